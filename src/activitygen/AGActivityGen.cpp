@@ -186,9 +186,10 @@ AGActivityGen::makeActivityTrips(int days, int beginSec, int endSec) {
     //list<Trip>* trips = &(acts.trips);
     std::list<AGTrip> expTrips;
     std::map<std::string, int> carUsed;
-    std::list<AGTrip>::iterator it;
-    //multiplication of days
-    for (it = acts.trips.begin(); it != acts.trips.end(); ++it) {
+    const int numTrips = (int)acts.trips.size();
+    //multiplication of days (the generated trips are discarded as soon as they are expanded to keep the memory footprint low)
+    for (; !acts.trips.empty(); acts.trips.pop_front()) {
+        std::list<AGTrip>::iterator it = acts.trips.begin();
         if (it->isDaily()) {
             for (int currday = 1; currday < durationInDays + 2; ++currday) {
                 AGTrip tr(it->getDep(), it->getArr(), it->getVehicleName(), it->getTime(), currday);
@@ -230,7 +231,7 @@ AGActivityGen::makeActivityTrips(int days, int beginSec, int endSec) {
         }
     }
 
-    std::cout << "total trips generated: " << acts.trips.size() << std::endl;
+    std::cout << "total trips generated: " << numTrips << std::endl;
     std::cout << "total trips finally taken: " << expTrips.size() << std::endl;
 
     /**
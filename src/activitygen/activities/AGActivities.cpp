@@ -39,16 +39,13 @@
 // method definitions
 // ===========================================================================
 void
-AGActivities::addTrip(AGTrip t, std::list<AGTrip>* tripSet) {
+AGActivities::addTrip(const AGTrip& t, std::list<AGTrip>* tripSet) {
     tripSet->push_back(t);
 }
 
 void
-AGActivities::addTrips(std::list<AGTrip> t, std::list<AGTrip>* tripSet) {
-    std::list<AGTrip>::iterator it;
-    for (it = t.begin(); it != t.end(); ++it) {
-        tripSet->push_back(*it);
-    }
+AGActivities::addTrips(const std::list<AGTrip>& t, std::list<AGTrip>* tripSet) {
+    tripSet->insert(tripSet->end(), t.begin(), t.end());
 }
 
 void
@@ -142,14 +139,14 @@ AGActivities::generateTrips(AGHousehold& hh) {
         }
         addTrips(ft.getPartialActivityTrips(), &temporaTrips);
         //cout << "after this hh: " << temporaTrips.size() << " we have: " << trips.size() << endl;
-        //trips of all activities generated:
-        addTrips(temporaTrips, &trips);
+        //trips of all activities generated (moved without copying):
+        trips.splice(trips.end(), temporaTrips);
     }
     return generated;
 }
 
 bool
-AGActivities::generateBusTraffic(AGBusLine bl) {
+AGActivities::generateBusTraffic(AGBusLine& bl) {
     std::list<AGBus>::iterator itB;
     std::list<AGPosition>::iterator itS;
     /**
@@ -40,8 +40,8 @@ public:
     AGActivities(AGCity* city, int days) :
         myCity(city),
         nbrDays(days) {};
-    void addTrip(AGTrip t, std::list<AGTrip>* tripSet);
-    void addTrips(std::list<AGTrip> t, std::list<AGTrip>* tripSet);
+    void addTrip(const AGTrip& t, std::list<AGTrip>* tripSet);
+    void addTrips(const std::list<AGTrip>& t, std::list<AGTrip>* tripSet);
     void generateActivityTrips();
 
     /**
@@ -54,7 +54,7 @@ public:
 
 private:
     bool generateTrips(AGHousehold& hh);
-    bool generateBusTraffic(AGBusLine bl);
+    bool generateBusTraffic(AGBusLine& bl);
     bool generateInOutTraffic();
     bool generateRandomTraffic();
 
@@ -188,12 +188,18 @@
 /* defined and set to version if JuPedSim is available */
 #cmakedefine JPS_VERSION @JPS_VERSION@
 
+/* defined if the linux perf_event interface shall be used for hardware performance counters */
+#cmakedefine HAVE_PERF_EVENTS
+
 /* defined if osg is available */
 #cmakedefine HAVE_OSG
 
 /* defined if zlib is available */
 #cmakedefine HAVE_ZLIB
 
+/* defined if zstd is available */
+#cmakedefine HAVE_ZSTD
+
 /* set to proj.h, proj_api.h or empty depending on which proj is available */
 #cmakedefine PROJ_API_FILE "@PROJ_API_FILE@"
 
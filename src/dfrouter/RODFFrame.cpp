@@ -149,6 +149,9 @@ RODFFrame::fillOptions() {
     oc.addSynonyme("max-search-depth", "max-nodet-follower", true);
     oc.addDescription("max-search-depth", "Processing", TL("Number of edges to follow a route without passing a detector"));
 
+    oc.doRegister("routing-threads", new Option_Integer(0));
+    oc.addDescription("routing-threads", "Processing", TL("The number of parallel execution threads used for computing the routes"));
+
     oc.doRegister("emissions-only", new Option_Bool(false));
     oc.addDescription("emissions-only", "Processing", TL("Writes only emission times"));
 
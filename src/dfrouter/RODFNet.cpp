@@ -26,6 +26,8 @@
 #include <iostream>
 #include <map>
 #include <queue>
+#include <set>
+#include <thread>
 #include <vector>
 #include <iterator>
 #include "RODFNet.h"
@@ -180,16 +182,15 @@ RODFNet::hasSourceDetector(ROEdge* edge,
 
 
 
-void
-RODFNet::computeRoutesFor(ROEdge* edge, RODFRouteDesc& base, int /*no*/,
+int
+RODFNet::computeRoutesFor(ROEdge* edge, RODFRouteDesc& base,
                           bool keepUnfoundEnds,
                           bool keepShortestOnly,
-                          ROEdgeVector& /*visited*/,
-                          const RODFDetector& det, RODFRouteCont& into,
+                          RODFRouteCont& into,
                           const RODFDetectorCon& detectors,
-                          int maxFollowingLength,
-                          ROEdgeVector& seen) const {
+                          int maxFollowingLength) const {
     std::vector<RODFRouteDesc> unfoundEnds;
+    std::set<const ROEdge*> seen;
     std::priority_queue<RODFRouteDesc, std::vector<RODFRouteDesc>, DFRouteDescByTimeComperator> toSolve;
     std::map<ROEdge*, ROEdgeVector > dets2Follow;
     dets2Follow[edge] = ROEdgeVector();
@@ -213,10 +214,9 @@ RODFNet::computeRoutesFor(ROEdge* edge, RODFRouteDesc& base, int /*no*/,
         }
 
         // do not process an edge twice
-        if (find(seen.begin(), seen.end(), last) != seen.end() && keepShortestOnly) {
+        if (!seen.insert(last).second && keepShortestOnly) {
             continue;
         }
-        seen.push_back(last);
         // end if the edge has no further connections
         if (!hasApproached(last)) {
             // ok, no further connections to follow
@@ -230,7 +230,7 @@ RODFNet::computeRoutesFor(ROEdge* edge, RODFRouteDesc& base, int /*no*/,
         // check for passing detectors:
         //  if the current last edge is not the one the detector is placed on ...
         bool addNextNoFurther = false;
-        if (last != getDetectorEdge(det)) {
+        if (last != edge) {
             // ... if there is a detector ...
             if (hasDetector(last)) {
                 if (!hasInBetweenDetectorsOnly(last, detectors)) {
@@ -263,7 +263,7 @@ RODFNet::computeRoutesFor(ROEdge* edge, RODFRouteDesc& base, int /*no*/,
         // check for highway off-ramps
         if (myAmInHighwayMode) {
             // if it's beside the highway...
-            if (last->getSpeedLimit() < 19.4 && last != getDetectorEdge(det)) {
+            if (last->getSpeedLimit() < 19.4 && last != edge) {
                 // ... and has more than one following edge
                 if (myApproachedEdges.find(last)->second.size() > 1) {
                     // -> let's add this edge and the following, but not any further
@@ -278,7 +278,6 @@ RODFNet::computeRoutesFor(ROEdge* edge, RODFRouteDesc& base, int /*no*/,
             //  without a detector occurred
             if (current.passedNo > maxFollowingLength) {
                 // mark not to process any further
-                WRITE_WARNINGF(TL("Could not close route for '%'"), det.getID());
                 unfoundEnds.push_back(current);
                 current.factor = 1.;
                 double cdist = current.edges2Pass[0]->getFromJunction()->getPosition().distanceTo(current.edges2Pass.back()->getToJunction()->getPosition());
@@ -331,32 +330,17 @@ RODFNet::computeRoutesFor(ROEdge* edge, RODFRouteDesc& base, int /*no*/,
     } else {
         // !!! patch the factors
     }
-    while (!toSolve.empty()) {
-//        RODFRouteDesc d = toSolve.top();
-        toSolve.pop();
-//        delete d;
-    }
+    return (int)unfoundEnds.size();
 }
 
 
 void
-RODFNet::buildRoutes(RODFDetectorCon& detcont, bool keepUnfoundEnds, bool includeInBetween,
-                     bool keepShortestOnly, int maxFollowingLength) const {
-    // build needed information first
-    buildDetectorEdgeDependencies(detcont);
-    // then build the routes
-    std::map<ROEdge*, RODFRouteCont* > doneEdges;
-    const std::vector< RODFDetector*>& dets = detcont.getDetectors();
-    for (std::vector< RODFDetector*>::const_iterator i = dets.begin(); i != dets.end(); ++i) {
-        ROEdge* e = getDetectorEdge(**i);
-        if (doneEdges.find(e) != doneEdges.end()) {
-            // use previously build routes
-            (*i)->addRoutes(new RODFRouteCont(*doneEdges[e]));
-            continue;
-        }
-        ROEdgeVector seen;
-        RODFRouteCont* routes = new RODFRouteCont();
-        doneEdges[e] = routes;
+RODFNet::computeRoutesForEdges(const std::vector<ROEdge*>& edges, std::vector<RODFRouteCont*>& routes,
+                               std::vector<int>& numUnclosed, int first, int numThreads,
+                               bool keepUnfoundEnds, bool keepShortestOnly,
+                               const RODFDetectorCon& detectors, int maxFollowingLength) const {
+    for (int i = first; i < (int)edges.size(); i += numThreads) {
+        ROEdge* e = edges[i];
         RODFRouteDesc rd;
         rd.edges2Pass.push_back(e);
         rd.duration_2 = (e->getLength() / e->getSpeedLimit()); //!!!;
@@ -368,10 +352,55 @@ RODFNet::buildRoutes(RODFDetectorCon& detcont, bool keepUnfoundEnds, bool includ
 
         rd.overallProb = 0;
 
-        ROEdgeVector visited;
-        visited.push_back(e);
-        computeRoutesFor(e, rd, 0, keepUnfoundEnds, keepShortestOnly,
-                         visited, **i, *routes, detcont, maxFollowingLength, seen);
+        routes[i] = new RODFRouteCont();
+        numUnclosed[i] = computeRoutesFor(e, rd, keepUnfoundEnds, keepShortestOnly,
+                                          *routes[i], detectors, maxFollowingLength);
+    }
+}
+
+
+void
+RODFNet::buildRoutes(RODFDetectorCon& detcont, bool keepUnfoundEnds, bool includeInBetween,
+                     bool keepShortestOnly, int maxFollowingLength, int numThreads) const {
+    // build needed information first
+    buildDetectorEdgeDependencies(detcont);
+    const std::vector< RODFDetector*>& dets = detcont.getDetectors();
+    // collect the edges to start from (in the order of their first detector)
+    std::map<ROEdge*, int> edgeIndex;
+    std::vector<ROEdge*> edges;
+    for (const RODFDetector* const det : dets) {
+        ROEdge* e = getDetectorEdge(*det);
+        if (edgeIndex.insert(std::make_pair(e, (int)edges.size())).second) {
+            edges.push_back(e);
+        }
+    }
+    // then build the routes, the search only reads the net and the detector types
+    std::vector<RODFRouteCont*> edgeRoutes(edges.size(), nullptr);
+    std::vector<int> numUnclosed(edges.size(), 0);
+    const int numWorkers = MAX2(1, MIN2(numThreads, (int)edges.size()));
+    std::vector<std::thread> threads;
+    for (int i = 1; i < numWorkers; i++) {
+        threads.emplace_back(&RODFNet::computeRoutesForEdges, this, std::cref(edges), std::ref(edgeRoutes), std::ref(numUnclosed),
+                             i, numWorkers, keepUnfoundEnds, keepShortestOnly, std::cref(detcont), maxFollowingLength);
+    }
+    computeRoutesForEdges(edges, edgeRoutes, numUnclosed, 0, numWorkers, keepUnfoundEnds, keepShortestOnly, detcont, maxFollowingLength);
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    // assign them to the detectors
+    std::vector<bool> done(edges.size(), false);
+    for (std::vector< RODFDetector*>::const_iterator i = dets.begin(); i != dets.end(); ++i) {
+        const int index = edgeIndex[getDetectorEdge(**i)];
+        if (done[index]) {
+            // use previously build routes
+            (*i)->addRoutes(new RODFRouteCont(*edgeRoutes[index]));
+            continue;
+        }
+        done[index] = true;
+        for (int j = 0; j < numUnclosed[index]; j++) {
+            WRITE_WARNINGF(TL("Could not close route for '%'"), (*i)->getID());
+        }
+        RODFRouteCont* routes = edgeRoutes[index];
         //!!!routes->removeIllegal(illegals);
         (*i)->addRoutes(routes);
 
@@ -449,7 +478,7 @@ RODFNet::revalidateFlows(const RODFDetector* detector,
         while (!missing.empty() && !maxDepthReached) {
             IterationEdge last = missing.back();
             missing.pop_back();
-            ROEdgeVector approaching = myApproachingEdges[last.edge];
+            const ROEdgeVector& approaching = myApproachingEdges[last.edge];
             for (ROEdgeVector::const_iterator j = approaching.begin(); j != approaching.end(); ++j) {
                 if (hasDetector(*j)) {
                     previous.push_back(*j);
@@ -482,7 +511,7 @@ RODFNet::revalidateFlows(const RODFDetector* detector,
         while (!missing.empty() && !maxDepthReached) {
             IterationEdge last = missing.back();
             missing.pop_back();
-            ROEdgeVector approached = myApproachedEdges[last.edge];
+            const ROEdgeVector& approached = myApproachedEdges[last.edge];
             for (ROEdgeVector::const_iterator j = approached.begin(); j != approached.end(); ++j) {
                 if (*j == getDetectorEdge(*detector)) {
                     continue;
@@ -1010,6 +1039,8 @@ RODFNet::buildDetectorDependencies(RODFDetectorCon& detectors) {
 
 
     buildDetectorEdgeDependencies(detectors);
+    // detectors on the same edge usually share their routes, each route needs to be evaluated once per edge
+    std::map<ROEdge*, std::set<ROEdgeVector>, idComp> doneRoutes;
     // for each detector, compute the lists of predecessor and following detectors
     std::map<std::string, ROEdge*>::const_iterator i;
     for (i = myDetectorEdges.begin(); i != myDetectorEdges.end(); ++i) {
@@ -1017,6 +1048,7 @@ RODFNet::buildDetectorDependencies(RODFDetectorCon& detectors) {
         if (!det.hasRoutes()) {
             continue;
         }
+        std::set<ROEdgeVector>& done = doneRoutes[(*i).second];
         // mark current detectors
         std::vector<RODFDetector*> last;
         {
@@ -1029,6 +1061,10 @@ RODFNet::buildDetectorDependencies(RODFDetectorCon& detectors) {
         const std::vector<RODFRouteDesc>& routes = det.getRouteVector();
         for (std::vector<RODFRouteDesc>::const_iterator j = routes.begin(); j != routes.end(); ++j) {
             const ROEdgeVector& edges2Pass = (*j).edges2Pass;
+            if (!done.insert(edges2Pass).second) {
+                // the prior and following detectors are sets, so this would not add anything
+                continue;
+            }
             for (ROEdgeVector::const_iterator k = edges2Pass.begin() + 1; k != edges2Pass.end(); ++k) {
                 if (myDetectorsOnEdges.find(*k) != myDetectorsOnEdges.end()) {
                     const std::vector<std::string>& detNames = myDetectorsOnEdges.find(*k)->second;
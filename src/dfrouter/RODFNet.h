@@ -55,8 +55,14 @@ public:
 
     void computeTypes(RODFDetectorCon& dets,
                       bool sourcesStrict) const;
+    /** @brief computes the routes starting at the detectors
+     *
+     * Detectors on the same edge share the routes. The routes of the
+     *  different edges are computed independently, optionally using
+     *  several threads, and assigned in the order of the detectors afterwards.
+     */
     void buildRoutes(RODFDetectorCon& det, bool keepUnfoundEnds, bool includeInBetween,
-                     bool keepShortestOnly, int maxFollowingLength) const;
+                     bool keepShortestOnly, int maxFollowingLength, int numThreads = 0) const;
     double getAbsPos(const RODFDetector& det) const;
 
     void buildEdgeFlowMap(const RODFDetectorFlows& flows,
@@ -117,13 +123,21 @@ protected:
     bool isDestination(const RODFDetector& det, ROEdge* edge, ROEdgeVector& seen,
                        const RODFDetectorCon& detectors) const;
 
-    void computeRoutesFor(ROEdge* edge, RODFRouteDesc& base, int no,
-                          bool keepUnfoundEnds,
-                          bool keepShortestOnly,
-                          ROEdgeVector& visited, const RODFDetector& det,
-                          RODFRouteCont& into, const RODFDetectorCon& detectors,
-                          int maxFollowingLength,
-                          ROEdgeVector& seen) const;
+    /** @brief computes the routes starting at the given (detector) edge
+     * @return the number of routes which could not be closed within maxFollowingLength
+     * @note does not modify the net or the detectors, so it may run in parallel for different edges
+     */
+    int computeRoutesFor(ROEdge* edge, RODFRouteDesc& base,
+                         bool keepUnfoundEnds,
+                         bool keepShortestOnly,
+                         RODFRouteCont& into, const RODFDetectorCon& detectors,
+                         int maxFollowingLength) const;
+
+    /// @brief computes the routes for every numThreads-th of the given edges starting with the given index
+    void computeRoutesForEdges(const std::vector<ROEdge*>& edges, std::vector<RODFRouteCont*>& routes,
+                               std::vector<int>& numUnclosed, int first, int numThreads,
+                               bool keepUnfoundEnds, bool keepShortestOnly,
+                               const RODFDetectorCon& detectors, int maxFollowingLength) const;
 
     void buildDetectorEdgeDependencies(RODFDetectorCon& dets) const;
 
@@ -147,7 +147,8 @@ startComputation(RODFNet* optNet, RODFDetectorFlows& flows, RODFDetectorCon& det
             PROGRESS_BEGIN_MESSAGE(TL("Computing routes"));
             optNet->buildRoutes(detectors,
                                 oc.getBool("keep-unfinished-routes"), oc.getBool("routes-for-all"),
-                                !oc.getBool("keep-longer-routes"), oc.getInt("max-search-depth"));
+                                !oc.getBool("keep-longer-routes"), oc.getInt("max-search-depth"),
+                                oc.getInt("routing-threads"));
             PROGRESS_DONE_MESSAGE();
         }
     }
@@ -86,6 +86,15 @@ RODUAFrame::addImportOptions() {
     oc.doRegister("write-costs", new Option_Bool(false));
     oc.addDescription("write-costs", "Output", TL("Include the cost attribute in route output"));
 
+    oc.doRegister("matrix-output", new Option_FileName());
+    oc.addDescription("matrix-output", "Output", TL("Write the route costs and lengths between the matrix origins and destinations to FILE"));
+
+    oc.doRegister("matrix.origins", new Option_StringVector());
+    oc.addDescription("matrix.origins", "Processing", TL("The origin edges for the matrix output"));
+
+    oc.doRegister("matrix.destinations", new Option_StringVector());
+    oc.addDescription("matrix.destinations", "Processing", TL("The destination edges for the matrix output (default: the origins)"));
+
     // register further processing options
     // ! The subtopic "Processing" must be initialised earlier !
     oc.doRegister("weights.random-factor", new Option_Float(1.));
@@ -104,7 +113,7 @@ RODUAFrame::addImportOptions() {
     oc.addDescription("astar.landmark-distances", "Processing", TL("Initialize lookup table for astar ALT-variant from the given file"));
 
     oc.doRegister("astar.save-landmark-distances", new Option_FileName());
-    oc.addDescription("astar.save-landmark-distances", "Processing", TL("Save lookup table for astar ALT-variant to the given file"));
+    oc.addDescription("astar.save-landmark-distances", "Processing", TL("Save lookup table for astar ALT-variant to the given file (in a fast loading binary format if the name ends with .bin)"));
 }
 
 
@@ -135,6 +144,9 @@ RODUAFrame::addDUAOptions() {
     oc.doRegister("keep-route-probability", new Option_Float(0));
     oc.addDescription("keep-route-probability", "Processing", TL("The probability of keeping the old route"));
 
+    oc.doRegister("reroute-probability", new Option_Float(1));
+    oc.addDescription("reroute-probability", "Processing", TL("The probability of searching a new route for a vehicle with route alternatives (the others only update the costs and probabilities of their alternatives)"));
+
     oc.doRegister("ptline-routing", new Option_Bool(false));
     oc.addDescription("ptline-routing", "Processing", TL("Route all public transport input"));
 
@@ -220,6 +232,14 @@ RODUAFrame::checkOptions() {
         WRITE_ERRORF(TL("Routing algorithm '%' does not support bulk routing."), oc.getString("routing-algorithm"));
         return false;
     }
+    if (oc.getFloat("reroute-probability") < 0 || oc.getFloat("reroute-probability") > 1) {
+        WRITE_ERROR(TL("The reroute probability must be in [0, 1]."));
+        ok = false;
+    }
+    if (oc.isSet("matrix-output") && !oc.isSet("matrix.origins")) {
+        WRITE_ERROR(TL("The matrix output needs the option 'matrix.origins'."));
+        return false;
+    }
     if (oc.isDefault("routing-algorithm") && (oc.isSet("astar.all-distances") || oc.isSet("astar.landmark-distances") || oc.isSet("astar.save-landmark-distances"))) {
         oc.setDefault("routing-algorithm", "astar");
     }
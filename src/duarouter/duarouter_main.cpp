@@ -49,6 +49,7 @@
 #include <utils/router/AStarRouter.h>
 #include <utils/router/CHRouter.h>
 #include <utils/router/CHRouterWrapper.h>
+#include <utils/router/DistanceMatrix.h>
 #include <utils/xml/XMLSubSys.h>
 #include <router/ROFrame.h>
 #include <router/ROLoader.h>
@@ -85,6 +86,51 @@ initNet(RONet& net, ROLoader& loader, OptionsCont& oc) {
 }
 
 
+/**
+ * Computes the costs between the matrix origins and destinations saving them
+ */
+void
+writeMatrix(RONet& net, const RORouterProvider& provider, OptionsCont& oc) {
+    std::vector<const ROEdge*> origins;
+    std::vector<const ROEdge*> destinations;
+    for (const std::string& id : oc.getStringVector("matrix.origins")) {
+        origins.push_back(net.getEdge(id));
+        if (origins.back() == nullptr) {
+            throw ProcessError(TLF("The matrix origin edge '%' is not known.", id));
+        }
+    }
+    if (oc.isSet("matrix.destinations")) {
+        for (const std::string& id : oc.getStringVector("matrix.destinations")) {
+            destinations.push_back(net.getEdge(id));
+            if (destinations.back() == nullptr) {
+                throw ProcessError(TLF("The matrix destination edge '%' is not known.", id));
+            }
+        }
+    } else {
+        destinations = origins;
+    }
+    ROVehicle defaultVehicle(SUMOVehicleParameter(), nullptr, net.getVehicleTypeSecure(DEFAULT_VTYPE_ID), &net);
+    const SUMOTime begin = string2time(oc.getString("begin"));
+    std::vector<double> costs;
+    std::vector<double> lengths;
+    DistanceMatrix<ROEdge, ROVehicle>::compute(provider.getVehicleRouter(defaultVehicle.getVClass()), origins, destinations, &defaultVehicle,
+            begin, oc.getInt("routing-threads"), costs, lengths);
+    OutputDevice::createDeviceByOption("matrix-output", "matrix");
+    OutputDevice& dev = OutputDevice::getDeviceByOption("matrix-output");
+    for (int o = 0; o < (int)origins.size(); o++) {
+        for (int d = 0; d < (int)destinations.size(); d++) {
+            const int cell = o * (int)destinations.size() + d;
+            // pairs without a connection are left out
+            if (costs[cell] != INVALID_DOUBLE) {
+                dev.openTag("entry").writeAttr(SUMO_ATTR_FROM, origins[o]->getID()).writeAttr(SUMO_ATTR_TO, destinations[d]->getID());
+                dev.writeAttr(SUMO_ATTR_COST, costs[cell]).writeAttr(SUMO_ATTR_LENGTH, lengths[cell]).closeTag();
+            }
+        }
+    }
+    dev.closeTag();
+}
+
+
 /**
  * Computes the routes saving them
  */
@@ -108,7 +154,8 @@ computeRoutes(RONet& net, ROLoader& loader, OptionsCont& oc) {
     }
 
     if (measure == "traveltime" && priorityFactor == 0) {
-        if (routingAlgorithm == "dijkstra") {
+        if (routingAlgorithm == "dijkstra" || routingAlgorithm == "raptor") {
+            // raptor only applies to intermodal routing
             router = new DijkstraRouter<ROEdge, ROVehicle>(ROEdge::getAllEdges(), oc.getBool("ignore-errors"), ttFunction, nullptr, false, nullptr, net.hasPermissions(), oc.isSet("restriction-params"));
         } else if (routingAlgorithm == "astar") {
             typedef AStarRouter<ROEdge, ROVehicle> AStar;
@@ -119,7 +166,10 @@ computeRoutes(RONet& net, ROLoader& loader, OptionsCont& oc) {
                 /* CHRouterWrapper<ROEdge, ROVehicle> chrouter(
                     ROEdge::getAllEdges(), true, &ROEdge::getTravelTimeStatic,
                     begin, end, SUMOTime_MAX, 1); */
-                DijkstraRouter<ROEdge, ROVehicle> forward(ROEdge::getAllEdges(), true, &ROEdge::getTravelTimeStatic);
+                // with time dependent weights the landmark distances must not overestimate the costs at any time
+                const bool timeDependent = oc.isSet("weight-files");
+                DijkstraRouter<ROEdge, ROVehicle> forward(ROEdge::getAllEdges(), true,
+                        timeDependent ? &ROEdge::getTravelTimeLowerBoundStatic : &ROEdge::getTravelTimeStatic);
                 std::vector<ReversedEdge<ROEdge, ROVehicle>*> reversed;
                 for (ROEdge* edge : ROEdge::getAllEdges()) {
                     reversed.push_back(edge->getReversedRoutingEdge());
@@ -127,7 +177,8 @@ computeRoutes(RONet& net, ROLoader& loader, OptionsCont& oc) {
                 for (ReversedEdge<ROEdge, ROVehicle>* redge : reversed) {
                     redge->init();
                 }
-                DijkstraRouter<ReversedEdge<ROEdge, ROVehicle>, ROVehicle> backward(reversed, true, &ReversedEdge<ROEdge, ROVehicle>::getTravelTimeStatic);
+                DijkstraRouter<ReversedEdge<ROEdge, ROVehicle>, ROVehicle> backward(reversed, true,
+                        timeDependent ? &ReversedEdge<ROEdge, ROVehicle>::getTravelTimeLowerBoundStatic : &ReversedEdge<ROEdge, ROVehicle>::getTravelTimeStatic);
                 ROVehicle defaultVehicle(SUMOVehicleParameter(), nullptr, net.getVehicleTypeSecure(DEFAULT_VTYPE_ID), &net);
                 lookup = std::make_shared<const AStar::LMLT>(oc.getString("astar.landmark-distances"), ROEdge::getAllEdges(), &forward, &backward, &defaultVehicle,
                          oc.isSet("astar.save-landmark-distances") ? oc.getString("astar.save-landmark-distances") : "", oc.getInt("routing-threads"));
@@ -215,6 +266,9 @@ computeRoutes(RONet& net, ROLoader& loader, OptionsCont& oc) {
     RORouterProvider provider(router, new PedestrianRouter<ROEdge, ROLane, RONode, ROVehicle>(),
                               new ROIntermodalRouter(RONet::adaptIntermodalRouter, carWalk, taxiWait, routingAlgorithm),
                               railRouter);
+    if (oc.isSet("matrix-output")) {
+        writeMatrix(net, provider, oc);
+    }
     // process route definitions
     try {
         net.openOutput(oc);
@@ -250,6 +304,7 @@ main(int argc, char** argv) {
         }
         SystemFrame::checkOptions(oc);
         XMLSubSys::setValidation(oc.getString("xml-validation"), oc.getString("xml-validation.net"), oc.getString("xml-validation.routes"));
+        XMLSubSys::setParseThreads(oc.getInt("parse-threads"));
 #ifdef HAVE_FOX
         if (oc.getInt("routing-threads") > 1) {
             // make the output aware of threading
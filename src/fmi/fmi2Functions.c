@@ -206,12 +206,28 @@ fmi2Reset(fmi2Component c) {
 // Implementation of the getter features
 fmi2Status
 fmi2GetReal(fmi2Component c, const fmi2ValueReference vr[], size_t nvr, fmi2Real value[]) {
-    UNREFERENCED_PARAMETER(c);
-    UNREFERENCED_PARAMETER(vr);
-    UNREFERENCED_PARAMETER(nvr);
-    UNREFERENCED_PARAMETER(value);
 
-    return fmi2Error;
+    ModelInstance *comp = (ModelInstance *)c;
+
+    // Check for null pointer errors
+    if (nvr > 0 && (!vr || !value)) {
+        return fmi2Error;
+    }
+
+    fmi2Status status = fmi2OK;
+
+    // Go through the list of arrays and save all requested values
+    size_t i;
+    for (i = 0; i < nvr; i++) {
+        fmi2Status s = sumo2fmi_getReal(comp, vr[i], &(value[i]));
+        status = s > status ? s : status;
+
+        if (status > fmi2Warning) {
+            return status;
+        }
+    }
+
+    return status;
 }
 
 fmi2Status
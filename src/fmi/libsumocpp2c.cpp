@@ -38,6 +38,13 @@
 
 #define DELIMITER ' '
 
+/// @brief the vehicles whose values are provided as real outputs
+static std::vector<std::string> subscribedIDs;
+/// @brief the values of the subscribed vehicles after the last step (SUBSCRIPTION_VARIABLES per vehicle)
+static std::vector<double> subscribedValues;
+/// @brief the number of subscribed vehicles in the network
+static int subscribedCount = 0;
+
 inline char*
 allocateAndCopyString(ModelInstance* comp, const std::string& s) {
     char* buf = NULL;
@@ -163,3 +170,51 @@ libsumo_vehicle_getPosition(ModelInstance* comp, const char** result) {
         abort();
     }
 }
+
+
+void
+libsumo_vehicle_setSubscribedIDs(const char* idString) {
+    subscribedIDs.clear();
+    std::stringstream ss(idString);
+    std::string temp_str;
+    while (std::getline(ss, temp_str, DELIMITER)) {
+        if (!temp_str.empty() && (int)subscribedIDs.size() < SUBSCRIPTION_SLOTS) {
+            subscribedIDs.push_back(temp_str);
+        }
+    }
+    libsumo_vehicle_updateSubscribed();
+}
+
+void
+libsumo_vehicle_updateSubscribed(void) {
+    subscribedValues.assign(SUBSCRIPTION_SLOTS * SUBSCRIPTION_VARIABLES, libsumo::INVALID_DOUBLE_VALUE);
+    subscribedCount = 0;
+    if (subscribedIDs.empty() || !libsumo::Simulation::isLoaded()) {
+        return;
+    }
+    for (int i = 0; i < (int)subscribedIDs.size(); i++) {
+        try {
+            const libsumo::TraCIPosition pos = libsumo::Vehicle::getPosition(subscribedIDs[i]);
+            subscribedValues[i * SUBSCRIPTION_VARIABLES] = pos.x;
+            subscribedValues[i * SUBSCRIPTION_VARIABLES + 1] = pos.y;
+            subscribedValues[i * SUBSCRIPTION_VARIABLES + 2] = libsumo::Vehicle::getSpeed(subscribedIDs[i]);
+            subscribedValues[i * SUBSCRIPTION_VARIABLES + 3] = libsumo::Vehicle::getAngle(subscribedIDs[i]);
+            subscribedCount++;
+        } catch (const libsumo::TraCIException&) {
+            // the vehicle is not (or no longer) in the network
+        }
+    }
+}
+
+int
+libsumo_vehicle_getSubscribedCount(void) {
+    return subscribedCount;
+}
+
+double
+libsumo_vehicle_getSubscribedValue(int slot, int variable) {
+    if (slot * SUBSCRIPTION_VARIABLES + variable >= (int)subscribedValues.size()) {
+        return libsumo::INVALID_DOUBLE_VALUE;
+    }
+    return subscribedValues[slot * SUBSCRIPTION_VARIABLES + variable];
+}
@@ -34,6 +34,10 @@ void libsumo_vehicle_moveToXY(const char*);
 void libsumo_vehicle_getParameterWithKey(ModelInstance*, const char**);
 void libsumo_vehicle_getLaneID(ModelInstance*, const char**);
 void libsumo_vehicle_getPosition(ModelInstance*, const char**);
+void libsumo_vehicle_setSubscribedIDs(const char*);
+void libsumo_vehicle_updateSubscribed(void);
+int  libsumo_vehicle_getSubscribedCount(void);
+double libsumo_vehicle_getSubscribedValue(int slot, int variable);
 
 #ifdef __cplusplus
 }
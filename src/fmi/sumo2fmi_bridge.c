@@ -111,11 +111,27 @@ sumo2fmi_getInteger(ModelInstance* comp, const fmi2ValueReference vr, int* value
         case 2:
             *value = libsumo_vehicle_getIDCount();
             return fmi2OK;
+        case 8:
+            *value = libsumo_vehicle_getSubscribedCount();
+            return fmi2OK;
         default:
             return fmi2Error;
     }
 }
 
+// Retrieve the real value for a single variable (the values of the subscribed vehicles are cached after each step)
+fmi2Status
+sumo2fmi_getReal(ModelInstance* comp, const fmi2ValueReference vr, double* value) {
+    UNREFERENCED_PARAMETER(comp);
+
+    if (vr < SUBSCRIPTION_VR_OFFSET || vr >= SUBSCRIPTION_VR_OFFSET + SUBSCRIPTION_SLOTS * SUBSCRIPTION_VARIABLES) {
+        return fmi2Error;
+    }
+    const int index = (int)vr - SUBSCRIPTION_VR_OFFSET;
+    *value = libsumo_vehicle_getSubscribedValue(index / SUBSCRIPTION_VARIABLES, index % SUBSCRIPTION_VARIABLES);
+    return fmi2OK;
+}
+
 fmi2Status
 sumo2fmi_getString(ModelInstance *comp, const fmi2ValueReference vr, fmi2String *value) {
     switch (vr) {
@@ -155,6 +171,9 @@ sumo2fmi_setString(ModelInstance* comp, fmi2ValueReference vr, fmi2String value)
         case 3:
             libsumo_vehicle_moveToXY(value);
             return fmi2OK;
+        case 7:
+            libsumo_vehicle_setSubscribedIDs(value);
+            return fmi2OK;
         default:
             return fmi2Error;
     }
@@ -165,5 +184,6 @@ sumo2fmi_step(ModelInstance *comp, double tNext) {
     UNREFERENCED_PARAMETER(comp);
 
     libsumo_step(tNext);
+    libsumo_vehicle_updateSubscribed();
     return fmi2OK;
 }
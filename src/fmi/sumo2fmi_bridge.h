@@ -28,6 +28,13 @@
 #include <foreign/fmi/fmi2FunctionTypes.h>
 #include <foreign/fmi/fmi2TypesPlatform.h>
 
+/* The subscribed vehicles whose values are provided as real outputs
+ * (value references SUBSCRIPTION_VR_OFFSET + slot * SUBSCRIPTION_VARIABLES + variable,
+ * with the variables x, y, speed and angle) */
+#define SUBSCRIPTION_SLOTS 8
+#define SUBSCRIPTION_VARIABLES 4
+#define SUBSCRIPTION_VR_OFFSET 9
+
 /* Type definitions for callback functions */
 typedef void* (*allocateMemoryType)(size_t nobj, size_t size);
 typedef void (*loggerType)(void* componentEnvironment, const char* instanceName, int status, const char* category, const char* message, ...);
@@ -70,6 +77,7 @@ void        sumo2fmi_logMessage(ModelInstance* comp, int status, const char* cat
 
 /* Getter/Setter Functions */
 fmi2Status  sumo2fmi_getInteger(ModelInstance* comp, const fmi2ValueReference vr, int* value);
+fmi2Status  sumo2fmi_getReal(ModelInstance* comp, const fmi2ValueReference vr, double* value);
 fmi2Status  sumo2fmi_getString(ModelInstance* comp, const fmi2ValueReference vr, fmi2String* value);
 fmi2Status  sumo2fmi_setString(ModelInstance* comp, fmi2ValueReference vr, fmi2String value);
 
@@ -19,6 +19,7 @@
 #ifndef WIN32
 	#include <sys/types.h>
 	#include <sys/socket.h>
+	#include <sys/uio.h>
 	#include <netinet/in.h>
 	#include <netinet/tcp.h>
 	#include <arpa/inet.h>
@@ -26,6 +27,8 @@
 	#include <errno.h>
 	#include <fcntl.h>
 	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
 #else
 	#ifdef ERROR
 		#undef ERROR
@@ -48,7 +51,14 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
 #include <string.h>
+#ifdef WIN32
+	#include <process.h>
+#endif
 
 
 #ifdef SHAWN
@@ -62,6 +72,16 @@ namespace tcpip
 {
 	const int Socket::lengthLen = 4;
 
+	/// @brief the layout of the shared memory segment, the two ring buffers follow at SHM_DATA_OFFSET
+	struct SharedMemoryHeader
+	{
+		/// total number of bytes written to / read from each ring buffer, buffer 0 is written by the creator
+		std::atomic<unsigned long long> written[2];
+		std::atomic<unsigned long long> read[2];
+		unsigned long long capacity;
+	};
+	static const std::size_t SHM_DATA_OFFSET = 64;
+
 #ifdef WIN32
 	bool Socket::init_windows_sockets_ = true;
 	bool Socket::windows_sockets_initialized_ = false;
@@ -76,7 +96,12 @@ namespace tcpip
 		socket_(-1),
 		server_socket_(-1),
 		blocking_(true),
-		verbose_(false)
+		verbose_(false),
+		shm_(nullptr),
+		shmLength_(0),
+		shmHandle_(nullptr),
+		shmOwner_(false),
+		shmActive_(false)
 	{
 		init();
 	}
@@ -89,7 +114,12 @@ namespace tcpip
 		socket_(-1),
 		server_socket_(-1),
 		blocking_(true),
-		verbose_(false)
+		verbose_(false),
+		shm_(nullptr),
+		shmLength_(0),
+		shmHandle_(nullptr),
+		shmOwner_(false),
+		shmActive_(false)
 	{
 		init();
 	}
@@ -390,6 +420,7 @@ namespace tcpip
 		Socket::
 		close()
 	{
+		unmapSharedMemory();
 		// Close client-connection
 		if( socket_ >= 0 )
 		{
@@ -415,6 +446,11 @@ namespace tcpip
 
 		size_t numbytes = buffer.size();
 		unsigned char const *bufPtr = &buffer[0];
+		if( shmActive_ )
+		{
+			shmWrite(bufPtr, numbytes);
+			return;
+		}
 		while( numbytes > 0 )
 		{
 #ifdef WIN32
@@ -438,17 +474,101 @@ namespace tcpip
 		Socket::
 		sendExact( const Storage &b)
 	{
-		int length = static_cast<int>(b.size());
+		const Storage empty;
+		sendExact(b, empty);
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		Socket::
+		sendExact( const Storage &head, const Storage &body)
+	{
+		const int length = static_cast<int>(head.size() + body.size());
 		Storage length_storage;
 		length_storage.writeInt(lengthLen + length);
 
-		// Sending length_storage and b independently would probably be possible and
-		// avoid some copying here, but both parts would have to go through the
-		// TCP/IP stack on their own which probably would cost more performance.
-		std::vector<unsigned char> msg;
-		msg.insert(msg.end(), length_storage.begin(), length_storage.end());
-		msg.insert(msg.end(), b.begin(), b.end());
-		send(msg);
+		if( verbose_ )
+		{
+			std::vector<unsigned char> msg;
+			msg.insert(msg.end(), length_storage.begin(), length_storage.end());
+			msg.insert(msg.end(), head.begin(), head.end());
+			msg.insert(msg.end(), body.begin(), body.end());
+			printBufferOnVerbose(msg, "Send");
+		}
+
+		// The parts go through the TCP/IP stack in a single gather write,
+		// so large messages are neither copied nor split into several packets.
+		const unsigned char* const parts[3] = {
+			&*length_storage.begin(),
+			head.size() > 0 ? &*head.begin() : nullptr,
+			body.size() > 0 ? &*body.begin() : nullptr
+		};
+		const std::size_t lengths[3] = { length_storage.size(), head.size(), body.size() };
+		sendParts(parts, lengths, 3);
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		Socket::
+		sendParts(const unsigned char* const parts[], const std::size_t lengths[], int numParts)
+	{
+		if( socket_ < 0 )
+			return;
+
+		if( shmActive_ )
+		{
+			for( int i = 0; i < numParts; ++i )
+			{
+				if( lengths[i] > 0 )
+					shmWrite(parts[i], lengths[i]);
+			}
+			return;
+		}
+		const int maxParts = 3;
+		assert(numParts <= maxParts);
+		// first part which is not completely sent and the bytes of it already sent
+		int first = 0;
+		std::size_t offset = 0;
+		while( first < numParts && lengths[first] == 0 )
+			++first;
+		while( first < numParts )
+		{
+			int num = 0;
+#ifdef WIN32
+			WSABUF bufs[maxParts];
+			for( int i = first; i < numParts; ++i, ++num )
+			{
+				const std::size_t skip = i == first ? offset : 0;
+				bufs[num].buf = (char*)(parts[i] + skip);
+				bufs[num].len = static_cast<ULONG>(lengths[i] - skip);
+			}
+			DWORD sent = 0;
+			if( WSASend( socket_, bufs, num, &sent, 0, NULL, NULL ) != 0 )
+				BailOnSocketError( "send failed" );
+			std::size_t bytesSent = sent;
+#else
+			struct iovec bufs[maxParts];
+			for( int i = first; i < numParts; ++i, ++num )
+			{
+				const std::size_t skip = i == first ? offset : 0;
+				bufs[num].iov_base = const_cast<unsigned char*>(parts[i] + skip);
+				bufs[num].iov_len = lengths[i] - skip;
+			}
+			const ssize_t sent = ::writev( socket_, bufs, num );
+			if( sent < 0 )
+				BailOnSocketError( "send failed" );
+			std::size_t bytesSent = static_cast<std::size_t>(sent);
+#endif
+			while( first < numParts && bytesSent >= lengths[first] - offset )
+			{
+				bytesSent -= lengths[first] - offset;
+				offset = 0;
+				++first;
+			}
+			offset += bytesSent;
+		}
 	}
 
 
@@ -458,6 +578,8 @@ namespace tcpip
 		recvAndCheck(unsigned char * const buffer, std::size_t len)
 		const
 	{
+		if( shmActive_ )
+			return shmRead(buffer, len);
 #ifdef WIN32
 		const int bytesReceived = recv( socket_, (char*)buffer, static_cast<int>(len), 0 );
 #else
@@ -562,6 +684,195 @@ namespace tcpip
 	}
 
 
+	// ----------------------------------------------------------------------
+	void
+		Socket::
+		mapSharedMemory(const std::string& name, int capacity, bool create)
+	{
+		unmapSharedMemory();
+		if( capacity <= 0 )
+			throw SocketException("tcpip::Socket::mapSharedMemory: invalid capacity");
+		shmName_ = name;
+		if( shmName_.empty() && create )
+		{
+			std::ostringstream tmp;
+#ifdef WIN32
+			tmp << "Local\\sumo-traci-" << _getpid() << "-" << port_;
+#else
+			tmp << (access("/dev/shm", W_OK) == 0 ? "/dev/shm" : "/tmp") << "/sumo-traci-" << getpid() << "-" << port_;
+#endif
+			shmName_ = tmp.str();
+		}
+		shmLength_ = SHM_DATA_OFFSET + 2 * static_cast<std::size_t>(capacity);
+#ifdef WIN32
+		HANDLE handle = create
+			? CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, (DWORD)((unsigned long long)shmLength_ >> 32), (DWORD)(shmLength_ & 0xFFFFFFFF), shmName_.c_str())
+			: OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, shmName_.c_str());
+		if( handle == nullptr )
+			throw SocketException("tcpip::Socket::mapSharedMemory: could not open '" + shmName_ + "'");
+		void* addr = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, shmLength_);
+		if( addr == nullptr )
+		{
+			CloseHandle(handle);
+			throw SocketException("tcpip::Socket::mapSharedMemory: could not map '" + shmName_ + "'");
+		}
+		shmHandle_ = handle;
+#else
+		// a file on tmpfs (/dev/shm) is used instead of shm_open to avoid linking librt
+		const int fd = ::open(shmName_.c_str(), create ? O_RDWR | O_CREAT | O_EXCL : O_RDWR, 0600);
+		if( fd < 0 )
+			throw SocketException("tcpip::Socket::mapSharedMemory: could not open '" + shmName_ + "' (" + std::string(strerror(errno)) + ")");
+		if( create && ftruncate(fd, static_cast<off_t>(shmLength_)) != 0 )
+		{
+			::close(fd);
+			::unlink(shmName_.c_str());
+			throw SocketException("tcpip::Socket::mapSharedMemory: could not resize '" + shmName_ + "'");
+		}
+		void* addr = mmap(nullptr, shmLength_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd);
+		if( addr == MAP_FAILED )
+		{
+			if( create )
+				::unlink(shmName_.c_str());
+			throw SocketException("tcpip::Socket::mapSharedMemory: could not map '" + shmName_ + "'");
+		}
+#endif
+		shm_ = static_cast<unsigned char*>(addr);
+		shmOwner_ = create;
+		SharedMemoryHeader* header = reinterpret_cast<SharedMemoryHeader*>(shm_);
+		if( create )
+		{
+			new (header) SharedMemoryHeader();
+			for( int i = 0; i < 2; ++i )
+			{
+				header->written[i].store(0);
+				header->read[i].store(0);
+			}
+			header->capacity = capacity;
+		}
+		else if( header->capacity != static_cast<unsigned long long>(capacity) )
+		{
+			unmapSharedMemory();
+			throw SocketException("tcpip::Socket::mapSharedMemory: capacity mismatch for '" + name + "'");
+		}
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		Socket::
+		useSharedMemory()
+	{
+		if( shm_ == nullptr )
+			throw SocketException("tcpip::Socket::useSharedMemory: no shared memory mapped");
+		shmActive_ = true;
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		Socket::
+		unmapSharedMemory()
+	{
+		if( shm_ == nullptr )
+			return;
+#ifdef WIN32
+		UnmapViewOfFile(shm_);
+		CloseHandle((HANDLE)shmHandle_);
+		shmHandle_ = nullptr;
+#else
+		munmap(shm_, shmLength_);
+		if( shmOwner_ )
+			::unlink(shmName_.c_str());
+#endif
+		shm_ = nullptr;
+		shmActive_ = false;
+		shmOwner_ = false;
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		Socket::
+		shmWait(int& spins)
+		const
+	{
+		// spin first (the peer usually answers within microseconds), then yield and finally sleep
+		++spins;
+		if( spins < 1000 )
+			return;
+		if( spins < 2000 )
+		{
+			std::this_thread::yield();
+			return;
+		}
+		std::this_thread::sleep_for(std::chrono::microseconds(20));
+		if( spins % 1000 == 0 && socket_ >= 0 && datawaiting(socket_) )
+		{
+			// the TCP connection is idle while using shared memory, so readability means shutdown
+			char c;
+			if( recv(socket_, &c, 1, MSG_PEEK) <= 0 )
+				throw SocketException("tcpip::Socket::shmWait: peer shutdown");
+		}
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		Socket::
+		shmWrite(const unsigned char* buffer, std::size_t len)
+		const
+	{
+		SharedMemoryHeader* header = reinterpret_cast<SharedMemoryHeader*>(shm_);
+		const int channel = shmOwner_ ? 0 : 1;
+		const unsigned long long capacity = header->capacity;
+		unsigned char* const data = shm_ + SHM_DATA_OFFSET + channel * capacity;
+		int spins = 0;
+		while( len > 0 )
+		{
+			const unsigned long long w = header->written[channel].load(std::memory_order_relaxed);
+			const unsigned long long r = header->read[channel].load(std::memory_order_acquire);
+			const unsigned long long space = capacity - (w - r);
+			if( space == 0 )
+			{
+				shmWait(spins);
+				continue;
+			}
+			const std::size_t n = static_cast<std::size_t>(std::min(std::min(static_cast<unsigned long long>(len), space), capacity - w % capacity));
+			memcpy(data + w % capacity, buffer, n);
+			header->written[channel].store(w + n, std::memory_order_release);
+			buffer += n;
+			len -= n;
+			spins = 0;
+		}
+	}
+
+
+	// ----------------------------------------------------------------------
+	size_t
+		Socket::
+		shmRead(unsigned char* const buffer, std::size_t len)
+		const
+	{
+		SharedMemoryHeader* header = reinterpret_cast<SharedMemoryHeader*>(shm_);
+		const int channel = shmOwner_ ? 1 : 0;
+		const unsigned long long capacity = header->capacity;
+		const unsigned char* const data = shm_ + SHM_DATA_OFFSET + channel * capacity;
+		const unsigned long long r = header->read[channel].load(std::memory_order_relaxed);
+		unsigned long long w = header->written[channel].load(std::memory_order_acquire);
+		int spins = 0;
+		while( w == r )
+		{
+			shmWait(spins);
+			w = header->written[channel].load(std::memory_order_acquire);
+		}
+		const std::size_t n = static_cast<std::size_t>(std::min(std::min(static_cast<unsigned long long>(len), w - r), capacity - r % capacity));
+		memcpy(buffer, data + r % capacity, n);
+		header->read[channel].store(r + n, std::memory_order_release);
+		return n;
+	}
+
+
 	// ----------------------------------------------------------------------
 	bool
 		Socket::
@@ -571,6 +882,24 @@ namespace tcpip
 		return socket_ >= 0;
 	}
 
+
+	// ----------------------------------------------------------------------
+	bool
+		Socket::
+		has_data()
+		const
+	{
+		if( shmActive_ )
+		{
+			const SharedMemoryHeader* header = reinterpret_cast<const SharedMemoryHeader*>(shm_);
+			const int channel = shmOwner_ ? 1 : 0;
+			if( header->written[channel].load(std::memory_order_acquire) != header->read[channel].load(std::memory_order_relaxed) )
+				return true;
+			// the TCP connection is idle while using shared memory, so readability means shutdown
+		}
+		return socket_ >= 0 && datawaiting(socket_);
+	}
+
 	// ----------------------------------------------------------------------
 	bool
 		Socket::
@@ -82,6 +82,8 @@ namespace tcpip
 
 		void send( const std::vector<unsigned char> &buffer);
 		void sendExact( const Storage & );
+		/// Send \p head and \p body as one TraCI message without copying them into a common buffer
+		void sendExact( const Storage &head, const Storage &body );
 		/// Receive up to \p bufSize available bytes from Socket::socket_
 		std::vector<unsigned char> receive( int bufSize = 2048 );
 		/// Receive a complete TraCI message from Socket::socket_
@@ -91,11 +93,20 @@ namespace tcpip
 		void set_blocking(bool);
 		bool is_blocking();
 		bool has_client_connection() const;
+		/// Whether data can be received without blocking (or the connection was closed)
+		bool has_data() const;
 
 		// If verbose, each send and received data is written to stderr
 		bool verbose() { return verbose_; }
 		void set_verbose(bool newVerbose) { verbose_ = newVerbose; }
 
+		/// @brief Maps (and creates if \p create is set) a shared memory segment holding two ring buffers of \p capacity bytes each
+		/// @note If \p name is empty and \p create is set, a name is chosen which can be retrieved by sharedMemoryName()
+		void mapSharedMemory(const std::string& name, int capacity, bool create);
+		/// @brief Lets all further send / receive calls use the mapped shared memory instead of the TCP connection
+		void useSharedMemory();
+		const std::string& sharedMemoryName() const { return shmName_; }
+
 	protected:
 		/// Length of the message length part of a TraCI message
 		static const int lengthLen;
@@ -106,6 +117,15 @@ namespace tcpip
 		size_t recvAndCheck(unsigned char * const buffer, std::size_t len) const;
 		/// Print \p label and \p buffer to stderr if Socket::verbose_ is set
 		void printBufferOnVerbose(const std::vector<unsigned char> buffer, const std::string &label) const;
+		/// Send the \p numParts buffers \p parts of \p lengths bytes as one gather write
+		void sendParts(const unsigned char* const parts[], const std::size_t lengths[], int numParts);
+		/// Write \p len bytes to the outgoing shared memory ring buffer
+		void shmWrite(const unsigned char* buffer, std::size_t len) const;
+		/// Read up to \p len available bytes from the incoming shared memory ring buffer
+		size_t shmRead(unsigned char* const buffer, std::size_t len) const;
+		/// Back off while waiting for the peer, throws if the TCP connection was closed
+		void shmWait(int& spins) const;
+		void unmapSharedMemory();
 
 	private:
 		void init();
@@ -123,6 +143,14 @@ namespace tcpip
 		bool blocking_;
 
 		bool verbose_;
+
+		/// shared memory transport (see mapSharedMemory)
+		unsigned char* shm_;
+		std::size_t shmLength_;
+		std::string shmName_;
+		void* shmHandle_;
+		bool shmOwner_;
+		bool shmActive_;
 #ifdef WIN32
 		static bool init_windows_sockets_;
 		static bool windows_sockets_initialized_;
@@ -1993,6 +1993,9 @@ void
 GUIApplicationWindow::handleEvent_SimulationEnded(GUIEvent* e) {
     GUIEvent_SimulationEnded* ec = static_cast<GUIEvent_SimulationEnded*>(e);
     onCmdStop(nullptr, 0, nullptr);
+    for (GUIGlChildWindow* const window : myGLWindows) {
+        window->getView()->finishSnapshotWrites();
+    }
     if (ec->getReason() == MSNet::SIMSTATE_LOADING) {
         onCmdReload(nullptr, 0, nullptr);
     } else if (GUIGlobals::gQuitOnEnd) {
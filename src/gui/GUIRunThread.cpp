@@ -158,6 +158,8 @@ GUIRunThread::tryStep() {
         if (mySingle) {
             myHalting = true;
         }
+        // the vehicle geometry is prepared after the step only while the simulation keeps running
+        getNet().setRenderSnapshotsActive(!myHalting);
         // do the step
         makeStep();
         waitForSnapshots(myNet->getCurrentTimeStep() - DELTA_T);
@@ -194,6 +196,7 @@ GUIRunThread::makeStep() {
         myNet->simulationStep();
         myNet->guiSimulationStep();
         mySimulationLock.unlock();
+        myNet->updateRenderSnapshots();
 
         // inform parent that a step has been performed
         e = new GUIEvent_SimulationStep();
@@ -279,6 +282,9 @@ void
 GUIRunThread::stop() {
     mySingle = false;
     myHalting = true;
+    if (myNet != nullptr) {
+        myNet->setRenderSnapshotsActive(false);
+    }
 }
 
 
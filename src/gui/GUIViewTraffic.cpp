@@ -364,6 +364,9 @@ GUIViewTraffic::doPaintGL(int mode, const Boundary& bound) {
     // draw decals (if not in grabbing mode)
     drawDecals();
     myVisualizationSettings->scale = myVisualizationSettings->drawForPositionSelection ? myVisualizationSettings->scale : m2p(SUMO_const_laneWidth);
+    if (!myVisualizationSettings->drawForPositionSelection && !myVisualizationSettings->drawForRectangleSelection) {
+        GUINet::getGUIInstance()->publishRenderSettings(*myVisualizationSettings);
+    }
     if (myVisualizationSettings->showGrid) {
         paintGLGrid();
     }
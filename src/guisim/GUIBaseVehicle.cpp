@@ -658,6 +658,74 @@ GUIBaseVehicle::drawGL(const GUIVisualizationSettings& s) const {
 }
 
 
+bool
+GUIBaseVehicle::drawBatched(const GUIVisualizationSettings& s) const {
+    return (s.vehicleQuality <= 1
+            && !s.drawForPositionSelection && !s.drawForRectangleSelection
+            && !s.drawDetail(s.detailSettings.vehicleTriangles, getExaggeration(s))
+            && !s.drawMinGap && !s.drawBrakeGap && !s.showBTRange
+            && !s.vehicleName.show(this) && !s.vehicleValue.show(this)
+            && !s.vehicleScaleValue.show(this) && !s.vehicleText.show(this)
+            && myAdditionalVisualizations.empty()
+            && getNumPassengers() == 0 && getNumContainers() == 0);
+}
+
+
+void
+GUIBaseVehicle::addToBatch(const GUIVisualizationSettings& s, std::vector<double>& vertices, std::vector<unsigned char>& colors) const {
+    // the corners (in multiples of width and length) of the shapes from GUIBaseVehicleHelper
+    static const double triangle[] = {0., 0., -.5, 1., .5, 1.};
+    static const double triangleReversed[] = {0., 1., -.5, 0., .5, 0.};
+    static const double box[] = {0., 0., -.5, .15, .5, .15, -.5, .15, .5, .15, -.5, 1., .5, .15, -.5, 1., .5, 1.};
+    static const double boxReversed[] = {-.5, 0., .5, 0., -.5, .85, .5, 0., -.5, .85, .5, .85, -.5, .85, .5, .85, 0., 1.};
+    const RGBColor col = computeColor(s);
+    if (col.alpha() == 0) {
+        return;
+    }
+    // the same transformations as in drawOnPos
+    const Position pos = getVisualPosition(s.secondaryShape);
+    const double angle = getVisualAngle(s.secondaryShape) + M_PI / 2.;
+    const double length = getVType().getLength();
+    const double upscale = getExaggeration(s);
+    double shift = 0.;
+    if (upscale > 1 && s.laneWidthExaggeration > 1 && myVehicle.isOnRoad()) {
+        double offsetFromLeftBorder = myVehicle.getCurrentEdge()->getWidth() - myVehicle.getRightSideOnEdge() - myVehicle.getVehicleType().getWidth() / 2;
+        shift = (s.laneWidthExaggeration - 1) * -offsetFromLeftBorder / 2;
+    }
+    double upscaleLength = upscale;
+    if (upscale > 1 && length > 5) {
+        const double widthLengthFactor = length / 5;
+        const double shrinkFactor = MIN2(widthLengthFactor, sqrt(upscaleLength));
+        upscaleLength /= shrinkFactor;
+    }
+    const double geometryFactor = (s.scaleLength ?
+                                   ((myVehicle.getLane() != nullptr
+                                     ? myVehicle.getLane()->getLengthGeometryFactor(s.secondaryShape)
+                                     : (myVehicle.getEdge()->getLanes().size() > 0 ? myVehicle.getEdge()->getLanes()[0]->getLengthGeometryFactor(s.secondaryShape) : 1)))
+                                   : 1);
+    const double scaledLength = length * geometryFactor;
+    const bool asBox = s.vehicleQuality == 1 || scaledLength >= 8.;
+    const bool reversed = drawReversed(s);
+    const double* const corners = asBox ? (reversed ? boxReversed : box) : (reversed ? triangleReversed : triangle);
+    const int numCorners = asBox ? 9 : 3;
+    const double width = getVType().getWidth() * upscale;
+    const double drawLength = scaledLength * upscaleLength;
+    const double cosAngle = cos(angle);
+    const double sinAngle = sin(angle);
+    for (int i = 0; i < numCorners; i++) {
+        const double x = corners[2 * i] * width + shift;
+        const double y = corners[2 * i + 1] * drawLength;
+        vertices.push_back(pos.x() + x * cosAngle - y * sinAngle);
+        vertices.push_back(pos.y() + x * sinAngle + y * cosAngle);
+        vertices.push_back(getType());
+        colors.push_back(col.red());
+        colors.push_back(col.green());
+        colors.push_back(col.blue());
+        colors.push_back(col.alpha());
+    }
+}
+
+
 void
 GUIBaseVehicle::drawGLAdditional(GUISUMOAbstractView* const parent, const GUIVisualizationSettings& s) const {
     if (!myVehicle.isOnRoad()) {
@@ -707,12 +775,19 @@ GUIBaseVehicle::drawLinkItem(const Position& pos, SUMOTime arrivalTime, SUMOTime
 
 RGBColor
 GUIBaseVehicle::setColor(const GUIVisualizationSettings& s) const {
+    const RGBColor col = computeColor(s);
+    GLHelper::setColor(col);
+    return col;
+}
+
+
+RGBColor
+GUIBaseVehicle::computeColor(const GUIVisualizationSettings& s) const {
     RGBColor col;
     const GUIColorer& c = s.vehicleColorer;
     if (!setFunctionalColor(c.getActive(), &myVehicle, col)) {
         col = c.getScheme().getColor(getColorValue(s, c.getActive()));
     }
-    GLHelper::setColor(col);
     return col;
 }
 
@@ -204,6 +204,23 @@ public:
     void drawGL(const GUIVisualizationSettings& s) const;
 
 
+    /** @brief Returns whether the vehicle shall be drawn as part of a batch instead of calling drawGL
+     *
+     * This holds for triangles and boxes below the detail level for vehicle triangles
+     *  if nothing besides the shape (names, gaps, passengers, ...) needs to be drawn
+     * @param[in] s The settings for the current view
+     */
+    bool drawBatched(const GUIVisualizationSettings& s) const;
+
+
+    /** @brief Appends the triangles of the vehicle shape as drawn by drawGL
+     * @param[in] s The settings for the current view
+     * @param[in, out] vertices The coordinates to append to (see GLHelper::drawTriangles)
+     * @param[in, out] colors The colors to append to (see GLHelper::drawTriangles)
+     */
+    void addToBatch(const GUIVisualizationSettings& s, std::vector<double>& vertices, std::vector<unsigned char>& colors) const;
+
+
     /** @brief Draws additionally triggered visualisations
      * @param[in] parent The view
      * @param[in] s The settings for the current view (may influence drawing)
@@ -366,6 +383,9 @@ protected:
     /// @brief sets the color according to the current settings
     RGBColor setColor(const GUIVisualizationSettings& s) const;
 
+    /// @brief returns the color according to the current settings
+    RGBColor computeColor(const GUIVisualizationSettings& s) const;
+
     /// @brief returns the seat position for the person with the given index
     const Seat& getSeatPosition(int personIndex) const;
     const Seat& getContainerPosition(int containerIndex) const;
@@ -30,6 +30,7 @@
 #include <utils/options/OptionsCont.h>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/StdDefs.h>
+#include <utils/common/SysUtils.h>
 #include <utils/geom/GeomHelper.h>
 #include <utils/gui/div/GLHelper.h>
 #include <utils/gui/div/GUIParameterTableWindow.h>
@@ -66,6 +67,11 @@
 // ===========================================================================
 const RGBColor GUILane::MESO_USE_LANE_COLOR(0, 0, 0, 0);
 GUIVisualizationSettings* GUILane::myCachedGUISettings(nullptr);
+const int GUILane::NUM_SHAPE_LODS = 5;
+const double GUILane::SHAPE_LOD_TOLERANCE = 0.25;
+const long long GUILane::GEOMETRY_CACHE_TIMEOUT = 60000;
+std::vector<const GUILane*> GUILane::myCachedGeometryLanes;
+int GUILane::myNextCacheSweep = 10000;
 
 
 // ===========================================================================
@@ -80,6 +86,7 @@ GUILane::GUILane(const std::string& id, double maxSpeed, double friction, double
                  const std::string& type) :
     MSLane(id, maxSpeed, friction, length, edge, numericalID, shape, width, permissions, changeLeft, changeRight, index, isRampAccel, type),
     GUIGlObject(GLO_LANE, id, GUIIconSubSys::getIcon(GUIIcon::LANE)),
+    myLastGeometryAccess(-1),
     myParkingAreas(nullptr),
     myTesselation(nullptr),
 #ifdef HAVE_OSG
@@ -87,14 +94,15 @@ GUILane::GUILane(const std::string& id, double maxSpeed, double friction, double
 #endif
     myAmClosed(false),
     myLengthGeometryFactor2(myLengthGeometryFactor),
-    myLock(true) {
+    myLock(true),
+    myFrontSnapshot(0) {
     if (MSGlobals::gUseMesoSim) {
         myShape = splitAtSegments(shape);
+        myShapeIndex.update();
         assert(fabs(myShape.length() - shape.length()) < POSITION_EPS);
         assert(myShapeSegments.size() == myShape.size());
     }
-    initRotations(myShape, myShapeRotations, myShapeLengths, myShapeColors);
-    //
+    // the rotations and lengths of the shape are computed when the lane is drawn the first time
     myHalfLaneWidth = myWidth / 2.;
     myQuarterLaneWidth = myWidth / 4.;
 }
@@ -105,6 +113,8 @@ GUILane::~GUILane() {
     if (myLock.locked()) {
         myLock.unlock();
     }
+    // lanes are only deleted together with the whole network
+    myCachedGeometryLanes.clear();
     delete myParkingAreas;
     delete myTesselation;
 }
@@ -131,6 +141,106 @@ GUILane::initRotations(const PositionVector& shape,
 }
 
 
+PositionVector
+GUILane::simplifyShape(const PositionVector& shape, double tolerance) {
+    if (shape.size() <= 2) {
+        return shape;
+    }
+    std::vector<bool> keep(shape.size(), false);
+    keep.front() = true;
+    keep.back() = true;
+    std::vector<std::pair<int, int> > ranges({std::make_pair(0, (int)shape.size() - 1)});
+    while (!ranges.empty()) {
+        const int first = ranges.back().first;
+        const int last = ranges.back().second;
+        ranges.pop_back();
+        double maxDist = tolerance;
+        int farthest = -1;
+        for (int i = first + 1; i < last; i++) {
+            const double offset = GeomHelper::nearest_offset_on_line_to_point2D(shape[first], shape[last], shape[i], false);
+            const double dist = shape[i].distanceTo2D(PositionVector::positionAtOffset2D(shape[first], shape[last], offset));
+            if (dist > maxDist) {
+                maxDist = dist;
+                farthest = i;
+            }
+        }
+        if (farthest >= 0) {
+            keep[farthest] = true;
+            ranges.push_back(std::make_pair(first, farthest));
+            ranges.push_back(std::make_pair(farthest, last));
+        }
+    }
+    PositionVector result;
+    for (int i = 0; i < (int)shape.size(); i++) {
+        if (keep[i]) {
+            result.push_back(shape[i]);
+        }
+    }
+    return result;
+}
+
+
+void
+GUILane::touchGeometry() const {
+    // drawing happens in the gui thread only
+    const long long now = SysUtils::getCurrentMillis();
+    if (myLastGeometryAccess < 0) {
+        if ((int)myCachedGeometryLanes.size() >= myNextCacheSweep) {
+            // free the geometry of the lanes which were not visible for a while
+            std::vector<const GUILane*> kept;
+            for (const GUILane* const lane : myCachedGeometryLanes) {
+                if (now - lane->myLastGeometryAccess > GEOMETRY_CACHE_TIMEOUT) {
+                    std::vector<double>().swap(lane->myShapeRotations);
+                    std::vector<double>().swap(lane->myShapeLengths);
+                    std::vector<ShapeLOD>().swap(lane->myShapeLODs);
+                    lane->myLastGeometryAccess = -1;
+                } else {
+                    kept.push_back(lane);
+                }
+            }
+            myCachedGeometryLanes.swap(kept);
+            myNextCacheSweep = MAX2(10000, 2 * (int)myCachedGeometryLanes.size());
+        }
+        myCachedGeometryLanes.push_back(this);
+        initRotations(myShape, myShapeRotations, myShapeLengths, myShapeColors);
+    }
+    myLastGeometryAccess = now;
+}
+
+
+const GUILane::ShapeLOD*
+GUILane::getShapeLOD(const GUIVisualizationSettings& s) const {
+    if (s.secondaryShape || myShape.size() <= 2 || s.scale * SHAPE_LOD_TOLERANCE > 0.5) {
+        return nullptr;
+    }
+    touchGeometry();
+    if (myShapeLODs.empty()) {
+        // drawing happens in the gui thread only
+        double tolerance = SHAPE_LOD_TOLERANCE;
+        for (int i = 0; i < NUM_SHAPE_LODS; i++) {
+            ShapeLOD lod;
+            lod.tolerance = tolerance;
+            lod.shape = simplifyShape(myShape, tolerance);
+            initRotations(lod.shape, lod.rotations, lod.lengths, lod.colors);
+            myShapeLODs.push_back(lod);
+            tolerance *= 4;
+        }
+    }
+    // less than half a pixel of deviation is not visible
+    const ShapeLOD* result = nullptr;
+    for (const ShapeLOD& lod : myShapeLODs) {
+        if (lod.tolerance * s.scale > 0.5) {
+            break;
+        }
+        result = &lod;
+    }
+    if (result != nullptr && result->shape.size() == myShape.size()) {
+        return nullptr;
+    }
+    return result;
+}
+
+
 void
 GUILane::addSecondaryShape(const PositionVector& shape) {
     myShape2 = shape;
@@ -579,10 +689,11 @@ GUILane::drawGL(const GUIVisualizationSettings& s) const {
         // check whether it is not too small
         if (s.scale * exaggeration < 1. && junctionExaggeration == 1 && s.junctionSize.minSize != 0) {
             if (!isInternal || hasRailSignal) {
+                const ShapeLOD* const lod = getShapeLOD(s);
                 if (shapeColors.size() > 0) {
                     GLHelper::drawLine(baseShape, shapeColors);
                 } else {
-                    GLHelper::drawLine(baseShape);
+                    GLHelper::drawLine(lod != nullptr ? lod->shape : baseShape);
                 }
             }
             GLHelper::popMatrix();
@@ -655,8 +766,11 @@ GUILane::drawGL(const GUIVisualizationSettings& s) const {
                     offset += halfWidth * 0.5 * (MSGlobals::gLefthand ? -1 : 1);
                     halfWidth *= 0.4; // create visible gap
                 }
+                const ShapeLOD* const lod = cornerDetail == 0 ? getShapeLOD(s) : nullptr;
                 if (shapeColors.size() > 0) {
                     GLHelper::drawBoxLines(baseShape, getShapeRotations(s2), getShapeLengths(s2), shapeColors, halfWidth * exaggeration, cornerDetail, offset);
+                } else if (lod != nullptr) {
+                    GLHelper::drawBoxLines(lod->shape, lod->rotations, lod->lengths, halfWidth * exaggeration, cornerDetail, offset);
                 } else {
                     GLHelper::drawBoxLines(baseShape, getShapeRotations(s2), getShapeLengths(s2), halfWidth * exaggeration, cornerDetail, offset);
                 }
@@ -754,24 +868,90 @@ GUILane::drawGL(const GUIVisualizationSettings& s) const {
         GLHelper::popMatrix();
     }
     // draw vehicles
-    if (s.scale * s.vehicleSize.getExaggeration(s, nullptr) > s.vehicleSize.minSize) {
+    if (s.scale * s.vehicleSize.getExaggeration(s, nullptr) > s.vehicleSize.minSize && !drawRenderSnapshot(s)) {
         // retrieve vehicles from lane; disallow simulation
         const MSLane::VehCont& vehicles = getVehiclesSecure();
+        // vehicles without details are collected and drawn at once (drawing happens in the gui thread only)
+        static std::vector<double> batchVertices;
+        static std::vector<unsigned char> batchColors;
+        batchVertices.clear();
+        batchColors.clear();
         for (MSLane::VehCont::const_iterator v = vehicles.begin(); v != vehicles.end(); ++v) {
             if ((*v)->getLane() == this) {
-                static_cast<const GUIVehicle*>(*v)->drawGL(s);
+                const GUIVehicle* const veh = static_cast<const GUIVehicle*>(*v);
+                if (veh->drawBatched(s)) {
+                    veh->addToBatch(s, batchVertices, batchColors);
+                } else {
+                    veh->drawGL(s);
+                }
             } // else: this is the shadow during a continuous lane change
         }
         // draw parking vehicles
         for (const MSBaseVehicle* const v : myParkingVehicles) {
-            dynamic_cast<const GUIBaseVehicle*>(v)->drawGL(s);
+            const GUIBaseVehicle* const veh = dynamic_cast<const GUIBaseVehicle*>(v);
+            if (veh->drawBatched(s)) {
+                veh->addToBatch(s, batchVertices, batchColors);
+            } else {
+                veh->drawGL(s);
+            }
         }
+        GLHelper::drawTriangles(batchVertices, batchColors);
         // allow lane simulation
         releaseVehicles();
     }
     GLHelper::popName();
 }
 
+
+void
+GUILane::updateRenderSnapshot(const GUIVisualizationSettings& s, const int version) {
+    RenderSnapshot& back = myRenderSnapshots[1 - myFrontSnapshot];
+    back.version = version;
+    back.scale = s.scale;
+    back.complete = true;
+    back.vertices.clear();
+    back.colors.clear();
+    const MSLane::VehCont& vehicles = getVehiclesSecure();
+    for (const MSVehicle* const v : vehicles) {
+        if (v->getLane() == this) {
+            const GUIVehicle* const veh = static_cast<const GUIVehicle*>(v);
+            if (!veh->drawBatched(s)) {
+                back.complete = false;
+                break;
+            }
+            veh->addToBatch(s, back.vertices, back.colors);
+        }
+    }
+    for (const MSBaseVehicle* const v : myParkingVehicles) {
+        const GUIBaseVehicle* const veh = dynamic_cast<const GUIBaseVehicle*>(v);
+        if (!back.complete || !veh->drawBatched(s)) {
+            back.complete = false;
+            break;
+        }
+        veh->addToBatch(s, back.vertices, back.colors);
+    }
+    releaseVehicles();
+    std::lock_guard<std::mutex> lock(mySnapshotLock);
+    myFrontSnapshot = 1 - myFrontSnapshot;
+}
+
+
+bool
+GUILane::drawRenderSnapshot(const GUIVisualizationSettings& s) const {
+    const int version = GUINet::getGUIInstance()->getRenderSnapshotVersion();
+    if (version < 0 || s.drawForPositionSelection || s.drawForRectangleSelection) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mySnapshotLock);
+    const RenderSnapshot& front = myRenderSnapshots[myFrontSnapshot];
+    if (front.version != version || front.scale != s.scale || !front.complete) {
+        return false;
+    }
+    GLHelper::drawTriangles(front.vertices, front.colors);
+    return true;
+}
+
+
 bool
 GUILane::neighLaneNotBidi() const {
     const MSLane* right = getParallelLane(-1, false);
@@ -1064,13 +1244,21 @@ GUILane::getShape(bool secondary) const {
 
 const std::vector<double>&
 GUILane::getShapeRotations(bool secondary) const {
-    return secondary && myShapeRotations2.size() > 0 ? myShapeRotations2 : myShapeRotations;
+    if (secondary && myShapeRotations2.size() > 0) {
+        return myShapeRotations2;
+    }
+    touchGeometry();
+    return myShapeRotations;
 }
 
 
 const std::vector<double>&
 GUILane::getShapeLengths(bool secondary) const {
-    return secondary && myShapeLengths2.size() > 0 ? myShapeLengths2 : myShapeLengths;
+    if (secondary && myShapeLengths2.size() > 0) {
+        return myShapeLengths2;
+    }
+    touchGeometry();
+    return myShapeLengths;
 }
 
 
@@ -23,8 +23,10 @@
 #include <config.h>
 
 #include <utils/foxtools/fxheader.h>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 #include <microsim/MSLane.h>
 #include <microsim/MSEdge.h>
 #include <utils/geom/Position.h>
@@ -206,6 +208,12 @@ public:
     void drawGL(const GUIVisualizationSettings& s) const override;
 
     double getClickPriority() const override;
+
+    /** @brief Records the batched vehicle triangles for drawing without locking the simulation
+     * @param[in] s The published settings of the view (called from the simulation thread after each step)
+     * @param[in] version The version of the published settings
+     */
+    void updateRenderSnapshot(const GUIVisualizationSettings& s, const int version);
     //@}
 
     const PositionVector& getShape(bool secondary) const override;
@@ -327,10 +335,18 @@ private:
     double getPendingEmits() const;
 
 private:
-    void initRotations(const PositionVector& shape,
-                       std::vector<double>& rotations,
-                       std::vector<double>& lengths,
-                       std::vector<RGBColor>& colors);
+    static void initRotations(const PositionVector& shape,
+                              std::vector<double>& rotations,
+                              std::vector<double>& lengths,
+                              std::vector<RGBColor>& colors);
+
+    /** @brief computes the rotations and lengths of the primary shape if needed and marks them as used
+     *
+     * When many lanes have cached geometry, the caches of lanes which were not
+     *  accessed for GEOMETRY_CACHE_TIMEOUT are freed (and recomputed when the
+     *  lane becomes visible again).
+     */
+    void touchGeometry() const;
 
     /// @brief sets multiple colors according to the current scheme index and some lane function
     bool setMultiColor(const GUIVisualizationSettings& s, const GUIColorer& c, RGBColor& col) const;
@@ -346,14 +362,49 @@ private:
 
     std::vector<RGBColor>& getShapeColors(bool secondary) const;
 
-    /// The rotations of the shape parts
-    std::vector<double> myShapeRotations;
+    /// @brief a simplified version of the primary shape for drawing at low zoom
+    struct ShapeLOD {
+        /// @brief the maximum lateral deviation from the original shape
+        double tolerance;
+        PositionVector shape;
+        std::vector<double> rotations;
+        std::vector<double> lengths;
+        std::vector<RGBColor> colors;
+    };
+
+    /// @brief the coarsest simplified shape which deviates less than half a pixel (nullptr if the original shape shall be used)
+    const ShapeLOD* getShapeLOD(const GUIVisualizationSettings& s) const;
+
+    /// @brief removes the geometry points which deviate less than the tolerance from the remaining shape (Douglas-Peucker)
+    static PositionVector simplifyShape(const PositionVector& shape, double tolerance);
+
+    /// @brief the simplified shapes with increasing tolerance (computed on first use)
+    mutable std::vector<ShapeLOD> myShapeLODs;
+
+    /// @brief the number of simplification levels and the tolerance of the finest one
+    static const int NUM_SHAPE_LODS;
+    static const double SHAPE_LOD_TOLERANCE;
+
+    /// The rotations of the shape parts (the primary ones are computed on first use)
+    mutable std::vector<double> myShapeRotations;
     std::vector<double> myShapeRotations2;
 
-    /// The lengths of the shape parts
-    std::vector<double> myShapeLengths;
+    /// The lengths of the shape parts (the primary ones are computed on first use)
+    mutable std::vector<double> myShapeLengths;
     std::vector<double> myShapeLengths2;
 
+    /// @brief the time of the last access to the cached geometry in ms (-1 if there is none)
+    mutable long long myLastGeometryAccess;
+
+    /// @brief the lanes with cached geometry
+    static std::vector<const GUILane*> myCachedGeometryLanes;
+
+    /// @brief the number of cached lanes which triggers freeing unused caches
+    static int myNextCacheSweep;
+
+    /// @brief the time in ms after which unused geometry caches may be freed
+    static const long long GEOMETRY_CACHE_TIMEOUT;
+
     /// The color of the shape parts (cached)
     mutable std::vector<RGBColor> myShapeColors;
     mutable std::vector<RGBColor> myShapeColors2;
@@ -393,9 +444,30 @@ private:
     static GUIVisualizationSettings* myCachedGUISettings;
 
 private:
+    /// @brief the vehicle triangles of one completed simulation step
+    struct RenderSnapshot {
+        /// @brief the settings version and scale used (-1 if empty)
+        int version = -1;
+        double scale = 0.;
+        /// @brief whether all vehicles could be batched (otherwise the snapshot is not used)
+        bool complete = false;
+        std::vector<double> vertices;
+        std::vector<unsigned char> colors;
+    };
+
+    /// @brief draws the front snapshot if it matches the settings, returns whether it was drawn
+    bool drawRenderSnapshot(const GUIVisualizationSettings& s) const;
+
     /// The mutex used to avoid concurrent updates of the vehicle buffer
     mutable FXMutex myLock;
 
+    /// @brief the snapshots written by the simulation thread (back) and drawn by the gui thread (front)
+    RenderSnapshot myRenderSnapshots[2];
+    int myFrontSnapshot;
+
+    /// @brief guards swapping the snapshots against drawing the front one
+    mutable std::mutex mySnapshotLock;
+
     /// @brief special color to signify alternative coloring scheme
     static const RGBColor MESO_USE_LANE_COLOR;
 
@@ -40,6 +40,8 @@
 #include <utils/common/RGBColor.h>
 #include <utils/iodevices/OutputDevice.h>
 #include <utils/gui/div/GLObjectValuePassConnector.h>
+#include <utils/gui/settings/GUIVisualizationSettings.h>
+#include <microsim/MSGlobals.h>
 #include <microsim/MSNet.h>
 #include <microsim/MSEdgeWeightsStorage.h>
 #include <microsim/MSJunction.h>
@@ -86,7 +88,11 @@ GUINet::GUINet(MSVehicleControl* vc, MSEventControl* beginOfTimestepEvents,
     MSNet(vc, beginOfTimestepEvents, endOfTimestepEvents, insertionEvents, new GUIShapeContainer(myGrid)),
     GUIGlObject(GLO_NETWORK, "", nullptr),
     myLastSimDuration(0), /*myLastVisDuration(0),*/ myLastIdleDuration(0),
-    myLastVehicleMovementCount(0), myOverallVehicleCount(0), myOverallSimDuration(0) {
+    myLastVehicleMovementCount(0), myOverallVehicleCount(0), myOverallSimDuration(0),
+    myPublishedSettings(nullptr),
+    myRenderScale(1.),
+    myRenderSettingsVersion(0),
+    myRenderSnapshotsActive(false) {
     GUIGlObjectStorage::gIDStorage.setNetObject(this);
 }
 
@@ -95,6 +101,7 @@ GUINet::~GUINet() {
     if (myLock.locked()) {
         myLock.unlock();
     }
+    delete myPublishedSettings;
     // delete allocated wrappers
     //  of junctions
     for (std::vector<GUIJunctionWrapper*>::iterator i1 = myJunctionWrapper.begin(); i1 != myJunctionWrapper.end(); i1++) {
@@ -236,6 +243,56 @@ GUINet::simulationStep() {
 }
 
 
+void
+GUINet::publishRenderSettings(const GUIVisualizationSettings& s) {
+    if (myPublishedSettings == nullptr || !(*myPublishedSettings == s)) {
+        if (myPublishedSettings == nullptr) {
+            myPublishedSettings = new GUIVisualizationSettings(s.name);
+        }
+        myPublishedSettings->copy(s);
+        std::shared_ptr<GUIVisualizationSettings> settings = std::make_shared<GUIVisualizationSettings>(s.name);
+        settings->copy(s);
+        std::lock_guard<std::mutex> lock(myRenderSettingsLock);
+        myRenderSettings = settings;
+        myRenderScale = s.scale;
+        myRenderSettingsVersion++;
+    } else {
+        std::lock_guard<std::mutex> lock(myRenderSettingsLock);
+        myRenderScale = s.scale;
+    }
+}
+
+
+void
+GUINet::updateRenderSnapshots() {
+    if (!myRenderSnapshotsActive || MSGlobals::gUseMesoSim) {
+        return;
+    }
+    std::shared_ptr<GUIVisualizationSettings> settings;
+    int version;
+    {
+        std::lock_guard<std::mutex> lock(myRenderSettingsLock);
+        if (myRenderSettings == nullptr) {
+            return;
+        }
+        settings = myRenderSettings;
+        settings->scale = myRenderScale;
+        version = myRenderSettingsVersion;
+    }
+    for (const MSEdge* const edge : MSEdge::getAllEdges()) {
+        for (MSLane* const lane : edge->getLanes()) {
+            static_cast<GUILane*>(lane)->updateRenderSnapshot(*settings, version);
+        }
+    }
+}
+
+
+void
+GUINet::setRenderSnapshotsActive(bool active) {
+    myRenderSnapshotsActive = active;
+}
+
+
 std::vector<GUIGlID>
 GUINet::getJunctionIDs(bool includeInternal) const {
     std::vector<GUIGlID> ret;
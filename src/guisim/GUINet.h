@@ -22,6 +22,9 @@
 #pragma once
 #include <config.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <microsim/MSNet.h>
@@ -58,6 +61,7 @@ class GUIVehicle;
 class GUIVehicleControl;
 class MSVehicleControl;
 class GUIMEVehicleControl;
+class GUIVisualizationSettings;
 class Command;
 
 
@@ -160,6 +164,27 @@ public:
      */
     void simulationStep();
 
+    /// @name render snapshots (vehicle geometry prepared by the simulation thread)
+    /// @{
+
+    /** @brief Publishes the settings of the drawing view (called by the gui thread before drawing)
+     *
+     * The settings are copied only if they changed; the scale is always updated.
+     */
+    void publishRenderSettings(const GUIVisualizationSettings& s);
+
+    /// @brief Lets all lanes record their vehicle geometry using the published settings (called by the simulation thread after each step)
+    void updateRenderSnapshots();
+
+    /// @brief En- or disables drawing from the snapshots (they are only used while the simulation is running)
+    void setRenderSnapshotsActive(bool active);
+
+    /// @brief the version of the published settings the snapshots must match or -1 if they shall not be used
+    int getRenderSnapshotVersion() const {
+        return myRenderSnapshotsActive ? myRenderSettingsVersion.load() : -1;
+    }
+    /// @}
+
     /// @name functions for performance measurements
     /// @{
 
@@ -459,4 +484,22 @@ private:
     /// The mutex used to avoid concurrent updates of the vehicle buffer
     mutable FXMutex myLock;
 
+    /// @brief the settings last published by the gui (only accessed by the gui thread)
+    GUIVisualizationSettings* myPublishedSettings;
+
+    /// @brief the copy of the published settings used by the simulation thread (replaced on change)
+    std::shared_ptr<GUIVisualizationSettings> myRenderSettings;
+
+    /// @brief the published scale
+    double myRenderScale;
+
+    /// @brief guards myRenderSettings and myRenderScale
+    std::mutex myRenderSettingsLock;
+
+    /// @brief the version of the published settings (incremented on change)
+    std::atomic<int> myRenderSettingsVersion;
+
+    /// @brief whether the snapshots are drawn
+    std::atomic<bool> myRenderSnapshotsActive;
+
 };
@@ -69,7 +69,7 @@ ROJTREdge::addFollowerProbability(ROJTREdge* follower, double begTime,
 
 
 ROJTREdge*
-ROJTREdge::chooseNext(const ROVehicle* const veh, double time, const std::set<const ROEdge*>& avoid) const {
+ROJTREdge::chooseNext(const ROVehicle* const veh, double time, const std::set<const ROEdge*>& avoid, SumoRNG* rng) const {
     // if no usable follower exist, return 0
     //  their probabilities are not yet regarded
     if (myFollowingEdges.size() == 0 || (veh != nullptr && allFollowersProhibit(veh))) {
@@ -100,7 +100,7 @@ ROJTREdge::chooseNext(const ROVehicle* const veh, double time, const std::set<co
         return nullptr;
     }
     // return one of the possible followers
-    return dist.get();
+    return dist.get(rng);
 }
 
 
@@ -22,6 +22,7 @@
 #pragma once
 #include <config.h>
 
+#include <atomic>
 #include <string>
 #include <map>
 #include <vector>
@@ -33,6 +34,7 @@
 // class declarations
 // ===========================================================================
 class ROLane;
+class SumoRNG;
 
 
 // ===========================================================================
@@ -89,9 +91,10 @@ public:
      * @param[in] veh The vehicle to choose the next edge for
      * @param[in] time The time at which the next edge shall be entered (in seconds)
      * @param[in] avoid The set of edges to avoid
+     * @param[in] rng The random number generator to use (nullptr for the default one)
      * @return The chosen edge
      */
-    ROJTREdge* chooseNext(const ROVehicle* const veh, double time, const std::set<const ROEdge*>& avoid) const;
+    ROJTREdge* chooseNext(const ROVehicle* const veh, double time, const std::set<const ROEdge*>& avoid, SumoRNG* rng = nullptr) const;
 
 
     /** @brief Sets the turning definition defaults
@@ -121,7 +124,7 @@ private:
 
     /// @brief the flows departing from this edge in the given time
     //ValueTimeLine<int> mySourceFlows;
-    int mySourceFlows;
+    std::atomic<int> mySourceFlows;
 
 private:
     /// @brief invalidated copy constructor
@@ -25,6 +25,7 @@
 #include "ROJTRRouter.h"
 #include "ROJTREdge.h"
 #include <utils/common/MsgHandler.h>
+#include <utils/common/ToString.h>
 
 
 // ===========================================================================
@@ -39,11 +40,25 @@ ROJTRRouter::ROJTRRouter(bool unbuildIsWarningOnly, bool acceptAllDestinations,
     myAcceptAllDestination(acceptAllDestinations), myMaxEdges(maxEdges),
     myIgnoreClasses(ignoreClasses),
     myAllowLoops(allowLoops),
-    myDiscountSources(discountSources)
+    myDiscountSources(discountSources),
+    myRNG(nullptr),
+    myNumClones(0)
 { }
 
 
-ROJTRRouter::~ROJTRRouter() {}
+ROJTRRouter::~ROJTRRouter() {
+    delete myRNG;
+}
+
+
+SUMOAbstractRouter<ROEdge, ROVehicle>*
+ROJTRRouter::clone() {
+    ROJTRRouter* const clone = new ROJTRRouter(myUnbuildIsWarningOnly, myAcceptAllDestination, myMaxEdges, myIgnoreClasses, myAllowLoops, myDiscountSources);
+    // the clones are made one after another in the main thread, so the seeds do not depend on the thread timing
+    clone->myRNG = new SumoRNG("jtrrouter_" + toString(myNumClones++));
+    RandHelper::initRand(clone->myRNG, false, RandHelper::rand(std::numeric_limits<int>::max(), myRNG));
+    return clone;
+}
 
 
 bool
@@ -66,7 +81,7 @@ ROJTRRouter::compute(const ROEdge* from, const ROEdge* to,
             avoidEdges.insert(current);
         }
         timeS += current->getTravelTime(vehicle, timeS);
-        current = current->chooseNext(myIgnoreClasses ? nullptr : vehicle, timeS, avoidEdges);
+        current = current->chooseNext(myIgnoreClasses ? nullptr : vehicle, timeS, avoidEdges, myRNG);
         assert(myIgnoreClasses || current == 0 || !current->prohibits(vehicle));
     }
     // check whether no valid ending edge was found
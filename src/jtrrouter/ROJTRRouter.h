@@ -21,6 +21,7 @@
 #pragma once
 #include <config.h>
 
+#include <utils/common/RandHelper.h>
 #include <utils/router/SUMOAbstractRouter.h>
 #include <router/RORoutable.h>
 
@@ -59,9 +60,8 @@ public:
     /// @brief Destructor
     ~ROJTRRouter();
 
-    virtual SUMOAbstractRouter<ROEdge, ROVehicle>* clone() {
-        return new ROJTRRouter(myUnbuildIsWarningOnly, myAcceptAllDestination, myMaxEdges, myIgnoreClasses, myAllowLoops, myDiscountSources);
-    }
+    /// @brief Clones the router for a routing thread, the clone draws the turns from its own random number generator
+    virtual SUMOAbstractRouter<ROEdge, ROVehicle>* clone();
 
     /// @name Implementatios of SUMOAbstractRouter
     /// @{
@@ -97,4 +97,10 @@ private:
 
     /// @brief Whether upstream flows shall be discounted from source flows
     const bool myDiscountSources;
+
+    /// @brief The random number generator of a clone (nullptr for the original which uses the default one)
+    SumoRNG* myRNG;
+
+    /// @brief The number of clones made (used for naming their generators)
+    int myNumClones;
 };
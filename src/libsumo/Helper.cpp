@@ -85,6 +85,7 @@ std::map<int, std::shared_ptr<VariableWrapper> > Helper::myWrapper;
 Helper::VehicleStateListener Helper::myVehicleStateListener;
 Helper::TransportableStateListener Helper::myTransportableStateListener;
 LANE_RTREE_QUAL* Helper::myLaneTree;
+Helper::VehicleGrid Helper::myVehicleGrid;
 std::map<std::string, MSVehicle*> Helper::myRemoteControlledVehicles;
 std::map<std::string, MSPerson*> Helper::myRemoteControlledPersons;
 
@@ -166,11 +167,18 @@ Helper::handleSubscriptions(const SUMOTime t) {
         }
         ++i;
     }
-    for (const libsumo::Subscription& s : mySubscriptions) {
-        if (s.beginTime <= t) {
-            handleSingleSubscription(s);
+    useVehicleGrid(true);
+    try {
+        for (const libsumo::Subscription& s : mySubscriptions) {
+            if (s.beginTime <= t) {
+                handleSingleSubscription(s);
+            }
         }
+    } catch (...) {
+        useVehicleGrid(false);
+        throw;
     }
+    useVehicleGrid(false);
 }
 
 
@@ -431,7 +439,7 @@ Helper::convertCartesianToRoadMap(const Position& pos, const SUMOVehicleClass vC
             MSLane* lane = const_cast<MSLane*>(dynamic_cast<const MSLane*>(named));
             if (lane->allowsVehicleClass(vClass)) {
                 // @todo this may be a place where 3D is required but 2D is used
-                const double newDistance = lane->getShape().distance2D(pos);
+                const double newDistance = lane->getShapeIndex().distance2D(pos);
                 if (newDistance < minDistance ||
                         (newDistance == minDistance
                          && result.first != nullptr
@@ -442,7 +450,7 @@ Helper::convertCartesianToRoadMap(const Position& pos, const SUMOVehicleClass vC
             }
         }
         if (minDistance < std::numeric_limits<double>::max()) {
-            result.second = result.first->interpolateGeometryPosToLanePos(result.first->getShape().nearest_offset_to_point2D(pos, false));
+            result.second = result.first->interpolateGeometryPosToLanePos(result.first->getShapeIndex().nearest_offset_to_point2D(pos, false));
             break;
         }
         range *= 2;
@@ -679,12 +687,13 @@ Helper::cleanup() {
     InductionLoop::cleanup();
     Junction::cleanup();
     LaneArea::cleanup();
-    POI::cleanup();
-    Polygon::cleanup();
     Helper::clearStateChanges();
     Helper::clearSubscriptions();
     delete myLaneTree;
     myLaneTree = nullptr;
+    myVehicleGrid.entries.clear();
+    myVehicleGrid.cellStart.clear();
+    myVehicleGrid.valid = false;
 }
 
 
@@ -802,6 +811,19 @@ Helper::findObjectShape(int domain, const std::string& id, PositionVector& shape
 
 void
 Helper::collectObjectIDsInRange(int domain, const PositionVector& shape, double range, std::set<std::string>& into) {
+    if (domain == libsumo::CMD_GET_VEHICLE_VARIABLE && myVehicleGrid.enabled && !MSGlobals::gUseMesoSim) {
+        std::vector<const MSBaseVehicle*> vehs;
+        collectVehiclesInRange(shape, range, vehs);
+        std::vector<std::string> ids;
+        ids.reserve(vehs.size());
+        for (const MSBaseVehicle* const veh : vehs) {
+            ids.push_back(veh->getID());
+        }
+        // inserting sorted ids into the set takes linear time
+        std::sort(ids.begin(), ids.end());
+        into.insert(ids.begin(), ids.end());
+        return;
+    }
     std::set<const Named*> objects;
     collectObjectsInRange(domain, shape, range, objects);
     for (const Named* obj : objects) {
@@ -860,10 +882,17 @@ Helper::collectObjectsInRange(int domain, const PositionVector& shape, double ra
         case libsumo::CMD_GET_POLYGON_VARIABLE:
             Polygon::getTree()->Search(cmin, cmax, Named::StoringVisitor(into));
             break;
+        case libsumo::CMD_GET_VEHICLE_VARIABLE:
+            if (myVehicleGrid.enabled && !MSGlobals::gUseMesoSim) {
+                std::vector<const MSBaseVehicle*> vehs;
+                collectVehiclesInRange(shape, range, vehs);
+                into.insert(vehs.begin(), vehs.end());
+                break;
+            }
+            FALLTHROUGH;
         case libsumo::CMD_GET_EDGE_VARIABLE:
         case libsumo::CMD_GET_LANE_VARIABLE:
-        case libsumo::CMD_GET_PERSON_VARIABLE:
-        case libsumo::CMD_GET_VEHICLE_VARIABLE: {
+        case libsumo::CMD_GET_PERSON_VARIABLE: {
             if (myLaneTree == nullptr) {
                 myLaneTree = new LANE_RTREE_QUAL(&MSLane::visit);
                 MSLane::fill(*myLaneTree);
@@ -880,6 +909,86 @@ Helper::collectObjectsInRange(int domain, const PositionVector& shape, double ra
 
 
 
+void
+Helper::useVehicleGrid(const bool enable) {
+    myVehicleGrid.enabled = enable;
+    myVehicleGrid.valid = false;
+}
+
+
+void
+Helper::collectVehiclesInRange(const PositionVector& shape, double range, std::vector<const MSBaseVehicle*>& into) {
+    VehicleGrid& g = myVehicleGrid;
+    if (!g.valid) {
+        g.build();
+    }
+    if (g.entries.empty()) {
+        return;
+    }
+    const Boundary b = shape.getBoxBoundary().grow(range);
+    const int x0 = MAX2(0, (int)floor((b.xmin() - g.xmin) / g.cellSize));
+    const int x1 = MIN2(g.numX - 1, (int)floor((b.xmax() - g.xmin) / g.cellSize));
+    const int y0 = MAX2(0, (int)floor((b.ymin() - g.ymin) / g.cellSize));
+    const int y1 = MIN2(g.numY - 1, (int)floor((b.ymax() - g.ymin) / g.cellSize));
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            const int cell = y * g.numX + x;
+            for (int i = g.cellStart[cell]; i < g.cellStart[cell + 1]; i++) {
+                if (shape.distance2D(g.entries[i].first) <= range) {
+                    into.push_back(g.entries[i].second);
+                }
+            }
+        }
+    }
+}
+
+
+void
+Helper::VehicleGrid::build() {
+    // the vehicles which are found by the lane tree (on the lanes or parking)
+    std::vector<std::pair<Position, const MSBaseVehicle*> > vehs;
+    const MSVehicleControl& vc = MSNet::getInstance()->getVehicleControl();
+    for (auto it = vc.loadedVehBegin(); it != vc.loadedVehEnd(); ++it) {
+        const MSVehicle* const veh = dynamic_cast<const MSVehicle*>(it->second);
+        if (veh != nullptr && veh->getLane() != nullptr && (veh->isOnRoad() || veh->isParking())) {
+            vehs.push_back(std::make_pair(veh->getPosition(), veh));
+        }
+    }
+    entries.clear();
+    cellStart.clear();
+    valid = true;
+    if (vehs.empty()) {
+        return;
+    }
+    Boundary b;
+    for (const auto& item : vehs) {
+        b.add(item.first);
+    }
+    xmin = b.xmin();
+    ymin = b.ymin();
+    // not more cells than vehicles but at least 100m per cell
+    cellSize = MAX2(100., sqrt(MAX2(b.getWidth(), 1.) * MAX2(b.getHeight(), 1.) / (double)vehs.size()));
+    numX = (int)(b.getWidth() / cellSize) + 1;
+    numY = (int)(b.getHeight() / cellSize) + 1;
+    std::vector<int> cellOf(vehs.size());
+    cellStart.assign(numX * numY + 1, 0);
+    for (int i = 0; i < (int)vehs.size(); i++) {
+        const int x = MIN2(numX - 1, (int)((vehs[i].first.x() - xmin) / cellSize));
+        const int y = MIN2(numY - 1, (int)((vehs[i].first.y() - ymin) / cellSize));
+        cellOf[i] = y * numX + x;
+        cellStart[cellOf[i] + 1]++;
+    }
+    for (int cell = 0; cell < numX * numY; cell++) {
+        cellStart[cell + 1] += cellStart[cell];
+    }
+    entries.resize(vehs.size());
+    std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < (int)vehs.size(); i++) {
+        entries[fill[cellOf[i]]++] = vehs[i];
+    }
+}
+
+
 void
 Helper::applySubscriptionFilters(const Subscription& s, std::set<std::string>& objIDs) {
 #ifdef DEBUG_SURROUNDING
@@ -1559,14 +1668,15 @@ Helper::moveToXYMap(const Position& pos, double maxRouteDistance, bool mayLeaveN
             const double slack = POSITION_EPS * TS;
             PositionVector laneShape = l->getShape();
             laneShape.extrapolate2D(slack);
+            // the distances are taken at the nearest offsets directly (distance2D would search them again)
             double off = laneShape.nearest_offset_to_point2D(pos, true);
             if (off != GeomHelper::INVALID_OFFSET) {
-                perpendicularDist = laneShape.distance2D(pos, true);
+                perpendicularDist = pos.distanceTo2D(laneShape.positionAtOffset2D(off));
             }
-            off = l->getShape().nearest_offset_to_point2D(pos, perpendicular);
+            off = l->getShapeIndex().nearest_offset_to_point2D(pos, perpendicular);
             if (off != GeomHelper::INVALID_OFFSET) {
-                dist = l->getShape().distance2D(pos, perpendicular);
-                langle = GeomHelper::naviDegree(l->getShape().rotationAtOffset(off));
+                dist = pos.distanceTo2D(l->getShapeIndex().positionAtOffset2D(off));
+                langle = GeomHelper::naviDegree(l->getShapeIndex().rotationAtOffset(off));
             }
             // cannot trust lanePos on walkingArea
             bool sameEdge = onRoad && e == &currentLane->getEdge() && currentRouteEdge->getLength() > currentLanePos + SPEED2DIST(speed) && !e->isWalkingArea();
@@ -1691,7 +1801,7 @@ Helper::findCloserLane(const MSEdge* edge, const Position& pos, SUMOVehicleClass
             // mapping to shapeless lanes is a bad idea
             continue;
         }
-        const double dist = candidateLane->getShape().distance2D(pos); // get distance
+        const double dist = candidateLane->getShapeIndex().distance2D(pos); // get distance
 #ifdef DEBUG_MOVEXY
         std::cout << "   b at lane " << candidateLane->getID() << " dist:" << dist << " best:" << bestDistance << std::endl;
 #endif
@@ -1811,7 +1921,7 @@ Helper::moveToXYMap_matchingRoutePosition(const Position& pos, const std::string
                 if (setLateralPos) {
                     // vehicle might end up on top of another lane with a big
                     // lateral offset to the lane with origID.
-                    const double dist = (*i)->getShape().distance2D(pos); // get distance
+                    const double dist = (*i)->getShapeIndex().distance2D(pos); // get distance
                     if (dist < (*i)->getWidth() / 2) {
                         *lane = *i;
                         break;
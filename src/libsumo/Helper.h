@@ -98,6 +98,14 @@ public:
     static void collectObjectsInRange(int domain, const PositionVector& shape, double range, std::set<const Named*>& into);
     static void collectObjectIDsInRange(int domain, const PositionVector& shape, double range, std::set<std::string>& into);
 
+    /** @brief Enables or disables the vehicle grid shared by all range queries
+     *
+     * While enabled, vehicle range queries use a grid of the vehicle positions
+     *  which is built on the first query. The vehicles must not move while
+     *  the grid is enabled (it is meant for processing all subscriptions of a step).
+     */
+    static void useVehicleGrid(const bool enable);
+
     /**
      * @brief Filter the given ID-Set (which was obtained from an R-Tree search)
      *        according to the filters set by the subscription or firstly build the object ID list if
@@ -243,6 +251,9 @@ private:
 
     static void debugPrint(const SUMOTrafficObject* veh);
 
+    /// @brief collects the vehicles within range of the shape from the vehicle grid
+    static void collectVehiclesInRange(const PositionVector& shape, double range, std::vector<const MSBaseVehicle*>& into);
+
 private:
     class VehicleStateListener : public MSNet::VehicleStateListener {
     public:
@@ -276,6 +287,27 @@ private:
     /// @brief A lookup tree of lanes
     static LANE_RTREE_QUAL* myLaneTree;
 
+    /// @brief uniform grid of the vehicle positions (cell contents stored consecutively)
+    struct VehicleGrid {
+        /// @brief whether the grid shall be used for range queries
+        bool enabled = false;
+        /// @brief whether the grid was built for the current vehicle positions
+        bool valid = false;
+        double xmin = 0;
+        double ymin = 0;
+        double cellSize = 1;
+        int numX = 0;
+        int numY = 0;
+        /// @brief the index of the first entry of each cell (and the number of entries at the end)
+        std::vector<int> cellStart;
+        /// @brief the vehicles with their positions sorted by cell
+        std::vector<std::pair<Position, const MSBaseVehicle*> > entries;
+
+        /// @brief builds the grid from all vehicles on the network
+        void build();
+    };
+    static VehicleGrid myVehicleGrid;
+
     static std::map<std::string, MSVehicle*> myRemoteControlledVehicles;
     static std::map<std::string, MSPerson*> myRemoteControlledPersons;
 
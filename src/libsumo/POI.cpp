@@ -39,7 +39,6 @@ namespace libsumo {
 // ===========================================================================
 SubscriptionResults POI::mySubscriptionResults;
 ContextSubscriptionResults POI::myContextSubscriptionResults;
-NamedRTree* POI::myTree(nullptr);
 
 
 // ===========================================================================
@@ -158,30 +157,16 @@ bool
 POI::add(const std::string& poiID, double x, double y, const TraCIColor& color, const std::string& poiType,
          int layer, const std::string& imgFile, double width, double height, double angle, const std::string& icon) {
     ShapeContainer& shapeCont = MSNet::getInstance()->getShapeContainer();
-    bool ok = shapeCont.addPOI(poiID, poiType, Helper::makeRGBColor(color),
+    return shapeCont.addPOI(poiID, poiType, Helper::makeRGBColor(color),
                                Position(x, y), false, "", 0, false, 0, icon, layer,
                                angle, imgFile, Shape::DEFAULT_RELATIVEPATH,
                                width, height);
-    if (ok && myTree != nullptr) {
-        PointOfInterest* p = shapeCont.getPOIs().get(poiID);
-        const float cmin[2] = {(float)p->x(), (float)p->y()};
-        const float cmax[2] = {(float)p->x(), (float)p->y()};
-        myTree->Insert(cmin, cmax, p);
-    }
-    return ok;
 }
 
 
 bool
 POI::remove(const std::string& poiID, int /* layer */) {
-    ShapeContainer& shapeCont = MSNet::getInstance()->getShapeContainer();
-    PointOfInterest* p = shapeCont.getPOIs().get(poiID);
-    if (p != nullptr && myTree != nullptr) {
-        const float cmin[2] = {(float)p->x(), (float)p->y()};
-        const float cmax[2] = {(float)p->x(), (float)p->y()};
-        myTree->Remove(cmin, cmax, p);
-    }
-    return shapeCont.removePOI(poiID);
+    return MSNet::getInstance()->getShapeContainer().removePOI(poiID);
 }
 
 
@@ -262,22 +247,7 @@ POI::getPoI(const std::string& id) {
 
 NamedRTree*
 POI::getTree() {
-    if (myTree == nullptr) {
-        myTree = new NamedRTree();
-        ShapeContainer& shapeCont = MSNet::getInstance()->getShapeContainer();
-        for (const auto& i : shapeCont.getPOIs()) {
-            const float cmin[2] = {(float)i.second->x(), (float)i.second->y()};
-            const float cmax[2] = {(float)i.second->x(), (float)i.second->y()};
-            myTree->Insert(cmin, cmax, i.second);
-        }
-    }
-    return myTree;
-}
-
-void
-POI::cleanup() {
-    delete myTree;
-    myTree = nullptr;
+    return MSNet::getInstance()->getShapeContainer().getPOITree();
 }
 
 
@@ -77,7 +77,6 @@ public:
      *  @return The rtree of PoIs
      */
     static NamedRTree* getTree();
-    static void cleanup();
 
     /** @brief Saves the shape of the requested object in the given container
     *  @param id The id of the poi to retrieve
@@ -96,7 +95,6 @@ private:
 private:
     static SubscriptionResults mySubscriptionResults;
     static ContextSubscriptionResults myContextSubscriptionResults;
-    static NamedRTree* myTree;
 #endif
 #endif
 
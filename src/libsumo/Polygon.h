@@ -70,7 +70,6 @@ public:
      * @return The rtree of polygons
      */
     static NamedRTree* getTree();
-    static void cleanup();
 
     /** @brief Saves the shape of the requested object in the given container
     *  @param id The id of the poi to retrieve
@@ -95,7 +94,6 @@ private:
 private:
     static SubscriptionResults mySubscriptionResults;
     static ContextSubscriptionResults myContextSubscriptionResults;
-    static NamedRTree* myTree;
 #endif
 #endif
 
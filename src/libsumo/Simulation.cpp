@@ -20,17 +20,26 @@
 // C++ TraCI client API implementation
 /****************************************************************************/
 #include <config.h>
+#include <limits>
+#ifndef WIN32
+#include <sys/types.h>
+#include <unistd.h>
+#endif
 #ifdef HAVE_VERSION_H
 #include <version.h>
 #endif
 #include <utils/options/OptionsCont.h>
 #include <utils/common/MsgHandler.h>
+#include <utils/common/PerformanceCounters.h>
+#include <utils/common/RandHelper.h>
 #include <utils/common/StdDefs.h>
 #include <utils/common/StringTokenizer.h>
 #include <utils/common/StringUtils.h>
 #include <utils/common/SystemFrame.h>
 #include <utils/geom/GeoConvHelper.h>
+#include <utils/iodevices/OutputDevice.h>
 #include <utils/options/OptionsIO.h>
+#include <utils/router/DistanceMatrix.h>
 #include <utils/router/IntermodalRouter.h>
 #include <utils/router/PedestrianRouter.h>
 #include <utils/xml/XMLSubSys.h>
@@ -43,6 +52,7 @@
 #include <microsim/MSVehicleControl.h>
 #include <microsim/MSVehicleTransfer.h>
 #include <microsim/transportables/MSTransportableControl.h>
+#include <microsim/MSStateCheckpoints.h>
 #include <microsim/MSStateHandler.h>
 #include <microsim/MSStoppingPlace.h>
 #include <microsim/MSParkingArea.h>
@@ -50,6 +60,10 @@
 #include <microsim/trigger/MSChargingStation.h>
 #include <microsim/trigger/MSOverheadWire.h>
 #include <microsim/devices/MSDevice_Tripinfo.h>
+#include <microsim/devices/MSDevice_ToC.h>
+#include <microsim/devices/MSDevice_BTreceiver.h>
+#include <microsim/MSDriverState.h>
+#include <microsim/MSRouteHandler.h>
 #include <mesosim/MELoop.h>
 #include <mesosim/MESegment.h>
 #include <netload/NLBuilder.h>
@@ -605,6 +619,60 @@ Simulation::findRoute(const std::string& from, const std::string& to, const std:
 }
 
 
+std::vector<TraCIStage>
+Simulation::findRoutesMatrix(const std::vector<std::string>& fromEdges, const std::vector<std::string>& toEdges, const std::string& typeID, const double depart, const int routingMode) {
+    std::vector<TraCIStage> result;
+    if (fromEdges.empty() || toEdges.empty()) {
+        return result;
+    }
+    std::vector<const MSEdge*> origins;
+    std::vector<const MSEdge*> destinations;
+    for (const std::string& from : fromEdges) {
+        origins.push_back(MSEdge::dictionary(from));
+        if (origins.back() == nullptr) {
+            throw TraCIException("Unknown from edge '" + from + "'.");
+        }
+    }
+    for (const std::string& to : toEdges) {
+        destinations.push_back(MSEdge::dictionary(to));
+        if (destinations.back() == nullptr) {
+            throw TraCIException("Unknown to edge '" + to + "'.");
+        }
+    }
+    MSVehicleType* type = MSNet::getInstance()->getVehicleControl().getVType(typeID == "" ? DEFAULT_VTYPE_ID : typeID);
+    if (type == nullptr) {
+        throw TraCIException("The vehicle type '" + typeID + "' is not known.");
+    }
+    SUMOVehicleParameter* pars = new SUMOVehicleParameter();
+    pars->id = "simulation.findRoutesMatrix";
+    SUMOVehicle* vehicle = nullptr;
+    try {
+        ConstMSRoutePtr const routeDummy = std::make_shared<MSRoute>("", ConstMSEdgeVector({ origins.front() }), false, nullptr, std::vector<SUMOVehicleParameter::Stop>());
+        vehicle = MSNet::getInstance()->getVehicleControl().buildVehicle(pars, routeDummy, type, false);
+        // we need to fix the speed factor here for deterministic results
+        vehicle->setChosenSpeedFactor(type->getSpeedFactor().getParameter()[0]);
+    } catch (ProcessError& e) {
+        throw TraCIException("Could not build a vehicle of type '" + type->getID() + "' (" + e.what() + ")");
+    }
+    const SUMOTime dep = depart < 0 ? MSNet::getInstance()->getCurrentTimeStep() : TIME2STEPS(depart);
+    SUMOAbstractRouter<MSEdge, SUMOVehicle>& router = routingMode == ROUTING_MODE_AGGREGATED ? MSRoutingEngine::getRouterTT(0, vehicle->getVClass()) : MSNet::getInstance()->getRouterTT(0);
+    std::vector<double> costs;
+    std::vector<double> lengths;
+    DistanceMatrix<MSEdge, SUMOVehicle>::compute(router, origins, destinations, vehicle, dep, MSGlobals::gNumThreads, costs, lengths);
+    MSNet::getInstance()->getVehicleControl().deleteVehicle(vehicle, true);
+    for (int i = 0; i < (int)costs.size(); i++) {
+        result.emplace_back(STAGE_DRIVING);
+        if (costs[i] != INVALID_DOUBLE) {
+            result.back().travelTime = result.back().cost = costs[i];
+            result.back().length = lengths[i];
+        } else {
+            result.back().travelTime = result.back().cost = result.back().length = INVALID_DOUBLE_VALUE;
+        }
+    }
+    return result;
+}
+
+
 std::vector<TraCIStage>
 Simulation::findIntermodalRoute(const std::string& from, const std::string& to,
                                 const std::string& modes, double depart, const int routingMode, double speed, double walkFactor,
@@ -819,6 +887,12 @@ Simulation::getParameter(const std::string& objectID, const std::string& key) {
         }
         const std::string attrName = key.substr(16);
         return MSDevice_Tripinfo::getGlobalParameter(attrName);
+    } else if (StringUtils::startsWith(key, "performance.")) {
+        std::string value;
+        if (!PerformanceCounters::getValue(key.substr(12), value)) {
+            throw TraCIException("Invalid performance parameter '" + key.substr(12) + "'");
+        }
+        return value;
     } else if (objectID == "") {
         return MSNet::getInstance()->getParameter(key, "");
     } else {
@@ -853,6 +927,44 @@ Simulation::saveState(const std::string& fileName) {
     MSStateHandler::saveState(fileName, MSNet::getInstance()->getCurrentTimeStep());
 }
 
+int
+Simulation::fork(int numChildren) {
+#ifdef WIN32
+    UNUSED_PARAMETER(numChildren);
+    throw TraCIException("Forking a simulation is not supported on Windows.");
+#else
+    if (hasGUI()) {
+        throw TraCIException("Forking a simulation is not supported with the GUI.");
+    }
+    // avoid duplicating buffered output into the children
+    OutputDevice::flushAll();
+    std::cout.flush();
+    std::cerr.flush();
+    for (int child = 1; child <= numChildren; child++) {
+        const pid_t pid = ::fork();
+        if (pid < 0) {
+            throw TraCIException("Forking the simulation failed.");
+        }
+        if (pid == 0) {
+            // derive new seeds from the current stream states so the children differ but stay reproducible
+            std::vector<SumoRNG*> rngs = {nullptr, MSRouteHandler::getParsingRNG(), MSDevice::getEquipmentRNG(), OUProcess::getRNG(),
+                                          MSDevice_ToC::getResponseTimeRNG(), MSDevice_BTreceiver::getRNG(), MSDevice_BTreceiver::getRecognitionRNG(),
+                                          MSNet::getInstance()->getInsertionControl().getFlowRNG()
+                                         };
+            for (int i = 0; i < MSLane::getNumRNGs(); i++) {
+                rngs.push_back(MSLane::getRNGByIndex(i));
+            }
+            for (SumoRNG* rng : rngs) {
+                RandHelper::initRand(rng, false, RandHelper::rand(std::numeric_limits<int>::max(), rng) ^ (child * 7919));
+            }
+            return child;
+        }
+    }
+    return 0;
+#endif
+}
+
+
 double
 Simulation::loadState(const std::string& fileName) {
     long before = PROGRESS_BEGIN_TIME_MESSAGE("Loading state from '" + fileName + "'");
@@ -869,6 +981,35 @@ Simulation::loadState(const std::string& fileName) {
     }
 }
 
+void
+Simulation::saveCheckpoint(int maxCheckpoints) {
+    MSStateCheckpoints::save(maxCheckpoints);
+}
+
+
+double
+Simulation::loadCheckpoint(double time) {
+    try {
+        const SUMOTime newTime = MSStateCheckpoints::load(time == libsumo::INVALID_DOUBLE_VALUE ? -1 : TIME2STEPS(time));
+        Helper::clearStateChanges();
+        Helper::clearSubscriptions();
+        return STEPS2TIME(newTime);
+    } catch (const ProcessError& e) {
+        throw TraCIException(std::string("Loading checkpoint failed. ") + e.what());
+    }
+}
+
+
+std::vector<double>
+Simulation::getCheckpointTimes() {
+    std::vector<double> result;
+    for (const SUMOTime t : MSStateCheckpoints::getTimes()) {
+        result.push_back(STEPS2TIME(t));
+    }
+    return result;
+}
+
+
 void
 Simulation::writeMessage(const std::string& msg) {
     WRITE_MESSAGE(msg);
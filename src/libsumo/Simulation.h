@@ -53,6 +53,9 @@ public:
 
     static void setOrder(int order);
 
+    /// @brief collect set commands and send them in one message before the next other command
+    static void setBatchMode(bool batch);
+
 #endif
 
     static std::pair<int, std::string> start(const std::vector<std::string>& cmd, int port = -1, int numRetries = libsumo::DEFAULT_NUM_RETRIES,
@@ -147,6 +150,13 @@ public:
 
     static libsumo::TraCIStage findRoute(const std::string& fromEdge, const std::string& toEdge, const std::string& vType = "", const double depart = -1., const int routingMode = 0);
 
+    /* @brief computes the routes from all origins to all destinations
+     * @return the stages for all pairs in row major order (only travelTime, cost and length are filled,
+     *  they are INVALID_DOUBLE_VALUE if there is no connection)
+     */
+    static std::vector<libsumo::TraCIStage> findRoutesMatrix(const std::vector<std::string>& fromEdges, const std::vector<std::string>& toEdges,
+            const std::string& vType = "", const double depart = -1., const int routingMode = 0);
+
     /* @note: default arrivalPos is not -1 because this would lead to very short walks when moving against the edge direction,
      * instead the middle of the edge is used. DepartPos is treated differently so that 1-edge walks do not have length 0.
      */
@@ -164,6 +174,26 @@ public:
     static void saveState(const std::string& fileName);
     /// @brief quick-load simulation state from file and return the state time
     static double loadState(const std::string& fileName);
+    /** @brief create numChildren copies of the running simulation process (POSIX only)
+     *
+     * The children share the current state copy-on-write and get freshly seeded random number generators.
+     * @return 0 in the calling process and the index of the copy (starting at 1) in the children
+     */
+    static int fork(int numChildren = 1);
+    /** @brief keep the current simulation state in memory for a later loadCheckpoint
+     *
+     * Only the parts of the state which differ from the other checkpoints need additional memory.
+     * @param[in] maxCheckpoints The number of checkpoints to keep, the oldest ones are discarded
+     */
+    static void saveCheckpoint(int maxCheckpoints = 10);
+    /** @brief restore the newest checkpoint not later than the given time (the newest one by default)
+     *
+     * The checkpoints saved after the restored one are discarded.
+     * @return the state time
+     */
+    static double loadCheckpoint(double time = libsumo::INVALID_DOUBLE_VALUE);
+    /// @brief the times of the saved checkpoints from the oldest to the newest
+    static std::vector<double> getCheckpointTimes();
     static void writeMessage(const std::string& msg);
 
     static void subscribe(const std::vector<int>& varIDs = std::vector<int>(), double begin = libsumo::INVALID_DOUBLE_VALUE, double end = libsumo::INVALID_DOUBLE_VALUE, const libsumo::TraCIResults& params = libsumo::TraCIResults());
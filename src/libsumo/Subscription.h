@@ -99,7 +99,8 @@ public:
           filterVTypes(),
           filterVClasses(0),
           filterFieldOfVisionOpeningAngle(-1),
-          filterLateralDist(-1) {}
+          filterLateralDist(-1),
+          deltaMode(false) {}
 
     bool isVehicleToVehicleContextSubscription() const {
         return commandId == CMD_SUBSCRIBE_VEHICLE_CONTEXT && contextDomain == CMD_GET_VEHICLE_VARIABLE;
@@ -144,6 +145,10 @@ public:
     double filterFieldOfVisionOpeningAngle;
     /// @brief Lateral distance specified by the lateral distance filter
     double filterLateralDist;
+    /// @brief Whether only changed values are sent (variable subscriptions via TraCI only)
+    bool deltaMode;
+    /// @brief The encoded values sent last for each variable (only used in delta mode)
+    std::vector<std::string> lastValues;
 };
 
 class VariableWrapper {
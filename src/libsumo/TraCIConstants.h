@@ -61,6 +61,9 @@ TRACI_CONST int CMD_SIMSTEP = 0x02;
 // command: set connection priority (execution order)
 TRACI_CONST int CMD_SETORDER = 0x03;
 
+// command: switch the connection to a shared memory transport
+TRACI_CONST int CMD_SHARED_MEMORY = 0x7c;
+
 // command: stop vehicle
 TRACI_CONST int CMD_STOP = 0x12;
 
@@ -686,6 +689,9 @@ TRACI_CONST int FILTER_TYPE_FIELD_OF_VISION = 0x0A;
 // Only return vehicles within the given lateral distance in context subscription result
 TRACI_CONST int FILTER_TYPE_LATERAL_DIST = 0x0B;
 
+// Only send the variables of the last variable subscription which changed since the previous step
+TRACI_CONST int FILTER_TYPE_DELTA = 0x0C;
+
 // ****************************************
 // VARIABLE TYPES (for CMD_GET_*_VARIABLE)
 // ****************************************
@@ -70,6 +70,8 @@ static const libsumo::SubscriptionResults getAllSubscriptionResults(); \
 static const libsumo::TraCIResults getSubscriptionResults(const std::string& objectID); \
 static const libsumo::ContextSubscriptionResults getAllContextSubscriptionResults(); \
 static const libsumo::SubscriptionResults getContextSubscriptionResults(const std::string& objectID); \
+static const std::vector<std::string> getSubscriptionColumnIDs(); \
+static const std::vector<double> getSubscriptionColumn(int varID); \
 static void subscribeParameterWithKey(const std::string& objectID, const std::string& key, double beginTime = libsumo::INVALID_DOUBLE_VALUE, double endTime = libsumo::INVALID_DOUBLE_VALUE); \
 static const int DOMAIN_ID;
 
@@ -107,6 +109,14 @@ const libsumo::SubscriptionResults \
 CLASS::getContextSubscriptionResults(const std::string& objectID) { \
     return myContextSubscriptionResults[objectID]; \
 } \
+const std::vector<std::string> \
+CLASS::getSubscriptionColumnIDs() { \
+    return libsumo::getSubscriptionColumnIDs(mySubscriptionResults); \
+} \
+const std::vector<double> \
+CLASS::getSubscriptionColumn(int varID) { \
+    return libsumo::getSubscriptionColumn(mySubscriptionResults, varID); \
+} \
 void \
 CLASS::subscribeParameterWithKey(const std::string& objectID, const std::string& key, double beginTime, double endTime) { \
     libsumo::Helper::subscribe(libsumo::CMD_SUBSCRIBE_##DOM##_VARIABLE, objectID, std::vector<int>({libsumo::VAR_PARAMETER_WITH_KEY}), beginTime, endTime, libsumo::TraCIResults {{libsumo::VAR_PARAMETER_WITH_KEY, std::make_shared<libsumo::TraCIString>(key)}}); \
@@ -337,6 +347,39 @@ typedef std::map<int, std::shared_ptr<libsumo::TraCIResult> > TraCIResults;
 typedef std::map<std::string, libsumo::TraCIResults> SubscriptionResults;
 typedef std::map<std::string, libsumo::SubscriptionResults> ContextSubscriptionResults;
 
+#ifndef SWIG
+/// @brief the ids of all objects with subscription results in the order of the columns
+inline std::vector<std::string>
+getSubscriptionColumnIDs(const SubscriptionResults& results) {
+    std::vector<std::string> ids;
+    ids.reserve(results.size());
+    for (const auto& item : results) {
+        ids.push_back(item.first);
+    }
+    return ids;
+}
+
+/// @brief the numerical values of the variable for all objects with subscription results (INVALID_DOUBLE_VALUE if missing or not numerical)
+inline std::vector<double>
+getSubscriptionColumn(const SubscriptionResults& results, const int variable) {
+    std::vector<double> column;
+    column.reserve(results.size());
+    for (const auto& item : results) {
+        double value = INVALID_DOUBLE_VALUE;
+        const auto it = item.second.find(variable);
+        if (it != item.second.end()) {
+            if (it->second->getType() == TYPE_DOUBLE) {
+                value = static_cast<const TraCIDouble*>(it->second.get())->value;
+            } else if (const TraCIInt* const intResult = dynamic_cast<const TraCIInt*>(it->second.get())) {
+                value = intResult->value;
+            }
+        }
+        column.push_back(value);
+    }
+    return column;
+}
+#endif
+
 
 class TraCIPhase {
 public:
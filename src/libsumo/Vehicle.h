@@ -117,6 +117,15 @@ public:
     static std::vector<std::string> getTeleportingIDList();
     /// @}
 
+    /// @name Bulk value retrieval (one value per given vehicle in the given order)
+    /// @{
+    static std::vector<double> getSpeeds(const std::vector<std::string>& vehIDs);
+    static std::vector<double> getAccelerations(const std::vector<std::string>& vehIDs);
+    static std::vector<double> getLanePositions(const std::vector<std::string>& vehIDs);
+    /// @brief returns the coordinates as [x0, y0, x1, y1, ...]
+    static std::vector<double> getPositions(const std::vector<std::string>& vehIDs);
+    /// @}
+
     LIBSUMO_ID_PARAMETER_API
     LIBSUMO_VEHICLE_TYPE_GETTER
 
@@ -189,6 +198,7 @@ public:
     static void deactivateGapControl(const std::string& vehID);
     static void requestToC(const std::string& vehID, double leadTime);
     static void setSpeed(const std::string& vehID, double speed);
+    static void setSpeeds(const std::vector<std::string>& vehIDs, const std::vector<double>& speeds);
     static void setAcceleration(const std::string& vehID, double acceleration, double duration);
     static void setPreviousSpeed(const std::string& vehID, double prevSpeed, double prevAcceleration = libsumo::INVALID_DOUBLE_VALUE);
     static void setSpeedMode(const std::string& vehID, int speedMode);
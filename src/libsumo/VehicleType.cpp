@@ -407,12 +407,13 @@ VehicleType::setParameter(const std::string& typeID, const std::string& name, co
         }
         try {
             StringUtils::toDouble(value); // check number format
-            ((SUMOVTypeParameter&)getVType(typeID)->getParameter()).jmParameter[attr] = value;
+            getVType(typeID)->setJMParam(attr, value);
         } catch (NumberFormatException&) {
             throw TraCIException("Invalid junctionModel parameter value '" + value + "' for type '" + typeID + " (should be numeric)'");
         }
     } else {
         ((SUMOVTypeParameter&)getVType(typeID)->getParameter()).setParameter(name, value);
+        getVType(typeID)->resetDeviceAssignments();
     }
 }
 
@@ -42,7 +42,7 @@ std::map<const std::string, Connection*> Connection::myConnections;
 // member method definitions
 // ===========================================================================
 Connection::Connection(const std::string& host, int port, int numRetries, const std::string& label, FILE* const pipe) :
-    myLabel(label), myProcessPipe(pipe), myProcessReader(nullptr), mySocket(host, port) {
+    myLabel(label), myProcessPipe(pipe), myProcessReader(nullptr), mySocket(host, port), myAmBatching(false) {
     if (pipe != nullptr) {
         myProcessReader = new std::thread(&Connection::readOutput, this);
     }
@@ -89,6 +89,7 @@ void
 Connection::close() {
     if (mySocket.has_client_connection()) {
         std::unique_lock<std::mutex> lock{ myMutex };
+        sendBatch();
         tcpip::Storage outMsg;
         // command length
         outMsg.writeUnsignedByte(1 + 1);
@@ -120,6 +121,7 @@ Connection::close() {
 void
 Connection::simulationStep(double time) {
     std::unique_lock<std::mutex> lock{myMutex};
+    sendBatch();
     tcpip::Storage outMsg;
     // command length
     outMsg.writeUnsignedByte(1 + 1 + 8);
@@ -149,6 +151,7 @@ Connection::simulationStep(double time) {
 void
 Connection::setOrder(int order) {
     std::unique_lock<std::mutex> lock{ myMutex };
+    sendBatch();
     tcpip::Storage outMsg;
     // command length
     outMsg.writeUnsignedByte(1 + 1 + 4);
@@ -163,6 +166,58 @@ Connection::setOrder(int order) {
 }
 
 
+void
+Connection::useSharedMemory(int capacity, const std::string& name) {
+    std::unique_lock<std::mutex> lock{ myMutex };
+    sendBatch();
+    mySocket.mapSharedMemory(name, capacity, true);
+    const std::string& shmName = mySocket.sharedMemoryName();
+    tcpip::Storage outMsg;
+    // command length (extended)
+    outMsg.writeUnsignedByte(0);
+    outMsg.writeInt(1 + 4 + 1 + 4 + (int)shmName.size() + 4);
+    // command id
+    outMsg.writeUnsignedByte(libsumo::CMD_SHARED_MEMORY);
+    outMsg.writeString(shmName);
+    outMsg.writeInt(capacity);
+    mySocket.sendExact(outMsg);
+
+    tcpip::Storage inMsg;
+    check_resultState(inMsg, libsumo::CMD_SHARED_MEMORY);
+    mySocket.useSharedMemory();
+}
+
+
+void
+Connection::setBatchMode(bool batch) {
+    std::unique_lock<std::mutex> lock{ myMutex };
+    if (!batch) {
+        sendBatch();
+    }
+    myAmBatching = batch;
+}
+
+
+void
+Connection::sendBatch() {
+    if (myBatchCommands.empty()) {
+        return;
+    }
+    // reset the batch first, so that an error does not leave it in a half sent state
+    tcpip::Storage outMsg;
+    outMsg.writeStorage(myBatch);
+    myBatch.reset();
+    const std::vector<int> commands(std::move(myBatchCommands));
+    myBatchCommands.clear();
+    mySocket.sendExact(outMsg);
+    tcpip::Storage inMsg;
+    mySocket.receiveExact(inMsg);
+    for (const int command : commands) {
+        readResultState(inMsg, command);
+    }
+}
+
+
 void
 Connection::createCommand(int cmdID, int varID, const std::string* const objID, tcpip::Storage* add) const {
     if (!mySocket.has_client_connection()) {
@@ -247,6 +302,7 @@ Connection::subscribe(int domID, const std::string& objID, double beginTime, dou
     complete.writeInt(5 + (int)outMsg.size());
     complete.writeStorage(outMsg);
     std::unique_lock<std::mutex> lock{ myMutex };
+    sendBatch();
     // send message
     mySocket.sendExact(complete);
 
@@ -266,6 +322,12 @@ Connection::subscribe(int domID, const std::string& objID, double beginTime, dou
 void
 Connection::check_resultState(tcpip::Storage& inMsg, int command, bool ignoreCommandId, std::string* acknowledgement) {
     mySocket.receiveExact(inMsg);
+    readResultState(inMsg, command, ignoreCommandId, acknowledgement);
+}
+
+
+void
+Connection::readResultState(tcpip::Storage& inMsg, int command, bool ignoreCommandId, std::string* acknowledgement) {
     int cmdLength;
     int cmdId;
     int resultType;
@@ -327,6 +389,7 @@ Connection::check_commandGetResult(tcpip::Storage& inMsg, int command, int expec
 
 tcpip::Storage&
 Connection::doCommand(int command, int var, const std::string& id, tcpip::Storage* add, int expectedType) {
+    sendBatch();
     createCommand(command, var, &id, add);
     mySocket.sendExact(myOutput);
     myInput.reset();
@@ -338,9 +401,22 @@ Connection::doCommand(int command, int var, const std::string& id, tcpip::Storag
 }
 
 
+void
+Connection::doSetCommand(int command, int var, const std::string& id, tcpip::Storage* add) {
+    if (!myAmBatching) {
+        doCommand(command, var, id, add);
+        return;
+    }
+    createCommand(command, var, &id, add);
+    myBatch.writeStorage(myOutput);
+    myBatchCommands.push_back(command);
+}
+
+
 void
 Connection::addFilter(int var, tcpip::Storage* add) {
     std::unique_lock<std::mutex> lock{ myMutex };
+    sendBatch();
     createCommand(libsumo::CMD_ADD_SUBSCRIPTION_FILTER, var, nullptr, add);
     mySocket.sendExact(myOutput);
     myInput.reset();
@@ -100,6 +100,25 @@ public:
      */
     void setOrder(int order);
 
+    /** @brief Switches the connection to shared memory ring buffers
+     *
+     * Only possible if client and server run on the same host. The TCP
+     *  connection stays open but is no longer used for data.
+     * @param[in] capacity The size of each of the two ring buffers in bytes
+     * @param[in] name The name of the segment (a file name on POSIX systems), chosen automatically if empty
+     */
+    void useSharedMemory(int capacity = 1 << 24, const std::string& name = "");
+
+    /** @brief Switches the collection of set commands on or off
+     *
+     * In batch mode the commands given to doSetCommand are not sent immediately
+     *  but collected and sent as a single message (answered by a single message)
+     *  before the next command which is not a set command. Errors of collected
+     *  commands are reported when the batch is sent. Switching the batch mode off
+     *  sends the collected commands.
+     */
+    void setBatchMode(bool batch);
+
     /** @brief Sends a GetVariable / SetVariable request if mySocket is connected.
      * Otherwise writes to myOutput only.
      * @param[in] cmdID The command and domain of the variable
@@ -126,6 +145,9 @@ public:
 
 
     tcpip::Storage& doCommand(int command, int var = -1, const std::string& id = "", tcpip::Storage* add = nullptr, int expectedType = -1);
+
+    /// @brief Sends a command which only returns a status (or collects it in batch mode)
+    void doSetCommand(int command, int var, const std::string& id, tcpip::Storage* add = nullptr);
     void addFilter(int var, tcpip::Storage* add = nullptr);
 
     void readVariableSubscription(int responseID, tcpip::Storage& inMsg);
@@ -141,6 +163,12 @@ private:
      */
     void check_resultState(tcpip::Storage& inMsg, int command, bool ignoreCommandId = false, std::string* acknowledgement = 0);
 
+    /// @brief Validates the next result state in an already received message (see check_resultState)
+    void readResultState(tcpip::Storage& inMsg, int command, bool ignoreCommandId = false, std::string* acknowledgement = 0);
+
+    /// @brief Sends the collected set commands and checks their results
+    void sendBatch();
+
     /** @brief Validates the result state of a command
      * @return The command Id
      */
@@ -185,6 +213,13 @@ private:
 
     mutable std::mutex myMutex;
 
+    /// @brief Whether set commands are collected
+    bool myAmBatching;
+    /// @brief The collected set commands
+    tcpip::Storage myBatch;
+    /// @brief The ids of the collected set commands
+    std::vector<int> myBatchCommands;
+
     std::map<int, libsumo::SubscriptionResults> mySubscriptionResults;
     std::map<int, libsumo::ContextSubscriptionResults> myContextSubscriptionResults;
 
@@ -69,6 +69,14 @@ const libsumo::SubscriptionResults CLASS::getContextSubscriptionResults(const st
     return libtraci::Connection::getActive().getAllContextSubscriptionResults(libsumo::RESPONSE_SUBSCRIBE_##DOMAIN##_CONTEXT)[objectID]; \
 } \
 \
+const std::vector<std::string> CLASS::getSubscriptionColumnIDs() { \
+    return libsumo::getSubscriptionColumnIDs(libtraci::Connection::getActive().getAllSubscriptionResults(libsumo::RESPONSE_SUBSCRIBE_##DOMAIN##_VARIABLE)); \
+} \
+\
+const std::vector<double> CLASS::getSubscriptionColumn(int varID) { \
+    return libsumo::getSubscriptionColumn(libtraci::Connection::getActive().getAllSubscriptionResults(libsumo::RESPONSE_SUBSCRIBE_##DOMAIN##_VARIABLE), varID); \
+} \
+\
 void CLASS::subscribeParameterWithKey(const std::string& objectID, const std::string& key, double beginTime, double endTime) { \
     subscribe(objectID, std::vector<int>({libsumo::VAR_PARAMETER_WITH_KEY}), beginTime, endTime, libsumo::TraCIResults {{libsumo::VAR_PARAMETER_WITH_KEY, std::make_shared<libsumo::TraCIString>(key)}}); \
 }
@@ -92,7 +100,7 @@ CLASS::setParameter(const std::string& objectID, const std::string& key, const s
     content.writeString(key); \
     content.writeUnsignedByte(libsumo::TYPE_STRING); \
     content.writeString(value); \
-    Connection::getActive().doCommand(libsumo::CMD_SET_##DOMAIN##_VARIABLE, libsumo::VAR_PARAMETER, objectID, &content); \
+    Connection::getActive().doSetCommand(libsumo::CMD_SET_##DOMAIN##_VARIABLE, libsumo::VAR_PARAMETER, objectID, &content); \
 } \
 \
 const std::pair<std::string, std::string> \
@@ -218,7 +226,7 @@ public:
 
     static void set(int var, const std::string& id, tcpip::Storage* add) {
         std::unique_lock<std::mutex> lock{ libtraci::Connection::getActive().getMutex() };
-        libtraci::Connection::getActive().doCommand(SET, var, id, add);
+        libtraci::Connection::getActive().doSetCommand(SET, var, id, add);
     }
 
     static void setInt(int var, const std::string& id, int value) {
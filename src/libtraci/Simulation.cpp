@@ -107,6 +107,12 @@ Simulation::setOrder(int order) {
 }
 
 
+void
+Simulation::setBatchMode(bool batch) {
+    Connection::getActive().setBatchMode(batch);
+}
+
+
 void
 Simulation::load(const std::vector<std::string>& args) {
     std::unique_lock<std::mutex> lock{ libtraci::Connection::getActive().getMutex() };
@@ -509,6 +515,23 @@ Simulation::findRoute(const std::string& fromEdge, const std::string& toEdge, co
 }
 
 
+std::vector<libsumo::TraCIStage>
+Simulation::findRoutesMatrix(const std::vector<std::string>& fromEdges, const std::vector<std::string>& toEdges, const std::string& vType, const double depart, const int routingMode) {
+    // there is no dedicated command, the server answers the single queries
+    std::vector<libsumo::TraCIStage> result;
+    for (const std::string& from : fromEdges) {
+        for (const std::string& to : toEdges) {
+            result.push_back(findRoute(from, to, vType, depart, routingMode));
+            if (result.back().edges.empty()) {
+                result.back().travelTime = result.back().cost = result.back().length = libsumo::INVALID_DOUBLE_VALUE;
+            }
+            result.back().edges.clear();
+        }
+    }
+    return result;
+}
+
+
 std::vector<libsumo::TraCIStage>
 Simulation::findIntermodalRoute(const std::string& fromEdge, const std::string& toEdge,
                                 const std::string& modes, double depart, const int routingMode, double speed, double walkFactor,
@@ -578,6 +601,26 @@ Simulation::loadState(const std::string& fileName) {
     return 0.;
 }
 
+int
+Simulation::fork(int /* numChildren */) {
+    throw libsumo::TraCIException("Forking a simulation is only possible with libsumo.");
+}
+
+void
+Simulation::saveCheckpoint(int /* maxCheckpoints */) {
+    throw libsumo::TraCIException("In-memory checkpoints are only possible with libsumo.");
+}
+
+double
+Simulation::loadCheckpoint(double /* time */) {
+    throw libsumo::TraCIException("In-memory checkpoints are only possible with libsumo.");
+}
+
+std::vector<double>
+Simulation::getCheckpointTimes() {
+    throw libsumo::TraCIException("In-memory checkpoints are only possible with libsumo.");
+}
+
 void
 Simulation::writeMessage(const std::string& msg) {
     Dom::setString(libsumo::CMD_MESSAGE, "", msg);
@@ -646,6 +646,48 @@ Vehicle::getTeleportingIDList() {
     return Dom::getStringVector(libsumo::VAR_TELEPORTING_LIST, "");
 }
 
+std::vector<double>
+Vehicle::getSpeeds(const std::vector<std::string>& vehIDs) {
+    std::vector<double> result;
+    result.reserve(vehIDs.size());
+    for (const std::string& vehID : vehIDs) {
+        result.push_back(getSpeed(vehID));
+    }
+    return result;
+}
+
+std::vector<double>
+Vehicle::getAccelerations(const std::vector<std::string>& vehIDs) {
+    std::vector<double> result;
+    result.reserve(vehIDs.size());
+    for (const std::string& vehID : vehIDs) {
+        result.push_back(getAcceleration(vehID));
+    }
+    return result;
+}
+
+std::vector<double>
+Vehicle::getLanePositions(const std::vector<std::string>& vehIDs) {
+    std::vector<double> result;
+    result.reserve(vehIDs.size());
+    for (const std::string& vehID : vehIDs) {
+        result.push_back(getLanePosition(vehID));
+    }
+    return result;
+}
+
+std::vector<double>
+Vehicle::getPositions(const std::vector<std::string>& vehIDs) {
+    std::vector<double> result;
+    result.reserve(2 * vehIDs.size());
+    for (const std::string& vehID : vehIDs) {
+        const libsumo::TraCIPosition pos = getPosition(vehID);
+        result.push_back(pos.x);
+        result.push_back(pos.y);
+    }
+    return result;
+}
+
 std::string
 Vehicle::getEmissionClass(const std::string& vehID) {
     return Dom::getString(libsumo::VAR_EMISSIONCLASS, vehID);
@@ -996,6 +1038,16 @@ Vehicle::setSpeed(const std::string& vehID, double speed) {
     Dom::setDouble(libsumo::VAR_SPEED, vehID, speed);
 }
 
+void
+Vehicle::setSpeeds(const std::vector<std::string>& vehIDs, const std::vector<double>& speeds) {
+    if (vehIDs.size() != speeds.size()) {
+        throw libsumo::TraCIException("The number of speeds (" + std::to_string(speeds.size()) + ") does not match the number of vehicles (" + std::to_string(vehIDs.size()) + ").");
+    }
+    for (int i = 0; i < (int)vehIDs.size(); i++) {
+        setSpeed(vehIDs[i], speeds[i]);
+    }
+}
+
 void
 Vehicle::setAcceleration(const std::string& vehID, double acceleration, double duration) {
     tcpip::Storage content;
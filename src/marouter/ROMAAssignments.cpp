@@ -355,7 +355,7 @@ ROMAAssignments::incremental(const int numIter, const bool verbose) {
                 const double intervalLengthInHours = STEPS2TIME(end - begin) / 3600.;
                 const ConstROEdgeVector& edges = c->pathsVector.back()->getEdgeVector();
                 for (ConstROEdgeVector::const_iterator e = edges.begin(); e != edges.end(); e++) {
-                    ROMAEdge* edge = static_cast<ROMAEdge*>(myNet.getEdge((*e)->getID()));
+                    ROMAEdge* edge = static_cast<ROMAEdge*>(const_cast<ROEdge*>(*e));
                     const double newFlow = edge->getFlow(STEPS2TIME(begin)) + linkFlow;
                     edge->setFlow(STEPS2TIME(begin), STEPS2TIME(end), newFlow);
                     double travelTime = capacityConstraintFunction(edge, newFlow / intervalLengthInHours);
@@ -377,6 +377,131 @@ ROMAAssignments::incremental(const int numIter, const bool verbose) {
 }
 
 
+void
+ROMAAssignments::updateRouteChoice(std::vector<ODCell*>::const_iterator first, std::vector<ODCell*>::const_iterator last) {
+    for (std::vector<ODCell*>::const_iterator i = first; i != last; ++i) {
+        const ODCell* const c = *i;
+        // update path cost
+        for (std::vector<RORoute*>::const_iterator j = c->pathsVector.begin(); j != c->pathsVector.end(); ++j) {
+            RORoute* r = *j;
+            r->setCosts(myRouter.recomputeCosts(r->getEdgeVector(), myDefaultVehicle, 0));
+            //                    std::cout << std::setprecision(20) << r->getID() << ":" << r->getCosts() << std::endl;
+        }
+        // calculate route utilities and probabilities
+        RouteCostCalculator<RORoute, ROEdge, ROVehicle>::getCalculator().calculateProbabilities(c->pathsVector, myDefaultVehicle, 0);
+    }
+}
+
+
+void
+ROMAAssignments::updateRouteChoice() {
+    const std::vector<ODCell*>& cells = myMatrix.getCells();
+#ifdef HAVE_FOX
+    if (myNet.getThreadPool().size() > 0 && !cells.empty()) {
+        // the cells are independent, so any partition gives the same result
+        const int numTasks = MIN2((int)cells.size(), 4 * myNet.getThreadPool().size());
+        const int chunkSize = ((int)cells.size() + numTasks - 1) / numTasks;
+        for (int i = 0; i < (int)cells.size(); i += chunkSize) {
+            myNet.getThreadPool().add(new RouteChoiceTask(*this, cells.begin() + i, cells.begin() + MIN2(i + chunkSize, (int)cells.size())));
+        }
+        myNet.getThreadPool().waitAll();
+        return;
+    }
+#endif
+    updateRouteChoice(cells.begin(), cells.end());
+}
+
+
+int
+ROMAAssignments::updateEdges(std::vector<ROMAEdge*>::const_iterator first, std::vector<ROMAEdge*>::const_iterator last,
+                             const SUMOTime begin, const SUMOTime end, const bool initial, const int inner, const double tolerance) {
+    const double intervalLengthInHours = STEPS2TIME(end - begin) / 3600.;
+    const double intBegin = STEPS2TIME(begin);
+    const double intEnd = STEPS2TIME(end);
+    int unstableEdges = 0;
+    for (std::vector<ROMAEdge*>::const_iterator e = first; e != last; ++e) {
+        ROMAEdge* edge = *e;
+        const double oldFlow = edge->getFlow(intBegin);
+        double newFlow = oldFlow;
+        if (initial) {
+            newFlow += edge->getHelpFlow(intBegin);
+        } else {
+            newFlow += (edge->getHelpFlow(intBegin) - oldFlow) / (inner + 1);
+        }
+        //                if not lohse:
+        if (newFlow > 0.) {
+            if (fabs(newFlow - oldFlow) / newFlow > tolerance) {
+                unstableEdges++;
+            }
+        } else if (newFlow == 0.) {
+            if (oldFlow != 0. && (fabs(newFlow - oldFlow) / oldFlow > tolerance)) {
+                unstableEdges++;
+            }
+        } else { // newFlow < 0.
+            unstableEdges++;
+            newFlow = 0.;
+        }
+        edge->setFlow(intBegin, intEnd, newFlow);
+        const double travelTime = capacityConstraintFunction(edge, newFlow / intervalLengthInHours);
+        edge->addTravelTime(travelTime, intBegin, intEnd);
+        edge->setHelpFlow(intBegin, intEnd, 0.);
+    }
+    return unstableEdges;
+}
+
+
+int
+ROMAAssignments::updateEdges(const std::vector<ROMAEdge*>& edges, const std::map<const SUMOTime, SUMOTime>& intervals, const bool initial, const int inner, const double tolerance) {
+    int unstableEdges = 0;
+    for (const auto& it : intervals) {
+#ifdef HAVE_FOX
+        if (myNet.getThreadPool().size() > 0 && !edges.empty()) {
+            // every task counts the unstable edges of its own range
+            const int numTasks = MIN2((int)edges.size(), 4 * myNet.getThreadPool().size());
+            const int chunkSize = ((int)edges.size() + numTasks - 1) / numTasks;
+            std::vector<int> unstable(numTasks, 0);
+            for (int i = 0, task = 0; i < (int)edges.size(); i += chunkSize, task++) {
+                myNet.getThreadPool().add(new EdgeUpdateTask(*this, edges.begin() + i, edges.begin() + MIN2(i + chunkSize, (int)edges.size()),
+                                          it.first, it.second, initial, inner, tolerance, unstable[task]));
+            }
+            myNet.getThreadPool().waitAll();
+            for (const int count : unstable) {
+                unstableEdges += count;
+            }
+            continue;
+        }
+#endif
+        unstableEdges += updateEdges(edges.begin(), edges.end(), it.first, it.second, initial, inner, tolerance);
+    }
+    return unstableEdges;
+}
+
+
+bool
+ROMAAssignments::findNewRoutes() {
+    bool newRoute = false;
+#ifdef HAVE_FOX
+    if (myNet.getThreadPool().size() > 0) {
+        // a cell got a new route iff its number of paths grew
+        std::vector<int> numPaths;
+        for (ODCell* const c : myMatrix.getCells()) {
+            numPaths.push_back((int)c->pathsVector.size());
+            myNet.getThreadPool().add(new RoutingTask(*this, c, 0, 0.));
+        }
+        myNet.getThreadPool().waitAll();
+        for (int i = 0; i < (int)numPaths.size(); i++) {
+            newRoute |= (int)myMatrix.getCells()[i]->pathsVector.size() > numPaths[i];
+        }
+        return newRoute;
+    }
+#endif
+    for (ODCell* const c : myMatrix.getCells()) {
+        newRoute |= !computePath(c).empty();
+    }
+    return newRoute;
+}
+
+
 void
 ROMAAssignments::sue(const int maxOuterIteration, const int maxInnerIteration, const int kPaths, const double penalty, const double tolerance, const std::string /* routeChoiceMethod */) {
     getKPaths(kPaths, penalty);
@@ -388,64 +513,29 @@ ROMAAssignments::sue(const int maxOuterIteration, const int maxInnerIteration, c
             intervals[c->begin] = c->end;
         }
     }
+    std::vector<ROMAEdge*> edges;
+    for (const auto& item : myNet.getEdgeMap()) {
+        edges.push_back(static_cast<ROMAEdge*>(item.second));
+    }
     for (int outer = 0; outer < maxOuterIteration; outer++) {
         for (int inner = 0; inner < maxInnerIteration; inner++) {
+            updateRouteChoice();
+            // calculate route flows in the cell order (keeps the sums independent of the number of threads)
             for (const ODCell* const c : myMatrix.getCells()) {
                 const SUMOTime begin = myAdditiveTraffic ? myBegin : c->begin;
                 const SUMOTime end = myAdditiveTraffic ? myEnd : c->end;
-                // update path cost
-                for (std::vector<RORoute*>::const_iterator j = c->pathsVector.begin(); j != c->pathsVector.end(); ++j) {
-                    RORoute* r = *j;
-                    r->setCosts(myRouter.recomputeCosts(r->getEdgeVector(), myDefaultVehicle, 0));
-                    //                    std::cout << std::setprecision(20) << r->getID() << ":" << r->getCosts() << std::endl;
-                }
-                // calculate route utilities and probabilities
-                RouteCostCalculator<RORoute, ROEdge, ROVehicle>::getCalculator().calculateProbabilities(c->pathsVector, myDefaultVehicle, 0);
-                // calculate route flows
                 for (std::vector<RORoute*>::const_iterator j = c->pathsVector.begin(); j != c->pathsVector.end(); ++j) {
                     RORoute* r = *j;
                     const double pathFlow = r->getProbability() * c->vehicleNumber;
                     // assign edge flow deltas
                     for (ConstROEdgeVector::const_iterator e = r->getEdgeVector().begin(); e != r->getEdgeVector().end(); e++) {
-                        ROMAEdge* edge = static_cast<ROMAEdge*>(myNet.getEdge((*e)->getID()));
+                        ROMAEdge* edge = static_cast<ROMAEdge*>(const_cast<ROEdge*>(*e));
                         edge->setHelpFlow(STEPS2TIME(begin), STEPS2TIME(end), edge->getHelpFlow(STEPS2TIME(begin)) + pathFlow);
                     }
                 }
             }
             // calculate new edge flows and check for stability
-            int unstableEdges = 0;
-            for (const auto& it : intervals) {
-                const double intervalLengthInHours = STEPS2TIME(it.second - it.first) / 3600.;
-                const double intBegin = STEPS2TIME(it.first);
-                const double intEnd = STEPS2TIME(it.second);
-                for (std::map<std::string, ROEdge*>::const_iterator e = myNet.getEdgeMap().begin(); e != myNet.getEdgeMap().end(); ++e) {
-                    ROMAEdge* edge = static_cast<ROMAEdge*>(e->second);
-                    const double oldFlow = edge->getFlow(intBegin);
-                    double newFlow = oldFlow;
-                    if (inner == 0 && outer == 0) {
-                        newFlow += edge->getHelpFlow(intBegin);
-                    } else {
-                        newFlow += (edge->getHelpFlow(intBegin) - oldFlow) / (inner + 1);
-                    }
-                    //                if not lohse:
-                    if (newFlow > 0.) {
-                        if (fabs(newFlow - oldFlow) / newFlow > tolerance) {
-                            unstableEdges++;
-                        }
-                    } else if (newFlow == 0.) {
-                        if (oldFlow != 0. && (fabs(newFlow - oldFlow) / oldFlow > tolerance)) {
-                            unstableEdges++;
-                        }
-                    } else { // newFlow < 0.
-                        unstableEdges++;
-                        newFlow = 0.;
-                    }
-                    edge->setFlow(intBegin, intEnd, newFlow);
-                    const double travelTime = capacityConstraintFunction(edge, newFlow / intervalLengthInHours);
-                    edge->addTravelTime(travelTime, intBegin, intEnd);
-                    edge->setHelpFlow(intBegin, intEnd, 0.);
-                }
-            }
+            const int unstableEdges = updateEdges(edges, intervals, inner == 0 && outer == 0, inner, tolerance);
             // if stable break
             if (unstableEdges == 0) {
                 break;
@@ -454,23 +544,13 @@ ROMAAssignments::sue(const int maxOuterIteration, const int maxInnerIteration, c
         }
         // check for a new route, if none available, break
         // several modifications about when a route is new and when to break are in the original script
-        bool newRoute = false;
-        for (ODCell* const c : myMatrix.getCells()) {
-            newRoute |= !computePath(c).empty();
-        }
-        if (!newRoute) {
+        if (!findNewRoutes()) {
             break;
         }
     }
     // final round of assignment
+    updateRouteChoice();
     for (const ODCell* const c : myMatrix.getCells()) {
-        // update path cost
-        for (std::vector<RORoute*>::const_iterator j = c->pathsVector.begin(); j != c->pathsVector.end(); ++j) {
-            RORoute* r = *j;
-            r->setCosts(myRouter.recomputeCosts(r->getEdgeVector(), myDefaultVehicle, 0));
-        }
-        // calculate route utilities and probabilities
-        RouteCostCalculator<RORoute, ROEdge, ROVehicle>::getCalculator().calculateProbabilities(c->pathsVector, myDefaultVehicle, 0);
         // calculate route flows
         for (std::vector<RORoute*>::const_iterator j = c->pathsVector.begin(); j != c->pathsVector.end(); ++j) {
             RORoute* r = *j;
@@ -511,4 +591,22 @@ void
 ROMAAssignments::RoutingTask::run(MFXWorkerThread* context) {
     myAssign.computePath(myCell, myBegin, myLinkFlow, &static_cast<RONet::WorkerThread*>(context)->getVehicleRouter(SVC_IGNORING), mySetBulkMode);
 }
+
+
+// ---------------------------------------------------------------------------
+// ROMAAssignments::RouteChoiceTask-methods
+// ---------------------------------------------------------------------------
+void
+ROMAAssignments::RouteChoiceTask::run(MFXWorkerThread* /* context */) {
+    myAssign.updateRouteChoice(myFirst, myLast);
+}
+
+
+// ---------------------------------------------------------------------------
+// ROMAAssignments::EdgeUpdateTask-methods
+// ---------------------------------------------------------------------------
+void
+ROMAAssignments::EdgeUpdateTask::run(MFXWorkerThread* /* context */) {
+    myUnstableEdges = myAssign.updateEdges(myFirst, myLast, myBegin, myEnd, myInitial, myInner, myTolerance);
+}
 #endif
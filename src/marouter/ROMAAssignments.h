@@ -129,6 +129,24 @@ private:
     /// @brief get the k shortest paths
     void getKPaths(const int kPaths, const double penalty);
 
+    /// @brief update the path costs and route probabilities of the given cells
+    void updateRouteChoice(std::vector<ODCell*>::const_iterator first, std::vector<ODCell*>::const_iterator last);
+
+    /** @brief calculate new flows and travel times for the given edges (one SUE inner iteration)
+     * @return the number of edges whose flow changed by more than the tolerance
+     */
+    int updateEdges(std::vector<ROMAEdge*>::const_iterator first, std::vector<ROMAEdge*>::const_iterator last,
+                    const SUMOTime begin, const SUMOTime end, const bool initial, const int inner, const double tolerance);
+
+    /// @brief run updateRouteChoice for all cells (in parallel if threads are available)
+    void updateRouteChoice();
+
+    /// @brief run updateEdges for all edges and intervals (in parallel if threads are available)
+    int updateEdges(const std::vector<ROMAEdge*>& edges, const std::map<const SUMOTime, SUMOTime>& intervals, const bool initial, const int inner, const double tolerance);
+
+    /// @brief try to find a new route for every cell (in parallel if threads are available)
+    bool findNewRoutes();
+
 private:
     const SUMOTime myBegin;
     const SUMOTime myEnd;
@@ -160,6 +178,41 @@ private:
         /// @brief Invalidated assignment operator.
         RoutingTask& operator=(const RoutingTask&) = delete;
     };
+
+    class RouteChoiceTask : public MFXWorkerThread::Task {
+    public:
+        RouteChoiceTask(ROMAAssignments& assign, std::vector<ODCell*>::const_iterator first, std::vector<ODCell*>::const_iterator last)
+            : myAssign(assign), myFirst(first), myLast(last) {}
+        void run(MFXWorkerThread* context);
+    private:
+        ROMAAssignments& myAssign;
+        const std::vector<ODCell*>::const_iterator myFirst;
+        const std::vector<ODCell*>::const_iterator myLast;
+    private:
+        /// @brief Invalidated assignment operator.
+        RouteChoiceTask& operator=(const RouteChoiceTask&) = delete;
+    };
+
+    class EdgeUpdateTask : public MFXWorkerThread::Task {
+    public:
+        EdgeUpdateTask(ROMAAssignments& assign, std::vector<ROMAEdge*>::const_iterator first, std::vector<ROMAEdge*>::const_iterator last,
+                       const SUMOTime begin, const SUMOTime end, const bool initial, const int inner, const double tolerance, int& unstableEdges)
+            : myAssign(assign), myFirst(first), myLast(last), myBegin(begin), myEnd(end), myInitial(initial), myInner(inner), myTolerance(tolerance), myUnstableEdges(unstableEdges) {}
+        void run(MFXWorkerThread* context);
+    private:
+        ROMAAssignments& myAssign;
+        const std::vector<ROMAEdge*>::const_iterator myFirst;
+        const std::vector<ROMAEdge*>::const_iterator myLast;
+        const SUMOTime myBegin;
+        const SUMOTime myEnd;
+        const bool myInitial;
+        const int myInner;
+        const double myTolerance;
+        int& myUnstableEdges;
+    private:
+        /// @brief Invalidated assignment operator.
+        EdgeUpdateTask& operator=(const EdgeUpdateTask&) = delete;
+    };
 #endif
 
 
@@ -352,6 +352,7 @@ main(int argc, char** argv) {
         }
         SystemFrame::checkOptions(oc);
         XMLSubSys::setValidation(oc.getString("xml-validation"), oc.getString("xml-validation.net"), oc.getString("xml-validation.routes"));
+        XMLSubSys::setParseThreads(oc.getInt("parse-threads"));
         MsgHandler::initOutputOptions();
         if (!ROMAFrame::checkOptions()) {
             throw ProcessError();
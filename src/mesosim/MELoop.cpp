@@ -22,19 +22,30 @@
 #include <queue>
 #include <vector>
 #include <map>
+#include <set>
 #include <cmath>
+#include <algorithm>
 
 #include <microsim/MSNet.h>
 #include <microsim/MSEdge.h>
 #include <microsim/MSGlobals.h>
+#include <microsim/MSJunction.h>
 #include <microsim/MSLane.h>
 #include <microsim/MSVehicle.h>
 #include <microsim/MSVehicleControl.h>
+#include <microsim/MSEdgeControl.h>
+#include <microsim/devices/MSVehicleDevice.h>
+#include <microsim/output/MSDetectorControl.h>
+#include <microsim/output/MSMeanData.h>
+#include <microsim/output/MSStepProfiler.h>
+#include <microsim/trigger/MSTriggeredRerouter.h>
+#include <utils/common/MsgHandler.h>
 #include <utils/options/OptionsCont.h>
 #include <utils/common/ToString.h>
 #include <utils/common/FileHelpers.h>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/RandHelper.h>
+#include <utils/geom/GeomConvHelper.h>
 #include "MELoop.h"
 #include "MESegment.h"
 #include "MEVehicle.h"
@@ -43,7 +54,16 @@
 // ===========================================================================
 // method definitions
 // ===========================================================================
-MELoop::MELoop(const SUMOTime recheckInterval) : myFullRecheckInterval(recheckInterval), myLinkRecheckInterval(TIME2STEPS(1)) {
+MELoop::MELoop(const SUMOTime recheckInterval) :
+    myFullRecheckInterval(recheckInterval),
+    myLinkRecheckInterval(TIME2STEPS(1)),
+    myParallel(-1),
+    myAmInParallelPhase(false) {
+    const OptionsCont& oc = OptionsCont::getOptions();
+    if (oc.exists("meso-detail-area") && oc.isSet("meso-detail-area")) {
+        bool ok = true;
+        myDetailArea = GeomConvHelper::parseBoundaryReporting(oc.getString("meso-detail-area"), "option", "meso-detail-area", ok, false);
+    }
 }
 
 MELoop::~MELoop() {
@@ -61,12 +81,25 @@ void
 MELoop::simulate(SUMOTime tMax) {
     while (!myLeaderCars.empty()) {
         const SUMOTime time = myLeaderCars.begin()->first;
-        std::vector<MEVehicle*> vehs = myLeaderCars[time];
-        assert(time > tMax - DELTA_T || vehs.size() == 0);
         if (time > tMax) {
             return;
         }
-        myLeaderCars.erase(time);
+        std::vector<MEVehicle*> vehs;
+        vehs.reserve(myLeaderCars.begin()->second.size());
+        for (MEVehicle* const veh : myLeaderCars.begin()->second) {
+            if (veh != nullptr) {
+                if (veh->getLeaderIndex() >= 0) {
+                    veh->setLeaderIndex(-1);
+                }
+                vehs.push_back(veh);
+            }
+        }
+        assert(time > tMax - DELTA_T || vehs.size() == 0);
+        myLeaderCars.erase(myLeaderCars.begin());
+        if (useParallel()) {
+            checkCars(vehs);
+            continue;
+        }
         for (std::vector<MEVehicle*>::const_iterator i = vehs.begin(); i != vehs.end(); ++i) {
             checkCar(*i);
             assert(myLeaderCars.empty() || myLeaderCars.begin()->first >= time);
@@ -75,6 +108,163 @@ MELoop::simulate(SUMOTime tMax) {
 }
 
 
+bool
+MELoop::useParallel() {
+    if (myParallel < 0) {
+        myParallel = 0;
+#ifdef HAVE_FOX
+#ifndef THREAD_POOL
+        if (OptionsCont::getOptions().getBool("meso-parallel") && MSGlobals::gNumSimThreads > 1) {
+            // these share their state between edges
+            bool aggregated = false;
+            for (const auto& item : MSNet::getInstance()->getDetectorControl().getMeanData()) {
+                for (const MSMeanData* const meanData : item.second) {
+                    aggregated |= meanData->isAggregated();
+                }
+            }
+            if (aggregated || !MSTriggeredRerouter::getInstances().empty()
+                    || MSNet::getInstance()->getDetectorControl().getTypedDetectors(SUMO_TAG_ENTRY_EXIT_DETECTOR).size() > 0) {
+                WRITE_WARNING(TL("Parallel mesoscopic simulation is not supported with rerouters, entry-exit detectors or aggregated edge data."));
+            } else {
+                myParallel = 1;
+                myDeferredChanges.resize(MSEdge::getAllEdges().size());
+                myCheckedIndex.resize(MSEdge::getAllEdges().size(), -1);
+            }
+        }
+#endif
+#endif
+    }
+    return myParallel == 1;
+}
+
+
+bool
+MELoop::isLocalChange(const MEVehicle* veh) const {
+    const MESegment* const onSegment = veh->getSegment();
+    if (onSegment == nullptr || veh->getQueIndex() == MESegment::PARKING_QUEUE) {
+        return false;
+    }
+    const MESegment* const toSegment = onSegment->getNextSegment();
+    if (toSegment == nullptr || toSegment->getNextSegment() == nullptr || toSegment->allowsOvertaking()
+            || veh->hasStops() || veh->succEdge(1) == nullptr
+            || (MSGlobals::gTimeToGridlock > 0 && veh->getWaitingTime() > MSGlobals::gTimeToGridlock)) {
+        return false;
+    }
+    for (const MSVehicleDevice* const dev : veh->getDevices()) {
+        const std::string& name = dev->deviceName();
+        if (name != "tripinfo" && name != "vehroute" && name != "emissions" && name != "rerouting" && name != "fcd") {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void
+MELoop::checkCars(const std::vector<MEVehicle*>& vehs) {
+    std::vector<MEVehicle*> local;
+    std::set<const MEVehicle*> seen;
+    for (MEVehicle* const veh : vehs) {
+        const bool isLocal = isLocalChange(veh);
+        if (!isLocal || seen.count(veh) > 0) {
+            // the earlier local changes have to be finished first
+            checkLocalCars(local);
+            local.clear();
+            seen.clear();
+        }
+        if (isLocal) {
+            local.push_back(veh);
+            seen.insert(veh);
+        } else {
+            checkCar(veh);
+        }
+    }
+    checkLocalCars(local);
+}
+
+
+void
+MELoop::checkLocalCars(const std::vector<MEVehicle*>& vehs) {
+#ifdef HAVE_FOX
+#ifndef THREAD_POOL
+    MFXWorkerThread::Pool& pool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+    std::vector<CheckTask*> tasks;
+    std::map<int, CheckTask*> edgeTasks;
+    for (int i = 0; i < (int)vehs.size(); i++) {
+        const int edgeID = vehs[i]->getEdge()->getNumericalID();
+        auto it = edgeTasks.find(edgeID);
+        if (it == edgeTasks.end()) {
+            if ((int)tasks.size() < pool.size()) {
+                tasks.push_back(new CheckTask(*this));
+            }
+            // the edges are distributed round robin, all vehicles of an edge go to the same task
+            it = edgeTasks.insert(std::make_pair(edgeID, tasks[edgeTasks.size() % tasks.size()])).first;
+        }
+        it->second->myVehicles.push_back(std::make_pair(i, vehs[i]));
+    }
+    if (tasks.size() > 1) {
+        myAmInParallelPhase = true;
+        for (CheckTask* const task : tasks) {
+            pool.add(task);
+        }
+        try {
+            pool.waitAll();
+        } catch (ProcessError&) {
+            myAmInParallelPhase = false;
+            applyDeferredLeaderChanges();
+            throw;
+        }
+        myAmInParallelPhase = false;
+        applyDeferredLeaderChanges();
+        return;
+    }
+    for (CheckTask* const task : tasks) {
+        delete task;
+    }
+#endif
+#endif
+    for (MEVehicle* const veh : vehs) {
+        checkCar(veh);
+    }
+}
+
+
+#ifdef HAVE_FOX
+void
+MELoop::CheckTask::run(MFXWorkerThread* /*context*/) {
+    MSStepProfiler::Scope span("mesoCheckTask");
+    for (const auto& item : myVehicles) {
+        myLoop.myCheckedIndex[item.second->getEdge()->getNumericalID()] = item.first;
+        myLoop.checkCar(item.second);
+    }
+}
+#endif
+
+
+void
+MELoop::applyDeferredLeaderChanges() {
+    std::vector<LeaderChange> changes;
+    for (std::vector<LeaderChange>& edgeChanges : myDeferredChanges) {
+        if (!edgeChanges.empty()) {
+            changes.insert(changes.end(), edgeChanges.begin(), edgeChanges.end());
+            edgeChanges.clear();
+        }
+    }
+    // changes of one vehicle are recorded by a single task in their original order
+    std::stable_sort(changes.begin(), changes.end(), [](const LeaderChange & a, const LeaderChange & b) {
+        return a.index < b.index;
+    });
+    for (const LeaderChange& c : changes) {
+        if (c.add) {
+            pushLeaderCar(c.veh);
+            c.veh->setApproaching(c.link);
+        } else {
+            eraseLeaderCar(c.veh, c.time);
+        }
+    }
+}
+
+
 SUMOTime
 MELoop::changeSegment(MEVehicle* veh, SUMOTime leaveTime, MESegment* const toSegment, MSMoveReminder::Notification reason, const bool ignoreLink) const {
     int qIdx = 0;
@@ -221,29 +411,89 @@ MELoop::teleportVehicle(MEVehicle* veh, MESegment* const toSegment) {
 
 void
 MELoop::addLeaderCar(MEVehicle* veh, MSLink* link) {
-    myLeaderCars[veh->getEventTime()].push_back(veh);
+    if (myAmInParallelPhase) {
+        // all vehicles affected by a local change are on the edge of the checked vehicle
+        const int edgeID = veh->getEdge()->getNumericalID();
+        myDeferredChanges[edgeID].push_back({myCheckedIndex[edgeID], veh, veh->getEventTime(), link, true});
+        return;
+    }
+    pushLeaderCar(veh);
     veh->setApproaching(link);
 }
 
 
+void
+MELoop::pushLeaderCar(MEVehicle* veh) {
+    std::vector<MEVehicle*>& cands = myLeaderCars[veh->getEventTime()];
+    // a second entry makes the recorded position ambiguous, fall back to searching
+    veh->setLeaderIndex(veh->getLeaderIndex() == -1 ? (int)cands.size() : -2);
+    cands.push_back(veh);
+}
+
+
+bool
+MELoop::eraseLeaderCar(MEVehicle* veh, SUMOTime time) {
+    MEVehicle** slot = findLeaderCar(veh, time);
+    if (slot == nullptr) {
+        return false;
+    }
+    *slot = nullptr;
+    if (veh->getLeaderIndex() >= 0) {
+        veh->setLeaderIndex(-1);
+    }
+    return true;
+}
+
+
+MEVehicle**
+MELoop::findLeaderCar(const MEVehicle* veh, SUMOTime time) {
+    if (veh->getLeaderIndex() == -1) {
+        return nullptr;
+    }
+    const auto candIt = myLeaderCars.find(time);
+    if (candIt == myLeaderCars.end()) {
+        return nullptr;
+    }
+    std::vector<MEVehicle*>& cands = candIt->second;
+    const int index = veh->getLeaderIndex();
+    if (index >= 0) {
+        return index < (int)cands.size() && cands[index] == veh ? &cands[index] : nullptr;
+    }
+    auto it = std::find(cands.begin(), cands.end(), veh);
+    return it != cands.end() ? &*it : nullptr;
+}
+
+
 void
 MELoop::clearState() {
+    for (const auto& item : myLeaderCars) {
+        for (MEVehicle* const veh : item.second) {
+            if (veh != nullptr) {
+                veh->setLeaderIndex(-1);
+            }
+        }
+    }
     myLeaderCars.clear();
 }
 
 
 bool
 MELoop::removeLeaderCar(MEVehicle* v) {
-    const auto candIt = myLeaderCars.find(v->getEventTime());
-    if (candIt != myLeaderCars.end()) {
-        std::vector<MEVehicle*>& cands = candIt->second;
-        auto it = find(cands.begin(), cands.end(), v);
-        if (it != cands.end()) {
-            cands.erase(it);
-            return true;
+    if (myAmInParallelPhase) {
+        const int edgeID = v->getEdge()->getNumericalID();
+        const SUMOTime time = v->getEventTime();
+        bool found = findLeaderCar(v, time) != nullptr;
+        for (const LeaderChange& c : myDeferredChanges[edgeID]) {
+            if (c.veh == v && c.time == time) {
+                found = c.add;
+            }
+        }
+        if (found) {
+            myDeferredChanges[edgeID].push_back({myCheckedIndex[edgeID], v, time, nullptr, false});
         }
+        return found;
     }
-    return false;
+    return eraseLeaderCar(v, v->getEventTime());
 }
 
 
@@ -349,4 +599,10 @@ MELoop::isEnteringRoundabout(const MSEdge& e) {
 }
 
 
+bool
+MELoop::isInDetailArea(const MSEdge& e) const {
+    return myDetailArea.isInitialised() && e.getToJunction() != nullptr && myDetailArea.around(e.getToJunction()->getPosition());
+}
+
+
 /****************************************************************************/
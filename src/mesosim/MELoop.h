@@ -23,6 +23,10 @@
 #include <vector>
 #include <map>
 #include <utils/common/SUMOTime.h>
+#include <utils/geom/Boundary.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#endif
 #include <microsim/MSMoveReminder.h>
 
 
@@ -55,6 +59,12 @@ public:
      *
      * Checks all vehicles with an event time less or equal than the given time.
      *
+     * With meso-parallel, consecutive vehicles of a time slice which only move
+     *  to the next segment of their edge (see isLocalChange) are checked in
+     *  parallel, one task per edge. The changes of the leader cars are recorded
+     *  per edge and applied in the original order of the vehicles afterwards,
+     *  so the result equals the sequential processing.
+     *
      * @param[in] tMax the end time for the sim step
      */
     void simulate(SUMOTime tMax);
@@ -78,6 +88,9 @@ public:
     /// @brief whether the given edge is entering a roundabout
     static bool isEnteringRoundabout(const MSEdge& e);
 
+    /// @brief whether the given edge ends inside the area of detailed simulation (option --meso-detail-area)
+    bool isInDetailArea(const MSEdge& e) const;
+
     /** @brief Compute number of segments per edge (best value stay close to the configured segment length) */
     static int numSegmentsFor(const double length, const double slength);
 
@@ -141,8 +154,72 @@ private:
      */
     void teleportVehicle(MEVehicle* veh, MESegment* const toSegment);
 
+    /// @brief checks the vehicles of one time slice (possibly in parallel, see simulate)
+    void checkCars(const std::vector<MEVehicle*>& vehs);
+
+    /// @brief checks the given vehicles (which all perform local changes) grouped by edge
+    void checkLocalCars(const std::vector<MEVehicle*>& vehs);
+
+    /// @brief applies the leader car changes recorded while checking local changes in parallel
+    void applyDeferredLeaderChanges();
+
+    /** @brief Whether the vehicle's next segment change affects nothing but its current edge
+     *
+     * This is the case if the vehicle moves to the next segment on the same edge
+     *  (which is not the last one, so no links are involved), cannot arrive, stop,
+     *  overtake or teleport and carries only devices without shared state.
+     */
+    bool isLocalChange(const MEVehicle* veh) const;
+
+    /// @brief initializes the parallel processing on first use and returns whether it is enabled
+    bool useParallel();
+
+#ifdef HAVE_FOX
+    /**
+     * @class CheckTask
+     * @brief the task checking the local changes of the vehicles on some edges
+     */
+    class CheckTask : public MFXWorkerThread::Task {
+    public:
+        CheckTask(MELoop& loop) : myLoop(loop) {}
+        void run(MFXWorkerThread* /*context*/);
+        /// @brief the vehicles to check with their index within the time slice
+        std::vector<std::pair<int, MEVehicle*> > myVehicles;
+    private:
+        MELoop& myLoop;
+    private:
+        /// @brief Invalidated assignment operator.
+        CheckTask& operator=(const CheckTask&) = delete;
+    };
+#endif
+
+    /// @brief a change of the leader cars recorded during the parallel phase
+    struct LeaderChange {
+        /// @brief the index of the checked vehicle which caused the change
+        int index;
+        MEVehicle* veh;
+        SUMOTime time;
+        MSLink* link;
+        /// @brief whether the vehicle was added (or removed)
+        bool add;
+    };
+
 private:
-    /// @brief leader cars in the segments sorted by exit time
+    /// @brief appends the vehicle to the leader cars at its event time and records its position
+    void pushLeaderCar(MEVehicle* veh);
+
+    /** @brief removes the first occurrence of the vehicle from the leader cars at the given time
+     *
+     * The slot is only cleared (not erased) so the positions of the other
+     *  vehicles stay valid and the processing order does not change.
+     * @return Whether the vehicle was found
+     */
+    bool eraseLeaderCar(MEVehicle* veh, SUMOTime time);
+
+    /// @brief returns the slot of the first occurrence of the vehicle at the given time (or nullptr)
+    MEVehicle** findLeaderCar(const MEVehicle* veh, SUMOTime time);
+
+    /// @brief leader cars in the segments sorted by exit time (removed vehicles leave a nullptr)
     std::map<SUMOTime, std::vector<MEVehicle*> > myLeaderCars;
 
     /// @brief mapping from internal edge ids to their initial segments
@@ -154,6 +231,21 @@ private:
     /// @brief the interval at which to recheck at blocked junctions (<=0 means asap)
     const SUMOTime myLinkRecheckInterval;
 
+    /// @brief whether local changes are checked in parallel (-1 if not initialized yet)
+    int myParallel;
+
+    /// @brief whether local changes are being checked in parallel
+    bool myAmInParallelPhase;
+
+    /// @brief the area with junction control and overtaking on all edges
+    Boundary myDetailArea;
+
+    /// @brief the leader car changes recorded per edge during the parallel phase
+    std::vector<std::vector<LeaderChange> > myDeferredChanges;
+
+    /// @brief the index of the vehicle being checked per edge during the parallel phase
+    std::vector<int> myCheckedIndex;
+
 private:
     /// @brief Invalidated copy constructor.
     MELoop(const MELoop&);
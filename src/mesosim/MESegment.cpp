@@ -163,7 +163,8 @@ MESegment::initSegment(const MesoEdgeType& edgeType, const MSEdge& parent, const
         myTau_jj = edgeType.taujj;
     }
 
-    myJunctionControl = myNextSegment == nullptr && (edgeType.junctionControl || MELoop::isEnteringRoundabout(parent));
+    const bool detailed = MSGlobals::gMesoNet != nullptr && MSGlobals::gMesoNet->isInDetailArea(parent);
+    myJunctionControl = myNextSegment == nullptr && (edgeType.junctionControl || detailed || MELoop::isEnteringRoundabout(parent));
     myTLSPenalty = ((edgeType.tlsPenalty > 0 || edgeType.tlsFlowPenalty > 0) &&
                     // only apply to the last segment of a tls-controlled edge
                     myNextSegment == nullptr && (
@@ -179,7 +180,11 @@ MESegment::initSegment(const MesoEdgeType& edgeType, const MSEdge& parent, const
                            parent.getToJunction()->getType() != SumoXMLNodeType::TRAFFIC_LIGHT_RIGHT_ON_RED &&
                            parent.hasMinorLink());
     myMinorPenalty = edgeType.minorPenalty;
-    myOvertaking = edgeType.overtaking && myCapacity > myLength;
+    myOvertaking = (edgeType.overtaking || detailed) && myCapacity > myLength;
+    // constant parts of the jam-jam headway function (see getTauJJ)
+    myHeadwayCapacity = myQueueCapacity / DEFAULT_VEH_LENGTH_WITH_GAP;
+    myTau_jjSeconds = STEPS2TIME(myTau_jj);
+    myTau_jfGrossSeconds = STEPS2TIME(tauWithVehLength(myTau_jf, DEFAULT_VEH_LENGTH_WITH_GAP, 1.));
 
     //std::cout << getID() << " myMinorPenalty=" << myMinorPenalty << " myTLSPenalty=" << myTLSPenalty << " myJunctionControl=" << myJunctionControl << " myOvertaking=" << myOvertaking << "\n";
 
@@ -311,26 +316,41 @@ MESegment::hasSpaceFor(const MEVehicle* const veh, const SUMOTime entryTime, int
         }
     }
     const SUMOVehicleClass svc = veh->getVClass();
+    const double lengthWithGap = veh->getVehicleType().getLengthWithGap();
     int minSize = std::numeric_limits<int>::max();
-    const MSEdge* const succ = myNextSegment == nullptr ? veh->succEdge(1) : nullptr;
+    // the queues which lead to the next edge (all of them if there is no restriction)
+    int allowedQueues = -1;
+    if (myNextSegment == nullptr && !myFollowerMap.empty() && !veh->getCachedAllowedQueues(this, allowedQueues)) {
+        const auto it = myFollowerMap.find(veh->succEdge(1));
+        if (it != myFollowerMap.end()) {
+            allowedQueues = it->second;
+        }
+        veh->setCachedAllowedQueues(this, allowedQueues);
+    }
+    // the constraints for initial insertions do not depend on the queue, they are computed at most once
+    const bool blockedInit = init && (myTLSPenalty || hasBlockedLeader());
+    double speedJamThreshold = -1.;
     for (int i = 0; i < (int)myQueues.size(); i++) {
         const Queue& q = myQueues[i];
-        const double newOccupancy = q.size() == 0 ? 0. : q.getOccupancy() + veh->getVehicleType().getLengthWithGap();
+        const double newOccupancy = q.size() == 0 ? 0. : q.getOccupancy() + lengthWithGap;
         if (newOccupancy <= myQueueCapacity) { // we must ensure that occupancy remains below capacity
-            if (succ == nullptr || myFollowerMap.count(succ) == 0 || ((myFollowerMap.find(succ)->second & (1 << i)) != 0)) {
+            if ((allowedQueues & (1 << i)) != 0) {
                 if (q.allows(svc) && q.size() < minSize) {
                     if (init) {
                         // regular insertions and initial insertions must respect different constraints:
                         // - regular insertions must respect entryBlockTime
                         // - initial insertions should not cause additional jamming
                         // - inserted vehicle should be able to continue at the current speed
-                        if (q.getOccupancy() <= myJamThreshold && !hasBlockedLeader() && !myTLSPenalty) {
+                        if (q.getOccupancy() <= myJamThreshold && !blockedInit) {
                             if (newOccupancy <= myJamThreshold) {
                                 qIdx = i;
                                 minSize = q.size();
                             }
                         } else {
-                            if (newOccupancy <= jamThresholdForSpeed(getMeanSpeed(false), -1)) {
+                            if (speedJamThreshold < 0.) {
+                                speedJamThreshold = jamThresholdForSpeed(getMeanSpeed(false), -1);
+                            }
+                            if (newOccupancy <= speedJamThreshold) {
                                 qIdx = i;
                                 minSize = q.size();
                             }
@@ -441,20 +461,33 @@ MESegment::getLink(const MEVehicle* veh, bool penalty) const {
         if (nextEdge == nullptr || veh->getQueIndex() == PARKING_QUEUE) {
             return nullptr;
         }
-        // try to find any link leading to our next edge, start with the lane pointed to by the que index
-        const MSLane* const bestLane = myEdge.getLanes()[veh->getQueIndex()];
-        for (MSLink* const link : bestLane->getLinkCont()) {
-            if (&link->getLane()->getEdge() == nextEdge) {
-                return link;
-            }
+        MSLink* result = nullptr;
+        if (veh->getCachedLink(this, result)) {
+            return result;
         }
-        // this is for the non-multique case, maybe we should use caching here !!!
-        for (const MSLane* const lane : myEdge.getLanes()) {
-            if (lane != bestLane) {
-                for (MSLink* const link : lane->getLinkCont()) {
-                    if (&link->getLane()->getEdge() == nextEdge) {
-                        return link;
-                    }
+        result = findLink(veh, nextEdge);
+        veh->setCachedLink(this, result);
+        return result;
+    }
+    return nullptr;
+}
+
+
+MSLink*
+MESegment::findLink(const MEVehicle* veh, const MSEdge* const nextEdge) const {
+    // try to find any link leading to our next edge, start with the lane pointed to by the que index
+    const MSLane* const bestLane = myEdge.getLanes()[veh->getQueIndex()];
+    for (MSLink* const link : bestLane->getLinkCont()) {
+        if (&link->getLane()->getEdge() == nextEdge) {
+            return link;
+        }
+    }
+    // this is for the non-multique case
+    for (const MSLane* const lane : myEdge.getLanes()) {
+        if (lane != bestLane) {
+            for (MSLink* const link : lane->getLinkCont()) {
+                if (&link->getLane()->getEdge() == nextEdge) {
+                    return link;
                 }
             }
         }
@@ -530,10 +563,8 @@ MESegment::send(MEVehicle* veh, MESegment* const next, const int nextQIdx, SUMOT
     MEVehicle* lc = removeCar(veh, time, reason); // new leaderCar
     q.setBlockTime(time);
     if (!isInvalid(next)) {
-        const bool nextFree = next->myQueues[nextQIdx].getOccupancy() <= next->myJamThreshold;
-        const SUMOTime tau = (q.getOccupancy() <= myJamThreshold
-                              ? (nextFree ? myTau_ff : myTau_fj)
-                              : (nextFree ? myTau_jf : getTauJJ((double)next->myQueues[nextQIdx].size(), next->myQueueCapacity, next->myJamThreshold)));
+        const Queue& nextQ = next->myQueues[nextQIdx];
+        const SUMOTime tau = getTimeHeadway(q.getOccupancy() > myJamThreshold, *next, nextQ.getOccupancy(), nextQ.size());
         assert(tau >= 0);
         myLastHeadway = tauWithVehLength(tau, veh->getVehicleType().getLengthWithGap(), veh->getVehicleType().getCarFollowModel().getHeadwayTime());
         if (myTLSPenalty) {
@@ -552,7 +583,7 @@ MESegment::send(MEVehicle* veh, MESegment* const next, const int nextQIdx, SUMOT
 }
 
 SUMOTime
-MESegment::getTauJJ(double nextQueueSize, double nextQueueCapacity, double nextJamThreshold) const {
+MESegment::getTauJJ(double nextQueueSize, const MESegment& next) const {
     // compute coefficients for the jam-jam headway function
     // this function models the effect that "empty space" needs to move
     // backwards through the downstream segment before the upstream segment may
@@ -564,16 +595,17 @@ MESegment::getTauJJ(double nextQueueSize, double nextQueueCapacity, double nextJ
     // f(n_jam_threshold) = tau_jf_withLength (for continuity)
     // f(headwayCapacity) = myTau_jj * headwayCapacity
 
-    const SUMOTime tau_jf_withLength = tauWithVehLength(myTau_jf, DEFAULT_VEH_LENGTH_WITH_GAP, 1.);
+    // the constant parts (myTau_jfGrossSeconds as tau_jf_withLength) are precomputed in initSegment
+
     // number of vehicles that fit into the NEXT queue (could be larger than expected with DEFAULT_VEH_LENGTH_WITH_GAP!)
-    const double headwayCapacity = MAX2(nextQueueSize, nextQueueCapacity / DEFAULT_VEH_LENGTH_WITH_GAP);
+    const double headwayCapacity = MAX2(nextQueueSize, next.myHeadwayCapacity);
     // number of vehicles above which the NEXT queue is jammed
-    const double n_jam_threshold = headwayCapacity * nextJamThreshold / nextQueueCapacity;
+    const double n_jam_threshold = headwayCapacity * next.myJamThreshold / next.myQueueCapacity;
 
     // slope a and axis offset b for the jam-jam headway function
     // solving f(x) = a * x + b
-    const double a = (STEPS2TIME(myTau_jj) * headwayCapacity - STEPS2TIME(tau_jf_withLength)) / (headwayCapacity - n_jam_threshold);
-    const double b = headwayCapacity * (STEPS2TIME(myTau_jj) - a);
+    const double a = (myTau_jjSeconds * headwayCapacity - myTau_jfGrossSeconds) / (headwayCapacity - n_jam_threshold);
+    const double b = headwayCapacity * (myTau_jjSeconds - a);
 
     // it is only well defined for nextQueueSize >= n_jam_threshold (which may not be the case for longer vehicles), so we take the MAX
     return TIME2STEPS(a * MAX2(nextQueueSize, n_jam_threshold) + b);
@@ -243,6 +243,14 @@ public:
         return myLength;
     }
 
+    /** @brief Returns whether vehicles may overtake within this segment
+     *
+     * @return whether overtaking is enabled
+     */
+    inline bool allowsOvertaking() const {
+        return myOvertaking;
+    }
+
     /** @brief Returns the sum of the lengths of all usable lanes of the segment in meters.
      *
      * @return the capacity of the segment
@@ -447,6 +455,19 @@ public:
     /// @brief return a time after earliestEntry at which a vehicle may be inserted at full speed
     SUMOTime getNextInsertionTime(SUMOTime earliestEntry) const;
 
+    /** @brief return the net time headway (without vehicle length) for leaving a queue of this segment
+     * @param[in] jammed Whether the queue which is left is jammed
+     * @param[in] next The segment to enter
+     * @param[in] nextOccupancy The occupancy of the queue to enter
+     * @param[in] nextQueueSize The number of vehicles in the queue to enter
+     */
+    inline SUMOTime getTimeHeadway(const bool jammed, const MESegment& next, const double nextOccupancy, const int nextQueueSize) const {
+        if (nextOccupancy <= next.myJamThreshold) {
+            return jammed ? myTau_jf : myTau_ff;
+        }
+        return jammed ? getTauJJ((double)nextQueueSize, next) : myTau_fj;
+    }
+
     /// @brief return the remaining physical space on this segment
     inline int remainingVehicleCapacity(const double vehLength) const {
         int cap = 0;
@@ -503,12 +524,16 @@ private:
     /// @brief whether the given link may be passed because the option meso-junction-control.limited is set
     bool limitedControlOverride(const MSLink* link) const;
 
+    /// @brief searches the link leading to the given edge, starting with the lane of the vehicle's que (see getLink)
+    MSLink* findLink(const MEVehicle* veh, const MSEdge* const nextEdge) const;
+
     /// @brief convert net time gap (leader back to follower front) to gross time gap (leader front to follower front)
     inline SUMOTime tauWithVehLength(SUMOTime tau, double lengthWithGap, double vehicleTau) const {
         return (SUMOTime)((double)tau * vehicleTau + lengthWithGap * myTau_length);
     }
 
-    SUMOTime getTauJJ(double nextQueueSize, double nextQueueCapacity, double nextJamThreshold) const;
+    /// @brief the jam-jam headway when the next segment contains the given number of vehicles
+    SUMOTime getTauJJ(double nextQueueSize, const MESegment& next) const;
 
 private:
     /// @brief The microsim edge this segment belongs to
@@ -552,6 +577,13 @@ private:
     /// @brief The number of lanes represented by the queue * the length of the lane
     double myQueueCapacity = 0.;
 
+    /// @brief The number of vehicles with default length which fit into a queue (for the jam-jam headway)
+    double myHeadwayCapacity = 0.;
+
+    /// @brief The jam-jam time headway and the gross jam-free time headway of a default vehicle in seconds
+    double myTau_jjSeconds = 0.;
+    double myTau_jfGrossSeconds = 0.;
+
     /// @brief The space (in m) which needs to be occupied before the segment is considered jammed
     double myJamThreshold;
 
@@ -114,7 +114,7 @@ METriggeredCalibrator::execute(SUMOTime currentTime) {
             // keep calibrator alive but do not call again
             return TIME2STEPS(86400);
         }
-        return myFrequency;
+        return inactiveDelay(currentTime);
     }
     const bool calibrateFlow = myCurrentStateInterval->q >= 0;
     const bool calibrateSpeed = myCurrentStateInterval->v >= 0;
@@ -74,6 +74,9 @@ protected:
     /// @brief do nothing
     void updateMeanData() {}
 
+    /// @brief do nothing
+    void updateVehicleCounts() {}
+
     /// @brief returns the maximum number of vehicles that could enter from upstream until the calibrator is activated again
     inline int maximumInflow() const {
         return (int)std::ceil((double)myFrequency / (double)mySegment->getMinimumHeadwayTime());
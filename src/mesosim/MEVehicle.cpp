@@ -25,6 +25,7 @@
 #include <utils/common/StdDefs.h>
 #include <utils/common/FileHelpers.h>
 #include <utils/common/MsgHandler.h>
+#include <utils/common/PerformanceCounters.h>
 #include <utils/iodevices/OutputDevice.h>
 #include <utils/xml/SUMOSAXAttributes.h>
 #include <microsim/devices/MSDevice_Tripinfo.h>
@@ -56,6 +57,7 @@ MEVehicle::MEVehicle(SUMOVehicleParameter* pars, ConstMSRoutePtr route,
     myQueIndex(0),
     myEventTime(SUMOTime_MIN),
     myLastEntryTime(SUMOTime_MIN),
+    myLeaderIndex(-1),
     myBlockTime(SUMOTime_MAX),
     myInfluencer(nullptr) {
     if (!(*myCurrEdge)->isTazConnector()) {
@@ -67,6 +69,12 @@ MEVehicle::MEVehicle(SUMOVehicleParameter* pars, ConstMSRoutePtr route,
                                "' is too high for the vehicle type '" + type->getID() + "'.");
         }
     }
+    PerformanceCounters::added(PerformanceCounters::VEHICLES, sizeof(MEVehicle));
+}
+
+
+MEVehicle::~MEVehicle() {
+    PerformanceCounters::removed(PerformanceCounters::VEHICLES, sizeof(MEVehicle));
 }
 
 
@@ -195,6 +203,8 @@ bool
 MEVehicle::replaceRoute(ConstMSRoutePtr newRoute, const std::string& info,  bool onInit, int offset, bool addRouteStops, bool removeStops, std::string* msgReturn) {
     MSLink* const oldLink = mySegment != nullptr ? mySegment->getLink(this) : nullptr;
     if (MSBaseVehicle::replaceRoute(newRoute, info, onInit, offset, addRouteStops, removeStops, msgReturn)) {
+        myLinkCache.segment = nullptr;
+        myQueuesCache.segment = nullptr;
         if (mySegment != nullptr) {
             MSLink* const newLink = mySegment->getLink(this);
             // update approaching vehicle information
@@ -51,6 +51,9 @@ public:
     MEVehicle(SUMOVehicleParameter* pars, ConstMSRoutePtr route,
               MSVehicleType* type, const double speedFactor);
 
+    /// @brief Destructor
+    ~MEVehicle();
+
 
     /** @brief Get the vehicle's position along the lane
      * @return The position of the vehicle (in m from the lane's begin)
@@ -202,6 +205,22 @@ public:
     }
 
 
+    /** @brief Returns the position of the vehicle in its entry of the leader cars of MELoop
+     * @return The position, -1 if the vehicle is no leader car and -2 if it was added more than once
+     */
+    inline int getLeaderIndex() const {
+        return myLeaderIndex;
+    }
+
+
+    /** @brief Sets the position of the vehicle in its entry of the leader cars of MELoop
+     * @param[in] index The position (see getLeaderIndex)
+     */
+    inline void setLeaderIndex(int index) {
+        myLeaderIndex = index;
+    }
+
+
     /** @brief Sets the current segment the vehicle is at together with its que
      * @param[in] s The current segment
      * @param[in] q The current que
@@ -227,6 +246,51 @@ public:
         return myQueIndex;
     }
 
+    /// @name Values MESegment resolved for the current route position
+    /// @{
+
+    /** @brief Returns whether the link to the next edge is known for the given segment
+     *
+     * The link only depends on the segment, the que and the route position,
+     *  so it is resolved once instead of for every query (there are several
+     *  per segment transition). Rerouting invalidates the cached values.
+     * @param[in] seg The segment the link starts at
+     * @param[out] link The cached link
+     */
+    inline bool getCachedLink(const MESegment* const seg, MSLink*& link) const {
+        if (myLinkCache.segment == seg && myLinkCache.queIndex == myQueIndex && myLinkCache.edge == myCurrEdge) {
+            link = myLinkCache.link;
+            return true;
+        }
+        return false;
+    }
+
+    inline void setCachedLink(const MESegment* const seg, MSLink* const link) const {
+        myLinkCache.segment = seg;
+        myLinkCache.queIndex = myQueIndex;
+        myLinkCache.edge = myCurrEdge;
+        myLinkCache.link = link;
+    }
+
+    /** @brief Returns whether the ques of the given segment leading to the next edge are known
+     * @param[in] seg The segment to enter
+     * @param[out] queues The bit set of the ques
+     */
+    inline bool getCachedAllowedQueues(const MESegment* const seg, int& queues) const {
+        if (myQueuesCache.segment == seg && myQueuesCache.edge == myCurrEdge) {
+            queues = myQueuesCache.allowedQueues;
+            return true;
+        }
+        return false;
+    }
+
+    inline void setCachedAllowedQueues(const MESegment* const seg, const int queues) const {
+        myQueuesCache.segment = seg;
+        myQueuesCache.edge = myCurrEdge;
+        myQueuesCache.allowedQueues = queues;
+    }
+    /// @}
+
     /** @brief Get the vehicle's lateral position on the edge of the given lane
      * (or its current edge if lane == 0)
      * @return The lateral position of the vehicle (in m distance between right
@@ -359,10 +423,28 @@ protected:
     /// @brief The time the vehicle entered its current segment
     SUMOTime myLastEntryTime;
 
+    /// @brief The position in the leader cars of MELoop (avoids searching on removal)
+    int myLeaderIndex;
+
     /// @brief The time at which the vehicle was blocked on its current segment
     SUMOTime myBlockTime;
 
     /// @brief An instance of a velocity/lane influencing instance; built in "getInfluencer"
     BaseInfluencer* myInfluencer;
 
+    /// @brief A value resolved by a segment for a route position (and que)
+    struct SegmentCache {
+        const MESegment* segment = nullptr;
+        MSRouteIterator edge;
+        int queIndex = 0;
+        MSLink* link = nullptr;
+        int allowedQueues = -1;
+    };
+
+    /// @brief The cached link to the next edge (see MESegment::getLink)
+    mutable SegmentCache myLinkCache;
+
+    /// @brief The cached ques leading to the next edge (see MESegment::hasSpaceFor)
+    mutable SegmentCache myQueuesCache;
+
 };
@@ -121,11 +121,20 @@ MSBaseVehicle::MSBaseVehicle(SUMOVehicleParameter* pars, ConstMSRoutePtr route,
     myOdometer(0.),
     myRouteValidity(ROUTE_UNCHECKED),
     myNumericalID(myCurrentNumericalIndex++),
+    myCounterRNG(nullptr),
     myEdgeWeights(nullptr)
 #ifdef _DEBUG
     , myTraceMoveReminders(myShallTraceMoveReminders.count(pars->id) > 0)
 #endif
 {
+    if (MSGlobals::gCounterRNGs) {
+        // key by the id (and not the numerical id) to stay independent of the loading order
+        uint64_t idHash = 14695981039346656037ULL;
+        for (const char c : pars->id) {
+            idHash = (idHash ^ (unsigned char)c) * 1099511628211ULL;
+        }
+        myCounterRNG = new SumoRNG(pars->id, SumoRNG::deriveKey(MSGlobals::gSeed, idHash));
+    }
     if ((*myRoute->begin())->isTazConnector() || myRoute->getLastEdge()->isTazConnector()) {
         pars->parametersSet |= VEHPARS_FORCE_REROUTE;
     }
@@ -141,6 +150,7 @@ MSBaseVehicle::MSBaseVehicle(SUMOVehicleParameter* pars, ConstMSRoutePtr route,
 
 MSBaseVehicle::~MSBaseVehicle() {
     delete myEdgeWeights;
+    delete myCounterRNG;
     if (myParameter->repetitionNumber == -1) {
         // this is not a flow (flows call checkDist in MSInsertionControl::determineCandidates)
         MSRoute::checkDist(myParameter->routeid);
@@ -347,7 +357,7 @@ MSBaseVehicle::reroute(SUMOTime t, const std::string& info, SUMOAbstractRouter<M
             && myParameter->departPos > myParameter->arrivalPos) {
         router.computeLooped(source, sink, this, t, edges, silent);
     } else {
-        if (!router.compute(source, sink, this, t, edges, silent)) {
+        if (!MSRoutingEngine::compute(router, source, sink, this, t, edges, silent)) {
             edges.clear();
         }
     }
@@ -2143,6 +2153,10 @@ MSBaseVehicle::getRNGIndex() const {
 
 SumoRNG*
 MSBaseVehicle::getRNG() const {
+    if (myCounterRNG != nullptr) {
+        myCounterRNG->setStep(SIMSTEP);
+        return myCounterRNG;
+    }
     const MSLane* lane = getLane();
     if (lane == nullptr) {
         return getEdge()->getLanes()[0]->getRNG();
@@ -2297,4 +2311,26 @@ MSBaseVehicle::traceMoveReminder(const std::string& type, MSMoveReminder* rem, d
 #endif
 
 
+bool
+MSBaseVehicle::hasCachedEmissions(const double speed, const double accel, const double slope) const {
+    return (myEmissionCache.time == MSNet::getInstance()->getCurrentTimeStep()
+            && myEmissionCache.eClass == myType->getEmissionClass()
+            && myEmissionCache.speed == speed && myEmissionCache.accel == accel && myEmissionCache.slope == slope);
+}
+
+
+const PollutantsInterface::Emissions&
+MSBaseVehicle::getAllEmissions(const double speed, const double accel, const double slope) const {
+    if (!hasCachedEmissions(speed, accel, slope)) {
+        myEmissionCache.time = MSNet::getInstance()->getCurrentTimeStep();
+        myEmissionCache.eClass = myType->getEmissionClass();
+        myEmissionCache.speed = speed;
+        myEmissionCache.accel = accel;
+        myEmissionCache.slope = slope;
+        myEmissionCache.values = PollutantsInterface::computeAll(myEmissionCache.eClass, speed, accel, slope, getEmissionParameters());
+    }
+    return myEmissionCache.values;
+}
+
+
 /****************************************************************************/
@@ -26,6 +26,7 @@
 #include <vector>
 #include <set>
 #include <utils/common/StdDefs.h>
+#include <utils/common/MemoryPool.h>
 #include <utils/emissions/EnergyParams.h>
 #include <utils/emissions/PollutantsInterface.h>
 #include <utils/vehicle/SUMOVehicle.h>
@@ -92,6 +93,16 @@ public:
     /// @brief Destructor
     virtual ~MSBaseVehicle();
 
+    /// @brief allocates the memory of vehicles from the memory pool
+    static void* operator new(std::size_t size) {
+        return MemoryPool::allocate(size);
+    }
+
+    /// @brief returns the memory of vehicles to the memory pool
+    static void operator delete(void* p, std::size_t size) {
+        MemoryPool::deallocate(p, size);
+    }
+
     virtual void initDevices();
 
     bool isVehicle() const {
@@ -788,11 +799,26 @@ public:
     template<PollutantsInterface::EmissionType ET>
     double getEmissions() const {
         if (isOnRoad() || isIdling()) {
-            return PollutantsInterface::compute(myType->getEmissionClass(), ET, getSpeed(), getAcceleration(), getSlope(), getEmissionParameters());
+            const double speed = getSpeed();
+            const double accel = getAcceleration();
+            const double slope = getSlope();
+            if (hasCachedEmissions(speed, accel, slope)) {
+                return myEmissionCache.values.get(ET);
+            }
+            return PollutantsInterface::compute(myType->getEmissionClass(), ET, speed, accel, slope, getEmissionParameters());
         }
         return 0.;
     }
 
+    /** @brief Returns all emissions for the given state
+     *
+     * The result is kept until the state or the simulation step changes, so
+     *  that the emission device, the emission outputs and the TraCI getters
+     *  evaluating the same state compute it only once.
+     * The values are always per 1s, so multiply by step length if necessary.
+     */
+    const PollutantsInterface::Emissions& getAllEmissions(const double speed, const double accel, const double slope) const;
+
     /** @brief Returns actual state of charge of battery (Wh)
     * RICE_CHECK: This may be a misnomer, SOC is typically percentage of the maximum battery capacity.
     * @return The actual battery state of charge
@@ -1024,6 +1050,20 @@ protected:
     /// @brief The emission parameters this vehicle may have
     mutable EnergyParams* myEnergyParams;
 
+    /// @brief the last emissions computed by getAllEmissions together with their input
+    struct EmissionCache {
+        SUMOTime time = -1;
+        SUMOEmissionClass eClass = 0;
+        double speed = 0.;
+        double accel = 0.;
+        double slope = 0.;
+        PollutantsInterface::Emissions values;
+    };
+    mutable EmissionCache myEmissionCache;
+
+    /// @brief whether the emission cache holds the values for the given state in the current step
+    bool hasCachedEmissions(const double speed, const double accel, const double slope) const;
+
     /// @brief The real departure time
     SUMOTime myDeparture;
 
@@ -1070,6 +1110,9 @@ protected:
 private:
     const NumericalID myNumericalID;
 
+    /// @brief The vehicle's own counter based random number stream (only used with option --counter-rngs)
+    SumoRNG* myCounterRNG;
+
     /* @brief The vehicle's knowledge about edge efforts/travel times; @see MSEdgeWeightsStorage
      * @note member is initialized on first access */
     mutable MSEdgeWeightsStorage* myEdgeWeights;
@@ -95,7 +95,11 @@ double DriverStateDefaults::maximalReactionTimeFactor = 1.0;
 OUProcess::OUProcess(double initialState, double timeScale, double noiseIntensity)
     : myState(initialState),
       myTimeScale(timeScale),
-      myNoiseIntensity(noiseIntensity) {}
+      myNoiseIntensity(noiseIntensity),
+      myCoefficientsDt(-1.),
+      myCoefficientsTimeScale(-1.),
+      myDecay(0.),
+      myNoiseFactor(0.) {}
 
 
 OUProcess::~OUProcess() {}
@@ -106,7 +110,14 @@ OUProcess::step(double dt) {
 #ifdef DEBUG_OUPROCESS
     const double oldstate = myState;
 #endif
-    myState = exp(-dt / myTimeScale) * myState + myNoiseIntensity * sqrt(2 * dt / myTimeScale) * RandHelper::randNorm(0, 1, &myRNG);
+    if (dt != myCoefficientsDt || myTimeScale != myCoefficientsTimeScale) {
+        // the step length and the time scale (given by the awareness) rarely change
+        myCoefficientsDt = dt;
+        myCoefficientsTimeScale = myTimeScale;
+        myDecay = exp(-dt / myTimeScale);
+        myNoiseFactor = sqrt(2 * dt / myTimeScale);
+    }
+    myState = myDecay * myState + myNoiseIntensity * myNoiseFactor * RandHelper::randNorm(0, 1, &myRNG);
 #ifdef DEBUG_OUPROCESS
     std::cout << "  OU-step (" << dt << " s.): " << oldstate << "->" << myState << std::endl;
 #endif
@@ -250,7 +261,11 @@ MSSimpleDriverState::getPerceivedHeadway(const double trueGap, const void* objID
 #endif
 
         // new perceived gap differs significantly from the previous
-        myAssumedGap[objID] = perceivedGap;
+        if (assumedGap == myAssumedGap.end()) {
+            myAssumedGap.emplace(objID, perceivedGap);
+        } else {
+            assumedGap->second = perceivedGap;
+        }
         return perceivedGap;
     } else {
 
@@ -263,7 +278,7 @@ MSSimpleDriverState::getPerceivedHeadway(const double trueGap, const void* objID
         }
 #endif
         // new perceived gap doesn't differ significantly from the previous
-        return myAssumedGap[objID];
+        return assumedGap->second;
     }
 }
 
@@ -310,7 +325,11 @@ MSSimpleDriverState::getPerceivedSpeedDifference(const double trueSpeedDifferenc
 #endif
 
         // new perceived speed difference differs significantly from the previous
-        myLastPerceivedSpeedDifference[objID] = perceivedSpeedDifference;
+        if (lastPerceivedSpeedDifference == myLastPerceivedSpeedDifference.end()) {
+            myLastPerceivedSpeedDifference.emplace(objID, perceivedSpeedDifference);
+        } else {
+            lastPerceivedSpeedDifference->second = perceivedSpeedDifference;
+        }
         return perceivedSpeedDifference;
     } else {
 #ifdef DEBUG_PERCEPTION_ERRORS
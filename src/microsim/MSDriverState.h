@@ -26,6 +26,7 @@
 #include <config.h>
 
 #include <memory>
+#include <unordered_map>
 #include <utils/common/SUMOTime.h>
 #include <utils/xml/SUMOXMLDefinitions.h>
 
@@ -92,6 +93,14 @@ private:
      */
     double myNoiseIntensity;
 
+    /// @brief The step length and time scale the coefficients below were computed for
+    double myCoefficientsDt;
+    double myCoefficientsTimeScale;
+
+    /// @brief The decay exp(-dt / timeScale) and the noise factor sqrt(2 * dt / timeScale) of a step
+    double myDecay;
+    double myNoiseFactor;
+
     /// @brief Random generator for OUProcesses
     static SumoRNG myRNG;
 };
@@ -336,9 +345,9 @@ private:
 
     /// @brief The assumed gaps to different objects
     /// @todo: update each step to incorporate the assumed change given a specific speed difference
-    std::map<const void*, double> myAssumedGap;
+    std::unordered_map<const void*, double> myAssumedGap;
     /// @brief The last perceived speed differences to the corresponding objects
-    std::map<const void*, double> myLastPerceivedSpeedDifference;
+    std::unordered_map<const void*, double> myLastPerceivedSpeedDifference;
     /// @}
 
     /// @brief Used to prevent infinite loops in debugging outputs, @see followSpeed() and stopSpeed() (of MSCFModel_Krauss, e.g.)
@@ -57,6 +57,7 @@
 // static member definitions
 // ===========================================================================
 MSEdge::DictType MSEdge::myDict;
+StringHashIndex<MSEdge::DictType::iterator> MSEdge::myDictIndex;
 MSEdgeVector MSEdge::myEdges;
 SVCPermissions MSEdge::myMesoIgnoredVClasses(0);
 
@@ -297,7 +298,7 @@ MSEdge::getMesoPermissions(SVCPermissions p, SVCPermissions ignoreIgnored) {
 
 
 void
-MSEdge::rebuildAllowedLanes(const bool onInit) {
+MSEdge::rebuildAllowedLanes(const bool onInit, const bool updateTargets) {
     // rebuild myMinimumPermissions and myCombinedPermissions
     myMinimumPermissions = SVCAll;
     myCombinedPermissions = 0;
@@ -326,9 +327,11 @@ MSEdge::rebuildAllowedLanes(const bool onInit) {
         }
     }
     if (!onInit) {
-        rebuildAllowedTargets(false);
-        for (MSEdge* pred : myPredecessors) {
-            pred->rebuildAllowedTargets(false);
+        if (updateTargets) {
+            rebuildAllowedTargets(false);
+            for (MSEdge* pred : myPredecessors) {
+                pred->rebuildAllowedTargets(false);
+            }
         }
         if (MSGlobals::gUseMesoSim) {
             for (MESegment* s = MSGlobals::gMesoNet->getSegmentForEdge(*this); s != nullptr; s = s->getNextSegment()) {
@@ -342,7 +345,10 @@ MSEdge::rebuildAllowedLanes(const bool onInit) {
 void
 MSEdge::rebuildAllowedTargets(const bool updateVehicles) {
     myAllowedTargets.clear();
+    myAllowedTargets.reserve(mySuccessors.size());
     for (const MSEdge* target : mySuccessors) {
+        myAllowedTargets.push_back(std::make_pair(target, AllowedLanesCont()));
+        AllowedLanesCont& targetLanes = myAllowedTargets.back().second;
         bool universalMap = true; // whether the mapping for SVC_IGNORING is also valid for all vehicle classes
         std::shared_ptr<std::vector<MSLane*> > allLanes = std::make_shared<std::vector<MSLane*> >();
         // compute the mapping for SVC_IGNORING
@@ -366,14 +372,14 @@ MSEdge::rebuildAllowedTargets(const bool updateVehicles) {
         if (universalMap) {
             if (myAllowed.empty()) {
                 // we have no lane specific permissions
-                myAllowedTargets[target].push_back(std::make_pair(myMinimumPermissions, myLanes));
+                targetLanes.push_back(std::make_pair(myMinimumPermissions, myLanes));
             } else {
                 for (const auto& i : myAllowed) {
-                    addToAllowed(i.first, i.second, myAllowedTargets[target]);
+                    addToAllowed(i.first, i.second, targetLanes);
                 }
             }
         } else {
-            addToAllowed(SVC_IGNORING, allLanes, myAllowedTargets[target]);
+            addToAllowed(SVC_IGNORING, allLanes, targetLanes);
             // compute the vclass specific mapping
             for (int vclass = SVC_PRIVATE; vclass <= SUMOVehicleClass_MAX; vclass *= 2) {
                 if ((myCombinedPermissions & vclass) == vclass) {
@@ -387,21 +393,108 @@ MSEdge::rebuildAllowedTargets(const bool updateVehicles) {
                             }
                         }
                     }
-                    addToAllowed(vclass, allowedLanes, myAllowedTargets[target]);
+                    addToAllowed(vclass, allowedLanes, targetLanes);
                 }
             }
         }
     }
     if (updateVehicles) {
-        for (const MSLane* const lane : *myLanes) {
-            const MSLane::VehCont& vehs = lane->getVehiclesSecure();
-            for (MSVehicle* veh : vehs) {
-                veh->updateBestLanes(true);
-            }
-            lane->releaseVehicles();
+        updateVehicleBestLanes();
+    }
+    // stable to keep the first entry for duplicate targets
+    std::stable_sort(myAllowedTargets.begin(), myAllowedTargets.end(),
+    [](const std::pair<const MSEdge*, AllowedLanesCont>& a, const std::pair<const MSEdge*, AllowedLanesCont>& b) {
+        return a.first < b.first;
+    });
+    rebuildClassSuccessors();
+}
+
+
+void
+MSEdge::rebuildPermissions(const std::set<MSEdge*, ComparatorNumericalIdLess>& edges) {
+    // the targets depend on the lanes of the edge and its successors, so all lanes are rebuilt first
+    std::set<MSEdge*, ComparatorNumericalIdLess> targetsChanged;
+    for (MSEdge* const edge : edges) {
+        edge->rebuildAllowedLanes(false, false);
+        targetsChanged.insert(edge);
+        targetsChanged.insert(edge->myPredecessors.begin(), edge->myPredecessors.end());
+    }
+    for (MSEdge* const edge : targetsChanged) {
+        edge->rebuildAllowedTargets(false);
+    }
+}
+
+
+void
+MSEdge::updateVehicleBestLanes() const {
+    for (const MSLane* const lane : *myLanes) {
+        const MSLane::VehCont& vehs = lane->getVehiclesSecure();
+        for (MSVehicle* veh : vehs) {
+            veh->updateBestLanes(true);
         }
+        lane->releaseVehicles();
     }
+}
+
+
+void
+MSEdge::rebuildClassSuccessors() {
+    myClassesSuccessorIndex.clear();
+    myClassesSuccessors.clear();
+    myClassesViaSuccessors.clear();
     myClassesSuccessorMap.clear();
+    myClassesViaSuccessorMap.clear();
+    // the classes which may reach each successor, allowedLanes returns a non-empty
+    // list for a single class if and only if one of the non-empty entries contains it
+    std::map<const MSEdge*, SVCPermissions> reachable;
+    for (const MSEdge* const target : mySuccessors) {
+        SVCPermissions permissions = target->isTazConnector() ? SVCAll : 0;
+        AllowedLanesByTarget::const_iterator i = std::lower_bound(myAllowedTargets.begin(), myAllowedTargets.end(), target,
+        [](const std::pair<const MSEdge*, AllowedLanesCont>& a, const MSEdge * const b) {
+            return a.first < b;
+        });
+        if (i != myAllowedTargets.end() && i->first == target) {
+            for (const auto& allowed : i->second) {
+                if (!allowed.second->empty()) {
+                    permissions |= allowed.first;
+                }
+            }
+        }
+        reachable[target] = permissions;
+    }
+    MSEdgeVector successors;
+    for (int vclass = SVC_PRIVATE; vclass <= SUMOVehicleClass_MAX; vclass *= 2) {
+        successors.clear();
+        for (MSEdge* const target : mySuccessors) {
+            if ((reachable[target] & vclass) != 0) {
+                successors.push_back(target);
+            }
+        }
+        const int index = (int)(std::find(myClassesSuccessors.begin(), myClassesSuccessors.end(), successors) - myClassesSuccessors.begin());
+        if (index == (int)myClassesSuccessors.size()) {
+            myClassesSuccessors.push_back(successors);
+            myClassesViaSuccessors.push_back(MSConstEdgePairVector());
+            for (const auto& viaPair : myViaSuccessors) {
+                if ((reachable[viaPair.first] & vclass) != 0) {
+                    myClassesViaSuccessors.back().push_back(viaPair);
+                }
+            }
+        }
+        myClassesSuccessorIndex.push_back(index);
+    }
+}
+
+
+int
+MSEdge::getClassSuccessorIndex(SUMOVehicleClass vClass) const {
+    if (myClassesSuccessorIndex.empty() || (vClass & (vClass - 1)) != 0) {
+        return -1;
+    }
+    int bit = 0;
+    for (int v = vClass; v > 1; v >>= 1) {
+        bit++;
+    }
+    return bit < (int)myClassesSuccessorIndex.size() ? myClassesSuccessorIndex[bit] : -1;
 }
 
 
@@ -437,8 +530,11 @@ MSEdge::parallelLane(const MSLane* const lane, int offset, bool includeOpposite)
 
 const std::vector<MSLane*>*
 MSEdge::allowedLanes(const MSEdge& destination, SUMOVehicleClass vclass) const {
-    AllowedLanesByTarget::const_iterator i = myAllowedTargets.find(&destination);
-    if (i != myAllowedTargets.end()) {
+    AllowedLanesByTarget::const_iterator i = std::lower_bound(myAllowedTargets.begin(), myAllowedTargets.end(), &destination,
+    [](const std::pair<const MSEdge*, AllowedLanesCont>& a, const MSEdge * const b) {
+        return a.first < b;
+    });
+    if (i != myAllowedTargets.end() && i->first == &destination) {
         for (const auto& allowed : i->second) {
             if ((allowed.first & vclass) == vclass) {
                 return allowed.second.get();
@@ -757,6 +853,12 @@ MSEdge::insertVehicle(SUMOVehicle& v, SUMOTime time, const bool checkOnly, const
         }
         return false;
     }
+    if (!forceCheck && myLastFailedInsertionTime == time
+            && (int)myFailedInsertionMemory.size() == (int)myLanes->size()
+            && pars.departLaneProcedure != DepartLaneDefinition::RANDOM) {
+        // all lanes rejected a vehicle in this timestep, the lane choice can be skipped
+        return false;
+    }
     MSLane* insertionLane = getDepartLane(static_cast<MSVehicle&>(v));
     if (insertionLane == nullptr) {
         return false;
@@ -943,10 +1045,10 @@ MSEdge::getRoutingSpeed() const {
 
 bool
 MSEdge::dictionary(const std::string& id, MSEdge* ptr) {
-    const DictType::iterator it = myDict.lower_bound(id);
-    if (it == myDict.end() || it->first != id) {
+    DictType::iterator it;
+    if (!myDictIndex.find(id, it)) {
         // id not in myDict
-        myDict.emplace_hint(it, id, ptr);
+        myDictIndex.insert(myDict.emplace(id, ptr).first);
         while (ptr->getNumericalID() >= (int)myEdges.size()) {
             myEdges.push_back(nullptr);
         }
@@ -959,8 +1061,8 @@ MSEdge::dictionary(const std::string& id, MSEdge* ptr) {
 
 MSEdge*
 MSEdge::dictionary(const std::string& id) {
-    const DictType::iterator it = myDict.find(id);
-    if (it == myDict.end()) {
+    DictType::iterator it;
+    if (!myDictIndex.find(id, it)) {
         return nullptr;
     }
     return it->second;
@@ -992,6 +1094,7 @@ MSEdge::clear() {
         delete (*i).second;
     }
     myDict.clear();
+    myDictIndex.clear();
     myEdges.clear();
 }
 
@@ -1149,6 +1252,9 @@ MSEdge::addSuccessor(MSEdge* edge, const MSEdge* via) {
     if (edge->isTazConnector() && getToJunction() != nullptr) {
         edge->myBoundary.add(getToJunction()->getPosition());
     }
+    if (!myClassesSuccessorIndex.empty()) {
+        rebuildClassSuccessors();
+    }
 }
 
 
@@ -1157,6 +1263,10 @@ MSEdge::getSuccessors(SUMOVehicleClass vClass) const {
     if (vClass == SVC_IGNORING || !MSNet::getInstance()->hasPermissions() || myFunction == SumoXMLEdgeFunc::CONNECTOR) {
         return mySuccessors;
     }
+    const int classIndex = getClassSuccessorIndex(vClass);
+    if (classIndex >= 0) {
+        return myClassesSuccessors[classIndex];
+    }
 #ifdef HAVE_FOX
     ScopedLocker<> lock(mySuccessorMutex, MSGlobals::gNumThreads > 1);
 #endif
@@ -1187,6 +1297,10 @@ MSEdge::getViaSuccessors(SUMOVehicleClass vClass) const {
     if (vClass == SVC_IGNORING || !MSNet::getInstance()->hasPermissions() || myFunction == SumoXMLEdgeFunc::CONNECTOR) {
         return myViaSuccessors;
     }
+    const int classIndex = getClassSuccessorIndex(vClass);
+    if (classIndex >= 0) {
+        return myClassesViaSuccessors[classIndex];
+    }
 #ifdef HAVE_FOX
     ScopedLocker<> lock(mySuccessorMutex, MSGlobals::gNumThreads > 1);
 #endif
@@ -35,6 +35,7 @@
 #include <utils/common/Parameterised.h>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/SUMOVehicleClass.h>
+#include <utils/common/StringHashIndex.h>
 #include <utils/geom/Boundary.h>
 #include <utils/router/ReversedEdge.h>
 #include <utils/router/RailEdge.h>
@@ -79,8 +80,8 @@ private:
     /** @brief "Map" from vehicle class to allowed lanes */
     typedef std::vector<std::pair<SVCPermissions, std::shared_ptr<const std::vector<MSLane*> > > > AllowedLanesCont;
 
-    /** @brief Succeeding edges (keys) and allowed lanes to reach these edges (values). */
-    typedef std::map<const MSEdge*, AllowedLanesCont> AllowedLanesByTarget;
+    /** @brief Succeeding edges and allowed lanes to reach these edges (sorted by the edge pointer for binary search). */
+    typedef std::vector<std::pair<const MSEdge*, AllowedLanesCont> > AllowedLanesByTarget;
 
 
 public:
@@ -635,10 +636,24 @@ public:
         return mySublaneSides;
     }
 
-    void rebuildAllowedLanes(const bool onInit = false);
+    /** @brief Rebuilds the lanes allowed for each vehicle class after a permission change
+     * @param[in] onInit Whether the edge is initialized (the targets are built later on)
+     * @param[in] updateTargets Whether the allowed targets of this edge and its predecessors shall be rebuilt as well
+     */
+    void rebuildAllowedLanes(const bool onInit = false, const bool updateTargets = true);
 
     void rebuildAllowedTargets(const bool updateVehicles = true);
 
+    /** @brief Rebuilds the allowed lanes of all given edges after their lane permissions changed
+     *
+     * The allowed targets of every edge which is given or a predecessor of a given edge are rebuilt once
+     * @param[in] edges The edges with changed lane permissions
+     */
+    static void rebuildPermissions(const std::set<MSEdge*, ComparatorNumericalIdLess>& edges);
+
+    /// @brief recomputes the best lanes of all vehicles on this edge
+    void updateVehicleBestLanes() const;
+
 
     /** @brief optimistic air distance heuristic for use in routing
      * @param[in] other The edge to which the distance shall be returned
@@ -975,6 +990,9 @@ protected:
      */
     static DictType myDict;
 
+    /// @brief hash index for the lookups in myDict
+    static StringHashIndex<DictType::iterator> myDictIndex;
+
     /** @brief Static list of edges
      * @deprecated Move to MSEdgeControl, make non-static
      */
@@ -984,10 +1002,19 @@ protected:
     /// @}
 
 
-    /// @brief The successors available for a given vClass
+    /// @brief For each single vehicle class (by bit index) the index of its successors in myClassesSuccessors
+    std::vector<int> myClassesSuccessorIndex;
+
+    /// @brief The distinct successor lists of all single vehicle classes
+    std::vector<MSEdgeVector> myClassesSuccessors;
+
+    /// @brief The distinct via successor lists of all single vehicle classes (same indices as myClassesSuccessors)
+    std::vector<MSConstEdgePairVector> myClassesViaSuccessors;
+
+    /// @brief The successors available for a given vClass which is not in the tables above
     mutable std::map<SUMOVehicleClass, MSEdgeVector> myClassesSuccessorMap;
 
-    /// @brief The successors available for a given vClass
+    /// @brief The successors available for a given vClass which is not in the tables above
     mutable std::map<SUMOVehicleClass, MSConstEdgePairVector> myClassesViaSuccessorMap;
 
     /// @brief The bounding rectangle of end nodes incoming or outgoing edges for taz connectors or of my own start and end node for normal edges
@@ -1024,4 +1051,10 @@ private:
     bool isSuperposable(const MSEdge* other);
 
     void addToAllowed(const SVCPermissions permissions, std::shared_ptr<const std::vector<MSLane*> > allowedLanes, AllowedLanesCont& laneCont) const;
+
+    /// @brief precomputes the successors for all single vehicle classes
+    void rebuildClassSuccessors();
+
+    /// @brief the index of the vehicle class in myClassesSuccessorIndex or -1 if it has no precomputed successors
+    int getClassSuccessorIndex(SUMOVehicleClass vClass) const;
 };
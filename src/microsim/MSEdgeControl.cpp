@@ -22,6 +22,8 @@
 /****************************************************************************/
 #include <config.h>
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <queue>
 #include <vector>
@@ -29,16 +31,28 @@
 #include "MSVehicleControl.h"
 #include "MSGlobals.h"
 #include "MSEdge.h"
+#include "MSJunction.h"
 #include "MSLane.h"
 #include "MSVehicle.h"
+#include <utils/common/PerformanceCounters.h>
+#include <utils/geom/Boundary.h>
+#include <microsim/output/MSE3Collector.h>
+#include <microsim/output/MSStepProfiler.h>
 
 #define PARALLEL_PLAN_MOVE
 #define PARALLEL_EXEC_MOVE
-//#define PARALLEL_CHANGE_LANES
 //#define LOAD_BALANCING
 
 //#define PARALLEL_STOPWATCH
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const double MSEdgeControl::COST_SMOOTHING = 0.2;
+const int MSEdgeControl::REASSIGN_STEPS = 100;
+const int MSEdgeControl::TASKS_PER_THREAD = 4;
+
+
 // ===========================================================================
 // member method definitions
 // ===========================================================================
@@ -46,9 +60,15 @@ MSEdgeControl::MSEdgeControl(const std::vector< MSEdge* >& edges)
     : myEdges(edges),
       myLanes(MSLane::dictSize()),
       myWithVehicles2Integrate(MSGlobals::gNumSimThreads > 1),
+      myWithDeviceUpdates(MSGlobals::gNumSimThreads > 1),
+      myAmExecutingMovements(false),
       myLastLaneChange(edges.size()),
       myInactiveCheckCollisions(MSGlobals::gNumSimThreads > 1),
       myMinLengthGeometryFactor(1.),
+      myLaneChangeResources(MSGlobals::gParallelLaneChange ? edges.size() : 0),
+      myResourceGroups(MSGlobals::gParallelLaneChange ? edges.size() + MSLane::getNumRNGs() : 0),
+      myMeanLaneCost(0.),
+      myMeasuredSteps(0),
 #ifdef THREAD_POOL
       myThreadPool(false, std::vector<int>(MSGlobals::gNumThreads, 0)),
 #endif
@@ -73,6 +93,7 @@ MSEdgeControl::MSEdgeControl(const std::vector< MSEdge* >& edges)
             myLastLaneChange[edge->getNumericalID()] = -1;
         }
     }
+    assignThreads();
 #ifndef THREAD_POOL
 #ifdef HAVE_FOX
     if (MSGlobals::gNumThreads > 1) {
@@ -85,6 +106,147 @@ MSEdgeControl::MSEdgeControl(const std::vector< MSEdge* >& edges)
 }
 
 
+void
+MSEdgeControl::assignThreads() {
+    myLaneThreads.assign(MSLane::dictSize(), 0);
+    const int numThreads = MSGlobals::gNumSimThreads;
+    if (numThreads <= 1) {
+        return;
+    }
+    std::vector<std::pair<Position, MSLane*> > centers;
+    Boundary b;
+    for (MSEdge* const edge : myEdges) {
+        for (MSLane* const lane : edge->getLanes()) {
+            centers.push_back(std::make_pair(lane->getShape().positionAtOffset(lane->getShape().length() / 2), lane));
+            b.add(centers.back().first);
+        }
+    }
+    // spread the lower 16 bits such that there is a zero bit between each of them
+    auto spread = [](long long v) {
+        v &= 0xffff;
+        v = (v | (v << 8)) & 0x00ff00ff;
+        v = (v | (v << 4)) & 0x0f0f0f0f;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    };
+    const double scale = 65535. / MAX2(1., MAX2(b.getWidth(), b.getHeight()));
+    std::vector<std::pair<long long, MSLane*> > order;
+    double totalLength = 0.;
+    double totalWork = 0.;
+    for (const auto& item : centers) {
+        const long long x = (long long)((item.first.x() - b.xmin()) * scale);
+        const long long y = (long long)((item.first.y() - b.ymin()) * scale);
+        order.push_back(std::make_pair(spread(x) | (spread(y) << 1), item.second));
+        totalLength += MAX2(1., item.second->getLength());
+        totalWork += myLanes[item.second->getNumericalID()].work;
+    }
+    std::sort(order.begin(), order.end(), [](const std::pair<long long, MSLane*>& a, const std::pair<long long, MSLane*>& b) {
+        return a.first < b.first || (a.first == b.first && a.second->getNumericalID() < b.second->getNumericalID());
+    });
+    double weight = 0.;
+    for (const auto& item : order) {
+        LaneUsage& lu = myLanes[item.second->getNumericalID()];
+        myLaneThreads[item.second->getNumericalID()] = MIN2(numThreads - 1, (int)(weight * numThreads));
+        // keep a small share of the length so idle lanes are spread as well
+        const double lengthShare = MAX2(1., item.second->getLength()) / totalLength;
+        weight += totalWork > 0. ? 0.1 * lengthShare + 0.9 * lu.work / totalWork : lengthShare;
+        lu.work = 0.;
+    }
+    myMeasuredSteps = 0;
+}
+
+
+void
+MSEdgeControl::processLanes(const std::vector<MSLane*>& lanes, const std::function<void(MSLane*)>& fn, const bool measure) {
+#if defined(THREAD_POOL) || defined(HAVE_FOX)
+    const int numThreads = MSGlobals::gNumSimThreads;
+    // group the lanes by thread and estimate the cost of each thread's tasks
+    std::vector<std::vector<MSLane*> > byThread(numThreads);
+    double totalCost = 0.;
+    for (MSLane* const lane : lanes) {
+        byThread[getThreadIndex(lane)].push_back(lane);
+        const double cost = myLanes[lane->getNumericalID()].cost;
+        totalCost += cost < 0. ? myMeanLaneCost : cost;
+    }
+    // without estimates (grain 0) every lane gets its own task
+    const double grain = totalCost / (TASKS_PER_THREAD * numThreads);
+    std::vector<MSLane*> ordered;
+    ordered.reserve(lanes.size());
+    std::vector<std::pair<int, int> > batches;
+    std::vector<int> batchThreads;
+    for (int thread = 0; thread < numThreads; thread++) {
+        double batchCost = 0.;
+        bool open = false;
+        for (MSLane* const lane : byThread[thread]) {
+            if (!open) {
+                batches.push_back(std::make_pair((int)ordered.size(), (int)ordered.size()));
+                batchThreads.push_back(thread);
+                open = true;
+            }
+            ordered.push_back(lane);
+            batches.back().second++;
+            const double cost = myLanes[lane->getNumericalID()].cost;
+            batchCost += cost < 0. ? myMeanLaneCost : cost;
+            if (batchCost >= grain) {
+                batchCost = 0.;
+                open = false;
+            }
+        }
+    }
+    const std::function<void(int, int)> batch = [this, &ordered, &fn, measure](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            MSLane* const lane = ordered[i];
+            if (measure) {
+                // every lane is processed by one thread only, so its usage may be written here
+                const auto start = std::chrono::steady_clock::now();
+                fn(lane);
+                const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                LaneUsage& lu = myLanes[lane->getNumericalID()];
+                lu.cost = lu.cost < 0. ? elapsed : (1. - COST_SMOOTHING) * lu.cost + COST_SMOOTHING * elapsed;
+                lu.work += elapsed;
+            } else {
+                fn(lane);
+            }
+        }
+    };
+    for (int i = 0; i < (int)batches.size(); i++) {
+        const int begin = batches[i].first;
+        const int end = batches[i].second;
+#ifdef THREAD_POOL
+        myThreadPool.executeAsync([&batch, begin, end](int) {
+            batch(begin, end);
+        }, batchThreads[i]);
+#else
+        myThreadPool.add(new RangeTask(batch, begin, end), batchThreads[i]);
+#endif
+    }
+    myThreadPool.waitAll();
+    if (measure && !ordered.empty()) {
+        double sum = 0.;
+        for (MSLane* const lane : ordered) {
+            sum += myLanes[lane->getNumericalID()].cost;
+        }
+        myMeanLaneCost = sum / (double)ordered.size();
+        if (++myMeasuredSteps >= REASSIGN_STEPS) {
+            assignThreads();
+        }
+    }
+#else
+    UNUSED_PARAMETER(measure);
+    for (MSLane* const lane : lanes) {
+        fn(lane);
+    }
+#endif
+}
+
+
+int
+MSEdgeControl::getThreadIndex(const MSLane* const lane) const {
+    return myLaneThreads[lane->getNumericalID()];
+}
+
+
 MSEdgeControl::~MSEdgeControl() {
 #ifndef THREAD_POOL
 #ifdef HAVE_FOX
@@ -133,50 +295,45 @@ MSEdgeControl::patchActiveLanes() {
 
 void
 MSEdgeControl::planMovements(SUMOTime t) {
+    PerformanceCounters::Timer timer(PerformanceCounters::MOVEMENT);
 #ifdef PARALLEL_STOPWATCH
     myStopWatch[0].start();
 #endif
-#ifdef THREAD_POOL
-    std::vector<std::future<void>> results;
-#endif
+    if (MSGlobals::gNumSimThreads > 1) {
+        MSNet::getInstance()->deferVehicleStateEvents();
+    }
+    std::vector<MSLane*> mirrored;
+    if (MSGlobals::gKinematicsMirror) {
+        mirrored.assign(myActiveLanes.begin(), myActiveLanes.end());
+        for (MSLane* const lane : mirrored) {
+            lane->updateKinematicsMirror();
+        }
+    }
+    std::vector<MSLane*> parallel;
     for (std::list<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end();) {
         const int vehNum = (*i)->getVehicleNumber();
         if (vehNum == 0) {
             myLanes[(*i)->getNumericalID()].amActive = false;
             i = myActiveLanes.erase(i);
         } else {
-#ifdef THREAD_POOL
             if (MSGlobals::gNumSimThreads > 1) {
-                results.push_back(myThreadPool.executeAsync([i, t](int) {
-                    (*i)->planMovements(t);
-                }, (*i)->getRNGIndex() % MSGlobals::gNumSimThreads));
-                ++i;
-                continue;
-            }
-#else
-#ifdef HAVE_FOX
-            if (MSGlobals::gNumSimThreads > 1) {
-                myThreadPool.add((*i)->getPlanMoveTask(t), (*i)->getRNGIndex() % myThreadPool.size());
-                ++i;
-                continue;
+                parallel.push_back(*i);
+            } else {
+                (*i)->planMovements(t);
             }
-#endif
-#endif
-            (*i)->planMovements(t);
             ++i;
         }
     }
-#ifdef THREAD_POOL
-    for (auto& r : results) {
-        r.wait();
-    }
-#else
-#ifdef HAVE_FOX
     if (MSGlobals::gNumSimThreads > 1) {
-        myThreadPool.waitAll(false);
+        processLanes(parallel, [t](MSLane * lane) {
+            lane->planMovements(t);
+        }, true);
+        MSNet::getInstance()->flushVehicleStateEvents();
+    }
+    // positions and containers change from now on
+    for (MSLane* const lane : mirrored) {
+        lane->invalidateKinematicsMirror();
     }
-#endif
-#endif
 #ifdef PARALLEL_STOPWATCH
     myStopWatch[0].stop();
 #endif
@@ -193,31 +350,25 @@ MSEdgeControl::setJunctionApproaches(SUMOTime t) {
 
 void
 MSEdgeControl::executeMovements(SUMOTime t) {
+    PerformanceCounters::Timer timer(PerformanceCounters::MOVEMENT);
 #ifdef PARALLEL_STOPWATCH
     myStopWatch[1].start();
 #endif
     std::vector<MSLane*> wasActive(myActiveLanes.begin(), myActiveLanes.end());
     myWithVehicles2Integrate.clear();
+    myAmExecutingMovements = true;
 #ifdef PARALLEL_EXEC_MOVE
-#ifdef THREAD_POOL
     if (MSGlobals::gNumSimThreads > 1) {
-        for (MSLane* const lane : myActiveLanes) {
-            myThreadPool.executeAsync([lane, t](int) {
-                lane->executeMovements(t);
-            }, lane->getRNGIndex() % MSGlobals::gNumSimThreads);
-        }
-        myThreadPool.waitAll();
+        MSNet::getInstance()->deferVehicleStateEvents();
+        MSE3Collector::deferEvents();
     }
-#else
-#ifdef HAVE_FOX
     if (MSGlobals::gNumSimThreads > 1) {
-        for (MSLane* const lane : myActiveLanes) {
-            myThreadPool.add(lane->getExecuteMoveTask(t), lane->getRNGIndex() % myThreadPool.size());
-        }
-        myThreadPool.waitAll(false);
+        processLanes(wasActive, [t](MSLane * lane) {
+            lane->executeMovements(t);
+        }, false);
+        MSNet::getInstance()->flushVehicleStateEvents();
+        MSE3Collector::flushEvents();
     }
-#endif
-#endif
 #endif
     for (std::list<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end();) {
         if (
@@ -234,6 +385,8 @@ MSEdgeControl::executeMovements(SUMOTime t) {
             ++i;
         }
     }
+    myAmExecutingMovements = false;
+    executeDevices();
     for (MSLane* lane : wasActive) {
         lane->updateLengthSum();
     }
@@ -266,71 +419,227 @@ MSEdgeControl::executeMovements(SUMOTime t) {
 }
 
 
+void
+MSEdgeControl::executeDevices() {
+    std::vector<MSVehicle*>& vehs = myWithDeviceUpdates.getContainer();
+    if (vehs.size() > 1) {
+        MSStepProfiler::Scope span("devices");
+        // contiguous chunks of the registration order (vehicles of the same lane)
+        parallelFor(0, (int)vehs.size(), 0, [&vehs](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                vehs[i]->workOnDeferredMoveReminders();
+            }
+        });
+    } else {
+        for (MSVehicle* const veh : vehs) {
+            veh->workOnDeferredMoveReminders();
+        }
+    }
+    vehs.clear();
+    myWithDeviceUpdates.unlock();
+}
+
+
+void
+MSEdgeControl::computePositions() {
+    const std::vector<MSLane*> lanes(myActiveLanes.begin(), myActiveLanes.end());
+    parallelFor(0, (int)lanes.size(), 0, [&lanes](int begin, int end) {
+        MSStepProfiler::Scope span("positionTask");
+        for (int i = begin; i < end; i++) {
+            for (const MSVehicle* const veh : lanes[i]->getVehiclesSecure()) {
+                veh->getPosition();
+            }
+            lanes[i]->releaseVehicles();
+        }
+    });
+}
+
+
+void
+MSEdgeControl::parallelFor(const int begin, const int end, const int grain, const std::function<void(int, int)>& fn) {
+    if (begin >= end) {
+        return;
+    }
+    const int n = end - begin;
+#if defined(THREAD_POOL) || defined(HAVE_FOX)
+    if (MSGlobals::gNumSimThreads > 1 && n > 1 && (grain <= 0 || grain < n)) {
+        const int chunkSize = grain > 0 ? grain : (n + 4 * MSGlobals::gNumThreads - 1) / (4 * MSGlobals::gNumThreads);
+        for (int chunkBegin = begin; chunkBegin < end; chunkBegin += chunkSize) {
+            const int chunkEnd = MIN2(end, chunkBegin + chunkSize);
+#ifdef THREAD_POOL
+            myThreadPool.executeAsync([&fn, chunkBegin, chunkEnd](int) {
+                fn(chunkBegin, chunkEnd);
+            });
+#else
+            myThreadPool.add(new RangeTask(fn, chunkBegin, chunkEnd));
+#endif
+        }
+        myThreadPool.waitAll();
+        return;
+    }
+#else
+    UNUSED_PARAMETER(grain);
+    UNUSED_PARAMETER(n);
+#endif
+    fn(begin, end);
+}
+
+
 void
 MSEdgeControl::changeLanes(const SUMOTime t) {
+    PerformanceCounters::Timer timer(PerformanceCounters::LANE_CHANGE);
     std::vector<MSLane*> toAdd;
-#ifdef PARALLEL_CHANGE_LANES
-    std::vector<const MSEdge*> recheckLaneUsage;
-#endif
     MSGlobals::gComputeLC = true;
-    for (const MSLane* const l : myActiveLanes) {
-        if (myLanes[l->getNumericalID()].haveNeighbors) {
-            const MSEdge& edge = l->getEdge();
-            if (myLastLaneChange[edge.getNumericalID()] != t) {
-                myLastLaneChange[edge.getNumericalID()] = t;
-#ifdef PARALLEL_CHANGE_LANES
-                if (MSGlobals::gNumSimThreads > 1) {
-                    MSLane* lane = edge.getLanes()[0];
-                    myThreadPool.add(lane->getLaneChangeTask(t), lane->getRNGIndex() % myThreadPool.size());
-                    recheckLaneUsage.push_back(&edge);
-                } else {
-#endif
+    if (MSGlobals::gParallelLaneChange) {
+        changeLanesGrouped(t, toAdd);
+    } else {
+        for (const MSLane* const l : myActiveLanes) {
+            if (myLanes[l->getNumericalID()].haveNeighbors) {
+                const MSEdge& edge = l->getEdge();
+                if (myLastLaneChange[edge.getNumericalID()] != t) {
+                    myLastLaneChange[edge.getNumericalID()] = t;
                     edge.changeLanes(t);
-                    for (MSLane* const lane : edge.getLanes()) {
-                        LaneUsage& lu = myLanes[lane->getNumericalID()];
-                        //if ((*i)->getID() == "disabled") {
-                        //    std::cout << SIMTIME << " vehicles=" << toString((*i)->getVehiclesSecure()) << "\n";
-                        //    (*i)->releaseVehicles();
-                        //}
-                        if (lane->getVehicleNumber() > 0 && !lu.amActive) {
-                            toAdd.push_back(lane);
-                            lu.amActive = true;
-                        }
-                        if (MSGlobals::gLateralResolution > 0) {
-                            lane->sortManeuverReservations();
-                        }
-                    }
-#ifdef PARALLEL_CHANGE_LANES
+                    updateLaneUsage(edge, toAdd);
                 }
-#endif
+            } else {
+                break;
             }
-        } else {
-            break;
         }
     }
+    MSGlobals::gComputeLC = false;
+    for (std::vector<MSLane*>::iterator i = toAdd.begin(); i != toAdd.end(); ++i) {
+        myActiveLanes.push_front(*i);
+    }
+}
 
-#ifdef PARALLEL_CHANGE_LANES
-    if (MSGlobals::gNumSimThreads > 1) {
-        myThreadPool.waitAll(false);
-        for (const MSEdge* e : recheckLaneUsage) {
-            for (MSLane* const l : e->getLanes()) {
-                LaneUsage& lu = myLanes[l->getNumericalID()];
-                if (l->getVehicleNumber() > 0 && !lu.amActive) {
-                    toAdd.push_back(l);
-                    lu.amActive = true;
-                }
-                if (MSGlobals::gLateralResolution > 0) {
-                    l->sortManeuverReservations();
-                }
+
+void
+MSEdgeControl::changeLanesGrouped(const SUMOTime t, std::vector<MSLane*>& toAdd) {
+    // collect the edges in an order which does not depend on the history of the active lanes
+    std::vector<const MSEdge*> edges;
+    for (const MSLane* const l : myActiveLanes) {
+        if (!myLanes[l->getNumericalID()].haveNeighbors) {
+            break;
+        }
+        const MSEdge& edge = l->getEdge();
+        if (myLastLaneChange[edge.getNumericalID()] != t) {
+            myLastLaneChange[edge.getNumericalID()] = t;
+            edges.push_back(&edge);
+        }
+    }
+    std::sort(edges.begin(), edges.end(), ComparatorNumericalIdLess());
+    // greedy coloring: edges within a group share neither a junction, a neighboring edge nor a random number generator
+    std::vector<std::vector<const MSEdge*> > groups;
+    std::vector<const MSEdge*> serial;
+    std::vector<int> touched;
+    for (const MSEdge* const edge : edges) {
+        if (edge->canChangeToOpposite() || edge->getBidiEdge() != nullptr) {
+            // changes may affect another edge directly
+            serial.push_back(edge);
+            continue;
+        }
+        const std::vector<int>& resources = getLaneChangeResources(*edge);
+        std::vector<bool> blocked(groups.size() + 1, false);
+        for (const int r : resources) {
+            for (const int g : myResourceGroups[r]) {
+                blocked[g] = true;
+            }
+        }
+        const int group = (int)(std::find(blocked.begin(), blocked.end(), false) - blocked.begin());
+        if (group == (int)groups.size()) {
+            groups.push_back(std::vector<const MSEdge*>());
+        }
+        groups[group].push_back(edge);
+        for (const int r : resources) {
+            if (myResourceGroups[r].empty()) {
+                touched.push_back(r);
             }
+            myResourceGroups[r].push_back(group);
         }
     }
+    for (const int r : touched) {
+        myResourceGroups[r].clear();
+    }
+    for (const std::vector<const MSEdge*>& group : groups) {
+#ifdef THREAD_POOL
+        if (MSGlobals::gNumSimThreads > 1 && group.size() > 1) {
+            for (const MSEdge* const edge : group) {
+                myThreadPool.executeAsync([edge, t](int) {
+                    edge->changeLanes(t);
+                }, getThreadIndex(edge->getLanes()[0]));
+            }
+            myThreadPool.waitAll();
+        } else {
+#else
+#ifdef HAVE_FOX
+        if (MSGlobals::gNumSimThreads > 1 && group.size() > 1) {
+            for (const MSEdge* const edge : group) {
+                MSLane* const lane = edge->getLanes()[0];
+                myThreadPool.add(lane->getLaneChangeTask(t), getThreadIndex(lane));
+            }
+            myThreadPool.waitAll(false);
+        } else {
 #endif
+#endif
+            for (const MSEdge* const edge : group) {
+                edge->changeLanes(t);
+            }
+#if defined(THREAD_POOL) || defined(HAVE_FOX)
+        }
+#endif
+        for (const MSEdge* const edge : group) {
+            updateLaneUsage(*edge, toAdd);
+        }
+    }
+    // cross-edge changes are resolved afterwards
+    for (const MSEdge* const edge : serial) {
+        edge->changeLanes(t);
+        updateLaneUsage(*edge, toAdd);
+    }
+}
 
-    MSGlobals::gComputeLC = false;
-    for (std::vector<MSLane*>::iterator i = toAdd.begin(); i != toAdd.end(); ++i) {
-        myActiveLanes.push_front(*i);
+
+void
+MSEdgeControl::updateLaneUsage(const MSEdge& edge, std::vector<MSLane*>& toAdd) {
+    for (MSLane* const lane : edge.getLanes()) {
+        LaneUsage& lu = myLanes[lane->getNumericalID()];
+        if (lane->getVehicleNumber() > 0 && !lu.amActive) {
+            toAdd.push_back(lane);
+            lu.amActive = true;
+        }
+        if (MSGlobals::gLateralResolution > 0) {
+            lane->sortManeuverReservations();
+        }
+    }
+}
+
+
+const std::vector<int>&
+MSEdgeControl::getLaneChangeResources(const MSEdge& edge) {
+    std::vector<int>& resources = myLaneChangeResources[edge.getNumericalID()];
+    if (resources.empty()) {
+        // the edge itself and all edges meeting at its junctions
+        resources.push_back(edge.getNumericalID());
+        for (const MSJunction* const junction : {
+                    edge.getFromJunction(), edge.getToJunction()
+                }) {
+            if (junction != nullptr) {
+                for (const MSEdge* const e : junction->getIncoming()) {
+                    resources.push_back(e->getNumericalID());
+                }
+                for (const MSEdge* const e : junction->getOutgoing()) {
+                    resources.push_back(e->getNumericalID());
+                }
+            }
+        }
+        // the random number generators of the edge's lanes
+        for (const MSLane* const lane : edge.getLanes()) {
+            resources.push_back((int)myEdges.size() + lane->getRNGIndex());
+        }
+        std::sort(resources.begin(), resources.end());
+        resources.erase(std::unique(resources.begin(), resources.end()), resources.end());
     }
+    return resources;
 }
 
 
@@ -32,6 +32,7 @@
 #include <list>
 #include <set>
 #include <queue>
+#include <functional>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/Named.h>
 #include <utils/common/StopWatch.h>
@@ -57,6 +58,7 @@
 class MSEdge;
 class MSLane;
 class MSJunction;
+class MSVehicle;
 class OutputDevice;
 
 typedef std::vector<MSEdge*> MSEdgeVector;
@@ -143,9 +145,41 @@ public:
     void needsVehicleIntegration(MSLane* const l) {
         myWithVehicles2Integrate.push_back(l);
     }
+
+    /// @brief registers a vehicle with move reminders deferred to the device phase
+    void needsDeviceUpdate(MSVehicle* const veh) {
+        myWithDeviceUpdates.push_back(veh);
+    }
+
+    /// @brief whether executeMovements is running (so move reminders may be deferred)
+    bool isExecutingMovements() const {
+        return myAmExecutingMovements;
+    }
     /// @}
 
 
+    /** @brief Computes the cached positions of all vehicles on the active lanes
+     *
+     * Done in parallel when using multiple threads, so that the outputs which
+     *  query the positions afterwards only read the cache.
+     */
+    void computePositions();
+
+    /** @brief Runs the given function on chunks of the index range [begin, end) using the simulation threads
+     *
+     * With a positive grain the chunks are [begin + i * grain, begin + (i + 1) * grain),
+     *  so they do not depend on the number of threads and results collected per chunk
+     *  can be merged in a reproducible order. Otherwise the range is split into a few
+     *  chunks per thread. Without simulation threads the whole range is processed by
+     *  the calling thread. Must not be called from within a task of the thread pool.
+     * @param[in] begin The first index
+     * @param[in] end The index after the last one
+     * @param[in] grain The chunk size (or a non-positive number for an automatic split)
+     * @param[in] fn The function processing the chunk given by its begin and end
+     */
+    void parallelFor(const int begin, const int end, const int grain, const std::function<void(int, int)>& fn);
+
+
     /** @brief Moves (precomputes) critical vehicles
      *
      * Calls "changeLanes" of each of the multi-lane edges. Check then for this
@@ -156,6 +190,16 @@ public:
      */
     void changeLanes(const SUMOTime t);
 
+    /** @brief Performs lane changing in groups of mutually independent edges
+     *
+     * Edges which share neither a junction, a neighboring edge nor a random
+     *  number generator are processed in parallel. The groups are built from
+     *  the numerical ids only, so the result does not depend on the number of
+     *  threads. Edges which may change onto another edge (opposite or bidi)
+     *  are processed serially afterwards.
+     */
+    void changeLanesGrouped(const SUMOTime t, std::vector<MSLane*>& toAdd);
+
 
     /** @brief Detect collisions
      *
@@ -205,6 +249,7 @@ public:
     void setActiveLanes(std::list<MSLane*> lanes);
 
 
+
 #ifndef THREAD_POOL
 #ifdef HAVE_FOX
     MFXWorkerThread::Pool& getThreadPool() {
@@ -232,6 +277,10 @@ public:
         bool amActive;
         /// @brief Information whether this lane belongs to a multi-lane edge
         bool haveNeighbors;
+        /// @brief The measured time for planning the movements in one step (moving average, negative if not measured yet)
+        double cost = -1.;
+        /// @brief The measured time since the threads were assigned
+        double work = 0.;
     };
 
 #ifdef HAVE_FOX
@@ -264,6 +313,34 @@ public:
 #endif
 
 private:
+    /** @brief Assigns every lane to a simulation thread
+     *
+     * The lanes are ordered along a space filling curve (z-order of the lane
+     *  centers) and cut into chunks of similar total weight, so every thread
+     *  works on a compact region of the network. Neighboring lanes (and the
+     *  vehicles passing between them) thus stay in the caches of one core.
+     *  The weight is the length of the lane at the start and mostly the
+     *  measured work since the last assignment later on (lanes near complex
+     *  junctions cost much more than motorway lanes of the same length).
+     *  The random number generators are not affected, so the results do not
+     *  change.
+     */
+    void assignThreads();
+
+    /** @brief Runs the given function for the lanes using the simulation threads
+     *
+     * Each lane is processed by its thread. The lanes of a thread are batched
+     *  into tasks of similar estimated cost (a few per thread) so cheap lanes
+     *  do not cause one task each.
+     * @param[in] lanes The lanes to process
+     * @param[in] fn The function to call for each lane
+     * @param[in] measure Whether the time of each call is measured for the cost estimates
+     */
+    void processLanes(const std::vector<MSLane*>& lanes, const std::function<void(MSLane*)>& fn, const bool measure);
+
+    /// @brief the thread which processes the given lane
+    int getThreadIndex(const MSLane* const lane) const;
+
     /// @brief Loaded edges
     MSEdgeVector myEdges;
 
@@ -279,6 +356,12 @@ private:
     /// @brief A storage for lanes which shall be integrated because vehicles have moved onto them
     MFXSynchQue<MSLane*, std::vector<MSLane*> > myWithVehicles2Integrate;
 
+    /// @brief Vehicles whose parallel safe move reminders still need to be notified
+    MFXSynchQue<MSVehicle*, std::vector<MSVehicle*> > myWithDeviceUpdates;
+
+    /// @brief whether executeMovements is running
+    bool myAmExecutingMovements;
+
     /// @brief Lanes which changed the state without informing the control
     std::set<MSLane*, ComparatorNumericalIdLess> myChangedStateLanes;
 
@@ -290,6 +373,30 @@ private:
 
     double myMinLengthGeometryFactor;
 
+    /// @brief The (lazily computed) resources an edge occupies while changing lanes (edges and rngs)
+    std::vector<std::vector<int> > myLaneChangeResources;
+
+    /// @brief The lane changing groups using a resource in the current step
+    std::vector<std::vector<int> > myResourceGroups;
+
+    /// @brief The simulation thread of each lane (indexed by numerical id)
+    std::vector<int> myLaneThreads;
+
+    /// @brief The mean cost of the lanes measured in the last step (for lanes without a measurement)
+    double myMeanLaneCost;
+
+    /// @brief The number of measured steps since the threads were assigned
+    int myMeasuredSteps;
+
+    /// @brief The weight of new measurements in the moving average of the lane costs
+    static const double COST_SMOOTHING;
+
+    /// @brief The number of measured steps after which the threads are assigned again
+    static const int REASSIGN_STEPS;
+
+    /// @brief The number of tasks which are formed per thread in processLanes
+    static const int TASKS_PER_THREAD;
+
 #ifdef THREAD_POOL
     WorkStealingThreadPool<> myThreadPool;
 #else
@@ -300,7 +407,39 @@ private:
 
     std::vector<StopWatch<std::chrono::nanoseconds> > myStopWatch;
 
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    /**
+     * @class RangeTask
+     * @brief the task processing one chunk of a parallelFor
+     */
+    class RangeTask : public MFXWorkerThread::Task {
+    public:
+        RangeTask(const std::function<void(int, int)>& fn, const int begin, const int end) : myFn(fn), myBegin(begin), myEnd(end) {}
+        void run(MFXWorkerThread* /*context*/) {
+            myFn(myBegin, myEnd);
+        }
+    private:
+        const std::function<void(int, int)>& myFn;
+        const int myBegin;
+        const int myEnd;
+    private:
+        /// @brief Invalidated assignment operator.
+        RangeTask& operator=(const RangeTask&) = delete;
+    };
+#endif
+#endif
+
 private:
+    /// @brief notifies the move reminders which were deferred during executeMovements
+    void executeDevices();
+
+    /// @brief mark the lanes of the given edge as active if they received vehicles
+    void updateLaneUsage(const MSEdge& edge, std::vector<MSLane*>& toAdd);
+
+    /// @brief return the resources which must not be shared by edges changing lanes in parallel
+    const std::vector<int>& getLaneChangeResources(const MSEdge& edge);
+
     /// @brief Copy constructor.
     MSEdgeControl(const MSEdgeControl&);
 
@@ -121,4 +121,15 @@ MSEdgeWeightsStorage::knowsEffort(const MSEdge* const e) const {
 }
 
 
+void
+MSEdgeWeightsStorage::compact() {
+    for (auto& item : myTravelTimes) {
+        item.second.compact();
+    }
+    for (auto& item : myEfforts) {
+        item.second.compact();
+    }
+}
+
+
 /****************************************************************************/
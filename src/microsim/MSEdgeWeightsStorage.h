@@ -110,6 +110,14 @@ public:
     bool knowsEffort(const MSEdge* const e) const;
 
 
+    /** @brief Converts all time lines with equal interval lengths to arrays
+     *
+     * Should be called after loading, values added later are stored as before.
+     * @see ValueTimeLine::compact
+     */
+    void compact();
+
+
 private:
     /// @brief A map of edge->time->travel time
     std::map<const MSEdge*, ValueTimeLine<double> > myTravelTimes;
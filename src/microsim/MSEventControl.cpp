@@ -24,6 +24,7 @@
 #include <config.h>
 
 #include <cassert>
+#include <algorithm>
 #include "MSEventControl.h"
 #include <utils/common/MsgHandler.h>
 #include <utils/common/Command.h>
@@ -34,64 +35,135 @@
 // member definitions
 // ===========================================================================
 MSEventControl::MSEventControl() :
-    myEvents() {}
+    myBuckets(WHEEL_SIZE),
+    myCurrentStep(0),
+    myWheelSize(0),
+    myDueLimit(0),
+    myAmExecuting(false) {}
 
 
 MSEventControl::~MSEventControl() {
     // delete the events
+    for (const std::vector<Event>& bucket : myBuckets) {
+        for (const Event& e : bucket) {
+            delete e.first;
+        }
+    }
     for (const Event& e : myEvents) {
         delete e.first;
     }
+    for (const Event& e : myDueEvents) {
+        delete e.first;
+    }
 }
 
 
 void
 MSEventControl::addEvent(Command* operation, SUMOTime execTimeStep) {
-    myEvents.emplace_back(Event(operation, execTimeStep));
-    std::push_heap(myEvents.begin(), myEvents.end(), MSEventControl::eventCompare);
+    if (myAmExecuting && execTimeStep < myDueLimit) {
+        myDueEvents.emplace_back(Event(operation, execTimeStep));
+        std::push_heap(myDueEvents.begin(), myDueEvents.end(), MSEventControl::eventCompare);
+    } else {
+        insertEvent(Event(operation, execTimeStep));
+    }
+}
+
+
+void
+MSEventControl::insertEvent(const Event& e) {
+    // events in the past are due at the current wheel position
+    const SUMOTime step = MAX2(getStep(e.second), myCurrentStep);
+    if (step < myCurrentStep + WHEEL_SIZE) {
+        myBuckets[step & (WHEEL_SIZE - 1)].push_back(e);
+        myWheelSize++;
+    } else {
+        myEvents.push_back(e);
+        std::push_heap(myEvents.begin(), myEvents.end(), MSEventControl::eventCompare);
+    }
+}
+
+
+void
+MSEventControl::collectDueEvents(SUMOTime dueLimit) {
+    const SUMOTime lastStep = MAX2(getStep(dueLimit - 1), myCurrentStep);
+    // after a jump beyond the horizon every bucket has to be visited once
+    const SUMOTime firstStep = MAX2(myCurrentStep, lastStep - WHEEL_SIZE + 1);
+    for (SUMOTime step = firstStep; step <= lastStep && myWheelSize > 0; step++) {
+        std::vector<Event>& bucket = myBuckets[step & (WHEEL_SIZE - 1)];
+        // keep the events of the last step which are not due yet
+        auto keep = bucket.begin();
+        for (const Event& e : bucket) {
+            if (e.second < dueLimit) {
+                myDueEvents.push_back(e);
+                myWheelSize--;
+            } else {
+                *keep++ = e;
+            }
+        }
+        bucket.erase(keep, bucket.end());
+    }
+    myCurrentStep = lastStep;
+    // fetch the events which are now within the horizon
+    while (!myEvents.empty() && getStep(myEvents.front().second) < myCurrentStep + WHEEL_SIZE) {
+        const Event e = myEvents.front();
+        std::pop_heap(myEvents.begin(), myEvents.end(), eventCompare);
+        myEvents.pop_back();
+        if (e.second < dueLimit) {
+            myDueEvents.push_back(e);
+        } else {
+            insertEvent(e);
+        }
+    }
+    std::make_heap(myDueEvents.begin(), myDueEvents.end(), eventCompare);
 }
 
 
 void
 MSEventControl::execute(SUMOTime execTime) {
     // Execute all events that are scheduled for execTime.
-    while (!myEvents.empty()) {
-        Event currEvent = myEvents.front();
+    myDueLimit = execTime + DELTA_T;
+    collectDueEvents(myDueLimit);
+    myAmExecuting = true;
+    while (!myDueEvents.empty()) {
+        Event currEvent = myDueEvents.front();
         if (currEvent.second < 0) {
             currEvent.second = execTime;
         }
-        if (currEvent.second < execTime + DELTA_T) {
-            Command* command = currEvent.first;
-            std::pop_heap(myEvents.begin(), myEvents.end(), eventCompare);
-            myEvents.pop_back();
-            SUMOTime time = 0;
-            try {
-                time = command->execute(execTime);
-            } catch (...) {
-                delete command;
-                throw;
+        Command* command = currEvent.first;
+        std::pop_heap(myDueEvents.begin(), myDueEvents.end(), eventCompare);
+        myDueEvents.pop_back();
+        SUMOTime time = 0;
+        try {
+            time = command->execute(execTime);
+        } catch (...) {
+            delete command;
+            // keep the remaining events for the next call
+            myAmExecuting = false;
+            for (const Event& e : myDueEvents) {
+                insertEvent(e);
             }
+            myDueEvents.clear();
+            throw;
+        }
 
-            // Delete nonrecurring events, reinsert recurring ones
-            // with new execution time = execTime + returned offset.
-            if (time <= 0) {
-                if (time < 0) {
-                    WRITE_WARNING("Command returned negative repeat number; will be deleted.");
-                }
-                delete currEvent.first;
-            } else {
-                addEvent(currEvent.first, currEvent.second + time);
+        // Delete nonrecurring events, reinsert recurring ones
+        // with new execution time = execTime + returned offset.
+        if (time <= 0) {
+            if (time < 0) {
+                WRITE_WARNING("Command returned negative repeat number; will be deleted.");
             }
+            delete currEvent.first;
         } else {
-            break;
+            addEvent(currEvent.first, currEvent.second + time);
         }
     }
+    myAmExecuting = false;
 }
 
 
 bool
 MSEventControl::isEmpty() {
-    return myEvents.empty();
+    return myWheelSize == 0 && myEvents.empty() && myDueEvents.empty();
 }
 
 bool
@@ -101,16 +173,22 @@ MSEventControl::eventCompare(const Event& e1, const Event& e2) {
 
 void
 MSEventControl::clearState(SUMOTime currentTime, SUMOTime newTime) {
-    for (auto eventIt = myEvents.begin(); eventIt != myEvents.end();) {
-        eventIt->second = eventIt->first->shiftTime(currentTime, eventIt->second, newTime);
-        if (eventIt->second >= 0) {
-            ++eventIt;
+    std::vector<Event> events;
+    events.swap(myEvents);
+    for (std::vector<Event>& bucket : myBuckets) {
+        events.insert(events.end(), bucket.begin(), bucket.end());
+        bucket.clear();
+    }
+    myWheelSize = 0;
+    myCurrentStep = MAX2((SUMOTime)0, getStep(newTime));
+    for (Event& e : events) {
+        e.second = e.first->shiftTime(currentTime, e.second, newTime);
+        if (e.second >= 0) {
+            insertEvent(e);
         } else {
-            delete eventIt->first;
-            eventIt = myEvents.erase(eventIt);
+            delete e.first;
         }
     }
-    std::make_heap(myEvents.begin(), myEvents.end(), eventCompare);
 }
 
 
@@ -43,12 +43,21 @@ class Command;
 /**
  * @class MSEventControl
  * @brief Stores time-dependant events and executes them at the proper time
+ *
+ * The events are kept in a timing wheel with one bucket per simulation step
+ *  for the next WHEEL_SIZE steps, so adding an event costs constant time.
+ *  Events beyond the horizon of the wheel are kept in a heap and moved into
+ *  the wheel once it reaches them. Only the events which are due in a call
+ *  of execute are ordered (by time and priority).
  */
 class MSEventControl {
 public:
     /// @brief Combination of an event and the time it shall be executed at
     typedef std::pair< Command*, SUMOTime > Event;
 
+    /// @brief The number of steps covered by the timing wheel (a power of two)
+    static const int WHEEL_SIZE = 1024;
+
 
 public:
     /// @brief Default constructor.
@@ -106,9 +115,40 @@ protected:
 
 
 private:
-    /// @brief Event-container, holds executable events.
+    /// @brief returns the step of the given time (-1 for negative times)
+    static SUMOTime getStep(SUMOTime time) {
+        return time < 0 ? -1 : time / DELTA_T;
+    }
+
+    /// @brief inserts the event into the wheel or (if it lies beyond the horizon) into the heap
+    void insertEvent(const Event& e);
+
+    /// @brief moves all events before the given time into myDueEvents and advances the wheel to its step
+    void collectDueEvents(SUMOTime dueLimit);
+
+
+private:
+    /// @brief The buckets of the timing wheel, holding the events of one step each (in arbitrary order)
+    std::vector<std::vector<Event> > myBuckets;
+
+    /// @brief The step of the current wheel position
+    SUMOTime myCurrentStep;
+
+    /// @brief The number of events in the wheel
+    int myWheelSize;
+
+    /// @brief Heap of the events beyond the horizon of the wheel
     std::vector<Event> myEvents;
 
+    /// @brief Heap of the events to execute in the running call of execute
+    std::vector<Event> myDueEvents;
+
+    /// @brief Events before this time are added to myDueEvents directly (while executing)
+    SUMOTime myDueLimit;
+
+    /// @brief Whether execute is running
+    bool myAmExecuting;
+
 
 private:
     /// @brief invalid copy constructor.
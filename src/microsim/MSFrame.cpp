@@ -36,6 +36,7 @@
 #include <utils/common/ToString.h>
 #include <utils/common/StringUtils.h>
 #include <utils/geom/GeoConvHelper.h>
+#include <utils/geom/GeomConvHelper.h>
 #include <utils/iodevices/OutputDevice.h>
 #include <utils/vehicle/SUMOVehicleParserHelper.h>
 #include <microsim/MSBaseVehicle.h>
@@ -47,7 +48,12 @@
 #include <microsim/lcmodels/MSAbstractLaneChangeModel.h>
 #include <microsim/devices/MSDevice.h>
 #include <microsim/devices/MSDevice_Vehroutes.h>
+#include <microsim/output/MSHardwareCounters.h>
+#include <microsim/output/MSTripStatistics.h>
+#include <microsim/output/MSStepProfiler.h>
 #include <microsim/output/MSStopOut.h>
+#include <microsim/output/MSFCDColumnarWriter.h>
+#include <utils/common/PerformanceCounters.h>
 #include <utils/common/RandHelper.h>
 #include "MSFrame.h"
 #include <utils/common/SystemFrame.h>
@@ -103,6 +109,12 @@ MSFrame::fillOptions() {
     oc.doRegister("junction-taz", new Option_Bool(false));
     oc.addDescription("junction-taz", "Input", TL("Initialize a TAZ for every junction to use attributes toJunction and fromJunction"));
 
+    oc.doRegister("batch", new Option_FileName());
+    oc.addDescription("batch", "Input", TL("Runs one scenario per line of FILE (given as additional options) after each other, parsing the network only once"));
+
+    oc.doRegister("ensemble", new Option_Integer(0));
+    oc.addDescription("ensemble", "Input", TL("Runs the simulation INT times with consecutive seeds (starting with --seed), parsing the network only once"));
+
     // need to do this here to be able to check for network and route input options
     SystemFrame::addReportOptions(oc);
 
@@ -158,7 +170,7 @@ MSFrame::fillOptions() {
     oc.addDescription("substations-output.precision", "Output", TL("Write substation values with the given precision (default 2)"));
 
     oc.doRegister("fcd-output", new Option_FileName());
-    oc.addDescription("fcd-output", "Output", TL("Save the Floating Car Data"));
+    oc.addDescription("fcd-output", "Output", TL("Save the Floating Car Data (in columnar binary format if the file name ends with .bin or .bin.gz)"));
     oc.doRegister("fcd-output.geo", new Option_Bool(false));
     oc.addDescription("fcd-output.geo", "Output", TL("Save the Floating Car Data using geo-coordinates (lon/lat)"));
     oc.doRegister("fcd-output.signals", new Option_Bool(false));
@@ -171,6 +183,8 @@ MSFrame::fillOptions() {
     oc.addDescription("fcd-output.max-leader-distance", "Output", TL("Add leader vehicle information to the FCD output (within the given distance)"));
     oc.doRegister("fcd-output.params", new Option_StringVector());
     oc.addDescription("fcd-output.params", "Output", TL("Add generic parameter values to the FCD output"));
+    oc.doRegister("fcd-output.tolerance", new Option_Float(0));
+    oc.addDescription("fcd-output.tolerance", "Output", TL("Omit vehicle records whose position deviates at most FLOAT from the extrapolation of their previous record"));
     oc.doRegister("fcd-output.filter-edges.input-file", new Option_FileName());
     oc.addDescription("fcd-output.filter-edges.input-file", "Output", TL("Restrict fcd output to the edge selection from the given input file"));
     oc.doRegister("fcd-output.attributes", new Option_StringVector());
@@ -215,6 +229,12 @@ MSFrame::fillOptions() {
     oc.doRegister("tripinfo-output.write-undeparted", new Option_Bool(false));
     oc.addDescription("tripinfo-output.write-undeparted", "Output", TL("Write tripinfo output for vehicles which have not departed at simulation end because of depart delay"));
 
+    oc.doRegister("tripinfo-statistics-output", new Option_FileName());
+    oc.addDescription("tripinfo-statistics-output", "Output", TL("Write histograms of duration, timeLoss and waitingTime of the arrived vehicles per vType and TAZ pair into FILE (without per-vehicle output)"));
+
+    oc.doRegister("tripinfo-statistics-output.bin-width", new Option_String("10", "TIME"));
+    oc.addDescription("tripinfo-statistics-output.bin-width", "Output", TL("Use histogram bins of TIME width for the tripinfo statistics"));
+
     oc.doRegister("personinfo-output", new Option_FileName());
     oc.addSynonyme("personinfo-output", "personinfo");
     oc.addDescription("personinfo-output", "Output", TL("Save personinfo and containerinfo to separate FILE"));
@@ -278,6 +298,12 @@ MSFrame::fillOptions() {
     oc.doRegister("railsignal-block-output", new Option_FileName());
     oc.addDescription("railsignal-block-output", "Output", TL("Save railsignal-blocks into FILE"));
 
+    oc.doRegister("partition-output", new Option_FileName());
+    oc.addDescription("partition-output", "Output", TL("Save a spatial partition of the network edges and the edges at partition boundaries into FILE"));
+
+    oc.doRegister("partition-output.parts", new Option_Integer(2));
+    oc.addDescription("partition-output.parts", "Output", TL("Number of partitions to write with option --partition-output"));
+
     oc.doRegister("bt-output", new Option_FileName());
     oc.addDescription("bt-output", "Output", TL("Save bluetooth visibilities into FILE (in conjunction with device.btreceiver and device.btsender)"));
 
@@ -310,6 +336,18 @@ MSFrame::fillOptions() {
     oc.addSynonyme("statistic-output", "statistics-output");
     oc.addDescription("statistic-output", "Output", TL("Write overall statistics into FILE"));
 
+    oc.doRegister("ensemble-output", new Option_FileName());
+    oc.addDescription("ensemble-output", "Output", TL("Write mean, standard deviation and quantiles of the overall statistics of all ensemble runs into FILE"));
+
+    oc.doRegister("profile-output", new Option_FileName());
+    oc.addDescription("profile-output", "Output", TL("Write the time spent in the simulation phases and thread tasks as Chrome trace (JSON) into FILE"));
+
+    oc.doRegister("hardware-counter-output", new Option_FileName());
+    oc.addDescription("hardware-counter-output", "Output", TL("Write cycles, instructions, cache and branch misses of the simulation phases into FILE (requires a build with PERF_EVENTS)"));
+
+    oc.doRegister("hardware-counter-output.period", new Option_Integer(1000));
+    oc.addDescription("hardware-counter-output.period", "Output", TL("Aggregate the hardware counters over INT simulation steps"));
+
 #ifdef _DEBUG
     oc.doRegister("movereminder-output", new Option_FileName());
     oc.addDescription("movereminder-output", "Output", TL("Save movereminder states of selected vehicles into FILE"));
@@ -326,7 +364,7 @@ MSFrame::fillOptions() {
     oc.doRegister("save-state.prefix", new Option_FileName(StringVector({ "state" })));
     oc.addDescription("save-state.prefix", "Output", TL("Prefix for network states"));
     oc.doRegister("save-state.suffix", new Option_String(".xml.gz"));
-    oc.addDescription("save-state.suffix", "Output", TL("Suffix for network states (.xml.gz or .xml)"));
+    oc.addDescription("save-state.suffix", "Output", TL("Suffix for network states (.xml.gz, .xml or the binary .sbx)"));
     oc.doRegister("save-state.files", new Option_FileName());
     oc.addDescription("save-state.files", "Output", TL("Files for network states"));
     oc.doRegister("save-state.rng", new Option_Bool(false));
@@ -348,6 +386,12 @@ MSFrame::fillOptions() {
     oc.doRegister("step-length", new Option_String("1", "TIME"));
     oc.addDescription("step-length", "Time", TL("Defines the step duration in seconds"));
 
+    oc.doRegister("real-time", new Option_Float(0));
+    oc.addDescription("real-time", "Time", TL("Keep pace with the wall clock, simulating FLOAT seconds per second (0 runs as fast as possible)"));
+
+    oc.doRegister("real-time.shed-lag", new Option_String("-1", "TIME"));
+    oc.addDescription("real-time.shed-lag", "Time", TL("Skip periodic rerouting and fcd output while the simulation lags more than TIME behind the wall clock (negative never skips)"));
+
     oc.doRegister("step-method.ballistic", new Option_Bool(false));
     oc.addDescription("step-method.ballistic", "Processing", TL("Whether to use ballistic method for the positional update of vehicles (default is a semi-implicit Euler method)."));
 
@@ -357,6 +401,27 @@ MSFrame::fillOptions() {
     oc.doRegister("threads", new Option_Integer(1));
     oc.addDescription("threads", "Processing", TL("Defines the number of threads for parallel simulation"));
 
+    oc.doRegister("kinematics-mirror", new Option_Bool(false));
+    oc.addDescription("kinematics-mirror", "Processing", TL("Keep a compact per-lane copy of vehicle positions and speeds to speed up leader lookups"));
+
+    oc.doRegister("junction-phase", new Option_Bool(false));
+    oc.addDescription("junction-phase", "Processing", TL("Compute right-of-way decisions once per step for all junctions (in parallel when using multiple threads) before executing movements"));
+
+    oc.doRegister("device-phase", new Option_Bool(false));
+    oc.addDescription("device-phase", "Processing", TL("Update thread safe devices (e.g. emissions) after executing movements (in parallel when using multiple threads)"));
+
+    oc.doRegister("tls-phase", new Option_Bool(false));
+    oc.addDescription("tls-phase", "Processing", TL("Evaluate actuated and delay based traffic lights at the start of the step (in parallel when using multiple threads)"));
+
+    oc.doRegister("position-phase", new Option_Bool(false));
+    oc.addDescription("position-phase", "Processing", TL("Compute the positions of all vehicles once before writing outputs (in parallel when using multiple threads)"));
+
+    oc.doRegister("freeflow-skip", new Option_String("0", "TIME"));
+    oc.addDescription("freeflow-skip", "Processing", TL("Skip the movement planning of isolated vehicles in free flow for up to TIME and let them keep their speed (0 disables)"));
+
+    oc.doRegister("stop-skip", new Option_Bool(false));
+    oc.addDescription("stop-skip", "Processing", TL("Skip the movement planning of vehicles waiting at untriggered stops until the stop ends or transportables want to board"));
+
     oc.doRegister("lateral-resolution", new Option_Float(-1));
     oc.addDescription("lateral-resolution", "Processing", TL("Defines the resolution in m when handling lateral positioning within a lane (with -1 all vehicles drive at the center of their lane"));
 
@@ -364,6 +429,15 @@ MSFrame::fillOptions() {
     oc.doRegister("route-steps", 's', new Option_String("200", "TIME"));
     oc.addDescription("route-steps", "Processing", TL("Load routes for the next number of seconds ahead"));
 
+    oc.doRegister("route-prefetch", new Option_Bool(false));
+    oc.addDescription("route-prefetch", "Processing", TL("Parse the route files in background threads ahead of the simulation"));
+
+    oc.doRegister("parse-threads", new Option_Integer(0));
+    oc.addDescription("parse-threads", "Processing", TL("Parse large xml inputs (routes, additionals, edge data) in chunks using INT threads"));
+
+    oc.doRegister("compact-routes", new Option_Bool(false));
+    oc.addDescription("compact-routes", "Processing", TL("Let routes with identical edges share their edge list to reduce memory"));
+
     oc.doRegister("no-internal-links", new Option_Bool(false));
     oc.addDescription("no-internal-links", "Processing", TL("Disable (junction) internal links"));
 
@@ -457,6 +531,9 @@ MSFrame::fillOptions() {
     oc.doRegister("lanechange.overtake-right", new Option_Bool(false));
     oc.addDescription("lanechange.overtake-right", "Processing", TL("Whether overtaking on the right on motorways is permitted"));
 
+    oc.doRegister("lanechange.parallel", new Option_Bool(false));
+    oc.addDescription("lanechange.parallel", "Processing", TL("Compute lane changes in groups of independent edges (in parallel when using multiple threads) with results independent of the number of threads"));
+
     oc.doRegister("tls.all-off", new Option_Bool(false));
     oc.addDescription("tls.all-off", "Processing", TL("Switches off all traffic lights."));
 
@@ -509,6 +586,9 @@ MSFrame::fillOptions() {
     oc.doRegister("parking.maneuver", new Option_Bool(false));
     oc.addDescription("parking.maneuver", "Processing", TL("Whether parking simulation includes maneuvering time and associated lane blocking"));
 
+    oc.doRegister("parking.dormant-threshold", new Option_String("-1", "TIME"));
+    oc.addDescription("parking.dormant-threshold", "Processing", TL("Release the look-ahead data of vehicles which are parked for longer than TIME (rebuilt on departure)"));
+
     oc.doRegister("use-stop-ended", new Option_Bool(false));
     oc.addDescription("use-stop-ended", "Processing", TL("Override stop until times with stop ended times when given"));
 
@@ -550,19 +630,25 @@ MSFrame::fillOptions() {
     oc.doRegister("pedestrian.striping.walkingarea-detail", new Option_Integer(4));
     oc.addDescription("pedestrian.striping.walkingarea-detail", "Processing", TL("Generate INT intermediate points to smooth out lanes within the walkingarea"));
 
+    oc.doRegister("pedestrian.striping.parallel", new Option_Bool(false));
+    oc.addDescription("pedestrian.striping.parallel", "Processing", TL("Move the pedestrians of different lanes in parallel (when running with multiple threads), the results do not depend on the number of threads"));
+
     oc.doRegister("pedestrian.jupedsim.step-length", new Option_String("0.01", "TIME"));
     oc.addDescription("pedestrian.jupedsim.step-length", "Processing", TL("The update interval of the JuPedSim simulation (in seconds)"));
 
     oc.doRegister("pedestrian.jupedsim.exit-tolerance", new Option_Float(1.));
     oc.addDescription("pedestrian.jupedsim.exit-tolerance", "Processing", TL("The distance to the destination point considered as arrival (in meters)"));
 
+    oc.doRegister("pedestrian.jupedsim.async", new Option_Bool(false));
+    oc.addDescription("pedestrian.jupedsim.async", "Processing", TL("Run the JuPedSim iterations while the vehicles move and update the pedestrians at the end of the step"));
+
     oc.doRegister("ride.stop-tolerance", new Option_Float(10.));
     oc.addDescription("ride.stop-tolerance", "Processing", TL("Tolerance to apply when matching pedestrian and vehicle positions on boarding at individual stops"));
 
     // generic routing options
     oc.doRegister("routing-algorithm", new Option_String("dijkstra"));
     oc.addDescription("routing-algorithm", "Routing",
-                      "Select among routing algorithms ['dijkstra', 'astar', 'CH', 'CHWrapper']");
+                      "Select among routing algorithms ['dijkstra', 'astar', 'CH', 'CHWrapper', 'raptor' (intermodal only)]");
 
     oc.doRegister("weights.random-factor", new Option_Float(1.));
     oc.addDescription("weights.random-factor", "Routing", TL("Edge weights for routing are dynamically disturbed by a random factor drawn uniformly from [1,FLOAT)"));
@@ -585,6 +671,9 @@ MSFrame::fillOptions() {
     oc.doRegister("astar.landmark-distances", new Option_FileName());
     oc.addDescription("astar.landmark-distances", "Routing", TL("Initialize lookup table for astar ALT-variant from the given file"));
 
+    oc.doRegister("ch.reuse-order", new Option_Bool(false));
+    oc.addDescription("ch.reuse-order", "Routing", TL("Rebuild contraction hierarchies for new edge weights in the order of the first build instead of recomputing priorities"));
+
     oc.doRegister("persontrip.walkfactor", new Option_Float(double(0.75)));
     oc.addDescription("persontrip.walkfactor", "Routing", TL("Use FLOAT as a factor on pedestrian maximum speed during intermodal routing"));
 
@@ -637,7 +726,7 @@ MSFrame::fillOptions() {
     oc.addDescription("duration-log.disable", "Report", TL("Disable performance reports for individual simulation steps"));
 
     oc.doRegister("duration-log.statistics", 't', new Option_Bool(false));
-    oc.addDescription("duration-log.statistics", "Report", TL("Enable statistics on vehicle trips"));
+    oc.addDescription("duration-log.statistics", "Report", TL("Enable statistics on vehicle trips and on the memory and time of the subsystems"));
 
     oc.doRegister("no-step-log", new Option_Bool(false));
     oc.addDescription("no-step-log", "Report", TL("Disable console output of current simulation step"));
@@ -651,6 +740,12 @@ MSFrame::fillOptions() {
     oc.addDescription("remote-port", "TraCI Server", TL("Enables TraCI Server if set"));
     oc.doRegister("num-clients", new Option_Integer(1));
     oc.addDescription("num-clients", "TraCI Server", TL("Expected number of connecting clients"));
+    oc.doRegister("traci-server.interleave-reads", new Option_Bool(false));
+    oc.addDescription("traci-server.interleave-reads", "TraCI Server", TL("Answer requests consisting of get commands only while waiting for clients served earlier in the step (results may depend on timing)"));
+    oc.doRegister("traci-server.record", new Option_FileName());
+    oc.addDescription("traci-server.record", "TraCI Server", TL("Record the requests of the TraCI client to FILE"));
+    oc.doRegister("traci-server.replay", new Option_FileName());
+    oc.addDescription("traci-server.replay", "TraCI Server", TL("Replay the TraCI requests recorded in FILE without a client and report the processing times"));
 
     oc.addOptionSubTopic("Mesoscopic");
     oc.doRegister("mesosim", new Option_Bool(false));
@@ -691,14 +786,21 @@ MSFrame::fillOptions() {
                       "Apply fixed time penalty when driving across a minor link. When using --meso-junction-control.limited, the penalty is not applied whenever limited control is active.");
     oc.doRegister("meso-overtaking", new Option_Bool(false));
     oc.addDescription("meso-overtaking", "Mesoscopic", TL("Enable mesoscopic overtaking"));
+    oc.doRegister("meso-detail-area", new Option_String("", "BOUNDARY"));
+    oc.addDescription("meso-detail-area", "Mesoscopic", TL("Enable junction control and overtaking for all edges ending inside the boundary xmin,ymin,xmax,ymax"));
     oc.doRegister("meso-recheck", new Option_String("0", "TIME"));
     oc.addDescription("meso-recheck", "Mesoscopic", TL("Time interval for rechecking insertion into the next segment after failure"));
+    oc.doRegister("meso-parallel", new Option_Bool(false));
+    oc.addDescription("meso-parallel", "Mesoscopic", TL("Process segment changes on independent edges in parallel when using multiple threads (with results independent of the number of threads)"));
 
     // add rand options
     RandHelper::insertRandOptions(oc);
     oc.doRegister("thread-rngs", new Option_Integer(64));
     oc.addDescription("thread-rngs", "Random Number",
                       "Number of pre-allocated random number generators to ensure repeatable multi-threaded simulations (should be at least the number of threads for repeatable simulations).");
+    oc.doRegister("counter-rngs", new Option_Bool(false));
+    oc.addDescription("counter-rngs", "Random Number",
+                      TL("Give each vehicle a counter based random number stream which makes results independent of the number of threads and thread-rngs"));
 
     // add GUI options
     // the reason that we include them in vanilla sumo as well is to make reusing config files easy
@@ -746,6 +848,9 @@ MSFrame::fillOptions() {
     oc.doRegister("window-pos", new Option_StringVector());
     oc.addDescription("window-pos", "GUI Only", TL("Create initial window at the given x,y position"));
 
+    oc.doRegister("snapshot-threads", new Option_Integer(0));
+    oc.addDescription("snapshot-threads", "GUI Only", TL("Write the images of scheduled snapshots with INT background threads while the simulation continues"));
+
     oc.doRegister("tracker-interval", new Option_String("1", "TIME"));
     oc.addDescription("tracker-interval", "GUI Only", TL("The aggregation period for value tracker windows"));
 
@@ -777,7 +882,8 @@ MSFrame::buildStreams() {
     OutputDevice::createDeviceByOption("tripinfo-output", "tripinfos", "tripinfo_file.xsd");
 
     //extended
-    OutputDevice::createDeviceByOption("fcd-output", "fcd-export", "fcd_file.xsd");
+    // columnar fcd output has no xml header, see MSFCDExport::write
+    OutputDevice::createDeviceByOption("fcd-output", MSFCDColumnarWriter::isColumnarFile(OptionsCont::getOptions().getString("fcd-output")) ? "" : "fcd-export", "fcd_file.xsd");
     OutputDevice::createDeviceByOption("emission-output", "emission-export", "emission_file.xsd");
     OutputDevice::createDeviceByOption("battery-output", "battery-export", "battery_file.xsd");
     if (OptionsCont::getOptions().getBool("elechybrid-output.aggregated")) {
@@ -795,11 +901,14 @@ MSFrame::buildStreams() {
     //OutputDevice::createDeviceByOption("vtk-output", "vtk-export");
     OutputDevice::createDeviceByOption("link-output", "link-output");
     OutputDevice::createDeviceByOption("railsignal-block-output", "railsignal-block-output");
+    OutputDevice::createDeviceByOption("partition-output", "partitions");
     OutputDevice::createDeviceByOption("bt-output", "bt-output");
     OutputDevice::createDeviceByOption("lanechange-output", "lanechanges");
     OutputDevice::createDeviceByOption("stop-output", "stops", "stopinfo_file.xsd");
     OutputDevice::createDeviceByOption("collision-output", "collisions", "collision_file.xsd");
     OutputDevice::createDeviceByOption("statistic-output", "statistics", "statistic_file.xsd");
+    OutputDevice::createDeviceByOption("profile-output");
+    OutputDevice::createDeviceByOption("hardware-counter-output");
 
 #ifdef _DEBUG
     OutputDevice::createDeviceByOption("movereminder-output", "movereminder-output");
@@ -807,6 +916,9 @@ MSFrame::buildStreams() {
 
     MSDevice_Vehroutes::init();
     MSStopOut::init();
+    MSStepProfiler::init();
+    MSHardwareCounters::init();
+    MSTripStatistics::init();
 }
 
 
@@ -814,10 +926,18 @@ bool
 MSFrame::checkOptions() {
     OptionsCont& oc = OptionsCont::getOptions();
     bool ok = true;
-    if (!oc.isSet("net-file") && oc.isDefault("remote-port")) {
+    if (!oc.isSet("net-file") && oc.isDefault("remote-port") && !oc.isSet("traci-server.replay")) {
         WRITE_ERROR(TL("No network file (-n) specified."));
         ok = false;
     }
+    if (oc.isSet("traci-server.replay") && (oc.isSet("traci-server.record") || oc.getInt("num-clients") != 1)) {
+        WRITE_ERROR(TL("A TraCI trace can only be replayed for a single client and without recording."));
+        ok = false;
+    }
+    if (oc.isSet("traci-server.record") && oc.getInt("num-clients") != 1) {
+        WRITE_ERROR(TL("TraCI requests can only be recorded for a single client."));
+        ok = false;
+    }
     if (oc.getFloat("scale") < 0.) {
         WRITE_ERROR(TL("Invalid scaling factor."));
         ok = false;
@@ -844,6 +964,9 @@ MSFrame::checkOptions() {
         }
         oc.setDefault("meso-junction-control", "true");
     }
+    if (oc.isSet("meso-detail-area")) {
+        GeomConvHelper::parseBoundaryReporting(oc.getString("meso-detail-area"), "option", "meso-detail-area", ok);
+    }
     if (oc.getBool("mesosim")) {
         if (oc.isDefault("pedestrian.model")) {
             oc.setDefault("pedestrian.model", "nonInteracting");
@@ -876,6 +999,14 @@ MSFrame::checkOptions() {
         WRITE_ERROR(TL("the minimum step-length is 0.001"));
         ok = false;
     }
+    if (oc.getInt("ensemble") < 0) {
+        WRITE_ERROR(TL("The number of ensemble runs must not be negative."));
+        ok = false;
+    }
+    if (oc.getFloat("real-time") < 0) {
+        WRITE_ERROR(TL("The real-time factor must not be negative."));
+        ok = false;
+    }
     const SUMOTime period = string2time(oc.getString("device.fcd.period"));
     if (period > 0) {
         checkStepLengthMultiple(period, " for device.fcd.period", deltaT);
@@ -983,11 +1114,15 @@ MSFrame::checkOptions() {
         ok = false;
     }
 #endif
+    if (oc.getInt("partition-output.parts") < 1) {
+        WRITE_ERROR(TL("You need at least one partition."));
+        ok = false;
+    }
     if (oc.getInt("threads") < 1) {
         WRITE_ERROR(TL("You need at least one thread."));
         ok = false;
     }
-    if (oc.getInt("threads") > oc.getInt("thread-rngs")) {
+    if (oc.getInt("threads") > oc.getInt("thread-rngs") && !oc.getBool("counter-rngs")) {
         WRITE_WARNING(TL("Number of threads exceeds number of thread-rngs. Simulation runs with the same seed may produce different results"));
     }
     if (oc.getString("game.mode") != "tls" && oc.getString("game.mode") != "drt") {
@@ -1018,6 +1153,8 @@ MSFrame::setMSGlobals(OptionsCont& oc) {
     MSGlobals::gOmitEmptyEdgesOnDump = !oc.getBool("netstate-dump.empty-edges");
     // set whether internal lanes shall be used
     MSGlobals::gUsingInternalLanes = !oc.getBool("no-internal-links");
+    // count objects and time per subsystem for the statistics
+    PerformanceCounters::setEnabled(oc.getBool("duration-log.statistics"));
     MSGlobals::gIgnoreJunctionBlocker = string2time(oc.getString("ignore-junction-blocker")) < 0 ?
                                         std::numeric_limits<SUMOTime>::max() : string2time(oc.getString("ignore-junction-blocker"));
     // set the grid lock time
@@ -1074,6 +1211,16 @@ MSFrame::setMSGlobals(OptionsCont& oc) {
     }
     MSGlobals::gNumSimThreads = oc.getInt("threads");
     MSGlobals::gNumThreads = MAX2(MSGlobals::gNumSimThreads, oc.getInt("device.rerouting.threads"));
+    MSGlobals::gParallelLaneChange = oc.getBool("lanechange.parallel");
+    MSGlobals::gKinematicsMirror = oc.getBool("kinematics-mirror");
+    MSGlobals::gJunctionPhase = oc.getBool("junction-phase");
+    MSGlobals::gDevicePhase = oc.getBool("device-phase");
+    MSGlobals::gTLSPhase = oc.getBool("tls-phase");
+    MSGlobals::gPositionPhase = oc.getBool("position-phase");
+    MSGlobals::gCounterRNGs = oc.getBool("counter-rngs");
+    MSGlobals::gFreeFlowSkip = string2time(oc.getString("freeflow-skip"));
+    MSGlobals::gStopSkip = oc.getBool("stop-skip");
+    MSGlobals::gCompactRoutes = oc.getBool("compact-routes");
 
     MSGlobals::gEmergencyDecelWarningThreshold = oc.getFloat("emergencydecel.warning-threshold");
     MSGlobals::gMinorPenalty = oc.getFloat("weights.minor-penalty");
@@ -1086,6 +1233,13 @@ MSFrame::setMSGlobals(OptionsCont& oc) {
     MSGlobals::gUseStopEnded = oc.getBool("use-stop-ended");
     MSGlobals::gUseStopStarted = oc.getBool("use-stop-started");
 
+    MSGlobals::gBegin = string2time(oc.getString("begin"));
+    MSGlobals::gSeed = oc.getInt("seed");
+    MSGlobals::gIgnoreRouteErrors = oc.getBool("ignore-route-errors");
+    MSGlobals::gSaveExitTimes = oc.getBool("vehroute-output.exit-times");
+    MSGlobals::gPersonTripWalkFactor = oc.getFloat("persontrip.walkfactor");
+    MSGlobals::gPersonTripDefaultGroup = oc.getString("persontrip.default.group");
+
 #ifdef _DEBUG
     if (oc.isSet("movereminder-output")) {
         MSBaseVehicle::initMoveReminderOutput(oc);
@@ -79,6 +79,17 @@ bool MSGlobals::gClearState(false);
 int MSGlobals::gNumSimThreads;
 int MSGlobals::gNumThreads;
 
+bool MSGlobals::gParallelLaneChange;
+bool MSGlobals::gKinematicsMirror;
+bool MSGlobals::gJunctionPhase;
+bool MSGlobals::gDevicePhase;
+bool MSGlobals::gTLSPhase;
+bool MSGlobals::gPositionPhase;
+bool MSGlobals::gCounterRNGs;
+SUMOTime MSGlobals::gFreeFlowSkip;
+bool MSGlobals::gStopSkip;
+bool MSGlobals::gCompactRoutes;
+
 double MSGlobals::gEmergencyDecelWarningThreshold(1);
 
 double MSGlobals::gMinorPenalty(0);
@@ -99,4 +110,11 @@ SUMOTime MSGlobals::gStartupWaitThreshold(0);
 
 bool MSGlobals::gHaveEmissions(false);
 
+SUMOTime MSGlobals::gBegin(0);
+int MSGlobals::gSeed(0);
+bool MSGlobals::gIgnoreRouteErrors(false);
+bool MSGlobals::gSaveExitTimes(false);
+double MSGlobals::gPersonTripWalkFactor(0.75);
+std::string MSGlobals::gPersonTripDefaultGroup;
+
 /****************************************************************************/
@@ -24,6 +24,7 @@
 #include <config.h>
 
 #include <map>
+#include <string>
 #include <utils/common/SUMOTime.h>
 
 
@@ -145,6 +146,36 @@ public:
     /// how many threads to use
     static int gNumThreads;
 
+    /// whether lane changing is computed in thread-count independent groups of edges
+    static bool gParallelLaneChange;
+
+    /// whether lanes keep a compact copy of their vehicles' kinematic state during movement planning
+    static bool gKinematicsMirror;
+
+    /// whether right-of-way decisions are precomputed per link before executing movements
+    static bool gJunctionPhase;
+
+    /// whether parallel safe move reminders (devices) are notified after all movements were executed
+    static bool gDevicePhase;
+
+    /// whether the switches of parallel safe traffic light logics are evaluated before the begin of step events
+    static bool gTLSPhase;
+
+    /// whether the vehicle positions are computed for all vehicles before writing outputs
+    static bool gPositionPhase;
+
+    /// whether vehicles draw from counter based random number streams instead of the lane rngs
+    static bool gCounterRNGs;
+
+    /// the maximum time for which isolated vehicles in free flow may skip their action steps
+    static SUMOTime gFreeFlowSkip;
+
+    /// whether vehicles waiting at a stop may skip their action steps until the stop ends
+    static bool gStopSkip;
+
+    /// whether routes with identical edges share their edge list
+    static bool gCompactRoutes;
+
     /// threshold for warning about strong deceleration
     static double gEmergencyDecelWarningThreshold;
 
@@ -176,4 +207,20 @@ public:
 
     /// @brief Whether emission output of some type is needed (files or GUI)
     static bool gHaveEmissions;
+
+    /// @brief The begin time of the simulation (option begin)
+    static SUMOTime gBegin;
+
+    /// @brief The seed given by the options (used to derive the counter based random number streams)
+    static int gSeed;
+
+    /// @brief Whether route errors shall be ignored (option ignore-route-errors)
+    static bool gIgnoreRouteErrors;
+
+    /// @brief Whether the exit times of transportables shall be written (option vehroute-output.exit-times)
+    static bool gSaveExitTimes;
+
+    /// @brief The default walk factor and group of person trips (options persontrip.walkfactor and persontrip.default.group)
+    static double gPersonTripWalkFactor;
+    static std::string gPersonTripDefaultGroup;
 };
@@ -28,6 +28,7 @@
 #include <algorithm>
 #include <cassert>
 #include <iterator>
+#include <utils/common/PerformanceCounters.h>
 #include <utils/router/IntermodalRouter.h>
 #include <microsim/devices/MSDevice_Routing.h>
 #include <microsim/devices/MSRoutingEngine.h>
@@ -125,6 +126,7 @@ MSInsertionControl::updateScale(const std::string vtypeid) {
 
 int
 MSInsertionControl::emitVehicles(SUMOTime time) {
+    PerformanceCounters::Timer timer(PerformanceCounters::INSERTION);
     // check whether any vehicles shall be emitted within this time step
     const bool havePreChecked = MSRoutingEngine::isEnabled();
     if (myPendingEmits.empty() || (havePreChecked && myEmitCandidates.empty())) {
@@ -136,6 +138,7 @@ MSInsertionControl::emitVehicles(SUMOTime time) {
     //  will be used to append those vehicles that will not be able to depart in this
     //  time step
     MSVehicleContainer::VehicleVector refusedEmits;
+    refusedEmits.reserve(myPendingEmits.size());
 
     // go through the list of previously refused vehicles, first
     MSVehicleContainer::VehicleVector::const_iterator veh;
@@ -147,7 +150,7 @@ MSInsertionControl::emitVehicles(SUMOTime time) {
         }
     }
     myEmitCandidates.clear();
-    myPendingEmits = refusedEmits;
+    myPendingEmits.swap(refusedEmits);
     return numEmitted;
 }
 
@@ -362,7 +365,8 @@ MSInsertionControl::getPendingEmits(const MSLane* lane) {
         }
         myPendingEmitsUpdateTime = MSNet::getInstance()->getCurrentTimeStep();
     }
-    return myPendingEmitsForLane[lane];
+    const auto it = myPendingEmitsForLane.find(lane);
+    return it == myPendingEmitsForLane.end() ? 0 : it->second;
 }
 
 
@@ -25,6 +25,8 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include "MSNet.h"
 #include "MSVehicleContainer.h"
@@ -219,7 +221,7 @@ private:
     MSVehicleContainer::VehicleVector myPendingEmits;
 
     /// @brief Buffer for vehicles that may be inserted in the current step
-    std::set<SUMOVehicle*> myEmitCandidates;
+    std::unordered_set<SUMOVehicle*> myEmitCandidates;
 
     /// @brief Set of vehicles which shall not be inserted anymore
     std::set<const SUMOVehicle*> myAbortedEmits;
@@ -255,7 +257,7 @@ private:
     SUMOTime myPendingEmitsUpdateTime;
 
     /// @brief the number of pending emits for each edge in the current time step
-    std::map<const MSLane*, int> myPendingEmitsForLane;
+    std::unordered_map<const MSLane*, int> myPendingEmitsForLane;
 
     /// @brief The maximum random offset to be added to vehicles departure times (non-negative)
     SUMOTime myMaxRandomDepartOffset;
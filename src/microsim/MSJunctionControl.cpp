@@ -22,9 +22,17 @@
 #include <config.h>
 
 #include <algorithm>
+#include "MSEdge.h"
+#include "MSEdgeControl.h"
+#include "MSGlobals.h"
 #include "MSInternalJunction.h"
 #include "MSJunctionControl.h"
+#include "MSLane.h"
 #include "MSLink.h"
+#include "MSNet.h"
+
+// the number of junction phase chunks per thread (to balance junctions of different size)
+#define RESPONSE_CHUNKS_PER_THREAD 4
 
 
 // ===========================================================================
@@ -35,6 +43,11 @@ MSJunctionControl::MSJunctionControl() {
 
 
 MSJunctionControl::~MSJunctionControl() {
+#ifdef HAVE_FOX
+    for (ResponseTask* const task : myResponseTasks) {
+        delete task;
+    }
+#endif
 }
 
 
@@ -56,4 +69,80 @@ MSJunctionControl::postloadInitContainer() {
 }
 
 
+void
+MSJunctionControl::initResponseChunks() {
+    std::vector<MSLink*> links;
+    std::vector<int> junctionEnds;
+    for (const auto& i : *this) {
+        const MSJunction* const junction = i.second;
+        if (junction->getType() == SumoXMLNodeType::INTERNAL) {
+            // the links of internal junctions are the links of the internal lanes of their parent
+            continue;
+        }
+        for (const MSEdge* const edge : junction->getIncoming()) {
+            for (const MSLane* const lane : edge->getLanes()) {
+                for (MSLink* const link : lane->getLinkCont()) {
+                    links.push_back(link);
+                }
+            }
+        }
+        for (const MSLane* const lane : junction->getInternalLanes()) {
+            for (MSLink* const link : lane->getLinkCont()) {
+                links.push_back(link);
+            }
+        }
+        junctionEnds.push_back((int)links.size());
+    }
+    const int numChunks = MSGlobals::gNumSimThreads > 1 ? MSGlobals::gNumSimThreads * RESPONSE_CHUNKS_PER_THREAD : 1;
+    const int chunkSize = (int)links.size() / numChunks + 1;
+    myResponseChunks.push_back(std::vector<MSLink*>());
+    int begin = 0;
+    for (const int end : junctionEnds) {
+        if ((int)myResponseChunks.back().size() >= chunkSize) {
+            myResponseChunks.push_back(std::vector<MSLink*>());
+        }
+        myResponseChunks.back().insert(myResponseChunks.back().end(), links.begin() + begin, links.begin() + end);
+        begin = end;
+    }
+#ifdef HAVE_FOX
+    for (const std::vector<MSLink*>& chunk : myResponseChunks) {
+        myResponseTasks.push_back(new ResponseTask(chunk));
+    }
+#endif
+}
+
+
+void
+MSJunctionControl::computeLinkResponses() {
+    if (myResponseChunks.empty()) {
+        initResponseChunks();
+    }
+#ifdef HAVE_FOX
+#ifndef THREAD_POOL
+    if (MSGlobals::gNumSimThreads > 1) {
+        MFXWorkerThread::Pool& pool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+        for (ResponseTask* const task : myResponseTasks) {
+            pool.add(task);
+        }
+        pool.waitAll(false);
+        return;
+    }
+#endif
+#endif
+    for (const std::vector<MSLink*>& chunk : myResponseChunks) {
+        computeLinkResponses(chunk);
+    }
+}
+
+
+void
+MSJunctionControl::computeLinkResponses(const std::vector<MSLink*>& links) {
+    for (MSLink* const link : links) {
+        if (link->getApproaching().size() > 0) {
+            link->computeApproachResponses();
+        }
+    }
+}
+
+
 /****************************************************************************/
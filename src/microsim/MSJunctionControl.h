@@ -29,9 +29,19 @@
 
 #include <utils/common/NamedObjectCont.h>
 #include <utils/common/UtilExceptions.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#include <microsim/output/MSStepProfiler.h>
+#endif
 #include "MSJunction.h"
 
 
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class MSLink;
+
+
 // ===========================================================================
 // class definitions
 // ===========================================================================
@@ -58,6 +68,48 @@ public:
     void postloadInitContainer();
 
 
+    /** @brief Computes the right-of-way decisions for all registered approaches (junction phase)
+     *
+     * The links are processed in chunks of whole junctions which are distributed
+     *  on the thread pool of the edge control when using multiple threads.
+     * @see MSLink::computeApproachResponses
+     */
+    void computeLinkResponses();
+
+
+private:
+    /// @brief computes the responses for the given links
+    static void computeLinkResponses(const std::vector<MSLink*>& links);
+
+    /// @brief groups the links of all junctions into chunks for the junction phase
+    void initResponseChunks();
+
+#ifdef HAVE_FOX
+    /**
+     * @class ResponseTask
+     * @brief the task computing the responses of one chunk of links
+     */
+    class ResponseTask : public MFXWorkerThread::Task {
+    public:
+        ResponseTask(const std::vector<MSLink*>& links) : myLinks(links) {}
+        void run(MFXWorkerThread* /*context*/) {
+            MSStepProfiler::Scope span("responseTask");
+            MSJunctionControl::computeLinkResponses(myLinks);
+        }
+    private:
+        const std::vector<MSLink*>& myLinks;
+    private:
+        /// @brief Invalidated assignment operator.
+        ResponseTask& operator=(const ResponseTask&) = delete;
+    };
+
+    /// @brief the tasks for the chunks (reused in every step)
+    std::vector<ResponseTask*> myResponseTasks;
+#endif
+
+    /// @brief the links of the junctions, grouped into chunks for the junction phase
+    std::vector<std::vector<MSLink*> > myResponseChunks;
+
 private:
     /// @brief Invalidated copy constructor.
     MSJunctionControl(const MSJunctionControl&);
@@ -36,6 +36,7 @@
 #include <iterator>
 #include <exception>
 #include <climits>
+#include <limits>
 #include <set>
 #include <utils/common/UtilExceptions.h>
 #include <utils/common/StdDefs.h>
@@ -100,6 +101,7 @@
 // static member definitions
 // ===========================================================================
 MSLane::DictType MSLane::myDict;
+thread_local MSLane::FollowerSearchScratch MSLane::myFollowerSearchScratch;
 MSLane::CollisionAction MSLane::myCollisionAction(MSLane::COLLISION_ACTION_TELEPORT);
 MSLane::CollisionAction MSLane::myIntermodalCollisionAction(MSLane::COLLISION_ACTION_WARN);
 bool MSLane::myCheckJunctionCollisions(false);
@@ -108,6 +110,7 @@ SUMOTime MSLane::myCollisionStopTime(0);
 SUMOTime MSLane::myIntermodalCollisionStopTime(0);
 double MSLane::myCollisionMinGapFactor(1.0);
 bool MSLane::myExtrapolateSubstepDepart(false);
+const int MSLane::FREE_GAP_BLOCK(32);
 std::vector<SumoRNG> MSLane::myRNGs;
 
 
@@ -247,7 +250,7 @@ MSLane::MSLane(const std::string& id, double maxSpeed, double friction, double l
                int index, bool isRampAccel,
                const std::string& type) :
     Named(id),
-    myNumericalID(numericalID), myShape(shape), myIndex(index),
+    myNumericalID(numericalID), myShape(shape), myShapeIndex(myShape), myIndex(index),
     myVehicles(), myLength(length), myWidth(width),
     myEdge(edge), myMaxSpeed(maxSpeed),
     myFrictionCoefficient(friction),
@@ -266,6 +269,7 @@ MSLane::MSLane(const std::string& id, double maxSpeed, double friction, double l
     myFollowerInfo(width, nullptr, 0.),
     myLeaderInfoTime(SUMOTime_MIN),
     myFollowerInfoTime(SUMOTime_MIN),
+    myFreeGapsTime(SUMOTime_MIN),
     myLengthGeometryFactor(MAX2(POSITION_EPS, myShape.length()) / myLength), // factor should not be 0
     myIsRampAccel(isRampAccel),
     myLaneType(type),
@@ -363,6 +367,7 @@ MSLane::setPartialOccupation(MSVehicle* v) {
 #endif
     //assert(std::find(myPartialVehicles.begin(), myPartialVehicles.end(), v) == myPartialVehicles.end());
     myPartialVehicles.push_back(v);
+    myFreeGapsTime = SUMOTime_MIN;
     return myLength;
 }
 
@@ -380,6 +385,7 @@ MSLane::resetPartialOccupation(MSVehicle* v) {
     for (VehCont::iterator i = myPartialVehicles.begin(); i != myPartialVehicles.end(); ++i) {
         if (v == *i) {
             myPartialVehicles.erase(i);
+            myFreeGapsTime = SUMOTime_MIN;
             // XXX update occupancy here?
             //std::cout << "    removed from myPartialVehicles\n";
             return;
@@ -424,6 +430,7 @@ MSLane::incorporateVehicle(MSVehicle* veh, double pos, double speed, double posL
     myNeedsCollisionCheck = true;
     assert(pos <= myLength);
     bool wasInactive = myVehicles.size() == 0;
+    myFreeGapsTime = SUMOTime_MIN;
     veh->enterLaneAtInsertion(this, pos, speed, posLat, notification);
     if (at == myVehicles.end()) {
         // vehicle will be the first on the lane
@@ -521,8 +528,20 @@ MSLane::freeInsertion(MSVehicle& veh, double mspeed, double posLat,
         }
     }
     // go through the lane, look for free positions (starting after the last vehicle)
+    // gaps which are too short even without any secure gap are skipped (unless the secure gap may be negative)
+    const bool useFreeGaps = veh.getCarFollowModel().getModelID() != SUMO_TAG_CF_ACC;
+    if (useFreeGaps) {
+        updateFreeGaps();
+    }
+    const double minFreeGap = veh.getVehicleType().getLength() + veh.getVehicleType().getMinGap() + POSITION_EPS - NUMERICAL_EPS;
     MSLane::VehCont::iterator predIt = myVehicles.begin();
     while (predIt != myVehicles.end()) {
+        if (useFreeGaps) {
+            predIt = myVehicles.begin() + nextFreeGap((int)(predIt - myVehicles.begin()), minFreeGap);
+            if (predIt == myVehicles.end()) {
+                break;
+            }
+        }
         // get leader (may be zero) and follower
         // @todo compute secure position in regard to sublane-model
         const MSVehicle* leader = predIt != myVehicles.end() - 1 ? *(predIt + 1) : nullptr;
@@ -565,6 +584,54 @@ MSLane::freeInsertion(MSVehicle& veh, double mspeed, double posLat,
 }
 
 
+void
+MSLane::updateFreeGaps() {
+    const SUMOTime now = MSNet::getInstance()->getCurrentTimeStep();
+    if (myFreeGapsTime == now) {
+        return;
+    }
+    myFreeGapsTime = now;
+    myFreeGaps.clear();
+    myFreeGapBlocks.clear();
+    for (int i = 0; i < (int)myVehicles.size(); i++) {
+        // the same leader as in freeInsertion
+        const MSVehicle* leader = i < (int)myVehicles.size() - 1 ? myVehicles[i + 1] : nullptr;
+        if (leader == nullptr && myPartialVehicles.size() > 0) {
+            leader = myPartialVehicles.front();
+        }
+        const MSVehicle* const follower = myVehicles[i];
+        if (leader == nullptr || follower->getCarFollowModel().getModelID() == SUMO_TAG_CF_ACC) {
+            // the gap to the lane end does not include the minGap of the inserted vehicle, the secure gap of ACC may be negative
+            myFreeGaps.push_back(std::numeric_limits<double>::max());
+        } else {
+            myFreeGaps.push_back(leader->getBackPositionOnLane(this) - (follower->getPositionOnLane() + follower->getVehicleType().getMinGap()));
+        }
+        if (i % FREE_GAP_BLOCK == 0) {
+            myFreeGapBlocks.push_back(myFreeGaps.back());
+        } else {
+            myFreeGapBlocks.back() = MAX2(myFreeGapBlocks.back(), myFreeGaps.back());
+        }
+    }
+}
+
+
+int
+MSLane::nextFreeGap(int index, double minGap) const {
+    const int numGaps = (int)myFreeGaps.size();
+    while (index < numGaps) {
+        if (index % FREE_GAP_BLOCK == 0 && myFreeGapBlocks[index / FREE_GAP_BLOCK] <= minGap) {
+            index += FREE_GAP_BLOCK;
+            continue;
+        }
+        if (myFreeGaps[index] > minGap) {
+            return index;
+        }
+        index++;
+    }
+    return (int)myVehicles.size();
+}
+
+
 double
 MSLane::getDepartSpeed(const MSVehicle& veh, bool& patchSpeed) {
     double speed = 0;
@@ -1598,11 +1665,29 @@ MSLane::detectCollisions(SUMOTime timestep, const std::string& stage) {
         const std::vector<const MSLane*>& foeLanes = myLinks.front()->getFoeLanes();
         // save the iterator, it might get modified, see #8842
         MSLane::AnyVehicleIterator end = anyVehiclesEnd();
+        // broad phase: the bounding boxes of the foe vehicles are computed once and sorted by their minimum x
+        // so that only foes with overlapping box boundaries are checked (in their original order)
+        std::vector<std::vector<JunctionFoe> > foes(foeLanes.size());
+        if (anyVehiclesBegin() != end) {
+            for (int i = 0; i < (int)foeLanes.size(); i++) {
+                MSLane::AnyVehicleIterator foeEnd = foeLanes[i]->anyVehiclesEnd();
+                int index = 0;
+                for (MSLane::AnyVehicleIterator it_veh = foeLanes[i]->anyVehiclesBegin(); it_veh != foeEnd; ++it_veh) {
+                    foes[i].push_back(JunctionFoe(*it_veh, index++));
+                }
+                std::sort(foes[i].begin(), foes[i].end(), [](const JunctionFoe & a, const JunctionFoe & b) {
+                    return a.boundary.xmin() < b.boundary.xmin();
+                });
+            }
+        }
+        std::vector<const JunctionFoe*> candidates;
         for (AnyVehicleIterator veh = anyVehiclesBegin(); veh != end; ++veh) {
             const MSVehicle* const collider = *veh;
             //std::cout << "   collider " << collider->getID() << "\n";
             PositionVector colliderBoundary = collider->getBoundingBox(myCheckJunctionCollisionMinGap);
-            for (const MSLane* const foeLane : foeLanes) {
+            const Boundary colliderBox = colliderBoundary.getBoxBoundary();
+            for (int i = 0; i < (int)foeLanes.size(); i++) {
+                const MSLane* const foeLane = foeLanes[i];
 #ifdef DEBUG_JUNCTION_COLLISIONS
                 if (DEBUG_COND) {
                     std::cout << "     foeLane " << foeLane->getID()
@@ -1610,9 +1695,22 @@ MSLane::detectCollisions(SUMOTime timestep, const std::string& stage) {
                               << " foePart=" << toString(foeLane->myPartialVehicles) << "\n";
                 }
 #endif
-                MSLane::AnyVehicleIterator foeEnd = foeLane->anyVehiclesEnd();
-                for (MSLane::AnyVehicleIterator it_veh = foeLane->anyVehiclesBegin(); it_veh != foeEnd; ++it_veh) {
-                    const MSVehicle* const victim = *it_veh;
+                candidates.clear();
+                for (const JunctionFoe& foe : foes[i]) {
+                    if (foe.boundary.xmin() > colliderBox.xmax() + NUMERICAL_EPS) {
+                        break;
+                    }
+                    if (foe.boundary.xmax() + NUMERICAL_EPS >= colliderBox.xmin()
+                            && foe.boundary.ymin() <= colliderBox.ymax() + NUMERICAL_EPS
+                            && foe.boundary.ymax() + NUMERICAL_EPS >= colliderBox.ymin()) {
+                        candidates.push_back(&foe);
+                    }
+                }
+                std::sort(candidates.begin(), candidates.end(), [](const JunctionFoe * a, const JunctionFoe * b) {
+                    return a->index < b->index;
+                });
+                for (const JunctionFoe* const foe : candidates) {
+                    const MSVehicle* const victim = foe->veh;
                     if (victim == collider) {
                         // may happen if the vehicles lane and shadow lane are siblings
                         continue;
@@ -1628,7 +1726,7 @@ MSLane::detectCollisions(SUMOTime timestep, const std::string& stage) {
                                   << "\n";
                     }
 #endif
-                    if (colliderBoundary.overlapsWith(victim->getBoundingBox())) {
+                    if (colliderBoundary.overlapsWith(foe->box)) {
                         // make a detailed check
                         PositionVector boundingPoly = collider->getBoundingPoly();
                         if (collider->getBoundingPoly(myCheckJunctionCollisionMinGap).overlapsWith(victim->getBoundingPoly())) {
@@ -1794,6 +1892,14 @@ MSLane::detectCollisions(SUMOTime timestep, const std::string& stage) {
 }
 
 
+MSLane::JunctionFoe::JunctionFoe(const MSVehicle* foe, const int foeIndex) :
+    veh(foe),
+    box(foe->getBoundingBox()),
+    boundary(box.getBoxBoundary()),
+    index(foeIndex) {
+}
+
+
 void
 MSLane::detectPedestrianJunctionCollision(const MSVehicle* collider, const PositionVector& colliderBoundary, const MSLane* foeLane,
         SUMOTime timestep, const std::string& stage,
@@ -2305,6 +2411,30 @@ MSLane::updateLengthSum() {
 }
 
 
+void
+MSLane::updateKinematicsMirror() {
+    const int numVehs = (int)myVehicles.size();
+    myKinematics.vehicles.resize(numVehs);
+    myKinematics.pos.resize(numVehs);
+    myKinematics.backPos.resize(numVehs);
+    myKinematics.speed.resize(numVehs);
+    myKinematics.length.resize(numVehs);
+    myKinematics.minGap.resize(numVehs);
+    myKinematics.accel.resize(numVehs);
+    for (int i = 0; i < numVehs; i++) {
+        MSVehicle* const veh = myVehicles[i];
+        myKinematics.vehicles[i] = veh;
+        myKinematics.pos[i] = veh->getPositionOnLane();
+        myKinematics.backPos[i] = veh->getBackPositionOnLane(this);
+        myKinematics.speed[i] = veh->getSpeed();
+        myKinematics.length[i] = veh->getVehicleType().getLength();
+        myKinematics.minGap[i] = veh->getVehicleType().getMinGap();
+        myKinematics.accel[i] = veh->getAcceleration();
+    }
+    myKinematics.valid = true;
+}
+
+
 void
 MSLane::changeLanes(const SUMOTime t) {
     myEdge->changeLanes(t);
@@ -2673,6 +2803,7 @@ MSLane::removeVehicle(MSVehicle* remVehicle, MSMoveReminder::Notification notifi
                 remVehicle->leaveLane(notification);
             }
             myVehicles.erase(it);
+            myFreeGapsTime = SUMOTime_MIN;
             myBruttoVehicleLengthSum -= remVehicle->getVehicleType().getLengthWithGap();
             myNettoVehicleLengthSum -= remVehicle->getVehicleType().getLength();
             break;
@@ -2776,6 +2907,14 @@ MSLane::getLeader(const MSVehicle* veh, const double vehPos, const std::vector<M
                 return std::pair<MSVehicle* const, double>(pred, pred->getBackPositionOnLane(this) - veh->getVehicleType().getMinGap() - vehPos);
             }
         }
+    } else if (myKinematics.valid && myPartialVehicles.empty() && myTmpVehicles.empty() && MSGlobals::gLaneChangeDuration <= 0) {
+        // scan the compact mirror instead of the vehicle objects
+        const int numVehs = (int)myKinematics.pos.size();
+        for (int i = 0; i < numVehs; i++) {
+            if (myKinematics.pos[i] >= vehPos && myKinematics.vehicles[i] != veh) {
+                return std::pair<MSVehicle* const, double>(myKinematics.vehicles[i], myKinematics.backPos[i] - veh->getVehicleType().getMinGap() - vehPos);
+            }
+        }
     } else {
         for (AnyVehicleIterator last = anyVehiclesBegin(); last != anyVehiclesEnd(); ++last) {
             // XXX refactor leaderInfo to use a const vehicle all the way through the call hierarchy
@@ -3698,23 +3837,43 @@ MSLane::getFollowersOnConsecutive(const MSVehicle* ego, double backOffset,
             }
 #endif
         }
-        std::set<const MSEdge*> egoFurther;
+        // reuse the containers of this thread unless they are in use further up the call stack
+        FollowerSearchScratch localScratch;
+        FollowerSearchScratch& scratch = myFollowerSearchScratch.inUse ? localScratch : myFollowerSearchScratch;
+        scratch.inUse = true;
+        std::vector<const MSEdge*>& egoFurther = scratch.egoFurther;
+        egoFurther.clear();
         for (MSLane* further : ego->getFurtherLanes()) {
-            egoFurther.insert(&further->getEdge());
+            egoFurther.push_back(&further->getEdge());
         }
         if (ego->getPositionOnLane() < ego->getVehicleType().getLength() && egoFurther.size() == 0
                 && ego->getLane()->getLogicalPredecessorLane() != nullptr) {
             // on insertion
-            egoFurther.insert(&ego->getLane()->getLogicalPredecessorLane()->getEdge());
+            egoFurther.push_back(&ego->getLane()->getLogicalPredecessorLane()->getEdge());
         }
 
         // avoid loops
-        std::set<const MSLane*> visited(myEdge->getLanes().begin(), myEdge->getLanes().end());
+        if ((int)scratch.visitMarks.size() < dictSize()) {
+            scratch.visitMarks.resize(dictSize(), 0);
+        }
+        if (++scratch.epoch == std::numeric_limits<int>::max()) {
+            std::fill(scratch.visitMarks.begin(), scratch.visitMarks.end(), 0);
+            scratch.epoch = 1;
+        }
+        std::vector<int>& visited = scratch.visitMarks;
+        const int epoch = scratch.epoch;
+        for (const MSLane* const lane : myEdge->getLanes()) {
+            visited[lane->getNumericalID()] = epoch;
+        }
         if (myEdge->getBidiEdge() != nullptr) {
-            visited.insert(myEdge->getBidiEdge()->getLanes().begin(), myEdge->getBidiEdge()->getLanes().end());
+            for (const MSLane* const lane : myEdge->getBidiEdge()->getLanes()) {
+                visited[lane->getNumericalID()] = epoch;
+            }
         }
-        std::vector<MSLane::IncomingLaneInfo> newFound;
-        std::vector<MSLane::IncomingLaneInfo> toExamine = myIncomingLanes;
+        std::vector<MSLane::IncomingLaneInfo>& newFound = scratch.newFound;
+        std::vector<MSLane::IncomingLaneInfo>& toExamine = scratch.toExamine;
+        newFound.clear();
+        toExamine.assign(myIncomingLanes.begin(), myIncomingLanes.end());
         while (toExamine.size() != 0) {
             for (std::vector<MSLane::IncomingLaneInfo>::iterator it = toExamine.begin(); it != toExamine.end(); ++it) {
                 MSLane* next = (*it).lane;
@@ -3728,7 +3887,7 @@ MSLane::getFollowersOnConsecutive(const MSVehicle* ego, double backOffset,
                 }
 #endif
                 if (backOffset + (*it).length - next->getLength() < 0
-                        && egoFurther.count(&next->getEdge()) != 0
+                        && std::find(egoFurther.begin(), egoFurther.end(), &next->getEdge()) != egoFurther.end()
                    )  {
                     // check for junction foes that would interfere with lane changing
                     // @note: we are passing the back of ego as its front position so
@@ -3823,10 +3982,10 @@ MSLane::getFollowersOnConsecutive(const MSVehicle* ego, double backOffset,
                 if ((*it).length < searchDist) {
                     const std::vector<MSLane::IncomingLaneInfo>& followers = next->getIncomingLanes();
                     for (std::vector<MSLane::IncomingLaneInfo>::const_iterator j = followers.begin(); j != followers.end(); ++j) {
-                        if (visited.find((*j).lane) == visited.end() && (((*j).viaLink->havePriority() && !(*j).viaLink->isTurnaround())
+                        if (visited[(*j).lane->getNumericalID()] != epoch && (((*j).viaLink->havePriority() && !(*j).viaLink->isTurnaround())
                                 || mLinkMode == MinorLinkMode::FOLLOW_ALWAYS
                                 || (mLinkMode == MinorLinkMode::FOLLOW_ONCOMING && (*j).viaLink->getDirection() == LinkDirection::STRAIGHT))) {
-                            visited.insert((*j).lane);
+                            visited[(*j).lane->getNumericalID()] = epoch;
                             MSLane::IncomingLaneInfo ili;
                             ili.lane = (*j).lane;
                             ili.length = (*j).length + (*it).length;
@@ -3839,6 +3998,7 @@ MSLane::getFollowersOnConsecutive(const MSVehicle* ego, double backOffset,
             toExamine.clear();
             swap(newFound, toExamine);
         }
+        scratch.inUse = false;
         //return result;
 
     }
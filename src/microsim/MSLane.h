@@ -39,6 +39,7 @@
 #include <utils/common/NamedRTree.h>
 #include <utils/emissions/PollutantsInterface.h>
 #include <utils/geom/PositionVector.h>
+#include <utils/geom/PositionVectorIndex.h>
 #include "MSGlobals.h"
 #include "MSLeaderInfo.h"
 #include "MSMoveReminder.h"
@@ -49,6 +50,7 @@
 #include <utils/foxtools/MFXWorkerThread.h>
 #endif
 #include <utils/common/StopWatch.h>
+#include <microsim/output/MSStepProfiler.h>
 
 
 // ===========================================================================
@@ -251,6 +253,11 @@ public:
         return (int)myRNGs.size();
     }
 
+    /// @brief return the RNG with the given index
+    static SumoRNG* getRNGByIndex(int index) {
+        return &myRNGs[index];
+    }
+
     /// @brief save random number generator states to the given output device
     static void saveRNGStates(OutputDevice& out);
 
@@ -525,6 +532,11 @@ public:
         return myShape;
     }
 
+    /// @brief Returns the precomputed lookup structure for fast queries on the shape
+    inline const PositionVectorIndex& getShapeIndex() const {
+        return myShapeIndex;
+    }
+
     /// @brief return shape.length() / myLength
     inline double getLengthGeometryFactor() const {
         return myLengthGeometryFactor;
@@ -549,7 +561,7 @@ public:
     /* @brief fit the given lane position to a visibly suitable geometry position
      * and return the coordinates */
     inline const Position geometryPositionAtOffset(double offset, double lateralOffset = 0) const {
-        return myShape.positionAtOffset(interpolateLanePosToGeometryPos(offset), lateralOffset);
+        return myShapeIndex.positionAtOffset(interpolateLanePosToGeometryPos(offset), lateralOffset);
     }
 
     /* @brief fit the given geometry position to a valid lane position
@@ -685,6 +697,14 @@ public:
 
     /// @brief updated current vehicle length sum (delayed to avoid lane-order-dependency)
     void updateLengthSum();
+
+    /// @brief copy the kinematic state of myVehicles into the compact kinematics mirror
+    void updateKinematicsMirror();
+
+    /// @brief mark the kinematics mirror as outdated (lookups fall back to the vehicle objects)
+    inline void invalidateKinematicsMirror() {
+        myKinematics.valid = false;
+    }
     ///@}
 
 
@@ -1362,6 +1382,22 @@ protected:
                                     const MSLane::VehCont::iterator& at,
                                     MSMoveReminder::Notification notification = MSMoveReminder::NOTIFICATION_DEPARTED);
 
+    /// @brief recomputes myFreeGaps if the vehicles on the lane changed
+    void updateFreeGaps();
+
+    /// @brief the index of the first vehicle at or after the given one which has more than minGap free space in front (myVehicles.size() if there is none)
+    int nextFreeGap(int index, double minGap) const;
+
+    /// @brief a vehicle on a foe lane with its bounding box for the junction collision check
+    struct JunctionFoe {
+        JunctionFoe(const MSVehicle* foe, const int foeIndex);
+        const MSVehicle* veh;
+        PositionVector box;
+        Boundary boundary;
+        /// @brief the position of the vehicle on its lane (to keep the order of the checks)
+        int index;
+    };
+
     /// @brief detect whether a vehicle collids with pedestrians on the junction
     void detectPedestrianJunctionCollision(const MSVehicle* collider, const PositionVector& colliderBoundary, const MSLane* foeLane,
                                            SUMOTime timestep, const std::string& stage,
@@ -1416,6 +1452,9 @@ protected:
     /// The shape of the lane
     PositionVector myShape;
 
+    /// @brief cumulative lengths and segment bounds of myShape
+    PositionVectorIndex myShapeIndex;
+
     /// The lane index
     int myIndex;
 
@@ -1460,6 +1499,27 @@ protected:
      *   of this container and the leaving ones leave from the back. */
     VehCont myManeuverReservations;
 
+    /** @struct KinematicsMirror
+     * @brief Structure-of-arrays copy of the kinematic state of myVehicles (same order)
+     *
+     * The mirror is only valid during the movement planning phase when neither
+     *  positions nor the vehicle containers change. It allows leader lookups
+     *  to scan contiguous memory instead of the large vehicle objects.
+     */
+    struct KinematicsMirror {
+        std::vector<MSVehicle*> vehicles;
+        std::vector<double> pos;
+        std::vector<double> backPos;
+        std::vector<double> speed;
+        std::vector<double> length;
+        std::vector<double> minGap;
+        std::vector<double> accel;
+        bool valid = false;
+    };
+
+    /// @brief the kinematics mirror of myVehicles (only used with option --kinematics-mirror)
+    KinematicsMirror myKinematics;
+
     /* @brief list of vehicles that are parking near this lane
      * (not necessarily on the road but having reached their stop on this lane)
      * */
@@ -1544,6 +1604,15 @@ protected:
     /// @brief time step for which myFollowerInfo was last updated
     mutable SUMOTime myFollowerInfoTime;
 
+    /// @brief the space behind each vehicle up to its leader minus the follower's minGap (cached for free insertion)
+    std::vector<double> myFreeGaps;
+    /// @brief the largest free gap for each block of FREE_GAP_BLOCK vehicles
+    std::vector<double> myFreeGapBlocks;
+    /// @brief time step for which myFreeGaps was last updated (SUMOTime_MIN if the vehicles changed since)
+    SUMOTime myFreeGapsTime;
+    /// @brief the number of gaps per block
+    static const int FREE_GAP_BLOCK;
+
     /// @brief precomputed myShape.length / myLength
     const double myLengthGeometryFactor;
 
@@ -1581,6 +1650,21 @@ protected:
 
     static std::vector<SumoRNG> myRNGs;
 
+    /// @brief reusable containers for the upstream search in getFollowersOnConsecutive
+    struct FollowerSearchScratch {
+        /// @brief the lanes visited by the current search are marked with the current epoch
+        std::vector<int> visitMarks;
+        int epoch = 0;
+        std::vector<IncomingLaneInfo> toExamine;
+        std::vector<IncomingLaneInfo> newFound;
+        std::vector<const MSEdge*> egoFurther;
+        /// @brief whether a search of this thread currently uses the containers
+        bool inUse = false;
+    };
+
+    /// @brief the search containers of the current thread
+    static thread_local FollowerSearchScratch myFollowerSearchScratch;
+
 private:
     /// @brief This lane's move reminder
     std::vector< MSMoveReminder* > myMoveReminders;
@@ -1724,6 +1808,7 @@ private:
             myTime = time;
         }
         void run(MFXWorkerThread* /*context*/) {
+            MSStepProfiler::Scope span("laneTask");
             try {
                 (myLane.*(myOperation))(myTime);
             } catch (ProcessError& e) {
@@ -336,10 +336,12 @@ MSLaneChanger::change() {
     }
 
     const std::vector<MSVehicle::LaneQ>& preb = vehicle->getBestLanes();
+    // the follower on the current lane is the same for both directions
+    const std::pair<MSVehicle* const, double> follower = getRealFollower(myCandi);
     // check whether the vehicle wants and is able to change to right lane
     int stateRight = 0;
     if (mayChange(-1)) {
-        stateRight = checkChangeWithinEdge(-1, leader, preb);
+        stateRight = checkChangeWithinEdge(-1, leader, follower, preb);
         // change if the vehicle wants to and is allowed to change
         if ((stateRight & LCA_RIGHT) != 0 && (stateRight & LCA_BLOCKED) == 0) {
             vehicle->getLaneChangeModel().setOwnState(stateRight);
@@ -356,7 +358,7 @@ MSLaneChanger::change() {
     // check whether the vehicle wants and is able to change to left lane
     int stateLeft = 0;
     if (mayChange(1)) {
-        stateLeft = checkChangeWithinEdge(1, leader, preb);
+        stateLeft = checkChangeWithinEdge(1, leader, follower, preb);
         // change if the vehicle wants to and is allowed to change
         if ((stateLeft & LCA_LEFT) != 0 && (stateLeft & LCA_BLOCKED) == 0) {
             vehicle->getLaneChangeModel().setOwnState(stateLeft);
@@ -726,9 +728,9 @@ int
 MSLaneChanger::checkChangeWithinEdge(
     int laneOffset,
     const std::pair<MSVehicle* const, double>& leader,
+    const std::pair<MSVehicle* const, double>& follower,
     const std::vector<MSVehicle::LaneQ>& preb) const {
 
-    std::pair<MSVehicle*, double> follower = getRealFollower(myCandi);
     std::pair<MSVehicle* const, double> neighLead = getRealLeader(myCandi + laneOffset);
     std::pair<MSVehicle*, double> neighFollow = getRealFollower(myCandi + laneOffset);
     if (neighLead.first != nullptr && neighLead.first == neighFollow.first) {
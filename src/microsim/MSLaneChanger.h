@@ -191,6 +191,7 @@ protected:
     int checkChangeWithinEdge(
         int laneOffset,
         const std::pair<MSVehicle* const, double>& leader,
+        const std::pair<MSVehicle* const, double>& follower,
         const std::vector<MSVehicle::LaneQ>& preb) const;
 
     /* @brief check whether lane changing in the given direction is desirable
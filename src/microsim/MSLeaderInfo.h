@@ -21,6 +21,7 @@
 #pragma once
 #include <config.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <utils/common/StdDefs.h>
@@ -42,6 +43,77 @@ typedef std::pair<MSVehicle*, double> LeaderDist;
 // ===========================================================================
 // class definitions
 // ===========================================================================
+/**
+ * @class MSSublaneValues
+ * @brief A fixed size container with one value per sublane
+ *
+ * Lanes with up to INLINE_SIZE sublanes store their values inline so that
+ *  constructing and copying the (frequently created) leader infos does not
+ *  allocate memory.
+ */
+template<class T>
+class MSSublaneValues {
+public:
+    MSSublaneValues(const size_t size, const T& value) :
+        mySize(0),
+        myInline() {
+        assign(size, value);
+    }
+
+    /// @brief resizes the container and sets all values
+    void assign(const size_t size, const T& value) {
+        mySize = size;
+        if (size > INLINE_SIZE) {
+            myHeap.assign(size, value);
+        } else {
+            myHeap.clear();
+            std::fill(myInline, myInline + size, value);
+        }
+    }
+
+    size_t size() const {
+        return mySize;
+    }
+
+    T& operator[](const size_t i) {
+        return data()[i];
+    }
+
+    const T& operator[](const size_t i) const {
+        return data()[i];
+    }
+
+    const T* begin() const {
+        return data();
+    }
+
+    const T* end() const {
+        return data() + mySize;
+    }
+
+private:
+    T* data() {
+        return mySize > INLINE_SIZE ? myHeap.data() : myInline;
+    }
+
+    const T* data() const {
+        return mySize > INLINE_SIZE ? myHeap.data() : myInline;
+    }
+
+    /// @brief the maximum number of values stored inline (a 3.2m lane with a lateral resolution of 0.2m)
+    static const size_t INLINE_SIZE = 16;
+
+    /// @brief the number of values
+    size_t mySize;
+
+    /// @brief the storage for small sizes
+    T myInline[INLINE_SIZE];
+
+    /// @brief the storage for large sizes
+    std::vector<T> myHeap;
+};
+
+
 /**
  * @class MSLeaderInfo
  */
@@ -95,7 +167,7 @@ public:
         return myHasVehicles;
     }
 
-    const std::vector<const MSVehicle*>& getVehicles() const {
+    const MSSublaneValues<const MSVehicle*>& getVehicles() const {
         return myVehicles;
     }
 
@@ -124,7 +196,7 @@ protected:
     /// @brief an extra offset for shifting the interpretation of sublane borders (default [0,myWidth])
     int myOffset;
 
-    std::vector<const MSVehicle*> myVehicles;
+    MSSublaneValues<const MSVehicle*> myVehicles;
 
     /// @brief the number of free sublanes
     // if an ego vehicle is given in the constructor, the number of free
@@ -181,7 +253,7 @@ public:
     /// @brief print a debugging representation
     virtual std::string toString() const;
 
-    const std::vector<double>& getDistances() const {
+    const MSSublaneValues<double>& getDistances() const {
         return myDistances;
     }
 
@@ -198,7 +270,7 @@ public:
 
 protected:
 
-    std::vector<double> myDistances;
+    MSSublaneValues<double> myDistances;
 
 };
 
@@ -248,7 +320,7 @@ public:
 protected:
 
     // @brief the differences between requriedGap and actual gap for each of the followers
-    std::vector<double> myMissingGaps;
+    MSSublaneValues<double> myMissingGaps;
 
     // @brief whether this Info objects tracks leaders instead of followers
     bool myHaveOppositeLeaders;
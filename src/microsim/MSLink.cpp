@@ -63,7 +63,6 @@
 #define INVALID_TIME -1000
 
 // the default safety gap when passing before oncoming pedestrians
-#define JM_CROSSING_GAP_DEFAULT 10
 
 // minimim width between sibling lanes to qualify as non-overlapping
 #define DIVERGENCE_MIN_WIDTH 2.5
@@ -680,6 +679,8 @@ MSLink::setApproaching(const SUMOVehicle* approaching, ApproachingVehicleInforma
         }
     }
 #endif
+    // a response computed for another link does not apply here
+    ai.response = -1;
     myApproachingVehicles.emplace(approaching, ai);
 }
 
@@ -875,6 +876,40 @@ MSLink::opened(SUMOTime arrivalTime, double arrivalSpeed, double leaveSpeed, dou
 }
 
 
+void
+MSLink::computeApproachResponses() {
+    for (ApproachInfos::value_type& item : myApproachingVehicles.items()) {
+        const SUMOVehicle* const veh = item.first;
+        ApproachingVehicleInformation& avi = item.second;
+        avi.response = -1;
+        if (!avi.willPass || myState == LINKSTATE_ZIPPER
+                || veh->getVehicleType().getModelParams().jmIgnoreFoeProb > 0) {
+            continue;
+        }
+        avi.responseImpatience = veh->getImpatience();
+        avi.response = opened(avi.arrivalTime, avi.arrivalSpeed, avi.leaveSpeed, veh->getVehicleType().getLength(),
+                              avi.responseImpatience, veh->getVehicleType().getCarFollowModel().getMaxDecel(),
+                              avi.waitingTime, avi.latOffset, nullptr, false, veh) ? 1 : 0;
+    }
+}
+
+
+int
+MSLink::getApproachResponse(const SUMOVehicle* veh, SUMOTime arrivalTime, double arrivalSpeed, double leaveSpeed,
+                            double impatience, SUMOTime waitingTime, double posLat) const {
+    auto i = myApproachingVehicles.find(veh);
+    if (i == myApproachingVehicles.end()) {
+        return -1;
+    }
+    const ApproachingVehicleInformation& avi = i->second;
+    if (avi.arrivalTime != arrivalTime || avi.arrivalSpeed != arrivalSpeed || avi.leaveSpeed != leaveSpeed
+            || avi.responseImpatience != impatience || avi.waitingTime != waitingTime || avi.latOffset != posLat) {
+        return -1;
+    }
+    return avi.response;
+}
+
+
 bool
 MSLink::blockedAtTime(SUMOTime arrivalTime, SUMOTime leaveTime, double arrivalSpeed, double leaveSpeed,
                       bool sameTargetLane, double impatience, double decel, SUMOTime waitingTime,
@@ -883,12 +918,12 @@ MSLink::blockedAtTime(SUMOTime arrivalTime, SUMOTime leaveTime, double arrivalSp
 #ifdef MSLink_DEBUG_OPENED
         if (gDebugFlag1) {
             if (ego != nullptr
-                    && ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_FOE_SPEED, 0) >= it.second.speed
-                    && ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_FOE_PROB, 0) > 0) {
+                    && ego->getVehicleType().getModelParams().jmIgnoreFoeSpeed >= it.second.speed
+                    && ego->getVehicleType().getModelParams().jmIgnoreFoeProb > 0) {
                 std::stringstream stream; // to reduce output interleaving from different threads
                 stream << SIMTIME << " " << myApproachingVehicles.size() << "   foe link=" << getViaLaneOrLane()->getID()
                        << " foeVeh=" << it.first->getID() << " (below ignore speed)"
-                       << " ignoreFoeProb=" << ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_FOE_PROB, 0)
+                       << " ignoreFoeProb=" << ego->getVehicleType().getModelParams().jmIgnoreFoeProb
                        << "\n";
                 std::cout << stream.str();
             }
@@ -896,9 +931,9 @@ MSLink::blockedAtTime(SUMOTime arrivalTime, SUMOTime leaveTime, double arrivalSp
 #endif
         if (it.first != ego
                 && (ego == nullptr
-                    || ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_FOE_PROB, 0) == 0
-                    || ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_FOE_SPEED, 0) < it.second.speed
-                    || ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_FOE_PROB, 0) < RandHelper::rand(ego->getRNG()))
+                    || ego->getVehicleType().getModelParams().jmIgnoreFoeProb == 0
+                    || ego->getVehicleType().getModelParams().jmIgnoreFoeSpeed < it.second.speed
+                    || ego->getVehicleType().getModelParams().jmIgnoreFoeProb < RandHelper::rand(ego->getRNG()))
                 && !ignoreFoe(ego, it.first)
                 && (!lastWasContRed || it.first->getSpeed() > SUMO_const_haltingSpeed)
                 && blockedByFoe(it.first, it.second, arrivalTime, leaveTime, arrivalSpeed, leaveSpeed, sameTargetLane,
@@ -968,7 +1003,9 @@ MSLink::blockedByFoe(const SUMOVehicle* veh, const ApproachingVehicleInformation
                                 ? myLookaheadTimeZipper
                                 : (ego == nullptr
                                    ? myLookaheadTime
-                                   : TIME2STEPS(ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_TIMEGAP_MINOR, STEPS2TIME(myLookaheadTime)))));
+                                   : (ego->getVehicleType().getModelParams().jmTimegapMinor == INVALID_DOUBLE
+                                      ? myLookaheadTime
+                                      : TIME2STEPS(ego->getVehicleType().getModelParams().jmTimegapMinor))));
     //if (ego != 0) std::cout << SIMTIME << " ego=" << ego->getID() << " jmTimegapMinor=" << ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_TIMEGAP_MINOR, -1) << " lookAhead=" << lookAhead << "\n";
 #ifdef MSLink_DEBUG_OPENED
     if (gDebugFlag1 || gDebugFlag6) {
@@ -1678,7 +1715,7 @@ MSLink::getLeaderInfo(const MSVehicle* ego, double dist, std::vector<const MSPer
                                           + ego->getLateralPositionOnLane() * (wayIn ? -1 : 1));
             // can access the movement model here since we already checked for existing persons above
             if (distToPeds >= -MSPModel::SAFETY_GAP && MSNet::getInstance()->getPersonControl().getMovementModel()->blockedAtDist(ego, foeLane, vehSideOffset, vehWidth,
-                    ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_CROSSING_GAP, JM_CROSSING_GAP_DEFAULT),
+                    ego->getVehicleType().getModelParams().jmCrossingGap,
                     collectBlockers)) {
                 result.emplace_back(nullptr, -1, distToPeds);
             }
@@ -22,6 +22,7 @@
 #pragma once
 #include <config.h>
 
+#include <algorithm>
 #include <vector>
 #include <set>
 #include <utils/common/SUMOTime.h>
@@ -136,33 +137,102 @@ public:
             waitingTime(_waitingTime),
             dist(_dist),
             speed(_speed),
-            latOffset(_latOffset) {
+            latOffset(_latOffset),
+            response(-1),
+            responseImpatience(0) {
         }
 
         /// @brief The time the vehicle's front arrives at the link
-        const SUMOTime arrivalTime;
+        SUMOTime arrivalTime;
         /// @brief The estimated time at which the vehicle leaves the link
-        const SUMOTime leavingTime;
+        SUMOTime leavingTime;
         /// @brief The estimated speed with which the vehicle arrives at the link (for headway computation)
-        const double arrivalSpeed;
+        double arrivalSpeed;
         /// @brief The estimated speed with which the vehicle leaves the link (for headway computation)
-        const double leaveSpeed;
+        double leaveSpeed;
         /// @brief Whether the vehicle wants to pass the link (@todo: check semantics)
-        const bool willPass;
+        bool willPass;
         /// @brief The estimated speed with which the vehicle arrives at the link if it starts braking(for headway computation)
-        const double arrivalSpeedBraking;
+        double arrivalSpeedBraking;
         /// @brief The waiting duration at the current link
-        const SUMOTime waitingTime;
+        SUMOTime waitingTime;
         /// @brief The distance up to the current link
-        const double dist;
+        double dist;
         /// @brief The current speed
-        const double speed;
+        double speed;
         /// @brief The lateral offset from the center of the entering lane
-        const double latOffset;
+        double latOffset;
+        /// @brief The result of opened() as computed in the junction phase (-1 if not available)
+        int response;
+        /// @brief The impatience used for computing the response
+        double responseImpatience;
+
+    };
+
+    /** @class ApproachInfos
+     * @brief The approaching vehicles, sorted by their numerical id
+     *
+     * The entries live in a flat vector which keeps its capacity, so the
+     *  frequent insertions and removals do not allocate once the link has
+     *  seen its usual number of approaching vehicles.
+     */
+    class ApproachInfos {
+    public:
+        typedef std::pair<const SUMOVehicle*, ApproachingVehicleInformation> value_type;
+        typedef std::vector<value_type>::const_iterator const_iterator;
+
+        const_iterator begin() const {
+            return myItems.begin();
+        }
+
+        const_iterator end() const {
+            return myItems.end();
+        }
+
+        int size() const {
+            return (int)myItems.size();
+        }
+
+        const_iterator find(const SUMOVehicle* veh) const {
+            const_iterator it = lowerBound(veh);
+            return it != myItems.end() && it->first == veh ? it : myItems.end();
+        }
+
+        /// @brief adds the vehicle unless it is already registered (like std::map::emplace)
+        void emplace(const SUMOVehicle* veh, const ApproachingVehicleInformation& avi) {
+            const_iterator it = lowerBound(veh);
+            if (it == myItems.end() || it->first != veh) {
+                myItems.insert(it, value_type(veh, avi));
+            }
+        }
+
+        void erase(const SUMOVehicle* veh) {
+            const_iterator it = find(veh);
+            if (it != myItems.end()) {
+                myItems.erase(it);
+            }
+        }
+
+        void clear() {
+            myItems.clear();
+        }
+
+        /// @brief modifiable access for storing the junction phase responses
+        std::vector<value_type>& items() {
+            return myItems;
+        }
 
+    private:
+        const_iterator lowerBound(const SUMOVehicle* veh) const {
+            const SUMOTrafficObject::NumericalID id = veh->getNumericalID();
+            return std::lower_bound(myItems.begin(), myItems.end(), id, [](const value_type & item, const SUMOTrafficObject::NumericalID numericalID) {
+                return item.first->getNumericalID() < numericalID;
+            });
+        }
+
+        std::vector<value_type> myItems;
     };
 
-    typedef std::map<const SUMOVehicle*, const ApproachingVehicleInformation, ComparatorNumericalIdLess> ApproachInfos;
     typedef std::vector<const SUMOVehicle*> BlockingFoes;
 
     enum ConflictFlag {
@@ -304,6 +374,21 @@ public:
                 bool ignoreRed = false,
                 const SUMOTrafficObject* ego = nullptr) const;
 
+    /** @brief Evaluates opened() for all vehicles which request to pass this link (junction phase)
+     *
+     * Vehicles whose decision depends on their random number generator are skipped.
+     * @note Only the response fields of this link's approach information are modified,
+     *  so links may be processed in parallel
+     */
+    void computeApproachResponses();
+
+    /** @brief Returns the response computed by computeApproachResponses
+     *
+     * @return 1 if the link is opened, 0 if not and -1 if there is no response for the given parameters
+     */
+    int getApproachResponse(const SUMOVehicle* veh, SUMOTime arrivalTime, double arrivalSpeed, double leaveSpeed,
+                            double impatience, SUMOTime waitingTime, double posLat) const;
+
     /** @brief Returns the information whether this link is blocked
      * Valid after the vehicles have set their requests
      * @param[in] arrivalTime The arrivalTime of the vehicle who checks for an approaching foe
@@ -169,6 +169,16 @@ public:
         return true;
     }
 
+    /** @brief Returns whether notifyMove only modifies the state of this reminder
+     *
+     * Such reminders are notified in the device phase after all movements are
+     *  executed (in parallel for different vehicles) if MSGlobals::gDevicePhase is set.
+     *  The default is false.
+     */
+    virtual bool isParallelSafe() const {
+        return false;
+    }
+
     /** @brief Computes idling emission values and adds them to the emission sums
     *
     * Idling implied by zero velocity, acceleration and slope
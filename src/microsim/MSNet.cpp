@@ -38,8 +38,12 @@
 #include <cassert>
 #include <vector>
 #include <ctime>
+#include <mutex>
+#include <thread>
+#include <chrono>
 
 #ifdef HAVE_FOX
+#include <utils/common/PerformanceCounters.h>
 #include <utils/common/ScopedLocker.h>
 #endif
 #include <utils/common/MsgHandler.h>
@@ -84,6 +88,9 @@
 #include <microsim/output/MSVTKExport.h>
 #include <microsim/output/MSXMLRawOut.h>
 #include <microsim/output/MSAmitranTrajectories.h>
+#include <microsim/output/MSHardwareCounters.h>
+#include <microsim/output/MSTripStatistics.h>
+#include <microsim/output/MSStepProfiler.h>
 #include <microsim/output/MSStopOut.h>
 #include <microsim/transportables/MSPModel.h>
 #include <microsim/transportables/MSPerson.h>
@@ -115,6 +122,7 @@
 #include "MSRoute.h"
 #include "MSGlobals.h"
 #include "MSEdgeWeightsStorage.h"
+#include "MSStateCheckpoints.h"
 #include "MSStateHandler.h"
 #include "MSFrame.h"
 #include "MSParkingArea.h"
@@ -215,6 +223,7 @@ MSNet::MSNet(MSVehicleControl* vc, MSEventControl* beginOfTimestepEvents,
     myHasPedestrianNetwork(false),
     myHasBidiEdges(false),
     myEdgeDataEndTime(-1),
+    myDeferVehicleStateEvents(false),
     myDynamicShapeUpdater(nullptr) {
     if (myInstance != nullptr) {
         throw ProcessError(TL("A network was already constructed."));
@@ -225,6 +234,8 @@ MSNet::MSNet(MSVehicleControl* vc, MSEventControl* beginOfTimestepEvents,
     myLogExecutionTime = !oc.getBool("no-duration-log");
     myLogStepNumber = !oc.getBool("no-step-log");
     myLogStepPeriod = oc.getInt("step-log.period");
+    myRealTimeFactor = oc.getFloat("real-time");
+    myRealTimeShedLag = myRealTimeFactor > 0 ? (long)string2time(oc.getString("real-time.shed-lag")) : -1;
     myInserter = new MSInsertionControl(*vc, string2time(oc.getString("max-depart-delay")), oc.getBool("eager-insert"), oc.getInt("max-num-vehicles"),
                                         string2time(oc.getString("random-depart-offset")));
     myVehicleControl = vc;
@@ -284,6 +295,9 @@ MSNet::closeBuilding(const OptionsCont& oc, MSEdgeControl* edges, MSJunctionCont
             && MSGlobals::gWeightsSeparateTurns > 0) {
         throw ProcessError(TL("Option weights.separate-turns is only supported when simulating with internal lanes"));
     }
+    if (oc.isSet("partition-output")) {
+        writePartitions(oc.getInt("partition-output.parts"));
+    }
 }
 
 
@@ -328,8 +342,9 @@ MSNet::~MSNet() {
         delete router.second;
     }
     myPedestrianRouter.clear();
-    for (auto& router : myIntermodalRouter) {
-        delete router.second;
+    // delete the clones before the routers owning the networks
+    for (auto router = myIntermodalRouter.rbegin(); router != myIntermodalRouter.rend(); ++router) {
+        delete router->second;
     }
     myIntermodalRouter.clear();
     myLanesRTree.second.RemoveAll();
@@ -400,6 +415,7 @@ MSNet::simulate(SUMOTime start, SUMOTime stop) {
     myStep = start;
     int numSteps = 0;
     bool doStepLog = false;
+    myRealTimeBeginMillis = SysUtils::getCurrentMillis();
     while (state == SIMSTATE_RUNNING) {
         doStepLog = myLogStepNumber && (numSteps % myLogStepPeriod == 0);
         if (doStepLog) {
@@ -409,6 +425,9 @@ MSNet::simulate(SUMOTime start, SUMOTime stop) {
         if (doStepLog) {
             postSimStepOutput();
         }
+        if (myRealTimeFactor > 0) {
+            synchronizeRealTime(start);
+        }
         state = adaptToState(simulationState(stop));
 #ifdef DEBUG_SIMSTEP
         std::cout << SIMTIME << " MSNet::simulate(" << start << ", " << stop << ")"
@@ -432,6 +451,28 @@ MSNet::simulate(SUMOTime start, SUMOTime stop) {
 }
 
 
+void
+MSNet::synchronizeRealTime(const SUMOTime start) {
+    const long due = myRealTimeBeginMillis + (long)(STEPS2TIME(myStep - start) * 1000. / myRealTimeFactor);
+    const long now = SysUtils::getCurrentMillis();
+    if (now < due) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(due - now));
+        myRealTimeLag = 0;
+        return;
+    }
+    const bool wasBehind = isBehindRealTime();
+    myRealTimeLag = now - due;
+    if (myRealTimeLag > 0) {
+        myRealTimeLateSteps++;
+        myRealTimeMaxLag = MAX2(myRealTimeMaxLag, myRealTimeLag);
+    }
+    if (!wasBehind && isBehindRealTime()) {
+        WRITE_WARNINGF(TL("Simulation lags % behind the wall clock at time %, skipping optional work."),
+                       elapsedMs2string(myRealTimeLag), time2string(myStep));
+    }
+}
+
+
 void
 MSNet::loadRoutes() {
     myRouteLoaders->loadNext(myStep);
@@ -450,6 +491,9 @@ MSNet::generateStatistics(const SUMOTime start, const long now) {
                 msg << " TraCI-Duration: " << elapsedMs2string(myTraCIMillis) << "\n";
             }
             msg << " Real time factor: " << (STEPS2TIME(myStep - start) * 1000. / (double)duration) << "\n";
+            if (myRealTimeFactor > 0) {
+                msg << " Real time lag: " << elapsedMs2string(myRealTimeMaxLag) << " max, " << myRealTimeLateSteps << " late steps\n";
+            }
             msg.setf(std::ios::fixed, std::ios::floatfield);     // use decimal format
             msg.setf(std::ios::showpoint);    // print decimal point
             msg << " UPS: " << ((double)myVehiclesMoved / ((double)duration / 1000)) << "\n";
@@ -457,6 +501,10 @@ MSNet::generateStatistics(const SUMOTime start, const long now) {
                 msg << " UPS-Persons: " << ((double)myPersonsMoved / ((double)duration / 1000)) << "\n";
             }
         }
+        const long long peakMemory = SysUtils::getPeakMemoryUsage();
+        if (peakMemory > 0) {
+            msg << " Peak memory: " << (peakMemory >> 20) << " MB\n";
+        }
         // print vehicle statistics
         const std::string discardNotice = ((myVehicleControl->getLoadedVehicleNo() != myVehicleControl->getDepartedVehicleNo()) ?
                                            " (Loaded: " + toString(myVehicleControl->getLoadedVehicleNo()) + ")" : "");
@@ -527,6 +575,7 @@ MSNet::generateStatistics(const SUMOTime start, const long now) {
     }
     if (OptionsCont::getOptions().getBool("duration-log.statistics")) {
         msg << MSDevice_Tripinfo::printStatistics();
+        msg << PerformanceCounters::printStatistics();
     }
     return msg.str();
 }
@@ -717,6 +766,7 @@ MSNet::simulationStep(const bool onlyMove) {
               << ", myStep = " << myStep
               << std::endl;
 #endif
+    MSStepProfiler::Scope phase("traci");
     TraCIServer* t = TraCIServer::getInstance();
     int lastTraCICmd = 0;
     if (t != nullptr) {
@@ -742,6 +792,7 @@ MSNet::simulationStep(const bool onlyMove) {
     if (myLogExecutionTime) {
         mySimStepDuration = SysUtils::getCurrentMillis();
     }
+    phase.next("saveState");
     // simulation state output
     std::vector<SUMOTime>::iterator timeIt = std::find(myStateDumpTimes.begin(), myStateDumpTimes.end(), myStep);
     if (timeIt != myStateDumpTimes.end()) {
@@ -760,20 +811,31 @@ MSNet::simulationStep(const bool onlyMove) {
             myPeriodicStateFiles.erase(myPeriodicStateFiles.begin());
         }
     }
+    if (MSGlobals::gTLSPhase) {
+        phase.next("tlsSwitches");
+        myLogics->prepareSwitches(myStep);
+    }
+    phase.next("beginOfStepEvents");
+#ifdef HAVE_FOX
+    MSRoutingEngine::beginBatch();
+#endif
     myBeginOfTimestepEvents->execute(myStep);
     if (MSRailSignalControl::hasInstance()) {
         MSRailSignalControl::getInstance().recheckGreen();
     }
 #ifdef HAVE_FOX
+    phase.next("rerouting");
     MSRoutingEngine::waitForAll();
 #endif
     if (MSGlobals::gCheck4Accidents && !MSGlobals::gUseMesoSim) {
         myEdges->detectCollisions(myStep, STAGE_EVENTS);
     }
     // check whether the tls programs need to be switched
+    phase.next("tls");
     myLogics->check2Switch(myStep);
 
     if (MSGlobals::gUseMesoSim) {
+        phase.next("mesoSimulate");
         MSGlobals::gMesoNet->simulate(myStep);
     } else {
         // assure all lanes with vehicles are 'active'
@@ -781,18 +843,28 @@ MSNet::simulationStep(const bool onlyMove) {
 
         // compute safe velocities for all vehicles for the next few lanes
         // also register ApproachingVehicleInformation for all links
+        phase.next("planMovements");
         myEdges->planMovements(myStep);
 
         // register junction approaches based on planned velocities as basis for right-of-way decision
+        phase.next("setJunctionApproaches");
         myEdges->setJunctionApproaches(myStep);
 
+        // decide right-of-way for all registered approaches at once
+        if (MSGlobals::gJunctionPhase) {
+            phase.next("linkResponses");
+            myJunctions->computeLinkResponses();
+        }
+
         // decide right-of-way and execute movements
+        phase.next("executeMovements");
         myEdges->executeMovements(myStep);
         if (MSGlobals::gCheck4Accidents) {
             myEdges->detectCollisions(myStep, STAGE_MOVEMENTS);
         }
 
         // vehicles may change lanes
+        phase.next("changeLanes");
         myEdges->changeLanes(myStep);
 
         if (MSGlobals::gCheck4Accidents) {
@@ -800,10 +872,12 @@ MSNet::simulationStep(const bool onlyMove) {
         }
     }
     // flush arrived meso vehicles and micro vehicles that were removed due to collision
+    phase.next("loadRoutes");
     myVehicleControl->removePending();
     loadRoutes();
 
     // persons
+    phase.next("insertion");
     if (myPersonControl != nullptr && myPersonControl->hasTransportables()) {
         myPersonControl->checkWaiting(this, myStep);
     }
@@ -812,6 +886,9 @@ MSNet::simulationStep(const bool onlyMove) {
         myContainerControl->checkWaiting(this, myStep);
     }
     // insert vehicles
+#ifdef HAVE_FOX
+    MSRoutingEngine::beginBatch();
+#endif
     myInserter->determineCandidates(myStep);
     myInsertionEvents->execute(myStep);
 #ifdef HAVE_FOX
@@ -825,24 +902,29 @@ MSNet::simulationStep(const bool onlyMove) {
     MSVehicleTransfer::getInstance()->checkInsertions(myStep);
 
     // execute endOfTimestepEvents
+    phase.next("endOfStepEvents");
     myEndOfTimestepEvents->execute(myStep);
 
     if (myLogExecutionTime) {
         myTraCIStepDuration -= SysUtils::getCurrentMillis();
     }
     if (onlyMove) {
+        phase.finish();
         myStepCompletionMissing = true;
         return;
     }
     if (t != nullptr && lastTraCICmd == libsumo::CMD_EXECUTEMOVE) {
+        phase.next("traci");
         t->processCommands(myStep, true);
     }
+    phase.finish();
     postMoveStep();
 }
 
 
 void
 MSNet::postMoveStep() {
+    MSStepProfiler::Scope phase("output");
     const int numControlled = libsumo::Helper::postProcessRemoteControl();
     if (numControlled > 0 && MSGlobals::gCheck4Accidents) {
         myEdges->detectCollisions(myStep, STAGE_REMOTECONTROL);
@@ -856,9 +938,21 @@ MSNet::postMoveStep() {
         // warnings. we must remove them now to ensure correct output.
         removeOutdatedCollisions();
     }
+    if (MSGlobals::gPositionPhase && !MSGlobals::gUseMesoSim) {
+        phase.next("positions");
+        myEdges->computePositions();
+        phase.next("output");
+    }
     // update and write (if needed) detector values
     mySimStepDuration = SysUtils::getCurrentMillis() - mySimStepDuration;
     writeOutput();
+    phase.finish();
+    if (MSStepProfiler::active()) {
+        MSStepProfiler::getInstance()->writeStep(myStep);
+    }
+    if (MSHardwareCounters::active()) {
+        MSHardwareCounters::getInstance()->endStep(myStep);
+    }
 
     if (myLogExecutionTime) {
         myVehiclesMoved += myVehicleControl->getRunningVehicleNo();
@@ -954,6 +1048,7 @@ MSNet::clearAll() {
     MSRoute::clear();
     delete MSVehicleTransfer::getInstance();
     MSDevice::cleanupAll();
+    MSStateCheckpoints::clear();
     MSCalibrator::cleanup();
     while (!MSLaneSpeedTrigger::getInstances().empty()) {
         delete MSLaneSpeedTrigger::getInstances().begin()->second;
@@ -965,6 +1060,10 @@ MSNet::clearAll() {
     MSDevice_SSM::cleanup();
     MSDevice_ToC::cleanup();
     MSStopOut::cleanup();
+    MSStepProfiler::cleanup();
+    MSHardwareCounters::cleanup();
+    MSTripStatistics::cleanup();
+    MSFCDExport::cleanup();
     MSRailSignalConstraint::cleanup();
     MSRailSignalControl::cleanup();
     TraCIServer* t = TraCIServer::getInstance();
@@ -1146,9 +1245,7 @@ MSNet::writeOutput() {
     }
 
     // write SSM output
-    for (MSDevice_SSM* dev : MSDevice_SSM::getInstances()) {
-        dev->updateAndWriteOutput();
-    }
+    MSDevice_SSM::updateAndWriteOutputAll();
 
     // write ToC output
     for (MSDevice_ToC* dev : MSDevice_ToC::getInstances()) {
@@ -1254,8 +1351,43 @@ MSNet::removeVehicleStateListener(VehicleStateListener* listener) {
 }
 
 
+namespace {
+/// @brief a vehicle state change recorded during a parallel phase
+struct VehicleStateEvent {
+    const SUMOVehicle* vehicle;
+    MSNet::VehicleState to;
+    std::string info;
+};
+
+/// @brief the events recorded by one thread, registered for the flush
+struct VehicleStateEventBuffer;
+std::mutex myEventBufferMutex;
+std::vector<VehicleStateEventBuffer*> myEventBuffers;
+
+struct VehicleStateEventBuffer {
+    VehicleStateEventBuffer() {
+        std::lock_guard<std::mutex> lock(myEventBufferMutex);
+        myEventBuffers.push_back(this);
+    }
+    ~VehicleStateEventBuffer() {
+        std::lock_guard<std::mutex> lock(myEventBufferMutex);
+        myEventBuffers.erase(std::find(myEventBuffers.begin(), myEventBuffers.end(), this));
+    }
+    std::vector<VehicleStateEvent> events;
+};
+
+thread_local VehicleStateEventBuffer myThreadEventBuffer;
+}
+
+
 void
 MSNet::informVehicleStateListener(const SUMOVehicle* const vehicle, VehicleState to, const std::string& info) {
+    if (myDeferVehicleStateEvents) {
+        if (!myVehicleStateListeners.empty()) {
+            myThreadEventBuffer.events.push_back(VehicleStateEvent({vehicle, to, info}));
+        }
+        return;
+    }
 #ifdef HAVE_FOX
     ScopedLocker<> lock(myVehicleStateListenerMutex, MSGlobals::gNumThreads > 1);
 #endif
@@ -1265,6 +1397,33 @@ MSNet::informVehicleStateListener(const SUMOVehicle* const vehicle, VehicleState
 }
 
 
+void
+MSNet::deferVehicleStateEvents() {
+    myDeferVehicleStateEvents = true;
+}
+
+
+void
+MSNet::flushVehicleStateEvents() {
+    myDeferVehicleStateEvents = false;
+    std::vector<VehicleStateEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(myEventBufferMutex);
+        for (VehicleStateEventBuffer* const buffer : myEventBuffers) {
+            std::move(buffer->events.begin(), buffer->events.end(), std::back_inserter(events));
+            buffer->events.clear();
+        }
+    }
+    // all events of a vehicle come from the same thread, so the stable sort keeps their order
+    std::stable_sort(events.begin(), events.end(), [](const VehicleStateEvent & a, const VehicleStateEvent & b) {
+        return a.vehicle->getNumericalID() < b.vehicle->getNumericalID();
+    });
+    for (const VehicleStateEvent& e : events) {
+        informVehicleStateListener(e.vehicle, e.to, e.info);
+    }
+}
+
+
 void
 MSNet::addTransportableStateListener(TransportableStateListener* listener) {
     if (find(myTransportableStateListeners.begin(), myTransportableStateListeners.end(), listener) == myTransportableStateListeners.end()) {
@@ -1369,6 +1528,12 @@ MSNet::getStoppingPlace(const std::string& id, const SumoXMLTag category) const
 }
 
 
+void
+MSNet::parallelFor(const int begin, const int end, const int grain, const std::function<void(int, int)>& fn) {
+    myEdges->parallelFor(begin, end, grain, fn);
+}
+
+
 std::string
 MSNet::getStoppingPlaceID(const MSLane* lane, const double pos, const SumoXMLTag category) const {
     if (myStoppingPlaces.count(category) > 0) {
@@ -1417,6 +1582,90 @@ MSNet::writeRailSignalBlocks() const {
 }
 
 
+void
+MSNet::writePartitions(const int numParts) const {
+    std::vector<const MSEdge*> edges;
+    for (const MSEdge* const edge : myEdges->getEdges()) {
+        if (edge->isNormal()) {
+            edges.push_back(edge);
+        }
+    }
+    std::vector<int> partOf(myEdges->getEdges().size(), -1);
+    bisectEdges(edges, 0, numParts, partOf);
+    std::vector<std::vector<const MSEdge*> > parts(numParts);
+    std::vector<std::vector<const MSEdge*> > boundaries(numParts);
+    std::vector<double> weights(numParts, 0.);
+    for (const MSEdge* const edge : myEdges->getEdges()) {
+        const int part = partOf[edge->getNumericalID()];
+        if (part < 0) {
+            continue;
+        }
+        parts[part].push_back(edge);
+        weights[part] += edge->getLength() * (double)edge->getNumLanes();
+        for (const MSEdge* const succ : edge->getSuccessors()) {
+            const int succPart = partOf[succ->getNumericalID()];
+            if (succPart >= 0 && succPart != part) {
+                // vehicles leaving this edge may need to be handed over
+                boundaries[part].push_back(edge);
+                break;
+            }
+        }
+    }
+    OutputDevice& output = OutputDevice::getDeviceByOption("partition-output");
+    for (int i = 0; i < numParts; i++) {
+        output.openTag("partition");
+        output.writeAttr(SUMO_ATTR_ID, i);
+        output.writeAttr(SUMO_ATTR_WEIGHT, weights[i]);
+        output.writeAttr(SUMO_ATTR_EDGES, parts[i]);
+        output.writeAttr("boundary", boundaries[i]);
+        output.closeTag();
+    }
+}
+
+
+void
+MSNet::bisectEdges(std::vector<const MSEdge*>& edges, const int firstPart, const int numParts, std::vector<int>& partOf) {
+    if (numParts <= 1 || edges.size() <= 1) {
+        for (const MSEdge* const edge : edges) {
+            partOf[edge->getNumericalID()] = firstPart;
+        }
+        return;
+    }
+    // split along the longer side of the bounding box of the edge centers
+    Boundary b;
+    for (const MSEdge* const edge : edges) {
+        b.add(edge->getLanes()[0]->getShape().positionAtOffset2D(edge->getLanes()[0]->getShape().length2D() / 2));
+    }
+    const bool splitX = b.getWidth() >= b.getHeight();
+    std::vector<std::pair<double, const MSEdge*> > sorted;
+    double totalWeight = 0.;
+    for (const MSEdge* const edge : edges) {
+        const Position center = edge->getLanes()[0]->getShape().positionAtOffset2D(edge->getLanes()[0]->getShape().length2D() / 2);
+        sorted.push_back(std::make_pair(splitX ? center.x() : center.y(), edge));
+        totalWeight += edge->getLength() * (double)edge->getNumLanes();
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const std::pair<double, const MSEdge*>& a, const std::pair<double, const MSEdge*>& b) {
+        return a.first < b.first || (a.first == b.first && a.second->getNumericalID() < b.second->getNumericalID());
+    });
+    // the first half gets a share of the weight proportional to its number of partitions
+    const int firstParts = numParts / 2;
+    const double target = totalWeight * firstParts / numParts;
+    std::vector<const MSEdge*> first;
+    std::vector<const MSEdge*> second;
+    double weight = 0.;
+    for (const auto& item : sorted) {
+        if (weight < target || first.empty()) {
+            first.push_back(item.second);
+            weight += item.second->getLength() * (double)item.second->getNumLanes();
+        } else {
+            second.push_back(item.second);
+        }
+    }
+    bisectEdges(first, firstPart, firstParts, partOf);
+    bisectEdges(second, firstPart + firstParts, numParts - firstParts, partOf);
+}
+
+
 void
 MSNet::writeOverheadWireSegmentOutput() const {
     if (myStoppingPlaces.count(SUMO_TAG_OVERHEAD_WIRE_SEGMENT) > 0) {
@@ -1466,7 +1715,7 @@ SUMOAbstractRouter<MSEdge, SUMOVehicle>&
 MSNet::getRouterTT(const int rngIndex, const MSEdgeVector& prohibited) const {
     if (myRouterTT.count(rngIndex) == 0) {
         const std::string routingAlgorithm = OptionsCont::getOptions().getString("routing-algorithm");
-        if (routingAlgorithm == "dijkstra") {
+        if (routingAlgorithm == "dijkstra" || routingAlgorithm == "raptor") {
             myRouterTT[rngIndex] = new DijkstraRouter<MSEdge, SUMOVehicle>(MSEdge::getAllEdges(), true, &MSNet::getTravelTime, nullptr, false, nullptr, true);
         } else {
             if (routingAlgorithm != "astar") {
@@ -1505,47 +1754,62 @@ MSNet::getIntermodalRouter(const int rngIndex, const int routingMode, const MSEd
     const OptionsCont& oc = OptionsCont::getOptions();
     const int key = rngIndex * oc.getInt("thread-rngs") + routingMode;
     if (myIntermodalRouter.count(key) == 0) {
-        int carWalk = 0;
-        for (const std::string& opt : oc.getStringVector("persontrip.transfer.car-walk")) {
-            if (opt == "parkingAreas") {
-                carWalk |= MSIntermodalRouter::Network::PARKING_AREAS;
-            } else if (opt == "ptStops") {
-                carWalk |= MSIntermodalRouter::Network::PT_STOPS;
-            } else if (opt == "allJunctions") {
-                carWalk |= MSIntermodalRouter::Network::ALL_JUNCTIONS;
+        if (rngIndex == 0 || routingMode == libsumo::ROUTING_MODE_COMBINED) {
+            // the fare module of the combined mode keeps state during the search and cannot be shared
+            myIntermodalRouter[key] = createIntermodalRouter(routingMode);
+        } else {
+            // the routers for the other rngs share the intermodal network of the first one
+            if (myIntermodalRouter.count(routingMode) == 0) {
+                myIntermodalRouter[routingMode] = createIntermodalRouter(routingMode);
             }
+            myIntermodalRouter[key] = static_cast<MSIntermodalRouter*>(myIntermodalRouter[routingMode]->clone());
         }
-        // XXX there is currently no reason to combine multiple values, thus getValueString rather than getStringVector
-        const std::string& taxiDropoff = oc.getValueString("persontrip.transfer.taxi-walk");
-        const std::string& taxiPickup = oc.getValueString("persontrip.transfer.walk-taxi");
-        if (taxiDropoff == "") {
-            if (MSDevice_Taxi::getTaxi() != nullptr) {
-                carWalk |= MSIntermodalRouter::Network::TAXI_DROPOFF_ANYWHERE;
-            }
-        } else if (taxiDropoff == "ptStops") {
-            carWalk |= MSIntermodalRouter::Network::TAXI_DROPOFF_PT;
-        } else if (taxiDropoff == "allJunctions") {
+    }
+    myIntermodalRouter[key]->prohibit(prohibited);
+    return *myIntermodalRouter[key];
+}
+
+
+MSNet::MSIntermodalRouter*
+MSNet::createIntermodalRouter(const int routingMode) const {
+    const OptionsCont& oc = OptionsCont::getOptions();
+    int carWalk = 0;
+    for (const std::string& opt : oc.getStringVector("persontrip.transfer.car-walk")) {
+        if (opt == "parkingAreas") {
+            carWalk |= MSIntermodalRouter::Network::PARKING_AREAS;
+        } else if (opt == "ptStops") {
+            carWalk |= MSIntermodalRouter::Network::PT_STOPS;
+        } else if (opt == "allJunctions") {
+            carWalk |= MSIntermodalRouter::Network::ALL_JUNCTIONS;
+        }
+    }
+    // XXX there is currently no reason to combine multiple values, thus getValueString rather than getStringVector
+    const std::string& taxiDropoff = oc.getValueString("persontrip.transfer.taxi-walk");
+    const std::string& taxiPickup = oc.getValueString("persontrip.transfer.walk-taxi");
+    if (taxiDropoff == "") {
+        if (MSDevice_Taxi::getTaxi() != nullptr) {
             carWalk |= MSIntermodalRouter::Network::TAXI_DROPOFF_ANYWHERE;
         }
-        if (taxiPickup == "") {
-            if (MSDevice_Taxi::getTaxi() != nullptr) {
-                carWalk |= MSIntermodalRouter::Network::TAXI_PICKUP_ANYWHERE;
-            }
-        } else if (taxiPickup == "ptStops") {
-            carWalk |= MSIntermodalRouter::Network::TAXI_PICKUP_PT;
-        } else if (taxiPickup == "allJunctions") {
+    } else if (taxiDropoff == "ptStops") {
+        carWalk |= MSIntermodalRouter::Network::TAXI_DROPOFF_PT;
+    } else if (taxiDropoff == "allJunctions") {
+        carWalk |= MSIntermodalRouter::Network::TAXI_DROPOFF_ANYWHERE;
+    }
+    if (taxiPickup == "") {
+        if (MSDevice_Taxi::getTaxi() != nullptr) {
             carWalk |= MSIntermodalRouter::Network::TAXI_PICKUP_ANYWHERE;
         }
-        const std::string routingAlgorithm = OptionsCont::getOptions().getString("routing-algorithm");
-        double taxiWait = STEPS2TIME(string2time(OptionsCont::getOptions().getString("persontrip.taxi.waiting-time")));
-        if (routingMode == libsumo::ROUTING_MODE_COMBINED) {
-            myIntermodalRouter[key] = new MSIntermodalRouter(MSNet::adaptIntermodalRouter, carWalk, taxiWait, routingAlgorithm, routingMode, new FareModul());
-        } else {
-            myIntermodalRouter[key] = new MSIntermodalRouter(MSNet::adaptIntermodalRouter, carWalk, taxiWait, routingAlgorithm, routingMode);
-        }
+    } else if (taxiPickup == "ptStops") {
+        carWalk |= MSIntermodalRouter::Network::TAXI_PICKUP_PT;
+    } else if (taxiPickup == "allJunctions") {
+        carWalk |= MSIntermodalRouter::Network::TAXI_PICKUP_ANYWHERE;
     }
-    myIntermodalRouter[key]->prohibit(prohibited);
-    return *myIntermodalRouter[key];
+    const std::string routingAlgorithm = OptionsCont::getOptions().getString("routing-algorithm");
+    double taxiWait = STEPS2TIME(string2time(OptionsCont::getOptions().getString("persontrip.taxi.waiting-time")));
+    if (routingMode == libsumo::ROUTING_MODE_COMBINED) {
+        return new MSIntermodalRouter(MSNet::adaptIntermodalRouter, carWalk, taxiWait, routingAlgorithm, routingMode, new FareModul());
+    }
+    return new MSIntermodalRouter(MSNet::adaptIntermodalRouter, carWalk, taxiWait, routingAlgorithm, routingMode);
 }
 
 
@@ -1662,6 +1926,26 @@ MSNet::loadState(const std::string& fileName, const bool catchExceptions) {
     if (MsgHandler::getErrorInstance()->wasInformed()) {
         throw ProcessError(TLF("Loading state from '%' failed.", fileName));
     }
+    finishStateLoading();
+    return newTime;
+}
+
+
+SUMOTime
+MSNet::loadStateString(const std::string& content, const SUMOTime time) {
+    clearState(time);
+    MSStateHandler h("checkpoint", 0);
+    XMLSubSys::runParserString(h, content, "checkpoint", false);
+    if (MsgHandler::getErrorInstance()->wasInformed()) {
+        throw ProcessError(TLF("Loading state from checkpoint at time % failed.", time2string(time)));
+    }
+    finishStateLoading();
+    return time;
+}
+
+
+void
+MSNet::finishStateLoading() {
     // reset route loaders
     delete myRouteLoaders;
     myRouteLoaders = NLBuilder::buildRouteLoaderControl(OptionsCont::getOptions());
@@ -1669,7 +1953,6 @@ MSNet::loadState(const std::string& fileName, const bool catchExceptions) {
     MSGlobals::gStateLoaded = true;
 
     updateGUI();
-    return newTime;
 }
 
 
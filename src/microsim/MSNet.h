@@ -36,6 +36,7 @@
 #include <cmath>
 #include <iomanip>
 #include <memory>
+#include <functional>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/UtilExceptions.h>
 #include <utils/common/NamedObjectCont.h>
@@ -349,6 +350,16 @@ public:
     bool logSimulationDuration() const;
 
 
+    /** @brief Returns whether optional work shall be skipped to catch up with the wall clock
+     *
+     * This is only the case in real time mode (option real-time) while the lag
+     *  exceeds real-time.shed-lag.
+     */
+    bool isBehindRealTime() const {
+        return myRealTimeShedLag >= 0 && myRealTimeLag > myRealTimeShedLag;
+    }
+
+
 
     /// @name Output during the simulation
     //@{
@@ -368,6 +379,14 @@ public:
     //}
 
 
+    /** @brief Waits until the wall clock reaches the current simulation time (real time mode)
+     *
+     * Updates the lag if the simulation is slower than the wall clock.
+     * @param[in] start The simulation time at which the wall clock was started
+     */
+    void synchronizeRealTime(const SUMOTime start);
+
+
 
     /// @name Retrieval of references to substructures
     /// @{
@@ -425,6 +444,16 @@ public:
     }
 
 
+    /** @brief Processes the index range [begin, end) in chunks on the simulation threads
+     *
+     * Every subsystem shares the thread pool of the edge control and thus the
+     *  thread budget given by --threads. A positive grain yields chunks which do
+     *  not depend on the number of threads (see MSEdgeControl::parallelFor).
+     * @param[in] fn The function processing the chunk given by its begin and end
+     */
+    void parallelFor(const int begin, const int end, const int grain, const std::function<void(int, int)>& fn);
+
+
     /** @brief Returns the insertion control
      * @return The insertion control
      * @see MSInsertionControl
@@ -575,6 +604,12 @@ public:
     /// @brief write rail signal block output
     void writeRailSignalBlocks() const;
 
+    /// @brief write a spatial partition of the network (for splitting the simulation into parallel domains)
+    void writePartitions(const int numParts) const;
+
+    /// @brief assign the given edges to numParts partitions (starting at firstPart) by recursive coordinate bisection
+    static void bisectEdges(std::vector<const MSEdge*>& edges, const int firstPart, const int numParts, std::vector<int>& partOf);
+
     /// @brief creates a wrapper for the given logic (see GUINet)
     virtual void createTLWrapper(MSTrafficLightLogic*) {};
 
@@ -594,6 +629,9 @@ public:
     /// @brief load state from file and return new time
     SUMOTime loadState(const std::string& fileName, const bool catchExceptions);
 
+    /// @brief load state from the given XML content (with the given time) and return new time
+    SUMOTime loadStateString(const std::string& content, const SUMOTime time);
+
     /// @brief reset state to the beginning without reloading the network
     void quickReload();
 
@@ -671,6 +709,23 @@ public:
      * @see VehicleStateListener:vehicleStateChanged
      */
     void informVehicleStateListener(const SUMOVehicle* const vehicle, VehicleState to, const std::string& info = "");
+
+
+    /** @brief Collects the vehicle state changes of the following parallel phase
+     *
+     * Until flushVehicleStateEvents is called, the worker threads record the events
+     *  in per thread buffers instead of calling the listeners.
+     */
+    void deferVehicleStateEvents();
+
+
+    /** @brief Informs the listeners about the collected state changes
+     *
+     * The events are delivered sorted by the vehicles' numerical ids, the events
+     *  of a single vehicle in the order of their occurrence. This does not depend
+     *  on the number of threads or their scheduling.
+     */
+    void flushVehicleStateEvents();
     /// @}
 
 
@@ -850,6 +905,9 @@ protected:
      */
     void postMoveStep();
 
+    /// @brief builds a new intermodal router (including its network) for the given routing mode
+    MSIntermodalRouter* createIntermodalRouter(const int routingMode) const;
+
 protected:
     /// @brief Unique instance of MSNet
     static MSNet* myInstance;
@@ -924,6 +982,21 @@ protected:
     /// @brief The overall time spent waiting for traci operations including
     long myTraCIMillis;
 
+    /// @brief The number of simulation seconds per wall clock second (0 if not running in real time mode)
+    double myRealTimeFactor = 0.;
+
+    /// @brief The lag (in ms) from which on optional work is skipped (-1 if never)
+    long myRealTimeShedLag = -1;
+
+    /// @brief The wall clock time at the start of the real time mode
+    long myRealTimeBeginMillis = 0;
+
+    /// @brief The current and the maximum lag (in ms) behind the wall clock
+    long myRealTimeLag = 0, myRealTimeMaxLag = 0;
+
+    /// @brief The number of steps which ended after their deadline
+    int myRealTimeLateSteps = 0;
+
     /// @brief The overall number of vehicle movements
     long long int myVehiclesMoved;
     long long int myPersonsMoved;
@@ -991,6 +1064,9 @@ protected:
     /// @brief Container for vehicle state listener
     std::vector<VehicleStateListener*> myVehicleStateListeners;
 
+    /// @brief whether vehicle state changes are collected for delivery after the current parallel phase
+    bool myDeferVehicleStateEvents;
+
     /// @brief Container for transportable state listener
     std::vector<TransportableStateListener*> myTransportableStateListeners;
 
@@ -1028,6 +1104,9 @@ protected:
     std::unique_ptr<MSDynamicShapeUpdater> myDynamicShapeUpdater;
 
 private:
+    /// @brief resets the route loaders and the GUI after a state was loaded
+    void finishStateLoading();
+
     /// @brief Invalidated copy constructor.
     MSNet(const MSNet&);
 
@@ -26,9 +26,11 @@
 #include <algorithm>
 #include <limits>
 #include <utils/common/FileHelpers.h>
+#include <utils/common/PerformanceCounters.h>
 #include <utils/common/RGBColor.h>
 #include <utils/iodevices/OutputDevice.h>
 #include "MSEdge.h"
+#include "MSGlobals.h"
 #include "MSLane.h"
 #include "MSRoute.h"
 
@@ -38,6 +40,7 @@
 // ===========================================================================
 MSRoute::RouteDict MSRoute::myDict;
 MSRoute::RouteDistDict MSRoute::myDistDict;
+std::unordered_map<std::size_t, std::vector<std::weak_ptr<const ConstMSEdgeVector> > > MSRoute::myEdgePool;
 #ifdef HAVE_FOX
 FXMutex MSRoute::myDictMutex(true);
 #endif
@@ -52,7 +55,8 @@ MSRoute::MSRoute(const std::string& id,
                  const std::vector<SUMOVehicleParameter::Stop>& stops,
                  SUMOTime replacedTime,
                  int replacedIndex) :
-    Named(id), myEdges(edges), myAmPermanent(isPermanent),
+    Named(id), myEdgeStorage(internEdges(edges)), myEdges(*myEdgeStorage),
+    myEdgeMask(computeEdgeMask(*myEdgeStorage)), myAmPermanent(isPermanent),
     myColor(c),
     myPeriod(0),
     myCosts(-1),
@@ -60,15 +64,62 @@ MSRoute::MSRoute(const std::string& id,
     myReroute(false),
     myStops(stops),
     myReplacedTime(replacedTime),
-    myReplacedIndex(replacedIndex)
-{}
+    myReplacedIndex(replacedIndex) {
+    PerformanceCounters::added(PerformanceCounters::ROUTES, sizeof(MSRoute) + myEdges.capacity() * sizeof(MSEdge*));
+}
 
 
 MSRoute::~MSRoute() {
+    PerformanceCounters::removed(PerformanceCounters::ROUTES, sizeof(MSRoute) + myEdges.capacity() * sizeof(MSEdge*));
     delete myColor;
 }
 
 
+std::shared_ptr<const ConstMSEdgeVector>
+MSRoute::internEdges(const ConstMSEdgeVector& edges) {
+    if (!MSGlobals::gCompactRoutes) {
+        return std::make_shared<const ConstMSEdgeVector>(edges);
+    }
+    std::size_t hash = edges.size();
+    for (const MSEdge* const e : edges) {
+        hash ^= (std::size_t)e->getNumericalID() + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+#ifdef HAVE_FOX
+    FXMutexLock f(myDictMutex);
+#endif
+    std::vector<std::weak_ptr<const ConstMSEdgeVector> >& bucket = myEdgePool[hash];
+    for (auto it = bucket.begin(); it != bucket.end();) {
+        std::shared_ptr<const ConstMSEdgeVector> candidate = it->lock();
+        if (candidate == nullptr) {
+            it = bucket.erase(it);
+        } else if (*candidate == edges) {
+            return candidate;
+        } else {
+            ++it;
+        }
+    }
+    std::shared_ptr<const ConstMSEdgeVector> result = std::make_shared<const ConstMSEdgeVector>(edges);
+    bucket.push_back(result);
+    return result;
+}
+
+
+unsigned long long
+MSRoute::getEdgeBit(const MSEdge* const edge) {
+    return 1ULL << (edge->getNumericalID() & 63);
+}
+
+
+unsigned long long
+MSRoute::computeEdgeMask(const ConstMSEdgeVector& edges) {
+    unsigned long long mask = 0;
+    for (const MSEdge* const e : edges) {
+        mask |= getEdgeBit(e);
+    }
+    return mask;
+}
+
+
 MSRouteIterator
 MSRoute::begin() const {
     return myEdges.begin();
@@ -180,6 +231,7 @@ MSRoute::clear() {
     }
     myDistDict.clear();
     myDict.clear();
+    myEdgePool.clear();
 }
 
 
@@ -239,6 +291,15 @@ MSRoute::writeEdgeIDs(OutputDevice& os, int firstIndex, int lastIndex, bool with
 }
 
 
+bool
+MSRoute::contains(const MSEdge* const edge) const {
+    if ((myEdgeMask & getEdgeBit(edge)) == 0) {
+        return false;
+    }
+    return std::find(myEdges.begin(), myEdges.end(), edge) != myEdges.end();
+}
+
+
 bool
 MSRoute::containsAnyOf(const MSEdgeVector& edgelist) const {
     MSEdgeVector::const_iterator i = edgelist.begin();
@@ -304,6 +365,7 @@ MSRoute::dict_clearState() {
 #endif
     myDistDict.clear();
     myDict.clear();
+    myEdgePool.clear();
 }
 
 
@@ -26,10 +26,12 @@
 
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <algorithm>
 #include <memory>
 #include <utils/common/Named.h>
+#include <utils/common/MemoryPool.h>
 #include <utils/distribution/RandomDistributor.h>
 #include <utils/common/RGBColor.h>
 #include <utils/vehicle/SUMOVehicleParameter.h>
@@ -75,6 +77,16 @@ public:
     /// Destructor
     virtual ~MSRoute();
 
+    /// @brief allocates the memory of routes from the memory pool
+    static void* operator new(std::size_t size) {
+        return MemoryPool::allocate(size);
+    }
+
+    /// @brief returns the memory of routes to the memory pool
+    static void operator delete(void* p, std::size_t size) {
+        MemoryPool::deallocate(p, size);
+    }
+
     /// Returns the begin of the list of edges to pass
     MSRouteIterator begin() const;
 
@@ -100,9 +112,8 @@ public:
      */
     int writeEdgeIDs(OutputDevice& os, int firstIndex = 0, int lastIndex = -1, bool withInternal = false, SUMOVehicleClass svc = SVC_IGNORING) const;
 
-    bool contains(const MSEdge* const edge) const {
-        return std::find(myEdges.begin(), myEdges.end(), edge) != myEdges.end();
-    }
+    /// @brief whether the route passes the given edge (most negative answers do not need to scan the edges)
+    bool contains(const MSEdge* const edge) const;
 
     bool containsAnyOf(const MSEdgeVector& edgelist) const;
 
@@ -272,9 +283,24 @@ public:
 
     static void insertIDs(std::vector<std::string>& into);
 
+    /// @brief returns the edge list to use for a new route, identical lists are shared if MSGlobals::gCompactRoutes is set
+    static std::shared_ptr<const ConstMSEdgeVector> internEdges(const ConstMSEdgeVector& edges);
+
 private:
+    /// @brief the bit of the given edge in myEdgeMask
+    static unsigned long long getEdgeBit(const MSEdge* const edge);
+
+    /// @brief computes myEdgeMask
+    static unsigned long long computeEdgeMask(const ConstMSEdgeVector& edges);
+
+    /// The storage of the edge list (may be shared with other routes)
+    const std::shared_ptr<const ConstMSEdgeVector> myEdgeStorage;
+
     /// The list of edges to pass
-    ConstMSEdgeVector myEdges;
+    const ConstMSEdgeVector& myEdges;
+
+    /// @brief one bit per edge numerical id modulo 64 for every edge of the route
+    const unsigned long long myEdgeMask;
 
     /// whether the route may be deleted after the last vehicle abandoned it
     const bool myAmPermanent;
@@ -316,6 +342,9 @@ private:
     /// The dictionary container
     static RouteDistDict myDistDict;
 
+    /// @brief the shared edge lists by their hash
+    static std::unordered_map<std::size_t, std::vector<std::weak_ptr<const ConstMSEdgeVector> > > myEdgePool;
+
 #ifdef HAVE_FOX
     /// @brief the mutex for the route dictionaries
     static FXMutex myDictMutex;
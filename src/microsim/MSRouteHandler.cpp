@@ -563,7 +563,7 @@ MSRouteHandler::closeVehicle() {
     MSVehicleControl& vehControl = MSNet::getInstance()->getVehicleControl();
     if (myVehicleParameter->departProcedure == DepartDefinition::GIVEN) {
         // let's check whether this vehicle had to depart before the simulation starts
-        if (!(myAddVehiclesDirectly || checkLastDepart()) || (myVehicleParameter->depart < string2time(OptionsCont::getOptions().getString("begin")) && !myAmLoadingState)) {
+        if (!(myAddVehiclesDirectly || checkLastDepart()) || (myVehicleParameter->depart < MSGlobals::gBegin && !myAmLoadingState)) {
             return;
         }
     }
@@ -760,7 +760,7 @@ MSRouteHandler::closeTransportable() {
         }
         // let's check whether this transportable had to depart before the simulation starts
         if (!(myAddVehiclesDirectly || checkLastDepart())
-                || (myVehicleParameter->depart < string2time(OptionsCont::getOptions().getString("begin")) && !myAmLoadingState)) {
+                || (myVehicleParameter->depart < MSGlobals::gBegin && !myAmLoadingState)) {
             deleteActivePlanAndVehicleParameter();
             return;
         }
@@ -818,7 +818,7 @@ MSRouteHandler::closeTransportableFlow() {
         }
         // let's check whether this transportable (person/container) had to depart before the simulation starts
         if (!(myAddVehiclesDirectly || checkLastDepart())
-                || (myVehicleParameter->depart < string2time(OptionsCont::getOptions().getString("begin")) && !myAmLoadingState)) {
+                || (myVehicleParameter->depart < MSGlobals::gBegin && !myAmLoadingState)) {
             deleteActivePlanAndVehicleParameter();
             return;
         }
@@ -953,7 +953,7 @@ MSRouteHandler::closeFlow() {
     // let's check whether vehicles had to depart before the simulation starts
     myVehicleParameter->repetitionsDone = 0;
     if (myVehicleParameter->repetitionProbability < 0) {
-        const SUMOTime offsetToBegin = string2time(OptionsCont::getOptions().getString("begin")) - myVehicleParameter->depart;
+        const SUMOTime offsetToBegin = MSGlobals::gBegin - myVehicleParameter->depart;
         while (myVehicleParameter->repetitionTotalOffset < offsetToBegin) {
             myVehicleParameter->incrementFlow(1, &myParsingRNG);
             if (myVehicleParameter->repetitionsDone == myVehicleParameter->repetitionNumber) {
@@ -1118,7 +1118,7 @@ MSRouteHandler::addRideOrTransport(const SUMOSAXAttributes& attrs, const SumoXML
                 throw ProcessError("The to edge '" + toID + "' within a " + mode + " of " + agent + " '" + aid + "' is not known.");
             }
         }
-        const std::string group = attrs.getOpt<std::string>(SUMO_ATTR_GROUP, aid.c_str(), ok, OptionsCont::getOptions().getString("persontrip.default.group"));
+        const std::string group = attrs.getOpt<std::string>(SUMO_ATTR_GROUP, aid.c_str(), ok, MSGlobals::gPersonTripDefaultGroup);
         const std::string intendedVeh = attrs.getOpt<std::string>(SUMO_ATTR_INTENDED, nullptr, ok, "");
         const SUMOTime intendedDepart = attrs.getOptSUMOTimeReporting(SUMO_ATTR_DEPART, nullptr, ok, -1);
         arrivalPos = SUMOVehicleParameter::interpretEdgePos(arrivalPos, to->getLength(), SUMO_ATTR_ARRIVALPOS, agent + " '" + aid + "' takes a " + mode + " to edge '" + to->getID() + "'");
@@ -1437,7 +1437,7 @@ MSRouteHandler::addPersonTrip(const SUMOSAXAttributes& attrs) {
         parseWalkPositions(attrs, myVehicleParameter->id, from, to, departPos, arrivalPos, stoppingPlace, nullptr, ok);
 
         const std::string modes = attrs.getOpt<std::string>(SUMO_ATTR_MODES, id, ok, "");
-        const std::string group = attrs.getOpt<std::string>(SUMO_ATTR_GROUP, id, ok, OptionsCont::getOptions().getString("persontrip.default.group"));
+        const std::string group = attrs.getOpt<std::string>(SUMO_ATTR_GROUP, id, ok, MSGlobals::gPersonTripDefaultGroup);
         SVCPermissions modeSet = 0;
         std::string errorMsg;
         // try to parse person modes
@@ -1457,7 +1457,7 @@ MSRouteHandler::addPersonTrip(const SUMOSAXAttributes& attrs) {
         if (attrs.hasAttribute(SUMO_ATTR_SPEED) && speed <= 0) {
             throw ProcessError(TLF("Non-positive walking speed for '%'.", myVehicleParameter->id));
         }
-        const double walkFactor = attrs.getOpt<double>(SUMO_ATTR_WALKFACTOR, id, ok, OptionsCont::getOptions().getFloat("persontrip.walkfactor"));
+        const double walkFactor = attrs.getOpt<double>(SUMO_ATTR_WALKFACTOR, id, ok, MSGlobals::gPersonTripWalkFactor);
         const double departPosLat = interpretDepartPosLat(attrs.getOpt<std::string>(SUMO_ATTR_DEPARTPOS_LAT, nullptr, ok, ""), -1, "personTrip");
         if (ok) {
             if (myActiveTransportablePlan->empty()) {
@@ -0,0 +1,121 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSStateCheckpoints.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// A ring of simulation states kept in memory for fast rollbacks
+/****************************************************************************/
+#include <config.h>
+
+#include <utils/common/UtilExceptions.h>
+#include <utils/common/StdDefs.h>
+#include <utils/iodevices/OutputDevice_String.h>
+#include "MSNet.h"
+#include "MSStateHandler.h"
+#include "MSStateCheckpoints.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+std::deque<MSStateCheckpoints::Checkpoint> MSStateCheckpoints::myCheckpoints;
+std::unordered_set<MSStateCheckpoints::Line, MSStateCheckpoints::LineHash, MSStateCheckpoints::LineEqual> MSStateCheckpoints::myPool;
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+void
+MSStateCheckpoints::save(const int maxCheckpoints) {
+    const SUMOTime now = MSNet::getInstance()->getCurrentTimeStep();
+    OutputDevice_String out;
+    MSStateHandler::saveState(out, now, true);
+    const std::string content = out.getString();
+    myCheckpoints.push_back(Checkpoint());
+    Checkpoint& cp = myCheckpoints.back();
+    cp.time = now;
+    std::string::size_type start = 0;
+    while (start < content.size()) {
+        std::string::size_type end = content.find('\n', start);
+        end = end == std::string::npos ? content.size() : end + 1;
+        // reuse the line if any checkpoint contains it already
+        cp.lines.push_back(*myPool.insert(std::make_shared<const std::string>(content, start, end - start)).first);
+        start = end;
+    }
+    bool removed = false;
+    while ((int)myCheckpoints.size() > MAX2(1, maxCheckpoints)) {
+        myCheckpoints.pop_front();
+        removed = true;
+    }
+    if (removed) {
+        prunePool();
+    }
+}
+
+
+SUMOTime
+MSStateCheckpoints::load(const SUMOTime time) {
+    while (!myCheckpoints.empty() && time >= 0 && myCheckpoints.back().time > time) {
+        myCheckpoints.pop_back();
+    }
+    if (myCheckpoints.empty()) {
+        prunePool();
+        throw ProcessError(TLF("There is no checkpoint at or before time %.", time2string(time)));
+    }
+    const Checkpoint& cp = myCheckpoints.back();
+    std::string content;
+    std::string::size_type size = 0;
+    for (const Line& line : cp.lines) {
+        size += line->size();
+    }
+    content.reserve(size);
+    for (const Line& line : cp.lines) {
+        content += *line;
+    }
+    prunePool();
+    return MSNet::getInstance()->loadStateString(content, cp.time);
+}
+
+
+std::vector<SUMOTime>
+MSStateCheckpoints::getTimes() {
+    std::vector<SUMOTime> result;
+    for (const Checkpoint& cp : myCheckpoints) {
+        result.push_back(cp.time);
+    }
+    return result;
+}
+
+
+void
+MSStateCheckpoints::clear() {
+    myCheckpoints.clear();
+    myPool.clear();
+}
+
+
+void
+MSStateCheckpoints::prunePool() {
+    for (auto it = myPool.begin(); it != myPool.end();) {
+        if (it->use_count() == 1) {
+            it = myPool.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+
+/****************************************************************************/
@@ -0,0 +1,99 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSStateCheckpoints.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// A ring of simulation states kept in memory for fast rollbacks
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <utils/common/SUMOTime.h>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSStateCheckpoints
+ * @brief Keeps the last states of the simulation in memory
+ *
+ * Each checkpoint is the state as written by MSStateHandler (including the
+ *  random number generators), split into lines. Lines which are identical to
+ *  a line of another checkpoint (routes, types, lanes and vehicles which did
+ *  not change) are stored only once, so every checkpoint only needs memory for
+ *  what changed since the previous ones. Restoring a checkpoint parses the
+ *  state from memory without touching the file system.
+ */
+class MSStateCheckpoints {
+public:
+    /** @brief saves the current state as a new checkpoint
+     * @param[in] maxCheckpoints The number of checkpoints to keep (the oldest ones are discarded)
+     */
+    static void save(const int maxCheckpoints);
+
+    /** @brief restores the newest checkpoint which is not later than the given time
+     *
+     * All checkpoints saved after the restored one are discarded.
+     * @param[in] time The latest time to restore (negative values restore the newest checkpoint)
+     * @return The time of the restored state
+     * @exception ProcessError If there is no such checkpoint or loading fails
+     */
+    static SUMOTime load(const SUMOTime time);
+
+    /// @brief the times of all checkpoints from the oldest to the newest
+    static std::vector<SUMOTime> getTimes();
+
+    /// @brief discards all checkpoints
+    static void clear();
+
+private:
+    typedef std::shared_ptr<const std::string> Line;
+
+    struct LineHash {
+        std::size_t operator()(const Line& line) const {
+            return std::hash<std::string>()(*line);
+        }
+    };
+
+    struct LineEqual {
+        bool operator()(const Line& a, const Line& b) const {
+            return *a == *b;
+        }
+    };
+
+    struct Checkpoint {
+        SUMOTime time;
+        std::vector<Line> lines;
+    };
+
+    /// @brief removes the lines which are not used by any checkpoint anymore
+    static void prunePool();
+
+    /// @brief the checkpoints from the oldest to the newest
+    static std::deque<Checkpoint> myCheckpoints;
+
+    /// @brief all distinct lines of the stored checkpoints
+    static std::unordered_set<Line, LineHash, LineEqual> myPool;
+
+private:
+    /// @brief Invalidated constructor.
+    MSStateCheckpoints() = delete;
+};
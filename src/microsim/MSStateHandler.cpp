@@ -126,6 +126,13 @@ MSStateHandler::~MSStateHandler() {
 void
 MSStateHandler::saveState(const std::string& file, SUMOTime step, bool usePrefix) {
     OutputDevice& out = OutputDevice::getDevice(file, usePrefix);
+    saveState(out, step, OptionsCont::getOptions().getBool("save-state.rng"));
+    out.close();
+}
+
+
+void
+MSStateHandler::saveState(OutputDevice& out, SUMOTime step, const bool saveRNG) {
     out.setPrecision(OptionsCont::getOptions().getInt("save-state.precision"));
     out.writeHeader<MSEdge>(SUMO_TAG_SNAPSHOT);
     out.writeAttr("xmlns:xsi", "http://www.w3.org/2001/XMLSchema-instance").writeAttr("xsi:noNamespaceSchemaLocation", "http://sumo.dlr.de/xsd/state_file.xsd");
@@ -135,7 +142,7 @@ MSStateHandler::saveState(const std::string& file, SUMOTime step, bool usePrefix
     if (OptionsCont::getOptions().getBool("save-state.constraints")) {
         out.writeAttr(SUMO_ATTR_CONSTRAINTS, true);
     }
-    if (OptionsCont::getOptions().getBool("save-state.rng")) {
+    if (saveRNG) {
         saveRNGs(out);
         if (!MSGlobals::gUseMesoSim) {
             MSNet::getInstance()->getEdgeControl().saveState(out);
@@ -169,7 +176,6 @@ MSStateHandler::saveState(const std::string& file, SUMOTime step, bool usePrefix
         }
     }
     MSNet::getInstance()->getTLSControl().saveState(out);
-    out.close();
 }
 
 
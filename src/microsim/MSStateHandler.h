@@ -54,6 +54,14 @@ public:
      */
     static void saveState(const std::string& file, SUMOTime step, bool usePrefix = true);
 
+    /** @brief Writes the current state to the given device (without closing it)
+     *
+     * @param[in] out The device to write the state into
+     * @param[in] step The current time step
+     * @param[in] saveRNG Whether the states of the random number generators shall be included
+     */
+    static void saveState(OutputDevice& out, SUMOTime step, const bool saveRNG);
+
     /// @brief get time
     SUMOTime getTime() const {
         return myTime;
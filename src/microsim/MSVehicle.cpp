@@ -41,6 +41,7 @@
 #include <memory>
 #include <utils/common/ToString.h>
 #include <utils/common/FileHelpers.h>
+#include <utils/common/PerformanceCounters.h>
 #include <utils/router/DijkstraRouter.h>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/RandHelper.h>
@@ -965,6 +966,7 @@ MSVehicle::MSVehicle(SUMOVehicleParameter* pars, ConstMSRoutePtr route,
     myDriverState(nullptr),
     myActionStep(true),
     myLastActionTime(0),
+    mySkippedActionTime(SUMOTime_MIN),
     myLane(nullptr),
     myLaneChangeModel(nullptr),
     myLastBestLanesEdge(nullptr),
@@ -974,6 +976,10 @@ MSVehicle::MSVehicle(SUMOVehicleParameter* pars, ConstMSRoutePtr route,
     mySignals(0),
     myAmOnNet(false),
     myAmIdling(false),
+    myHaveDeferredMove(false),
+    myDeferredOldPos(0),
+    myDeferredNewPos(0),
+    myDeferredSpeed(0),
     myHaveToWaitOnNextLink(false),
     myAngle(0),
     myStopDist(std::numeric_limits<double>::max()),
@@ -986,10 +992,12 @@ MSVehicle::MSVehicle(SUMOVehicleParameter* pars, ConstMSRoutePtr route,
     myInfluencer(nullptr) {
     myCFVariables = type->getCarFollowModel().createVehicleVariables();
     myNextDriveItem = myLFLinkLanes.begin();
+    PerformanceCounters::added(PerformanceCounters::VEHICLES, sizeof(MSVehicle));
 }
 
 
 MSVehicle::~MSVehicle() {
+    PerformanceCounters::removed(PerformanceCounters::VEHICLES, sizeof(MSVehicle));
     cleanupFurtherLanes();
     delete myLaneChangeModel;
     if (myType->isVehicleSpecific()) {
@@ -1114,9 +1122,22 @@ MSVehicle::replaceRoute(ConstMSRoutePtr newRoute, const std::string& info, bool
 // ------------ Interaction with move reminders
 void
 MSVehicle::workOnMoveReminders(double oldPos, double newPos, double newSpeed) {
+    // parallel safe reminders are notified after all vehicles moved (see MSEdgeControl::executeMovements)
+    const bool defer = MSGlobals::gDevicePhase && MSNet::getInstance()->getEdgeControl().isExecutingMovements();
     // This erasure-idiom works for all stl-sequence-containers
     // See Meyers: Effective STL, Item 9
     for (MoveReminderCont::iterator rem = myMoveReminders.begin(); rem != myMoveReminders.end();) {
+        if (defer && rem->first->isParallelSafe()) {
+            if (!myHaveDeferredMove) {
+                myHaveDeferredMove = true;
+                myDeferredOldPos = oldPos;
+                myDeferredNewPos = newPos;
+                myDeferredSpeed = newSpeed;
+                MSNet::getInstance()->getEdgeControl().needsDeviceUpdate(this);
+            }
+            ++rem;
+            continue;
+        }
         // XXX: calling notifyMove with newSpeed seems not the best choice. For the ballistic update, the average speed is calculated and used
         //      although a higher order quadrature-formula might be more adequate.
         //      For the euler case (where the speed is considered constant for each time step) it is conceivable that
@@ -1155,6 +1176,23 @@ MSVehicle::workOnMoveReminders(double oldPos, double newPos, double newSpeed) {
 }
 
 
+void
+MSVehicle::workOnDeferredMoveReminders() {
+    if (!myHaveDeferredMove) {
+        return;
+    }
+    for (MoveReminderCont::iterator rem = myMoveReminders.begin(); rem != myMoveReminders.end();) {
+        if (rem->first->isParallelSafe()
+                && !rem->first->notifyMove(*this, myDeferredOldPos + rem->second, myDeferredNewPos + rem->second, MAX2(0., myDeferredSpeed))) {
+            rem = myMoveReminders.erase(rem);
+        } else {
+            ++rem;
+        }
+    }
+    myHaveDeferredMove = false;
+}
+
+
 void
 MSVehicle::workOnIdleReminders() {
     updateWaitingTime(0.);   // cf issue 2233
@@ -1234,14 +1272,38 @@ MSVehicle::getPosition(const double offset) const {
         if (myStops.begin()->parkingarea != nullptr) {
             return myStops.begin()->parkingarea->getVehiclePosition(*this);
         } else {
+            if (offset == 0. && myTransientPosition.parking && myTransientPosition.lane == myLane && myTransientPosition.pos == myState.myPos) {
+                return myTransientPosition.position;
+            }
             // position beside the road
             PositionVector shp = myLane->getEdge().getLanes()[0]->getShape();
             shp.move2side(SUMO_const_laneWidth * (MSGlobals::gLefthand ? -1 : 1));
-            return shp.positionAtOffset(myLane->interpolateLanePosToGeometryPos(getPositionOnLane() + offset));
+            const Position result = shp.positionAtOffset(myLane->interpolateLanePosToGeometryPos(getPositionOnLane() + offset));
+            if (offset == 0.) {
+                myTransientPosition.lane = myLane;
+                myTransientPosition.pos = myState.myPos;
+                myTransientPosition.parking = true;
+                myTransientPosition.position = result;
+            }
+            return result;
         }
     }
     const bool changingLanes = myLaneChangeModel->isChangingLanes();
     const double posLat = (MSGlobals::gLefthand ? 1 : -1) * getLateralPositionOnLane();
+    if (offset == 0. && changingLanes) {
+        const MSLane* const shadowLane = myLaneChangeModel->getShadowLane();
+        if (myTransientPosition.parking || myTransientPosition.lane != myLane || myTransientPosition.shadowLane != shadowLane
+                || myTransientPosition.pos != myState.myPos || myTransientPosition.posLat != posLat) {
+            myTransientPosition.lane = myLane;
+            myTransientPosition.shadowLane = shadowLane;
+            myTransientPosition.pos = myState.myPos;
+            myTransientPosition.posLat = posLat;
+            myTransientPosition.parking = false;
+            myTransientPosition.position = validatePosition(myLane->geometryPositionAtOffset(myState.myPos, posLat));
+            interpolateLateralZ(myTransientPosition.position, myState.myPos, posLat);
+        }
+        return myTransientPosition.position;
+    }
     if (offset == 0. && !changingLanes) {
         if (myCachedPosition == Position::INVALID) {
             myCachedPosition = validatePosition(myLane->geometryPositionAtOffset(myState.myPos, posLat));
@@ -1459,7 +1521,7 @@ MSVehicle::computeAngle() const {
         if (myStops.begin()->parkingarea != nullptr) {
             return myStops.begin()->parkingarea->getVehicleAngle(*this);
         } else {
-            return myLane->getShape().rotationAtOffset(myLane->interpolateLanePosToGeometryPos(getPositionOnLane()));
+            return myLane->getShapeIndex().rotationAtOffset(myLane->interpolateLanePosToGeometryPos(getPositionOnLane()));
         }
     }
     if (myLaneChangeModel->isChangingLanes()) {
@@ -1495,7 +1557,7 @@ MSVehicle::computeAngle() const {
         }
     }
     double result = (p1 != p2 ? p2.angleTo2D(p1) :
-                     myLane->getShape().rotationAtOffset(myLane->interpolateLanePosToGeometryPos(getPositionOnLane())));
+                     myLane->getShapeIndex().rotationAtOffset(myLane->interpolateLanePosToGeometryPos(getPositionOnLane())));
 
     result += lefthandSign * myLaneChangeModel->calcAngleOffset();
 
@@ -1989,6 +2051,20 @@ MSVehicle::getBrakeGap(bool delayed) const {
 bool
 MSVehicle::checkActionStep(const SUMOTime t) {
     myActionStep = isActionStep(t);
+    if (myActionStep && t != mySkippedActionTime) {
+        if (MSGlobals::gFreeFlowSkip > 0 && canSkipFreeFlowAction(t)) {
+            mySkippedActionTime = t;
+        } else if (MSGlobals::gStopSkip && canSkipStoppedAction(t)) {
+            // the stop passes as in processNextStop
+            myStops.front().duration -= getActionStepLength();
+            mySkippedActionTime = t;
+        }
+    }
+    if (myActionStep && t == mySkippedActionTime) {
+        // the decision has to stay the same when being called again in this step
+        myActionStep = false;
+        myAcceleration = 0.;
+    }
     if (myActionStep) {
         myLastActionTime = t;
     }
@@ -1996,6 +2072,48 @@ MSVehicle::checkActionStep(const SUMOTime t) {
 }
 
 
+bool
+MSVehicle::canSkipFreeFlowAction(const SUMOTime t) const {
+    if (t - myLastActionTime >= MSGlobals::gFreeFlowSkip || myLFLinkLanes.empty() || myLane == nullptr || myLane->isInternal()
+            || myInfluencer != nullptr || isStopped() || myLaneChangeModel->isChangingLanes() || myLaneChangeModel->getShadowLane() != nullptr
+            || myLane->getVehicleNumberWithPartials() != 1) {
+        return false;
+    }
+    if (!myStops.empty() && &myStops.front().lane->getEdge() == &myLane->getEdge()) {
+        return false;
+    }
+    const double vMax = getMaxSpeedOnLane();
+    if (getSpeed() > vMax || getSpeed() < vMax - ACCEL2SPEED(getCarFollowModel().getMaxAccel()) || getBestLaneOffset() != 0) {
+        return false;
+    }
+    // the lane end must stay beyond the lookahead of planMove until the next regular action
+    const double skipDist = vMax * STEPS2TIME(MSGlobals::gFreeFlowSkip + getActionStepLength());
+    const double lookAhead = getCarFollowModel().brakeGap(vMax) + SPEED2DIST(vMax) + getVehicleType().getMinGap();
+    return myLane->getLength() - getPositionOnLane() > skipDist + lookAhead + POSITION_EPS;
+}
+
+
+bool
+MSVehicle::canSkipStoppedAction(const SUMOTime t) const {
+    if (!isStopped() || myInfluencer != nullptr || getSpeed() != 0 || myAmRegisteredAsWaiting) {
+        return false;
+    }
+    const MSStop& stop = myStops.front();
+    if (stop.triggered || stop.containerTriggered || stop.joinTriggered || stop.pars.join != "" || stop.pars.collision
+            || stop.getSpeed() > 0 || stop.duration - getActionStepLength() <= 0) {
+        return false;
+    }
+    // boarding and loading need the regular processing in processNextStop
+    MSNet* const net = MSNet::getInstance();
+    if (t <= stop.endBoarding && myLane != nullptr
+            && ((net->hasPersons() && net->getPersonControl().hasAnyWaiting(&myLane->getEdge(), const_cast<MSVehicle*>(this)))
+                || (net->hasContainers() && net->getContainerControl().hasAnyWaiting(&myLane->getEdge(), const_cast<MSVehicle*>(this))))) {
+        return false;
+    }
+    return true;
+}
+
+
 void
 MSVehicle::resetActionOffset(const SUMOTime timeUntilNextAction) {
     myLastActionTime = MSNet::getInstance()->getCurrentTimeStep() + timeUntilNextAction;
@@ -2059,7 +2177,8 @@ MSVehicle::planMove(const SUMOTime t, const MSLeaderInfo& ahead, const double le
             std::cout << STEPS2TIME(t) << " vehicle = '" << getID() << "' takes action." << std::endl;
         }
 #endif
-        myLFLinkLanesPrev = myLFLinkLanes;
+        // the new items are planned into the storage of the previous ones (planMoveInternal clears it)
+        myLFLinkLanesPrev.swap(myLFLinkLanes);
         if (myInfluencer != nullptr) {
             myInfluencer->updateRemoteControlRoute(this);
         }
@@ -2127,7 +2246,7 @@ MSVehicle::brakeForOverlap(const MSLink* link, const MSLane* lane) const {
 
 
 void
-MSVehicle::planMoveInternal(const SUMOTime t, MSLeaderInfo ahead, DriveItemVector& lfLinks, double& newStopDist, std::pair<double, const MSLink*>& nextTurn) const {
+MSVehicle::planMoveInternal(const SUMOTime t, const MSLeaderInfo& ahead, DriveItemVector& lfLinks, double& newStopDist, std::pair<double, const MSLink*>& nextTurn) const {
     lfLinks.clear();
     newStopDist = std::numeric_limits<double>::max();
     //
@@ -2210,6 +2329,9 @@ MSVehicle::planMoveInternal(const SUMOTime t, MSLeaderInfo ahead, DriveItemVecto
     const MSLane* lane = opposite ? myLane->getParallelOpposite() : myLane;
     assert(lane != 0);
     const MSLane* leaderLane = myLane;
+    // the leaders on leaderLane, the ones on the following lanes are copied into laneLeaders
+    const MSLeaderInfo* leaders = &ahead;
+    MSLeaderInfo laneLeaders(0.);
     bool foundRailSignal = !isRailway(getVClass());
 #ifdef PARALLEL_STOPWATCH
     myLane->getStopWatch()[0].start();
@@ -2229,7 +2351,6 @@ MSVehicle::planMoveInternal(const SUMOTime t, MSLeaderInfo ahead, DriveItemVecto
         if (opposite &&
                 (leaderLane->getVehicleNumberWithPartials() > 1
                  || (leaderLane != myLane && leaderLane->getVehicleNumber() > 0))) {
-            ahead.clear();
             // find opposite-driving leader that must be respected on the currently looked at lane
             // (only looking at one lane at a time)
             const double backOffset = leaderLane == myLane ? getPositionOnLane() : leaderLane->getLength();
@@ -2305,7 +2426,7 @@ MSVehicle::planMoveInternal(const SUMOTime t, MSLeaderInfo ahead, DriveItemVecto
                     }
                 }
             }
-            adaptToLeaders(ahead, lateralShift, seen, lastLink, leaderLane, v, vLinkPass);
+            adaptToLeaders(*leaders, lateralShift, seen, lastLink, leaderLane, v, vLinkPass);
         }
         if (lastLink != nullptr) {
             lastLink->myVLinkWait = MIN2(lastLink->myVLinkWait, v);
@@ -2587,7 +2708,8 @@ MSVehicle::planMoveInternal(const SUMOTime t, MSLeaderInfo ahead, DriveItemVecto
         //   the next step, new foes may appear and cause a collision (see #1096)
         // - major links: stopping point is irrelevant
         double laneStopOffset;
-        const double majorStopOffset = MAX2(getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_STOPLINE_GAP, DIST_TO_STOPLINE_EXPECT_PRIORITY), lane->getVehicleStopOffset(this));
+        const double stoplineGap = getVehicleType().getModelParams().jmStoplineGap;
+        const double majorStopOffset = MAX2(stoplineGap == INVALID_DOUBLE ? DIST_TO_STOPLINE_EXPECT_PRIORITY : stoplineGap, lane->getVehicleStopOffset(this));
         const double minorStopOffset = lane->getVehicleStopOffset(this);
         // override low desired decel at yellow and red
         const double stopDecel = yellowOrRed && !isRailway(getVClass()) ? MAX2(MIN2(MSGlobals::gTLSYellowMinDecel, cfModel.getEmergencyDecel()), cfModel.getMaxDecel()) : cfModel.getMaxDecel();
@@ -2714,7 +2836,7 @@ MSVehicle::planMoveInternal(const SUMOTime t, MSLeaderInfo ahead, DriveItemVecto
         const MSLink* entryLink = (*link)->getCorrespondingEntryLink();
         if (entryLink->haveRed() && ignoreRed(*link, canBrakeBeforeStopLine) && STEPS2TIME(t - entryLink->getLastStateChange()) > 2) {
             // restrict speed when ignoring a red light
-            const double redSpeed = MIN2(v, getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_DRIVE_RED_SPEED, v));
+            const double redSpeed = MIN2(v, getVehicleType().getModelParams().jmDriveRedSpeed);
             const double va = MAX2(redSpeed, cfModel.freeSpeed(this, getSpeed(), seen, redSpeed));
             v = MIN2(va, v);
 #ifdef DEBUG_PLAN_MOVE
@@ -2871,7 +2993,12 @@ MSVehicle::planMoveInternal(const SUMOTime t, MSLeaderInfo ahead, DriveItemVecto
 
             break;
         }
-        ahead = opposite ? MSLeaderInfo(leaderLane->getWidth()) : leaderLane->getLastVehicleInformation(nullptr, 0);
+        if (opposite) {
+            laneLeaders = MSLeaderInfo(leaderLane->getWidth());
+        } else {
+            laneLeaders = leaderLane->getLastVehicleInformation(nullptr, 0);
+        }
+        leaders = &laneLeaders;
         seen += lane->getLength();
         vLinkPass = MIN2(cfModel.estimateSpeedAfterDistance(lane->getLength(), v, cfModel.getMaxAccel()), laneMaxV); // upper bound
         lastLink = &lfLinks.back();
@@ -3360,8 +3487,8 @@ MSVehicle::checkLinkLeader(const MSLink* link, const MSLane* lane, double seen,
                 std::cout << SIMTIME << " veh=" << getID() << " is blocked on link to " << link->getViaLaneOrLane()->getID() << " by pedestrian. dist=" << it->distToCrossing << "\n";
             }
 #endif
-            if (getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_JUNCTION_FOE_PROB, 0) > 0
-                    && getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_JUNCTION_FOE_PROB, 0) >= RandHelper::rand(getRNG())) {
+            if (getVehicleType().getModelParams().jmIgnoreJunctionFoeProb > 0
+                    && getVehicleType().getModelParams().jmIgnoreJunctionFoeProb >= RandHelper::rand(getRNG())) {
 #ifdef DEBUG_PLAN_MOVE
                 if (DEBUG_COND) {
                     std::cout << SIMTIME << " veh=" << getID() << " is ignoring pedestrian (jmIgnoreJunctionFoeProb)\n";
@@ -3371,8 +3498,8 @@ MSVehicle::checkLinkLeader(const MSLink* link, const MSLane* lane, double seen,
             }
             adaptToJunctionLeader(std::make_pair(this, -1), seen, lastLink, lane, v, vLinkPass, it->distToCrossing);
         } else if (isLeader(link, leader, (*it).vehAndGap.second) || (*it).inTheWay()) {
-            if (getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_JUNCTION_FOE_PROB, 0) > 0
-                    && getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_JUNCTION_FOE_PROB, 0) >= RandHelper::rand(getRNG())) {
+            if (getVehicleType().getModelParams().jmIgnoreJunctionFoeProb > 0
+                    && getVehicleType().getModelParams().jmIgnoreJunctionFoeProb >= RandHelper::rand(getRNG())) {
 #ifdef DEBUG_PLAN_MOVE
                 if (DEBUG_COND) {
                     std::cout << SIMTIME << " veh=" << getID() << " is ignoring linkLeader=" << leader->getID() << " (jmIgnoreJunctionFoeProb)\n";
@@ -3538,14 +3665,18 @@ MSVehicle::processLinkApproaches(double& vSafe, double& vSafeMin, double& vSafeM
             }
             const bool influencerPrio = (myInfluencer != nullptr && !myInfluencer->getRespectJunctionPriority());
             MSLink::BlockingFoes collectFoes;
-            bool opened = (yellow || influencerPrio
-                           || link->opened(dpi.myArrivalTime, dpi.myArrivalSpeed, dpi.getLeaveSpeed(),
-                                           getVehicleType().getLength(),
-                                           canBrake ? getImpatience() : 1,
-                                           getCarFollowModel().getMaxDecel(),
-                                           getWaitingTime(), getLateralPositionOnLane(),
-                                           ls == LINKSTATE_ZIPPER ? &collectFoes : nullptr,
-                                           ignoreRedLink, this));
+            const int response = (MSGlobals::gJunctionPhase && ls != LINKSTATE_ZIPPER && !ignoreRedLink
+                                  ? link->getApproachResponse(this, dpi.myArrivalTime, dpi.myArrivalSpeed, dpi.getLeaveSpeed(),
+                                          canBrake ? getImpatience() : 1, getWaitingTime(), getLateralPositionOnLane())
+                                  : -1);
+            bool opened = (yellow || influencerPrio || response == 1
+                           || (response < 0 && link->opened(dpi.myArrivalTime, dpi.myArrivalSpeed, dpi.getLeaveSpeed(),
+                                   getVehicleType().getLength(),
+                                   canBrake ? getImpatience() : 1,
+                                   getCarFollowModel().getMaxDecel(),
+                                   getWaitingTime(), getLateralPositionOnLane(),
+                                   ls == LINKSTATE_ZIPPER ? &collectFoes : nullptr,
+                                   ignoreRedLink, this)));
             if (opened && myLaneChangeModel->getShadowLane() != nullptr) {
                 const MSLink* const parallelLink = dpi.myLink->getParallelLink(myLaneChangeModel->getShadowDirection());
                 if (parallelLink != nullptr) {
@@ -4747,6 +4878,22 @@ MSVehicle::updateParkingState() {
 }
 
 
+void
+MSVehicle::compactParkingState() {
+    removeApproachingInformation(myLFLinkLanes);
+    removeApproachingInformation(myLFLinkLanesPrev);
+    DriveItemVector().swap(myLFLinkLanes);
+    DriveItemVector().swap(myLFLinkLanesPrev);
+    myNextDriveItem = myLFLinkLanes.begin();
+    // keep the lanes of the current edge for the getters, the rest is rebuilt on departure
+    if (myBestLanes.size() > 1) {
+        std::vector<std::vector<LaneQ> >(myBestLanes.begin(), myBestLanes.begin() + 1).swap(myBestLanes);
+    }
+    myLastBestLanesEdge = nullptr;
+    myLastBestLanesInternalLane = nullptr;
+}
+
+
 void
 MSVehicle::replaceVehicleType(MSVehicleType* type) {
     MSBaseVehicle::replaceVehicleType(type);
@@ -5741,8 +5888,8 @@ MSVehicle::updateBestLanes(bool forceRebuild, const MSLane* startLane) {
             assert(lanes.size() > 0);
             if (&(lanes[0].lane->getEdge()) == nextEdge) {
                 // keep those lanes which are successors of internal lanes from the edge of startLane
-                std::vector<LaneQ> oldLanes = lanes;
-                lanes.clear();
+                std::vector<LaneQ> oldLanes;
+                oldLanes.swap(lanes);
                 const std::vector<MSLane*>& sourceLanes = startLane->getEdge().getLanes();
                 for (std::vector<MSLane*>::const_iterator it_source = sourceLanes.begin(); it_source != sourceLanes.end(); ++it_source) {
                     for (std::vector<LaneQ>::iterator it_lane = oldLanes.begin(); it_lane != oldLanes.end(); ++it_lane) {
@@ -5834,7 +5981,9 @@ MSVehicle::updateBestLanes(bool forceRebuild, const MSLane* startLane) {
     // bestLanes must cover the braking distance even when at the very end of the current lane to avoid unecessary slow down
     const double maxBrakeDist = startLane->getLength() + getCarFollowModel().getHeadwayTime() * getMaxSpeed() + getCarFollowModel().brakeGap(getMaxSpeed()) + getVehicleType().getMinGap();
     for (MSRouteIterator ce = myCurrEdge; progress;) {
-        std::vector<LaneQ> currentLanes;
+        // fill the entries in place to avoid copying the continuation vectors
+        myBestLanes.emplace_back();
+        std::vector<LaneQ>& currentLanes = myBestLanes.back();
         const std::vector<MSLane*>* allowed = nullptr;
         const MSEdge* nextEdge = nullptr;
         if (ce != myRoute->end() && ce + 1 != myRoute->end()) {
@@ -5842,6 +5991,7 @@ MSVehicle::updateBestLanes(bool forceRebuild, const MSLane* startLane) {
             allowed = (*ce)->allowedLanes(*nextEdge, myType->getVehicleClass());
         }
         const std::vector<MSLane*>& lanes = (*ce)->getLanes();
+        currentLanes.reserve(lanes.size());
         for (std::vector<MSLane*>::const_iterator i = lanes.begin(); i != lanes.end(); ++i) {
             LaneQ q;
             MSLane* cl = *i;
@@ -5854,7 +6004,7 @@ MSVehicle::updateBestLanes(bool forceRebuild, const MSLane* startLane) {
             q.allowsContinuation = allowed == nullptr || std::find(allowed->begin(), allowed->end(), cl) != allowed->end();
             q.occupation = 0;
             q.nextOccupation = 0;
-            currentLanes.push_back(q);
+            currentLanes.push_back(std::move(q));
         }
         //
         if (nextStopEdge == ce
@@ -5873,7 +6023,6 @@ MSVehicle::updateBestLanes(bool forceRebuild, const MSLane* startLane) {
             }
         }
 
-        myBestLanes.push_back(currentLanes);
         ++seen;
         seenLength += currentLanes[0].lane->getLength();
         ++ce;
@@ -5942,6 +6091,7 @@ MSVehicle::updateBestLanes(bool forceRebuild, const MSLane* startLane) {
     }
     // go backward through the lanes
     // track back best lane and compute the best prior lane(s)
+    const bool hasElecHybrid = getDevice(typeid(MSDevice_ElecHybrid)) != nullptr;
     for (std::vector<std::vector<LaneQ> >::reverse_iterator i = myBestLanes.rbegin() + 1; i != myBestLanes.rend(); ++i) {
         std::vector<LaneQ>& nextLanes = (*(i - 1));
         std::vector<LaneQ>& clanes = (*i);
@@ -5986,6 +6136,7 @@ MSVehicle::updateBestLanes(bool forceRebuild, const MSLane* startLane) {
                     }
                 }
                 if (bestConnectedNext != nullptr && (bestConnectedNext->allowsContinuation || bestConnectedNext->length > 0)) {
+                    j.bestContinuations.reserve(j.bestContinuations.size() + bestConnectedNext->bestContinuations.size());
                     copy(bestConnectedNext->bestContinuations.begin(), bestConnectedNext->bestContinuations.end(), back_inserter(j.bestContinuations));
                 } else {
                     j.allowsContinuation = false;
@@ -6006,7 +6157,7 @@ MSVehicle::updateBestLanes(bool forceRebuild, const MSLane* startLane) {
             }
 
             //vehicle with elecHybrid device prefers running under an overhead wire
-            if (getDevice(typeid(MSDevice_ElecHybrid)) != nullptr) {
+            if (hasElecHybrid) {
                 index = 0;
                 for (const LaneQ& j : clanes) {
                     std::string overheadWireSegmentID = MSNet::getInstance()->getStoppingPlaceID(j.lane, j.currentLength / 2., SUMO_TAG_OVERHEAD_WIRE_SEGMENT);
@@ -6084,7 +6235,7 @@ MSVehicle::updateBestLanes(bool forceRebuild, const MSLane* startLane) {
         }
 
         //vehicle with elecHybrid device prefers running under an overhead wire
-        if (static_cast<MSDevice_ElecHybrid*>(getDevice(typeid(MSDevice_ElecHybrid))) != 0) {
+        if (hasElecHybrid) {
             index = 0;
             std::string overheadWireID = MSNet::getInstance()->getStoppingPlaceID(clanes[bestThisIndex].lane, (clanes[bestThisIndex].currentLength) / 2, SUMO_TAG_OVERHEAD_WIRE_SEGMENT);
             if (overheadWireID != "") {
@@ -7183,7 +7334,7 @@ MSVehicle::wasRemoteControlled(SUMOTime lookBack) const {
 bool
 MSVehicle::keepClear(const MSLink* link) const {
     if (link->hasFoes() && link->keepClear() /* && item.myLink->willHaveBlockedFoe()*/) {
-        const double keepClearTime = getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_IGNORE_KEEPCLEAR_TIME, -1);
+        const double keepClearTime = getVehicleType().getModelParams().jmIgnoreKeepClearTime;
         //std::cout << SIMTIME << " veh=" << getID() << " keepClearTime=" << keepClearTime << " accWait=" << getAccumulatedWaitingSeconds() << " keepClear=" << (keepClearTime < 0 || getAccumulatedWaitingSeconds() < keepClearTime) << "\n";
         return keepClearTime < 0 || getAccumulatedWaitingSeconds() < keepClearTime;
     } else {
@@ -7197,14 +7348,14 @@ MSVehicle::ignoreRed(const MSLink* link, bool canBrake) const {
     if ((myInfluencer != nullptr && !myInfluencer->getEmergencyBrakeRedLight())) {
         return true;
     }
-    const double ignoreRedTime = getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_DRIVE_AFTER_RED_TIME, -1);
+    const double ignoreRedTime = getVehicleType().getModelParams().jmDriveAfterRedTime;
 #ifdef DEBUG_IGNORE_RED
     if (DEBUG_COND) {
         std::cout << SIMTIME << " veh=" << getID() << " link=" << link->getViaLaneOrLane()->getID() << " state=" << toString(link->getState()) << "\n";
     }
 #endif
     if (ignoreRedTime < 0) {
-        const double ignoreYellowTime = getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_DRIVE_AFTER_YELLOW_TIME, 0);
+        const double ignoreYellowTime = getVehicleType().getModelParams().jmDriveAfterYellowTime;
         if (ignoreYellowTime > 0 && link->haveYellow()) {
             assert(link->getTLLogic() != 0);
             const double yellowDuration = STEPS2TIME(MSNet::getInstance()->getCurrentTimeStep() - link->getLastStateChange());
@@ -279,6 +279,14 @@ public:
      * @see MSMoveReminder
      */
     void workOnMoveReminders(double oldPos, double newPos, double newSpeed);
+
+    /** @brief Processes the move reminders which were deferred to the device phase
+     *
+     * Only accesses the state of this vehicle and its reminders and may thus
+     *  be called in parallel for different vehicles.
+     * @see MSMoveReminder::isParallelSafe
+     */
+    void workOnDeferredMoveReminders();
     //@}
 
     /** @brief cycle through vehicle devices invoking notifyIdle
@@ -295,6 +303,22 @@ public:
      */
     bool checkActionStep(const SUMOTime t);
 
+    /** @brief Returns whether the action in the current step can be skipped since the vehicle drives alone in free flow
+     *
+     * This is the case if the vehicle is the only one on its lane, drives at its maximum speed on a best lane
+     *  and the end of the lane is beyond the lookahead distance for the whole skipped time (option --freeflow-skip)
+     *  @param[in] t
+     */
+    bool canSkipFreeFlowAction(const SUMOTime t) const;
+
+    /** @brief Returns whether the action in the current step can be skipped since the vehicle waits at a stop
+     *
+     * This is the case for untriggered stops which do not end within the next action step
+     *  while no transportables are waiting to board (option --stop-skip)
+     *  @param[in] t
+     */
+    bool canSkipStoppedAction(const SUMOTime t) const;
+
     /** @brief Resets the action offset for the vehicle
      *
      *  @param[in] timeUntilNextAction time interval from now for the next action, defaults to 0, which
@@ -1704,6 +1728,12 @@ public:
     /// @brief update state while parking
     void updateParkingState();
 
+    /** @brief releases the look-ahead data of a vehicle which parks for a long time
+     *
+     * The drive items and the best lanes are rebuilt when the vehicle re-enters the network.
+     */
+    void compactParkingState();
+
     /** @brief Replaces the current vehicle type by the one given
      * @param[in] type The new vehicle type
      * @see MSBaseVehicle::replaceVehicleType
@@ -1876,6 +1906,9 @@ protected:
     ///        Initialized to 0, to be set at insertion.
     SUMOTime myLastActionTime;
 
+    /// @brief The last time step in which the action was skipped (see canSkipFreeFlowAction and canSkipStoppedAction)
+    SUMOTime mySkippedActionTime;
+
 
 
     /// The lane the vehicle is on
@@ -1921,6 +1954,12 @@ protected:
     /// @brief Whether the vehicle is trying to enter the network (eg after parking so engine is running)
     bool myAmIdling;
 
+    /// @brief the arguments of the last move if parallel safe reminders still need to be notified
+    bool myHaveDeferredMove;
+    double myDeferredOldPos;
+    double myDeferredNewPos;
+    double myDeferredSpeed;
+
     bool myHaveToWaitOnNextLink;
 
     /// @brief the angle in radians (@todo consider moving this into myState)
@@ -1934,6 +1973,21 @@ protected:
 
     mutable Position myCachedPosition;
 
+    /** @brief the position while changing lanes or parking beside the road
+     *
+     * Unlike myCachedPosition it is not invalidated explicitly but validated
+     *  against the state it was computed for.
+     */
+    struct TransientPositionCache {
+        const MSLane* lane = nullptr;
+        const MSLane* shadowLane = nullptr;
+        double pos = 0.;
+        double posLat = 0.;
+        bool parking = false;
+        Position position = Position::INVALID;
+    };
+    mutable TransientPositionCache myTransientPosition;
+
     /// @brief time at which the current junction was entered
     SUMOTime myJunctionEntryTime;
     SUMOTime myJunctionEntryTimeNeverYield;
@@ -2015,8 +2069,11 @@ protected:
     */
     DriveItemVector::iterator myNextDriveItem;
 
-    /// @todo: documentation
-    void planMoveInternal(const SUMOTime t, MSLeaderInfo ahead, DriveItemVector& lfLinks, double& myStopDist, std::pair<double, const MSLink*>& myNextTurn) const;
+    /** @brief fills lfLinks with the drive items for the look-ahead distance
+     * @param[in] ahead The leaders on the current lane (the leaders on the following lanes are retrieved from the lanes)
+     * @param[out] lfLinks The drive items, the vector is cleared first (its capacity is reused)
+     */
+    void planMoveInternal(const SUMOTime t, const MSLeaderInfo& ahead, DriveItemVector& lfLinks, double& myStopDist, std::pair<double, const MSLink*>& myNextTurn) const;
 
     /// @brief runs heuristic for keeping the intersection clear in case of downstream jamming
     void checkRewindLinkLanes(const double lengthsInFront, DriveItemVector& lfLinks) const;
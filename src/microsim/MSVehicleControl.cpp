@@ -241,6 +241,7 @@ MSVehicleControl::clearState(const bool reinit) {
         delete item.second;
     }
     myVehicleDict.clear();
+    myVehicleIndex.clear();
     // delete vehicle type distributions
     for (const auto& item : myVTypeDistDict) {
         delete item.second;
@@ -274,10 +275,9 @@ MSVehicleControl::clearState(const bool reinit) {
 
 bool
 MSVehicleControl::addVehicle(const std::string& id, SUMOVehicle* v) {
-    VehicleDictType::iterator it = myVehicleDict.find(id);
-    if (it == myVehicleDict.end()) {
+    if (myVehicleIndex.insert(std::make_pair(id, v)).second) {
         // id not in myVehicleDict.
-        myVehicleDict[id] = v;
+        myVehicleDict.insert(myVehicleDict.end(), std::make_pair(id, v));
         handleTriggeredDepart(v, true);
         const SUMOVehicleParameter& pars = v->getParameter();
         if (v->getVClass() != SVC_TAXI && pars.line != "" && pars.repetitionNumber < 0) {
@@ -323,8 +323,8 @@ MSVehicleControl::handleTriggeredDepart(SUMOVehicle* v, bool add) {
 
 SUMOVehicle*
 MSVehicleControl::getVehicle(const std::string& id) const {
-    VehicleDictType::const_iterator it = myVehicleDict.find(id);
-    if (it == myVehicleDict.end()) {
+    const auto it = myVehicleIndex.find(id);
+    if (it == myVehicleIndex.end()) {
         return nullptr;
     }
     return it->second;
@@ -339,6 +339,7 @@ MSVehicleControl::deleteVehicle(SUMOVehicle* veh, bool discard) {
     }
     if (veh != nullptr) {
         myVehicleDict.erase(veh->getID());
+        myVehicleIndex.erase(veh->getID());
     }
     auto ptVehIt = std::find(myPTVehicles.begin(), myPTVehicles.end(), veh);
     if (ptVehIt != myPTVehicles.end()) {
@@ -26,6 +26,7 @@
 #include <string>
 #include <map>
 #include <set>
+#include <unordered_map>
 #ifdef HAVE_FOX
 #include <utils/foxtools/fxheader.h>
 #include <utils/foxtools/MFXSynchQue.h>
@@ -634,6 +635,8 @@ protected:
     typedef std::map< std::string, SUMOVehicle* > VehicleDictType;
     /// @brief Dictionary of vehicles
     VehicleDictType myVehicleDict;
+    /// @brief Hash index of myVehicleDict for the lookup by id (the dictionary keeps the sorted iteration)
+    std::unordered_map<std::string, SUMOVehicle*> myVehicleIndex;
     /// @}
 
 
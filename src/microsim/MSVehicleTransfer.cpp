@@ -21,8 +21,10 @@
 /****************************************************************************/
 #include <config.h>
 
+#include <algorithm>
 #include <iostream>
 #include <utils/common/MsgHandler.h>
+#include <utils/options/OptionsCont.h>
 #include <utils/xml/SUMOSAXAttributes.h>
 #include "MSNet.h"
 #include "MSLane.h"
@@ -95,111 +97,126 @@ void
 MSVehicleTransfer::checkInsertions(SUMOTime time) {
     // go through vehicles
     auto& vehInfos = myVehicles.getContainer();
-    std::sort(vehInfos.begin(), vehInfos.end());
-    for (auto i = vehInfos.begin(); i != vehInfos.end();) {
-        // vehicle information cannot be const because we need to assign the proceed time
-        VehicleInformation& desc = *i;
+    // the vehicles added since the last call are appended, so only these need sorting
+    const auto unsorted = std::is_sorted_until(vehInfos.begin(), vehInfos.end());
+    std::sort(unsorted, vehInfos.end());
+    std::inplace_merge(vehInfos.begin(), unsorted, vehInfos.end());
+    // keep the remaining vehicles in one pass instead of erasing the finished ones individually
+    auto kept = vehInfos.begin();
+    for (auto i = vehInfos.begin(); i != vehInfos.end(); ++i) {
+        if (!checkInsertion(*i, time)) {
+            if (kept != i) {
+                *kept = *i;
+            }
+            ++kept;
+        }
+    }
+    vehInfos.erase(kept, vehInfos.end());
+    myVehicles.unlock();
+}
 
-        if (desc.myParking) {
-            // handle parking vehicles
-            if (time != desc.myTransferTime) {
-                // avoid calling processNextStop twice in the transfer step
-                const MSLane* lane = desc.myVeh->getLane();
-                // lane must be locked because pedestrians may be added in during stop processing while existing passengers are being drawn simultaneously
-                if (lane != nullptr) {
-                    lane->getVehiclesSecure();
-                }
-                desc.myVeh->processNextStop(1);
-                desc.myVeh->updateParkingState();
-                if (lane != nullptr) {
-                    lane->releaseVehicles();
-                }
+
+bool
+MSVehicleTransfer::checkInsertion(VehicleInformation& desc, SUMOTime time) {
+    if (desc.myParking) {
+        // handle parking vehicles
+        if (time != desc.myTransferTime) {
+            // avoid calling processNextStop twice in the transfer step
+            const MSLane* lane = desc.myVeh->getLane();
+            // lane must be locked because pedestrians may be added in during stop processing while existing passengers are being drawn simultaneously
+            if (lane != nullptr) {
+                lane->getVehiclesSecure();
             }
-            if (desc.myVeh->keepStopping(true)) {
-                i++;
-                continue;
+            desc.myVeh->processNextStop(1);
+            desc.myVeh->updateParkingState();
+            if (lane != nullptr) {
+                lane->releaseVehicles();
             }
-            // parking finished, head back into traffic
         }
-        const SUMOVehicleClass vclass = desc.myVeh->getVehicleType().getVehicleClass();
-        const MSEdge* e = desc.myVeh->getEdge();
-        const MSEdge* nextEdge = desc.myVeh->succEdge(1);
+        if (desc.myVeh->keepStopping(true)) {
+            if (!desc.myDormant && myDormantThreshold >= 0 && time - desc.myTransferTime >= myDormantThreshold) {
+                desc.myVeh->compactParkingState();
+                desc.myDormant = true;
+            }
+            return false;
+        }
+        // parking finished, head back into traffic
+    }
+    const SUMOVehicleClass vclass = desc.myVeh->getVehicleType().getVehicleClass();
+    const MSEdge* e = desc.myVeh->getEdge();
+    const MSEdge* nextEdge = desc.myVeh->succEdge(1);
 
 
-        if (desc.myParking) {
-            MSParkingArea* pa = desc.myVeh->getCurrentParkingArea();
-            const double departPos = pa != nullptr ? pa->getInsertionPosition(*desc.myVeh) : desc.myVeh->getPositionOnLane();
-            // handle parking vehicles
-            desc.myVeh->setIdling(true);
-            if (desc.myVeh->getMutableLane()->isInsertionSuccess(desc.myVeh, 0, departPos, desc.myVeh->getLateralPositionOnLane(),
-                    false, MSMoveReminder::NOTIFICATION_PARKING)) {
-                MSNet::getInstance()->informVehicleStateListener(desc.myVeh, MSNet::VehicleState::ENDING_PARKING);
-                desc.myVeh->getMutableLane()->removeParking(desc.myVeh);
-                // at this point we are in the lane, blocking traffic & if required we configure the exit manoeuvre
-                if (MSGlobals::gModelParkingManoeuver && desc.myVeh->setExitManoeuvre()) {
-                    MSNet::getInstance()->informVehicleStateListener(desc.myVeh, MSNet::VehicleState::MANEUVERING);
-                }
-                desc.myVeh->setIdling(false);
-                i = vehInfos.erase(i);
-            } else {
-                // blocked from entering the road - engine assumed to be idling.
-                desc.myVeh->workOnIdleReminders();
-                if (!desc.myVeh->signalSet(MSVehicle::VEH_SIGNAL_BLINKER_LEFT | MSVehicle::VEH_SIGNAL_BLINKER_RIGHT)) {
-                    // signal wish to re-enter the road
-                    desc.myVeh->switchOnSignal(MSGlobals::gLefthand ? MSVehicle::VEH_SIGNAL_BLINKER_RIGHT : MSVehicle::VEH_SIGNAL_BLINKER_LEFT);
-                    if (pa) {
-                        // update freePosition so other vehicles can help with insertion
-                        desc.myVeh->getCurrentParkingArea()->notifyEgressBlocked();
-                    }
-                }
-                i++;
+    if (desc.myParking) {
+        MSParkingArea* pa = desc.myVeh->getCurrentParkingArea();
+        const double departPos = pa != nullptr ? pa->getInsertionPosition(*desc.myVeh) : desc.myVeh->getPositionOnLane();
+        // handle parking vehicles
+        desc.myVeh->setIdling(true);
+        if (desc.myVeh->getMutableLane()->isInsertionSuccess(desc.myVeh, 0, departPos, desc.myVeh->getLateralPositionOnLane(),
+                false, MSMoveReminder::NOTIFICATION_PARKING)) {
+            MSNet::getInstance()->informVehicleStateListener(desc.myVeh, MSNet::VehicleState::ENDING_PARKING);
+            desc.myVeh->getMutableLane()->removeParking(desc.myVeh);
+            // at this point we are in the lane, blocking traffic & if required we configure the exit manoeuvre
+            if (MSGlobals::gModelParkingManoeuver && desc.myVeh->setExitManoeuvre()) {
+                MSNet::getInstance()->informVehicleStateListener(desc.myVeh, MSNet::VehicleState::MANEUVERING);
             }
-        } else if (desc.myJumping && desc.myProceedTime > time) {
-            ++i;
+            desc.myVeh->setIdling(false);
+            return true;
         } else {
-            const double departPos = 0;
-            // get the lane on which this vehicle should continue
-            // first select all the lanes which allow continuation onto nextEdge
-            //   then pick the one which is least occupied
-            MSLane* l = (nextEdge != nullptr ? e->getFreeLane(e->allowedLanes(*nextEdge, vclass), vclass, departPos) :
-                         e->getFreeLane(nullptr, vclass, departPos));
-            // handle teleporting vehicles, lane may be 0 because permissions were modified by a closing rerouter or TraCI
-            const bool busyBidi = l != nullptr && l->getBidiLane() != nullptr && l->getBidiLane()->getVehicleNumberWithPartials() > 0;
-            if (l != nullptr && !busyBidi && l->freeInsertion(*(desc.myVeh), MIN2(l->getSpeedLimit(), desc.myVeh->getMaxSpeed()), 0, MSMoveReminder::NOTIFICATION_TELEPORT)) {
-                if (!desc.myJumping) {
-                    WRITE_WARNINGF(TL("Vehicle '%' ends teleporting on edge '%', time=%."), desc.myVeh->getID(), e->getID(), time2string(time));
+            // blocked from entering the road - engine assumed to be idling.
+            desc.myVeh->workOnIdleReminders();
+            if (!desc.myVeh->signalSet(MSVehicle::VEH_SIGNAL_BLINKER_LEFT | MSVehicle::VEH_SIGNAL_BLINKER_RIGHT)) {
+                // signal wish to re-enter the road
+                desc.myVeh->switchOnSignal(MSGlobals::gLefthand ? MSVehicle::VEH_SIGNAL_BLINKER_RIGHT : MSVehicle::VEH_SIGNAL_BLINKER_LEFT);
+                if (pa) {
+                    // update freePosition so other vehicles can help with insertion
+                    desc.myVeh->getCurrentParkingArea()->notifyEgressBlocked();
                 }
-                MSNet::getInstance()->informVehicleStateListener(desc.myVeh, MSNet::VehicleState::ENDING_TELEPORT);
-                i = vehInfos.erase(i);
-            } else {
-                // vehicle is visible while show-route is active. Make it's state more obvious
-                desc.myVeh->computeAngle();
-                desc.myVeh->setLateralPositionOnLane(-desc.myVeh->getLane()->getWidth() / 2);
-                desc.myVeh->invalidateCachedPosition();
-                // could not insert. maybe we should proceed in virtual space
-                if (desc.myProceedTime < 0) {
-                    // initialize proceed time (delayed to avoid lane-order dependency in executeMove)
-                    desc.myProceedTime = time + TIME2STEPS(e->getCurrentTravelTime(TeleportMinSpeed));
-                } else if (desc.myProceedTime < time) {
-                    if (desc.myVeh->succEdge(1) == nullptr) {
-                        WRITE_WARNINGF(TL("Vehicle '%' teleports beyond arrival edge '%', time=%."), desc.myVeh->getID(), e->getID(), time2string(time));
-                        desc.myVeh->leaveLane(MSMoveReminder::NOTIFICATION_TELEPORT_ARRIVED);
-                        MSNet::getInstance()->getVehicleControl().scheduleVehicleRemoval(desc.myVeh);
-                        i = vehInfos.erase(i);
-                        continue;
-                    }
-                    // let the vehicle move to the next edge
-                    desc.myVeh->leaveLane(MSMoveReminder::NOTIFICATION_TELEPORT_CONTINUATION);
-                    // active move reminders (i.e. rerouters)
-                    desc.myVeh->enterLaneAtMove(desc.myVeh->succEdge(1)->getLanes()[0], true);
-                    // use current travel time to determine when to move the vehicle forward
-                    desc.myProceedTime = time + TIME2STEPS(e->getCurrentTravelTime(TeleportMinSpeed));
+            }
+        }
+    } else if (desc.myJumping && desc.myProceedTime > time) {
+        return false;
+    } else {
+        const double departPos = 0;
+        // get the lane on which this vehicle should continue
+        // first select all the lanes which allow continuation onto nextEdge
+        //   then pick the one which is least occupied
+        MSLane* l = (nextEdge != nullptr ? e->getFreeLane(e->allowedLanes(*nextEdge, vclass), vclass, departPos) :
+                     e->getFreeLane(nullptr, vclass, departPos));
+        // handle teleporting vehicles, lane may be 0 because permissions were modified by a closing rerouter or TraCI
+        const bool busyBidi = l != nullptr && l->getBidiLane() != nullptr && l->getBidiLane()->getVehicleNumberWithPartials() > 0;
+        if (l != nullptr && !busyBidi && l->freeInsertion(*(desc.myVeh), MIN2(l->getSpeedLimit(), desc.myVeh->getMaxSpeed()), 0, MSMoveReminder::NOTIFICATION_TELEPORT)) {
+            if (!desc.myJumping) {
+                WRITE_WARNINGF(TL("Vehicle '%' ends teleporting on edge '%', time=%."), desc.myVeh->getID(), e->getID(), time2string(time));
+            }
+            MSNet::getInstance()->informVehicleStateListener(desc.myVeh, MSNet::VehicleState::ENDING_TELEPORT);
+            return true;
+        } else {
+            // vehicle is visible while show-route is active. Make it's state more obvious
+            desc.myVeh->computeAngle();
+            desc.myVeh->setLateralPositionOnLane(-desc.myVeh->getLane()->getWidth() / 2);
+            desc.myVeh->invalidateCachedPosition();
+            // could not insert. maybe we should proceed in virtual space
+            if (desc.myProceedTime < 0) {
+                // initialize proceed time (delayed to avoid lane-order dependency in executeMove)
+                desc.myProceedTime = time + TIME2STEPS(e->getCurrentTravelTime(TeleportMinSpeed));
+            } else if (desc.myProceedTime < time) {
+                if (desc.myVeh->succEdge(1) == nullptr) {
+                    WRITE_WARNINGF(TL("Vehicle '%' teleports beyond arrival edge '%', time=%."), desc.myVeh->getID(), e->getID(), time2string(time));
+                    desc.myVeh->leaveLane(MSMoveReminder::NOTIFICATION_TELEPORT_ARRIVED);
+                    MSNet::getInstance()->getVehicleControl().scheduleVehicleRemoval(desc.myVeh);
+                    return true;
                 }
-                ++i;
+                // let the vehicle move to the next edge
+                desc.myVeh->leaveLane(MSMoveReminder::NOTIFICATION_TELEPORT_CONTINUATION);
+                // active move reminders (i.e. rerouters)
+                desc.myVeh->enterLaneAtMove(desc.myVeh->succEdge(1)->getLanes()[0], true);
+                // use current travel time to determine when to move the vehicle forward
+                desc.myProceedTime = time + TIME2STEPS(e->getCurrentTravelTime(TeleportMinSpeed));
             }
         }
     }
-    myVehicles.unlock();
+    return false;
 }
 
 
@@ -212,7 +229,9 @@ MSVehicleTransfer::getInstance() {
 }
 
 
-MSVehicleTransfer::MSVehicleTransfer() : myVehicles(MSGlobals::gNumSimThreads > 1) {}
+MSVehicleTransfer::MSVehicleTransfer() :
+    myVehicles(MSGlobals::gNumSimThreads > 1),
+    myDormantThreshold(string2time(OptionsCont::getOptions().getString("parking.dormant-threshold"))) {}
 
 
 MSVehicleTransfer::~MSVehicleTransfer() {
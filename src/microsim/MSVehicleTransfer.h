@@ -134,6 +134,8 @@ protected:
         bool myParking;
         /// @brief whether the vehicle is or was jumping
         bool myJumping;
+        /// @brief whether the look-ahead data of the parking vehicle was released
+        bool myDormant = false;
 
         /** @brief Constructor
          * @param[in] veh The teleported vehicle
@@ -147,10 +149,21 @@ protected:
         bool operator<(const VehicleInformation& v2) const;
     };
 
+    /** @brief Tries to insert the given vehicle or moves it virtually
+     *
+     * @param[in] desc The information about the vehicle (the proceed time may be updated)
+     * @param[in] time The current simulation time
+     * @return Whether the vehicle left the transfer
+     */
+    bool checkInsertion(VehicleInformation& desc, SUMOTime time);
+
 
     /// @brief The information about stored vehicles to move virtually
     MFXSynchQue<VehicleInformation, std::vector<VehicleInformation> > myVehicles;
 
+    /// @brief The parking time after which the look-ahead data of a vehicle is released (-1 for never)
+    const SUMOTime myDormantThreshold;
+
     /// @brief The static singleton-instance
     static MSVehicleTransfer* myInstance;
 
@@ -77,6 +77,7 @@ MSVehicleType::MSVehicleType(const SUMOVTypeParameter& parameter) :
         myParameter.actionStepLength = MSGlobals::gActionStepLength;
     }
     myCachedActionStepLengthSecs = STEPS2TIME(myParameter.actionStepLength);
+    updateModelParams();
 }
 
 
@@ -286,6 +287,52 @@ MSVehicleType::setImpatience(const double impatience) {
 }
 
 
+const MSVehicleType::DeviceAssignment&
+MSVehicleType::getDeviceAssignment(const int index, const std::string& parameterKey, const std::string& probabilityKey) const {
+    if (index >= (int)myDeviceAssignments.size()) {
+        myDeviceAssignments.resize(index + 1);
+    }
+    DeviceAssignment& da = myDeviceAssignments[index];
+    if (!da.initialized) {
+        if (myParameter.knowsParameter(parameterKey)) {
+            da.byParameter = StringUtils::toBool(myParameter.getParameter(parameterKey, "false")) ? 1 : 0;
+        } else if (myParameter.knowsParameter(probabilityKey)) {
+            da.probabilityGiven = true;
+            da.probability = StringUtils::toDouble(myParameter.getParameter(probabilityKey, "0"));
+        }
+        da.initialized = true;
+    }
+    return da;
+}
+
+
+void
+MSVehicleType::setJMParam(const SumoXMLAttr attr, const std::string& value) {
+    myParameter.jmParameter[attr] = value;
+    updateModelParams();
+}
+
+
+void
+MSVehicleType::updateModelParams() {
+    const ModelParams defaults;
+    myModelParams.jmStoplineGap = myParameter.getJMParam(SUMO_ATTR_JM_STOPLINE_GAP, defaults.jmStoplineGap);
+    myModelParams.jmDriveRedSpeed = myParameter.getJMParam(SUMO_ATTR_JM_DRIVE_RED_SPEED, defaults.jmDriveRedSpeed);
+    myModelParams.jmTimegapMinor = myParameter.getJMParam(SUMO_ATTR_JM_TIMEGAP_MINOR, defaults.jmTimegapMinor);
+    myModelParams.jmSigmaMinor = myParameter.getJMParam(SUMO_ATTR_JM_SIGMA_MINOR, defaults.jmSigmaMinor);
+    myModelParams.jmCrossingGap = myParameter.getJMParam(SUMO_ATTR_JM_CROSSING_GAP, defaults.jmCrossingGap);
+    myModelParams.jmIgnoreFoeProb = myParameter.getJMParam(SUMO_ATTR_JM_IGNORE_FOE_PROB, defaults.jmIgnoreFoeProb);
+    myModelParams.jmIgnoreFoeSpeed = myParameter.getJMParam(SUMO_ATTR_JM_IGNORE_FOE_SPEED, defaults.jmIgnoreFoeSpeed);
+    myModelParams.jmIgnoreJunctionFoeProb = myParameter.getJMParam(SUMO_ATTR_JM_IGNORE_JUNCTION_FOE_PROB, defaults.jmIgnoreJunctionFoeProb);
+    myModelParams.jmIgnoreKeepClearTime = myParameter.getJMParam(SUMO_ATTR_JM_IGNORE_KEEPCLEAR_TIME, defaults.jmIgnoreKeepClearTime);
+    myModelParams.jmDriveAfterRedTime = myParameter.getJMParam(SUMO_ATTR_JM_DRIVE_AFTER_RED_TIME, defaults.jmDriveAfterRedTime);
+    myModelParams.jmDriveAfterYellowTime = myParameter.getJMParam(SUMO_ATTR_JM_DRIVE_AFTER_YELLOW_TIME, defaults.jmDriveAfterYellowTime);
+    const SUMOVTypeParameter::SubParams& lcParams = myParameter.getLCParams();
+    myModelParams.lcHasSpeedLatDependency = (lcParams.count(SUMO_ATTR_LCA_MAXSPEEDLATSTANDING) != 0
+                                            || lcParams.count(SUMO_ATTR_LCA_MAXSPEEDLATFACTOR) != 0);
+}
+
+
 void
 MSVehicleType::setBoardingDuration(SUMOTime duration, bool isPerson) {
     if (myOriginalType != nullptr && duration < 0) {
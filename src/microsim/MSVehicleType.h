@@ -26,6 +26,7 @@
 #include <cassert>
 #include <map>
 #include <string>
+#include <vector>
 #include <microsim/cfmodels/MSCFModel.h>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/StdDefs.h>
@@ -62,6 +63,47 @@ class SUMOVTypeParameter;
  */
 class MSVehicleType {
 public:
+    /** @struct ModelParams
+     * @brief Junction and lane change model parameters which are needed every step
+     *
+     * The values are parsed once from the string valued parameter maps. Values
+     *  without a common default are INVALID_DOUBLE if they were not given.
+     */
+    struct ModelParams {
+        /// @brief jmStoplineGap (INVALID_DOUBLE if not given)
+        double jmStoplineGap = INVALID_DOUBLE;
+        /// @brief jmDriveRedSpeed (INVALID_DOUBLE if not given)
+        double jmDriveRedSpeed = INVALID_DOUBLE;
+        /// @brief jmTimegapMinor (INVALID_DOUBLE if not given)
+        double jmTimegapMinor = INVALID_DOUBLE;
+        /// @brief jmSigmaMinor (INVALID_DOUBLE if not given)
+        double jmSigmaMinor = INVALID_DOUBLE;
+        double jmCrossingGap = 10;
+        double jmIgnoreFoeProb = 0;
+        double jmIgnoreFoeSpeed = 0;
+        double jmIgnoreJunctionFoeProb = 0;
+        double jmIgnoreKeepClearTime = -1;
+        double jmDriveAfterRedTime = -1;
+        double jmDriveAfterYellowTime = 0;
+        /// @brief whether lcMaxSpeedLatStanding or lcMaxSpeedLatFactor were given
+        bool lcHasSpeedLatDependency = false;
+    };
+
+    /** @struct DeviceAssignment
+     * @brief The equipment with a device as given by the parameters of the type
+     * @see MSDevice::equippedByDefaultAssignmentOptions
+     */
+    struct DeviceAssignment {
+        /// @brief whether the values were parsed already
+        bool initialized = false;
+        /// @brief the value of has.<device>.device (-1 if not given)
+        int byParameter = -1;
+        /// @brief whether device.<device>.probability is given
+        bool probabilityGiven = false;
+        /// @brief the value of device.<device>.probability
+        double probability = 0;
+    };
+
     /** @brief Constructor.
      *
      * @param[in] parameter The vehicle type's parameter
@@ -610,6 +652,29 @@ public:
         return myParameter;
     }
 
+    /// @brief Returns the parsed model parameters needed every step
+    const ModelParams& getModelParams() const {
+        return myModelParams;
+    }
+
+    /** @brief Returns the device equipment given by the type parameters, parsing them on first access
+     * @param[in] index The index of the device (see MSDevice::getDefaultAssignment)
+     * @param[in] parameterKey The key of the has.<device>.device parameter
+     * @param[in] probabilityKey The key of the device.<device>.probability parameter
+     */
+    const DeviceAssignment& getDeviceAssignment(const int index, const std::string& parameterKey, const std::string& probabilityKey) const;
+
+    /// @brief discards the parsed device equipment after the parameters were changed
+    void resetDeviceAssignments() {
+        myDeviceAssignments.clear();
+    }
+
+    /** @brief Set a junction model parameter
+     * @param[in] attr The junction model attribute
+     * @param[in] value The new (numerical) value
+     */
+    void setJMParam(const SumoXMLAttr attr, const std::string& value);
+
     /** @brief Checks whether vehicle type parameters may be problematic
      *         (Currently, only the value for the action step length is
      *         compared with the value for the desired headway time.)
@@ -622,9 +687,18 @@ public:
     }
 
 private:
+    /// @brief parses myModelParams from the parameter container
+    void updateModelParams();
+
     /// @brief the parameter container
     SUMOVTypeParameter myParameter;
 
+    /// @brief the parsed model parameters
+    ModelParams myModelParams;
+
+    /// @brief the parsed device equipment by device index
+    mutable std::vector<DeviceAssignment> myDeviceAssignments;
+
     const EnergyParams myEnergyParams;
 
     /// @brief the vtypes actionsStepLength in seconds (cached because needed very often)
@@ -294,6 +294,16 @@ MSCFModel::maxNextSpeed(double speed, const MSVehicle* const /*veh*/) const {
 }
 
 
+void
+MSCFModel::followSpeedBatch(const int n, const MSVehicle* const* vehs, const double* speeds, const double* gaps,
+                            const double* predSpeeds, const double* predMaxDecels, const MSVehicle* const* preds,
+                            double* result, const CalcReason usage) const {
+    for (int i = 0; i < n; i++) {
+        result[i] = followSpeed(vehs[i], speeds[i], gaps[i], predSpeeds[i], predMaxDecels[i], preds == nullptr ? nullptr : preds[i], usage);
+    }
+}
+
+
 double
 MSCFModel::minNextSpeed(double speed, const MSVehicle* const /*veh*/) const {
     if (MSGlobals::gSemiImplicitEulerUpdate) {
@@ -25,6 +25,7 @@
 
 #include <cmath>
 #include <string>
+#include <utils/common/MemoryPool.h>
 #include <utils/common/StdDefs.h>
 #include <utils/common/SUMOTime.h>
 
@@ -59,6 +60,16 @@ public:
     class VehicleVariables {
     public:
         virtual ~VehicleVariables();
+
+        /// @brief allocates the memory of the variables from the memory pool
+        static void* operator new(std::size_t size) {
+            return MemoryPool::allocate(size);
+        }
+
+        /// @brief returns the memory of the variables to the memory pool
+        static void operator delete(void* p, std::size_t size) {
+            MemoryPool::deallocate(p, size);
+        }
     };
 
     /** @brief Constructor
@@ -140,6 +151,25 @@ public:
                                double predMaxDecel, const MSVehicle* const pred = 0, const CalcReason usage = CalcReason::CURRENT) const = 0;
 
 
+    /** @brief Computes the follow speeds (no dawdling) for a batch of vehicles using this model
+     *
+     * The default implementation calls followSpeed for every entry. Models may
+     *  override it to evaluate the whole batch in loops over contiguous arrays.
+     * @param[in] n The number of entries
+     * @param[in] vehs The vehicles (EGO)
+     * @param[in] speeds The vehicles' speeds
+     * @param[in] gaps The (netto) distances to the LEADERs
+     * @param[in] predSpeeds The speeds of the LEADERs
+     * @param[in] predMaxDecels The maximum decelerations of the LEADERs
+     * @param[in] preds The LEADERs (may be nullptr if no leader vehicles are known)
+     * @param[out] result The safe speeds
+     * @param[in] usage What the return value is used for
+     */
+    virtual void followSpeedBatch(const int n, const MSVehicle* const* vehs, const double* speeds, const double* gaps,
+                                  const double* predSpeeds, const double* predMaxDecels, const MSVehicle* const* preds,
+                                  double* result, const CalcReason usage = CalcReason::CURRENT) const;
+
+
     /** @brief Computes the vehicle's safe speed (no dawdling)
      * This method is used during the insertion stage. Whereas the method
      * followSpeed returns the desired speed which may be lower than the safe
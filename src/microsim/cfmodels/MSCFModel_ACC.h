@@ -44,7 +44,7 @@ class MSCFModel_CACC;
 * @brief The ACC car-following model
 * @see MSCFModel
 */
-class MSCFModel_ACC : public MSCFModel {
+class MSCFModel_ACC final : public MSCFModel {
 public:
     /** @brief Constructor
      *  @param[in] vtype the type for which this model is built and also the parameter object to configure this model
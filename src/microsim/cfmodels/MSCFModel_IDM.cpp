@@ -107,6 +107,42 @@ MSCFModel_IDM::followSpeed(const MSVehicle* const veh, double speed, double gap2
 }
 
 
+void
+MSCFModel_IDM::followSpeedBatch(const int n, const MSVehicle* const* vehs, const double* speeds, const double* gaps,
+                                const double* predSpeeds, const double* predMaxDecels, const MSVehicle* const* preds,
+                                double* result, const CalcReason /*usage*/) const {
+    std::vector<double> gap(gaps, gaps + n);
+    std::vector<double> predSpeed(predSpeeds, predSpeeds + n);
+    std::vector<double> desSpeed(n);
+    std::vector<double> headwayTime(n, myHeadwayTime);
+    const double minGap = myType->getMinGap();
+    for (int i = 0; i < n; i++) {
+        const MSVehicle* const veh = vehs[i];
+        applyHeadwayAndSpeedDifferencePerceptionErrors(veh, speeds[i], gap[i], predSpeed[i], predMaxDecels[i], preds == nullptr ? nullptr : preds[i]);
+        desSpeed[i] = MAX2(NUMERICAL_EPS, veh->getLane()->getVehicleMaxSpeed(veh));
+        if (myAdaptationFactor != 1.) {
+            const VehicleVariables* vars = (VehicleVariables*)veh->getCarFollowVariables();
+            headwayTime[i] *= myAdaptationFactor + vars->levelOfService * (1. - myAdaptationFactor);
+        }
+        // gap2pred comes with minGap already subtracted (see _v)
+        gap[i] += minGap;
+        result[i] = speeds[i];
+    }
+    // same computation as _v but with the loops exchanged
+    for (int it = 0; it < myIterations; it++) {
+        for (int i = 0; i < n; i++) {
+            const double newSpeed = result[i];
+            const double delta_v = newSpeed - predSpeed[i];
+            const double s = MAX2(0., newSpeed * headwayTime[i] + newSpeed * delta_v / myTwoSqrtAccelDecel) + minGap;
+            const double g = MAX2(NUMERICAL_EPS, gap[i]);
+            const double acc = myAccel * (1. - pow(newSpeed / desSpeed[i], myDelta) - (s * s) / (g * g));
+            result[i] = MAX2(0.0, newSpeed + ACCEL2SPEED(acc) / myIterations);
+            gap[i] = g - MAX2(0., SPEED2DIST(result[i] - predSpeed[i]) / myIterations);
+        }
+    }
+}
+
+
 double
 MSCFModel_IDM::insertionFollowSpeed(const MSVehicle* const v, double speed, double gap2pred, double predSpeed, double predMaxDecel, const MSVehicle* const pred) const {
     // see definition of s in _v()
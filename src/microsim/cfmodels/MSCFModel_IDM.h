@@ -36,7 +36,7 @@
  * @brief The Intelligent Driver Model (IDM) car-following model
  * @see MSCFModel
  */
-class MSCFModel_IDM : public MSCFModel {
+class MSCFModel_IDM final : public MSCFModel {
 public:
     /** @brief Constructor
      *  @param[in] vtype the type for which this model is built and also the parameter object to configure this model
@@ -101,6 +101,17 @@ public:
                        double predMaxDecel, const MSVehicle* const pred = 0, const CalcReason usage = CalcReason::CURRENT) const;
 
 
+    /** @brief Computes the follow speeds for a batch of vehicles
+     *
+     * The iterations of the model are evaluated for all entries at once so
+     *  that the inner loop runs over contiguous arrays.
+     * @see MSCFModel::followSpeedBatch
+     */
+    void followSpeedBatch(const int n, const MSVehicle* const* vehs, const double* speeds, const double* gaps,
+                          const double* predSpeeds, const double* predMaxDecels, const MSVehicle* const* preds,
+                          double* result, const CalcReason usage = CalcReason::CURRENT) const;
+
+
     /** @brief Computes the vehicle's safe speed for approaching a non-moving obstacle (no dawdling)
      * @param[in] veh The vehicle (EGO)
      * @param[in] gap2pred The (netto) distance to the the obstacle
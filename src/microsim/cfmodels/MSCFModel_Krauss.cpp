@@ -66,9 +66,8 @@ MSCFModel_Krauss::~MSCFModel_Krauss() {}
 
 double
 MSCFModel_Krauss::patchSpeedBeforeLC(const MSVehicle* veh, double vMin, double vMax) const {
-    const double sigma = (veh->passingMinor()
-                          ? veh->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_SIGMA_MINOR, myDawdle)
-                          : myDawdle);
+    const double sigmaMinor = veh->getVehicleType().getModelParams().jmSigmaMinor;
+    const double sigma = (veh->passingMinor() && sigmaMinor != INVALID_DOUBLE ? sigmaMinor : myDawdle);
     double vDawdle;
     if (myDawdleStep > DELTA_T) {
         VehicleVariables* vars = (VehicleVariables*)veh->getCarFollowVariables();
@@ -126,6 +125,32 @@ MSCFModel_Krauss::followSpeed(const MSVehicle* const veh, double speed, double g
     }
 }
 
+void
+MSCFModel_Krauss::followSpeedBatch(const int n, const MSVehicle* const* vehs, const double* speeds, const double* gaps,
+                                   const double* predSpeeds, const double* predMaxDecels, const MSVehicle* const* preds,
+                                   double* result, const CalcReason /*usage*/) const {
+    std::vector<double> vmax(n);
+    for (int i = 0; i < n; i++) {
+        double gap = gaps[i];
+        double predSpeed = predSpeeds[i];
+        applyHeadwayAndSpeedDifferencePerceptionErrors(vehs[i], speeds[i], gap, predSpeed, predMaxDecels[i], preds == nullptr ? nullptr : preds[i]);
+        result[i] = maximumSafeFollowSpeed(gap, speeds[i], predSpeed, predMaxDecels[i]);
+        vmax[i] = maxNextSpeed(speeds[i], vehs[i]);
+    }
+    if (MSGlobals::gSemiImplicitEulerUpdate) {
+        for (int i = 0; i < n; i++) {
+            result[i] = MIN2(result[i], vmax[i]);
+        }
+    } else {
+        // ballistic (see followSpeed)
+        const double emergencyDecel = ACCEL2SPEED(myEmergencyDecel);
+        for (int i = 0; i < n; i++) {
+            result[i] = MAX2(MIN2(result[i], vmax[i]), speeds[i] - emergencyDecel);
+        }
+    }
+}
+
+
 double
 MSCFModel_Krauss::dawdle2(double speed, double sigma, SumoRNG* rng) const {
     if (!MSGlobals::gSemiImplicitEulerUpdate) {
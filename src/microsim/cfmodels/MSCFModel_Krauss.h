@@ -73,6 +73,17 @@ public:
                        double predSpeed, double predMaxDecel, const MSVehicle* const pred = 0, const CalcReason usage = CalcReason::CURRENT) const;
 
 
+    /** @brief Computes the safe speeds for a batch of vehicles
+     *
+     * The safe speeds are computed first and then limited by the
+     *  acceleration bounds in a separate loop over contiguous arrays.
+     * @see MSCFModel::followSpeedBatch
+     */
+    void followSpeedBatch(const int n, const MSVehicle* const* vehs, const double* speeds, const double* gaps,
+                          const double* predSpeeds, const double* predMaxDecels, const MSVehicle* const* preds,
+                          double* result, const CalcReason usage = CalcReason::CURRENT) const;
+
+
     /** @brief Returns the model's name
      * @return The model's name
      * @see MSCFModel::getModelName
@@ -35,7 +35,7 @@
  * @see MSCFModel
  * @see MSCFModel_Krauss
  */
-class MSCFModel_KraussPS : public MSCFModel_Krauss {
+class MSCFModel_KraussPS final : public MSCFModel_Krauss {
 public:
     /** @brief Constructor
      *  @param[in] vtype the type for which this model is built and also the parameter object to configure this model
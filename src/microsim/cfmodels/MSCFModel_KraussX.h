@@ -32,7 +32,7 @@
  * @see MSCFModel
  * @see MSCFModel_Krauss
  */
-class MSCFModel_KraussX : public MSCFModel_Krauss {
+class MSCFModel_KraussX final : public MSCFModel_Krauss {
 public:
     /** @brief Constructor
      *  @param[in] vtype the type for which this model is built and also the parameter object to configure this model
@@ -52,7 +52,8 @@
 // ===========================================================================
 // static member variables
 // ===========================================================================
-std::map<std::string, std::set<std::string> > MSDevice::myExplicitIDs;
+std::map<std::string, MSDevice::DefaultAssignment> MSDevice::myDefaultAssignments[2];
+std::map<std::string, std::pair<bool, std::string> > MSDevice::myOptionParams;
 SumoRNG MSDevice::myEquipmentRNG("deviceEquipment");
 
 // ===========================================================================
@@ -142,6 +143,10 @@ MSDevice::cleanupAll() {
     MSDevice_Tripinfo::cleanup();
     MSDevice_FCD::cleanup();
     MSDevice_Taxi::cleanup();
+    MSDevice_StationFinder::cleanup();
+    myDefaultAssignments[0].clear();
+    myDefaultAssignments[1].clear();
+    myOptionParams.clear();
 }
 
 void
@@ -160,6 +165,29 @@ MSDevice::insertDefaultAssignmentOptions(const std::string& deviceName, const st
 }
 
 
+const MSDevice::DefaultAssignment&
+MSDevice::getDefaultAssignment(const OptionsCont& oc, const std::string& deviceName, const bool isPerson) {
+    std::map<std::string, DefaultAssignment>& assignments = myDefaultAssignments[isPerson ? 1 : 0];
+    auto it = assignments.find(deviceName);
+    if (it == assignments.end()) {
+        const std::string prefix = (isPerson ? "person-device." : "device.") + deviceName;
+        DefaultAssignment da;
+        da.index = (int)(myDefaultAssignments[0].size() + myDefaultAssignments[1].size());
+        da.parameterKey = "has." + deviceName + ".device";
+        da.probabilityKey = prefix + ".probability";
+        da.deterministic = oc.exists(prefix + ".deterministic") && oc.getBool(prefix + ".deterministic");
+        da.probability = oc.exists(prefix + ".probability") ? oc.getFloat(prefix + ".probability") : -1.;
+        da.nameGiven = oc.exists(prefix + ".explicit") && oc.isSet(prefix + ".explicit");
+        if (da.nameGiven) {
+            const std::vector<std::string> idList = oc.getStringVector(prefix + ".explicit");
+            da.explicitIDs.insert(idList.begin(), idList.end());
+        }
+        it = assignments.insert(std::make_pair(deviceName, da)).first;
+    }
+    return it->second;
+}
+
+
 void
 MSDevice::saveState(OutputDevice& /* out */) const {
     WRITE_WARNINGF(TL("Device '%' cannot save state"), getID());
@@ -179,8 +207,13 @@ MSDevice::getStringParam(const SUMOVehicle& v, const OptionsCont& oc, const std:
     } else if (v.getVehicleType().getParameter().knowsParameter(key)) {
         return v.getVehicleType().getParameter().getParameter(key, "");
     } else {
-        if (oc.exists(key) && oc.isSet(key)) {
-            return oc.getValueString(key);
+        auto it = myOptionParams.find(paramName);
+        if (it == myOptionParams.end()) {
+            const bool isSet = oc.exists(key) && oc.isSet(key);
+            it = myOptionParams.insert(std::make_pair(paramName, std::make_pair(isSet, isSet ? oc.getValueString(key) : ""))).first;
+        }
+        if (it->second.first) {
+            return it->second.second;
         } else {
             if (required) {
                 throw ProcessError("Missing parameter '" + key + "' for vehicle '" + v.getID());
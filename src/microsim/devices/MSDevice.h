@@ -31,6 +31,7 @@
 #include <microsim/MSVehicleType.h>
 #include <microsim/MSVehicleControl.h>
 #include <utils/common/Named.h>
+#include <utils/common/PerformanceCounters.h>
 #include <utils/common/StringUtils.h>
 #include <utils/common/UtilExceptions.h>
 #include <utils/options/OptionsCont.h>
@@ -101,11 +102,14 @@ public:
      * @param[in] id The ID of the device
      */
     MSDevice(const std::string& id) : Named(id) {
+        PerformanceCounters::added(PerformanceCounters::DEVICES, sizeof(MSDevice));
     }
 
 
     /// @brief Destructor
-    virtual ~MSDevice() { }
+    virtual ~MSDevice() {
+        PerformanceCounters::removed(PerformanceCounters::DEVICES, sizeof(MSDevice));
+    }
 
 
     /** @brief Called on vehicle deletion to extend tripinfo and other outputs
@@ -181,8 +185,32 @@ protected:
     /// @}
 
 private:
-    /// @brief vehicles which explicitly carry a device, sorted by device, first
-    static std::map<std::string, std::set<std::string> > myExplicitIDs;
+    /// @brief the default assignment options of a device, read once from the options
+    struct DefaultAssignment {
+        /// @brief the index of the device in the type caches (see MSVehicleType::getDeviceAssignment)
+        int index;
+        /// @brief the key of the has.<device>.device parameter
+        std::string parameterKey;
+        /// @brief the key of the device.<device>.probability parameter
+        std::string probabilityKey;
+        /// @brief whether the probability is applied deterministically
+        bool deterministic;
+        /// @brief the probability given by the options (-1 if not given)
+        double probability;
+        /// @brief whether the equipped holders are given by name
+        bool nameGiven;
+        /// @brief the holders which explicitly carry the device
+        std::set<std::string> explicitIDs;
+    };
+
+    /// @brief returns the assignment options of the given device, reading them on first access
+    static const DefaultAssignment& getDefaultAssignment(const OptionsCont& oc, const std::string& deviceName, const bool isPerson);
+
+    /// @brief the assignment options of vehicle (first) and person devices by device name
+    static std::map<std::string, DefaultAssignment> myDefaultAssignments[2];
+
+    /// @brief the device parameters given as options (whether they are set and their value) by parameter name, read on first access
+    static std::map<std::string, std::pair<bool, std::string> > myOptionParams;
 
     /// @brief A random number generator used to choose from vtype/route distributions and computing the speed factors
     static SumoRNG myEquipmentRNG;
@@ -200,48 +228,38 @@ private:
 
 template<class DEVICEHOLDER> bool
 MSDevice::equippedByDefaultAssignmentOptions(const OptionsCont& oc, const std::string& deviceName, DEVICEHOLDER& v, bool outputOptionSet, const bool isPerson) {
-    const std::string prefix = (isPerson ? "person-device." : "device.") + deviceName;
+    const DefaultAssignment& da = getDefaultAssignment(oc, deviceName, isPerson);
     // assignment by number
     bool haveByNumber = false;
     bool numberGiven = false;
-    if (oc.exists(prefix + ".deterministic") && oc.getBool(prefix + ".deterministic")) {
+    if (da.deterministic) {
         numberGiven = true;
-        haveByNumber = MSNet::getInstance()->getVehicleControl().getQuota(oc.getFloat(prefix + ".probability")) == 1;
+        haveByNumber = MSNet::getInstance()->getVehicleControl().getQuota(da.probability) == 1;
     } else {
-        if (oc.exists(prefix + ".probability") && oc.getFloat(prefix + ".probability") >= 0.) {
+        if (da.probability >= 0.) {
             numberGiven = true;
-            haveByNumber = RandHelper::rand(&myEquipmentRNG) < oc.getFloat(prefix + ".probability");
+            haveByNumber = RandHelper::rand(&myEquipmentRNG) < da.probability;
         }
     }
     // assignment by name
-    bool haveByName = false;
-    bool nameGiven = false;
-    if (oc.exists(prefix + ".explicit") && oc.isSet(prefix + ".explicit")) {
-        nameGiven = true;
-        if (myExplicitIDs.find(deviceName) == myExplicitIDs.end()) {
-            myExplicitIDs[deviceName] = std::set<std::string>();
-            const std::vector<std::string> idList = OptionsCont::getOptions().getStringVector(prefix + ".explicit");
-            myExplicitIDs[deviceName].insert(idList.begin(), idList.end());
-        }
-        haveByName = myExplicitIDs[deviceName].count(v.getID()) > 0;
-    }
+    const bool haveByName = da.nameGiven && da.explicitIDs.count(v.getID()) > 0;
     // assignment by abstract parameters
     bool haveByParameter = false;
     bool parameterGiven = false;
-    const std::string key = "has." + deviceName + ".device";
-    if (v.getParameter().knowsParameter(key)) {
+    const MSVehicleType::DeviceAssignment& typeAssignment = v.getVehicleType().getDeviceAssignment(da.index, da.parameterKey, da.probabilityKey);
+    if (v.getParameter().knowsParameter(da.parameterKey)) {
         parameterGiven = true;
-        haveByParameter = StringUtils::toBool(v.getParameter().getParameter(key, "false"));
-    } else if (v.getVehicleType().getParameter().knowsParameter(key)) {
+        haveByParameter = StringUtils::toBool(v.getParameter().getParameter(da.parameterKey, "false"));
+    } else if (typeAssignment.byParameter >= 0) {
         parameterGiven = true;
-        haveByParameter = StringUtils::toBool(v.getVehicleType().getParameter().getParameter(key, "false"));
-    } else if (v.getVehicleType().getParameter().knowsParameter(prefix + ".probability")) {
+        haveByParameter = typeAssignment.byParameter == 1;
+    } else if (typeAssignment.probabilityGiven) {
         // override global options
         numberGiven = true;
-        haveByNumber = RandHelper::rand(&myEquipmentRNG) < StringUtils::toDouble(v.getVehicleType().getParameter().getParameter(prefix + ".probability", "0"));
+        haveByNumber = RandHelper::rand(&myEquipmentRNG) < typeAssignment.probability;
     }
     //std::cout << " deviceName=" << deviceName << " holder=" << v.getID()
-    //    << " nameGiven=" << nameGiven << " haveByName=" << haveByName
+    //    << " nameGiven=" << da.nameGiven << " haveByName=" << haveByName
     //    << " parameterGiven=" << parameterGiven << " haveByParameter=" << haveByParameter
     //    << " numberGiven=" << numberGiven << " haveByNumber=" << haveByNumber
     //    << " outputOptionSet=" << outputOptionSet << "\n";
@@ -252,6 +270,6 @@ MSDevice::equippedByDefaultAssignmentOptions(const OptionsCont& oc, const std::s
     } else if (numberGiven) {
         return haveByNumber;
     } else {
-        return !nameGiven && outputOptionSet;
+        return !da.nameGiven && outputOptionSet;
     }
 }
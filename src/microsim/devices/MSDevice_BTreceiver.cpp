@@ -162,16 +162,19 @@ MSDevice_BTreceiver::BTreceiverUpdate::execute(SUMOTime /*currentTime*/) {
         }
     }
 
-    // build rtree with senders
-    NamedRTree rt;
+    // sort the senders into a grid with cells of the size of the largest range
+    mySenderGrid.clear();
     for (std::map<std::string, MSDevice_BTsender::VehicleInformation*>::const_iterator i = MSDevice_BTsender::sVehicles.begin(); i != MSDevice_BTsender::sVehicles.end(); ++i) {
         MSDevice_BTsender::VehicleInformation* vi = (*i).second;
         Boundary b = vi->getBoxBoundary();
         b.grow(POSITION_EPS);
-        const float cmin[2] = {(float) b.xmin(), (float) b.ymin()};
-        const float cmax[2] = {(float) b.xmax(), (float) b.ymax()};
-        rt.Insert(cmin, cmax, vi);
+        mySenderGrid.add(b, vi);
     }
+    double maxRange = 0.;
+    for (const auto& receiverInfo : MSDevice_BTreceiver::sVehicles) {
+        maxRange = MAX2(maxRange, receiverInfo.second->range);
+    }
+    mySenderGrid.build(2 * maxRange);
 
     // check visibility for all receivers
     OptionsCont& oc = OptionsCont::getOptions();
@@ -182,19 +185,16 @@ MSDevice_BTreceiver::BTreceiverUpdate::execute(SUMOTime /*currentTime*/) {
         MSDevice_BTreceiver::VehicleInformation* vi = (*i).second;
         Boundary b = vi->getBoxBoundary();
         b.grow(vi->range);
-        const float cmin[2] = {(float) b.xmin(), (float) b.ymin()};
-        const float cmax[2] = {(float) b.xmax(), (float) b.ymax()};
-        std::set<const Named*> surroundingVehicles;
-        Named::StoringVisitor sv(surroundingVehicles);
-        rt.Search(cmin, cmax, sv);
+        mySenderGrid.query(b, myNearbySenders);
 
         // loop over surrounding vehicles, check visibility status
-        for (const Named* vehicle : surroundingVehicles) {
-            if ((*i).first == vehicle->getID()) {
+        for (const int senderIndex : myNearbySenders) {
+            MSDevice_BTsender::VehicleInformation* const sender = mySenderGrid.getItem(senderIndex);
+            if ((*i).first == sender->getID()) {
                 // seeing oneself? skip
                 continue;
             }
-            updateVisibility(*vi, *MSDevice_BTsender::sVehicles.find(vehicle->getID())->second);
+            updateVisibility(*vi, *sender);
         }
 
         if (vi->haveArrived) {
@@ -233,7 +233,7 @@ MSDevice_BTreceiver::BTreceiverUpdate::updateVisibility(MSDevice_BTreceiver::Veh
     const MSDevice_BTsender::VehicleState& senderData = sender.updates.back();
     if (!receiver.amOnNet || !sender.amOnNet) {
         // at least one of the vehicles has left the simulation area for any reason
-        if (receiver.currentlySeen.find(sender.getID()) != receiver.currentlySeen.end()) {
+        if (receiver.currentlySeen.find(sender.index) != receiver.currentlySeen.end()) {
             leaveRange(receiver, receiverData, sender, senderData, 0);
         }
     }
@@ -252,13 +252,13 @@ MSDevice_BTreceiver::BTreceiverUpdate::updateVisibility(MSDevice_BTreceiver::Veh
         case 0:
             // no intersections -> other vehicle either stays within or beyond range
             if (receiver.amOnNet && sender.amOnNet && receiverData.position.distanceTo(senderData.position) < receiver.range) {
-                if (receiver.currentlySeen.find(sender.getID()) == receiver.currentlySeen.end()) {
-                    enterRange(0., receiverData, sender.getID(), senderData, receiver.currentlySeen);
+                if (receiver.currentlySeen.find(sender.index) == receiver.currentlySeen.end()) {
+                    enterRange(0., receiverData, sender.index, senderData, receiver.currentlySeen);
                 } else {
-                    addRecognitionPoint(SIMTIME, receiverData, senderData, receiver.currentlySeen[sender.getID()]);
+                    addRecognitionPoint(SIMTIME, receiverData, senderData, receiver.currentlySeen[sender.index]);
                 }
             } else {
-                if (receiver.currentlySeen.find(sender.getID()) != receiver.currentlySeen.end()) {
+                if (receiver.currentlySeen.find(sender.index) != receiver.currentlySeen.end()) {
                     leaveRange(receiver, receiverData, sender, senderData, 0.);
                 }
             }
@@ -269,24 +269,24 @@ MSDevice_BTreceiver::BTreceiverUpdate::updateVisibility(MSDevice_BTreceiver::Veh
             intersection1ReceiverData.position = oldReceiverPosition + receiverDelta * intersections.front();
             MSDevice_BTsender::VehicleState intersection1SenderData(senderData);
             intersection1SenderData.position = oldSenderPosition + senderDelta * intersections.front();
-            if (receiver.currentlySeen.find(sender.getID()) != receiver.currentlySeen.end()) {
+            if (receiver.currentlySeen.find(sender.index) != receiver.currentlySeen.end()) {
                 leaveRange(receiver, intersection1ReceiverData,
                            sender, intersection1SenderData, (intersections.front() - 1.) * TS);
             } else {
                 enterRange((intersections.front() - 1.) * TS, intersection1ReceiverData,
-                           sender.getID(), intersection1SenderData, receiver.currentlySeen);
+                           sender.index, intersection1SenderData, receiver.currentlySeen);
             }
         }
         break;
         case 2:
             // two intersections -> other vehicle enters and leaves the range
-            if (receiver.currentlySeen.find(sender.getID()) == receiver.currentlySeen.end()) {
+            if (receiver.currentlySeen.find(sender.index) == receiver.currentlySeen.end()) {
                 MSDevice_BTsender::VehicleState intersectionReceiverData(receiverData);
                 intersectionReceiverData.position = oldReceiverPosition + receiverDelta * intersections.front();
                 MSDevice_BTsender::VehicleState intersectionSenderData(senderData);
                 intersectionSenderData.position = oldSenderPosition + senderDelta * intersections.front();
                 enterRange((intersections.front() - 1.) * TS, intersectionReceiverData,
-                           sender.getID(), intersectionSenderData, receiver.currentlySeen);
+                           sender.index, intersectionSenderData, receiver.currentlySeen);
                 intersectionReceiverData.position = oldReceiverPosition + receiverDelta * intersections.back();
                 intersectionSenderData.position = oldSenderPosition + senderDelta * intersections.back();
                 leaveRange(receiver, intersectionReceiverData,
@@ -304,11 +304,11 @@ MSDevice_BTreceiver::BTreceiverUpdate::updateVisibility(MSDevice_BTreceiver::Veh
 
 void
 MSDevice_BTreceiver::BTreceiverUpdate::enterRange(double atOffset, const MSDevice_BTsender::VehicleState& receiverState,
-        const std::string& senderID, const MSDevice_BTsender::VehicleState& senderState,
-        std::map<std::string, SeenDevice*>& currentlySeen) {
+        const long long int senderIndex, const MSDevice_BTsender::VehicleState& senderState,
+        std::map<long long int, SeenDevice*>& currentlySeen) {
     MeetingPoint mp(SIMTIME + atOffset, receiverState, senderState);
     SeenDevice* sd = new SeenDevice(mp);
-    currentlySeen[senderID] = sd;
+    currentlySeen[senderIndex] = sd;
     addRecognitionPoint(SIMTIME, receiverState, senderState, sd);
 }
 
@@ -317,7 +317,7 @@ void
 MSDevice_BTreceiver::BTreceiverUpdate::leaveRange(VehicleInformation& receiverInfo, const MSDevice_BTsender::VehicleState& receiverState,
         MSDevice_BTsender::VehicleInformation& senderInfo, const MSDevice_BTsender::VehicleState& senderState,
         double tOffset) {
-    std::map<std::string, SeenDevice*>::iterator i = receiverInfo.currentlySeen.find(senderInfo.getID());
+    std::map<long long int, SeenDevice*>::iterator i = receiverInfo.currentlySeen.find(senderInfo.index);
     // check whether the other was recognized
     addRecognitionPoint(SIMTIME + tOffset, receiverState, senderState, i->second);
     // build leaving point
@@ -27,6 +27,7 @@
 #include <utils/common/SUMOTime.h>
 #include <utils/common/Command.h>
 #include <utils/common/RandHelper.h>
+#include <utils/geom/SpatialGrid.h>
 
 
 // ===========================================================================
@@ -190,7 +191,7 @@ public:
      * @param[in] c The currently seen container to clear
      * @param[in] s The seen container to clear
      */
-    static void cleanUp(std::map<std::string, SeenDevice*>& c, std::map<std::string, std::vector<SeenDevice*> >& s);
+    static void cleanUp(std::map<long long int, SeenDevice*>& c, std::map<std::string, std::vector<SeenDevice*> >& s);
 
     static SumoRNG* getRecognitionRNG() {
         return &sRecognitionRNG;
@@ -235,7 +236,7 @@ protected:
 
         /// @brief Destructor
         ~VehicleInformation() {
-            std::map<std::string, SeenDevice*>::iterator i;
+            std::map<long long int, SeenDevice*>::iterator i;
             for (i = currentlySeen.begin(); i != currentlySeen.end(); i++) {
                 delete i->second;
             }
@@ -251,8 +252,8 @@ protected:
         /// @brief Recognition range of the vehicle
         const double range;
 
-        /// @brief The map of devices seen by the vehicle at removal time
-        std::map<std::string, SeenDevice*> currentlySeen;
+        /// @brief The map of devices seen by the vehicle at removal time (by the index of the sender information)
+        std::map<long long int, SeenDevice*> currentlySeen;
 
         /// @brief The past episodes of removed vehicle
         std::map<std::string, std::vector<SeenDevice*> > seen;
@@ -296,13 +297,13 @@ protected:
         /** @brief Informs the receiver about a sender entering it's radius
          * @param[in] atOffset The time offset to the current time step
          * @param[in] receiverState The position, speed, lane etc. the observer had at the time
-         * @param[in] senderID The ID of the entering sender
+         * @param[in] senderIndex The index of the entering sender's information
          * @param[in] senderState The position, speed, lane etc. the seen vehicle had at the time
          * @param[in] currentlySeen The container storing episodes
          */
         void enterRange(double atOffset, const MSDevice_BTsender::VehicleState& receiverState,
-                        const std::string& senderID, const MSDevice_BTsender::VehicleState& senderState,
-                        std::map<std::string, SeenDevice*>& currentlySeen);
+                        const long long int senderIndex, const MSDevice_BTsender::VehicleState& senderState,
+                        std::map<long long int, SeenDevice*>& currentlySeen);
 
 
         /** @brief Removes the sender from the currently seen devices to past episodes
@@ -338,6 +339,12 @@ protected:
         void writeOutput(const std::string& id, const std::map<std::string, std::vector<SeenDevice*> >& seen,
                          bool allRecognitions);
 
+    private:
+        /// @brief The senders sorted into a grid (rebuilt every step)
+        SpatialGrid<MSDevice_BTsender::VehicleInformation*> mySenderGrid;
+
+        /// @brief The senders found near the current receiver
+        std::vector<int> myNearbySenders;
 
 
 
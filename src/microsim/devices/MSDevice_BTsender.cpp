@@ -38,6 +38,7 @@
 // static members
 // ===========================================================================
 std::map<std::string, MSDevice_BTsender::VehicleInformation*> MSDevice_BTsender::sVehicles;
+long long int MSDevice_BTsender::VehicleInformation::myNextIndex = 0;
 
 
 // ===========================================================================
@@ -146,7 +146,7 @@ public:
         /** @brief Constructor
          * @param[in] id The id of the vehicle
          */
-        VehicleInformation(const std::string& id) : Named(id), amOnNet(true), haveArrived(false)  {}
+        VehicleInformation(const std::string& id) : Named(id), index(myNextIndex++), amOnNet(true), haveArrived(false)  {}
 
         /// @brief Destructor
         virtual ~VehicleInformation() {}
@@ -162,6 +162,9 @@ public:
             return ret;
         }
 
+        /// @brief A unique number identifying this information (used as key instead of the id)
+        const long long int index;
+
         /// @brief List of position updates during last step
         std::vector<VehicleState> updates;
 
@@ -174,6 +177,10 @@ public:
         /// @brief List of edges travelled
         ConstMSEdgeVector route;
 
+    private:
+        /// @brief The index of the next created information
+        static long long int myNextIndex;
+
     };
 
 
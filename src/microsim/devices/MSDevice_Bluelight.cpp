@@ -85,7 +85,10 @@ MSDevice_Bluelight::MSDevice_Bluelight(SUMOVehicle& holder, const std::string& i
                                        const double reactionDist, const double minGapFactor) :
     MSVehicleDevice(holder, id),
     myReactionDist(reactionDist),
-    myMinGapFactor(minGapFactor) {
+    myMinGapFactor(minGapFactor),
+    myNearDist(getFloatParam(holder, OptionsCont::getOptions(), "bluelight.near-dist", 12.5, false)),
+    myReactionProbNear(getFloatParam(holder, OptionsCont::getOptions(), "bluelight.reaction-prob-near", 0.577, false)),
+    myReactionProbFar(getFloatParam(holder, OptionsCont::getOptions(), "bluelight.reaction-prob-far", 0.189, false)) {
 #ifdef DEBUG_BLUELIGHT
     std::cout << SIMTIME << " initialized device '" << id << "' with myReactionDist=" << myReactionDist << "\n";
 #endif
@@ -218,10 +221,7 @@ MSDevice_Bluelight::notifyMove(SUMOTrafficObject& veh, double /* oldPos */,
                 //other vehicle should not use the rescue lane so they should not make any lane changes
                 lanechange.setLaneChangeMode(1605);//todo change lane back
                 // the vehicles should react according to the distance to the emergency vehicle taken from real world data
-                double reactionProb = (
-                                          distanceDelta < getFloatParam(myHolder, OptionsCont::getOptions(), "bluelight.near-dist", 12.5, false)
-                                          ? getFloatParam(myHolder, OptionsCont::getOptions(), "bluelight.reaction-prob-near", 0.577, false)
-                                          : getFloatParam(myHolder, OptionsCont::getOptions(), "bluelight.reaction-prob-far", 0.189, false));
+                double reactionProb = distanceDelta < myNearDist ? myReactionProbNear : myReactionProbFar;
                 // todo works only for one second steps
                 //std::cout << SIMTIME << " veh2=" << veh2->getID() << " distanceDelta=" << distanceDelta << " reaction=" << reaction << " reactionProb=" << reactionProb << "\n";
                 if (veh2->isActionStep(SIMSTEP) && reaction < reactionProb * veh2->getActionStepLengthSecs()) {
@@ -241,7 +241,7 @@ MSDevice_Bluelight::notifyMove(SUMOTrafficObject& veh, double /* oldPos */,
                     }
                     t.setPreferredLateralAlignment(align);
                     t.setMinGap(t.getMinGap() * myMinGapFactor);
-                    const_cast<SUMOVTypeParameter&>(t.getParameter()).jmParameter[SUMO_ATTR_JM_STOPLINE_GAP] = toString(myMinGapFactor);
+                    t.setJMParam(SUMO_ATTR_JM_STOPLINE_GAP, toString(myMinGapFactor));
                     // disable strategic lane-changing
 #ifdef DEBUG_BLUELIGHT_RESCUELANE
                     std::cout << SIMTIME << " device=" << getID() << " formingRescueLane=" << veh2->getID()
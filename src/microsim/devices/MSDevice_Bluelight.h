@@ -156,6 +156,13 @@ private:
     /// @brief min gap reduction of other vehicles
     double myMinGapFactor;
 
+    /// @brief the distance below which the near reaction probability applies
+    const double myNearDist;
+
+    /// @brief the reaction probabilities (per second) of near and far vehicles
+    const double myReactionProbNear;
+    const double myReactionProbFar;
+
 private:
     /// @brief Invalidated copy constructor.
     MSDevice_Bluelight(const MSDevice_Bluelight&);
@@ -21,6 +21,7 @@
 /****************************************************************************/
 #include <config.h>
 
+#include <microsim/MSBaseVehicle.h>
 #include <microsim/MSNet.h>
 #include <microsim/MSLane.h>
 #include <microsim/MSStop.h>
@@ -74,16 +75,14 @@ MSDevice_Emissions::~MSDevice_Emissions() {
 
 bool
 MSDevice_Emissions::notifyMove(SUMOTrafficObject& veh, double /*oldPos*/, double /*newPos*/, double newSpeed) {
-    const SUMOEmissionClass c = veh.getVehicleType().getEmissionClass();
-    myEmissions.addScaled(PollutantsInterface::computeAll(c, newSpeed, veh.getAcceleration(), veh.getSlope(), myHolder.getEmissionParameters()), TS);
+    myEmissions.addScaled(static_cast<const MSBaseVehicle&>(myHolder).getAllEmissions(newSpeed, veh.getAcceleration(), veh.getSlope()), TS);
     return true;
 }
 
 
 bool
 MSDevice_Emissions::notifyIdle(SUMOTrafficObject& veh) {
-    const SUMOEmissionClass c = veh.getVehicleType().getEmissionClass();
-    myEmissions.addScaled(PollutantsInterface::computeAll(c, 0., 0., 0., myHolder.getEmissionParameters()), TS);
+    myEmissions.addScaled(static_cast<const MSBaseVehicle&>(myHolder).getAllEmissions(0., 0., 0.), TS);
     return true;
 }
 
@@ -99,8 +98,7 @@ MSDevice_Emissions::notifyMoveInternal(const SUMOTrafficObject& veh,
                                        const double /* meanLengthOnLane */) {
 
     // called by meso (see MSMeanData_Emissions::MSLaneMeanDataValues::notifyMoveInternal)
-    const SUMOEmissionClass c = veh.getVehicleType().getEmissionClass();
-    myEmissions.addScaled(PollutantsInterface::computeAll(c, meanSpeedVehicleOnLane, veh.getAcceleration(), veh.getSlope(), myHolder.getEmissionParameters()), timeOnLane);
+    myEmissions.addScaled(static_cast<const MSBaseVehicle&>(myHolder).getAllEmissions(meanSpeedVehicleOnLane, veh.getAcceleration(), veh.getSlope()), timeOnLane);
 }
 
 
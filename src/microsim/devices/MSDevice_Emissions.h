@@ -104,6 +104,11 @@ public:
         */
     bool notifyMove(SUMOTrafficObject& veh, double oldPos, double newPos, double newSpeed);
 
+    /// @brief the emissions only depend on the holder's state and are summed per device
+    bool isParallelSafe() const {
+        return true;
+    }
+
     /** @brief Computes idling emission values and adds them to the emission sums
         *
         * Idling implied by zero velocity, acceleration and slope
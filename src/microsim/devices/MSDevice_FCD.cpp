@@ -47,6 +47,7 @@ const long long int MSDevice_FCD::myDefaultMask(~(
 // ===========================================================================
 std::set<const MSEdge*> MSDevice_FCD::myEdgeFilter;
 std::vector<PositionVector> MSDevice_FCD::myShape4Filters;
+std::vector<Boundary> MSDevice_FCD::myShape4FilterBoundaries;
 bool MSDevice_FCD::myEdgeFilterInitialized(false);
 bool MSDevice_FCD::myShapeFilterInitialized(false);
 bool MSDevice_FCD::myShapeFilterDesired(false);
@@ -103,8 +104,13 @@ MSDevice_FCD::shapeFilter(const SUMOTrafficObject* veh) {
         buildShapeFilter();
     }
     const MSVehicle* msVeh = dynamic_cast<const MSVehicle*>(veh);
-    for (auto shape : myShape4Filters) {
-        if (shape.around(veh->getPosition()) || ((msVeh != nullptr) && shape.around(msVeh->getBackPosition()))) {
+    const Position front = veh->getPosition();
+    const Position back = msVeh != nullptr ? msVeh->getBackPosition() : Position::INVALID;
+    for (int i = 0; i < (int)myShape4Filters.size(); i++) {
+        // the bounding box check rejects most shapes without the expensive containment test
+        const Boundary& b = myShape4FilterBoundaries[i];
+        const PositionVector& shape = myShape4Filters[i];
+        if ((b.around(front) && shape.around(front)) || (msVeh != nullptr && b.around(back) && shape.around(back))) {
             return true;
         }
     }
@@ -124,6 +130,7 @@ MSDevice_FCD::buildShapeFilter(void) {
                 } else {
                     // store the PositionVector, not reference, as traci can manipulate / detete the polygons
                     myShape4Filters.push_back(loadedShapes.getPolygons().get(attrName)->getShape());
+                    myShape4FilterBoundaries.push_back(myShape4Filters.back().getBoxBoundary());
                 }
             }
             myShapeFilterInitialized = true;
@@ -187,6 +194,7 @@ void
 MSDevice_FCD::cleanup() {
     myEdgeFilter.clear();
     myShape4Filters.clear();
+    myShape4FilterBoundaries.clear();
     myEdgeFilterInitialized = false;
     myShapeFilterInitialized = false;
     myShapeFilterDesired = false;
@@ -64,6 +64,17 @@ public:
      */
     static void buildVehicleDevices(SUMOVehicle& v, std::vector<MSVehicleDevice*>& into);
 
+    /// @brief the state of the vehicle at the time of its last fcd record (see fcd-output.tolerance)
+    struct WrittenState {
+        /// @brief the time of the last record (-1 if nothing was written yet)
+        SUMOTime time = -1;
+        Position pos;
+        double speed = 0.;
+        double angle = 0.;
+        const MSEdge* edge = nullptr;
+        const MSLane* lane = nullptr;
+    };
+
 public:
     /// @brief Destructor.
     ~MSDevice_FCD();
@@ -84,6 +95,11 @@ public:
         return myEdgeFilter;
     }
 
+    /// @brief the state of the holder when it was written last
+    WrittenState& getLastWritten() {
+        return myLastWritten;
+    }
+
     static long long int getWrittenAttributes() {
         return myWrittenAttributes;
     }
@@ -111,6 +127,8 @@ private:
      */
     MSDevice_FCD(SUMOVehicle& holder, const std::string& id);
 
+    /// @brief the state of the holder when it was written last
+    WrittenState myLastWritten;
 
     /// @brief edge filter for FCD output
     static std::set<const MSEdge*> myEdgeFilter;
@@ -118,6 +136,7 @@ private:
 
     /// @brief polygon spatial filter for FCD output
     static std::vector<PositionVector> myShape4Filters;
+    static std::vector<Boundary> myShape4FilterBoundaries;
     static bool myShapeFilterInitialized;
     static bool myShapeFilterDesired;
 
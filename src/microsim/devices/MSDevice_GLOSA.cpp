@@ -81,6 +81,9 @@ MSDevice_GLOSA::MSDevice_GLOSA(SUMOVehicle& holder, const std::string& id, doubl
     myVeh(dynamic_cast<MSVehicle&>(holder)),
     myNextTLSLink(nullptr),
     myDistance(0),
+    mySwitchLink(nullptr),
+    mySwitchPhase(nullptr),
+    mySwitchOffset(0),
     myMinSpeed(minSpeed),
     myRange(range),
     myMaxSpeedFactor(maxSpeedFactor)
@@ -113,7 +116,7 @@ MSDevice_GLOSA::notifyMove(SUMOTrafficObject& /*tObject*/, double oldPos,
                     const double vMax2 = vMax / myVeh.getChosenSpeedFactor() * myMaxSpeedFactor;
                     const double timetoJunction2 = earliest_arrival(myDistance, vMax2);
                     // reaching the signal at yellow might be sufficient
-                    const double yellowSlack = myVeh.getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_DRIVE_AFTER_YELLOW_TIME, 0);
+                    const double yellowSlack = myVeh.getVehicleType().getModelParams().jmDriveAfterYellowTime;
 #ifdef DEBUG_GLOSA
                     if (DEBUG_COND) {
                         std::cout << "  vMax2=" << vMax2 << " ttJ2=" << timetoJunction2 << " yellowSlack=" << yellowSlack << "\n";
@@ -187,20 +190,25 @@ MSDevice_GLOSA::getTimeToSwitch(const MSLink* tlsLink) {
     assert(tlsLink != nullptr);
     const MSTrafficLightLogic* const tl = tlsLink->getTLLogic();
     assert(tl != nullptr);
-    const auto& phases = tl->getPhases();
-    const int n = (int)phases.size();
-    const int cur = tl->getCurrentPhaseIndex();
-    SUMOTime result = tl->getNextSwitchTime() - SIMSTEP;
-    for (int i = 1; i < n; i++) {
-        const auto& phase = phases[(cur + i) % n];
-        const char ls = phase->getState()[tlsLink->getTLIndex()];
-        if ((tlsLink->haveRed() && (ls == 'g' || ls == 'G'))
-                || (tlsLink->haveGreen() && ls != 'g' && ls != 'G')) {
-            break;
+    const MSPhaseDefinition* const curPhase = &tl->getCurrentPhaseDef();
+    if (tlsLink != mySwitchLink || curPhase != mySwitchPhase) {
+        const auto& phases = tl->getPhases();
+        const int n = (int)phases.size();
+        const int cur = tl->getCurrentPhaseIndex();
+        mySwitchLink = tlsLink;
+        mySwitchPhase = curPhase;
+        mySwitchOffset = 0;
+        for (int i = 1; i < n; i++) {
+            const auto& phase = phases[(cur + i) % n];
+            const char ls = phase->getState()[tlsLink->getTLIndex()];
+            if ((tlsLink->haveRed() && (ls == 'g' || ls == 'G'))
+                    || (tlsLink->haveGreen() && ls != 'g' && ls != 'G')) {
+                break;
+            }
+            mySwitchOffset += phase->duration;
         }
-        result += phase->duration;
     }
-    return STEPS2TIME(result);
+    return STEPS2TIME(tl->getNextSwitchTime() - SIMSTEP + mySwitchOffset);
 }
 
 
@@ -29,6 +29,7 @@
 // ===========================================================================
 class SUMOTrafficObject;
 class MSLink;
+class MSPhaseDefinition;
 
 
 // ===========================================================================
@@ -124,8 +125,12 @@ public:
 
 private:
 
-    /// @brief compute time to next (relevant) switch
-    static double getTimeToSwitch(const MSLink* tlsLink);
+    /** @brief compute time to next (relevant) switch
+     *
+     * The durations of the phases following the current one only change when
+     *  the traffic light switches, so their sum is cached until then.
+     */
+    double getTimeToSwitch(const MSLink* tlsLink);
 
     /// @brief return minimum number of seconds to reach the junction
     double earliest_arrival(double speed, double distance);
@@ -158,6 +163,12 @@ private:
     /// @brief the distance to the upcoming traffic light
     double myDistance;
 
+    /// @brief the link and phase for which mySwitchOffset was computed
+    const MSLink* mySwitchLink;
+    const MSPhaseDefinition* mySwitchPhase;
+    /// @brief the duration of the phases between the end of mySwitchPhase and the next relevant switch
+    SUMOTime mySwitchOffset;
+
     /// @brief minimum approach speed towards red light
     double myMinSpeed;
     /// @brief maximum communication range
@@ -84,6 +84,15 @@ MSDevice_Routing::insertOptions(OptionsCont& oc) {
     oc.doRegister("device.rerouting.synchronize", new Option_Bool(false));
     oc.addDescription("device.rerouting.synchronize", "Routing", TL("Let rerouting happen at the same time for all vehicles"));
 
+    oc.doRegister("device.rerouting.route-cache-size", new Option_Integer(-1));
+    oc.addDescription("device.rerouting.route-cache-size", "Routing", TL("The maximum number of cached routes between zones for parallel rerouting (-1 means no limit)"));
+
+    oc.doRegister("device.rerouting.alternatives", new Option_Integer(0));
+    oc.addDescription("device.rerouting.alternatives", "Routing", TL("The number of alternative routes per start edge and destination which are reused by rerouting instead of searching (0 disables them)"));
+
+    oc.doRegister("device.rerouting.alternatives.tolerance", new Option_Float(0.1));
+    oc.addDescription("device.rerouting.alternatives.tolerance", "Routing", TL("The relative increase of the effort of an alternative route up to which it is reused without searching"));
+
     oc.doRegister("device.rerouting.railsignal", new Option_Bool(true));
     oc.addDescription("device.rerouting.railsignal", "Routing", TL("Allow rerouting triggered by rail signals."));
 
@@ -115,6 +124,14 @@ MSDevice_Routing::checkOptions(OptionsCont& oc) {
         WRITE_ERROR(TL("The value for device.rerouting.adaptation-weight must be between 0 and 1!"));
         ok = false;
     }
+    if (oc.getInt("device.rerouting.alternatives") < 0) {
+        WRITE_ERROR(TL("Negative value for device.rerouting.alternatives!"));
+        ok = false;
+    }
+    if (oc.getFloat("device.rerouting.alternatives.tolerance") < 0.) {
+        WRITE_ERROR(TL("Negative value for device.rerouting.alternatives.tolerance!"));
+        ok = false;
+    }
 #ifndef HAVE_FOX
     if (oc.getInt("device.rerouting.threads") > 1) {
         WRITE_ERROR(TL("Parallel routing is only possible when compiled with Fox."));
@@ -275,7 +292,7 @@ SUMOTime
 MSDevice_Routing::wrappedRerouteCommandExecute(SUMOTime currentTime) {
     if (myHolder.isStopped()) {
         myRerouteAfterStop = true;
-    } else {
+    } else if (!MSNet::getInstance()->isBehindRealTime()) {
         reroute(currentTime);
     }
     return myPeriod;
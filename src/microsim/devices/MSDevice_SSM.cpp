@@ -45,6 +45,9 @@
 #include <microsim/MSVehicle.h>
 #include <microsim/MSVehicleControl.h>
 #include <microsim/MSJunctionControl.h>
+#include <microsim/MSEdgeControl.h>
+#include <microsim/MSGlobals.h>
+#include <microsim/output/MSStepProfiler.h>
 #include <microsim/lcmodels/MSAbstractLaneChangeModel.h>
 #include "MSDevice_SSM.h"
 
@@ -190,6 +193,8 @@ std::set<std::string> MSDevice_SSM::myCreatedOutputFiles;
 
 int MSDevice_SSM::myIssuedParameterWarnFlags = 0;
 
+int MSDevice_SSM::myParallel = -1;
+
 const std::set<int> MSDevice_SSM::FOE_ENCOUNTERTYPES({
     ENCOUNTER_TYPE_FOLLOWING_LEADER, ENCOUNTER_TYPE_MERGING_FOLLOWER,
     ENCOUNTER_TYPE_CROSSING_FOLLOWER, ENCOUNTER_TYPE_FOE_ENTERED_CONFLICT_AREA,
@@ -225,6 +230,7 @@ MSDevice_SSM::cleanup() {
     myEdgeFilter.clear();
     myEdgeFilterInitialized = false;
     myEdgeFilterActive = false;
+    myParallel = -1;
 }
 
 
@@ -256,6 +262,8 @@ MSDevice_SSM::insertOptions(OptionsCont& oc) {
     oc.addDescription("device.ssm.write-lane-positions", "SSM Device", TL("Whether to write lanes and their positions for each timestep"));
     oc.doRegister("device.ssm.exclude-conflict-types", new Option_String(""));
     oc.addDescription("device.ssm.exclude-conflict-types", "SSM Device", TL("Which conflicts will be excluded from the log according to the conflict type they have been classified (combination of values in 'ego', 'foe' , '', any numerical valid conflict type code). An empty value will log all and 'ego'/'foe' refer to a certain conflict type subset."));
+    oc.doRegister("device.ssm.parallel", new Option_Bool(false));
+    oc.addDescription("device.ssm.parallel", "SSM Device", TL("Scan the surroundings of all devices in parallel (when running with multiple threads)"));
 }
 
 
@@ -524,6 +532,61 @@ MSDevice_SSM::updateAndWriteOutput() {
     }
 }
 
+void
+MSDevice_SSM::updateAndWriteOutputAll() {
+    if (myParallel < 0) {
+        myParallel = OptionsCont::getOptions().getBool("device.ssm.parallel") && MSGlobals::gNumSimThreads > 1 ? 1 : 0;
+    }
+#ifdef HAVE_FOX
+#ifndef THREAD_POOL
+    if (myParallel == 1 && myInstances->size() > 1) {
+        MFXWorkerThread::Pool& pool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+        // contiguous chunks keep the vehicles of a task close to each other in the id order
+        const int numTasks = MIN2((int)myInstances->size(), 4 * pool.size());
+        const int chunkSize = ((int)myInstances->size() + numTasks - 1) / numTasks;
+        UpdateTask* task = nullptr;
+        for (MSDevice_SSM* const dev : *myInstances) {
+            if (task == nullptr || (int)task->myDevices.size() == chunkSize) {
+                if (task != nullptr) {
+                    pool.add(task);
+                }
+                task = new UpdateTask();
+            }
+            task->myDevices.push_back(dev);
+        }
+        pool.add(task);
+        pool.waitAll();
+        for (MSDevice_SSM* const dev : *myInstances) {
+            if (dev->myHolder.isOnRoad()) {
+                dev->flushConflicts();
+            } else {
+                dev->resetEncounters();
+                dev->flushConflicts(true);
+            }
+        }
+        return;
+    }
+#endif
+#endif
+    for (MSDevice_SSM* const dev : *myInstances) {
+        dev->updateAndWriteOutput();
+    }
+}
+
+
+#ifdef HAVE_FOX
+void
+MSDevice_SSM::UpdateTask::run(MFXWorkerThread* /*context*/) {
+    MSStepProfiler::Scope span("ssmTask");
+    for (MSDevice_SSM* const dev : myDevices) {
+        if (dev->myHolder.isOnRoad()) {
+            dev->update();
+        }
+    }
+}
+#endif
+
+
 void
 MSDevice_SSM::update() {
 #ifdef DEBUG_SSM
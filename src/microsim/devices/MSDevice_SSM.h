@@ -29,6 +29,9 @@
 #include <utils/common/SUMOTime.h>
 #include <utils/iodevices/OutputDevice_File.h>
 #include <utils/geom/Position.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#endif
 
 
 // ===========================================================================
@@ -402,6 +405,13 @@ public:
      */
     void updateAndWriteOutput();
 
+    /** @brief Calls updateAndWriteOutput for all devices
+     *
+     * If device.ssm.parallel is set, the surroundings of all devices are scanned in parallel
+     *  first and the output is written afterwards in the usual order.
+     */
+    static void updateAndWriteOutputAll();
+
     /// @brief try to retrieve the given parameter from this device. Throw exception for unsupported key
     std::string getParameter(const std::string& key) const;
 
@@ -796,6 +806,22 @@ private:
     /// @}
     /// @}
 
+#ifdef HAVE_FOX
+    /**
+     * @class UpdateTask
+     * @brief the task updating a chunk of devices
+     */
+    class UpdateTask : public MFXWorkerThread::Task {
+    public:
+        void run(MFXWorkerThread* /*context*/);
+        /// @brief the devices of this task
+        std::vector<MSDevice_SSM*> myDevices;
+    };
+#endif
+
+    /// @brief whether device updates are done in parallel (-1 if not decided yet)
+    static int myParallel;
+
     /// @brief spatial filter for SSM device output
     static std::set<const MSEdge*> myEdgeFilter;
     static bool myEdgeFilterInitialized;
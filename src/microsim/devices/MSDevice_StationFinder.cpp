@@ -23,6 +23,7 @@
 #include <microsim/MSLane.h>
 #include <microsim/MSStop.h>
 #include <microsim/MSVehicleControl.h>
+#include <microsim/trigger/MSChargingStation.h>
 #include <microsim/output/MSDetectorControl.h>
 #include <utils/options/OptionsCont.h>
 #include <utils/emissions/PollutantsInterface.h>
@@ -33,6 +34,12 @@
 #include "MSDevice_StationFinder.h"
 
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+SpatialGrid<MSStoppingPlace*> MSDevice_StationFinder::myStationGrid;
+
+
 // ===========================================================================
 // method definitions
 // ===========================================================================
@@ -70,14 +77,22 @@ MSDevice_StationFinder::buildVehicleDevices(SUMOVehicle& v, std::vector<MSVehicl
 }
 
 
+void
+MSDevice_StationFinder::cleanup() {
+    myStationGrid.clear();
+}
+
+
 // ---------------------------------------------------------------------------
 // MSDevice_StationFinder-methods
 // ---------------------------------------------------------------------------
 MSDevice_StationFinder::MSDevice_StationFinder(SUMOVehicle& holder)
     : MSVehicleDevice(holder, "stationfinder_" + holder.getID()),
-      myBattery(nullptr), myChargingStation(nullptr) {
+      myBattery(nullptr), myChargingStation(nullptr), myLastSearch(-1) {
     OptionsCont& oc = OptionsCont::getOptions();
     myReserveFactor = getFloatParam(holder, oc, "stationfinder.reserveFactor", 1.1);
+    myRadius = getTimeParam(holder, oc, "stationfinder.radius", TIME2STEPS(180));
+    myRepeatInterval = getTimeParam(holder, oc, "stationfinder.repeat", TIME2STEPS(60));
 }
 
 
@@ -94,31 +109,14 @@ MSDevice_StationFinder::notifyMove(SUMOTrafficObject& /*veh*/, double /*oldPos*/
         const ConstMSEdgeVector remainingRoute(route.begin() + myHolder.getRoutePosition(), route.end());
         const double remainingTime = router.recomputeCosts(remainingRoute, &myHolder, now);
         if (now > myHolder.getDeparture()) {
-            double expectedConsumption = myBattery->getTotalConsumption() / STEPS2TIME(now - myHolder.getDeparture()) * remainingTime;
-            if (expectedConsumption > myBattery->getActualBatteryCapacity() * myReserveFactor) {
-                const MSEdge* const start = myHolder.getEdge();
+            const double consumptionRate = myBattery->getTotalConsumption() / STEPS2TIME(now - myHolder.getDeparture());
+            const double expectedConsumption = consumptionRate * remainingTime;
+            if (expectedConsumption > myBattery->getActualBatteryCapacity() * myReserveFactor
+                    && (myLastSearch < 0 || now - myLastSearch >= myRepeatInterval)) {
                 double minTime = std::numeric_limits<double>::max();
-                MSChargingStation* minStation = nullptr;
                 ConstMSEdgeVector minRoute;
-                // TODO do some form of bulk routing here
-                for (const auto& stop : MSNet::getInstance()->getStoppingPlaces(SUMO_TAG_CHARGING_STATION)) {
-                    ConstMSEdgeVector routeTo;
-                    const MSEdge* const csEdge = &stop.second->getLane().getEdge();
-                    if (router.compute(start, myHolder.getPositionOnLane(), csEdge, stop.second->getBeginLanePosition(), &myHolder, now, routeTo)) {
-                        ConstMSEdgeVector routeFrom;
-                        if (csEdge == route.back() || router.compute(start, &stop.second->getLane().getEdge(), &myHolder, now, routeFrom)) {
-                            if (csEdge != route.back()) {
-                                routeTo.insert(routeTo.end(), routeFrom.begin() + 1, routeFrom.end());
-                            }
-                            const double time = router.recomputeCosts(routeTo, &myHolder, now);
-                            if (time < minTime) {
-                                minTime = time;
-                                minStation = static_cast<MSChargingStation*>(stop.second);
-                                minRoute = routeTo;
-                            }
-                        }
-                    }
-                }
+                MSChargingStation* const minStation = findStation(consumptionRate, minRoute, minTime);
+                myLastSearch = minStation == nullptr ? now : -1;
                 if (minStation != nullptr) {
                     if (myHolder.hasStops()) {
                         WRITE_WARNINGF(TL("Rerouting using station finder removes all upcoming stops for vehicle '%'."), myHolder.getID());
@@ -144,6 +142,72 @@ MSDevice_StationFinder::notifyMove(SUMOTrafficObject& /*veh*/, double /*oldPos*/
 }
 
 
+MSChargingStation*
+MSDevice_StationFinder::findStation(const double consumptionRate, ConstMSEdgeVector& minRoute, double& minTime) {
+    const SUMOTime now = SIMSTEP;
+    const NamedObjectCont<MSStoppingPlace*>& stations = MSNet::getInstance()->getStoppingPlaces(SUMO_TAG_CHARGING_STATION);
+    if (myStationGrid.size() != (int)stations.size()) {
+        myStationGrid.clear();
+        for (const auto& stop : stations) {
+            const MSLane& lane = stop.second->getLane();
+            Boundary b;
+            b.add(lane.geometryPositionAtOffset(stop.second->getBeginLanePosition()));
+            b.add(lane.geometryPositionAtOffset(stop.second->getEndLanePosition()));
+            myStationGrid.add(b, stop.second);
+        }
+        myStationGrid.build(1000.);
+    }
+    // a station cannot be reached faster than driving the air line distance at maximum speed
+    const double radius = STEPS2TIME(myRadius);
+    const double maxDist = radius * myHolder.getMaxSpeed();
+    const double capacity = myBattery->getActualBatteryCapacity();
+    const Position pos = myHolder.getPosition();
+    Boundary searchArea(pos.x() - maxDist, pos.y() - maxDist, pos.x() + maxDist, pos.y() + maxDist);
+    std::vector<int> candidates;
+    myStationGrid.query(searchArea, candidates);
+    std::vector<std::pair<MSStoppingPlace*, ConstMSEdgeVector> > reachable;
+    SUMOAbstractRouter<MSEdge, SUMOVehicle>& router = MSRoutingEngine::getRouterTT(myHolder.getRNGIndex(), myHolder.getVClass());
+    const MSEdge* const start = myHolder.getEdge();
+    // all routes to the stations start at the same place, so the search tree is shared (bulk mode)
+    router.setAutoBulkMode(true);
+    for (const int index : candidates) {
+        MSStoppingPlace* const station = myStationGrid.getItem(index);
+        const double minTravelTime = pos.distanceTo2D(station->getLane().geometryPositionAtOffset(station->getBeginLanePosition())) / myHolder.getMaxSpeed();
+        if (minTravelTime > radius || minTravelTime * consumptionRate > capacity) {
+            continue;
+        }
+        ConstMSEdgeVector routeTo;
+        if (router.compute(start, myHolder.getPositionOnLane(), &station->getLane().getEdge(), station->getBeginLanePosition(), &myHolder, now, routeTo)) {
+            const double time = router.recomputeCosts(routeTo, &myHolder, now);
+            if (time <= radius && time * consumptionRate <= capacity) {
+                reachable.push_back(std::make_pair(station, routeTo));
+            }
+        }
+    }
+    router.setAutoBulkMode(false);
+    MSChargingStation* minStation = nullptr;
+    const ConstMSEdgeVector& route = myHolder.getRoute().getEdges();
+    for (auto& item : reachable) {
+        MSStoppingPlace* const station = item.first;
+        ConstMSEdgeVector& routeTo = item.second;
+        const MSEdge* const csEdge = &station->getLane().getEdge();
+        ConstMSEdgeVector routeFrom;
+        if (csEdge == route.back() || router.compute(csEdge, station->getEndLanePosition(), route.back(), myHolder.getArrivalPos(), &myHolder, now, routeFrom)) {
+            if (csEdge != route.back()) {
+                routeTo.insert(routeTo.end(), routeFrom.begin() + 1, routeFrom.end());
+            }
+            const double time = router.recomputeCosts(routeTo, &myHolder, now);
+            if (time < minTime) {
+                minTime = time;
+                minStation = static_cast<MSChargingStation*>(station);
+                minRoute = routeTo;
+            }
+        }
+    }
+    return minStation;
+}
+
+
 bool
 MSDevice_StationFinder::notifyIdle(SUMOTrafficObject& /*veh*/) {
     return true;
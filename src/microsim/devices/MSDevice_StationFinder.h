@@ -20,12 +20,14 @@
 #pragma once
 #include <config.h>
 
+#include <utils/geom/SpatialGrid.h>
 #include "MSVehicleDevice.h"
 
 
 // ===========================================================================
 // class declarations
 // ===========================================================================
+class MSChargingStation;
 class MSDevice_Battery;
 class MSStoppingPlace;
 
@@ -124,6 +126,9 @@ public:
         myBattery = battery;
     }
 
+    /// @brief forgets the spatial index of the charging stations
+    static void cleanup();
+
 protected:
     /** @brief Internal notification about the vehicle moves, see MSMoveReminder::notifyMoveInternal()
      *
@@ -138,6 +143,19 @@ protected:
                             const double meanLengthOnLane);
 
 private:
+    /** @brief searches the charging station with the fastest route to the destination
+     *
+     * Only stations which can be reached within the search radius and with the
+     *  remaining battery charge (given the average consumption so far) are
+     *  considered. All routes to the stations start at the current position of
+     *  the vehicle and share one search tree.
+     * @param[in] consumptionRate The average consumption per second
+     * @param[out] minRoute The route via the best station
+     * @param[out] minTime The travel time of the route
+     * @return the best station or nullptr if none was found
+     */
+    MSChargingStation* findStation(const double consumptionRate, ConstMSEdgeVector& minRoute, double& minTime);
+
     /// @brief The corresponding battery device
     MSDevice_Battery* myBattery;
 
@@ -147,6 +165,18 @@ private:
     /// @brief To which station we are currently travelling
     MSStoppingPlace* myChargingStation;
 
+    /// @brief The search radius in travel time
+    SUMOTime myRadius;
+
+    /// @brief The time to wait after an unsuccessful search
+    SUMOTime myRepeatInterval;
+
+    /// @brief The time of the last unsuccessful search (or -1)
+    SUMOTime myLastSearch;
+
+    /// @brief The locations of all charging stations (built on the first search)
+    static SpatialGrid<MSStoppingPlace*> myStationGrid;
+
 private:
     /// @brief Invalidated copy constructor.
     MSDevice_StationFinder(const MSDevice_StationFinder&);
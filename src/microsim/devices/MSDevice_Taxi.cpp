@@ -37,6 +37,7 @@
 #include <microsim/trigger/MSTriggeredRerouter.h>
 
 #include "MSDispatch.h"
+#include "MSDispatch_Assignment.h"
 #include "MSDispatch_Greedy.h"
 #include "MSDispatch_GreedyShared.h"
 #include "MSDispatch_RouteExtension.h"
@@ -81,7 +82,7 @@ MSDevice_Taxi::insertOptions(OptionsCont& oc) {
     insertDefaultAssignmentOptions("taxi", "Taxi Device", oc);
 
     oc.doRegister("device.taxi.dispatch-algorithm", new Option_String("greedy"));
-    oc.addDescription("device.taxi.dispatch-algorithm", "Taxi Device", TL("The dispatch algorithm [greedy|greedyClosest|greedyShared|routeExtension|traci]"));
+    oc.addDescription("device.taxi.dispatch-algorithm", "Taxi Device", TL("The dispatch algorithm [greedy|greedyClosest|greedyShared|routeExtension|assignment|traci]"));
 
     oc.doRegister("device.taxi.dispatch-algorithm.output", new Option_FileName());
     oc.addDescription("device.taxi.dispatch-algorithm.output", "Taxi Device", TL("Write information from the dispatch algorithm to FILE"));
@@ -143,6 +144,8 @@ MSDevice_Taxi::initDispatch() {
         myDispatcher = new MSDispatch_GreedyShared(params.getParametersMap());
     } else if (algo == "routeExtension") {
         myDispatcher = new MSDispatch_RouteExtension(params.getParametersMap());
+    } else if (algo == "assignment") {
+        myDispatcher = new MSDispatch_Assignment(params.getParametersMap());
     } else if (algo == "traci") {
         myDispatcher = new MSDispatch_TraCI(params.getParametersMap());
     } else {
@@ -90,7 +90,7 @@ MSDevice_Tripinfo::insertOptions(OptionsCont& oc) {
 void
 MSDevice_Tripinfo::buildVehicleDevices(SUMOVehicle& v, std::vector<MSVehicleDevice*>& into) {
     OptionsCont& oc = OptionsCont::getOptions();
-    const bool enableByOutputOption = oc.isSet("tripinfo-output") || oc.getBool("duration-log.statistics");
+    const bool enableByOutputOption = oc.isSet("tripinfo-output") || oc.getBool("duration-log.statistics") || oc.isSet("ensemble-output");
     if (equippedByDefaultAssignmentOptions(oc, "tripinfo", v, enableByOutputOption)) {
         MSDevice_Tripinfo* device = new MSDevice_Tripinfo(v, "tripinfo_" + v.getID());
         into.push_back(device);
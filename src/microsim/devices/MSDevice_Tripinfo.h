@@ -77,6 +77,14 @@ public:
     /// @brief write statistic output to (xml) file
     static void writeStatistics(OutputDevice& od);
 
+    /// @brief the number of vehicles and walks the statistics were collected for
+    static int getNumVehicles() {
+        return myVehicleCount;
+    }
+    static int getNumWalks() {
+        return myWalkCount;
+    }
+
     /// @brief accessors for GUINet-Parameters
     static double getAvgRouteLength();
     static double getAvgTripSpeed();
@@ -0,0 +1,284 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2007-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSDispatch_Assignment.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// An algorithm that performs dispatch for the taxi device
+/****************************************************************************/
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <utils/geom/Boundary.h>
+#include <microsim/MSNet.h>
+#include <microsim/MSEdge.h>
+#include <microsim/MSEdgeControl.h>
+#include <microsim/MSLane.h>
+#include "MSRoutingEngine.h"
+#include "MSDispatch_Assignment.h"
+
+//#define DEBUG_DISPATCH
+
+
+// ===========================================================================
+// MSDispatch_Assignment methods
+// ===========================================================================
+void
+MSDispatch_Assignment::computeDispatch(SUMOTime now, const std::vector<MSDevice_Taxi*>& fleet) {
+    int numDispatched = 0;
+    int numPostponed = 0;
+    std::vector<MSDevice_Taxi*> available;
+    for (MSDevice_Taxi* taxi : fleet) {
+        if (taxi->isEmpty()) {
+            available.push_back(taxi);
+        }
+    }
+    std::sort(available.begin(), available.end(), MSVehicleDevice::ComparatorNumericalVehicleIdLess());
+    std::vector<Reservation*> reservations;
+    for (Reservation* res : getReservations()) {
+        if (res->recheck <= now) {
+            reservations.push_back(res);
+        } else {
+            numPostponed++;
+        }
+    }
+    std::stable_sort(reservations.begin(), reservations.end(), time_sorter());
+#ifdef DEBUG_DISPATCH
+    std::cout << SIMTIME << " computeDispatch fleet=" << fleet.size() << " available=" << available.size() << " reservations=" << toString(reservations) << "\n";
+#endif
+    if (!available.empty() && !reservations.empty()) {
+        std::vector<Candidate> candidates;
+        findCandidates(reservations, available, candidates);
+        computePickupTimes(now, reservations, available, candidates);
+        // postpone reservations where even the closest taxi would be too early
+        std::vector<SUMOTime> fastest(reservations.size(), SUMOTime_MAX);
+        for (const Candidate& c : candidates) {
+            fastest[c.reservation] = MIN2(fastest[c.reservation], c.pickupTime);
+        }
+        std::vector<Candidate> valid;
+        for (const Candidate& c : candidates) {
+            const Reservation* const res = reservations[c.reservation];
+            if (c.pickupTime <= myMaxPickupTime && res->pickupTime - (now + fastest[c.reservation]) <= myMaximumWaitingTime) {
+                valid.push_back(c);
+            }
+        }
+        for (int i = 0; i < (int)reservations.size(); i++) {
+            Reservation* const res = reservations[i];
+            if (fastest[i] != SUMOTime_MAX && res->pickupTime - (now + fastest[i]) > myMaximumWaitingTime) {
+                res->recheck = MAX2(now + myRecheckTime, res->pickupTime - fastest[i] - myRecheckSafety);
+            }
+        }
+        const std::vector<int> assignment = solveAssignment((int)reservations.size(), (int)available.size(), valid);
+        for (int i = 0; i < (int)reservations.size(); i++) {
+            if (assignment[i] >= 0) {
+#ifdef DEBUG_DISPATCH
+                std::cout << SIMTIME << " dispatch taxi=" << available[assignment[i]]->getHolder().getID() << " person=" << toString(reservations[i]->persons) << "\n";
+#endif
+                available[assignment[i]]->dispatch(*reservations[i]);
+                servedReservation(reservations[i]);
+                numDispatched++;
+            } else {
+                numPostponed++;
+            }
+        }
+    }
+    // check if any taxis are able to service the remaining requests
+    const int numAvailable = (int)available.size() - numDispatched;
+    myHasServableReservations = getReservations().size() > 0 && (numAvailable < (int)fleet.size() || numPostponed > 0 || numDispatched > 0);
+}
+
+
+SUMOAbstractRouter<MSEdge, SUMOVehicle>&
+MSDispatch_Assignment::getRouter(const int index) const {
+    return myRoutingMode == 1 ? MSRoutingEngine::getRouterTT(index, SVC_TAXI) : MSNet::getInstance()->getRouterTT(index);
+}
+
+
+void
+MSDispatch_Assignment::findCandidates(const std::vector<Reservation*>& reservations, const std::vector<MSDevice_Taxi*>& taxis,
+                                      std::vector<Candidate>& into) {
+    // bucket the taxis into a grid with about one taxi per cell
+    std::vector<Position> positions;
+    Boundary bounds;
+    for (const MSDevice_Taxi* const taxi : taxis) {
+        positions.push_back(taxi->getHolder().getPosition());
+        bounds.add(positions.back());
+    }
+    const double cellSize = MAX2(100., sqrt(bounds.getWidth() * bounds.getHeight() / (double)taxis.size()));
+    const int numX = (int)(bounds.getWidth() / cellSize) + 1;
+    const int numY = (int)(bounds.getHeight() / cellSize) + 1;
+    std::vector<std::vector<int> > cells(numX * numY);
+    for (int t = 0; t < (int)taxis.size(); t++) {
+        const int x = MIN2(numX - 1, (int)((positions[t].x() - bounds.xmin()) / cellSize));
+        const int y = MIN2(numY - 1, (int)((positions[t].y() - bounds.ymin()) / cellSize));
+        cells[y * numX + x].push_back(t);
+    }
+    const int numCandidates = myNumCandidates > 0 ? MIN2(myNumCandidates, (int)taxis.size()) : (int)taxis.size();
+    std::vector<std::pair<double, int> > found;
+    for (int r = 0; r < (int)reservations.size(); r++) {
+        Reservation* const res = reservations[r];
+        const Position pos = res->from->getLanes().front()->geometryPositionAtOffset(res->fromPos);
+        const int cx = MAX2(0, MIN2(numX - 1, (int)((pos.x() - bounds.xmin()) / cellSize)));
+        const int cy = MAX2(0, MIN2(numY - 1, (int)((pos.y() - bounds.ymin()) / cellSize)));
+        found.clear();
+        for (int ring = 0; ring <= MAX2(numX, numY); ring++) {
+            for (int y = MAX2(0, cy - ring); y <= MIN2(numY - 1, cy + ring); y++) {
+                for (int x = MAX2(0, cx - ring); x <= MIN2(numX - 1, cx + ring); x++) {
+                    if (MAX2(abs(x - cx), abs(y - cy)) != ring) {
+                        continue;
+                    }
+                    for (const int t : cells[y * numX + x]) {
+                        if (remainingCapacity(taxis[t], res) >= 0 && taxis[t]->compatibleLine(res)) {
+                            found.push_back(std::make_pair(pos.distanceTo2D(positions[t]), t));
+                        }
+                    }
+                }
+            }
+            if ((int)found.size() >= numCandidates) {
+                // taxis in the outer rings are at least ring * cellSize away
+                std::nth_element(found.begin(), found.begin() + numCandidates - 1, found.end());
+                if (found[numCandidates - 1].first <= ring * cellSize) {
+                    break;
+                }
+            }
+        }
+        const int num = MIN2(numCandidates, (int)found.size());
+        std::partial_sort(found.begin(), found.begin() + num, found.end());
+        for (int i = 0; i < num; i++) {
+            into.push_back({r, found[i].second, SUMOTime_MAX});
+        }
+    }
+}
+
+
+void
+MSDispatch_Assignment::computePickupTimes(SUMOTime now, const std::vector<Reservation*>& reservations, const std::vector<MSDevice_Taxi*>& taxis,
+        std::vector<Candidate>& candidates) {
+    // consecutive queries from the same taxi can continue the previous search
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate & a, const Candidate & b) {
+        return a.taxi < b.taxi || (a.taxi == b.taxi && a.reservation < b.reservation);
+    });
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    MFXWorkerThread::Pool& threadPool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+    if (threadPool.size() > 0 && candidates.size() > 1) {
+        std::vector<SUMOAbstractRouter<MSEdge, SUMOVehicle>*> routers;
+        for (int i = 0; i < threadPool.size(); i++) {
+            routers.push_back(&getRouter(i));
+            routers.back()->setAutoBulkMode(true);
+        }
+        const int numTasks = MIN2((int)candidates.size(), 4 * threadPool.size());
+        for (int i = 0; i < numTasks; i++) {
+            const int index = i % threadPool.size();
+            threadPool.add(new PickupTimeTask(now, reservations, taxis,
+                                              candidates.begin() + i * candidates.size() / numTasks,
+                                              candidates.begin() + (i + 1) * candidates.size() / numTasks,
+                                              *routers[index]), index);
+        }
+        threadPool.waitAll();
+        for (SUMOAbstractRouter<MSEdge, SUMOVehicle>* const router : routers) {
+            router->setAutoBulkMode(false);
+        }
+        return;
+    }
+#endif
+#endif
+    SUMOAbstractRouter<MSEdge, SUMOVehicle>& router = getRouter(0);
+    router.setAutoBulkMode(true);
+    for (Candidate& c : candidates) {
+        c.pickupTime = computeReachablePickupTime(now, taxis[c.taxi], *reservations[c.reservation], router);
+    }
+    router.setAutoBulkMode(false);
+}
+
+
+SUMOTime
+MSDispatch_Assignment::computeReachablePickupTime(SUMOTime t, const MSDevice_Taxi* taxi, const Reservation& res, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router) {
+    ConstMSEdgeVector edges;
+    if (!router.compute(taxi->getHolder().getEdge(), taxi->getHolder().getPositionOnLane() - NUMERICAL_EPS,
+                        res.from, res.fromPos, &taxi->getHolder(), t, edges, true)) {
+        return SUMOTime_MAX;
+    }
+    return TIME2STEPS(router.recomputeCosts(edges, &taxi->getHolder(), t));
+}
+
+
+std::vector<int>
+MSDispatch_Assignment::solveAssignment(const int numReservations, const int numTaxis, const std::vector<Candidate>& candidates) const {
+    // forward auction: reservations bid for taxis, staying unassigned has the value of the maximum pickup time
+    const double eps = 1.;
+    const double unassignedValue = -STEPS2TIME(myMaxPickupTime) - eps;
+    std::vector<std::vector<std::pair<int, double> > > options(numReservations);
+    for (const Candidate& c : candidates) {
+        options[c.reservation].push_back(std::make_pair(c.taxi, -STEPS2TIME(c.pickupTime)));
+    }
+    std::vector<double> prices(numTaxis, 0.);
+    std::vector<int> owner(numTaxis, -1);
+    std::vector<int> assignment(numReservations, -1);
+    std::deque<int> bidders;
+    for (int r = 0; r < numReservations; r++) {
+        if (!options[r].empty()) {
+            bidders.push_back(r);
+        }
+    }
+    while (!bidders.empty()) {
+        const int r = bidders.front();
+        bidders.pop_front();
+        int bestTaxi = -1;
+        double best = unassignedValue;
+        double second = unassignedValue;
+        for (const std::pair<int, double>& option : options[r]) {
+            const double value = option.second - prices[option.first];
+            if (value > best) {
+                second = best;
+                best = value;
+                bestTaxi = option.first;
+            } else if (value > second) {
+                second = value;
+            }
+        }
+        if (bestTaxi < 0) {
+            // prices rose too high, the reservation stays unassigned
+            continue;
+        }
+        prices[bestTaxi] += best - second + eps;
+        if (owner[bestTaxi] >= 0) {
+            assignment[owner[bestTaxi]] = -1;
+            bidders.push_back(owner[bestTaxi]);
+        }
+        owner[bestTaxi] = r;
+        assignment[r] = bestTaxi;
+    }
+    return assignment;
+}
+
+
+#ifdef HAVE_FOX
+// ---------------------------------------------------------------------------
+// MSDispatch_Assignment::PickupTimeTask-methods
+// ---------------------------------------------------------------------------
+void
+MSDispatch_Assignment::PickupTimeTask::run(MFXWorkerThread* /*context*/) {
+    for (auto it = myBegin; it != myEnd; ++it) {
+        it->pickupTime = computeReachablePickupTime(myTime, myTaxis[it->taxi], *myReservations[it->reservation], myRouter);
+    }
+}
+#endif
+
+
+/****************************************************************************/
@@ -0,0 +1,117 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2007-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSDispatch_Assignment.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// An algorithm that performs dispatch for the taxi device
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <vector>
+#include <utils/common/Parameterised.h>
+#include <utils/common/SUMOTime.h>
+#include "MSDispatch_Greedy.h"
+
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#endif
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSDispatch_Assignment
+ * @brief A dispatch algorithm that assigns all current reservations to the idle taxis at once
+ *
+ * Only the spatially closest idle taxis (parameter "candidates") are considered
+ *  per reservation. Their pickup times are computed in parallel (if threads are
+ *  available) and the assignment minimizing the total pickup time is found with
+ *  an auction algorithm. Reservations may stay unassigned if serving them would
+ *  take longer than "maxPickupTime". The waiting time and recheck parameters
+ *  behave like those of the greedy algorithm.
+ */
+class MSDispatch_Assignment : public MSDispatch_Greedy {
+public:
+    MSDispatch_Assignment(const Parameterised::Map& params) :
+        MSDispatch_Greedy(params),
+        myNumCandidates(StringUtils::toInt(getParameter("candidates", "10"))),
+        myMaxPickupTime(TIME2STEPS(StringUtils::toInt(getParameter("maxPickupTime", "3600"))))
+    { }
+
+    void computeDispatch(SUMOTime now, const std::vector<MSDevice_Taxi*>& fleet);
+
+    /// @brief a possible assignment of a taxi to a reservation
+    struct Candidate {
+        int reservation;
+        int taxi;
+        SUMOTime pickupTime;
+    };
+
+private:
+#ifdef HAVE_FOX
+    /**
+     * @class PickupTimeTask
+     * @brief computes the pickup times for a range of candidates
+     */
+    class PickupTimeTask : public MFXWorkerThread::Task {
+    public:
+        PickupTimeTask(const SUMOTime now, const std::vector<Reservation*>& reservations, const std::vector<MSDevice_Taxi*>& taxis,
+                       std::vector<Candidate>::iterator begin, std::vector<Candidate>::iterator end,
+                       SUMOAbstractRouter<MSEdge, SUMOVehicle>& router)
+            : myTime(now), myReservations(reservations), myTaxis(taxis), myBegin(begin), myEnd(end), myRouter(router) {}
+        void run(MFXWorkerThread* context);
+    private:
+        const SUMOTime myTime;
+        const std::vector<Reservation*>& myReservations;
+        const std::vector<MSDevice_Taxi*>& myTaxis;
+        const std::vector<Candidate>::iterator myBegin;
+        const std::vector<Candidate>::iterator myEnd;
+        SUMOAbstractRouter<MSEdge, SUMOVehicle>& myRouter;
+    private:
+        /// @brief Invalidated assignment operator.
+        PickupTimeTask& operator=(const PickupTimeTask&) = delete;
+    };
+#endif
+
+    /// @brief the router for the given thread
+    SUMOAbstractRouter<MSEdge, SUMOVehicle>& getRouter(const int index) const;
+
+    /// @brief collects the closest compatible taxis for every reservation
+    void findCandidates(const std::vector<Reservation*>& reservations, const std::vector<MSDevice_Taxi*>& taxis,
+                        std::vector<Candidate>& into);
+
+    /// @brief computes the pickup times of all candidates
+    void computePickupTimes(SUMOTime now, const std::vector<Reservation*>& reservations, const std::vector<MSDevice_Taxi*>& taxis,
+                            std::vector<Candidate>& candidates);
+
+    /// @brief like computePickupTime but returns SUMOTime_MAX if the pickup location cannot be reached
+    static SUMOTime computeReachablePickupTime(SUMOTime t, const MSDevice_Taxi* taxi, const Reservation& res, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router);
+
+    /// @brief solves the assignment problem on the candidates, returns the assigned taxi index per reservation (or -1)
+    std::vector<int> solveAssignment(const int numReservations, const int numTaxis, const std::vector<Candidate>& candidates) const;
+
+    /// @brief the number of closest taxis considered per reservation
+    const int myNumCandidates;
+
+    /// @brief assignments with a longer pickup time are not considered
+    const SUMOTime myMaxPickupTime;
+
+private:
+    /// @brief Invalidated assignment operator.
+    MSDispatch_Assignment& operator=(const MSDispatch_Assignment&) = delete;
+
+};
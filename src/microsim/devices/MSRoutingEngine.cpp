@@ -23,6 +23,8 @@
 /****************************************************************************/
 #include <config.h>
 
+#include <limits>
+
 #include "MSRoutingEngine.h"
 #include <microsim/MSNet.h>
 #include <microsim/MSLane.h>
@@ -31,9 +33,11 @@
 #include <microsim/MSEventControl.h>
 #include <microsim/MSGlobals.h>
 #include <microsim/MSVehicleControl.h>
+#include <microsim/output/MSStepProfiler.h>
 #include <utils/options/OptionsCont.h>
 #include <utils/common/WrappingCommand.h>
 #include <utils/common/StaticCommand.h>
+#include <utils/common/PerformanceCounters.h>
 #include <utils/common/StringUtils.h>
 #include <utils/xml/SUMOSAXAttributes.h>
 #include <utils/router/DijkstraRouter.h>
@@ -61,17 +65,24 @@ SUMOTime MSRoutingEngine::myLastAdaptation = -1;
 bool MSRoutingEngine::myWithTaz;
 bool MSRoutingEngine::myBikeSpeeds;
 MSRoutingEngine::MSRouterProvider* MSRoutingEngine::myRouterProvider = nullptr;
-std::map<std::pair<const MSEdge*, const MSEdge*>, ConstMSRoutePtr> MSRoutingEngine::myCachedRoutes;
+MSRoutingEngine::RouteCacheShard MSRoutingEngine::myCachedRoutes[MSRoutingEngine::ROUTE_CACHE_SHARDS];
+std::atomic<int> MSRoutingEngine::myRouteCacheEpoch(0);
+int MSRoutingEngine::myRouteCacheShardSize = -1;
+int MSRoutingEngine::myNumAlternatives = 0;
+double MSRoutingEngine::myAlternativesTolerance = 0.;
+thread_local bool MSRoutingEngine::myUseAlternatives = false;
 double MSRoutingEngine::myPriorityFactor(0);
 double MSRoutingEngine::myMinEdgePriority(std::numeric_limits<double>::max());
 double MSRoutingEngine::myEdgePriorityRange(0);
-std::map<std::thread::id, SumoRNG*> MSRoutingEngine::myThreadRNGs;
-
-SUMOAbstractRouter<MSEdge, SUMOVehicle>::Operation MSRoutingEngine::myEffortFunc = &MSRoutingEngine::getEffort;
+std::vector<SumoRNG*> MSRoutingEngine::myThreadRNGs;
+thread_local SumoRNG* MSRoutingEngine::myThreadRNG = nullptr;
 #ifdef HAVE_FOX
-FXMutex MSRoutingEngine::myRouteCacheMutex;
+bool MSRoutingEngine::myBatchActive = false;
+std::vector<MSRoutingEngine::RoutingTask*> MSRoutingEngine::myPendingReroutes;
 #endif
 
+SUMOAbstractRouter<MSEdge, SUMOVehicle>::Operation MSRoutingEngine::myEffortFunc = &MSRoutingEngine::getEffort;
+
 
 // ===========================================================================
 // method definitions
@@ -86,6 +97,10 @@ MSRoutingEngine::initWeightUpdate() {
         myLastAdaptation = -1;
         const OptionsCont& oc = OptionsCont::getOptions();
         myWithTaz = oc.getBool("device.rerouting.with-taz");
+        const int cacheSize = oc.getInt("device.rerouting.route-cache-size");
+        myRouteCacheShardSize = cacheSize < 0 ? -1 : (cacheSize + ROUTE_CACHE_SHARDS - 1) / ROUTE_CACHE_SHARDS;
+        myNumAlternatives = oc.getInt("device.rerouting.alternatives");
+        myAlternativesTolerance = oc.getFloat("device.rerouting.alternatives.tolerance");
         myAdaptationInterval = string2time(oc.getString("device.rerouting.adaptation-interval"));
         myAdaptationWeight = oc.getFloat("device.rerouting.adaptation-weight");
         const SUMOTime period = string2time(oc.getString("device.rerouting.period"));
@@ -178,14 +193,7 @@ MSRoutingEngine::getEffortBike(const MSEdge* const e, const SUMOVehicle* const v
 
 SumoRNG*
 MSRoutingEngine::getThreadRNG() {
-    if (myThreadRNGs.size() > 0) {
-        auto it = myThreadRNGs.find(std::this_thread::get_id());
-        if (it != myThreadRNGs.end()) {
-            return it->second;
-        }
-        std::cout << " something bad happended\n";
-    }
-    return nullptr;
+    return myThreadRNG;
 }
 
 
@@ -222,7 +230,8 @@ MSRoutingEngine::adaptEdgeEfforts(SUMOTime currentTime) {
     if (MSNet::getInstance()->getVehicleControl().getDepartedVehicleNo() == 0) {
         return myAdaptationInterval;
     }
-    myCachedRoutes.clear();
+    // invalidate all cached routes without touching them
+    myRouteCacheEpoch++;
     const MSEdgeVector& edges = MSNet::getInstance()->getEdgeControl().getEdges();
     const double newWeightFactor = (double)(1. - myAdaptationWeight);
     for (const MSEdge* const e : edges) {
@@ -361,14 +370,59 @@ MSRoutingEngine::patchSpeedForTurns(const MSEdge* edge, double currSpeed) {
 
 ConstMSRoutePtr
 MSRoutingEngine::getCachedRoute(const std::pair<const MSEdge*, const MSEdge*>& key) {
-    auto routeIt = myCachedRoutes.find(key);
-    if (routeIt != myCachedRoutes.end()) {
-        return routeIt->second;
+    RouteCacheShard& shard = getRouteCacheShard(key);
+#ifdef HAVE_FOX
+    FXMutexLock lock(shard.lock);
+#endif
+    auto routeIt = shard.routes.find(key);
+    if (routeIt != shard.routes.end() && routeIt->second.second == myRouteCacheEpoch) {
+        return routeIt->second.first;
     }
     return nullptr;
 }
 
 
+void
+MSRoutingEngine::addCachedRoute(const std::pair<const MSEdge*, const MSEdge*>& key, ConstMSRoutePtr route) {
+    RouteCacheShard& shard = getRouteCacheShard(key);
+    const int epoch = myRouteCacheEpoch;
+#ifdef HAVE_FOX
+    FXMutexLock lock(shard.lock);
+#endif
+    auto routeIt = shard.routes.find(key);
+    if (routeIt != shard.routes.end()) {
+        if (routeIt->second.second != epoch) {
+            routeIt->second = std::make_pair(route, epoch);
+        }
+        return;
+    }
+    if (myRouteCacheShardSize >= 0 && (int)shard.routes.size() >= myRouteCacheShardSize) {
+        // evict the routes of past epochs
+        for (auto it = shard.routes.begin(); it != shard.routes.end();) {
+            if (it->second.second != epoch) {
+                it = shard.routes.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if ((int)shard.routes.size() >= myRouteCacheShardSize) {
+            return;
+        }
+    }
+    shard.routes[key] = std::make_pair(route, epoch);
+}
+
+
+void
+MSRoutingEngine::clearRouteCache() {
+    for (RouteCacheShard& shard : myCachedRoutes) {
+        shard.routes.clear();
+        shard.alternatives.clear();
+    }
+    myRouteCacheEpoch = 0;
+}
+
+
 void
 MSRoutingEngine::initRouter(SUMOVehicle* vehicle) {
     OptionsCont& oc = OptionsCont::getOptions();
@@ -378,7 +432,8 @@ MSRoutingEngine::initRouter(SUMOVehicle* vehicle) {
     myEffortFunc = ((gWeightsRandomFactor != 1 || myPriorityFactor != 0 || myBikeSpeeds) ? &MSRoutingEngine::getEffortExtra : &MSRoutingEngine::getEffort);
 
     SUMOAbstractRouter<MSEdge, SUMOVehicle>* router = nullptr;
-    if (routingAlgorithm == "dijkstra") {
+    if (routingAlgorithm == "dijkstra" || routingAlgorithm == "raptor") {
+        // raptor only applies to intermodal routing
         router = new DijkstraRouter<MSEdge, SUMOVehicle>(MSEdge::getAllEdges(), true, myEffortFunc, nullptr, false, nullptr, true);
     } else if (routingAlgorithm == "astar") {
         typedef AStarRouter<MSEdge, SUMOVehicle> AStar;
@@ -400,13 +455,13 @@ MSRoutingEngine::initRouter(SUMOVehicle* vehicle) {
     } else if (routingAlgorithm == "CH" && !hasPermissions) {
         const SUMOTime weightPeriod = myAdaptationInterval > 0 ? myAdaptationInterval : SUMOTime_MAX;
         router = new CHRouter<MSEdge, SUMOVehicle>(
-            MSEdge::getAllEdges(), true, myEffortFunc, vehicle == nullptr ? SVC_PASSENGER : vehicle->getVClass(), weightPeriod, true, false);
+            MSEdge::getAllEdges(), true, myEffortFunc, vehicle == nullptr ? SVC_PASSENGER : vehicle->getVClass(), weightPeriod, true, false, oc.getBool("ch.reuse-order"));
     } else if (routingAlgorithm == "CHWrapper" || routingAlgorithm == "CH") {
         // use CHWrapper instead of CH if the net has permissions
         const SUMOTime weightPeriod = myAdaptationInterval > 0 ? myAdaptationInterval : SUMOTime_MAX;
         router = new CHRouterWrapper<MSEdge, SUMOVehicle>(
             MSEdge::getAllEdges(), true, myEffortFunc,
-            string2time(oc.getString("begin")), string2time(oc.getString("end")), weightPeriod, hasPermissions, oc.getInt("device.rerouting.threads"));
+            string2time(oc.getString("begin")), string2time(oc.getString("end")), weightPeriod, hasPermissions, oc.getInt("device.rerouting.threads"), oc.getBool("ch.reuse-order"));
     } else {
         throw ProcessError(TLF("Unknown routing algorithm '%'!", routingAlgorithm));
     }
@@ -426,14 +481,9 @@ MSRoutingEngine::initRouter(SUMOVehicle* vehicle) {
                 static_cast<MSEdgeControl::WorkerThread*>(*t)->setRouterProvider(myRouterProvider->clone());
             }
         }
-#ifndef WIN32
-        /*
-        int i = 0;
-        for (MFXWorkerThread* t : threads) {
-            myThreadRNGs[(std::thread::id)t->id()] = new SumoRNG("routing_" + toString(i++));
+        while (myThreadRNGs.size() < threads.size()) {
+            myThreadRNGs.push_back(new SumoRNG("routing_" + toString(myThreadRNGs.size())));
         }
-        */
-#endif
     }
 #endif
 #endif
@@ -451,30 +501,110 @@ MSRoutingEngine::reroute(SUMOVehicle& vehicle, const SUMOTime currentTime, const
 #ifdef HAVE_FOX
     MFXWorkerThread::Pool& threadPool = MSNet::getInstance()->getEdgeControl().getThreadPool();
     if (threadPool.size() > 0) {
-        threadPool.add(new RoutingTask(vehicle, currentTime, info, onInit, silent, prohibited));
+        if (myBatchActive) {
+            myPendingReroutes.push_back(new RoutingTask(vehicle, currentTime, info, onInit, silent, prohibited));
+        } else {
+            threadPool.add(new RoutingTask(vehicle, currentTime, info, onInit, silent, prohibited));
+        }
         return;
     }
 #endif
 #endif
+    PerformanceCounters::Timer timer(PerformanceCounters::ROUTING);
     if (!prohibited.empty()) {
         router.prohibit(prohibited);
     }
+    myUseAlternatives = prohibited.empty();
     try {
         vehicle.reroute(currentTime, info, router, onInit, myWithTaz, silent);
     } catch (ProcessError&) {
         if (!silent) {
+            myUseAlternatives = false;
             if (!prohibited.empty()) {
                 router.prohibit(MSEdgeVector());
             }
             throw;
         }
     }
+    myUseAlternatives = false;
     if (!prohibited.empty()) {
         router.prohibit(MSEdgeVector());
     }
 }
 
 
+bool
+MSRoutingEngine::compute(SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, const MSEdge* const source, const MSEdge* const sink,
+                         const SUMOVehicle* const vehicle, const SUMOTime t, ConstMSEdgeVector& into, const bool silent) {
+    if (myNumAlternatives <= 0 || !myUseAlternatives) {
+        return router.compute(source, sink, vehicle, t, into, silent);
+    }
+    const std::pair<const MSEdge*, const MSEdge*> key(source, sink);
+    RouteCacheShard& shard = getRouteCacheShard(key);
+    // the current effort of each alternative relative to its effort when it was found
+    auto degradation = [&](const Alternative & alt) {
+        return router.isValid(alt.edges, vehicle) ? router.recomputeCosts(alt.edges, vehicle, t) / alt.effort : std::numeric_limits<double>::max();
+    };
+    {
+#ifdef HAVE_FOX
+        FXMutexLock lock(shard.lock);
+#endif
+        const auto it = shard.alternatives.find(key);
+        if (it != shard.alternatives.end()) {
+            const Alternative* best = nullptr;
+            double bestDegradation = 1. + myAlternativesTolerance;
+            for (const Alternative& alt : it->second) {
+                const double d = degradation(alt);
+                if (d <= bestDegradation) {
+                    best = &alt;
+                    bestDegradation = d;
+                }
+            }
+            if (best != nullptr) {
+                into.insert(into.end(), best->edges.begin(), best->edges.end());
+                return true;
+            }
+        }
+    }
+    // all alternatives degraded (or there are none yet)
+    const int offset = (int)into.size();
+    if (!router.compute(source, sink, vehicle, t, into, silent)) {
+        return false;
+    }
+    Alternative found;
+    found.edges.assign(into.begin() + offset, into.end());
+    if (found.edges.empty()) {
+        return true;
+    }
+    found.effort = MAX2(router.recomputeCosts(found.edges, vehicle, t), NUMERICAL_EPS);
+#ifdef HAVE_FOX
+    FXMutexLock lock(shard.lock);
+#endif
+    std::vector<Alternative>& alternatives = shard.alternatives[key];
+    for (Alternative& alt : alternatives) {
+        if (alt.edges == found.edges) {
+            alt.effort = found.effort;
+            return true;
+        }
+    }
+    if ((int)alternatives.size() < myNumAlternatives) {
+        alternatives.push_back(found);
+    } else {
+        Alternative* worst = &alternatives.front();
+        double worstDegradation = degradation(*worst);
+        for (Alternative& alt : alternatives) {
+            const double d = degradation(alt);
+            if (d > worstDegradation) {
+                worst = &alt;
+                worstDegradation = d;
+            }
+        }
+        *worst = found;
+    }
+    return true;
+}
+
+
 void
 MSRoutingEngine::setEdgeTravelTime(const MSEdge* const edge, const double travelTime) {
     myEdgeSpeeds[edge->getNumericalID()] = edge->getLength() / travelTime;
@@ -524,8 +654,12 @@ MSRoutingEngine::cleanup() {
     //for (auto& item : myCachedRoutes) {
     //    item.second->release();
     //}
-    myCachedRoutes.clear();
+    clearRouteCache();
     myAdaptationStepsIndex = 0;
+    for (SumoRNG* const rng : myThreadRNGs) {
+        delete rng;
+    }
+    myThreadRNGs.clear();
 #ifdef HAVE_FOX
     if (MSGlobals::gNumThreads > 1) {
         // router deletion is done in thread destructor
@@ -543,7 +677,22 @@ void
 MSRoutingEngine::waitForAll() {
 #ifndef THREAD_POOL
     MFXWorkerThread::Pool& threadPool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+    myBatchActive = false;
     if (threadPool.size() > 0) {
+        if (!myPendingReroutes.empty()) {
+            // neighbouring origins share the warm parts of the edge data in the same thread
+            std::stable_sort(myPendingReroutes.begin(), myPendingReroutes.end(), [](const RoutingTask* a, const RoutingTask * b) {
+                return a->getOrigin() < b->getOrigin();
+            });
+            const int numTasks = MIN2((int)myPendingReroutes.size(), 4 * threadPool.size());
+            for (int i = 0; i < numTasks; i++) {
+                const int index = i % threadPool.size();
+                threadPool.add(new BatchTask(myPendingReroutes.begin() + i * myPendingReroutes.size() / numTasks,
+                                             myPendingReroutes.begin() + (i + 1) * myPendingReroutes.size() / numTasks,
+                                             index < (int)myThreadRNGs.size() ? myThreadRNGs[index] : nullptr), index);
+            }
+            myPendingReroutes.clear();
+        }
         threadPool.waitAll();
     }
 #endif
@@ -555,32 +704,54 @@ MSRoutingEngine::waitForAll() {
 // ---------------------------------------------------------------------------
 void
 MSRoutingEngine::RoutingTask::run(MFXWorkerThread* context) {
+    MSStepProfiler::Scope span("routingTask");
+    PerformanceCounters::Timer timer(PerformanceCounters::ROUTING);
     SUMOAbstractRouter<MSEdge, SUMOVehicle>& router = static_cast<MSEdgeControl::WorkerThread*>(context)->getRouter(myVehicle.getVClass());
     if (!myProhibited.empty()) {
         router.prohibit(myProhibited);
     }
+    myUseAlternatives = myProhibited.empty();
     try {
         myVehicle.reroute(myTime, myInfo, router, myOnInit, myWithTaz, mySilent);
     } catch (ProcessError&) {
         if (!mySilent) {
+            myUseAlternatives = false;
             if (!myProhibited.empty()) {
                 router.prohibit(MSEdgeVector());
             }
             throw;
         }
     }
+    myUseAlternatives = false;
     if (!myProhibited.empty()) {
         router.prohibit(MSEdgeVector());
     }
     const MSEdge* source = *myVehicle.getRoute().begin();
     const MSEdge* dest = myVehicle.getRoute().getLastEdge();
     if (source->isTazConnector() && dest->isTazConnector()) {
-        const std::pair<const MSEdge*, const MSEdge*> key = std::make_pair(source, dest);
-        FXMutexLock lock(myRouteCacheMutex);
-        if (MSRoutingEngine::myCachedRoutes.find(key) == MSRoutingEngine::myCachedRoutes.end()) {
-            MSRoutingEngine::myCachedRoutes[key] = myVehicle.getRoutePtr();
-        }
+        MSRoutingEngine::addCachedRoute(std::make_pair(source, dest), myVehicle.getRoutePtr());
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// MSRoutingEngine::BatchTask-methods
+// ---------------------------------------------------------------------------
+MSRoutingEngine::BatchTask::~BatchTask() {
+    for (RoutingTask* const task : myTasks) {
+        delete task;
+    }
+}
+
+
+void
+MSRoutingEngine::BatchTask::run(MFXWorkerThread* context) {
+    MSStepProfiler::Scope span("routingBatch");
+    myThreadRNG = myRNG;
+    for (RoutingTask* const task : myTasks) {
+        task->run(context);
     }
+    myThreadRNG = nullptr;
 }
 #endif
 
@@ -22,10 +22,12 @@
 #pragma once
 #include <config.h>
 
+#include <atomic>
 #include <set>
 #include <vector>
 #include <map>
 #include <thread>
+#include <unordered_map>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/WrappingCommand.h>
 #include <utils/router/SUMOAbstractRouter.h>
@@ -89,6 +91,19 @@ public:
     static void reroute(SUMOVehicle& vehicle, const SUMOTime currentTime, const std::string& info,
                         const bool onInit = false, const bool silent = false, const MSEdgeVector& prohibited = MSEdgeVector());
 
+    /** @brief computes the route from source to sink, reusing the alternatives of earlier reroutes if possible
+     *
+     * With device.rerouting.alternatives the routes found by the reroutes of
+     *  the routing devices are kept per (source, sink). If the best valid one
+     *  (scored with the current efforts) is at most the given tolerance worse
+     *  than when it was found, it is used without a search. Otherwise the
+     *  router searches and the result replaces the most degraded alternative.
+     *  Other reroutes (e.g. with prohibited edges) always search.
+     * @see SUMOAbstractRouter::compute
+     */
+    static bool compute(SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, const MSEdge* const source, const MSEdge* const sink,
+                        const SUMOVehicle* const vehicle, const SUMOTime t, ConstMSEdgeVector& into, const bool silent);
+
     /// @brief adapt the known travel time for an edge
     static void setEdgeTravelTime(const MSEdge* const edge, const double travelTime);
 
@@ -136,6 +151,12 @@ public:
     static void addEdgeTravelTime(const MSEdge& edge, const SUMOTime travelTime);
 
 #ifdef HAVE_FOX
+    /// @brief collect the following reroutes until waitForAll instead of dispatching them one by one
+    static void beginBatch() {
+        myBatchActive = true;
+    }
+
+    /// @brief dispatches the collected reroutes and waits for all routing threads
     static void waitForAll();
 #endif
 
@@ -150,8 +171,13 @@ private:
     public:
         RoutingTask(SUMOVehicle& v, const SUMOTime time, const std::string& info,
                     const bool onInit, const bool silent, const MSEdgeVector& prohibited)
-            : myVehicle(v), myTime(time), myInfo(info), myOnInit(onInit), mySilent(silent), myProhibited(prohibited) {}
+            : myVehicle(v), myTime(time), myInfo(info), myOnInit(onInit), mySilent(silent), myProhibited(prohibited),
+              myOrigin((*v.getRerouteOrigin())->getNumericalID()) {}
         void run(MFXWorkerThread* context);
+        /// @brief the numerical id of the edge the search starts from (for sorting a batch)
+        int getOrigin() const {
+            return myOrigin;
+        }
     private:
         SUMOVehicle& myVehicle;
         const SUMOTime myTime;
@@ -159,10 +185,35 @@ private:
         const bool myOnInit;
         const bool mySilent;
         const MSEdgeVector myProhibited;
+        const int myOrigin;
     private:
         /// @brief Invalidated assignment operator.
         RoutingTask& operator=(const RoutingTask&) = delete;
     };
+
+    /**
+     * @class BatchTask
+     * @brief a chunk of routing tasks processed by the same thread (with the thread's RNG)
+     */
+    class BatchTask : public MFXWorkerThread::Task {
+    public:
+        BatchTask(std::vector<RoutingTask*>::const_iterator begin, std::vector<RoutingTask*>::const_iterator end, SumoRNG* rng)
+            : myTasks(begin, end), myRNG(rng) {}
+        ~BatchTask();
+        void run(MFXWorkerThread* context);
+    private:
+        std::vector<RoutingTask*> myTasks;
+        SumoRNG* const myRNG;
+    private:
+        /// @brief Invalidated assignment operator.
+        BatchTask& operator=(const BatchTask&) = delete;
+    };
+
+    /// @brief whether reroutes are collected until waitForAll
+    static bool myBatchActive;
+
+    /// @brief the reroutes collected in the current batch
+    static std::vector<RoutingTask*> myPendingReroutes;
 #endif
 
     /// @name Network state adaptation
@@ -231,10 +282,66 @@ private:
     /// @brief The router to use
     static MSRouterProvider* myRouterProvider;
 
-    static std::map<std::thread::id, SumoRNG*> myThreadRNGs;
+    /// @brief the random number generators of the routing threads (indexed by thread)
+    static std::vector<SumoRNG*> myThreadRNGs;
+
+    /// @brief the random number generator of the current routing thread
+    static thread_local SumoRNG* myThreadRNG;
+
+    /// @brief hash for (source, destination) pairs
+    struct EdgePairHash {
+        size_t operator()(const std::pair<const MSEdge*, const MSEdge*>& key) const {
+            return (size_t)key.first->getNumericalID() * 1000003 + (size_t)key.second->getNumericalID();
+        }
+    };
+
+    /// @brief the number of independently locked parts of the route cache
+    static const int ROUTE_CACHE_SHARDS = 64;
+
+    /// @brief a route found by a search together with its effort at that time
+    struct Alternative {
+        ConstMSEdgeVector edges;
+        double effort;
+    };
+
+    /// @brief one part of the route cache, the entries remember the cache epoch of their insertion
+    struct RouteCacheShard {
+        std::unordered_map<std::pair<const MSEdge*, const MSEdge*>, std::pair<ConstMSRoutePtr, int>, EdgePairHash> routes;
+        /// @brief the alternatives between edges (independent of the epoch, they are scored on use)
+        std::unordered_map<std::pair<const MSEdge*, const MSEdge*>, std::vector<Alternative>, EdgePairHash> alternatives;
+#ifdef HAVE_FOX
+        FXMutex lock;
+#endif
+    };
 
     /// @brief The container of pre-calculated routes
-    static std::map<std::pair<const MSEdge*, const MSEdge*>, ConstMSRoutePtr> myCachedRoutes;
+    static RouteCacheShard myCachedRoutes[ROUTE_CACHE_SHARDS];
+
+    /// @brief the current cache epoch, cached routes from earlier epochs are invalid
+    static std::atomic<int> myRouteCacheEpoch;
+
+    /// @brief the maximum number of routes per shard (-1 means no limit)
+    static int myRouteCacheShardSize;
+
+    /// @brief the number of alternatives kept per (source, sink), 0 disables them
+    static int myNumAlternatives;
+
+    /// @brief the relative increase of the effort up to which an alternative is used without a search
+    static double myAlternativesTolerance;
+
+    /// @brief whether the reroute in the current thread was triggered by the routing engine (without prohibitions)
+    static thread_local bool myUseAlternatives;
+
+    /// @brief retrieve the shard responsible for the given key
+    static RouteCacheShard& getRouteCacheShard(const std::pair<const MSEdge*, const MSEdge*>& key) {
+        return myCachedRoutes[EdgePairHash()(key) % ROUTE_CACHE_SHARDS];
+    }
+
+    /// @brief add a route to the cache unless there is already a valid one
+    static void addCachedRoute(const std::pair<const MSEdge*, const MSEdge*>& key, ConstMSRoutePtr route);
+
+    /// @brief remove all routes from the cache
+    static void clearRouteCache();
 
     /// @brief Coefficient for factoring edge priority into routing weight
     static double myPriorityFactor;
@@ -244,11 +351,6 @@ private:
     /// @brief the difference between maximum and minimum priority for all edges
     static double myEdgePriorityRange;
 
-#ifdef HAVE_FOX
-    /// @brief Mutex for accessing the route cache
-    static FXMutex myRouteCacheMutex;
-#endif
-
 private:
     /// @brief Invalidated copy constructor.
     MSRoutingEngine(const MSRoutingEngine&);
@@ -28,6 +28,7 @@
 #include <set>
 #include <random>
 #include <utils/vehicle/SUMOVehicle.h>
+#include <utils/common/MemoryPool.h>
 #include <microsim/MSMoveReminder.h>
 #include "MSDevice.h"
 
@@ -64,6 +65,16 @@ public:
     /// @brief Destructor
     virtual ~MSVehicleDevice() { }
 
+    /// @brief allocates the memory of devices from the memory pool
+    static void* operator new(std::size_t size) {
+        return MemoryPool::allocate(size);
+    }
+
+    /// @brief returns the memory of devices to the memory pool
+    static void operator delete(void* p, std::size_t size) {
+        MemoryPool::deallocate(p, size);
+    }
+
 
     /** @brief Returns the vehicle that holds this device
      *
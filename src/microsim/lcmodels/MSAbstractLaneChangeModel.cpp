@@ -755,8 +755,7 @@ MSAbstractLaneChangeModel::calcAngleOffset() {
 double
 MSAbstractLaneChangeModel::estimateLCDuration(const double speed, const double remainingManeuverDist, const double decel, bool urgent) const {
 
-    const SUMOVTypeParameter::SubParams& lcParams = myVehicle.getVehicleType().getParameter().getLCParams();
-    if (lcParams.find(SUMO_ATTR_LCA_MAXSPEEDLATSTANDING) == lcParams.end() && lcParams.find(SUMO_ATTR_LCA_MAXSPEEDLATFACTOR) == lcParams.end()) {
+    if (!myVehicle.getVehicleType().getModelParams().lcHasSpeedLatDependency) {
         if (!myVehicle.getVehicleType().wasSet(VTYPEPARS_MAXSPEED_LAT_SET)) {
             // no dependency of lateral speed on longitudinal speed. (Only called prior to LC initialization to determine whether it could be completed)
             return STEPS2TIME(MSGlobals::gLaneChangeDuration);
@@ -860,8 +859,7 @@ MSAbstractLaneChangeModel::estimateLCDuration(const double speed, const double r
 SUMOTime
 MSAbstractLaneChangeModel::remainingTime() const {
     assert(isChangingLanes()); // Only to be called during ongoing lane change
-    const SUMOVTypeParameter::SubParams& lcParams = myVehicle.getVehicleType().getParameter().getLCParams();
-    if (lcParams.find(SUMO_ATTR_LCA_MAXSPEEDLATSTANDING) == lcParams.end() && lcParams.find(SUMO_ATTR_LCA_MAXSPEEDLATFACTOR) == lcParams.end()) {
+    if (!myVehicle.getVehicleType().getModelParams().lcHasSpeedLatDependency) {
         if (myVehicle.getVehicleType().wasSet(VTYPEPARS_MAXSPEED_LAT_SET)) {
             return TIME2STEPS((1. - myLaneChangeCompletion) * myManeuverDist / myVehicle.getVehicleType().getMaxSpeedLat());
         } else {
@@ -26,6 +26,7 @@
 #include <config.h>
 
 #include <microsim/MSGlobals.h>
+#include <utils/common/MemoryPool.h>
 #include <microsim/MSLeaderInfo.h>
 #include <microsim/MSVehicle.h>
 
@@ -178,6 +179,16 @@ public:
     /// @brief Destructor
     virtual ~MSAbstractLaneChangeModel();
 
+    /// @brief allocates the memory of lane change models from the memory pool
+    static void* operator new(std::size_t size) {
+        return MemoryPool::allocate(size);
+    }
+
+    /// @brief returns the memory of lane change models to the memory pool
+    static void operator delete(void* p, std::size_t size) {
+        MemoryPool::deallocate(p, size);
+    }
+
     inline int getOwnState() const {
         return myOwnState;
     }
@@ -25,11 +25,14 @@
 #include <config.h>
 
 #include <iostream>
-#include <utils/options/OptionsCont.h>
+#include <set>
+#include <microsim/MSGlobals.h>
 #include <utils/options/Option.h>
 #include <utils/common/MsgHandler.h>
+#include <utils/common/PerformanceCounters.h>
 #include "MSMeanData_Emissions.h"
 #include "MSMeanData_Net.h"
+#include "MSFCDColumnarWriter.h"
 #include "MSDetectorControl.h"
 
 
@@ -50,6 +53,9 @@ MSDetectorControl::~MSDetectorControl() {
         }
     }
     myMeanData.clear();
+    for (auto item : myColumnarWriters) {
+        delete item.second;
+    }
 }
 
 
@@ -88,7 +94,7 @@ MSDetectorControl::add(MSMeanData* md, const std::string& device,
                        SUMOTime frequency, SUMOTime begin) {
     myMeanData[md->getID()].push_back(md);
     addDetectorAndInterval(md, &OutputDevice::getDevice(device), frequency, begin);
-    if (begin <= string2time(OptionsCont::getOptions().getString("begin"))) {
+    if (begin <= MSGlobals::gBegin) {
         md->init();
     }
     MSGlobals::gHaveEmissions |= typeid(*md) == typeid(MSMeanData_Emissions);
@@ -116,6 +122,7 @@ MSDetectorControl::getTypedDetectors(SumoXMLTag type) const {
 
 void
 MSDetectorControl::updateDetectors(const SUMOTime step) {
+    PerformanceCounters::Timer timer(PerformanceCounters::DETECTORS);
     for (const auto& i : myDetectors) {
         for (const auto& j : getTypedDetectors(i.first)) {
             j.second->detectorUpdate(step);
@@ -136,10 +143,23 @@ MSDetectorControl::writeOutput(SUMOTime step, bool closing) {
         if (myLastCalls[interval] + interval.first <= step || (closing && myLastCalls[interval] < step)) {
             DetectorFileVec dfVec = (*i).second;
             SUMOTime startTime = myLastCalls[interval];
+            std::set<MSFCDColumnarWriter*> rowGroups;
             // check whether at the end the output was already generated
             for (DetectorFileVec::iterator it = dfVec.begin(); it != dfVec.end(); ++it) {
                 MSDetectorFileOutput* det = it->first;
-                det->writeXMLOutput(*(it->second), startTime, step);
+                auto columnar = myColumnarWriters.find(it->second);
+                if (columnar == myColumnarWriters.end()) {
+                    det->writeXMLOutput(*(it->second), startTime, step);
+                } else {
+                    if (rowGroups.insert(columnar->second).second) {
+                        columnar->second->openTag(SUMO_TAG_INTERVAL);
+                        columnar->second->writeAttr(SUMO_ATTR_TIME, STEPS2TIME(step));
+                    }
+                    det->writeColumnarOutput(*columnar->second, startTime, step);
+                }
+            }
+            for (MSFCDColumnarWriter* writer : rowGroups) {
+                writer->closeTag();
             }
             myLastCalls[interval] = step;
         }
@@ -152,7 +172,7 @@ MSDetectorControl::addDetectorAndInterval(MSDetectorFileOutput* det,
         OutputDevice* device,
         SUMOTime interval,
         SUMOTime begin) {
-    const SUMOTime simBegin = string2time(OptionsCont::getOptions().getString("begin"));
+    const SUMOTime simBegin = MSGlobals::gBegin;
     if (begin == -1) {
         begin = simBegin;
     }
@@ -181,7 +201,16 @@ MSDetectorControl::addDetectorAndInterval(MSDetectorFileOutput* det,
             return;
         }
     }
-    det->writeXMLDetectorProlog(*device);
+    if (MSFCDColumnarWriter::isColumnarFile(device->getFilename())) {
+        if (!det->hasColumnarOutput()) {
+            throw ProcessError(TLF("Detector '%' cannot write to the columnar file '%'.", det->getID(), device->getFilename()));
+        }
+        if (myColumnarWriters.count(device) == 0) {
+            myColumnarWriters[device] = new MSFCDColumnarWriter(*device);
+        }
+    } else {
+        det->writeXMLDetectorProlog(*device);
+    }
 }
 
 void
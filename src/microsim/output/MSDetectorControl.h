@@ -38,6 +38,7 @@
 // class declarations
 // ===========================================================================
 class MSMeanData;
+class MSFCDColumnarWriter;
 
 
 // ===========================================================================
@@ -171,6 +172,9 @@ public:
      *  written in this step already, the writeXMLOutput method is called
      *  for all MSDetectorFileOutputs within this interval.
      *
+     * Detectors writing to a columnar file (see MSFCDColumnarWriter) add one
+     *  row each, all rows of the interval form a single row group per file.
+     *
      * @param[in] step The current time step
      * @param[in] closing Whether the device is closed
      * @exception IOError If an error on writing occurs (!!! not yet implemented)
@@ -207,6 +211,9 @@ protected:
     /// @brief The map that holds the last call for each sample interval
     std::map<IntervalsKey, SUMOTime> myLastCalls;
 
+    /// @brief The writers of the detector files in columnar format
+    std::map<OutputDevice*, MSFCDColumnarWriter*> myColumnarWriters;
+
     /// @brief List of meanData detectors
     std::map<std::string, std::vector<MSMeanData*> > myMeanData;
 
@@ -53,6 +53,7 @@ MSDetectorFileOutput::MSDetectorFileOutput(const std::string& id,
             throw ProcessError("Unknown edge '" + edgeID + "' given as nextEdges in detector '" + id + "'");
         }
     }
+    PerformanceCounters::added(PerformanceCounters::DETECTORS, sizeof(MSDetectorFileOutput));
 }
 
 
@@ -29,6 +29,7 @@
 
 #include <utils/common/Named.h>
 #include <utils/common/Parameterised.h>
+#include <utils/common/PerformanceCounters.h>
 #include <utils/common/SUMOTime.h>
 #include <microsim/MSNet.h>
 
@@ -37,6 +38,7 @@
 // class declarations
 // ===========================================================================
 class OutputDevice;
+class MSFCDColumnarWriter;
 class GUIDetectorWrapper;
 class SUMOTrafficObject;
 class MSTransportable;
@@ -65,7 +67,9 @@ public:
     MSDetectorFileOutput(const std::string& id, const std::string& vTypes, const std::string& nextEdges = "", const int detectPersons = false);
 
     /// @brief (virtual) destructor
-    virtual ~MSDetectorFileOutput() { }
+    virtual ~MSDetectorFileOutput() {
+        PerformanceCounters::removed(PerformanceCounters::DETECTORS, sizeof(MSDetectorFileOutput));
+    }
 
 
     /// @name Virtual methods to implement by derived classes
@@ -81,6 +85,30 @@ public:
                                 SUMOTime startTime, SUMOTime stopTime) = 0;
 
 
+    /** @brief Whether the detector can write its output in columnar format
+     * @see writeColumnarOutput
+     */
+    virtual bool hasColumnarOutput() const {
+        return false;
+    }
+
+
+    /** @brief Write the generated output as one row of a columnar file
+     *
+     * Only called if hasColumnarOutput returns true. The columns are named
+     *  like the attributes of the xml output.
+     *
+     * @param[in] into The writer collecting the rows of the interval
+     * @param[in] startTime First time step the data were gathered
+     * @param[in] stopTime Last time step the data were gathered
+     */
+    virtual void writeColumnarOutput(MSFCDColumnarWriter& into, SUMOTime startTime, SUMOTime stopTime) {
+        UNUSED_PARAMETER(into);
+        UNUSED_PARAMETER(startTime);
+        UNUSED_PARAMETER(stopTime);
+    }
+
+
     /** @brief Open the XML-output
      *
      * The implementing function should open an xml element using
@@ -49,6 +49,7 @@
 #include <microsim/MSVehicleType.h>
 #include <microsim/transportables/MSTransportable.h>
 #include <microsim/transportables/MSPModel.h>
+#include "MSFCDColumnarWriter.h"
 #include "MSE2Collector.h"
 
 //#define DEBUG_E2_CONSTRUCTOR
@@ -629,7 +630,7 @@ MSE2Collector::notifyMove(SUMOTrafficObject& veh, double oldPos,
 #ifdef HAVE_FOX
     ScopedLocker<> lock(myNotificationMutex, MSGlobals::gNumSimThreads > 1);
 #endif
-    VehicleInfoMap::iterator vi = myVehicleInfos.find(veh.getID());
+    VehicleInfoMap::iterator vi = findVehicleInfo(getVehicleInfoKey(veh));
     if (vi == myVehicleInfos.end()) {
         const std::string objectType = veh.isPerson() ? "Person" : "Vehicle";
         if (myNextEdges.size() > 0) {
@@ -640,7 +641,6 @@ MSE2Collector::notifyMove(SUMOTrafficObject& veh, double oldPos,
         return false;
     }
 
-    const std::string& vehID = veh.getID();
     VehicleInfo& vehInfo = *(vi->second);
 
     // position relative to the detector start
@@ -653,7 +653,7 @@ MSE2Collector::notifyMove(SUMOTrafficObject& veh, double oldPos,
     if (DEBUG_COND) {
         std::cout << "\n" << SIMTIME
                   << " MSE2Collector::notifyMove() (detID = " << myID << " on lane '" << myLane->getID() << "')"
-                  << " called by vehicle '" << vehID << "'"
+                  << " called by vehicle '" << veh.getID() << "'"
                   << " at relative position " << relPos
                   << ", distToDetectorEnd = " << vehInfo.distToDetectorEnd << std::endl;
     }
@@ -699,7 +699,7 @@ MSE2Collector::notifyMove(SUMOTrafficObject& veh, double oldPos,
         }
 #endif
         // Vehicle is beyond the detector, unsubscribe and register removal from myVehicleInfos
-        myLeftVehicles.insert(vehID);
+        myLeftVehicles.insert(vi->first);
         return false;
     } else {
         // Receive further notifications
@@ -730,7 +730,7 @@ MSE2Collector::notifyLeave(SUMOTrafficObject& veh, double /*lastPos*/, MSMoveRem
 
         if (enteredLane == nullptr || std::find(myLanes.begin(), myLanes.end(), enteredLane->getID()) == myLanes.end()) {
             // Entered lane is not part of the detector
-            VehicleInfoMap::iterator vi = myVehicleInfos.find(veh.getID());
+            VehicleInfoMap::iterator vi = findVehicleInfo(getVehicleInfoKey(veh));
             // Determine exit offset, where vehicle left the detector
             double exitOffset = vi->second->entryOffset - myOffsets[vi->second->currentOffsetIndex] - vi->second->currentLane->getLength();
             vi->second->exitOffset = MAX2(vi->second->exitOffset, exitOffset);
@@ -743,7 +743,7 @@ MSE2Collector::notifyLeave(SUMOTrafficObject& veh, double /*lastPos*/, MSMoveRem
 
         return true;
     } else {
-        VehicleInfoMap::iterator vi = myVehicleInfos.find(veh.getID());
+        VehicleInfoMap::iterator vi = findVehicleInfo(getVehicleInfoKey(veh));
         if (vi != myVehicleInfos.end()) {
             // erase vehicle, which leaves in a non-longitudinal way, immediately
             if (vi->second->hasEntered) {
@@ -821,8 +821,8 @@ MSE2Collector::notifyEnter(SUMOTrafficObject& veh, MSMoveReminder::Notification
 #ifdef HAVE_FOX
     ScopedLocker<> lock(myNotificationMutex, MSGlobals::gNumSimThreads > 1);
 #endif
-    const std::string& vehID = veh.getID();
-    VehicleInfoMap::iterator vi = myVehicleInfos.find(vehID);
+    const SUMOTrafficObject::NumericalID key = getVehicleInfoKey(veh);
+    VehicleInfoMap::iterator vi = findVehicleInfo(key);
     if (vi != myVehicleInfos.end()) {
         // Register move current offset to the next lane
         if (vi->second->currentLane != enteredLane) {
@@ -853,7 +853,8 @@ MSE2Collector::notifyEnter(SUMOTrafficObject& veh, MSMoveReminder::Notification
 #endif
 
     // Add vehicle info
-    myVehicleInfos.insert(std::make_pair(vehID, makeVehicleInfo(veh, enteredLane)));
+    myVehicleInfos.insert(std::lower_bound(myVehicleInfos.begin(), myVehicleInfos.end(), std::make_pair(key, (VehicleInfo*)nullptr)),
+                          std::make_pair(key, makeVehicleInfo(veh, enteredLane)));
     // Subscribe to vehicle's movement notifications
     return true;
 }
@@ -882,6 +883,16 @@ MSE2Collector::makeVehicleInfo(const SUMOTrafficObject& veh, const MSLane* enter
 }
 
 
+MSE2Collector::VehicleInfoMap::iterator
+MSE2Collector::findVehicleInfo(SUMOTrafficObject::NumericalID key) {
+    VehicleInfoMap::iterator it = std::lower_bound(myVehicleInfos.begin(), myVehicleInfos.end(), std::make_pair(key, (VehicleInfo*)nullptr));
+    if (it != myVehicleInfos.end() && it->first == key) {
+        return it;
+    }
+    return myVehicleInfos.end();
+}
+
+
 void
 MSE2Collector::notifyMovePerson(MSTransportable* p, int dir, double pos) {
     if (personApplies(*p, dir)) {
@@ -948,9 +959,8 @@ MSE2Collector::detectorUpdate(const SUMOTime /* step */) {
 
     // go through the list of vehicles positioned on the detector
     for (std::vector<MoveNotificationInfo*>::iterator i = myMoveNotifications.begin(); i != myMoveNotifications.end(); ++i) {
-        // The ID of the vehicle that has sent this notification in the last step
-        const std::string& vehID = (*i)->id;
-        VehicleInfoMap::iterator vi = myVehicleInfos.find(vehID);
+        // The vehicle that has sent this notification in the last step
+        VehicleInfoMap::iterator vi = findVehicleInfo((*i)->key);
 
         if (vi == myVehicleInfos.end()) {
             // The vehicle has already left the detector by lanechange, teleport, etc. (not longitudinal)
@@ -997,17 +1007,17 @@ MSE2Collector::detectorUpdate(const SUMOTime /* step */) {
     }
 #endif
 // Remove the vehicles that have left the detector
-    std::set<std::string>::const_iterator i;
+    std::set<SUMOTrafficObject::NumericalID>::const_iterator i;
     for (i = myLeftVehicles.begin(); i != myLeftVehicles.end(); ++i) {
-        VehicleInfoMap::iterator j = myVehicleInfos.find(*i);
-        delete j->second;
-        myVehicleInfos.erase(*i);
-        myNumberOfLeftVehicles++;
+        VehicleInfoMap::iterator j = findVehicleInfo(*i);
 #ifdef DEBUG_E2_DETECTOR_UPDATE
         if (DEBUG_COND) {
-            std::cout << "Erased vehicle '" << *i << "'" << std::endl;
+            std::cout << "Erased vehicle '" << j->second->id << "'" << std::endl;
         }
 #endif
+        delete j->second;
+        myVehicleInfos.erase(j);
+        myNumberOfLeftVehicles++;
     }
     myLeftVehicles.clear();
 
@@ -1121,7 +1131,7 @@ MSE2Collector::makeMoveNotification(const SUMOTrafficObject& veh, double oldPos,
 #endif
 
     /* Store new infos */
-    return new MoveNotificationInfo(veh.getID(), oldPos, newPos, newSpeed, veh.getAcceleration(),
+    return new MoveNotificationInfo(veh.getID(), getVehicleInfoKey(veh), oldPos, newPos, newSpeed, veh.getAcceleration(),
                                     myDetectorLength - (vehInfo.entryOffset + newPos),
                                     timeOnDetector, lengthOnDetector, timeLoss, stillOnDetector);
 }
@@ -1358,10 +1368,7 @@ void
 MSE2Collector::writeXMLOutput(OutputDevice& dev, SUMOTime startTime, SUMOTime stopTime) {
     const double meanSpeed = getIntervalMeanSpeed();
     const double meanOccupancy = getIntervalOccupancy();
-    myPreviousMeanOccupancy = meanOccupancy;
-    myPreviousMeanSpeed = meanSpeed;
-    myPreviousMaxJamLengthInMeters = myMaxJamInMeters;
-    myPreviousNumberOfSeenVehicles = myNumberOfSeenVehicles;
+    storePreviousValues(meanSpeed, meanOccupancy);
 
     if (dev.isNull()) {
         reset();
@@ -1377,32 +1384,12 @@ MSE2Collector::writeXMLOutput(OutputDevice& dev, SUMOTime startTime, SUMOTime st
 
     SUMOTime haltingDurationSum = 0;
     SUMOTime maxHaltingDuration = 0;
-    int haltingNo = 0;
-    for (std::vector<SUMOTime>::iterator i = myPastStandingDurations.begin(); i != myPastStandingDurations.end(); ++i) {
-        haltingDurationSum += (*i);
-        maxHaltingDuration = MAX2(maxHaltingDuration, (*i));
-        haltingNo++;
-    }
-    for (std::map<std::string, SUMOTime> ::iterator i = myHaltingVehicleDurations.begin(); i != myHaltingVehicleDurations.end(); ++i) {
-        haltingDurationSum += (*i).second;
-        maxHaltingDuration = MAX2(maxHaltingDuration, (*i).second);
-        haltingNo++;
-    }
+    const int haltingNo = sumHaltingDurations(myPastStandingDurations, myHaltingVehicleDurations, haltingDurationSum, maxHaltingDuration);
     const SUMOTime meanHaltingDuration = haltingNo != 0 ? haltingDurationSum / haltingNo : 0;
 
     SUMOTime intervalHaltingDurationSum = 0;
     SUMOTime intervalMaxHaltingDuration = 0;
-    int intervalHaltingNo = 0;
-    for (std::vector<SUMOTime>::iterator i = myPastIntervalStandingDurations.begin(); i != myPastIntervalStandingDurations.end(); ++i) {
-        intervalHaltingDurationSum += (*i);
-        intervalMaxHaltingDuration = MAX2(intervalMaxHaltingDuration, (*i));
-        intervalHaltingNo++;
-    }
-    for (std::map<std::string, SUMOTime> ::iterator i = myIntervalHaltingVehicleDurations.begin(); i != myIntervalHaltingVehicleDurations.end(); ++i) {
-        intervalHaltingDurationSum += (*i).second;
-        intervalMaxHaltingDuration = MAX2(intervalMaxHaltingDuration, (*i).second);
-        intervalHaltingNo++;
-    }
+    const int intervalHaltingNo = sumHaltingDurations(myPastIntervalStandingDurations, myIntervalHaltingVehicleDurations, intervalHaltingDurationSum, intervalMaxHaltingDuration);
     const SUMOTime intervalMeanHaltingDuration = intervalHaltingNo != 0 ? intervalHaltingDurationSum / intervalHaltingNo : 0;
 
 #ifdef DEBUG_E2_XML_OUT
@@ -1447,6 +1434,71 @@ MSE2Collector::writeXMLOutput(OutputDevice& dev, SUMOTime startTime, SUMOTime st
     reset();
 }
 
+
+void
+MSE2Collector::writeColumnarOutput(MSFCDColumnarWriter& into, SUMOTime startTime, SUMOTime stopTime) {
+    const double meanSpeed = getIntervalMeanSpeed();
+    const double meanOccupancy = getIntervalOccupancy();
+    storePreviousValues(meanSpeed, meanOccupancy);
+    SUMOTime haltingDurationSum = 0;
+    SUMOTime maxHaltingDuration = 0;
+    const int haltingNo = sumHaltingDurations(myPastStandingDurations, myHaltingVehicleDurations, haltingDurationSum, maxHaltingDuration);
+    SUMOTime intervalHaltingDurationSum = 0;
+    SUMOTime intervalMaxHaltingDuration = 0;
+    const int intervalHaltingNo = sumHaltingDurations(myPastIntervalStandingDurations, myIntervalHaltingVehicleDurations, intervalHaltingDurationSum, intervalMaxHaltingDuration);
+    into.openTag(SUMO_TAG_INTERVAL);
+    into.writeAttr(SUMO_ATTR_BEGIN, STEPS2TIME(startTime)).writeAttr(SUMO_ATTR_END, STEPS2TIME(stopTime)).writeAttr(SUMO_ATTR_ID, getID());
+    into.writeAttr("sampledSeconds", myVehicleSamples);
+    into.writeAttr("nVehEntered", myNumberOfEnteredVehicles);
+    into.writeAttr("nVehLeft", myNumberOfLeftVehicles);
+    into.writeAttr("nVehSeen", myNumberOfSeenVehicles);
+    into.writeAttr("meanSpeed", meanSpeed);
+    into.writeAttr("meanTimeLoss", myNumberOfSeenVehicles != 0 ? myTotalTimeLoss / myNumberOfSeenVehicles : -1);
+    into.writeAttr("meanOccupancy", meanOccupancy);
+    into.writeAttr("maxOccupancy", myMaxOccupancy);
+    into.writeAttr("meanMaxJamLengthInVehicles", myTimeSamples != 0 ? myMeanMaxJamInVehicles / (double) myTimeSamples : 0);
+    into.writeAttr("meanMaxJamLengthInMeters", myTimeSamples != 0 ? myMeanMaxJamInMeters / (double) myTimeSamples : 0);
+    into.writeAttr("maxJamLengthInVehicles", myMaxJamInVehicles);
+    into.writeAttr("maxJamLengthInMeters", myMaxJamInMeters);
+    into.writeAttr("jamLengthInVehiclesSum", myJamLengthInVehiclesSum);
+    into.writeAttr("jamLengthInMetersSum", myJamLengthInMetersSum);
+    into.writeAttr("meanHaltingDuration", STEPS2TIME(haltingNo != 0 ? haltingDurationSum / haltingNo : 0));
+    into.writeAttr("maxHaltingDuration", STEPS2TIME(maxHaltingDuration));
+    into.writeAttr("haltingDurationSum", STEPS2TIME(haltingDurationSum));
+    into.writeAttr("meanIntervalHaltingDuration", STEPS2TIME(intervalHaltingNo != 0 ? intervalHaltingDurationSum / intervalHaltingNo : 0));
+    into.writeAttr("maxIntervalHaltingDuration", STEPS2TIME(intervalMaxHaltingDuration));
+    into.writeAttr("intervalHaltingDurationSum", STEPS2TIME(intervalHaltingDurationSum));
+    into.writeAttr("startedHalts", myStartedHalts);
+    into.writeAttr("meanVehicleNumber", myTimeSamples != 0 ? (double) myMeanVehicleNumber / (double) myTimeSamples : 0);
+    into.writeAttr("maxVehicleNumber", myMaxVehicleNumber);
+    into.closeTag();
+    reset();
+}
+
+
+int
+MSE2Collector::sumHaltingDurations(const std::vector<SUMOTime>& past, const std::map<std::string, SUMOTime>& ongoing,
+                                   SUMOTime& sum, SUMOTime& maxDuration) {
+    for (const SUMOTime duration : past) {
+        sum += duration;
+        maxDuration = MAX2(maxDuration, duration);
+    }
+    for (const auto& item : ongoing) {
+        sum += item.second;
+        maxDuration = MAX2(maxDuration, item.second);
+    }
+    return (int)(past.size() + ongoing.size());
+}
+
+
+void
+MSE2Collector::storePreviousValues(double meanSpeed, double meanOccupancy) {
+    myPreviousMeanOccupancy = meanOccupancy;
+    myPreviousMeanSpeed = meanSpeed;
+    myPreviousMaxJamLengthInMeters = myMaxJamInMeters;
+    myPreviousNumberOfSeenVehicles = myNumberOfSeenVehicles;
+}
+
 void
 MSE2Collector::reset() {
     myVehicleSamples = 0;
@@ -1520,6 +1572,10 @@ MSE2Collector::getCurrentVehicles() const {
             res.push_back(i->second);
         }
     }
+    // keep the order of the vehicle ids (the infos are sorted by numerical id)
+    std::sort(res.begin(), res.end(), [](const VehicleInfo * const a, const VehicleInfo * const b) {
+        return a->id < b->id;
+    });
     return res;
 }
 
@@ -1532,17 +1588,14 @@ MSE2Collector::getEstimatedCurrentVehicleNumber(double speedThreshold) const {
     double thresholdSpeed = myLane->getSpeedLimit() / speedThreshold;
 
     int count = 0;
-    for (VehicleInfoMap::const_iterator it = myVehicleInfos.begin();
-            it != myVehicleInfos.end(); it++) {
-        if (it->second->onDetector) {
-            //            if (it->position < distance) {
-            //                distance = it->position;
-            //            }
-            //            const double realDistance = myLane->getLength() - distance; // the closer vehicle get to the light the greater is the distance
-            const double realDistance = it->second->distToDetectorEnd;
-            if (it->second->lastSpeed <= thresholdSpeed || it->second->lastAccel > 0) { //TODO speed less half of the maximum speed for the lane NEED TUNING
-                count = (int)(realDistance / (it->second->length + it->second->minGap)) + 1;
-            }
+    for (const VehicleInfo* const vi : getCurrentVehicles()) {
+        //            if (it->position < distance) {
+        //                distance = it->position;
+        //            }
+        //            const double realDistance = myLane->getLength() - distance; // the closer vehicle get to the light the greater is the distance
+        const double realDistance = vi->distToDetectorEnd;
+        if (vi->lastSpeed <= thresholdSpeed || vi->lastAccel > 0) { //TODO speed less half of the maximum speed for the lane NEED TUNING
+            count = (int)(realDistance / (vi->length + vi->minGap)) + 1;
         }
     }
 
@@ -1559,27 +1612,24 @@ MSE2Collector::getEstimateQueueLength() const {
     double distance = std::numeric_limits<double>::max();
     double realDistance = 0;
     bool flowing =  true;
-    for (VehicleInfoMap::const_iterator it = myVehicleInfos.begin();
-            it != myVehicleInfos.end(); it++) {
-        if (it->second->onDetector) {
-            distance = MIN2(it->second->lastPos, distance);
-            //  double distanceTemp = myLane->getLength() - distance;
-            if (it->second->lastSpeed <= 0.5) {
-                realDistance = distance - it->second->length + it->second->minGap;
-                flowing = false;
-            }
-            //            DBG(
-            //                std::ostringstream str;
-            //                str << time2string(MSNet::getInstance()->getCurrentTimeStep())
-            //                << " MSE2Collector::getEstimateQueueLength::"
-            //                << " lane " << myLane->getID()
-            //                << " vehicle " << it->second.id
-            //                << " positionOnLane " << it->second.position
-            //                << " vel " << it->second.speed
-            //                << " realDistance " << realDistance;
-            //                WRITE_MESSAGE(str.str());
-            //            )
+    for (const VehicleInfo* const vi : getCurrentVehicles()) {
+        distance = MIN2(vi->lastPos, distance);
+        //  double distanceTemp = myLane->getLength() - distance;
+        if (vi->lastSpeed <= 0.5) {
+            realDistance = distance - vi->length + vi->minGap;
+            flowing = false;
         }
+        //            DBG(
+        //                std::ostringstream str;
+        //                str << time2string(MSNet::getInstance()->getCurrentTimeStep())
+        //                << " MSE2Collector::getEstimateQueueLength::"
+        //                << " lane " << myLane->getID()
+        //                << " vehicle " << it->second.id
+        //                << " positionOnLane " << it->second.position
+        //                << " vel " << it->second.speed
+        //                << " realDistance " << realDistance;
+        //                WRITE_MESSAGE(str.str());
+        //            )
     }
     if (flowing) {
         return 0;
@@ -148,7 +148,8 @@ public:
         double lastPos;
     };
 
-    typedef std::map<std::string, VehicleInfo*> VehicleInfoMap;
+    /// @brief the vehicle infos sorted by a numerical key (see getVehicleInfoKey)
+    typedef std::vector<std::pair<SUMOTrafficObject::NumericalID, VehicleInfo*> > VehicleInfoMap;
 
 
 private:
@@ -157,8 +158,9 @@ private:
      *          temporarily stored in myMoveNotifications for each step.
     */
     struct MoveNotificationInfo {
-        MoveNotificationInfo(std::string _vehID, double _oldPos, double _newPos, double _speed, double _accel, double _distToDetectorEnd, double _timeOnDetector, double _lengthOnDetector, double _timeLoss, bool _onDetector) :
+        MoveNotificationInfo(std::string _vehID, SUMOTrafficObject::NumericalID _key, double _oldPos, double _newPos, double _speed, double _accel, double _distToDetectorEnd, double _timeOnDetector, double _lengthOnDetector, double _timeLoss, bool _onDetector) :
             id(_vehID),
+            key(_key),
             oldPos(_oldPos),
             newPos(_newPos),
             speed(_speed),
@@ -173,6 +175,8 @@ private:
 
         /// Vehicle's id
         std::string id;
+        /// Vehicle's key in myVehicleInfos
+        SUMOTrafficObject::NumericalID key;
         /// Position before the last integration step (relative to the vehicle's entry lane on the detector)
         double oldPos;
         /// Position after the last integration step (relative to the vehicle's entry lane on the detector)
@@ -351,6 +355,18 @@ public:
     virtual void writeXMLOutput(OutputDevice& dev, SUMOTime startTime, SUMOTime stopTime);
 
 
+    /// @brief lane area detectors support columnar output
+    bool hasColumnarOutput() const {
+        return true;
+    }
+
+
+    /** @brief Writes collected values as one row of a columnar file
+     * @see MSDetectorFileOutput::writeColumnarOutput
+     */
+    virtual void writeColumnarOutput(MSFCDColumnarWriter& into, SUMOTime startTime, SUMOTime stopTime);
+
+
     /** @brief Open the XML-output
      *
      * The implementing function should open an xml element using
@@ -671,6 +687,14 @@ private:
      */
     VehicleInfo* makeVehicleInfo(const SUMOTrafficObject& veh, const MSLane* enteredLane) const;
 
+    /// @brief the key of the vehicle or person in myVehicleInfos (persons and vehicles are numbered independently)
+    static SUMOTrafficObject::NumericalID getVehicleInfoKey(const SUMOTrafficObject& veh) {
+        return veh.isPerson() ? -1 - veh.getNumericalID() : veh.getNumericalID();
+    }
+
+    /// @brief the entry of myVehicleInfos with the given key or myVehicleInfos.end()
+    VehicleInfoMap::iterator findVehicleInfo(SUMOTrafficObject::NumericalID key);
+
     /** @brief Calculates the time loss for a segment with constant vmax
      *
      * @param timespan time needed to cover the segment
@@ -689,6 +713,19 @@ private:
 
     void notifyMovePerson(MSTransportable* p, int dir, double pos);
 
+    /** @brief Sums up the finished and the ongoing halting durations
+     * @param[in] past The durations of the finished halts
+     * @param[in] ongoing The durations of the ongoing halts
+     * @param[out] sum The sum of all durations
+     * @param[out] maxDuration The maximum duration
+     * @return The number of halts
+     */
+    static int sumHaltingDurations(const std::vector<SUMOTime>& past, const std::map<std::string, SUMOTime>& ongoing,
+                                   SUMOTime& sum, SUMOTime& maxDuration);
+
+    /// @brief stores the values of the finished interval which are retrievable afterwards
+    void storePreviousValues(double meanSpeed, double meanOccupancy);
+
 private:
 
     /// @brief Information about how this detector is used
@@ -734,7 +771,7 @@ private:
     /// @brief Keep track of vehicles that left the detector by a regular move along a junction (not lanechange, teleport, etc.)
     ///        and should be removed from myVehicleInfos after taking into account their movement. Non-longitudinal exits
     ///        are processed immediately in notifyLeave()
-    std::set<std::string> myLeftVehicles;
+    std::set<SUMOTrafficObject::NumericalID> myLeftVehicles;
 
     /// @brief Storage for halting durations of known vehicles (for halting vehicles)
     std::map<std::string, SUMOTime> myHaltingVehicleDurations;
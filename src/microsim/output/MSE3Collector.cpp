@@ -24,6 +24,7 @@
 #include <config.h>
 
 #include <algorithm>
+#include <iterator>
 #ifdef HAVE_FOX
 #include <utils/common/ScopedLocker.h>
 #endif
@@ -47,6 +48,36 @@
 //#define DEBUG_COND_VEH(veh) (true)
 
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+struct MSE3Collector::EventBuffer {
+    EventBuffer() {
+        std::lock_guard<std::mutex> lock(myEventBufferMutex);
+        myEventBuffers.push_back(this);
+    }
+    ~EventBuffer() {
+        std::lock_guard<std::mutex> lock(myEventBufferMutex);
+        myEventBuffers.erase(std::find(myEventBuffers.begin(), myEventBuffers.end(), this));
+    }
+    typedef std::pair<MSE3Collector*, const SUMOTrafficObject*> Key;
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return std::hash<const void*>()(key.first) ^ (std::hash<const void*>()(key.second) << 1);
+        }
+    };
+    /// @brief the current values of the changed vehicles (the first member is false if the vehicle is not within the area anymore)
+    std::unordered_map<Key, std::pair<bool, E3Values>, KeyHash> changed;
+    /// @brief the values of the vehicles which left an area
+    std::vector<std::pair<Key, E3Values> > left;
+};
+
+bool MSE3Collector::myDeferEvents = false;
+std::vector<MSE3Collector::EventBuffer*> MSE3Collector::myEventBuffers;
+std::mutex MSE3Collector::myEventBufferMutex;
+thread_local MSE3Collector::EventBuffer MSE3Collector::myThreadEventBuffer;
+
+
 // ===========================================================================
 // method definitions
 // ===========================================================================
@@ -76,11 +107,10 @@ MSE3Collector::MSE3EntryReminder::notifyEnter(SUMOTrafficObject& veh, Notificati
         const double posOnLane = veh.getBackPositionOnLane(enteredLane) + veh.getVehicleType().getLength();
         if (myLane == enteredLane && posOnLane > myPosition) {
 #ifdef HAVE_FOX
-            ScopedLocker<> lock(myCollector.myContainerMutex, MSGlobals::gNumSimThreads > 1);
+            ScopedLocker<> lock(myCollector.myContainerMutex, needsLock());
 #endif
-            const auto& itVeh = myCollector.myEnteredContainer.find(&veh);
-            if (itVeh == myCollector.myEnteredContainer.end() ||
-                    itVeh->second.entryReminder != this) {
+            const E3Values* const values = myCollector.findEntered(veh);
+            if (values == nullptr || values->entryReminder != this) {
 #ifdef DEBUG_E3_NOTIFY_ENTER
                 if (DEBUG_COND(myCollector) && DEBUG_COND_VEH(veh)) {
                     std::cout << "  assume already known\n";
@@ -109,9 +139,9 @@ MSE3Collector::MSE3EntryReminder::notifyMove(SUMOTrafficObject& veh, double oldP
     }
 #endif
 #ifdef HAVE_FOX
-    ScopedLocker<> lock(myCollector.myContainerMutex, MSGlobals::gNumSimThreads > 1);
+    ScopedLocker<> lock(myCollector.myContainerMutex, needsLock());
 #endif
-    if ((myCollector.myEnteredContainer.find(&veh) == myCollector.myEnteredContainer.end() ||
+    if ((myCollector.findEntered(veh) == nullptr ||
             (veh.isPerson() && dynamic_cast<const MSTransportable&>(veh).getDirection() != MSPModel::FORWARD))
             && newPos > myPosition) {
         if (oldPos > myPosition) {
@@ -154,9 +184,9 @@ MSE3Collector::MSE3EntryReminder::notifyLeave(SUMOTrafficObject& veh, double, MS
 #endif
     if (reason >= MSMoveReminder::NOTIFICATION_ARRIVED) {
 #ifdef HAVE_FOX
-        ScopedLocker<> lock(myCollector.myContainerMutex, MSGlobals::gNumSimThreads > 1);
+        ScopedLocker<> lock(myCollector.myContainerMutex, needsLock());
 #endif
-        if (myCollector.myEnteredContainer.erase(&veh) > 0) {
+        if (myCollector.eraseEntered(veh)) {
             if (!myCollector.myExpectArrival) {
                 WRITE_WARNINGF("Vehicle '%' arrived inside % '%'.", veh.getID(), toString(SUMO_TAG_E3DETECTOR), myCollector.getID());
             }
@@ -224,7 +254,7 @@ MSE3Collector::MSE3LeaveReminder::notifyMove(SUMOTrafficObject& veh, double oldP
         return true;
     }
 #ifdef HAVE_FOX
-    ScopedLocker<> lock(myCollector.myContainerMutex, MSGlobals::gNumSimThreads > 1);
+    ScopedLocker<> lock(myCollector.myContainerMutex, needsLock());
 #endif
     const double oldSpeed = veh.getPreviousSpeed();
     if (oldPos < myPosition) {
@@ -280,15 +310,15 @@ MSE3Collector::MSE3LeaveReminder::notifyLeave(SUMOTrafficObject&  veh, double /*
         return false;
     }
 #ifdef HAVE_FOX
-    ScopedLocker<> lock(myCollector.myContainerMutex, MSGlobals::gNumSimThreads > 1);
+    ScopedLocker<> lock(myCollector.myContainerMutex, needsLock());
 #endif
     if (reason == MSMoveReminder::NOTIFICATION_TELEPORT) {
         WRITE_WARNINGF("Vehicle '%' teleported from % '%'.", veh.getID(), toString(SUMO_TAG_E3DETECTOR), myCollector.getID());
-        myCollector.myEnteredContainer.erase(&veh);
+        myCollector.eraseEntered(veh);
         return false;
     }
     if (reason >= MSMoveReminder::NOTIFICATION_ARRIVED) {
-        if (myCollector.myEnteredContainer.erase(&veh) > 0) {
+        if (myCollector.eraseEntered(veh)) {
             if (!myCollector.myExpectArrival) {
                 WRITE_WARNINGF("Vehicle '%' arrived inside % '%'.", veh.getID(), toString(SUMO_TAG_E3DETECTOR), myCollector.getID());
             }
@@ -364,7 +394,7 @@ MSE3Collector::enter(const SUMOTrafficObject& veh, const double entryTimestep, c
         leave(veh, entryTimestep, fractionTimeOnDet, true);
         return;
     }
-    if (myEnteredContainer.find(&veh) != myEnteredContainer.end()) {
+    if (findEntered(veh) != nullptr) {
         WRITE_WARNINGF("Vehicle '%' reentered % '%'.", veh.getID(), toString(SUMO_TAG_E3DETECTOR), getID());
         return;
     }
@@ -393,7 +423,7 @@ MSE3Collector::enter(const SUMOTrafficObject& veh, const double entryTimestep, c
         v.intervalTimeLoss = v.timeLoss;
     }
     v.entryReminder = entryReminder;
-    myEnteredContainer[&veh] = v;
+    setEntered(veh, v);
 }
 
 
@@ -409,12 +439,15 @@ MSE3Collector::leaveFront(const SUMOTrafficObject& veh, const double leaveTimest
     if (!vehicleApplies(veh)) {
         return;
     }
-    if (myEnteredContainer.find(&veh) == myEnteredContainer.end()) {
+    const E3Values* const entered = findEntered(veh);
+    if (entered == nullptr) {
         if (!myOpenEntry && veh.isVehicle()) {
             WRITE_WARNINGF("Vehicle '%' left % '%' without entering it.", veh.getID(), toString(SUMO_TAG_E3DETECTOR), getID());
         }
     } else {
-        myEnteredContainer[&veh].frontLeaveTime = leaveTimestep;
+        E3Values values = *entered;
+        values.frontLeaveTime = leaveTimestep;
+        setEntered(veh, values);
     }
 }
 
@@ -437,7 +470,8 @@ MSE3Collector::leave(const SUMOTrafficObject& veh, const double leaveTimestep, c
         enter(veh, leaveTimestep, fractionTimeOnDet, nullptr, true);
         return;
     }
-    if (myEnteredContainer.find(&veh) == myEnteredContainer.end()) {
+    const E3Values* const entered = findEntered(veh);
+    if (entered == nullptr) {
         if (!myOpenEntry && veh.isVehicle()) {
             WRITE_WARNINGF("Vehicle '%' left % '%' without entering it.", veh.getID(), toString(SUMO_TAG_E3DETECTOR), getID());
         }
@@ -445,7 +479,7 @@ MSE3Collector::leave(const SUMOTrafficObject& veh, const double leaveTimestep, c
 #ifdef DEBUG_E3_NOTIFY_LEAVE
         std::cout << veh.getID() << " leaves\n";
 #endif
-        E3Values values = myEnteredContainer[&veh];
+        E3Values values = *entered;
         values.backLeaveTime = leaveTimestep;
         const double speedFraction = veh.getSpeed() * (TS - fractionTimeOnDet);
         values.speedSum -= speedFraction;
@@ -461,12 +495,129 @@ MSE3Collector::leave(const SUMOTrafficObject& veh, const double leaveTimestep, c
             // timeLoss was initialized when entering
             values.timeLoss = dynamic_cast<const MSVehicle&>(veh).getTimeLoss() - values.timeLoss;
         }
-        myEnteredContainer.erase(&veh);
+        eraseEntered(veh);
+        addLeft(veh, values);
+    }
+}
+
+
+const MSE3Collector::E3Values*
+MSE3Collector::findEntered(const SUMOTrafficObject& veh) {
+    if (myDeferEvents) {
+        const auto it = myThreadEventBuffer.changed.find(std::make_pair(this, &veh));
+        if (it != myThreadEventBuffer.changed.end()) {
+            return it->second.first ? &it->second.second : nullptr;
+        }
+    }
+    const auto it = myEnteredIndex.find(&veh);
+    return it == myEnteredIndex.end() ? nullptr : &myEnteredContainer[it->second].second;
+}
+
+
+void
+MSE3Collector::setEntered(const SUMOTrafficObject& veh, const E3Values& values) {
+    if (myDeferEvents) {
+        myThreadEventBuffer.changed[std::make_pair(this, &veh)] = std::make_pair(true, values);
+        return;
+    }
+    const auto it = myEnteredIndex.find(&veh);
+    if (it == myEnteredIndex.end()) {
+        myEnteredIndex[&veh] = (int)myEnteredContainer.size();
+        myEnteredContainer.push_back(std::make_pair(&veh, values));
+    } else {
+        myEnteredContainer[it->second].second = values;
+    }
+}
+
+
+bool
+MSE3Collector::eraseEntered(const SUMOTrafficObject& veh) {
+    if (myDeferEvents) {
+        if (findEntered(veh) == nullptr) {
+            return false;
+        }
+        myThreadEventBuffer.changed[std::make_pair(this, &veh)] = std::make_pair(false, E3Values());
+        return true;
+    }
+    const auto it = myEnteredIndex.find(&veh);
+    if (it == myEnteredIndex.end()) {
+        return false;
+    }
+    const int index = it->second;
+    myEnteredIndex.erase(it);
+    if (index + 1 < (int)myEnteredContainer.size()) {
+        myEnteredContainer[index] = myEnteredContainer.back();
+        myEnteredIndex[myEnteredContainer[index].first] = index;
+    }
+    myEnteredContainer.pop_back();
+    return true;
+}
+
+
+void
+MSE3Collector::addLeft(const SUMOTrafficObject& veh, const E3Values& values) {
+    if (myDeferEvents) {
+        myThreadEventBuffer.left.push_back(std::make_pair(std::make_pair(this, &veh), values));
+    } else {
         myLeftContainer.push_back(values);
     }
 }
 
 
+bool
+MSE3Collector::needsLock() {
+    return MSGlobals::gNumSimThreads > 1 && !myDeferEvents;
+}
+
+
+void
+MSE3Collector::deferEvents() {
+    myDeferEvents = true;
+}
+
+
+void
+MSE3Collector::flushEvents() {
+    myDeferEvents = false;
+    std::vector<std::pair<EventBuffer::Key, std::pair<bool, E3Values> > > changed;
+    std::vector<std::pair<EventBuffer::Key, E3Values> > left;
+    {
+        std::lock_guard<std::mutex> lock(myEventBufferMutex);
+        for (EventBuffer* const buffer : myEventBuffers) {
+            changed.insert(changed.end(), buffer->changed.begin(), buffer->changed.end());
+            std::move(buffer->left.begin(), buffer->left.end(), std::back_inserter(left));
+            buffer->changed.clear();
+            buffer->left.clear();
+        }
+    }
+    // apply the changes in an order which does not depend on the threads
+    // (all changes of a vehicle come from the same thread, so the stable sort keeps their order)
+    auto before = [](const EventBuffer::Key & a, const EventBuffer::Key & b) {
+        if (a.second->isPerson() != b.second->isPerson()) {
+            return b.second->isPerson();
+        }
+        return a.second->getNumericalID() < b.second->getNumericalID();
+    };
+    std::sort(changed.begin(), changed.end(), [&before](const std::pair<EventBuffer::Key, std::pair<bool, E3Values> >& a, const std::pair<EventBuffer::Key, std::pair<bool, E3Values> >& b) {
+        return before(a.first, b.first);
+    });
+    std::stable_sort(left.begin(), left.end(), [&before](const std::pair<EventBuffer::Key, E3Values>& a, const std::pair<EventBuffer::Key, E3Values>& b) {
+        return before(a.first, b.first);
+    });
+    for (const auto& item : changed) {
+        MSE3Collector* const collector = item.first.first;
+        if (item.second.first) {
+            collector->setEntered(*item.first.second, item.second.second);
+        } else {
+            collector->eraseEntered(*item.first.second);
+        }
+    }
+    for (const auto& item : left) {
+        item.first.first->myLeftContainer.push_back(item.second);
+    }
+}
+
+
 void
 MSE3Collector::writeXMLOutput(OutputDevice& dev,
                               SUMOTime startTime, SUMOTime stopTime) {
@@ -503,7 +654,7 @@ MSE3Collector::writeXMLOutput(OutputDevice& dev,
     double meanIntervalHaltsPerVehicleWithin = 0.;
     double meanIntervalDurationWithin = 0.;
     double meanTimeLossWithin = 0.;
-    for (std::map<const SUMOTrafficObject*, E3Values>::iterator i = myEnteredContainer.begin(); i != myEnteredContainer.end(); ++i) {
+    for (auto i = myEnteredContainer.begin(); i != myEnteredContainer.end(); ++i) {
         meanHaltsPerVehicleWithin += (double)(*i).second.haltings;
         meanIntervalHaltsPerVehicleWithin += (double)(*i).second.intervalHaltings;
         const double end = (*i).second.backLeaveTime == 0 ? STEPS2TIME(stopTime) : (*i).second.backLeaveTime;
@@ -605,7 +756,7 @@ MSE3Collector::detectorUpdate(const SUMOTime step) {
 
     myCurrentMeanSpeed = 0;
     myCurrentHaltingsNumber = 0;
-    for (std::map<const SUMOTrafficObject*, E3Values>::iterator pair = myEnteredContainer.begin(); pair != myEnteredContainer.end(); ++pair) {
+    for (auto pair = myEnteredContainer.begin(); pair != myEnteredContainer.end(); ++pair) {
         const SUMOTrafficObject* veh = pair->first;
 #ifdef DEBUG_E3_DETECTORUPDATE
         //if (DEBUG_COND(*this) && DEBUG_COND_VEH(*veh)) {
@@ -675,7 +826,7 @@ MSE3Collector::getVehiclesWithin() const {
 std::vector<std::string>
 MSE3Collector::getCurrentVehicleIDs() const {
     std::vector<std::string> ret;
-    for (std::map<const SUMOTrafficObject*, E3Values>::const_iterator pair = myEnteredContainer.begin(); pair != myEnteredContainer.end(); ++pair) {
+    for (auto pair = myEnteredContainer.begin(); pair != myEnteredContainer.end(); ++pair) {
         ret.push_back((*pair).first->getID());
     }
     std::sort(ret.begin(), ret.end());
@@ -685,6 +836,7 @@ MSE3Collector::getCurrentVehicleIDs() const {
 void
 MSE3Collector::clearState(SUMOTime /* step */) {
     myEnteredContainer.clear();
+    myEnteredIndex.clear();
     myLeftContainer.clear();
 }
 
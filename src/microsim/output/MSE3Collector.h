@@ -26,6 +26,8 @@
 #include <string>
 #include <vector>
 #include <limits>
+#include <mutex>
+#include <unordered_map>
 #include <microsim/MSMoveReminder.h>
 #include <microsim/output/MSDetectorFileOutput.h>
 #include <utils/common/Named.h>
@@ -376,6 +378,18 @@ public:
     /** @brief Remove all vehicles before quick-loading state */
     virtual void clearState(SUMOTime step);
 
+    /** @brief Starts recording the changes of all collectors in per thread buffers
+     *
+     * Until flushEvents is called, the containers of all collectors are only read
+     *  and the worker threads record entering and leaving vehicles in their
+     *  own buffers, so moving vehicles over different detectors needs no lock.
+     *  All notifications of a vehicle must come from the same thread until then.
+     */
+    static void deferEvents();
+
+    /// @brief Applies the changes recorded since deferEvents to the collectors
+    static void flushEvents();
+
 protected:
     void notifyMovePerson(MSTransportable* p, MSMoveReminder* rem, double detPos, int dir, double pos);
 
@@ -437,8 +451,11 @@ protected:
         MSE3EntryReminder* entryReminder;
     };
 
-    /// @brief Container for vehicles that have entered the area
-    std::map<const SUMOTrafficObject*, E3Values> myEnteredContainer;
+    /// @brief Container for vehicles that have entered the area (in the order of entering, removal swaps with the last)
+    std::vector<std::pair<const SUMOTrafficObject*, E3Values> > myEnteredContainer;
+
+    /// @brief The position of the vehicles within myEnteredContainer
+    std::unordered_map<const SUMOTrafficObject*, int> myEnteredIndex;
 
     /// @brief Container for vehicles that have left the area
     std::vector<E3Values> myLeftContainer;
@@ -448,6 +465,38 @@ protected:
     FXMutex myContainerMutex;
 #endif
 
+    /// @name Access to the containers which regards the changes deferred by the current thread
+    /// @{
+
+    /// @brief returns the values of the given vehicle if it is within the area, nullptr otherwise
+    const E3Values* findEntered(const SUMOTrafficObject& veh);
+
+    /// @brief stores the values of the given vehicle within the area
+    void setEntered(const SUMOTrafficObject& veh, const E3Values& values);
+
+    /// @brief removes the given vehicle from the area, returns whether it was within
+    bool eraseEntered(const SUMOTrafficObject& veh);
+
+    /// @brief adds the values of a vehicle which left the area
+    void addLeft(const SUMOTrafficObject& veh, const E3Values& values);
+    /// @}
+
+    /// @brief whether the (parallel) locking of the containers is needed
+    static bool needsLock();
+
+    /// @brief the changes recorded by one thread while the events are deferred
+    struct EventBuffer;
+
+    /// @brief whether the changes are recorded in the buffers
+    static bool myDeferEvents;
+
+    /// @brief the buffers of all threads (registered on first use)
+    static std::vector<EventBuffer*> myEventBuffers;
+    static std::mutex myEventBufferMutex;
+
+    /// @brief the buffer of the current thread
+    static thread_local EventBuffer myThreadEventBuffer;
+
     /// @name Storages for current values
     /// @{
 
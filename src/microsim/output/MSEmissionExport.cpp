@@ -58,10 +58,8 @@ MSEmissionExport::write(OutputDevice& of, SUMOTime timestep, int precision) {
         if (emissionsDevice != nullptr && (veh->isOnRoad() || veh->isIdling())) {
             std::string fclass = veh->getVehicleType().getID();
             fclass = fclass.substr(0, fclass.find_first_of("@"));
-            PollutantsInterface::Emissions emiss = PollutantsInterface::computeAll(
-                    veh->getVehicleType().getEmissionClass(),
-                    veh->getSpeed(), veh->getAcceleration(), veh->getSlope(),
-                    veh->getEmissionParameters());
+            PollutantsInterface::Emissions emiss = static_cast<const MSBaseVehicle*>(veh)->getAllEmissions(
+                    veh->getSpeed(), veh->getAcceleration(), veh->getSlope());
             if (scaled) {
                 PollutantsInterface::Emissions tmp;
                 tmp.addScaled(emiss, TS);
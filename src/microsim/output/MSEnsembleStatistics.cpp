@@ -0,0 +1,156 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSEnsembleStatistics.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Aggregates the statistics of several runs with different seeds
+/****************************************************************************/
+#include <config.h>
+
+#include <algorithm>
+#include <microsim/MSNet.h>
+#include <microsim/MSVehicleControl.h>
+#include <microsim/MSInsertionControl.h>
+#include <microsim/transportables/MSTransportableControl.h>
+#include <microsim/devices/MSDevice_Tripinfo.h>
+#include <utils/common/StdDefs.h>
+#include <utils/options/OptionsCont.h>
+#include <utils/iodevices/OutputDevice.h>
+#include "MSEnsembleStatistics.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+std::vector<MSEnsembleStatistics::Scenario> MSEnsembleStatistics::myScenarios;
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+void
+MSEnsembleStatistics::startScenario(const std::string& id) {
+    myScenarios.push_back(Scenario());
+    myScenarios.back().id = id;
+}
+
+
+void
+MSEnsembleStatistics::add(const std::string& category, const std::string& name, const double value) {
+    std::vector<Category>& categories = myScenarios.back().categories;
+    auto cat = std::find_if(categories.begin(), categories.end(), [&](const Category & c) {
+        return c.name == category;
+    });
+    if (cat == categories.end()) {
+        categories.push_back(Category());
+        categories.back().name = category;
+        cat = categories.end() - 1;
+    }
+    auto val = std::find_if(cat->values.begin(), cat->values.end(), [&](const std::pair<std::string, SampleStatistics>& v) {
+        return v.first == name;
+    });
+    if (val == cat->values.end()) {
+        cat->values.push_back(std::make_pair(name, SampleStatistics()));
+        val = cat->values.end() - 1;
+    }
+    val->second.add(value);
+}
+
+
+void
+MSEnsembleStatistics::addRun(MSNet& net) {
+    if (myScenarios.empty()) {
+        startScenario("");
+    }
+    myScenarios.back().runs++;
+    const MSVehicleControl& vc = net.getVehicleControl();
+    add("vehicles", "loaded", vc.getLoadedVehicleNo());
+    add("vehicles", "inserted", vc.getDepartedVehicleNo());
+    add("vehicles", "running", vc.getRunningVehicleNo());
+    add("vehicles", "waiting", net.getInsertionControl().getWaitingVehicleNo());
+    add("teleports", "total", vc.getTeleportCount());
+    add("teleports", "jam", vc.getTeleportsJam());
+    add("teleports", "yield", vc.getTeleportsYield());
+    add("teleports", "wrongLane", vc.getTeleportsWrongLane());
+    add("safety", "collisions", vc.getCollisionCount());
+    add("safety", "emergencyStops", vc.getEmergencyStops());
+    add("safety", "emergencyBraking", vc.getEmergencyBrakingCount());
+    if (net.hasPersons()) {
+        const MSTransportableControl& pc = net.getPersonControl();
+        add("persons", "loaded", pc.getLoadedNumber());
+        add("persons", "running", pc.getRunningNumber());
+        add("persons", "jammed", pc.getJammedNumber());
+    }
+    if (MSDevice_Tripinfo::getNumVehicles() > 0) {
+        add("vehicleTripStatistics", "count", MSDevice_Tripinfo::getNumVehicles());
+        add("vehicleTripStatistics", "routeLength", MSDevice_Tripinfo::getAvgRouteLength());
+        add("vehicleTripStatistics", "speed", MSDevice_Tripinfo::getAvgTripSpeed());
+        add("vehicleTripStatistics", "duration", MSDevice_Tripinfo::getAvgDuration());
+        add("vehicleTripStatistics", "waitingTime", MSDevice_Tripinfo::getAvgWaitingTime());
+        add("vehicleTripStatistics", "timeLoss", MSDevice_Tripinfo::getAvgTimeLoss());
+        add("vehicleTripStatistics", "departDelay", MSDevice_Tripinfo::getAvgDepartDelay());
+        add("vehicleTripStatistics", "departDelayWaiting", MSDevice_Tripinfo::getAvgDepartDelayWaiting());
+        add("vehicleTripStatistics", "totalDepartDelay", MSDevice_Tripinfo::getTotalDepartDelay());
+    }
+    if (MSDevice_Tripinfo::getNumWalks() > 0) {
+        add("pedestrianStatistics", "number", MSDevice_Tripinfo::getNumWalks());
+        add("pedestrianStatistics", "routeLength", MSDevice_Tripinfo::getAvgWalkRouteLength());
+        add("pedestrianStatistics", "duration", MSDevice_Tripinfo::getAvgWalkDuration());
+        add("pedestrianStatistics", "timeLoss", MSDevice_Tripinfo::getAvgWalkTimeLoss());
+    }
+}
+
+
+void
+MSEnsembleStatistics::write(const std::string& file) {
+    OutputDevice& od = OutputDevice::getDevice(file);
+    od.writeXMLHeader("ensembleStatistics", "");
+    for (const Scenario& scenario : myScenarios) {
+        od.openTag("scenario");
+        if (scenario.id != "") {
+            od.writeAttr(SUMO_ATTR_ID, scenario.id);
+        }
+        od.writeAttr("runs", scenario.runs);
+        for (const Category& cat : scenario.categories) {
+            od.openTag(cat.name);
+            for (const auto& item : cat.values) {
+                const SampleStatistics& s = item.second;
+                od.openTag(item.first);
+                od.writeAttr("mean", s.getMean());
+                od.writeAttr("stdDev", s.getStdDev());
+                od.writeAttr("min", s.getQuantile(0.));
+                od.writeAttr("q05", s.getQuantile(0.05));
+                od.writeAttr("q25", s.getQuantile(0.25));
+                od.writeAttr("median", s.getQuantile(0.5));
+                od.writeAttr("q75", s.getQuantile(0.75));
+                od.writeAttr("q95", s.getQuantile(0.95));
+                od.writeAttr("max", s.getQuantile(1.));
+                od.closeTag();
+            }
+            od.closeTag();
+        }
+        od.closeTag();
+    }
+    od.close();
+}
+
+
+void
+MSEnsembleStatistics::cleanup() {
+    myScenarios.clear();
+}
+
+
+/****************************************************************************/
@@ -0,0 +1,84 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSEnsembleStatistics.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Aggregates the statistics of several runs with different seeds
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <string>
+#include <vector>
+#include <utils/common/SampleStatistics.h>
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class MSNet;
+class OutputDevice;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSEnsembleStatistics
+ * @brief Collects the end of simulation statistics of each run of an ensemble
+ *
+ * The values are those of the statistic-output (vehicle counts, teleports,
+ *  safety and the trip statistics). After each run the values are added to
+ *  the sample of the current scenario, at the end mean, standard deviation
+ *  and quantiles of every value are written.
+ */
+class MSEnsembleStatistics {
+public:
+    /// @brief starts collecting the runs of a new scenario (only needed for batch runs)
+    static void startScenario(const std::string& id);
+
+    /// @brief adds the statistics of the finished simulation
+    static void addRun(MSNet& net);
+
+    /// @brief writes the aggregated values of all scenarios to the given file
+    static void write(const std::string& file);
+
+    /// @brief discards all collected values
+    static void cleanup();
+
+private:
+    /// @brief the samples of one element of the statistics
+    struct Category {
+        std::string name;
+        std::vector<std::pair<std::string, SampleStatistics> > values;
+    };
+
+    /// @brief the collected values of one scenario
+    struct Scenario {
+        std::string id;
+        int runs = 0;
+        std::vector<Category> categories;
+    };
+
+    /// @brief adds a value to the sample with the given category and name
+    static void add(const std::string& category, const std::string& name, const double value);
+
+    /// @brief the scenarios in the order they were run
+    static std::vector<Scenario> myScenarios;
+
+private:
+    /// @brief Invalidated constructor.
+    MSEnsembleStatistics() = delete;
+};
@@ -0,0 +1,193 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2012-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSFCDColumnarWriter.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Collects FCD rows per time step and writes them as typed binary columns
+/****************************************************************************/
+#include <config.h>
+
+#include <utils/common/StringUtils.h>
+#include <utils/common/SUMOTime.h>
+#include <utils/iodevices/OutputDevice.h>
+#include "MSFCDColumnarWriter.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const std::string MSFCDColumnarWriter::MAGIC("SUMO-fcd-columnar-1");
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+MSFCDColumnarWriter::MSFCDColumnarWriter(OutputDevice& into) :
+    myDevice(into),
+    myTime(0.),
+    myNumRows(-1),
+    myInRow(false) {
+    myDevice.writePreformattedTag(MAGIC + "\n");
+}
+
+
+bool
+MSFCDColumnarWriter::isColumnarFile(const std::string& filename) {
+    return StringUtils::endsWith(filename, ".bin") || StringUtils::endsWith(filename, ".bin.gz");
+}
+
+
+MSFCDColumnarWriter&
+MSFCDColumnarWriter::openTag(const std::string& xmlElement) {
+    if (myNumRows < 0) {
+        myNumRows = 0;
+        myTime = 0.;
+        for (Column& c : myColumns) {
+            c.valid.clear();
+            c.doubles.clear();
+            c.strings.clear();
+        }
+    } else {
+        myInRow = true;
+        writeAttr(std::string("tag"), xmlElement);
+    }
+    return *this;
+}
+
+
+bool
+MSFCDColumnarWriter::closeTag() {
+    if (myInRow) {
+        myInRow = false;
+        myNumRows++;
+        return true;
+    }
+    if (myNumRows >= 0) {
+        writeRowGroup();
+        myNumRows = -1;
+        return true;
+    }
+    return false;
+}
+
+
+MSFCDColumnarWriter&
+MSFCDColumnarWriter::writeAttr(const std::string& attr, const double val) {
+    if (!myInRow) {
+        if (attr == toString(SUMO_ATTR_TIME)) {
+            myTime = val;
+        }
+        return *this;
+    }
+    Column& c = getColumn(attr, TYPE_DOUBLE);
+    c.valid.back() = 1;
+    c.doubles.back() = val;
+    return *this;
+}
+
+
+MSFCDColumnarWriter&
+MSFCDColumnarWriter::writeAttr(const std::string& attr, const std::string& val) {
+    if (!myInRow) {
+        if (attr == toString(SUMO_ATTR_TIME)) {
+            myTime = STEPS2TIME(string2time(val));
+        }
+        return *this;
+    }
+    Column& c = getColumn(attr, TYPE_STRING);
+    auto it = myDictionary.find(val);
+    if (it == myDictionary.end()) {
+        it = myDictionary.insert(std::make_pair(val, (int)myDictionary.size())).first;
+        myNewStrings.push_back(val);
+    }
+    c.valid.back() = 1;
+    c.strings.back() = it->second;
+    return *this;
+}
+
+
+MSFCDColumnarWriter::Column&
+MSFCDColumnarWriter::getColumn(const std::string& name, const char type) {
+    // the type is part of the key since string and numerical values may share a name (e.g. for params)
+    const std::string key = type == TYPE_DOUBLE ? name : name + "\n";
+    auto it = myColumnIndex.find(key);
+    if (it == myColumnIndex.end()) {
+        it = myColumnIndex.insert(std::make_pair(key, (int)myColumns.size())).first;
+        myColumns.push_back(Column(name, type));
+    }
+    Column& c = myColumns[it->second];
+    if ((int)c.valid.size() <= myNumRows) {
+        c.valid.resize(myNumRows + 1, 0);
+        if (type == TYPE_DOUBLE) {
+            c.doubles.resize(myNumRows + 1, 0.);
+        } else {
+            c.strings.resize(myNumRows + 1, -1);
+        }
+    }
+    return c;
+}
+
+
+template <class T> void
+MSFCDColumnarWriter::writeBinary(const T& val) {
+    myBuffer.append((const char*)&val, sizeof(T));
+}
+
+
+void
+MSFCDColumnarWriter::writeRowGroup() {
+    writeBinary(myTime);
+    writeBinary(myNumRows);
+    writeBinary((int)myNewStrings.size());
+    for (const std::string& s : myNewStrings) {
+        writeString(s);
+    }
+    myNewStrings.clear();
+    int numColumns = 0;
+    for (const Column& c : myColumns) {
+        if (!c.valid.empty()) {
+            numColumns++;
+        }
+    }
+    writeBinary(numColumns);
+    for (Column& c : myColumns) {
+        if (c.valid.empty()) {
+            continue;
+        }
+        c.valid.resize(myNumRows, 0);
+        writeString(c.name);
+        writeBinary(c.type);
+        myBuffer.append(c.valid.data(), myNumRows);
+        if (c.type == TYPE_DOUBLE) {
+            c.doubles.resize(myNumRows, 0.);
+            myBuffer.append((const char*)c.doubles.data(), sizeof(double) * myNumRows);
+        } else {
+            c.strings.resize(myNumRows, -1);
+            myBuffer.append((const char*)c.strings.data(), sizeof(int) * myNumRows);
+        }
+    }
+    myDevice.writePreformattedTag(myBuffer);
+    myBuffer.clear();
+}
+
+
+void
+MSFCDColumnarWriter::writeString(const std::string& val) {
+    writeBinary((int)val.size());
+    myBuffer.append(val);
+}
+
+
+/****************************************************************************/
@@ -0,0 +1,176 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2012-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSFCDColumnarWriter.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Collects FCD rows per time step and writes them as typed binary columns
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <map>
+#include <string>
+#include <vector>
+#include <utils/common/StdDefs.h>
+#include <utils/common/ToString.h>
+#include <utils/xml/SUMOXMLDefinitions.h>
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class OutputDevice;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSFCDColumnarWriter
+ * @brief Columnar (binary) backend for the FCD output
+ *
+ * The class mimics the subset of the OutputDevice interface used by
+ *  MSFCDExport, so the export code can be shared. Each time step is buffered
+ *  and written as one row group when its tag gets closed.
+ *
+ * File layout (native byte order, int = int32, double = float64):
+ *  - the magic line MSFCDColumnarWriter::MAGIC
+ *  - per row group: double time, int numRows,
+ *    int numNewStrings followed by as many length-prefixed strings which extend
+ *    the file-global string dictionary,
+ *    int numColumns followed by the columns
+ *  - per column: length-prefixed name, char type (TYPE_DOUBLE or TYPE_STRING),
+ *    numRows validity bytes and numRows values (double or int dictionary index)
+ *
+ * The column "tag" holds the element name (vehicle, person, container),
+ *  all other columns are named like the respective xml attributes.
+ *
+ * The writer is also used for E1 and E2 detector files (see
+ *  MSDetectorControl). There, each row group holds one row per detector
+ *  writing to the file and its time is the end of the interval. The detector
+ *  ids are stored in the string dictionary, so they are written once with the
+ *  first row group only.
+ */
+class MSFCDColumnarWriter {
+public:
+    /// @brief the first line of the file
+    static const std::string MAGIC;
+
+    /// @brief column types
+    static const char TYPE_DOUBLE = 0;
+    static const char TYPE_STRING = 1;
+
+    /// @brief Constructor
+    MSFCDColumnarWriter(OutputDevice& into);
+
+    /// @brief Destructor
+    ~MSFCDColumnarWriter() { }
+
+    /// @brief whether the given file name requests columnar output
+    static bool isColumnarFile(const std::string& filename);
+
+    /// @brief starts a row group (depth 0) or a row
+    MSFCDColumnarWriter& openTag(const std::string& xmlElement);
+    MSFCDColumnarWriter& openTag(const SumoXMLTag& xmlElement) {
+        return openTag(toString(xmlElement));
+    }
+
+    /// @brief finishes a row or writes the row group
+    bool closeTag();
+
+    /// @brief stores a value in the current row
+    template <class T>
+    MSFCDColumnarWriter& writeAttr(const SumoXMLAttr attr, const T& val) {
+        return writeAttr(toString(attr), val);
+    }
+
+    MSFCDColumnarWriter& writeAttr(const std::string& attr, const double val);
+    MSFCDColumnarWriter& writeAttr(const std::string& attr, const std::string& val);
+    MSFCDColumnarWriter& writeAttr(const std::string& attr, const char* val) {
+        return writeAttr(attr, std::string(val));
+    }
+    MSFCDColumnarWriter& writeAttr(const std::string& attr, const int val) {
+        return writeAttr(attr, (double)val);
+    }
+
+    /// @brief stores a value in the current row unless filtered (see OutputDevice::writeOptionalAttr)
+    template <typename T>
+    MSFCDColumnarWriter& writeOptionalAttr(const SumoXMLAttr attr, const T& val, long long int attributeMask) {
+        if (attributeMask == 0 || useAttribute(attr, attributeMask)) {
+            writeAttr(attr, val);
+        }
+        return *this;
+    }
+
+    inline bool useAttribute(const SumoXMLAttr attr, long long int attributeMask) const {
+        return (attributeMask & ((long long int)1 << attr)) != 0;
+    }
+
+    /// @brief values are stored at full precision, so this is a no-op
+    void setPrecision(int precision = gPrecision) {
+        UNUSED_PARAMETER(precision);
+    }
+
+private:
+    struct Column {
+        Column(const std::string& n, const char t) : name(n), type(t) {}
+        std::string name;
+        char type;
+        std::vector<char> valid;
+        std::vector<double> doubles;
+        std::vector<int> strings;
+    };
+
+    /// @brief retrieves the column with the given name and type for the current row
+    Column& getColumn(const std::string& name, const char type);
+
+    /// @brief writes the buffered row group
+    void writeRowGroup();
+
+    template <class T>
+    void writeBinary(const T& val);
+    void writeString(const std::string& val);
+
+private:
+    /// @brief the device to write to
+    OutputDevice& myDevice;
+
+    /// @brief the columns seen so far (the first one is the tag)
+    std::vector<Column> myColumns;
+    std::map<std::string, int> myColumnIndex;
+
+    /// @brief the file global string dictionary
+    std::map<std::string, int> myDictionary;
+    std::vector<std::string> myNewStrings;
+
+    /// @brief the encoded row group
+    std::string myBuffer;
+
+    /// @brief the time of the current row group
+    double myTime;
+
+    /// @brief the number of rows in the current group, -1 if no group is open
+    int myNumRows;
+
+    /// @brief whether a row is open
+    bool myInRow;
+
+private:
+    /// @brief Invalidated copy constructor.
+    MSFCDColumnarWriter(const MSFCDColumnarWriter&) = delete;
+
+    /// @brief Invalidated assignment operator.
+    MSFCDColumnarWriter& operator=(const MSFCDColumnarWriter&) = delete;
+};
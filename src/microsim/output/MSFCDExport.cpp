@@ -40,20 +40,30 @@
 #include <microsim/transportables/MSPerson.h>
 #include <microsim/transportables/MSTransportableControl.h>
 #include <microsim/MSVehicleControl.h>
+#include "MSFCDColumnarWriter.h"
 #include "MSFCDExport.h"
 
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+MSFCDColumnarWriter* MSFCDExport::myColumnarWriter = nullptr;
+
+
 // ===========================================================================
 // method definitions
 // ===========================================================================
-void
-MSFCDExport::write(OutputDevice& of, SUMOTime timestep, bool elevation) {
+template<class DEV> void
+MSFCDExport::writeTimestep(DEV& of, SUMOTime timestep, bool elevation) {
     const OptionsCont& oc = OptionsCont::getOptions();
     const SUMOTime period = string2time(oc.getString("device.fcd.period"));
     const SUMOTime begin = string2time(oc.getString("device.fcd.begin"));
     if ((period > 0 && (timestep - begin) % period != 0) || timestep < begin) {
         return;
     }
+    if (MSNet::getInstance()->isBehindRealTime()) {
+        return;
+    }
     const long long int mask = MSDevice_FCD::getWrittenAttributes();
     const bool maskSet = oc.isSet("fcd-output.attributes");
     const bool useGeo = oc.getBool("fcd-output.geo");
@@ -61,6 +71,7 @@ MSFCDExport::write(OutputDevice& of, SUMOTime timestep, bool elevation) {
     const bool writeAccel = oc.getBool("fcd-output.acceleration") || (maskSet && of.useAttribute(SUMO_ATTR_ACCELERATION, mask));
     const bool writeDistance = oc.getBool("fcd-output.distance") || (maskSet && of.useAttribute(SUMO_ATTR_DISTANCE, mask));
     const double maxLeaderDistance = oc.getFloat("fcd-output.max-leader-distance");
+    const double tolerance = oc.getFloat("fcd-output.tolerance");
     std::vector<std::string> params = oc.getStringVector("fcd-output.params");
     MSNet* net = MSNet::getInstance();
     MSVehicleControl& vc = net->getVehicleControl();
@@ -81,18 +92,36 @@ MSFCDExport::write(OutputDevice& of, SUMOTime timestep, bool elevation) {
         }
     }
 
+    // select the vehicles to write first so that all positions can be converted to geo coordinates at once
+    std::vector<bool> written;
+    PositionVector positions;
+    for (MSVehicleControl::constVehIt it = vc.loadedVehBegin(); it != vc.loadedVehEnd(); ++it) {
+        const SUMOVehicle* veh = it->second;
+        const bool write = (isVisible(veh)
+                            && hasOwnOutput(veh, filter, shapeFilter, (radius > 0 && inRadius.count(veh) > 0))
+                            && (tolerance <= 0 || deviatesFromLastOutput(veh, timestep, tolerance)));
+        written.push_back(write);
+        if (write) {
+            positions.push_back(veh->getPosition());
+        }
+    }
+    if (useGeo) {
+        GeoConvHelper::getFinal().cartesian2geo(positions);
+    }
+
     of.openTag("timestep").writeAttr(SUMO_ATTR_TIME, time2string(timestep));
+    int vehIndex = 0;
+    int posIndex = 0;
     for (MSVehicleControl::constVehIt it = vc.loadedVehBegin(); it != vc.loadedVehEnd(); ++it) {
         const SUMOVehicle* veh = it->second;
         const MSVehicle* microVeh = dynamic_cast<const MSVehicle*>(veh);
         const MSBaseVehicle* baseVeh = dynamic_cast<const MSBaseVehicle*>(veh);
+        const bool write = written[vehIndex++];
         if (isVisible(veh)) {
-            const bool hasOutput = hasOwnOutput(veh, filter, shapeFilter, (radius > 0 && inRadius.count(veh) > 0));
-            if (hasOutput) {
-                Position pos = veh->getPosition();
+            if (write) {
+                const Position& pos = positions[posIndex++];
                 if (useGeo) {
                     of.setPrecision(gPrecisionGeo);
-                    GeoConvHelper::getFinal().cartesian2geo(pos);
                 }
                 of.openTag(SUMO_TAG_VEHICLE);
                 of.writeAttr(SUMO_ATTR_ID, veh->getID());
@@ -114,10 +143,10 @@ MSFCDExport::write(OutputDevice& of, SUMOTime timestep, bool elevation) {
                 of.writeOptionalAttr(SUMO_ATTR_SLOPE, veh->getSlope(), mask);
                 if (microVeh != nullptr) {
                     if (signals) {
-                        of.writeOptionalAttr(SUMO_ATTR_SIGNALS, toString(microVeh->getSignals()), mask);
+                        of.writeOptionalAttr(SUMO_ATTR_SIGNALS, microVeh->getSignals(), mask);
                     }
                     if (writeAccel) {
-                        of.writeOptionalAttr(SUMO_ATTR_ACCELERATION, toString(microVeh->getAcceleration()), mask);
+                        of.writeOptionalAttr(SUMO_ATTR_ACCELERATION, microVeh->getAcceleration(), mask);
                         if (MSGlobals::gSublane) {
                             of.writeOptionalAttr(SUMO_ATTR_ACCELERATION_LAT, microVeh->getLaneChangeModel().getAccelerationLat(), mask);
                         }
@@ -139,9 +168,9 @@ MSFCDExport::write(OutputDevice& of, SUMOTime timestep, bool elevation) {
                 if (maxLeaderDistance >= 0 && microVeh != nullptr) {
                     std::pair<const MSVehicle* const, double> leader = microVeh->getLeader(maxLeaderDistance);
                     if (leader.first != nullptr) {
-                        of.writeOptionalAttr(SUMO_ATTR_LEADER_ID, toString(leader.first->getID()), mask);
-                        of.writeOptionalAttr(SUMO_ATTR_LEADER_SPEED, toString(leader.first->getSpeed()), mask);
-                        of.writeOptionalAttr(SUMO_ATTR_LEADER_GAP, toString(leader.second + microVeh->getVehicleType().getMinGap()), mask);
+                        of.writeOptionalAttr(SUMO_ATTR_LEADER_ID, leader.first->getID(), mask);
+                        of.writeOptionalAttr(SUMO_ATTR_LEADER_SPEED, leader.first->getSpeed(), mask);
+                        of.writeOptionalAttr(SUMO_ATTR_LEADER_GAP, leader.second + microVeh->getVehicleType().getMinGap(), mask);
                     } else {
                         of.writeOptionalAttr(SUMO_ATTR_LEADER_ID, "", mask);
                         of.writeOptionalAttr(SUMO_ATTR_LEADER_SPEED, -1, mask);
@@ -213,6 +242,33 @@ MSFCDExport::hasOwnOutput(const SUMOVehicle* veh, bool filter, bool shapeFilter,
             && ((veh->getDevice(typeid(MSDevice_FCD)) != nullptr) || isInRadius));
 }
 
+bool
+MSFCDExport::deviatesFromLastOutput(const SUMOVehicle* veh, SUMOTime timestep, double tolerance) {
+    MSDevice_FCD* device = static_cast<MSDevice_FCD*>(veh->getDevice(typeid(MSDevice_FCD)));
+    if (device == nullptr) {
+        // vehicles which are only written because they are in range of an equipped vehicle
+        return true;
+    }
+    MSDevice_FCD::WrittenState& last = device->getLastWritten();
+    const Position pos = veh->getPosition();
+    if (last.time >= 0 && last.edge == veh->getEdge() && last.lane == veh->getLane()) {
+        // dead reckoning: continue the last record with constant speed and heading
+        const double dist = last.speed * STEPS2TIME(timestep - last.time);
+        const Position predicted = last.pos + Position(cos(last.angle), sin(last.angle)) * dist;
+        if (predicted.distanceTo2D(pos) <= tolerance) {
+            return false;
+        }
+    }
+    last.time = timestep;
+    last.pos = pos;
+    last.speed = veh->getSpeed();
+    last.angle = veh->getAngle();
+    last.edge = veh->getEdge();
+    last.lane = veh->getLane();
+    return true;
+}
+
+
 bool
 MSFCDExport::hasOwnOutput(const MSTransportable* p, bool filter, bool shapeFilter, bool isInRadius) {
     return ((!filter || MSDevice_FCD::getEdgeFilter().count(p->getEdge()) > 0)
@@ -220,8 +276,8 @@ MSFCDExport::hasOwnOutput(const MSTransportable* p, bool filter, bool shapeFilte
             && ((p->getDevice(typeid(MSTransportableDevice_FCD)) != nullptr) || isInRadius));
 }
 
-void
-MSFCDExport::writeTransportable(OutputDevice& of, const MSEdge* e, MSTransportable* p, const SUMOVehicle* v,
+template<class DEV> void
+MSFCDExport::writeTransportable(DEV& of, const MSEdge* e, MSTransportable* p, const SUMOVehicle* v,
                                 bool filter, bool shapeFilter, bool inRadius,
                                 SumoXMLTag tag, bool useGeo, bool elevation, long long int mask) {
     if (!hasOwnOutput(p, filter, shapeFilter, inRadius)) {
@@ -249,4 +305,24 @@ MSFCDExport::writeTransportable(OutputDevice& of, const MSEdge* e, MSTransportab
 }
 
 
+void
+MSFCDExport::write(OutputDevice& of, SUMOTime timestep, bool elevation) {
+    if (myColumnarWriter == nullptr && MSFCDColumnarWriter::isColumnarFile(of.getFilename())) {
+        myColumnarWriter = new MSFCDColumnarWriter(of);
+    }
+    if (myColumnarWriter != nullptr) {
+        writeTimestep(*myColumnarWriter, timestep, elevation);
+    } else {
+        writeTimestep(of, timestep, elevation);
+    }
+}
+
+
+void
+MSFCDExport::cleanup() {
+    delete myColumnarWriter;
+    myColumnarWriter = nullptr;
+}
+
+
 /****************************************************************************/
@@ -27,6 +27,7 @@
 // class declarations
 // ===========================================================================
 class OutputDevice;
+class MSFCDColumnarWriter;
 class MSEdgeControl;
 class MSEdge;
 class MSLane;
@@ -50,6 +51,9 @@ public:
      *
      *  Opens the current time step and export the values vehicle id, position and angle
      *
+     *  If the device file name ends with ".bin" or ".bin.gz" the data is
+     *  written in columnar binary format (see MSFCDColumnarWriter).
+     *
      * @param[in] of The output device to use
      * @param[in] timestep The current time step
      * @param[in] elevation Whether elevation data shall be written
@@ -57,16 +61,36 @@ public:
      */
     static void write(OutputDevice& of, SUMOTime timestep, bool elevation);
 
+    /// @brief deletes the columnar writer (if any)
+    static void cleanup();
+
 private:
+    /// @brief write the time step into the given xml device or columnar writer
+    template<class DEV>
+    static void writeTimestep(DEV& of, SUMOTime timestep, bool elevation);
+
     /// @brief write transportable
-    static void writeTransportable(OutputDevice& of, const MSEdge* e, MSTransportable* p, const SUMOVehicle* v,
+    template<class DEV>
+    static void writeTransportable(DEV& of, const MSEdge* e, MSTransportable* p, const SUMOVehicle* v,
                                    bool filter, bool shapeFilter, bool inRadius,
                                    SumoXMLTag tag, bool useGeo, bool elevation, long long int mask);
 
     static bool isVisible(const SUMOVehicle* veh);
+
+    /** @brief whether the vehicle cannot be reconstructed from its last record within the tolerance
+     *
+     * The position is predicted from the last written record assuming constant
+     *  speed and heading. If the actual position is farther away than the
+     *  tolerance or the vehicle changed its lane (edge), it needs to be written
+     *  and the record becomes the new reference.
+     */
+    static bool deviatesFromLastOutput(const SUMOVehicle* veh, SUMOTime timestep, double tolerance);
     static bool hasOwnOutput(const SUMOVehicle* veh, bool filter, bool shapeFilter, bool isInRadius = false);
     static bool hasOwnOutput(const MSTransportable* p, bool filter, bool shapeFilter, bool isInRadius = false);
 
+    /// @brief the writer for columnar output
+    static MSFCDColumnarWriter* myColumnarWriter;
+
 private:
     /// @brief Invalidated copy constructor.
     MSFCDExport(const MSFCDExport&);
@@ -23,6 +23,9 @@
 #include <config.h>
 
 #include <utils/iodevices/OutputDevice.h>
+#include <utils/iodevices/OutputDevice_String.h>
+#include <utils/iodevices/BinaryFormatter.h>
+#include <utils/threadpool/WorkStealingThreadPool.h>
 #include <utils/emissions/PollutantsInterface.h>
 #include <utils/emissions/HelpersHarmonoise.h>
 #include <utils/geom/GeomHelper.h>
@@ -63,10 +66,8 @@ MSFullExport::writeVehicles(OutputDevice& of) {
         if (veh->isOnRoad()) {
             std::string fclass = veh->getVehicleType().getID();
             fclass = fclass.substr(0, fclass.find_first_of("@"));
-            PollutantsInterface::Emissions emiss = PollutantsInterface::computeAll(
-                    veh->getVehicleType().getEmissionClass(), veh->getSpeed(),
-                    veh->getAcceleration(), veh->getSlope(),
-                    veh->getEmissionParameters());
+            PollutantsInterface::Emissions emiss = static_cast<const MSBaseVehicle*>(veh)->getAllEmissions(
+                    veh->getSpeed(), veh->getAcceleration(), veh->getSlope());
             of.openTag("vehicle").writeAttr("id", veh->getID()).writeAttr("eclass", PollutantsInterface::getName(veh->getVehicleType().getEmissionClass()));
             of.writeAttr("CO2", emiss.CO2).writeAttr("CO", emiss.CO).writeAttr("HC", emiss.HC).writeAttr("NOx", emiss.NOx);
             of.writeAttr("PMx", emiss.PMx).writeAttr("fuel", emiss.fuel).writeAttr("electricity", emiss.electricity);
@@ -89,17 +90,46 @@ MSFullExport::writeEdge(OutputDevice& of) {
     of.openTag("edges");
     MSEdgeControl& ec = MSNet::getInstance()->getEdgeControl();
     const MSEdgeVector& edges = ec.getEdges();
-    for (MSEdgeVector::const_iterator e = edges.begin(); e != edges.end(); ++e) {
-        MSEdge& edge = **e;
-        if (!MSGlobals::gUsingInternalLanes && !edge.isNormal()) {
-            continue;
+    if (MSGlobals::gNumThreads > 1 && !MSGlobals::gUseMesoSim && !BinaryFormatter::isBinaryFile(of.getFilename())) {
+        // serialize chunks of edges in parallel and write them in order
+        WorkStealingThreadPool<int> threadPool(false, std::vector<int>(MSGlobals::gNumThreads));
+        const int numEdges = (int)edges.size();
+        const int chunkSize = MAX2(1, numEdges / (4 * MSGlobals::gNumThreads));
+        std::vector<std::future<std::string> > chunks;
+        for (int begin = 0; begin < numEdges; begin += chunkSize) {
+            const int end = MIN2(begin + chunkSize, numEdges);
+            chunks.push_back(threadPool.executeAsync([&edges, begin, end](int) {
+                // the edges are written inside the root, the data and the edges element
+                OutputDevice_String chunk(3);
+                for (int i = begin; i < end; i++) {
+                    writeSingleEdge(chunk, *edges[i]);
+                }
+                return chunk.getString();
+            }));
         }
-        of.openTag("edge").writeAttr("id", edge.getID()).writeAttr("traveltime", edge.getCurrentTravelTime());
-        const std::vector<MSLane*>& lanes = edge.getLanes();
-        for (std::vector<MSLane*>::const_iterator lane = lanes.begin(); lane != lanes.end(); ++lane) {
-            writeLane(of, **lane);
+        for (std::future<std::string>& chunk : chunks) {
+            const std::string content = chunk.get();
+            if (!content.empty()) {
+                of.writePreformattedTag(content);
+            }
+        }
+    } else {
+        for (const MSEdge* const edge : edges) {
+            writeSingleEdge(of, *edge);
         }
-        of.closeTag();
+    }
+    of.closeTag();
+}
+
+
+void
+MSFullExport::writeSingleEdge(OutputDevice& of, const MSEdge& edge) {
+    if (!MSGlobals::gUsingInternalLanes && !edge.isNormal()) {
+        return;
+    }
+    of.openTag("edge").writeAttr("id", edge.getID()).writeAttr("traveltime", edge.getCurrentTravelTime());
+    for (const MSLane* const lane : edge.getLanes()) {
+        writeLane(of, *lane);
     }
     of.closeTag();
 }
@@ -71,6 +71,9 @@ private:
     /// @brief Writes the XML Nodes for the edges (e.g. traveltime)
     static void writeEdge(OutputDevice& of);
 
+    /// @brief Writes the XML Node of a single edge and its lanes
+    static void writeSingleEdge(OutputDevice& of, const MSEdge& edge);
+
     /// @brief Writes the XML Nodes for the lanes (e.g. emissions, occupancy)
     static void writeLane(OutputDevice& of, const MSLane& lane);
 
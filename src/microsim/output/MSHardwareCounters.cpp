@@ -0,0 +1,196 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSHardwareCounters.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Hardware performance counters of the simulation phases
+/****************************************************************************/
+#include <config.h>
+
+#ifdef HAVE_PERF_EVENTS
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <utils/common/MsgHandler.h>
+#include <utils/common/StdDefs.h>
+#include <utils/iodevices/OutputDevice.h>
+#include <utils/options/OptionsCont.h>
+#include "MSHardwareCounters.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+MSHardwareCounters* MSHardwareCounters::myInstance = nullptr;
+
+
+// ===========================================================================
+// static initialisation methods
+// ===========================================================================
+void
+MSHardwareCounters::init() {
+    const OptionsCont& oc = OptionsCont::getOptions();
+    if (!oc.isSet("hardware-counter-output")) {
+        return;
+    }
+#ifdef HAVE_PERF_EVENTS
+    myInstance = new MSHardwareCounters(OutputDevice::getDeviceByOption("hardware-counter-output"), MAX2(1, oc.getInt("hardware-counter-output.period")));
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        if (myInstance->myCounters[i] < 0) {
+            WRITE_WARNING(TL("Hardware performance counters are not available (see /proc/sys/kernel/perf_event_paranoid)."));
+            cleanup();
+            return;
+        }
+    }
+#else
+    WRITE_WARNING(TL("Hardware performance counters are not supported by this build (enable PERF_EVENTS)."));
+#endif
+}
+
+
+void
+MSHardwareCounters::cleanup() {
+    delete myInstance;
+    myInstance = nullptr;
+}
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+MSHardwareCounters::MSHardwareCounters(OutputDevice& dev, const int period) :
+    myDevice(dev),
+    myPeriod(period),
+    myMainThread(std::this_thread::get_id()),
+    myIntervalBegin(-1),
+    myNumSteps(0) {
+    myDevice.writeXMLHeader("hardwareCounters", "");
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        myCounters[i] = -1;
+    }
+#ifdef HAVE_PERF_EVENTS
+    const unsigned long long configs[NUM_EVENTS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+    };
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = configs[i];
+        // count the worker threads which are started later as well
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        myCounters[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+}
+
+
+MSHardwareCounters::~MSHardwareCounters() {
+    if (myNumSteps > 0) {
+        writeInterval(myIntervalBegin + myNumSteps * DELTA_T);
+    }
+    myDevice.close();
+#ifdef HAVE_PERF_EVENTS
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        if (myCounters[i] >= 0) {
+            ::close(myCounters[i]);
+        }
+    }
+#endif
+}
+
+
+bool
+MSHardwareCounters::read(Values& values) const {
+    if (std::this_thread::get_id() != myMainThread) {
+        return false;
+    }
+#ifdef HAVE_PERF_EVENTS
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        long long value = 0;
+        if (::read(myCounters[i], &value, sizeof(value)) != sizeof(value)) {
+            return false;
+        }
+        values[i] = value;
+    }
+    return true;
+#else
+    UNUSED_PARAMETER(values);
+    return false;
+#endif
+}
+
+
+void
+MSHardwareCounters::addPhase(const char* name, const Values& start) {
+    Values now;
+    if (!read(now)) {
+        return;
+    }
+    auto it = myPhases.begin();
+    while (it != myPhases.end() && it->first != name) {
+        ++it;
+    }
+    if (it == myPhases.end()) {
+        myPhases.push_back(std::make_pair(std::string(name), Values()));
+        it = myPhases.end() - 1;
+        it->second.fill(0);
+    }
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        it->second[i] += now[i] - start[i];
+    }
+}
+
+
+void
+MSHardwareCounters::endStep(SUMOTime step) {
+    if (myIntervalBegin < 0) {
+        myIntervalBegin = step;
+    }
+    if (++myNumSteps >= myPeriod) {
+        writeInterval(step + DELTA_T);
+    }
+}
+
+
+void
+MSHardwareCounters::writeInterval(SUMOTime end) {
+    myDevice.openTag(SUMO_TAG_INTERVAL);
+    myDevice.writeAttr(SUMO_ATTR_BEGIN, time2string(myIntervalBegin));
+    myDevice.writeAttr(SUMO_ATTR_END, time2string(end));
+    for (auto& item : myPhases) {
+        const Values& v = item.second;
+        myDevice.openTag("phase");
+        myDevice.writeAttr(SUMO_ATTR_NAME, item.first);
+        myDevice.writeAttr("cycles", v[CYCLES]);
+        myDevice.writeAttr("instructions", v[INSTRUCTIONS]);
+        myDevice.writeAttr("ipc", v[CYCLES] > 0 ? (double)v[INSTRUCTIONS] / (double)v[CYCLES] : 0.);
+        myDevice.writeAttr("cacheMisses", v[CACHE_MISSES]);
+        myDevice.writeAttr("branchMisses", v[BRANCH_MISSES]);
+        myDevice.closeTag();
+        item.second.fill(0);
+    }
+    myDevice.closeTag();
+    myIntervalBegin = end;
+    myNumSteps = 0;
+}
+
+
+/****************************************************************************/
@@ -0,0 +1,128 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSHardwareCounters.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Hardware performance counters of the simulation phases
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <array>
+#include <string>
+#include <thread>
+#include <vector>
+#include <utils/common/SUMOTime.h>
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class OutputDevice;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSHardwareCounters
+ * @brief Aggregates cycles, instructions, cache and branch misses per simulation phase
+ *
+ * The counters are read through the Linux perf_event interface (only if
+ *  built with PERF_EVENTS) at the begin and the end of every phase measured
+ *  by MSStepProfiler::Scope on the main thread. They are opened before the
+ *  worker threads are started and inherited by them, so the parallel
+ *  sections of a phase are included. The sums per phase are written after
+ *  every period of simulation steps.
+ */
+class MSHardwareCounters {
+public:
+    /// @brief the sampled events
+    enum Event {
+        CYCLES,
+        INSTRUCTIONS,
+        CACHE_MISSES,
+        BRANCH_MISSES,
+        NUM_EVENTS
+    };
+
+    typedef std::array<long long, NUM_EVENTS> Values;
+
+    /// @brief Static intialization
+    static void init();
+
+    /// @brief writes the last (incomplete) period and closes the counters
+    static void cleanup();
+
+    static bool active() {
+        return myInstance != nullptr;
+    }
+
+    static MSHardwareCounters* getInstance() {
+        return myInstance;
+    }
+
+    /** @brief reads the current values of all counters
+     * @return false if called from another thread than the main thread (or reading failed)
+     */
+    bool read(Values& values) const;
+
+    /// @brief adds the events since the given values to the phase
+    void addPhase(const char* name, const Values& start);
+
+    /// @brief counts the step and writes the sums at the end of each period
+    void endStep(SUMOTime step);
+
+private:
+    /// @brief constructor
+    MSHardwareCounters(OutputDevice& dev, const int period);
+
+    /// @brief Destructor
+    ~MSHardwareCounters();
+
+    /// @brief writes the sums of the current period
+    void writeInterval(SUMOTime end);
+
+    /// @brief The device to write into
+    OutputDevice& myDevice;
+
+    /// @brief the number of steps per written interval
+    const int myPeriod;
+
+    /// @brief the file descriptors of the counters
+    int myCounters[NUM_EVENTS];
+
+    /// @brief the thread which runs the simulation loop
+    const std::thread::id myMainThread;
+
+    /// @brief the begin of the current interval
+    SUMOTime myIntervalBegin;
+
+    /// @brief the number of steps in the current interval
+    int myNumSteps;
+
+    /// @brief the sums per phase in the order of their first occurence
+    std::vector<std::pair<std::string, Values> > myPhases;
+
+    /// @brief The singleton instance
+    static MSHardwareCounters* myInstance;
+
+private:
+    /// @brief Invalidated copy constructor.
+    MSHardwareCounters(const MSHardwareCounters&) = delete;
+
+    /// @brief Invalidated assignment operator.
+    MSHardwareCounters& operator=(const MSHardwareCounters&) = delete;
+};
@@ -45,6 +45,7 @@
 #include <utils/common/UtilExceptions.h>
 #include <utils/common/StringUtils.h>
 #include <utils/iodevices/OutputDevice.h>
+#include "MSFCDColumnarWriter.h"
 
 #define HAS_NOT_LEFT_DETECTOR -1
 
@@ -384,6 +385,18 @@ MSInductLoop::writeXMLOutput(OutputDevice& dev, SUMOTime startTime, SUMOTime sto
         reset();
         return;
     }
+    writeInterval(dev, startTime, stopTime);
+}
+
+
+void
+MSInductLoop::writeColumnarOutput(MSFCDColumnarWriter& into, SUMOTime startTime, SUMOTime stopTime) {
+    writeInterval(into, startTime, stopTime);
+}
+
+
+template <class T> void
+MSInductLoop::writeInterval(T& dev, SUMOTime startTime, SUMOTime stopTime) {
     const double t(STEPS2TIME(stopTime - startTime));
     double occupancy = 0.;
     double speedSum = 0.;
@@ -260,6 +260,18 @@ public:
     void writeXMLOutput(OutputDevice& dev, SUMOTime startTime, SUMOTime stopTime);
 
 
+    /// @brief induction loops support columnar output
+    bool hasColumnarOutput() const {
+        return true;
+    }
+
+
+    /** @brief Writes collected values as one row of a columnar file
+     * @see MSDetectorFileOutput::writeColumnarOutput
+     */
+    void writeColumnarOutput(MSFCDColumnarWriter& into, SUMOTime startTime, SUMOTime stopTime);
+
+
     /** @brief Opens the XML-output using "detector" as root element
      *
      * @param[in] dev The output device to write the root into
@@ -332,6 +344,10 @@ public:
     virtual void clearState(SUMOTime time);
 
 protected:
+    /// @brief writes the interval element to the xml or columnar output and resets the values
+    template <class T>
+    void writeInterval(T& dev, SUMOTime startTime, SUMOTime stopTime);
+
     /// @name Function for summing up values
     ///@{
 
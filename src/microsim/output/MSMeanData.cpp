@@ -31,6 +31,8 @@
 #include <utils/common/ToString.h>
 #include <utils/common/StringTokenizer.h>
 #include <utils/iodevices/OutputDevice.h>
+#include <utils/iodevices/OutputDevice_String.h>
+#include <utils/threadpool/WorkStealingThreadPool.h>
 #include <microsim/MSEdgeControl.h>
 #include <microsim/MSEdge.h>
 #include <microsim/MSLane.h>
@@ -330,16 +332,17 @@ MSMeanData::MeanDataValueTracker::addTo(MSMeanData::MeanDataValues& val) const {
 
 void
 MSMeanData::MeanDataValueTracker::notifyMoveInternal(const SUMOTrafficObject& veh, const double frontOnLane, const double timeOnLane, const double meanSpeedFrontOnLane, const double meanSpeedVehicleOnLane, const double travelledDistanceFrontOnLane, const double travelledDistanceVehicleOnLane, const double meanLengthOnLane) {
-    myTrackedData[&veh]->myValues->notifyMoveInternal(veh, frontOnLane, timeOnLane, meanSpeedFrontOnLane, meanSpeedVehicleOnLane, travelledDistanceFrontOnLane, travelledDistanceVehicleOnLane, meanLengthOnLane);
+    myTrackedData.find(&veh)->second->myValues->notifyMoveInternal(veh, frontOnLane, timeOnLane, meanSpeedFrontOnLane, meanSpeedVehicleOnLane, travelledDistanceFrontOnLane, travelledDistanceVehicleOnLane, meanLengthOnLane);
 }
 
 
 bool
 MSMeanData::MeanDataValueTracker::notifyLeave(SUMOTrafficObject& veh, double lastPos, MSMoveReminder::Notification reason, const MSLane* /* enteredLane */) {
+    TrackerEntry* const entry = myTrackedData.find(&veh)->second;
     if (myParent == nullptr || reason != MSMoveReminder::NOTIFICATION_SEGMENT) {
-        myTrackedData[&veh]->myNumVehicleLeft++;
+        entry->myNumVehicleLeft++;
     }
-    return myTrackedData[&veh]->myValues->notifyLeave(veh, lastPos, reason);
+    return entry->myValues->notifyLeave(veh, lastPos, reason);
 }
 
 
@@ -353,14 +356,14 @@ MSMeanData::MeanDataValueTracker::notifyEnter(SUMOTrafficObject& veh, MSMoveRemi
     if (reason == MSMoveReminder::NOTIFICATION_SEGMENT) {
         return true;
     }
-    if (myParent->vehicleApplies(veh) && myTrackedData.find(&veh) == myTrackedData.end()) {
-        myTrackedData[&veh] = myCurrentData.back();
-        myTrackedData[&veh]->myNumVehicleEntered++;
-        if (!myTrackedData[&veh]->myValues->notifyEnter(veh, reason)) {
-            myTrackedData[&veh]->myNumVehicleLeft++;
-            myTrackedData.erase(&veh);
+    if (myParent->vehicleApplies(veh) && myTrackedData.count(&veh) == 0) {
+        TrackerEntry* const entry = myCurrentData.back();
+        entry->myNumVehicleEntered++;
+        if (!entry->myValues->notifyEnter(veh, reason)) {
+            entry->myNumVehicleLeft++;
             return false;
         }
+        myTrackedData[&veh] = entry;
         return true;
     }
     return false;
@@ -452,9 +455,10 @@ MSMeanData::init() {
         }
     }
     int index = 0;
+    myEdgeIndex.assign(MSEdge::getAllEdges().size(), -1);
     for (MSEdge* edge : myEdges) {
         myMeasures.push_back(std::vector<MeanDataValues*>());
-        myEdgeIndex[edge] = index++;
+        myEdgeIndex[edge->getNumericalID()] = index++;
         const std::vector<MSLane*>& lanes = edge->getLanes();
         if (MSGlobals::gUseMesoSim) {
             MeanDataValues* data;
@@ -676,6 +680,32 @@ MSMeanData::writeEdge(OutputDevice& dev,
 }
 
 
+void
+MSMeanData::writeEdgesParallel(OutputDevice& dev, SUMOTime startTime, SUMOTime stopTime) {
+    WorkStealingThreadPool<int> threadPool(false, std::vector<int>(MSGlobals::gNumThreads));
+    const int numEdges = (int)myEdges.size();
+    const int chunkSize = MAX2(1, numEdges / (4 * MSGlobals::gNumThreads));
+    std::vector<std::future<std::string> > chunks;
+    for (int begin = 0; begin < numEdges; begin += chunkSize) {
+        const int end = MIN2(begin + chunkSize, numEdges);
+        chunks.push_back(threadPool.executeAsync([this, begin, end, startTime, stopTime](int) {
+            // the edges are written inside the root and the interval element
+            OutputDevice_String chunk(2);
+            for (int i = begin; i < end; i++) {
+                writeEdge(chunk, myMeasures[i], myEdges[i], startTime, stopTime);
+            }
+            return chunk.getString();
+        }));
+    }
+    for (std::future<std::string>& chunk : chunks) {
+        const std::string content = chunk.get();
+        if (!content.empty()) {
+            dev.writePreformattedTag(content);
+        }
+    }
+}
+
+
 void
 MSMeanData::openInterval(OutputDevice& dev, const SUMOTime startTime, const SUMOTime stopTime) {
     dev.openTag(SUMO_TAG_INTERVAL).writeAttr(SUMO_ATTR_BEGIN, time2string(startTime)).writeAttr(SUMO_ATTR_END, time2string(stopTime));
@@ -731,6 +761,9 @@ MSMeanData::writeXMLOutput(OutputDevice& dev,
         openInterval(dev, startTime, stopTime);
         if (myAggregate) {
             writeAggregated(dev, startTime, stopTime);
+        } else if (MSGlobals::gNumThreads > 1 && !MSGlobals::gUseMesoSim && canWriteParallel()
+                   && !BinaryFormatter::isBinaryFile(dev.getFilename())) {
+            writeEdgesParallel(dev, startTime, stopTime);
         } else {
             MSEdgeVector::const_iterator edge = myEdges.begin();
             for (const std::vector<MeanDataValues*>& measures : myMeasures) {
@@ -775,9 +808,8 @@ MSMeanData::initWrittenAttributes(const std::string writeAttributes, const std::
 
 const std::vector<MSMeanData::MeanDataValues*>*
 MSMeanData::getEdgeValues(const MSEdge* edge) const {
-    auto it = myEdgeIndex.find(edge);
-    if (it != myEdgeIndex.end()) {
-        return &myMeasures[it->second];
+    if (edge->getNumericalID() < (int)myEdgeIndex.size() && myEdgeIndex[edge->getNumericalID()] >= 0) {
+        return &myMeasures[myEdgeIndex[edge->getNumericalID()]];
     } else {
         return nullptr;
     }
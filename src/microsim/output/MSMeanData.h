@@ -25,6 +25,7 @@
 #include <set>
 #include <list>
 #include <limits>
+#include <unordered_map>
 #include <microsim/output/MSDetectorFileOutput.h>
 #include <microsim/MSMoveReminder.h>
 #include <utils/common/SUMOTime.h>
@@ -285,7 +286,7 @@ public:
         };
 
         /// @brief The map of vehicles to data entries
-        std::map<const SUMOTrafficObject*, TrackerEntry*> myTrackedData;
+        std::unordered_map<const SUMOTrafficObject*, TrackerEntry*> myTrackedData;
 
         /// @brief The currently active meandata "intervals"
         std::list<TrackerEntry*> myCurrentData;
@@ -373,6 +374,11 @@ public:
         return myAmEdgeBased;
     }
 
+    /// @brief whether the data for all edges is aggregated into a single value
+    bool isAggregated() const {
+        return myAggregate;
+    }
+
     /// @brief return all attributes that are (potentially) written by this output
     virtual std::vector<std::string> getAttributeNames() const {
         return std::vector<std::string>();
@@ -437,6 +443,21 @@ protected:
      */
     void writeAggregated(OutputDevice& dev, SUMOTime startTime, SUMOTime stopTime);
 
+    /** @brief Writes the values of all edges, serializing chunks of edges in parallel
+     *
+     * The chunks are written in the order of the edges, so the output is the
+     *  same as when calling writeEdge for every edge.
+     * @param[in] dev The output device to write the data into
+     * @param[in] startTime First time step the data were gathered
+     * @param[in] stopTime Last time step the data were gathered
+     */
+    void writeEdgesParallel(OutputDevice& dev, SUMOTime startTime, SUMOTime stopTime);
+
+    /// @brief whether writing the values of different edges does not touch shared state (see writeEdgesParallel)
+    virtual bool canWriteParallel() const {
+        return false;
+    }
+
     /** @brief Writes the interval opener
      *
      * @param[in] dev The output device to write the data into
@@ -489,8 +510,8 @@ private:
     /// @brief The corresponding first edges
     MSEdgeVector myEdges;
 
-    /// @brief The index in myEdges / myMeasures
-    std::map<const MSEdge*, int> myEdgeIndex;
+    /// @brief The index in myEdges / myMeasures for every numerical edge id (-1 for edges without data)
+    std::vector<int> myEdgeIndex;
 
     /// @brief Whether empty lanes/edges shall be written
     const bool myPrintDefaults;
@@ -75,19 +75,15 @@ MSMeanData_Emissions::MSLaneMeanDataValues::notifyMoveInternal(const SUMOTraffic
         sampleSeconds += timeOnLane;
         travelledDistance += travelledDistanceVehicleOnLane;
         const double a = veh.getAcceleration();
-        myEmissions.addScaled(PollutantsInterface::computeAll(veh.getVehicleType().getEmissionClass(),
-                              // XXX: recheck, which value to use here for the speed. (Leo) Refs. #2579
-                              meanSpeedVehicleOnLane, a, veh.getSlope(),
-                              static_cast<const SUMOVehicle&>(veh).getEmissionParameters()), timeOnLane);
+        // XXX: recheck, which value to use here for the speed. (Leo) Refs. #2579
+        myEmissions.addScaled(static_cast<const MSBaseVehicle&>(veh).getAllEmissions(meanSpeedVehicleOnLane, a, veh.getSlope()), timeOnLane);
     }
 }
 
 bool
 MSMeanData_Emissions::MSLaneMeanDataValues::notifyIdle(SUMOTrafficObject& veh) {
     if (veh.isVehicle()) {
-        myEmissions.addScaled(PollutantsInterface::computeAll(veh.getVehicleType().getEmissionClass(),
-                              0., 0., 0.,
-                              static_cast<const SUMOVehicle&>(veh).getEmissionParameters()), TS);
+        myEmissions.addScaled(static_cast<const MSBaseVehicle&>(veh).getAllEmissions(0., 0., 0.), TS);
     }
     return true;
 }
@@ -248,6 +248,11 @@ protected:
      */
     MSMeanData::MeanDataValues* createValues(MSLane* const lane, const double length, const bool doAdd) const;
 
+    /// @brief the traffic measures of different edges are independent
+    bool canWriteParallel() const {
+        return true;
+    }
+
     /** @brief Resets network value in order to allow processing of the next interval
      *
      * Goes through the lists of edges and starts "resetOnly" for each edge.
@@ -28,6 +28,9 @@
 #include <microsim/MSGlobals.h>
 #include <utils/options/OptionsCont.h>
 #include <utils/iodevices/OutputDevice.h>
+#include <utils/iodevices/OutputDevice_String.h>
+#include <utils/iodevices/BinaryFormatter.h>
+#include <utils/threadpool/WorkStealingThreadPool.h>
 #include "MSQueueExport.h"
 #include <microsim/MSNet.h>
 #include <microsim/MSVehicle.h>
@@ -54,11 +57,38 @@ MSQueueExport::writeEdge(OutputDevice& of) {
     of.openTag("lanes");
     MSEdgeControl& ec = MSNet::getInstance()->getEdgeControl();
     const MSEdgeVector& edges = ec.getEdges();
-    for (MSEdgeVector::const_iterator e = edges.begin(); e != edges.end(); ++e) {
-        MSEdge& edge = **e;
-        const std::vector<MSLane*>& lanes = edge.getLanes();
-        for (std::vector<MSLane*>::const_iterator lane = lanes.begin(); lane != lanes.end(); ++lane) {
-            writeLane(of, **lane);
+    if (MSGlobals::gNumThreads > 1 && !MSGlobals::gUseMesoSim && !BinaryFormatter::isBinaryFile(of.getFilename())) {
+        // serialize chunks of edges in parallel and write them in order
+        WorkStealingThreadPool<int> threadPool(false, std::vector<int>(MSGlobals::gNumThreads));
+        const int numEdges = (int)edges.size();
+        const int chunkSize = MAX2(1, numEdges / (4 * MSGlobals::gNumThreads));
+        std::vector<std::future<std::string> > chunks;
+        for (int begin = 0; begin < numEdges; begin += chunkSize) {
+            const int end = MIN2(begin + chunkSize, numEdges);
+            chunks.push_back(threadPool.executeAsync([&edges, begin, end](int) {
+                // the lanes are written inside the root, the data and the lanes element
+                OutputDevice_String chunk(3);
+                for (int i = begin; i < end; i++) {
+                    for (const MSLane* const lane : edges[i]->getLanes()) {
+                        writeLane(chunk, *lane);
+                    }
+                }
+                return chunk.getString();
+            }));
+        }
+        for (std::future<std::string>& chunk : chunks) {
+            const std::string content = chunk.get();
+            if (!content.empty()) {
+                of.writePreformattedTag(content);
+            }
+        }
+    } else {
+        for (MSEdgeVector::const_iterator e = edges.begin(); e != edges.end(); ++e) {
+            MSEdge& edge = **e;
+            const std::vector<MSLane*>& lanes = edge.getLanes();
+            for (std::vector<MSLane*>::const_iterator lane = lanes.begin(); lane != lanes.end(); ++lane) {
+                writeLane(of, **lane);
+            }
         }
     }
     of.closeTag();
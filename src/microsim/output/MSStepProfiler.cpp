@@ -0,0 +1,96 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSStepProfiler.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Records the time spent in the simulation phases as a Chrome trace
+/****************************************************************************/
+#include <config.h>
+
+#include <utils/common/ToString.h>
+#include <utils/iodevices/OutputDevice.h>
+#include <utils/options/OptionsCont.h>
+#include "MSStepProfiler.h"
+
+
+// ---------------------------------------------------------------------------
+// static initialisation methods
+// ---------------------------------------------------------------------------
+MSStepProfiler* MSStepProfiler::myInstance = nullptr;
+
+void
+MSStepProfiler::init() {
+    if (OptionsCont::getOptions().isSet("profile-output")) {
+        myInstance = new MSStepProfiler(OutputDevice::getDeviceByOption("profile-output"));
+    }
+}
+
+
+void
+MSStepProfiler::cleanup() {
+    delete myInstance;
+    myInstance = nullptr;
+}
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+MSStepProfiler::MSStepProfiler(OutputDevice& dev) :
+    myDevice(dev),
+    myOrigin(Clock::now()),
+    myWroteEvent(false) {
+    myDevice << "{\"traceEvents\":[";
+}
+
+
+MSStepProfiler::~MSStepProfiler() {
+    writeStep(-1);
+    myDevice << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+
+void
+MSStepProfiler::addSpan(const char* name, Clock::time_point start, Clock::time_point end) {
+#ifdef HAVE_FOX
+    FXMutexLock lock(myMutex);
+#endif
+    auto it = myThreads.find(std::this_thread::get_id());
+    if (it == myThreads.end()) {
+        it = myThreads.insert(std::make_pair(std::this_thread::get_id(), (int)myThreads.size())).first;
+    }
+    mySpans.push_back({name,
+                       std::chrono::duration_cast<std::chrono::microseconds>(start - myOrigin).count(),
+                       std::chrono::duration_cast<std::chrono::microseconds>(end - start).count(),
+                       it->second});
+}
+
+
+void
+MSStepProfiler::writeStep(SUMOTime step) {
+#ifdef HAVE_FOX
+    FXMutexLock lock(myMutex);
+#endif
+    const std::string args = step >= 0 ? ",\"args\":{\"time\":\"" + time2string(step) + "\"}" : "";
+    for (const Span& s : mySpans) {
+        myDevice << (myWroteEvent ? ",\n" : "\n") << "{\"name\":\"" << s.name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << s.thread
+                 << ",\"ts\":" << s.begin << ",\"dur\":" << s.duration << args << "}";
+        myWroteEvent = true;
+    }
+    mySpans.clear();
+}
+
+
+/****************************************************************************/
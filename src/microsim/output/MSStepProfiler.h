@@ -0,0 +1,167 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSStepProfiler.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Records the time spent in the simulation phases as a Chrome trace
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <chrono>
+#include <map>
+#include <thread>
+#include <vector>
+#include <utils/common/SUMOTime.h>
+#include "MSHardwareCounters.h"
+#ifdef HAVE_FOX
+#include <utils/foxtools/fxheader.h>
+#endif
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class OutputDevice;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSStepProfiler
+ * @brief Writes the durations of the simulation phases and thread tasks
+ *
+ * The output is a JSON file in the Chrome trace event format (complete
+ *  events) which can be opened with chrome://tracing or ui.perfetto.dev.
+ *  The spans are buffered and written at the end of every simulation step.
+ */
+class MSStepProfiler {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * @class Scope
+     * @brief Measures the time (and the hardware counters) until destruction (or until the next phase starts)
+     */
+    class Scope {
+    public:
+        Scope(const char* name) :
+            myName(name) {
+            start();
+        }
+
+        ~Scope() {
+            finish();
+        }
+
+        /// @brief finishes the current span and starts the next one
+        void next(const char* name) {
+            finish();
+            myName = name;
+            start();
+        }
+
+        /// @brief finishes the current span
+        void finish() {
+            if (myName != nullptr) {
+                if (myInstance != nullptr) {
+                    myInstance->addSpan(myName, myStart, Clock::now());
+                }
+                if (myHaveCounters) {
+                    MSHardwareCounters::getInstance()->addPhase(myName, myCounters);
+                }
+            }
+            myName = nullptr;
+        }
+
+    private:
+        void start() {
+            if (myInstance != nullptr) {
+                myStart = Clock::now();
+            }
+            myHaveCounters = MSHardwareCounters::active() && MSHardwareCounters::getInstance()->read(myCounters);
+        }
+
+        const char* myName;
+        Clock::time_point myStart;
+        bool myHaveCounters;
+        MSHardwareCounters::Values myCounters;
+    };
+
+    /// @brief Static intialization
+    static void init();
+
+    /// @brief closes the trace
+    static void cleanup();
+
+    static bool active() {
+        return myInstance != nullptr;
+    }
+
+    static MSStepProfiler* getInstance() {
+        return myInstance;
+    }
+
+    /// @brief stores the span (thread safe)
+    void addSpan(const char* name, Clock::time_point start, Clock::time_point end);
+
+    /// @brief writes all spans recorded so far
+    void writeStep(SUMOTime step);
+
+private:
+    /// @brief constructor
+    MSStepProfiler(OutputDevice& dev);
+
+    /// @brief Destructor
+    ~MSStepProfiler();
+
+    struct Span {
+        const char* name;
+        long long int begin;
+        long long int duration;
+        int thread;
+    };
+
+    /// @brief The device to write into
+    OutputDevice& myDevice;
+
+    /// @brief the time all spans refer to
+    const Clock::time_point myOrigin;
+
+    /// @brief the spans of the current step
+    std::vector<Span> mySpans;
+
+    /// @brief the compact ids of the threads seen so far
+    std::map<std::thread::id, int> myThreads;
+
+    /// @brief whether an event was written already (for the separating comma)
+    bool myWroteEvent;
+
+#ifdef HAVE_FOX
+    /// @brief the mutex for the span buffer
+    FXMutex myMutex;
+#endif
+
+    /// @brief The singleton instance
+    static MSStepProfiler* myInstance;
+
+private:
+    /// @brief Invalidated copy constructor.
+    MSStepProfiler(const MSStepProfiler&) = delete;
+
+    /// @brief Invalidated assignment operator.
+    MSStepProfiler& operator=(const MSStepProfiler&) = delete;
+};
@@ -0,0 +1,139 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSTripStatistics.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Aggregated distributions of the trips of all arrived vehicles
+/****************************************************************************/
+#include <config.h>
+
+#include <utils/common/StdDefs.h>
+#include <utils/iodevices/OutputDevice.h>
+#include <utils/options/OptionsCont.h>
+#include <utils/vehicle/SUMOVehicle.h>
+#include <microsim/MSGlobals.h>
+#include <microsim/MSVehicle.h>
+#include <microsim/MSVehicleType.h>
+#include <mesosim/MEVehicle.h>
+#include "MSTripStatistics.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+MSTripStatistics* MSTripStatistics::myInstance = nullptr;
+
+
+// ===========================================================================
+// static initialisation methods
+// ===========================================================================
+void
+MSTripStatistics::init() {
+    const OptionsCont& oc = OptionsCont::getOptions();
+    if (oc.isSet("tripinfo-statistics-output")) {
+        myInstance = new MSTripStatistics(OutputDevice::getDeviceByOption("tripinfo-statistics-output"),
+                                          STEPS2TIME(string2time(oc.getString("tripinfo-statistics-output.bin-width"))));
+        MSNet::getInstance()->addVehicleStateListener(myInstance);
+    }
+}
+
+
+void
+MSTripStatistics::cleanup() {
+    if (myInstance != nullptr) {
+        myInstance->write();
+        if (MSNet::hasInstance()) {
+            MSNet::getInstance()->removeVehicleStateListener(myInstance);
+        }
+        delete myInstance;
+        myInstance = nullptr;
+    }
+}
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+MSTripStatistics::MSTripStatistics(OutputDevice& dev, const double binWidth) :
+    myDevice(dev),
+    myBinWidth(binWidth) {
+}
+
+
+void
+MSTripStatistics::vehicleStateChanged(const SUMOVehicle* const vehicle, MSNet::VehicleState to, const std::string& /*info*/) {
+    if (to != MSNet::VehicleState::ARRIVED || !vehicle->hasDeparted()) {
+        return;
+    }
+    const SUMOVehicleParameter& pars = vehicle->getParameter();
+    auto it = myGroups.find(GroupKey(vehicle->getVehicleType().getID(), pars.fromTaz, pars.toTaz));
+    if (it == myGroups.end()) {
+        it = myGroups.insert(std::make_pair(GroupKey(vehicle->getVehicleType().getID(), pars.fromTaz, pars.toTaz), Group(myBinWidth))).first;
+    }
+    Group& group = it->second;
+    group.duration.add(STEPS2TIME(SIMSTEP - vehicle->getDeparture()));
+    if (MSGlobals::gUseMesoSim) {
+        group.timeLoss.add(STEPS2TIME(static_cast<const MEVehicle*>(vehicle)->getTimeLoss()));
+    } else {
+        group.timeLoss.add(static_cast<const MSVehicle*>(vehicle)->getTimeLossSeconds());
+    }
+    group.waitingTime.add(STEPS2TIME(vehicle->getAccumulatedWaitingTime()));
+}
+
+
+void
+MSTripStatistics::write() const {
+    myDevice.writeXMLHeader("tripStatistics", "");
+    for (const auto& item : myGroups) {
+        myDevice.openTag("group");
+        myDevice.writeAttr(SUMO_ATTR_TYPE, std::get<0>(item.first));
+        if (std::get<1>(item.first) != "") {
+            myDevice.writeAttr(SUMO_ATTR_FROM_TAZ, std::get<1>(item.first));
+        }
+        if (std::get<2>(item.first) != "") {
+            myDevice.writeAttr(SUMO_ATTR_TO_TAZ, std::get<2>(item.first));
+        }
+        myDevice.writeAttr("count", item.second.duration.size());
+        writeDistribution("duration", item.second.duration);
+        writeDistribution("timeLoss", item.second.timeLoss);
+        writeDistribution("waitingTime", item.second.waitingTime);
+        myDevice.closeTag();
+    }
+    myDevice.close();
+}
+
+
+void
+MSTripStatistics::writeDistribution(const std::string& name, const HistogramStatistics& stats) const {
+    myDevice.openTag(name);
+    myDevice.writeAttr("mean", stats.getMean());
+    myDevice.writeAttr("min", stats.getMin());
+    myDevice.writeAttr("q05", stats.getQuantile(0.05));
+    myDevice.writeAttr("q25", stats.getQuantile(0.25));
+    myDevice.writeAttr("median", stats.getQuantile(0.5));
+    myDevice.writeAttr("q75", stats.getQuantile(0.75));
+    myDevice.writeAttr("q95", stats.getQuantile(0.95));
+    myDevice.writeAttr("max", stats.getMax());
+    for (const auto& bin : stats.getBins()) {
+        myDevice.openTag("bin");
+        myDevice.writeAttr(SUMO_ATTR_BEGIN, (double)bin.first * stats.getBinWidth());
+        myDevice.writeAttr("count", bin.second);
+        myDevice.closeTag();
+    }
+    myDevice.closeTag();
+}
+
+
+/****************************************************************************/
@@ -0,0 +1,98 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSTripStatistics.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Aggregated distributions of the trips of all arrived vehicles
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <utils/common/HistogramStatistics.h>
+#include <microsim/MSNet.h>
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class OutputDevice;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSTripStatistics
+ * @brief Collects histograms of duration, timeLoss and waitingTime of arriving vehicles
+ *
+ * The values are taken from the vehicle when it arrives, so no device is
+ *  needed and nothing is written per vehicle. The trips are grouped by
+ *  vehicle type and origin / destination TAZ. The waitingTime is the
+ *  accumulated waiting time of the vehicle (see --waiting-time-memory).
+ */
+class MSTripStatistics : public MSNet::VehicleStateListener {
+public:
+    /// @brief Static intialization (registers the listener if tripinfo-statistics-output is set)
+    static void init();
+
+    /// @brief writes the collected statistics and deletes the instance
+    static void cleanup();
+
+    /// @brief adds the trip of an arrived vehicle
+    void vehicleStateChanged(const SUMOVehicle* const vehicle, MSNet::VehicleState to, const std::string& info = "") override;
+
+private:
+    /// @brief the distributions of one group of trips
+    struct Group {
+        Group(const double binWidth) : duration(binWidth), timeLoss(binWidth), waitingTime(binWidth) {}
+        HistogramStatistics duration;
+        HistogramStatistics timeLoss;
+        HistogramStatistics waitingTime;
+    };
+
+    /// @brief vehicle type, origin and destination TAZ
+    typedef std::tuple<std::string, std::string, std::string> GroupKey;
+
+    /// @brief constructor
+    MSTripStatistics(OutputDevice& dev, const double binWidth);
+
+    /// @brief writes all groups
+    void write() const;
+
+    /// @brief writes the statistics and the occupied bins of one value
+    void writeDistribution(const std::string& name, const HistogramStatistics& stats) const;
+
+    /// @brief The device to write into
+    OutputDevice& myDevice;
+
+    /// @brief the width of the histogram bins in seconds
+    const double myBinWidth;
+
+    /// @brief the groups sorted by their key
+    std::map<GroupKey, Group> myGroups;
+
+    /// @brief The singleton instance
+    static MSTripStatistics* myInstance;
+
+private:
+    /// @brief Invalidated copy constructor.
+    MSTripStatistics(const MSTripStatistics&) = delete;
+
+    /// @brief Invalidated assignment operator.
+    MSTripStatistics& operator=(const MSTripStatistics&) = delete;
+};
@@ -24,6 +24,7 @@
 #include <config.h>
 
 #include <cassert>
+#include <cstdio>
 #include <utility>
 #include <vector>
 #include <bitset>
@@ -51,6 +52,12 @@ const std::vector<std::string> MSActuatedTrafficLightLogic::OPERATOR_PRECEDENCE(
     "and", "&&", "or", "||",
 });
 
+/// @brief encloses the index of an already compiled sub expression
+#define EXPRESSION_MARKER '\x01'
+
+/// @brief raised when an expression cannot be compiled and must be interpreted instead
+struct ExpressionFallback {};
+
 // ===========================================================================
 // parameter defaults definitions
 // ===========================================================================
@@ -1042,7 +1049,7 @@ MSActuatedTrafficLightLogic::decideNextPhaseCustom(bool mustSwitch) {
 
 
 double
-MSActuatedTrafficLightLogic::evalExpression(const std::string& condition) const {
+MSActuatedTrafficLightLogic::interpretExpression(const std::string& condition) const {
     const size_t bracketOpen = condition.find('(');
     if (bracketOpen != std::string::npos) {
         // find matching closing bracket
@@ -1064,10 +1071,10 @@ MSActuatedTrafficLightLogic::evalExpression(const std::string& condition) const
         }
         std::string cond2 = condition;
         const std::string inBracket = condition.substr(bracketOpen + 1, bracketClose - bracketOpen - 1);
-        double bracketVal = evalExpression(inBracket);
+        double bracketVal = interpretExpression(inBracket);
         cond2.replace(bracketOpen, bracketClose - bracketOpen + 1, toString(bracketVal));
         try {
-            return evalExpression(cond2);
+            return interpretExpression(cond2);
         } catch (ProcessError& e) {
             throw ProcessError("Error when evaluating expression '" + condition + "':\n  " + e.what());
         }
@@ -1115,7 +1122,7 @@ MSActuatedTrafficLightLogic::evalExpression(const std::string& condition) const
                         std::vector<std::string> newTokens(tokens.begin(), tokens.begin() + (i - 1));
                         newTokens.push_back(toString(val));
                         newTokens.insert(newTokens.end(), tokens.begin() + (i + 2), tokens.end());
-                        return evalExpression(toString(newTokens));
+                        return interpretExpression(toString(newTokens));
                     } catch (ProcessError& e) {
                         throw ProcessError("Error when evaluating expression '" + condition + "':\n  " + e.what());
                     }
@@ -1127,6 +1134,374 @@ MSActuatedTrafficLightLogic::evalExpression(const std::string& condition) const
     return true;
 }
 
+double
+MSActuatedTrafficLightLogic::evalExpression(const std::string& condition) const {
+    auto it = myCompiledExpressions.find(condition);
+    if (it == myCompiledExpressions.end()) {
+        // numbers (i.e. condition values written by assignments) are not cached
+        double value;
+        if (evalNumber(condition, value)) {
+            return value;
+        }
+        it = myCompiledExpressions.insert(std::make_pair(condition, compileExpression(condition))).first;
+    }
+    return evalExpressionNode(it->second);
+}
+
+
+bool
+MSActuatedTrafficLightLogic::evalNumber(const std::string& text, double& value) const {
+    try {
+        value = StringUtils::toDouble(text);
+    } catch (ProcessError&) {
+        return false;
+    }
+    // a variable on the stack hides the number just like in interpretExpression
+    auto it = myStack.back().find(text);
+    if (it != myStack.back().end()) {
+        value = it->second;
+    }
+    return true;
+}
+
+
+int
+MSActuatedTrafficLightLogic::compileExpression(const std::string& condition) const {
+    const int numNodes = (int)myExpressionNodes.size();
+    try {
+        return compileSubExpression(condition, condition);
+    } catch (ExpressionFallback&) {
+        // unusual constructs (or detectors which do not exist yet) are interpreted on every evaluation
+        myExpressionNodes.resize(numNodes, ExpressionNode(ExpressionType::ERROR));
+        return addExpressionNode(ExpressionNode(ExpressionType::INTERPRETED, condition));
+    }
+}
+
+
+int
+MSActuatedTrafficLightLogic::compileSubExpression(const std::string& condition, const std::string& origin) const {
+    // mirrors interpretExpression: brackets and reduced sub expressions are rounded as if written to a string
+    const size_t bracketOpen = condition.find('(');
+    if (bracketOpen != std::string::npos) {
+        size_t bracketClose = std::string::npos;
+        int open = 1;
+        for (size_t i = bracketOpen + 1; i < condition.size(); i++) {
+            if (condition[i] == '(') {
+                open++;
+            } else if (condition[i] == ')') {
+                open--;
+                if (open == 0) {
+                    bracketClose = i;
+                    break;
+                }
+            }
+        }
+        if (bracketClose == std::string::npos) {
+            return addExpressionNode(ExpressionNode(ExpressionType::ERROR, TLF("Unmatched parentheses in condition %'", origin)));
+        }
+        ExpressionNode round(ExpressionType::ROUND);
+        round.args.push_back(compileSubExpression(condition.substr(bracketOpen + 1, bracketClose - bracketOpen - 1), origin));
+        std::string cond2 = condition;
+        cond2.replace(bracketOpen, bracketClose - bracketOpen + 1, EXPRESSION_MARKER + toString(addExpressionNode(round)) + EXPRESSION_MARKER);
+        return compileSubExpression(cond2, origin);
+    }
+    std::vector<std::string> tokens = StringTokenizer(condition).getVector();
+    if (tokens.size() == 0) {
+        return addExpressionNode(ExpressionNode(ExpressionType::ERROR, TLF("Invalid empty condition '%'", origin)));
+    } else if (tokens.size() == 1) {
+        return compileAtomicExpression(tokens[0], origin);
+    } else if (tokens.size() == 2) {
+        if (tokens[0] == "not") {
+            ExpressionNode node(ExpressionType::NOT);
+            node.args.push_back(compileAtomicExpression(tokens[1], origin));
+            return addExpressionNode(node);
+        }
+        return addExpressionNode(ExpressionNode(ExpressionType::ERROR, TLF("Unsupported condition '%'", origin)));
+    }
+    const int iEnd = (int)tokens.size() - 1;
+    for (const std::string& o : OPERATOR_PRECEDENCE) {
+        for (int i = 1; i < iEnd; i++) {
+            if (tokens[i] == o) {
+                ExpressionNode node(ExpressionType::BINARY, o);
+                node.origin = origin;
+                node.op = getExpressionOperator(o);
+                node.args.push_back(compileAtomicExpression(tokens[i - 1], origin));
+                node.args.push_back(compileAtomicExpression(tokens[i + 1], origin));
+                if (tokens.size() == 3) {
+                    return addExpressionNode(node);
+                }
+                ExpressionNode round(ExpressionType::ROUND);
+                round.args.push_back(addExpressionNode(node));
+                std::vector<std::string> newTokens(tokens.begin(), tokens.begin() + (i - 1));
+                newTokens.push_back(EXPRESSION_MARKER + toString(addExpressionNode(round)) + EXPRESSION_MARKER);
+                newTokens.insert(newTokens.end(), tokens.begin() + (i + 2), tokens.end());
+                return compileSubExpression(toString(newTokens), origin);
+            }
+        }
+    }
+    if (tokens.size() == 3) {
+        // unknown operator, the operands are evaluated before raising the error
+        ExpressionNode node(ExpressionType::BINARY, tokens[1]);
+        node.origin = origin;
+        node.args.push_back(compileAtomicExpression(tokens[0], origin));
+        node.args.push_back(compileAtomicExpression(tokens[2], origin));
+        return addExpressionNode(node);
+    }
+    return addExpressionNode(ExpressionNode(ExpressionType::ERROR, "Parsing expressions with " + toString(tokens.size()) + " elements ('" + origin + "') is not supported"));
+}
+
+
+int
+MSActuatedTrafficLightLogic::compileAtomicExpression(const std::string& expr, const std::string& origin) const {
+    if (expr.size() == 0) {
+        return addExpressionNode(ExpressionNode(ExpressionType::ERROR, TL("Invalid empty expression")));
+    } else if (expr[0] == '!' || expr[0] == '-') {
+        ExpressionNode node(expr[0] == '!' ? ExpressionType::NOT : ExpressionType::NEGATE);
+        node.args.push_back(compileAtomicExpression(expr.substr(1), origin));
+        return addExpressionNode(node);
+    }
+    const size_t marker = expr.find(EXPRESSION_MARKER);
+    if (marker != std::string::npos) {
+        if (marker == 0 && expr.back() == EXPRESSION_MARKER && expr.find(EXPRESSION_MARKER, 1) == expr.size() - 1) {
+            return StringUtils::toInt(expr.substr(1, expr.size() - 2));
+        }
+        // a sub expression glued to other characters
+        throw ExpressionFallback();
+    }
+    const size_t pos = expr.find(':');
+    if (pos == std::string::npos) {
+        auto it = myConditions.find(expr);
+        if (it != myConditions.end()) {
+            ExpressionNode node(ExpressionType::CONDITION, expr);
+            node.condition = &it->second;
+            return addExpressionNode(node);
+        }
+        ExpressionNode node(ExpressionType::VARIABLE, expr);
+        try {
+            node.value = StringUtils::toDouble(expr);
+            node.cachedIsNumber = true;
+        } catch (ProcessError&) {
+            // the value must be on the stack when evaluating
+        }
+        return addExpressionNode(node);
+    }
+    const std::string fun = expr.substr(0, pos);
+    const std::string arg = expr.substr(pos + 1);
+    try {
+        if (fun == "z") {
+            ExpressionNode node(ExpressionType::DETECTION_GAP);
+            node.loop = retrieveDetExpression<MSInductLoop, SUMO_TAG_INDUCTION_LOOP>(arg, expr, true);
+            return addExpressionNode(node);
+        } else if (fun == "a") {
+            ExpressionNode node(ExpressionType::LOOP_ACTIVE);
+            try {
+                node.loop = retrieveDetExpression<MSInductLoop, SUMO_TAG_INDUCTION_LOOP>(arg, expr, true);
+            } catch (ProcessError&) {
+                node.type = ExpressionType::E2_VEHICLES;
+                node.e2 = retrieveDetExpression<MSE2Collector, SUMO_TAG_LANE_AREA_DETECTOR>(arg, expr, true);
+            }
+            return addExpressionNode(node);
+        } else if (fun == "g" || fun == "r") {
+            ExpressionNode node(fun == "g" ? ExpressionType::GREEN_TIME : ExpressionType::RED_TIME);
+            node.linkIndex = StringUtils::toInt(arg);
+            if (node.linkIndex >= 0 && node.linkIndex < myNumLinks) {
+                return addExpressionNode(node);
+            }
+        } else if (fun == "c") {
+            return addExpressionNode(ExpressionNode(ExpressionType::CYCLE_TIME));
+        } else {
+            auto it = myFunctions.find(fun);
+            if (it != myFunctions.end()) {
+                ExpressionNode node(ExpressionType::FUNCTION, fun);
+                node.function = &it->second;
+                for (const std::string& a : StringTokenizer(arg, ",").getVector()) {
+                    node.args.push_back(compileSubExpression(a, origin));
+                }
+                if ((int)node.args.size() == node.function->nArgs) {
+                    return addExpressionNode(node);
+                }
+            }
+        }
+    } catch (ProcessError&) {
+        // unknown detector or invalid link index
+    }
+    throw ExpressionFallback();
+}
+
+
+MSActuatedTrafficLightLogic::ExpressionOperator
+MSActuatedTrafficLightLogic::getExpressionOperator(const std::string& o) {
+    typedef ExpressionOperator Op;
+    if (o == "=" || o == "==") {
+        return Op::EQUAL;
+    } else if (o == "!=") {
+        return Op::NOT_EQUAL;
+    } else if (o == "<") {
+        return Op::LESS;
+    } else if (o == ">") {
+        return Op::GREATER;
+    } else if (o == "<=") {
+        return Op::LESS_EQUAL;
+    } else if (o == ">=") {
+        return Op::GREATER_EQUAL;
+    } else if (o == "or" || o == "||") {
+        return Op::OR;
+    } else if (o == "and" || o == "&&") {
+        return Op::AND;
+    } else if (o == "+") {
+        return Op::PLUS;
+    } else if (o == "-") {
+        return Op::MINUS;
+    } else if (o == "*") {
+        return Op::TIMES;
+    } else if (o == "/") {
+        return Op::DIVIDE;
+    } else if (o == "%") {
+        return Op::MODULO;
+    } else if (o == "**" || o == "^") {
+        return Op::POWER;
+    }
+    return Op::INVALID;
+}
+
+
+int
+MSActuatedTrafficLightLogic::addExpressionNode(const ExpressionNode& node) const {
+    myExpressionNodes.push_back(node);
+    return (int)myExpressionNodes.size() - 1;
+}
+
+
+double
+MSActuatedTrafficLightLogic::evalExpressionNode(int index) const {
+    ExpressionNode& n = myExpressionNodes[index];
+    switch (n.type) {
+        case ExpressionType::NUMBER:
+            return n.value;
+        case ExpressionType::VARIABLE: {
+            auto it = myStack.back().find(n.text);
+            if (it != myStack.back().end()) {
+                return it->second;
+            }
+            // raises the number format error for unknown variables
+            return n.cachedIsNumber ? n.value : StringUtils::toDouble(n.text);
+        }
+        case ExpressionType::CONDITION: {
+            if (n.cachedRoot < 0 || n.cachedText != *n.condition) {
+                // the condition was modified by an assignment
+                n.cachedText = *n.condition;
+                n.cachedIsNumber = false;
+                n.cachedRoot = -1;
+                try {
+                    n.value = StringUtils::toDouble(n.cachedText);
+                    n.cachedIsNumber = true;
+                    n.cachedRoot = 0;
+                } catch (ProcessError&) {
+                    auto it = myCompiledExpressions.find(n.cachedText);
+                    if (it == myCompiledExpressions.end()) {
+                        it = myCompiledExpressions.insert(std::make_pair(n.cachedText, compileExpression(n.cachedText))).first;
+                    }
+                    n.cachedRoot = it->second;
+                }
+            }
+            if (n.cachedIsNumber) {
+                auto it = myStack.back().find(n.cachedText);
+                return it != myStack.back().end() ? it->second : n.value;
+            }
+            return evalExpressionNode(n.cachedRoot);
+        }
+        case ExpressionType::NOT:
+            return evalExpressionNode(n.args[0]) == 0. ? 1. : 0.;
+        case ExpressionType::NEGATE:
+            return -evalExpressionNode(n.args[0]);
+        case ExpressionType::ROUND: {
+            // same result as writing the value with toString and parsing it again
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "%.*f", (int)gPrecision, evalExpressionNode(n.args[0]));
+            return strtod(buffer, nullptr);
+        }
+        case ExpressionType::BINARY: {
+            const double a = evalExpressionNode(n.args[0]);
+            const double b = evalExpressionNode(n.args[1]);
+            switch (n.op) {
+                case ExpressionOperator::EQUAL:
+                    return (double)(a == b);
+                case ExpressionOperator::NOT_EQUAL:
+                    return (double)(a != b);
+                case ExpressionOperator::LESS:
+                    return (double)(a < b);
+                case ExpressionOperator::GREATER:
+                    return (double)(a > b);
+                case ExpressionOperator::LESS_EQUAL:
+                    return (double)(a <= b);
+                case ExpressionOperator::GREATER_EQUAL:
+                    return (double)(a >= b);
+                case ExpressionOperator::OR:
+                    return (double)(a || b);
+                case ExpressionOperator::AND:
+                    return (double)(a && b);
+                case ExpressionOperator::PLUS:
+                    return a + b;
+                case ExpressionOperator::MINUS:
+                    return a - b;
+                case ExpressionOperator::TIMES:
+                    return a * b;
+                case ExpressionOperator::DIVIDE:
+                    if (b == 0) {
+                        WRITE_ERRORF(TL("Division by 0 in condition '%'"), n.origin);
+                        return 0;
+                    }
+                    return a / b;
+                case ExpressionOperator::MODULO:
+                    return fmod(a, b);
+                case ExpressionOperator::POWER:
+                    return pow(a, b);
+                default:
+                    throw ProcessError("Unsupported operator '" + n.text + "' in condition '" + n.origin + "'");
+            }
+        }
+        case ExpressionType::DETECTION_GAP:
+            return n.loop->getTimeSinceLastDetection();
+        case ExpressionType::LOOP_ACTIVE:
+            return n.loop->getTimeSinceLastDetection() == 0;
+        case ExpressionType::E2_VEHICLES:
+            return n.e2->getCurrentVehicleNumber();
+        case ExpressionType::GREEN_TIME:
+        case ExpressionType::RED_TIME: {
+            const bool green = n.type == ExpressionType::GREEN_TIME;
+            const std::vector<SUMOTime>& times = green ? myLinkGreenTimes : myLinkRedTimes;
+            if (times.empty()) {
+                return 0;
+            }
+            if (myLastTrySwitchTime < SIMSTEP) {
+                // see evalAtomicExpression
+                const LinkState ls = getCurrentPhaseDef().getSignalState(n.linkIndex);
+                if ((green && (ls == LINKSTATE_TL_GREEN_MAJOR || ls == LINKSTATE_TL_GREEN_MINOR))
+                        || (!green && (ls == LINKSTATE_TL_RED || ls == LINKSTATE_TL_REDYELLOW))) {
+                    const SUMOTime currentGreen = SIMSTEP - myLastTrySwitchTime;
+                    return STEPS2TIME(times[n.linkIndex] + currentGreen);
+                }
+                return 0;
+            }
+            return STEPS2TIME(times[n.linkIndex]);
+        }
+        case ExpressionType::CYCLE_TIME:
+            return STEPS2TIME(getTimeInCycle());
+        case ExpressionType::FUNCTION: {
+            std::vector<double> args;
+            for (const int a : n.args) {
+                args.push_back(evalExpressionNode(a));
+            }
+            return callCustomFunction(n.text, *n.function, args);
+        }
+        case ExpressionType::INTERPRETED:
+            return interpretExpression(n.text);
+        default:
+            throw ProcessError(n.text);
+    }
+}
+
+
 double
 MSActuatedTrafficLightLogic::evalTernaryExpression(double a, const std::string& o, double b, const std::string& condition) const {
     if (o == "=" || o == "==") {
@@ -1177,6 +1552,12 @@ MSActuatedTrafficLightLogic::evalCustomFunction(const std::string& fun, const st
     for (auto a : args) {
         args2.push_back(evalExpression(a));
     }
+    return callCustomFunction(fun, f, args2);
+}
+
+
+double
+MSActuatedTrafficLightLogic::callCustomFunction(const std::string& fun, const Function& f, const std::vector<double>& args2) const {
     myStack.push_back(myStack.back());
     myStack.back()["$0"] = 0;
     for (int i = 0; i < (int)args2.size(); i++) {
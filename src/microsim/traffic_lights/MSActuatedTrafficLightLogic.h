@@ -25,6 +25,7 @@
 #include <utility>
 #include <vector>
 #include <bitset>
+#include <deque>
 #include <map>
 #include <microsim/MSEventControl.h>
 #include <microsim/traffic_lights/MSTrafficLightLogic.h>
@@ -105,6 +106,11 @@ public:
     SUMOTime trySwitch() override;
     /// @}
 
+    /// @brief the switching only depends on this logic and its detectors
+    bool isParallelSafe() const override {
+        return true;
+    }
+
     SUMOTime getMinDur(int step = -1) const override;
     SUMOTime getMaxDur(int step = -1) const override;
     SUMOTime getEarliestEnd(int step = -1) const override;
@@ -205,9 +211,12 @@ protected:
     /// @brief select among candidate phases based on detector states and custom switching rules
     int decideNextPhaseCustom(bool mustSwitch);
 
-    /// @brief evaluate custom switching condition
+    /// @brief evaluate custom switching condition (compiled on first use)
     double evalExpression(const std::string& condition) const;
 
+    /// @brief evaluate custom switching condition by parsing the string (used when compiling is not possible)
+    double interpretExpression(const std::string& condition) const;
+
     /// @brief evaluate atomic expression
     double evalTernaryExpression(double a, const std::string& o, double b, const std::string& condition) const;
 
@@ -217,6 +226,68 @@ protected:
     /// @brief evaluate function expression
     double evalCustomFunction(const std::string& fun, const std::string& arg) const;
 
+    /// @brief evaluate the given function for the already evaluated arguments
+    double callCustomFunction(const std::string& fun, const Function& f, const std::vector<double>& args) const;
+
+    /// @name compiled expressions
+    /// @{
+
+    /// @brief the kinds of compiled expression nodes
+    enum class ExpressionType {
+        NUMBER, VARIABLE, CONDITION, NOT, NEGATE, ROUND, BINARY, DETECTION_GAP, LOOP_ACTIVE, E2_VEHICLES,
+        GREEN_TIME, RED_TIME, CYCLE_TIME, FUNCTION, INTERPRETED, ERROR
+    };
+
+    /// @brief the operators of binary expression nodes (INVALID raises an error after evaluating the operands)
+    enum class ExpressionOperator {
+        EQUAL, NOT_EQUAL, LESS, GREATER, LESS_EQUAL, GREATER_EQUAL, OR, AND, PLUS, MINUS, TIMES, DIVIDE, MODULO, POWER, INVALID
+    };
+
+    /// @brief a node of a compiled expression with pre-resolved detectors, links and functions
+    struct ExpressionNode {
+        ExpressionNode(ExpressionType _type, const std::string& _text = "") : type(_type), text(_text) {}
+        ExpressionType type;
+        /// @brief variable name, operator, error message or the text to interpret
+        std::string text;
+        /// @brief the expression for error messages of binary nodes
+        std::string origin;
+        ExpressionOperator op = ExpressionOperator::INVALID;
+        double value = 0;
+        int linkIndex = -1;
+        /// @brief indices of the operands (or function arguments)
+        std::vector<int> args;
+        const MSInductLoop* loop = nullptr;
+        const MSE2Collector* e2 = nullptr;
+        const Function* function = nullptr;
+        /// @brief the current expression of a condition and its evaluation
+        const std::string* condition = nullptr;
+        std::string cachedText;
+        int cachedRoot = -1;
+        bool cachedIsNumber = false;
+    };
+
+    /// @brief compile the expression, falling back to interpretation for unusual constructs
+    int compileExpression(const std::string& condition) const;
+
+    /// @brief compile the expression (recursively)
+    int compileSubExpression(const std::string& condition, const std::string& origin) const;
+
+    /// @brief compile an expression without whitespace
+    int compileAtomicExpression(const std::string& expr, const std::string& origin) const;
+
+    /// @brief the operator of a binary expression node
+    static ExpressionOperator getExpressionOperator(const std::string& o);
+
+    /// @brief add a node and return its index
+    int addExpressionNode(const ExpressionNode& node) const;
+
+    /// @brief evaluate a compiled expression node
+    double evalExpressionNode(int index) const;
+
+    /// @brief the value of a numerical expression (taking precedence of the function stack into account)
+    bool evalNumber(const std::string& text, double& value) const;
+    /// @}
+
     /// @brief execute assignemnts of the logic or a custom function
     void executeAssignments(const AssignmentMap& assignments, ConditionMap& conditions, const ConditionMap& forbidden = ConditionMap()) const;
 
@@ -317,6 +388,12 @@ protected:
     /// @brief The function call stack;
     mutable std::vector<std::map<std::string, double> > myStack;
 
+    /// @brief the nodes of all compiled expressions (a deque keeps the nodes in place when adding)
+    mutable std::deque<ExpressionNode> myExpressionNodes;
+
+    /// @brief the compiled expressions
+    mutable std::map<std::string, int> myCompiledExpressions;
+
     /// @brief the conditions which shall be listed in GUITLLogicPhasesTrackerWindow
     std::set<std::string> myListedConditions;
 
@@ -84,6 +84,11 @@ public:
     SUMOTime trySwitch();
     /// @}
 
+    /// @brief the switching only depends on this logic and its detectors
+    bool isParallelSafe() const override {
+        return true;
+    }
+
     bool showDetectors() const {
         return myShowDetectors;
     }
@@ -603,6 +603,7 @@ MSRailSignal::LinkInfo::reset() {
     myLastRerouteTime = -1;
     myLastRerouteVehicle = nullptr;
     myDriveways.clear();
+    myLastDriveWayIndex = -1;
 }
 
 
@@ -644,6 +645,16 @@ MSRailSignal::LinkInfo::getDriveWay(const SUMOVehicle* veh) {
         }
         return myDriveways.front();
     }
+    // an approaching train asks every step, the result only changes with its route
+    const int routeIndex = (int)(firstIt - veh->getRoute().begin());
+    if (myLastDriveWayIndex >= 0 && myLastDriveWayVehicle == veh->getNumericalID()
+            && myLastDriveWayReroutes == veh->getNumberReroutes() && myLastDriveWayRouteIndex == routeIndex) {
+        return myDriveways[myLastDriveWayIndex];
+    }
+    myLastDriveWayVehicle = veh->getNumericalID();
+    myLastDriveWayReroutes = veh->getNumberReroutes();
+    myLastDriveWayRouteIndex = routeIndex;
+    myLastDriveWayIndex = -1;
     //std::cout << SIMTIME << " veh=" << veh->getID() << " rsl=" << getID() << " dws=" << myDriveways.size() << "\n";
     for (DriveWay& dw : myDriveways) {
         // @todo optimize: it is sufficient to check for specific edges (after each switch)
@@ -664,6 +675,7 @@ MSRailSignal::LinkInfo::getDriveWay(const SUMOVehicle* veh) {
         if (match && itDwRoute == dw.myRoute.end()
                 && (itRoute == veh->getRoute().end() || dw.myFoundSignal || dw.myFoundReversal)) {
             //std::cout << "  using dw=" << "\n";
+            myLastDriveWayIndex = (int)(&dw - myDriveways.data());
             return dw;
         }
 #ifdef DEBUG_SELECT_DRIVEWAY
@@ -675,6 +687,7 @@ MSRailSignal::LinkInfo::getDriveWay(const SUMOVehicle* veh) {
     std::cout << SIMTIME << " rs=" << getID() << " veh=" << veh->getID() << " new dwSignal=" << dw.myFoundSignal << " dwRoute=" << toString(dw.myRoute) << " route=" << toString(veh->getRoute().getEdges()) << "\n";
 #endif
     myDriveways.push_back(dw);
+    myLastDriveWayIndex = (int)myDriveways.size() - 1;
     return myDriveways.back();
 }
 
@@ -1565,6 +1578,7 @@ MSRailSignal::updateDriveway(int numericalID) {
 #endif
                 std::vector<const MSEdge*> route = dw.myRoute;
                 li.myDriveways.erase(it);
+                li.myLastDriveWayIndex = -1;
                 if (li.myDriveways.size() == 0) {
                     // rebuild default driveway
                     li.myDriveways.push_back(li.buildDriveWay(route.begin(), route.end()));
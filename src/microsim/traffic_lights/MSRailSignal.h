@@ -433,6 +433,13 @@ protected:
 
         SUMOTime myLastRerouteTime;
         SUMOVehicle* myLastRerouteVehicle;
+
+        /// @brief the vehicle (numerical id), its number of reroutes and its route index at the last driveway lookup
+        long long int myLastDriveWayVehicle;
+        int myLastDriveWayReroutes;
+        int myLastDriveWayRouteIndex;
+        /// @brief the index of the driveway returned by the last lookup (-1 if the cache is invalid)
+        int myLastDriveWayIndex;
     };
 
     /// @brief data storage for every link at this node (more than one when directly guarding a switch)
@@ -23,6 +23,7 @@
 /****************************************************************************/
 #include <config.h>
 
+#include <algorithm>
 #include <cassert>
 #include <utility>
 #include <vector>
@@ -152,13 +153,7 @@ MSSimpleTrafficLightLogic::getCurrentPhaseDef() const {
 // ------------ Conversion between time and phase
 SUMOTime
 MSSimpleTrafficLightLogic::getPhaseIndexAtTime(SUMOTime simStep) const {
-    SUMOTime position = 0;
-    if (myStep > 0) {
-        for (int i = 0; i < myStep; i++) {
-            position = position + getPhase(i).duration;
-        }
-    }
-    position = position + simStep - getPhase(myStep).myLastSwitch;
+    SUMOTime position = getPhaseOffsets()[myStep] + simStep - getPhase(myStep).myLastSwitch;
     position = position % myDefaultCycleTime;
     assert(position <= myDefaultCycleTime);
     return position;
@@ -168,14 +163,7 @@ MSSimpleTrafficLightLogic::getPhaseIndexAtTime(SUMOTime simStep) const {
 SUMOTime
 MSSimpleTrafficLightLogic::getOffsetFromIndex(int index) const {
     assert(index < (int)myPhases.size());
-    if (index == 0) {
-        return 0;
-    }
-    SUMOTime pos = 0;
-    for (int i = 0; i < index; i++) {
-        pos += getPhase(i).duration;
-    }
-    return pos;
+    return getPhaseOffsets()[index];
 }
 
 
@@ -185,18 +173,31 @@ MSSimpleTrafficLightLogic::getIndexFromOffset(SUMOTime offset) const {
     if (offset == myDefaultCycleTime) {
         return 0;
     }
-    SUMOTime testPos = 0;
-    for (int i = 0; i < (int)myPhases.size(); i++) {
-        testPos = testPos + getPhase(i).duration;
-        if (testPos > offset) {
-            return i;
-        }
-        if (testPos == offset) {
-            assert((int)myPhases.size() > (i + 1));
-            return (i + 1);
+    // the first phase which ends at or after the offset
+    const std::vector<SUMOTime>& offsets = getPhaseOffsets();
+    const auto it = std::lower_bound(offsets.begin() + 1, offsets.end(), offset);
+    if (it == offsets.end()) {
+        return 0;
+    }
+    const int i = (int)(it - offsets.begin()) - 1;
+    if (*it == offset) {
+        assert((int)myPhases.size() > (i + 1));
+        return i + 1;
+    }
+    return i;
+}
+
+
+const std::vector<SUMOTime>&
+MSSimpleTrafficLightLogic::getPhaseOffsets() const {
+    if (myPhaseOffsets.size() != myPhases.size() + 1) {
+        myPhaseOffsets.clear();
+        myPhaseOffsets.push_back(0);
+        for (const MSPhaseDefinition* const phase : myPhases) {
+            myPhaseOffsets.push_back(myPhaseOffsets.back() + phase->duration);
         }
     }
-    return 0;
+    return myPhaseOffsets;
 }
 
 
@@ -305,6 +306,7 @@ MSSimpleTrafficLightLogic::setPhases(const Phases& phases, int step) {
     assert(step < (int)phases.size());
     deletePhases();
     myPhases = phases;
+    myPhaseOffsets.clear();
     myStep = step;
     myDefaultCycleTime = computeCycleTime(myPhases);
 }
@@ -228,4 +228,10 @@ private:
     /// @brief frees memory responsibilities
     void deletePhases();
 
+    /// @brief returns the begin of every phase within the cycle (and the total duration as last element)
+    const std::vector<SUMOTime>& getPhaseOffsets() const;
+
+    /// @brief the cumulated phase durations, rebuilt when the phases change
+    mutable std::vector<SUMOTime> myPhaseOffsets;
+
 };
@@ -34,7 +34,11 @@
 #include "MSTLLogicControl.h"
 #include "MSOffTrafficLightLogic.h"
 #include "MSRailSignalConstraint.h"
+#include <microsim/MSEdge.h>
+#include <microsim/MSEdgeControl.h>
 #include <microsim/MSEventControl.h>
+#include <microsim/MSGlobals.h>
+#include <microsim/MSLane.h>
 #include <microsim/MSNet.h>
 #include <utils/common/StringUtils.h>
 #include <utils/common/ToString.h>
@@ -815,6 +819,50 @@ MSTLLogicControl::check2Switch(SUMOTime step) {
 }
 
 
+void
+MSTLLogicControl::prepareSwitches(SUMOTime step) {
+    std::vector<MSTrafficLightLogic*> due;
+    for (const auto& item : myLogics) {
+        for (MSTrafficLightLogic* const logic : item.second->getAllLogics()) {
+            if (logic->getNextSwitchTime() == step && logic->isParallelSafe()) {
+                due.push_back(logic);
+            }
+        }
+    }
+    if (due.empty()) {
+        return;
+    }
+#ifdef HAVE_FOX
+#ifndef THREAD_POOL
+    if (MSGlobals::gNumSimThreads > 1) {
+        MFXWorkerThread::Pool& pool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+        const int numTasks = MIN2((int)due.size(), 4 * pool.size());
+        for (int i = 0; i < numTasks; i++) {
+            pool.add(new SwitchTask(std::vector<MSTrafficLightLogic*>(due.begin() + i * due.size() / numTasks,
+                                    due.begin() + (i + 1) * due.size() / numTasks), step));
+        }
+        pool.waitAll();
+        return;
+    }
+#endif
+#endif
+    for (MSTrafficLightLogic* const logic : due) {
+        logic->prepareSwitch(step);
+    }
+}
+
+
+#ifdef HAVE_FOX
+void
+MSTLLogicControl::SwitchTask::run(MFXWorkerThread* /*context*/) {
+    MSStepProfiler::Scope span("switchTask");
+    for (MSTrafficLightLogic* const logic : myLogics) {
+        logic->prepareSwitch(myStep);
+    }
+}
+#endif
+
+
 std::pair<SUMOTime, MSPhaseDefinition>
 MSTLLogicControl::getPhaseDef(const std::string& tlid) const {
     MSTrafficLightLogic* tl = getActive(tlid);
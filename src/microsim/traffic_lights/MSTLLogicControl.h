@@ -29,6 +29,10 @@
 #include <utils/common/Command.h>
 #include <utils/common/StdDefs.h>
 #include <utils/xml/SUMOXMLDefinitions.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#include <microsim/output/MSStepProfiler.h>
+#endif
 
 
 // ===========================================================================
@@ -344,6 +348,15 @@ public:
     void check2Switch(SUMOTime step);
 
 
+    /** @brief Evaluates the parallel safe logics which are due to switch in the given step
+     *
+     * The evaluation runs in parallel when using multiple threads, the switch commands
+     *  apply the results (signals and switch actions) in their usual order.
+     * Called from MSNet::simulationStep before the begin of step events
+     */
+    void prepareSwitches(SUMOTime step);
+
+
     /** @brief return the complete phase definition for a named traffic lights logic
      *
      * The phase definition will be the current of the currently active program of
@@ -753,6 +766,24 @@ protected:
     /// @brief Information whether the net was completely loaded
     bool myNetWasLoaded;
 
+#ifdef HAVE_FOX
+    /**
+     * @class SwitchTask
+     * @brief evaluates the switches for a chunk of logics
+     */
+    class SwitchTask : public MFXWorkerThread::Task {
+    public:
+        SwitchTask(const std::vector<MSTrafficLightLogic*>& logics, const SUMOTime step) : myLogics(logics), myStep(step) {}
+        void run(MFXWorkerThread* context);
+    private:
+        const std::vector<MSTrafficLightLogic*> myLogics;
+        const SUMOTime myStep;
+    private:
+        /// @brief Invalidated assignment operator.
+        SwitchTask& operator=(const SwitchTask&) = delete;
+    };
+#endif
+
 
 private:
     /// @brief Invalidated copy constructor.
@@ -52,7 +52,8 @@ const MSTrafficLightLogic::LaneVector MSTrafficLightLogic::myEmptyLaneVector;
 MSTrafficLightLogic::SwitchCommand::SwitchCommand(MSTLLogicControl& tlcontrol,
         MSTrafficLightLogic* tlLogic, SUMOTime nextSwitch) :
     myTLControl(tlcontrol), myTLLogic(tlLogic),
-    myAssumedNextSwitch(nextSwitch), myAmValid(true) {
+    myAssumedNextSwitch(nextSwitch), myAmValid(true),
+    myPreparedTime(-1), myPreparedStep(-1), myPreparedNext(0) {
     // higher than default command priority of 0
     priority = 1;
 }
@@ -69,10 +70,13 @@ MSTrafficLightLogic::SwitchCommand::execute(SUMOTime t) {
         return 0;
     }
     int step1 = myTLLogic->getCurrentPhaseIndex();
-    SUMOTime next = myTLLogic->trySwitch();
-    while (next == 0) {
-        // skip phase and switch again
-        next = myTLLogic->trySwitch();
+    SUMOTime next;
+    if (myPreparedTime == t) {
+        step1 = myPreparedStep;
+        next = myPreparedNext;
+        myPreparedTime = -1;
+    } else {
+        next = trySwitch();
     }
     int step2 = myTLLogic->getCurrentPhaseIndex();
     if (step1 != step2) {
@@ -90,6 +94,25 @@ MSTrafficLightLogic::SwitchCommand::execute(SUMOTime t) {
 }
 
 
+void
+MSTrafficLightLogic::SwitchCommand::prepare(SUMOTime t) {
+    myPreparedStep = myTLLogic->getCurrentPhaseIndex();
+    myPreparedNext = trySwitch();
+    myPreparedTime = t;
+}
+
+
+SUMOTime
+MSTrafficLightLogic::SwitchCommand::trySwitch() {
+    SUMOTime next = myTLLogic->trySwitch();
+    while (next == 0) {
+        // skip phase and switch again
+        next = myTLLogic->trySwitch();
+    }
+    return next;
+}
+
+
 void
 MSTrafficLightLogic::SwitchCommand::deschedule(MSTrafficLightLogic* tlLogic) {
     if (tlLogic == myTLLogic) {
@@ -385,6 +408,12 @@ MSTrafficLightLogic::getNextSwitchTime() const {
 }
 
 
+void
+MSTrafficLightLogic::prepareSwitch(SUMOTime t) {
+    mySwitchCommand->prepare(t);
+}
+
+
 SUMOTime
 MSTrafficLightLogic::getSpentDuration(SUMOTime simStep) const {
     if (simStep == -1) {
@@ -369,6 +369,17 @@ public:
         return myAmActive;
     }
 
+    /** @brief Whether trySwitch only depends on the state of this logic and its detectors
+     *
+     * The switches of such logics may be evaluated in parallel (see MSTLLogicControl::prepareSwitches)
+     */
+    virtual bool isParallelSafe() const {
+        return false;
+    }
+
+    /// @brief evaluates the switch due at the given time in advance (applied when the switch command executes)
+    void prepareSwitch(SUMOTime t);
+
     /// @brief whether the given link index ever turns 'G'
     virtual bool getsMajorGreen(int linkIndex) const;
 
@@ -449,6 +460,9 @@ protected:
             return myAssumedNextSwitch;
         }
 
+        /// @brief calls trySwitch for the given time, execute will only apply the result
+        void prepare(SUMOTime t);
+
         /** @brief Reschedule or deschedule the command when quick-loading state
          *
          * The implementations should return -1 if the command shall not be re-scheduled,
@@ -475,6 +489,18 @@ protected:
         /// @brief Information whether this switch command is still valid
         bool myAmValid;
 
+        /// @brief the time of the prepared switch (-1 if there is none)
+        SUMOTime myPreparedTime;
+
+        /// @brief the phase index before the prepared switch
+        int myPreparedStep;
+
+        /// @brief the result of the prepared switch
+        SUMOTime myPreparedNext;
+
+        /// @brief calls trySwitch until the phase has a duration
+        SUMOTime trySwitch();
+
     private:
         /// @brief Invalidated copy constructor.
         SwitchCommand(const SwitchCommand&);
@@ -57,13 +57,18 @@ const double MSPModel_JuPedSim::GEOS_MIN_AREA = 0.01;
 // ===========================================================================
 MSPModel_JuPedSim::MSPModel_JuPedSim(const OptionsCont& oc, MSNet* net) :
     myNetwork(net), myJPSDeltaT(string2time(oc.getString("pedestrian.jupedsim.step-length"))),
-    myExitTolerance(oc.getFloat("pedestrian.jupedsim.exit-tolerance")) {
+    myExitTolerance(oc.getFloat("pedestrian.jupedsim.exit-tolerance")),
+    myAsyncIteration(oc.getBool("pedestrian.jupedsim.async")) {
     initialize();
     net->getBeginOfTimestepEvents()->addEvent(new Event(this), net->getCurrentTimeStep() + DELTA_T);
+    if (myAsyncIteration) {
+        net->getEndOfTimestepEvents()->addEvent(new UpdateEvent(this), net->getCurrentTimeStep() + DELTA_T);
+    }
 }
 
 
 MSPModel_JuPedSim::~MSPModel_JuPedSim() {
+    waitForIteration();
     clearState();
 
     JPS_Simulation_Free(myJPSSimulation);
@@ -153,6 +158,8 @@ MSPModel_JuPedSim::addWaypoint(JPS_JourneyDescription journey, JPS_StageId& pred
 MSTransportableStateAdapter*
 MSPModel_JuPedSim::add(MSTransportable* person, MSStageMoving* stage, SUMOTime /* now */) {
     assert(person->getCurrentStageType() == MSStageType::WALKING);
+    // persons may start walking while the vehicles move (e.g. when leaving a vehicle)
+    waitForIteration();
     for (PState* const pstate : myPedestrianStates) {  // TODO transform myPedestrianStates into a map for faster lookup
         if (pstate->getPerson() == person) {
             return pstate;
@@ -256,16 +263,49 @@ MSPModel_JuPedSim::remove(MSTransportableStateAdapter* /* state */) {
 
 SUMOTime
 MSPModel_JuPedSim::execute(SUMOTime time) {
+    if (myAsyncIteration) {
+        // the results are collected by the UpdateEvent at the end of the step
+        waitForIteration();
+        myIterationThread = std::thread(&MSPModel_JuPedSim::iterate, this);
+        return DELTA_T;
+    }
+    iterate();
+    waitForIteration();
+    updatePedestrianStates(time);
+    return DELTA_T;
+}
+
+
+void
+MSPModel_JuPedSim::iterate() {
+    // this may run in a separate thread, so errors are only recorded here and reported by waitForIteration
     const int nbrIterations = (int)(DELTA_T / myJPSDeltaT);
     JPS_ErrorMessage message = nullptr;
     for (int i = 0; i < nbrIterations; ++i) {
         // Perform one JuPedSim iteration.
         bool ok = JPS_Simulation_Iterate(myJPSSimulation, &message);
-        if (!ok) {
-            WRITE_ERRORF(TL("Error during iteration %: %"), i, JPS_ErrorMessage_GetMessage(message));
+        if (!ok && myIterationError.empty()) {
+            myIterationError = "Error during iteration " + toString(i) + ": " + JPS_ErrorMessage_GetMessage(message);
         }
     }
+    JPS_ErrorMessage_Free(message);
+}
+
+
+void
+MSPModel_JuPedSim::waitForIteration() {
+    if (myIterationThread.joinable()) {
+        myIterationThread.join();
+    }
+    if (!myIterationError.empty()) {
+        WRITE_ERROR(myIterationError);
+        myIterationError = "";
+    }
+}
+
 
+void
+MSPModel_JuPedSim::updatePedestrianStates(SUMOTime time) {
     // Update the state of all pedestrians.
     // If necessary, this could be done more often in the loop above but the more precise positions are probably never visible.
     // If it is needed for model correctness (precise stopping / arrivals) we should rather reduce SUMO's step-length.
@@ -328,10 +368,6 @@ MSPModel_JuPedSim::execute(SUMOTime time) {
             ++stateIt;
         }
     }
-
-    JPS_ErrorMessage_Free(message);
-
-    return DELTA_T;
 }
 
 
@@ -352,6 +388,7 @@ int MSPModel_JuPedSim::getActiveNumber() {
 
 
 void MSPModel_JuPedSim::clearState() {
+    waitForIteration();
     myPedestrianStates.clear();
     myNumActivePedestrians = 0;
 }
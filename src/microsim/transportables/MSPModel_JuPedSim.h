@@ -25,6 +25,7 @@
 #include <config.h>
 #include <vector>
 #include <map>
+#include <thread>
 #include <geos_c.h>
 #include <jupedsim/jupedsim.h>
 #include "microsim/MSNet.h"
@@ -65,6 +66,21 @@ public:
         MSPModel_JuPedSim* myJPSModel;
     };
 
+    /// @brief the event at the end of the step which collects the results of an asynchronous iteration
+    class UpdateEvent : public Command {
+    public:
+        explicit UpdateEvent(MSPModel_JuPedSim* model)
+            : myJPSModel(model) { }
+        SUMOTime execute(SUMOTime currentTime) override {
+            myJPSModel->waitForIteration();
+            myJPSModel->updatePedestrianStates(currentTime);
+            return DELTA_T;
+        }
+
+    private:
+        MSPModel_JuPedSim* myJPSModel;
+    };
+
 private:
     /**
     * @class PState
@@ -146,6 +162,12 @@ private:
     MSNet* const myNetwork;
     const SUMOTime myJPSDeltaT;
     const double myExitTolerance;
+    /// @brief whether JuPedSim iterates in a background thread while the vehicles move
+    const bool myAsyncIteration;
+    /// @brief the thread running the current asynchronous iteration
+    std::thread myIterationThread;
+    /// @brief the first error of the last iteration
+    std::string myIterationError;
     int myNumActivePedestrians = 0;
     std::vector<PState*> myPedestrianStates;
 
@@ -163,6 +185,12 @@ private:
     static const double GEOS_MIN_AREA;
 
     void initialize();
+    /// @brief performs the JuPedSim iterations for one SUMO step
+    void iterate();
+    /// @brief waits for a running asynchronous iteration (needed before any access to the JuPedSim simulation)
+    void waitForIteration();
+    /// @brief reads the agent positions and advances the stages of the pedestrians
+    void updatePedestrianStates(SUMOTime time);
     void tryPedestrianInsertion(PState* state);
     bool addWaypoint(JPS_JourneyDescription journey, JPS_StageId& predecessor, const Position& point);
     static MSLane* getNextPedestrianLane(const MSLane* const currentLane);
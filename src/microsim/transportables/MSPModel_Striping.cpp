@@ -35,6 +35,8 @@
 #include <microsim/MSStoppingPlace.h>
 #include <microsim/MSVehicleControl.h>
 #include <microsim/MSGlobals.h>
+#include <microsim/MSEdgeControl.h>
+#include <microsim/output/MSStepProfiler.h>
 #include <microsim/transportables/MSStage.h>
 #include <microsim/transportables/MSTransportableControl.h>
 #include "MSPModel_Striping.h"
@@ -91,6 +93,11 @@ SUMOTime MSPModel_Striping::jamTime;
 SUMOTime MSPModel_Striping::jamTimeCrossing;
 SUMOTime MSPModel_Striping::jamTimeNarrow;
 bool MSPModel_Striping::myLegacyPosLat;
+bool MSPModel_Striping::myParallel(false);
+std::vector<std::tuple<int, std::string, bool> > MSPModel_Striping::myDeferredWarnings;
+#ifdef HAVE_FOX
+FXMutex MSPModel_Striping::myDeferredWarningsMutex;
+#endif
 const double MSPModel_Striping::LOOKAHEAD_SAMEDIR(4.0); // seconds
 const double MSPModel_Striping::LOOKAHEAD_ONCOMING(10.0); // seconds
 const double MSPModel_Striping::LOOKAROUND_VEHICLES(60.0); // meters
@@ -114,6 +121,7 @@ const double MSPModel_Striping::MIN_STARTUP_DIST(0.4); // meters
 
 MSPModel_Striping::MSPModel_Striping(const OptionsCont& oc, MSNet* net) :
     myNumActivePedestrians(0),
+    myUseSnapshot(false),
     myAmActive(false) {
     myWalkingAreaDetail = oc.getInt("pedestrian.striping.walkingarea-detail");
     initWalkingAreaPaths(net);
@@ -144,6 +152,7 @@ MSPModel_Striping::MSPModel_Striping(const OptionsCont& oc, MSNet* net) :
         jamTimeNarrow = SUMOTime_MAX;
     }
     myLegacyPosLat = oc.getBool("pedestrian.striping.legacy-departposlat");
+    myParallel = oc.getBool("pedestrian.striping.parallel");
 }
 
 
@@ -157,6 +166,8 @@ MSPModel_Striping::~MSPModel_Striping() {
 void
 MSPModel_Striping::clearState() {
     myActiveLanes.clear();
+    myLeaving.clear();
+    mySnapshot.clear();
     myNumActivePedestrians = 0;
     myAmActive = false;
 }
@@ -177,7 +188,7 @@ MSPModel_Striping::add(MSTransportable* transportable, MSStageMoving* stage, SUM
     const MSLane* lane = stage->checkDepartLane(person->getEdge(), person->getVClass(), stage->getDepartLane(), person->getID());
     if (lane == nullptr) {
         const char* error = TL("Person '%' could not find sidewalk on edge '%', time=%.");
-        if (OptionsCont::getOptions().getBool("ignore-route-errors")) {
+        if (MSGlobals::gIgnoreRouteErrors) {
             WRITE_WARNINGF(error, person->getID(), person->getEdge()->getID(), time2string(net->getCurrentTimeStep()));
             return nullptr;
         } else {
@@ -185,7 +196,7 @@ MSPModel_Striping::add(MSTransportable* transportable, MSStageMoving* stage, SUM
         }
     }
     PState* ped = new PState(person, stage, lane);
-    myActiveLanes[lane].push_back(ped);
+    getActivePedestrians(lane).push_back(ped);
     myNumActivePedestrians++;
     return ped;
 }
@@ -200,7 +211,7 @@ MSPModel_Striping::loadState(MSTransportable* transportable, MSStageMoving* stag
         myAmActive = true;
     }
     PState* ped = new PState(person, stage, &in);
-    myActiveLanes[ped->getLane()].push_back(ped);
+    getActivePedestrians(ped->getLane()).push_back(ped);
     myNumActivePedestrians++;
     return ped;
 }
@@ -209,7 +220,7 @@ MSPModel_Striping::loadState(MSTransportable* transportable, MSStageMoving* stag
 void
 MSPModel_Striping::remove(MSTransportableStateAdapter* state) {
     const MSLane* lane = dynamic_cast<PState*>(state)->myLane;
-    Pedestrians& pedestrians = myActiveLanes[lane];
+    Pedestrians& pedestrians = getActivePedestrians(lane);
     for (Pedestrians::iterator it = pedestrians.begin(); it != pedestrians.end(); ++it) {
         if (*it == state) {
             pedestrians.erase(it);
@@ -316,16 +327,58 @@ MSPModel_Striping::nextBlocking(const MSLane* lane, double minPos, double minRig
 
 MSPModel_Striping::Pedestrians&
 MSPModel_Striping::getPedestrians(const MSLane* lane) {
-    ActiveLanes::iterator it = myActiveLanes.find(lane);
-    if (it != myActiveLanes.end()) {
-        //std::cout << " found lane=" << lane->getID() << " n=" << it->second.size() << "\n";
-        return (it->second);
+    if (lane->getNumericalID() < (int)myActiveLanes.size()) {
+        //std::cout << " found lane=" << lane->getID() << " n=" << myActiveLanes[lane->getNumericalID()].second.size() << "\n";
+        return myActiveLanes[lane->getNumericalID()].second;
     } else {
         return noPedestrians;
     }
 }
 
 
+MSPModel_Striping::Pedestrians&
+MSPModel_Striping::getActivePedestrians(const MSLane* lane) {
+    const int index = lane->getNumericalID();
+    if (index >= (int)myActiveLanes.size()) {
+        myActiveLanes.resize(MAX2(index + 1, MSLane::dictSize()));
+    }
+    myActiveLanes[index].first = lane;
+    return myActiveLanes[index].second;
+}
+
+
+const MSPModel_Striping::Pedestrians&
+MSPModel_Striping::getSortedPedestrians(const MSLane* lane, int dir) {
+    if (myUseSnapshot) {
+        // other threads may be modifying the current state of the lane
+        if (lane->getNumericalID() < (int)mySnapshot.size()) {
+            const LaneSnapshot& snapshot = mySnapshot[lane->getNumericalID()];
+            return dir == FORWARD ? snapshot.forward : snapshot.backward;
+        }
+        return noPedestrians;
+    }
+    Pedestrians& pedestrians = getPedestrians(lane);
+    sort(pedestrians.begin(), pedestrians.end(), by_xpos_sorter(dir));
+    return pedestrians;
+}
+
+
+void
+MSPModel_Striping::warn(const MSLane* lane, const std::string& msg, bool jammed) {
+    if (myParallel) {
+#ifdef HAVE_FOX
+        FXMutexLock lock(myDeferredWarningsMutex);
+#endif
+        myDeferredWarnings.push_back(std::make_tuple(lane->getNumericalID(), msg, jammed));
+    } else {
+        if (jammed) {
+            MSNet::getInstance()->getPersonControl().registerJammed();
+        }
+        WRITE_WARNING(msg);
+    }
+}
+
+
 int
 MSPModel_Striping::numStripes(const MSLane* lane) {
     return MAX2(1, (int)floor(lane->getWidth() / stripeWidth));
@@ -540,7 +593,7 @@ MSPModel_Striping::getNextLane(const PState& ped, const MSLane* currentLane, con
     if (nextRouteLane == nullptr && nextRouteEdge != nullptr) {
         std::string error = "Person '" + ped.myPerson->getID() + "' could not find sidewalk on edge '" + nextRouteEdge->getID() + "', time="
                             + time2string(MSNet::getInstance()->getCurrentTimeStep()) + ".";
-        if (OptionsCont::getOptions().getBool("ignore-route-errors")) {
+        if (MSGlobals::gIgnoreRouteErrors) {
             WRITE_WARNING(error);
             nextRouteLane = nextRouteEdge->getLanes().front();
         } else {
@@ -836,8 +889,8 @@ MSPModel_Striping::getNextLaneObstacles(NextLanesObstacles& nextLanesObs, const
                 }
             }
         }
-        Pedestrians& pedestrians = getPedestrians(nextLane);
         if (nextLane->getEdge().isWalkingArea()) {
+            const Pedestrians& pedestrians = myUseSnapshot ? getSortedPedestrians(nextLane, nextDir) : getPedestrians(nextLane);
             transformToCurrentLanePositions(obs, currentDir, nextDir, currentLength, nextLength);
             // complex transformation into the coordinate system of the current lane
             // (pedestrians on next lane may walk at arbitrary angles relative to the current lane)
@@ -864,7 +917,7 @@ MSPModel_Striping::getNextLaneObstacles(NextLanesObstacles& nextLanesObs, const
             // simple transformation into the coordinate system of the current lane
             // (only need to worry about currentDir and nextDir)
             // XXX consider waitingToEnter on nextLane
-            sort(pedestrians.begin(), pedestrians.end(), by_xpos_sorter(nextDir));
+            const Pedestrians& pedestrians = getSortedPedestrians(nextLane, nextDir);
             for (int ii = 0; ii < (int)pedestrians.size(); ++ii) {
                 const PState& p = *pedestrians[ii];
                 if (p.myWaitingToEnter || p.myAmJammed) {
@@ -941,154 +994,247 @@ MSPModel_Striping::addCloserObstacle(Obstacles& obs, double x, int stripe, int n
 
 void
 MSPModel_Striping::moveInDirection(SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir) {
-    for (ActiveLanes::iterator it_lane = myActiveLanes.begin(); it_lane != myActiveLanes.end(); ++it_lane) {
-        const MSLane* lane = it_lane->first;
-        Pedestrians& pedestrians = it_lane->second;
-        if (pedestrians.size() == 0) {
-            continue;
+    if (myParallel) {
+        moveInDirectionParallel(currentTime, changedLane, dir);
+        return;
+    }
+    // lane changes may register further lanes, so iterators cannot be used
+    for (int i = 0; i < (int)myActiveLanes.size(); i++) {
+        if (myActiveLanes[i].second.size() > 0) {
+            moveLane(myActiveLanes[i].first, myActiveLanes[i].second, currentTime, changedLane, dir);
         }
-        //std::cout << SIMTIME << ">>> lane=" << lane->getID() << " numPeds=" << pedestrians.size() << "\n";
-        if (lane->getEdge().isWalkingArea()) {
-            const double lateral_offset = (lane->getWidth() - stripeWidth) * 0.5;
-            const double minY = stripeWidth * - 0.5 + NUMERICAL_EPS;
-            const double maxY = stripeWidth * (numStripes(lane) - 0.5) - NUMERICAL_EPS;
-            const WalkingAreaPath* debugPath = nullptr;
-            // need to handle each walkingAreaPath separately and transform
-            // coordinates beforehand
-            std::set<const WalkingAreaPath*, walkingarea_path_sorter> paths;
-            for (Pedestrians::iterator it = pedestrians.begin(); it != pedestrians.end(); ++it) {
-                const PState* p = *it;
-                assert(p->myWalkingAreaPath != 0);
-                if (p->myDir == dir) {
-                    paths.insert(p->myWalkingAreaPath);
-                    if DEBUGCOND(*p) {
-                        debugPath = p->myWalkingAreaPath;
-                        std::cout << SIMTIME << " debugging WalkingAreaPath from=" << debugPath->from->getID() << " to=" << debugPath->to->getID() << " minY=" << minY << " maxY=" << maxY << " latOffset=" << lateral_offset << "\n";
-                    }
+    }
+}
+
+
+void
+MSPModel_Striping::moveInDirectionParallel(SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir) {
+    // lanes are grouped by thread index like in MSEdgeControl, so lanes
+    // sharing an RNG are always processed by the same task in id order
+    std::vector<std::vector<const MSLane*> > groups(MSGlobals::gNumSimThreads);
+    std::vector<const MSLane*> lanes;
+    mySnapshot.resize(myActiveLanes.size());
+    myLeaving.resize(myActiveLanes.size());
+    for (const auto& item : myActiveLanes) {
+        if (item.second.size() > 0) {
+            const MSLane* const lane = item.first;
+            LaneSnapshot& snapshot = mySnapshot[lane->getNumericalID()];
+            snapshot.states.reserve(item.second.size());
+            for (const PState* const p : item.second) {
+                snapshot.states.push_back(*p);
+            }
+            for (PState& p : snapshot.states) {
+                snapshot.forward.push_back(&p);
+            }
+            snapshot.backward = snapshot.forward;
+            sort(snapshot.forward.begin(), snapshot.forward.end(), by_xpos_sorter(FORWARD));
+            sort(snapshot.backward.begin(), snapshot.backward.end(), by_xpos_sorter(BACKWARD));
+            groups[lane->getThreadIndex()].push_back(lane);
+            lanes.push_back(lane);
+        }
+    }
+    myUseSnapshot = true;
+    bool moved = false;
+#ifdef HAVE_FOX
+#ifndef THREAD_POOL
+    if (MSGlobals::gNumSimThreads > 1) {
+        MFXWorkerThread::Pool& pool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+        for (const std::vector<const MSLane*>& group : groups) {
+            if (!group.empty()) {
+                MoveLanesTask* const task = new MoveLanesTask(this, currentTime, changedLane, dir);
+                task->myLanes = group;
+                pool.add(task);
+            }
+        }
+        pool.waitAll();
+        moved = true;
+    }
+#endif
+#endif
+    if (!moved) {
+        for (const std::vector<const MSLane*>& group : groups) {
+            moveLanes(group, currentTime, changedLane, dir);
+        }
+    }
+    myUseSnapshot = false;
+    // issue the warnings in lane order (the order within a lane is already deterministic)
+    std::stable_sort(myDeferredWarnings.begin(), myDeferredWarnings.end(),
+    [](const std::tuple<int, std::string, bool>& a, const std::tuple<int, std::string, bool>& b) {
+        return std::get<0>(a) < std::get<0>(b);
+    });
+    for (const auto& warning : myDeferredWarnings) {
+        if (std::get<2>(warning)) {
+            MSNet::getInstance()->getPersonControl().registerJammed();
+        }
+        WRITE_WARNING(std::get<1>(warning));
+    }
+    myDeferredWarnings.clear();
+    // merge the lane changes in lane order
+    for (const MSLane* const lane : lanes) {
+        LaneSnapshot& snapshot = mySnapshot[lane->getNumericalID()];
+        snapshot.forward.clear();
+        snapshot.backward.clear();
+        snapshot.states.clear();
+        Pedestrians& leaving = myLeaving[lane->getNumericalID()];
+        for (PState* const p : leaving) {
+            advance(p, currentTime, changedLane, dir);
+        }
+        leaving.clear();
+    }
+}
+
+
+void
+MSPModel_Striping::moveLanes(const std::vector<const MSLane*>& lanes, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir) {
+    for (const MSLane* const lane : lanes) {
+        moveLane(lane, myActiveLanes[lane->getNumericalID()].second, currentTime, changedLane, dir);
+    }
+}
+
+
+void
+MSPModel_Striping::moveLane(const MSLane* lane, Pedestrians& pedestrians, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir) {
+    //std::cout << SIMTIME << ">>> lane=" << lane->getID() << " numPeds=" << pedestrians.size() << "\n";
+    if (lane->getEdge().isWalkingArea()) {
+        const double lateral_offset = (lane->getWidth() - stripeWidth) * 0.5;
+        const double minY = stripeWidth * - 0.5 + NUMERICAL_EPS;
+        const double maxY = stripeWidth * (numStripes(lane) - 0.5) - NUMERICAL_EPS;
+        const WalkingAreaPath* debugPath = nullptr;
+        // need to handle each walkingAreaPath separately and transform
+        // coordinates beforehand
+        std::set<const WalkingAreaPath*, walkingarea_path_sorter> paths;
+        for (Pedestrians::iterator it = pedestrians.begin(); it != pedestrians.end(); ++it) {
+            const PState* p = *it;
+            assert(p->myWalkingAreaPath != 0);
+            if (p->myDir == dir) {
+                paths.insert(p->myWalkingAreaPath);
+                if DEBUGCOND(*p) {
+                    debugPath = p->myWalkingAreaPath;
+                    std::cout << SIMTIME << " debugging WalkingAreaPath from=" << debugPath->from->getID() << " to=" << debugPath->to->getID() << " minY=" << minY << " maxY=" << maxY << " latOffset=" << lateral_offset << "\n";
                 }
             }
-            const double usableWidth = (numStripes(lane) - 1) * stripeWidth;
-            for (std::set<const WalkingAreaPath*, walkingarea_path_sorter>::iterator it = paths.begin(); it != paths.end(); ++it) {
-                const WalkingAreaPath* path = *it;
-                Pedestrians toDelete;
-                Pedestrians transformedPeds;
-                transformedPeds.reserve(pedestrians.size());
-                for (Pedestrians::iterator it_p = pedestrians.begin(); it_p != pedestrians.end(); ++it_p) {
-                    PState* p = *it_p;
-                    if (p->myWalkingAreaPath == path) {
+        }
+        const double usableWidth = (numStripes(lane) - 1) * stripeWidth;
+        for (std::set<const WalkingAreaPath*, walkingarea_path_sorter>::iterator it = paths.begin(); it != paths.end(); ++it) {
+            const WalkingAreaPath* path = *it;
+            Pedestrians toDelete;
+            Pedestrians transformedPeds;
+            transformedPeds.reserve(pedestrians.size());
+            for (Pedestrians::iterator it_p = pedestrians.begin(); it_p != pedestrians.end(); ++it_p) {
+                PState* p = *it_p;
+                if (p->myWalkingAreaPath == path) {
+                    transformedPeds.push_back(p);
+                    if (path == debugPath) std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << p->myRelX << " relY=" << p->myRelY << " (untransformed), vecCoord="
+                                                         << path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1)) << "\n";
+                } else if (p->myWalkingAreaPath->from == path->to && p->myWalkingAreaPath->to == path->from) {
+                    if (p->myWalkingAreaPath->dir != path->dir) {
+                        // opposite direction is already in the correct coordinate system
                         transformedPeds.push_back(p);
                         if (path == debugPath) std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << p->myRelX << " relY=" << p->myRelY << " (untransformed), vecCoord="
                                                              << path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1)) << "\n";
-                    } else if (p->myWalkingAreaPath->from == path->to && p->myWalkingAreaPath->to == path->from) {
-                        if (p->myWalkingAreaPath->dir != path->dir) {
-                            // opposite direction is already in the correct coordinate system
-                            transformedPeds.push_back(p);
-                            if (path == debugPath) std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << p->myRelX << " relY=" << p->myRelY << " (untransformed), vecCoord="
-                                                                 << path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1)) << "\n";
-                        } else {
-                            // x position must be reversed
-                            PState* tp = new PState(*p);
-                            tp->myRelX = path->length - p->myRelX;
-                            tp->myRelY = usableWidth - p->myRelY;
-                            tp->myDir = !path->dir;
-                            tp->mySpeed = -p->mySpeed;
-                            tp->mySpeedLat = -p->mySpeedLat;
-                            toDelete.push_back(tp);
-                            transformedPeds.push_back(tp);
-                            if (path == debugPath) std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << p->myRelX << " relY=" << p->myRelY << " (semi-transformed), vecCoord="
-                                                                 << path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1)) << "\n";
+                    } else {
+                        // x position must be reversed
+                        PState* tp = new PState(*p);
+                        tp->myRelX = path->length - p->myRelX;
+                        tp->myRelY = usableWidth - p->myRelY;
+                        tp->myDir = !path->dir;
+                        tp->mySpeed = -p->mySpeed;
+                        tp->mySpeedLat = -p->mySpeedLat;
+                        toDelete.push_back(tp);
+                        transformedPeds.push_back(tp);
+                        if (path == debugPath) std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << p->myRelX << " relY=" << p->myRelY << " (semi-transformed), vecCoord="
+                                                             << path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1)) << "\n";
+                    }
+                } else {
+                    const Position relPos = path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1));
+                    const double newY = relPos.y() + lateral_offset;
+                    if (relPos != Position::INVALID && newY >= minY && newY <= maxY) {
+                        PState* tp = new PState(*p);
+                        tp->myRelX = relPos.x();
+                        tp->myRelY = newY;
+                        // only an obstacle, speed may be orthogonal to dir
+                        tp->myDir = !dir;
+                        tp->mySpeed = 0;
+                        tp->mySpeedLat = 0;
+                        toDelete.push_back(tp);
+                        transformedPeds.push_back(tp);
+                        if (path == debugPath) {
+                            std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << relPos.x() << " relY=" << newY << " (transformed), vecCoord=" << relPos << "\n";
                         }
                     } else {
-                        const Position relPos = path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1));
-                        const double newY = relPos.y() + lateral_offset;
-                        if (relPos != Position::INVALID && newY >= minY && newY <= maxY) {
-                            PState* tp = new PState(*p);
-                            tp->myRelX = relPos.x();
-                            tp->myRelY = newY;
-                            // only an obstacle, speed may be orthogonal to dir
-                            tp->myDir = !dir;
-                            tp->mySpeed = 0;
-                            tp->mySpeedLat = 0;
-                            toDelete.push_back(tp);
-                            transformedPeds.push_back(tp);
-                            if (path == debugPath) {
-                                std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << relPos.x() << " relY=" << newY << " (transformed), vecCoord=" << relPos << "\n";
-                            }
-                        } else {
-                            if (path == debugPath) {
-                                std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << relPos.x() << " relY=" << newY << " (invalid), vecCoord=" << relPos << "\n";
-                            }
+                        if (path == debugPath) {
+                            std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << relPos.x() << " relY=" << newY << " (invalid), vecCoord=" << relPos << "\n";
                         }
                     }
                 }
-                auto itFoe = myWalkingAreaFoes.find(&lane->getEdge());
-                if (itFoe != myWalkingAreaFoes.end()) {
-                    // add vehicle foes on paths which cross this walkingarea
-                    // translate the vehicle into a number of dummy-pedestrians
-                    // that occupy the same space
-                    for (const MSLane* foeLane : itFoe->second) {
-                        for (auto itVeh = foeLane->anyVehiclesBegin(); itVeh != foeLane->anyVehiclesEnd(); ++itVeh) {
-                            const MSVehicle* veh = *itVeh;
-                            const double vehWidth = veh->getVehicleType().getWidth();
-                            Boundary relCorners;
-                            Position relFront = path->shape.transformToVectorCoordinates(veh->getPosition());
-                            Position relBack = path->shape.transformToVectorCoordinates(veh->getBackPosition());
-                            PositionVector relCenter;
-                            relCenter.push_back(relFront);
-                            relCenter.push_back(relBack);
-                            relCenter.move2side(vehWidth / 2);
-                            relCorners.add(relCenter[0]);
-                            relCorners.add(relCenter[1]);
-                            relCenter.move2side(-vehWidth);
-                            relCorners.add(relCenter[0]);
-                            relCorners.add(relCenter[1]);
-                            // persons should requier less gap than the vehicles to prevent getting stuck
-                            // when a vehicles moves towards them
-                            relCorners.growWidth(SAFETY_GAP / 2);
-                            const double xWidth = relCorners.getWidth();
-                            const double vehYmin = MAX2(minY - lateral_offset, relCorners.ymin());
-                            const double vehYmax = MIN2(maxY - lateral_offset, relCorners.ymax());
-                            const double xCenter = relCorners.getCenter().x();
-                            Position yMinPos(xCenter, vehYmin);
-                            Position yMaxPos(xCenter, vehYmax);
-                            const bool addFront = addVehicleFoe(veh, lane, yMinPos, dir * xWidth, 0, lateral_offset, minY, maxY, toDelete, transformedPeds);
-                            const bool addBack = addVehicleFoe(veh, lane, yMaxPos, dir * xWidth, 0, lateral_offset, minY, maxY, toDelete, transformedPeds);
-                            if (path == debugPath) {
-                                std::cout << "  veh=" << veh->getID()
-                                          << " corners=" << relCorners
-                                          << " xWidth=" << xWidth
-                                          << " ymin=" << relCorners.ymin()
-                                          << " ymax=" << relCorners.ymax()
-                                          << " vehYmin=" << vehYmin
-                                          << " vehYmax=" << vehYmax
-                                          << "\n";
-                            }
-                            if (addFront && addBack) {
-                                // add in-between positions
-                                const double yDist = vehYmax - vehYmin;
-                                for (double dist = stripeWidth; dist < yDist; dist += stripeWidth) {
-                                    const double relDist = dist / yDist;
-                                    Position between = (yMinPos * relDist) + (yMaxPos * (1 - relDist));
-                                    if (path == debugPath) {
-                                        std::cout << "  vehBetween=" << veh->getID() << " pos=" << between << "\n";
-                                    }
-                                    addVehicleFoe(veh, lane, between, dir * xWidth, stripeWidth, lateral_offset, minY, maxY, toDelete, transformedPeds);
+            }
+            auto itFoe = myWalkingAreaFoes.find(&lane->getEdge());
+            if (itFoe != myWalkingAreaFoes.end()) {
+                // add vehicle foes on paths which cross this walkingarea
+                // translate the vehicle into a number of dummy-pedestrians
+                // that occupy the same space
+                for (const MSLane* foeLane : itFoe->second) {
+                    for (auto itVeh = foeLane->anyVehiclesBegin(); itVeh != foeLane->anyVehiclesEnd(); ++itVeh) {
+                        const MSVehicle* veh = *itVeh;
+                        const double vehWidth = veh->getVehicleType().getWidth();
+                        Boundary relCorners;
+                        Position relFront = path->shape.transformToVectorCoordinates(veh->getPosition());
+                        Position relBack = path->shape.transformToVectorCoordinates(veh->getBackPosition());
+                        PositionVector relCenter;
+                        relCenter.push_back(relFront);
+                        relCenter.push_back(relBack);
+                        relCenter.move2side(vehWidth / 2);
+                        relCorners.add(relCenter[0]);
+                        relCorners.add(relCenter[1]);
+                        relCenter.move2side(-vehWidth);
+                        relCorners.add(relCenter[0]);
+                        relCorners.add(relCenter[1]);
+                        // persons should requier less gap than the vehicles to prevent getting stuck
+                        // when a vehicles moves towards them
+                        relCorners.growWidth(SAFETY_GAP / 2);
+                        const double xWidth = relCorners.getWidth();
+                        const double vehYmin = MAX2(minY - lateral_offset, relCorners.ymin());
+                        const double vehYmax = MIN2(maxY - lateral_offset, relCorners.ymax());
+                        const double xCenter = relCorners.getCenter().x();
+                        Position yMinPos(xCenter, vehYmin);
+                        Position yMaxPos(xCenter, vehYmax);
+                        const bool addFront = addVehicleFoe(veh, lane, yMinPos, dir * xWidth, 0, lateral_offset, minY, maxY, toDelete, transformedPeds);
+                        const bool addBack = addVehicleFoe(veh, lane, yMaxPos, dir * xWidth, 0, lateral_offset, minY, maxY, toDelete, transformedPeds);
+                        if (path == debugPath) {
+                            std::cout << "  veh=" << veh->getID()
+                                      << " corners=" << relCorners
+                                      << " xWidth=" << xWidth
+                                      << " ymin=" << relCorners.ymin()
+                                      << " ymax=" << relCorners.ymax()
+                                      << " vehYmin=" << vehYmin
+                                      << " vehYmax=" << vehYmax
+                                      << "\n";
+                        }
+                        if (addFront && addBack) {
+                            // add in-between positions
+                            const double yDist = vehYmax - vehYmin;
+                            for (double dist = stripeWidth; dist < yDist; dist += stripeWidth) {
+                                const double relDist = dist / yDist;
+                                Position between = (yMinPos * relDist) + (yMaxPos * (1 - relDist));
+                                if (path == debugPath) {
+                                    std::cout << "  vehBetween=" << veh->getID() << " pos=" << between << "\n";
                                 }
+                                addVehicleFoe(veh, lane, between, dir * xWidth, stripeWidth, lateral_offset, minY, maxY, toDelete, transformedPeds);
                             }
                         }
                     }
                 }
-                moveInDirectionOnLane(transformedPeds, lane, currentTime, changedLane, dir, path == debugPath);
-                arriveAndAdvance(pedestrians, currentTime, changedLane, dir);
-                // clean up
-                for (Pedestrians::iterator it_p = toDelete.begin(); it_p != toDelete.end(); ++it_p) {
-                    delete *it_p;
-                }
             }
-        } else {
-            moveInDirectionOnLane(pedestrians, lane, currentTime, changedLane, dir, false);
+            moveInDirectionOnLane(transformedPeds, lane, currentTime, changedLane, dir, path == debugPath);
             arriveAndAdvance(pedestrians, currentTime, changedLane, dir);
+            // clean up
+            for (Pedestrians::iterator it_p = toDelete.begin(); it_p != toDelete.end(); ++it_p) {
+                delete *it_p;
+            }
         }
+    } else {
+        moveInDirectionOnLane(pedestrians, lane, currentTime, changedLane, dir, false);
+        arriveAndAdvance(pedestrians, currentTime, changedLane, dir);
     }
 }
 
@@ -1125,20 +1271,31 @@ MSPModel_Striping::arriveAndAdvance(Pedestrians& pedestrians, SUMOTime currentTi
             // walks) so erase must be called first
             pedestrians.erase(pedestrians.begin() + i);
             i--;
-            p->moveToNextLane(currentTime);
-            if (p->myLane != nullptr) {
-                changedLane.insert(p->myPerson);
-                myActiveLanes[p->myLane].push_back(p);
+            if (myUseSnapshot) {
+                // other lanes are modified after all lanes have moved
+                myLeaving[p->myLane->getNumericalID()].push_back(p);
             } else {
-                // end walking stage and destroy PState
-                p->myStage->moveToNextEdge(p->myPerson, currentTime, dir);
-                myNumActivePedestrians--;
+                advance(p, currentTime, changedLane, dir);
             }
         }
     }
 }
 
 
+void
+MSPModel_Striping::advance(PState* p, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir) {
+    p->moveToNextLane(currentTime);
+    if (p->myLane != nullptr) {
+        changedLane.insert(p->myPerson);
+        getActivePedestrians(p->myLane).push_back(p);
+    } else {
+        // end walking stage and destroy PState
+        p->myStage->moveToNextEdge(p->myPerson, currentTime, dir);
+        myNumActivePedestrians--;
+    }
+}
+
+
 void
 MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane* lane, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir, bool debug) {
     const int stripes = numStripes(lane);
@@ -1287,8 +1444,8 @@ MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane*
                             Obstacle cObs(c);
                             // we check only for real collisions, no min gap violations
                             if (p.distanceTo(cObs, false) == DIST_OVERLAP) {
-                                WRITE_WARNING("Collision of person '" + p.myPerson->getID() + "' and person '" + c.myPerson->getID()
-                                              + "', lane='" + lane->getID() + "', time=" + time2string(currentTime) + ".");
+                                warn(lane, "Collision of person '" + p.myPerson->getID() + "' and person '" + c.myPerson->getID()
+                                     + "', lane='" + lane->getID() + "', time=" + time2string(currentTime) + ".");
                             }
                         }
                     }
@@ -1910,7 +2067,7 @@ MSPModel_Striping::PState::moveToNextLane(SUMOTime currentTime) {
                     myNLI = getNextLane(*this, myLane, oldLane);
                 } else {
                     // disconnnected route. move to the next edge
-                    if (OptionsCont::getOptions().getBool("ignore-route-errors")) {
+                    if (MSGlobals::gIgnoreRouteErrors) {
                         // try to determine direction from topology, otherwise maintain current direction
                         const MSEdge* currRouteEdge = *myStage->getRouteStep();
                         const MSEdge* nextRouteEdge = myStage->getNextRouteEdge();
@@ -1939,7 +2096,7 @@ MSPModel_Striping::PState::moveToNextLane(SUMOTime currentTime) {
             // lane was not checked for obstacles)
             const double newLength = (myWalkingAreaPath == nullptr ? myLane->getLength() : myWalkingAreaPath->length);
             if (-dist > newLength) {
-                assert(OptionsCont::getOptions().getBool("ignore-route-errors"));
+                assert(MSGlobals::gIgnoreRouteErrors);
                 // should not happen because the end of myLane should have been an obstacle as well
                 // (only when the route is broken)
                 dist = -newLength;
@@ -2128,9 +2285,8 @@ MSPModel_Striping::PState::walk(const Obstacles& obs, SUMOTime currentTime) {
                 || myAmJammed) {
             // squeeze slowly through the crowd ignoring others
             if (!myAmJammed) {
-                MSNet::getInstance()->getPersonControl().registerJammed();
-                WRITE_WARNINGF(TL("Person '%' is jammed on edge '%', time=%."),
-                               myPerson->getID(), myStage->getEdge()->getID(), time2string(SIMSTEP));
+                warn(myLane, TLF("Person '%' is jammed on edge '%', time=%.",
+                                 myPerson->getID(), myStage->getEdge()->getID(), time2string(SIMSTEP)), true);
                 myAmJammed = true;
             }
             xSpeed = vMax / 4;
@@ -2139,7 +2295,8 @@ MSPModel_Striping::PState::walk(const Obstacles& obs, SUMOTime currentTime) {
         myAmJammed = false;
     }
     // dawdling
-    const double dawdle = MIN2(xSpeed, RandHelper::rand() * vMax * dawdling);
+    // the lanes which share an RNG are always moved by the same thread
+    const double dawdle = MIN2(xSpeed, RandHelper::rand(myParallel ? myLane->getRNG() : nullptr) * vMax * dawdling);
     xSpeed -= dawdle;
 
     // XXX ensure that diagonal speed <= vMax
@@ -2420,7 +2577,7 @@ MSPModel_Striping::PState::moveToXY(MSPerson* p, Position pos, MSLane* lane, dou
         const MSLane* oldLane = myLane;
         if (lane != myLane) {
             // implicitly adds new active lane if necessary
-            pm->myActiveLanes[lane].push_back(this);
+            pm->getActivePedestrians(lane).push_back(this);
         }
         if (edges.empty()) {
             // map within route
@@ -2594,7 +2751,7 @@ MSPModel_Striping::PState::mergeObstacles(Obstacles& into, const Obstacles& obs2
 bool
 MSPModel_Striping::PState::ignoreRed(const MSLink* link) const {
     if (link->haveRed()) {
-        const double ignoreRedTime = myPerson->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_DRIVE_AFTER_RED_TIME, -1);
+        const double ignoreRedTime = myPerson->getVehicleType().getModelParams().jmDriveAfterRedTime;
         if (ignoreRedTime >= 0) {
             const double redDuration = STEPS2TIME(MSNet::getInstance()->getCurrentTimeStep() - link->getLastStateChange());
             if (DEBUGCOND(*this)) {
@@ -2686,3 +2843,12 @@ MSPModel_Striping::MovePedestrians::execute(SUMOTime currentTime) {
 #endif
     return DELTA_T;
 }
+
+
+#ifdef HAVE_FOX
+void
+MSPModel_Striping::MoveLanesTask::run(MFXWorkerThread* /*context*/) {
+    MSStepProfiler::Scope span("pedestrianTask");
+    myModel->moveLanes(myLanes, myTime, myChangedLane, myDir);
+}
+#endif
@@ -23,6 +23,7 @@
 
 #include <string>
 #include <limits>
+#include <tuple>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/Command.h>
 #include <utils/options/OptionsCont.h>
@@ -137,6 +138,9 @@ public:
     // @brief use old style departPosLat interpretation
     static bool myLegacyPosLat;
 
+    // @brief move the pedestrians of different lanes in parallel
+    static bool myParallel;
+
     // @brief the distance (in seconds) to look ahead for changing stripes
     static const double LOOKAHEAD_SAMEDIR;
     // @brief the distance (in seconds) to look ahead for changing stripes (regarding oncoming pedestrians)
@@ -195,7 +199,8 @@ protected:
     struct Obstacle;
     class PState;
     typedef std::vector<PState*> Pedestrians;
-    typedef std::map<const MSLane*, Pedestrians, lane_by_numid_sorter> ActiveLanes;
+    /// @brief the lanes with pedestrians, indexed by the numerical id of the lane
+    typedef std::vector<std::pair<const MSLane*, Pedestrians> > ActiveLanes;
     typedef std::vector<Obstacle> Obstacles;
     typedef std::map<const MSLane*, Obstacles, lane_by_numid_sorter> NextLanesObstacles;
     typedef std::map<const MSLane*, double> MinNextLengths;
@@ -435,6 +440,32 @@ protected:
         MovePedestrians& operator=(const MovePedestrians&) = delete;
     };
 
+#ifdef HAVE_FOX
+    /// @brief moves the pedestrians of a group of lanes (see moveLanes)
+    class MoveLanesTask : public MFXWorkerThread::Task {
+    public:
+        MoveLanesTask(MSPModel_Striping* model, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir) :
+            myModel(model), myTime(currentTime), myChangedLane(changedLane), myDir(dir) {}
+        void run(MFXWorkerThread* context);
+        std::vector<const MSLane*> myLanes;
+    private:
+        MSPModel_Striping* const myModel;
+        const SUMOTime myTime;
+        std::set<MSPerson*>& myChangedLane;
+        const int myDir;
+    private:
+        /// @brief Invalidated assignment operator.
+        MoveLanesTask& operator=(const MoveLanesTask&) = delete;
+    };
+#endif
+
+    /// @brief the state of the pedestrians of one lane at the start of a parallel movement
+    struct LaneSnapshot {
+        std::vector<PState> states;
+        Pedestrians forward;
+        Pedestrians backward;
+    };
+
     /// @brief sorts the persons by position on the lane. If dir is forward, higher x positions come first.
     class by_xpos_sorter {
     public:
@@ -461,9 +492,26 @@ protected:
     /// @brief move pedestrians forward on one lane
     void moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane* lane, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir, bool debug);
 
+    /// @brief move the pedestrians of a single lane (including walkingareas)
+    void moveLane(const MSLane* lane, Pedestrians& pedestrians, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir);
+
+    /// @brief move all pedestrians forward, the lanes are processed in parallel groups and lane changes are merged afterwards
+    void moveInDirectionParallel(SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir);
+
+    /** @brief move the pedestrians of the given lanes (the work of one thread)
+     *
+     * The pedestrians which reach the end of their lane are removed and stored
+     *  in myLeaving, other lanes are only read by means of the snapshot. The
+     *  set of persons which changed lanes is not modified.
+     */
+    void moveLanes(const std::vector<const MSLane*>& lanes, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir);
+
     /// @brief handle arrivals and lane advancement
     void arriveAndAdvance(Pedestrians& pedestrians, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir);
 
+    /// @brief advance a pedestrian which reached the end of its lane
+    void advance(PState* p, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir);
+
     const ActiveLanes& getActiveLanes() {
         return myActiveLanes;
     }
@@ -520,6 +568,15 @@ private:
     /// @brief retrieves the pedestian vector for the given lane (may be empty)
     Pedestrians& getPedestrians(const MSLane* lane);
 
+    /// @brief retrieves the pedestian vector for the given lane and registers the lane as active
+    Pedestrians& getActivePedestrians(const MSLane* lane);
+
+    /// @brief retrieves the pedestians of the given lane sorted with by_xpos_sorter (from the snapshot when moving in parallel)
+    const Pedestrians& getSortedPedestrians(const MSLane* lane, int dir);
+
+    /// @brief issues the warning (deferred and sorted by lane when moving in parallel)
+    static void warn(const MSLane* lane, const std::string& msg, bool jammed = false);
+
     /* @brief compute stripe-offset to transform relY values from a lane with origStripes into a lane wit destStrips
      * @note this is called once for transforming nextLane peds to into the current system as obstacles and another time
      * (in reverse) to transform the pedestrian coordinates into the nextLane-coordinates when changing lanes
@@ -547,6 +604,15 @@ private:
     /// @brief store of all lanes which have pedestrians on them
     ActiveLanes myActiveLanes;
 
+    /// @brief pedestrians which reached the end of their lane during parallel movement, by lane numerical id
+    std::vector<Pedestrians> myLeaving;
+
+    /// @brief the positions of all pedestrians at the start of the parallel movement, by lane numerical id
+    std::vector<LaneSnapshot> mySnapshot;
+
+    /// @brief whether the snapshot is in use
+    bool myUseSnapshot;
+
     /// @brief whether an event for pedestrian processing was added
     bool myAmActive;
 
@@ -558,4 +624,10 @@ private:
     /// @brief empty pedestrian vector
     static Pedestrians noPedestrians;
 
+    /// @brief warnings issued during parallel movement (lane numerical id, message, whether the person got jammed)
+    static std::vector<std::tuple<int, std::string, bool> > myDeferredWarnings;
+#ifdef HAVE_FOX
+    static FXMutex myDeferredWarningsMutex;
+#endif
+
 };
@@ -25,7 +25,7 @@
 #include <string>
 #include <vector>
 #include <utils/iodevices/OutputDevice.h>
-#include <utils/options/OptionsCont.h>
+#include <microsim/MSGlobals.h>
 #include <utils/common/ToString.h>
 #include <utils/common/StringUtils.h>
 #include <utils/geom/GeomHelper.h>
@@ -135,7 +135,7 @@ MSPerson::MSPersonStage_Walking::proceed(MSNet* net, MSTransportable* person, SU
             }
         }
     }
-    if (OptionsCont::getOptions().getBool("vehroute-output.exit-times")) {
+    if (MSGlobals::gSaveExitTimes) {
         myExitTimes = new std::vector<SUMOTime>();
     }
     (*myRouteStep)->addTransportable(person);
@@ -29,6 +29,7 @@
 #include <microsim/MSEdge.h>
 #include <microsim/MSLane.h>
 #include <microsim/MSNet.h>
+#include <microsim/MSGlobals.h>
 #include <microsim/MSStop.h>
 #include <microsim/MSInsertionControl.h>
 #include <microsim/MSVehicleControl.h>
@@ -341,7 +342,7 @@ MSStageDriving::routeOutput(const bool isPerson, OutputDevice& os, const bool wi
     if (withRouteLength) {
         os.writeAttr("routeLength", myVehicleDistance);
     }
-    if (OptionsCont::getOptions().getBool("vehroute-output.exit-times")) {
+    if (MSGlobals::gSaveExitTimes) {
         os.writeAttr("vehicle", myVehicleID);
         os.writeAttr(SUMO_ATTR_STARTED, myDeparted >= 0 ? time2string(myDeparted) : "-1");
         os.writeAttr(SUMO_ATTR_ENDED, myArrived >= 0 ? time2string(myArrived) : "-1");
@@ -22,7 +22,7 @@
 /****************************************************************************/
 #include <config.h>
 
-#include <utils/options/OptionsCont.h>
+#include <microsim/MSGlobals.h>
 #include <utils/router/IntermodalEdge.h>
 #include <microsim/MSNet.h>
 #include <microsim/MSEdge.h>
@@ -124,7 +124,7 @@ MSStageMoving::checkDepartLane(const MSEdge* edge, SUMOVehicleClass svc, int lan
         const std::vector<MSLane*>& departLanes = edge->getLanes();
         if ((int)departLanes.size() <= laneIndex || !departLanes[laneIndex]->allowsVehicleClass(svc)) {
             std::string error = "Invalid departLane '" + toString(laneIndex) + "' for person '" + id + "'";
-            if (OptionsCont::getOptions().getBool("ignore-route-errors")) {
+            if (MSGlobals::gIgnoreRouteErrors) {
                 WRITE_WARNING(error);
                 return nullptr;
             } else {
@@ -23,7 +23,7 @@
 #include <string>
 #include <vector>
 #include <utils/iodevices/OutputDevice.h>
-#include <utils/options/OptionsCont.h>
+#include <microsim/MSGlobals.h>
 #include <utils/common/ToString.h>
 #include <utils/common/StringUtils.h>
 #include <utils/geom/GeomHelper.h>
@@ -123,7 +123,7 @@ MSStageTranship::routeOutput(const bool /*isPerson*/, OutputDevice& os, const bo
     if (withRouteLength) {
         os.writeAttr("routeLength", mySpeed * STEPS2TIME(myArrived - myDeparted));
     }
-    if (OptionsCont::getOptions().getBool("vehroute-output.exit-times")) {
+    if (MSGlobals::gSaveExitTimes) {
         os.writeAttr(SUMO_ATTR_STARTED, myDeparted >= 0 ? time2string(myDeparted) : "-1");
         os.writeAttr(SUMO_ATTR_ENDED, myArrived >= 0 ? time2string(myArrived) : "-1");
     }
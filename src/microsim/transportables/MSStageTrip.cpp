@@ -24,7 +24,7 @@
 
 #include <utils/common/StringTokenizer.h>
 #include <utils/geom/GeomHelper.h>
-#include <utils/options/OptionsCont.h>
+#include <microsim/MSGlobals.h>
 #include <utils/vehicle/SUMOVehicleParameter.h>
 #include <utils/router/PedestrianRouter.h>
 #include <utils/router/IntermodalRouter.h>
@@ -326,8 +326,8 @@ MSStageTrip::getStageSummary(const bool) const {
 void
 MSStageTrip::routeOutput(const bool /*isPerson*/, OutputDevice& os, const bool /*withRouteLength*/, const MSStage* const previous) const {
     if (myArrived < 0) {
-        const bool walkFactorSet = myWalkFactor != OptionsCont::getOptions().getFloat("persontrip.walkfactor");
-        const bool groupSet = myGroup != OptionsCont::getOptions().getString("persontrip.default.group");
+        const bool walkFactorSet = myWalkFactor != MSGlobals::gPersonTripWalkFactor;
+        const bool groupSet = myGroup != MSGlobals::gPersonTripDefaultGroup;
         // could still be a persontrip but most likely it was a walk in the input
         SumoXMLTag tag = myModeSet == 0 && !walkFactorSet && !groupSet ? SUMO_TAG_WALK : SUMO_TAG_PERSONTRIP;
         os.openTag(tag);
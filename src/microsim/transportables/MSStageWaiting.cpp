@@ -27,6 +27,7 @@
 #include <microsim/MSEdge.h>
 #include <microsim/MSLane.h>
 #include <microsim/MSNet.h>
+#include <microsim/MSGlobals.h>
 #include <microsim/MSStoppingPlace.h>
 #include <microsim/transportables/MSTransportable.h>
 #include <microsim/transportables/MSTransportableControl.h>
@@ -135,7 +136,7 @@ MSStageWaiting::routeOutput(const bool /* isPerson */, OutputDevice& os, const b
         if (myWaitingUntil >= 0) {
             os.writeAttr(SUMO_ATTR_UNTIL, time2string(myWaitingUntil));
         }
-        if (OptionsCont::getOptions().getBool("vehroute-output.exit-times")) {
+        if (MSGlobals::gSaveExitTimes) {
             os.writeAttr(SUMO_ATTR_STARTED, myDeparted >= 0 ? time2string(myDeparted) : "-1");
             os.writeAttr(SUMO_ATTR_ENDED, myArrived >= 0 ? time2string(myArrived) : "-1");
         }
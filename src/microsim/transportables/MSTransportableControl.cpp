@@ -199,9 +199,9 @@ MSTransportableControl::checkWaiting(MSNet* net, const SUMOTime time) {
     while (myWaiting4Departure.find(time) != myWaiting4Departure.end()) {
         TransportableVector& transportables = myWaiting4Departure[time];
         // we cannot use an iterator here because there might be additions to the vector while proceeding
-        for (auto it = transportables.begin(); it != transportables.end();) {
-            MSTransportable* t = *it;
-            it = transportables.erase(it);
+        // (the processed entries are dropped with the whole vector below instead of erasing them one by one)
+        for (int index = 0; index < (int)transportables.size(); index++) {
+            MSTransportable* t = transportables[index];
             myWaitingForDepartureNumber--;
             const bool isPerson = t->isPerson();
             if (t->proceed(net, time)) {
@@ -277,11 +277,19 @@ MSTransportableControl::loadAnyWaiting(const MSEdge* edge, SUMOVehicle* vehicle,
     if (wait != myWaiting4Vehicle.end()) {
         const SUMOTime currentTime = SIMSTEP;
         TransportableVector& transportables = wait->second;
-        for (TransportableVector::iterator i = transportables.begin(); i != transportables.end();) {
+        // the remaining transportables are moved to the front in a single pass (keeping their order)
+        TransportableVector::iterator kept = transportables.begin();
+        for (TransportableVector::iterator i = transportables.begin(); i != transportables.end(); ++i) {
+            if (timeToLoadNext - DELTA_T > currentTime
+                    || (vehicle->getPersonNumber() >= vehicle->getVehicleType().getPersonCapacity()
+                        && vehicle->getContainerNumber() >= vehicle->getVehicleType().getContainerCapacity())) {
+                // the vehicle is busy loading or full, nobody else can board in this step
+                kept = std::move(i, transportables.end(), kept);
+                break;
+            }
             MSTransportable* const t = *i;
             if (t->isWaitingFor(vehicle)
                     && vehicle->allowsBoarding(t)
-                    && timeToLoadNext - DELTA_T <= currentTime
                     && vehicle->isStoppedInRange(t->getEdgePos(), MSGlobals::gStopTolerance)) {
                 edge->removeTransportable(t);
                 vehicle->addTransportable(t);
@@ -300,15 +308,15 @@ MSTransportableControl::loadAnyWaiting(const MSEdge* edge, SUMOVehicle* vehicle,
 
                 static_cast<MSStageDriving*>(t->getCurrentStage())->setVehicle(vehicle);
                 if (t->getCurrentStage()->getOriginStop() != nullptr) {
-                    t->getCurrentStage()->getOriginStop()->removeTransportable(*i);
+                    t->getCurrentStage()->getOriginStop()->removeTransportable(t);
                 }
-                i = transportables.erase(i);
                 myWaitingForVehicleNumber--;
                 ret = true;
             } else {
-                ++i;
+                *kept++ = t;
             }
         }
+        transportables.erase(kept, transportables.end());
         if (transportables.empty()) {
             myWaiting4Vehicle.erase(wait);
         }
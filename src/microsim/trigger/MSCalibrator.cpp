@@ -301,6 +301,19 @@ MSCalibrator::currentSpeed() const {
 }
 
 
+SUMOTime
+MSCalibrator::inactiveDelay(SUMOTime currentTime) const {
+    if (myCurrentStateInterval != myIntervals.end() && myFrequency > 0) {
+        // skip all calls before the begin except for the last one
+        const SUMOTime skipped = (myCurrentStateInterval->begin - currentTime - 1) / myFrequency;
+        if (skipped > 1) {
+            return skipped * myFrequency;
+        }
+    }
+    return myFrequency;
+}
+
+
 bool
 MSCalibrator::removePending() {
     if (myToRemove.size() > 0) {
@@ -354,7 +367,7 @@ MSCalibrator::execute(SUMOTime currentTime) {
             // keep calibrator alive for gui but do not call again
             return TIME2STEPS(86400);
         }
-        return myFrequency;
+        return inactiveDelay(currentTime);
     }
     // we are active
     if (!myDidSpeedAdaption && calibrateSpeed) {
@@ -515,9 +528,12 @@ MSCalibrator::invalidJam(int laneIndex) const {
         // cannot reliably detect invalid jams
         return false;
     }
+    // the capacity is cheaper to check than the mean speed (which iterates over all vehicles)
+    if (remainingVehicleCapacity(laneIndex) >= 1) {
+        return false;
+    }
     // maxSpeed reflects the calibration target
-    const bool toSlow = lane->getMeanSpeed() < myInvalidJamThreshold * myEdge->getSpeedLimit();
-    return toSlow && remainingVehicleCapacity(laneIndex) < 1;
+    return lane->getMeanSpeed() < myInvalidJamThreshold * myEdge->getSpeedLimit();
 }
 
 
@@ -573,6 +589,17 @@ MSCalibrator::updateMeanData() {
 }
 
 
+void
+MSCalibrator::updateVehicleCounts() {
+    myEdgeMeanData.nVehEntered = 0;
+    myEdgeMeanData.nVehDeparted = 0;
+    for (const MSMeanData_Net::MSLaneMeanDataValues* const laneData : myLaneMeanData) {
+        myEdgeMeanData.nVehEntered += laneData->nVehEntered;
+        myEdgeMeanData.nVehDeparted += laneData->nVehDeparted;
+    }
+}
+
+
 bool
 MSCalibrator::VehicleRemover::notifyEnter(SUMOTrafficObject& veh, Notification /* reason */, const MSLane* /* enteredLane */) {
     if (myParent == nullptr) {
@@ -582,7 +609,7 @@ MSCalibrator::VehicleRemover::notifyEnter(SUMOTrafficObject& veh, Notification /
         return false;
     }
     if (myParent->isActive()) {
-        myParent->updateMeanData();
+        myParent->updateVehicleCounts();
         const bool calibrateFlow = myParent->myCurrentStateInterval->q >= 0;
         const int totalWishedNum = myParent->totalWished();
         int adaptedNum = myParent->passed() + myParent->myClearedInJam;
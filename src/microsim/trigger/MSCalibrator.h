@@ -241,6 +241,14 @@ protected:
     /// @brief measured speed in the current interval
     double currentSpeed() const;
 
+    /** @brief the time until the next execution while no interval is active
+     *
+     * The calibrator only needs to run once before the next interval begins
+     *  (to discard the values collected so far), so the intermediate calls
+     *  can be skipped.
+     */
+    SUMOTime inactiveDelay(SUMOTime currentTime) const;
+
     /* @brief returns whether the lane is jammed although it should not be
      * @param[in] lane The lane to check or all for negative values
      */
@@ -268,6 +276,9 @@ protected:
     /// @brief aggregate lane values
     virtual void updateMeanData();
 
+    /// @brief aggregate only the lane counters needed for passed()
+    virtual void updateVehicleCounts();
+
     /** @brief try to schedule the given vehicle for removal. return true if it
      * isn't already scheduled */
     bool scheduleRemoval(SUMOTrafficObject* veh) {
@@ -264,7 +264,7 @@ MSTriggeredRerouter::myEndElement(int element) {
             ri.closedLanesAffected.insert(ri.closedLanesAffected.begin(), affected.begin(), affected.end());
         }
         SUMOTime closingBegin = ri.begin;
-        SUMOTime simBegin = string2time(OptionsCont::getOptions().getString("begin"));
+        SUMOTime simBegin = MSGlobals::gBegin;
         if (closingBegin < simBegin && ri.end > simBegin) {
             // interval started before simulation begin but is still active at
             // the start of the simulation
@@ -290,7 +290,8 @@ MSTriggeredRerouter::myEndElement(int element) {
 
 SUMOTime
 MSTriggeredRerouter::setPermissions(const SUMOTime currentTime) {
-    bool updateVehicles = false;
+    // edges are rebuilt once even if several of their lanes or intervals change
+    std::set<MSEdge*, ComparatorNumericalIdLess> changed;
     for (const RerouteInterval& i : myIntervals) {
         if (i.begin == currentTime && !(i.closed.empty() && i.closedLanes.empty()) && i.permissions != SVCAll) {
             for (MSEdge* e : i.closed) {
@@ -298,13 +299,11 @@ MSTriggeredRerouter::setPermissions(const SUMOTime currentTime) {
                     //std::cout << SIMTIME << " closing: intervalID=" << i.id << " lane=" << (*l)->getID() << " prevPerm=" << getVehicleClassNames((*l)->getPermissions()) << " new=" << getVehicleClassNames(i.permissions) << "\n";
                     lane->setPermissions(i.permissions, i.id);
                 }
-                e->rebuildAllowedLanes();
-                updateVehicles = true;
+                changed.insert(e);
             }
             for (MSLane* lane : i.closedLanes) {
                 lane->setPermissions(i.permissions, i.id);
-                lane->getEdge().rebuildAllowedLanes();
-                updateVehicles = true;
+                changed.insert(&lane->getEdge());
             }
             MSNet::getInstance()->getBeginOfTimestepEvents()->addEvent(
                 new WrappingCommand<MSTriggeredRerouter>(this, &MSTriggeredRerouter::setPermissions), i.end);
@@ -315,21 +314,19 @@ MSTriggeredRerouter::setPermissions(const SUMOTime currentTime) {
                     lane->resetPermissions(i.id);
                     //std::cout << SIMTIME << " opening: intervalID=" << i.id << " lane=" << (*l)->getID() << " restore prevPerm=" << getVehicleClassNames((*l)->getPermissions()) << "\n";
                 }
-                e->rebuildAllowedLanes();
-                updateVehicles = true;
+                changed.insert(e);
             }
             for (MSLane* lane : i.closedLanes) {
                 lane->resetPermissions(i.id);
-                lane->getEdge().rebuildAllowedLanes();
-                updateVehicles = true;
+                changed.insert(&lane->getEdge());
             }
         }
     }
-    if (updateVehicles) {
-        // only vehicles on the affected lanes had their bestlanes updated so far
+    if (!changed.empty()) {
+        MSEdge::rebuildPermissions(changed);
+        // the allowed targets of the rerouter edges are only affected if they are adjacent to a changed edge (rebuilt above)
         for (MSEdge* e : myEdges) {
-            // also updates vehicles
-            e->rebuildAllowedTargets();
+            e->updateVehicleBestLanes();
         }
     }
     return 0;
@@ -799,6 +796,8 @@ MSTriggeredRerouter::rerouteParkingArea(const MSTriggeredRerouter::RerouteInterv
         const double parkingFrustration = getWeight(veh, "parking.frustration", 100);
         const double parkingKnowledge = getWeight(veh, "parking.knowledge", 0);
 
+        // the alternatives (index and assumed occupancy) which are not full
+        std::vector<std::pair<int, double> > candidates;
         for (int i = 0; i < (int)parks.size(); ++i) {
             MSParkingArea* pa = parks[i].first;
             // alternative occupancy is randomized (but never full) if invisible
@@ -822,15 +821,26 @@ MSTriggeredRerouter::rerouteParkingArea(const MSTriggeredRerouter::RerouteInterv
                 }
             }
             if (paOccupancy < pa->getCapacity()) {
-                if (addParkValues(veh, brakeGap, newDestination, pa, paOccupancy, probs[i], router, parkAreas, newRoutes, parkApproaches, maxValues)) {
-                    numAlternatives++;
-                }
+                candidates.push_back(std::make_pair(i, paOccupancy));
             } else if (visible) {
                 // might only be visible now (i.e. because it's on the other
                 // side of the street), so we should remember this for later.
                 veh.rememberBlockedParkingArea(pa, &pa->getLane().getEdge() == veh.getEdge());
             }
         }
+        // all routes to the candidates start at the same place, so the search tree is shared (bulk mode)
+        std::vector<ConstMSEdgeVector> edgesToPark(candidates.size());
+        router.setAutoBulkMode(true);
+        for (int k = 0; k < (int)candidates.size(); k++) {
+            computeParkApproach(veh, parks[candidates[k].first].first, router, edgesToPark[k]);
+        }
+        router.setAutoBulkMode(false);
+        for (int k = 0; k < (int)candidates.size(); k++) {
+            const int i = candidates[k].first;
+            if (addParkValues(veh, brakeGap, newDestination, parks[i].first, candidates[k].second, probs[i], router, parkAreas, newRoutes, parkApproaches, maxValues, &edgesToPark[k])) {
+                numAlternatives++;
+            }
+        }
         if (numAlternatives == 0) {
             // use parkingArea with lowest blockedTime
             std::sort(blockedTimes.begin(), blockedTimes.end(),
@@ -868,7 +878,7 @@ MSTriggeredRerouter::rerouteParkingArea(const MSTriggeredRerouter::RerouteInterv
             }
             if (numAlternatives == 0) {
                 // take any random target but prefer that that haven't been visited yet
-                std::vector<std::pair<SUMOTime, MSParkingArea*> > candidates;
+                std::vector<std::pair<SUMOTime, MSParkingArea*> > randomCandidates;
                 for (const ParkingAreaVisible& pav : parks) {
                     if (pav.first == destParkArea) {
                         continue;
@@ -878,19 +888,19 @@ MSTriggeredRerouter::rerouteParkingArea(const MSTriggeredRerouter::RerouteInterv
                         // randomize among the unvisited
                         dummy = -RandHelper::rand(1000000);
                     }
-                    candidates.push_back(std::make_pair(dummy, pav.first));
+                    randomCandidates.push_back(std::make_pair(dummy, pav.first));
                 }
-                std::sort(candidates.begin(), candidates.end(),
+                std::sort(randomCandidates.begin(), randomCandidates.end(),
                 [](std::tuple<SUMOTime, MSParkingArea*> const & t1, std::tuple<SUMOTime, MSParkingArea*> const & t2) {
                     return std::get<0>(t1) < std::get<0>(t2) || (std::get<0>(t1) == std::get<0>(t2) && std::get<1>(t1)->getID() < std::get<1>(t2)->getID());
                 }
                          );
-                for (auto item : candidates) {
+                for (auto item : randomCandidates) {
                     MSParkingArea* pa = item.second;
                     if (addParkValues(veh, brakeGap, newDestination, pa, 0, 1, router, parkAreas, newRoutes, parkApproaches, maxValues)) {
 #ifdef DEBUG_PARKING
                         if (DEBUGCOND) {
-                            std::cout << "    altPA=" << pa->getID() << " targeting occupied pa (based on pure randomness) among " << candidates.size() << " alternatives\n";
+                            std::cout << "    altPA=" << pa->getID() << " targeting occupied pa (based on pure randomness) among " << randomCandidates.size() << " alternatives\n";
                         }
 #endif
                         numAlternatives = 1;
@@ -1016,7 +1026,8 @@ MSTriggeredRerouter::addParkValues(SUMOVehicle& veh, double brakeGap, bool newDe
                                    MSParkingAreaMap_t& parkAreas,
                                    std::map<MSParkingArea*, ConstMSEdgeVector>& newRoutes,
                                    std::map<MSParkingArea*, ConstMSEdgeVector>& parkApproaches,
-                                   ParkingParamMap_t& maxValues) {
+                                   ParkingParamMap_t& maxValues,
+                                   const ConstMSEdgeVector* precomputedEdgesToPark) {
     // a map stores the parking values
     ParkingParamMap_t parkValues;
 
@@ -1030,7 +1041,11 @@ MSTriggeredRerouter::addParkValues(SUMOVehicle& veh, double brakeGap, bool newDe
     ConstMSEdgeVector edgesToPark;
     const double parkPos = pa->getLastFreePos(veh);
     const MSEdge* rerouteOrigin = *veh.getRerouteOrigin();
-    router.compute(rerouteOrigin, veh.getPositionOnLane(), parkEdge, parkPos, &veh, MSNet::getInstance()->getCurrentTimeStep(), edgesToPark, true);
+    if (precomputedEdgesToPark != nullptr) {
+        edgesToPark = *precomputedEdgesToPark;
+    } else {
+        computeParkApproach(veh, pa, router, edgesToPark);
+    }
 
 #ifdef DEBUG_PARKING
     if (DEBUGCOND) {
@@ -1194,6 +1209,14 @@ MSTriggeredRerouter::addParkValues(SUMOVehicle& veh, double brakeGap, bool newDe
 }
 
 
+void
+MSTriggeredRerouter::computeParkApproach(SUMOVehicle& veh, MSParkingArea* pa,
+        SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, ConstMSEdgeVector& into) {
+    router.compute(*veh.getRerouteOrigin(), veh.getPositionOnLane(), &pa->getLane().getEdge(), pa->getLastFreePos(veh),
+                   &veh, MSNet::getInstance()->getCurrentTimeStep(), into, true);
+}
+
+
 bool
 MSTriggeredRerouter::vehicleApplies(const SUMOVehicle& veh) const {
     if (myVehicleTypes.empty() || myVehicleTypes.count(veh.getVehicleType().getOriginalID()) > 0) {
@@ -221,14 +221,21 @@ protected:
     typedef std::map<std::string, double> ParkingParamMap_t;
     typedef std::map<MSParkingArea*, ParkingParamMap_t, ComparatorIdLess> MSParkingAreaMap_t;
 
-    /// determine attributes of candiate parking area for scoring
+    /** @brief determine attributes of candiate parking area for scoring
+     * @param[in] edgesToPark The route to the parking area if it was computed already (see computeParkApproach)
+     */
     static bool addParkValues(SUMOVehicle& veh, double brakeGap, bool newDestination,
                               MSParkingArea* pa, double paOccupancy, double prob,
                               SUMOAbstractRouter<MSEdge, SUMOVehicle>& router,
                               MSParkingAreaMap_t& parkAreas,
                               std::map<MSParkingArea*, ConstMSEdgeVector>& newRoutes,
                               std::map<MSParkingArea*, ConstMSEdgeVector>& parkApproaches,
-                              ParkingParamMap_t& maxValues);
+                              ParkingParamMap_t& maxValues,
+                              const ConstMSEdgeVector* edgesToPark = nullptr);
+
+    /// @brief computes the route from the reroute origin of the vehicle to the parking area
+    static void computeParkApproach(SUMOVehicle& veh, MSParkingArea* pa,
+                                    SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, ConstMSEdgeVector& into);
 
 protected:
     /// @brief edges where vehicles are notified
@@ -965,13 +965,14 @@ NBEdge::reduceGeometry(const double minDist) {
     // attempt symmetrical removal for forward and backward direction
     // (very important for bidiRail)
     if (myFrom->getID() < myTo->getID()) {
-        PositionVector reverse = myGeom.reverse();
-        reverse.removeDoublePoints(minDist, true, 0, 0, true);
-        myGeom = reverse.reverse();
+        // reverse in place instead of working on reversed copies
+        std::reverse(myGeom.begin(), myGeom.end());
+        myGeom.removeDoublePoints(minDist, true, 0, 0, true);
+        std::reverse(myGeom.begin(), myGeom.end());
         for (Lane& lane : myLanes) {
-            reverse = lane.customShape.reverse();
-            reverse.removeDoublePoints(minDist, true, 0, 0, true);
-            lane.customShape = reverse.reverse();
+            std::reverse(lane.customShape.begin(), lane.customShape.end());
+            lane.customShape.removeDoublePoints(minDist, true, 0, 0, true);
+            std::reverse(lane.customShape.begin(), lane.customShape.end());
         }
     } else {
         myGeom.removeDoublePoints(minDist, true, 0, 0, true);
@@ -782,14 +782,16 @@ NBEdgeCont::removeUnwishedEdges(NBDistrictCont& dc) {
 
 void
 NBEdgeCont::splitGeometry(NBDistrictCont& dc, NBNodeCont& nc) {
-    // make a copy of myEdges because splitting will modify it
-    EdgeCont edges = myEdges;
-    for (auto& item : edges) {
-        NBEdge* edge = item.second;
-        if (edge->getGeometry().size() < 3) {
-            continue;
+    // collect the candidates first because splitting will modify myEdges
+    std::vector<NBEdge*> edges;
+    for (const auto& item : myEdges) {
+        if (item.second->getGeometry().size() >= 3) {
+            edges.push_back(item.second);
         }
-        PositionVector geom = edge->getGeometry();
+    }
+    for (NBEdge* edge : edges) {
+        // copy the geometry because splitting will modify it
+        const PositionVector geom = edge->getGeometry();
         const std::string id = edge->getID();
         double offset = 0;
         for (int i = 1; i < (int)geom.size() - 1; i++) {
@@ -809,21 +811,21 @@ NBEdgeCont::splitGeometry(NBDistrictCont& dc, NBNodeCont& nc) {
 
 void
 NBEdgeCont::reduceGeometries(const double minDist) {
-    for (EdgeCont::iterator i = myEdges.begin(); i != myEdges.end(); ++i) {
-        (*i).second->reduceGeometry(minDist);
-    }
+    computeForAllEdges([minDist](NBEdge * edge) {
+        edge->reduceGeometry(minDist);
+    });
 }
 
 
 void
 NBEdgeCont::checkGeometries(const double maxAngle, const double minRadius, bool fix, bool fixRailways, bool silent) {
     if (maxAngle > 0 || minRadius > 0) {
-        for (auto& item : myEdges) {
-            if (isSidewalk(item.second->getPermissions()) || isForbidden(item.second->getPermissions())) {
-                continue;
+        computeForAllEdges([maxAngle, minRadius, fix, fixRailways, silent](NBEdge * edge) {
+            if (isSidewalk(edge->getPermissions()) || isForbidden(edge->getPermissions())) {
+                return;
             }
-            item.second->checkGeometry(maxAngle, minRadius, fix || (fixRailways && isRailway(item.second->getPermissions())), silent);
-        }
+            edge->checkGeometry(maxAngle, minRadius, fix || (fixRailways && isRailway(edge->getPermissions())), silent);
+        });
     }
 }
 
@@ -967,9 +969,10 @@ NBEdgeCont::appendRailwayTurnarounds(const NBPTStopCont& sc) {
 
 void
 NBEdgeCont::computeEdgeShapes(double smoothElevationThreshold) {
-    for (EdgeCont::iterator i = myEdges.begin(); i != myEdges.end(); i++) {
-        (*i).second->computeEdgeShape(smoothElevationThreshold);
-    }
+    // an edge only modifies its own geometry and reads the (already computed) node shapes
+    computeForAllEdges([smoothElevationThreshold](NBEdge * edge) {
+        edge->computeEdgeShape(smoothElevationThreshold);
+    });
     // equalize length of opposite edges
     for (EdgeCont::iterator i = myEdges.begin(); i != myEdges.end(); i++) {
         NBEdge* edge = i->second;
@@ -989,11 +992,47 @@ NBEdgeCont::computeEdgeShapes(double smoothElevationThreshold) {
 }
 
 
+
 void
-NBEdgeCont::computeLaneShapes() {
-    for (EdgeCont::iterator i = myEdges.begin(); i != myEdges.end(); ++i) {
-        (*i).second->computeLaneShapes();
+NBEdgeCont::computeForAllEdges(const std::function<void(NBEdge*)>& func) {
+#ifdef HAVE_FOX
+    if (myThreadPool != nullptr && myThreadPool->size() > 0 && !myEdges.empty()) {
+        std::vector<NBEdge*> edges;
+        edges.reserve(myEdges.size());
+        for (const auto& item : myEdges) {
+            edges.push_back(item.second);
+        }
+        const int numTasks = MIN2((int)edges.size(), 4 * myThreadPool->size());
+        const int chunkSize = ((int)edges.size() + numTasks - 1) / numTasks;
+        for (int i = 0; i < (int)edges.size(); i += chunkSize) {
+            myThreadPool->add(new EdgeTask(edges.begin() + i, edges.begin() + MIN2(i + chunkSize, (int)edges.size()), func));
+        }
+        myThreadPool->waitAll();
+        return;
     }
+#endif
+    for (EdgeCont::iterator i = myEdges.begin(); i != myEdges.end(); i++) {
+        func((*i).second);
+    }
+}
+
+
+#ifdef HAVE_FOX
+void
+NBEdgeCont::EdgeTask::run(MFXWorkerThread* /* context */) {
+    for (std::vector<NBEdge*>::const_iterator i = myFirst; i != myLast; ++i) {
+        myFunc(*i);
+    }
+}
+#endif
+
+
+void
+NBEdgeCont::computeLaneShapes() {
+    // an edge only modifies its own lanes (the lane spread may depend on the geometry of the opposite edge)
+    computeForAllEdges([](NBEdge * edge) {
+        edge->computeLaneShapes();
+    });
 }
 
 
@@ -22,6 +22,7 @@
 #pragma once
 #include <config.h>
 
+#include <functional>
 #include <map>
 #include <iostream>
 #include <string>
@@ -32,6 +33,9 @@
 #include <utils/common/UtilExceptions.h>
 #include <utils/geom/PositionVector.h>
 #include <utils/common/NamedRTree.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#endif
 
 
 // ===========================================================================
@@ -421,6 +425,13 @@ public:
      */
     void computeEdgeShapes(double smoothElevationThreshold = -1);
 
+#ifdef HAVE_FOX
+    /// @brief sets the thread pool for the per edge geometry computations (nullptr for serial computation)
+    void setThreadPool(MFXWorkerThread::Pool* pool) {
+        myThreadPool = pool;
+    }
+#endif
+
     /** @brief Computes the shapes of all lanes of all edges stored in the container
      *
      * Calls "NBEdge::computeLaneShapes" for all edges within the container.
@@ -792,6 +803,36 @@ private:
         }
     };
 
+    /** @brief applies the function to all edges
+     *
+     * Without a thread pool the edges are processed in id order, otherwise in
+     *  parallel chunks. The function may only modify the given edge.
+     */
+    void computeForAllEdges(const std::function<void(NBEdge*)>& func);
+
+#ifdef HAVE_FOX
+    /**
+     * @class EdgeTask
+     * @brief applies a function to a range of edges
+     */
+    class EdgeTask : public MFXWorkerThread::Task {
+    public:
+        EdgeTask(std::vector<NBEdge*>::const_iterator first, std::vector<NBEdge*>::const_iterator last, const std::function<void(NBEdge*)>& func)
+            : myFirst(first), myLast(last), myFunc(func) {}
+        void run(MFXWorkerThread* context);
+    private:
+        const std::vector<NBEdge*>::const_iterator myFirst;
+        const std::vector<NBEdge*>::const_iterator myLast;
+        const std::function<void(NBEdge*)>& myFunc;
+    private:
+        /// @brief Invalidated assignment operator.
+        EdgeTask& operator=(const EdgeTask&) = delete;
+    };
+
+    /// @brief the thread pool for the parallel geometry stages
+    MFXWorkerThread::Pool* myThreadPool = nullptr;
+#endif
+
     /// @brief invalidated copy constructor
     NBEdgeCont(const NBEdgeCont& s) = delete;
 
@@ -116,6 +116,9 @@ NBFrame::fillOptions(OptionsCont& oc, bool forNetgen) {
     oc.doRegister("no-internal-links", new Option_Bool(false)); // !!! not described
     oc.addDescription("no-internal-links", "Junctions", TL("Omits internal links"));
 
+    oc.doRegister("threads", new Option_Integer(1));
+    oc.addDescription("threads", "Processing", TL("Defines the number of threads for computing junction shapes, connections, right-of-way logics and edge shapes"));
+
     oc.doRegister("numerical-ids", new Option_Bool(false));
     oc.addDescription("numerical-ids", "Processing", TL("Remaps alphanumerical IDs of nodes and edges to ensure that all IDs are integers"));
 
@@ -88,28 +88,8 @@ NBHeightMapper::getZ(const Position& geo) const {
         WRITE_WARNING(TL("Cannot supply height since no height data was loaded"));
         return 0;
     }
-    for (auto& item : myRasters) {
-        const Boundary& boundary = item.boundary;
-        int16_t* raster = item.raster;
-        double result = -1e6;
-        if (boundary.around(geo)) {
-            const int xSize = item.xSize;
-            const double normX = (geo.x() - boundary.xmin()) / mySizeOfPixel.x();
-            const double normY = (geo.y() - boundary.ymax()) / mySizeOfPixel.y();
-            PositionVector corners;
-            corners.push_back(Position(floor(normX) + 0.5, floor(normY) + 0.5, raster[(int)normY * xSize + (int)normX]));
-            if (normX - floor(normX) > 0.5) {
-                corners.push_back(Position(floor(normX) + 1.5, floor(normY) + 0.5, raster[(int)normY * xSize + (int)normX + 1]));
-            } else {
-                corners.push_back(Position(floor(normX) - 0.5, floor(normY) + 0.5, raster[(int)normY * xSize + (int)normX - 1]));
-            }
-            if (normY - floor(normY) > 0.5 && ((int)normY + 1) < item.ySize) {
-                corners.push_back(Position(floor(normX) + 0.5, floor(normY) + 1.5, raster[((int)normY + 1) * xSize + (int)normX]));
-            } else {
-                corners.push_back(Position(floor(normX) + 0.5, floor(normY) - 0.5, raster[((int)normY - 1) * xSize + (int)normX]));
-            }
-            result = Triangle(corners).getZ(Position(normX, normY));
-        }
+    for (const RasterData& item : myRasters) {
+        const double result = getRasterZ(item, geo);
         if (result > -1e5 && result < 1e5) {
             return result;
         }
@@ -123,11 +103,11 @@ NBHeightMapper::getZ(const Position& geo) const {
     maxB[1] = (float)geo.y() + 0.00001f;
     QueryResult queryResult;
     int hits = myRTree.Search(minB, maxB, queryResult);
-    Triangles result = queryResult.triangles;
+    const Triangles& result = queryResult.triangles;
     assert(hits == (int)result.size());
     UNUSED_PARAMETER(hits); // only used for assertion
 
-    for (Triangles::iterator it = result.begin(); it != result.end(); it++) {
+    for (Triangles::const_iterator it = result.begin(); it != result.end(); it++) {
         const Triangle* triangle = *it;
         if (triangle->contains(geo)) {
             return triangle->getZ(geo);
@@ -138,6 +118,34 @@ NBHeightMapper::getZ(const Position& geo) const {
 }
 
 
+double
+NBHeightMapper::getRasterZ(const RasterData& item, const Position& geo) const {
+    const Boundary& boundary = item.boundary;
+    if (!boundary.around(geo)) {
+        return -1e6;
+    }
+    const int16_t* const raster = item.raster;
+    const int xSize = item.xSize;
+    const double normX = (geo.x() - boundary.xmin()) / mySizeOfPixel.x();
+    const double normY = (geo.y() - boundary.ymax()) / mySizeOfPixel.y();
+    const double fx = floor(normX);
+    const double fy = floor(normY);
+    const int index = (int)normY * xSize + (int)normX;
+    // same plane as Triangle::getZ but without allocating a PositionVector per query
+    Position p0(fx + 0.5, fy + 0.5, raster[index]);
+    const Position p1 = normX - fx > 0.5
+                        ? Position(fx + 1.5, fy + 0.5, raster[index + 1])
+                        : Position(fx - 0.5, fy + 0.5, raster[index - 1]);
+    const Position p2 = normY - fy > 0.5 && ((int)normY + 1) < item.ySize
+                        ? Position(fx + 0.5, fy + 1.5, raster[index + xSize])
+                        : Position(fx + 0.5, fy - 0.5, raster[index - xSize]);
+    Position side1 = p1 - p0;
+    const Position normal = side1.crossProduct(p2 - p0);
+    p0.sub(Position(normX, normY));
+    return p0.dotProduct(normal) / normal.z();
+}
+
+
 void
 NBHeightMapper::addTriangle(PositionVector corners) {
     Triangle* triangle = new Triangle(corners);
@@ -357,6 +365,7 @@ NBHeightMapper::clearData() {
         delete *it;
     }
     myTriangles.clear();
+    myRTree.RemoveAll();
 #ifdef HAVE_GDAL
     for (auto& item : myRasters) {
         CPLFree(item.raster);
@@ -374,6 +383,9 @@ NBHeightMapper::Triangle::Triangle(const PositionVector& corners):
     myCorners(corners) {
     assert(myCorners.size() == 3);
     // @todo assert non-colinearity
+    Position side1 = myCorners[1] - myCorners[0];
+    Position side2 = myCorners[2] - myCorners[0];
+    myNormal = side1.crossProduct(side2);
 }
 
 
@@ -395,17 +407,13 @@ NBHeightMapper::Triangle::getZ(const Position& geo) const {
     Position p0 = myCorners.front();
     Position line(0, 0, 1);
     p0.sub(geo); // p0 - l0
-    Position normal = normalVector();
-    return p0.dotProduct(normal) / line.dotProduct(normal);
+    return p0.dotProduct(myNormal) / line.dotProduct(myNormal);
 }
 
 
 Position
 NBHeightMapper::Triangle::normalVector() const {
-    // @todo maybe cache result to avoid multiple computations?
-    Position side1 = myCorners[1] - myCorners[0];
-    Position side2 = myCorners[2] - myCorners[0];
-    return side1.crossProduct(side2);
+    return myNormal;
 }
 
 
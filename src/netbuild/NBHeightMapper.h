@@ -105,6 +105,9 @@ public:
         /// @brief the corners of the triangle
         PositionVector myCorners;
 
+        /// @brief the (not normalized) normal vector of the triangle plane
+        Position myNormal;
+
     };
 
     typedef std::vector<const Triangle*> Triangles;
@@ -155,6 +158,14 @@ private:
     /// @brief adds one triangles worth of height data
     void addTriangle(PositionVector corners);
 
+    /** @brief returns the height of the given raster position
+     *
+     * The height is interpolated in the plane through the center of the pixel
+     *  and its nearest horizontal and vertical neighbors
+     * @return The height or a value below -1e5 if the position is not covered by the raster
+     */
+    double getRasterZ(const RasterData& raster, const Position& geo) const;
+
     /** @brief load height data from Arcgis-shape file and returns the number of parsed features
      * @return The number of parsed features
      * @throws ProcessError
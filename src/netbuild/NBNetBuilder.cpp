@@ -72,6 +72,18 @@ NBNetBuilder::applyOptions(OptionsCont& oc) {
     // apply options to traffic light logics control
     myTLLCont.applyOptions(oc);
     NBEdge::setDefaultConnectionLength(oc.getFloat("default.connection-length"));
+#ifdef HAVE_FOX
+    // create the threads for the parallel computation stages
+    const int numThreads = oc.getInt("threads");
+    if (numThreads > 1) {
+        while (myThreadPool.size() < numThreads) {
+            new MFXWorkerThread(myThreadPool);
+        }
+        myNodeCont.setThreadPool(&myThreadPool);
+        myEdgeCont.setThreadPool(&myThreadPool);
+        myPTLineCont.setThreadPool(&myThreadPool);
+    }
+#endif
 }
 
 
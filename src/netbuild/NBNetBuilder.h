@@ -253,6 +253,11 @@ protected:
     /// @brief flag to indicate that network has crossings
     bool myNetworkHaveCrossings;
 
+#ifdef HAVE_FOX
+    /// @brief the thread pool shared by the node and edge container
+    MFXWorkerThread::Pool myThreadPool;
+#endif
+
 private:
     /// @brief shift network so its lower left corner is at 0,0
     void moveToOrigin(GeoConvHelper& geoConvHelper, bool lefthand);
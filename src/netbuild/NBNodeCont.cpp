@@ -27,6 +27,7 @@
 
 #include <string>
 #include <map>
+#include <unordered_set>
 #include <algorithm>
 #include <cmath>
 #include <utils/options/OptionsCont.h>
@@ -539,7 +540,8 @@ NBNodeCont::avoidOverlap() {
 // ----------- (Helper) methods for joining nodes
 void
 NBNodeCont::generateNodeClusters(double maxDist, NodeClusters& into) const {
-    std::set<NBNode*> visited;
+    std::unordered_set<const NBNode*> visited;
+    visited.reserve(myNodes.size());
     for (const auto& i : myNodes) {
         if (visited.count(i.second) > 0) {
             continue;
@@ -551,10 +553,9 @@ NBNodeCont::generateNodeClusters(double maxDist, NodeClusters& into) const {
             NBNode* const n = toProc.back().first;
             const double dist = toProc.back().second;
             toProc.pop_back();
-            if (visited.count(n) > 0) {
+            if (!visited.insert(n).second) {
                 continue;
             }
-            visited.insert(n);
             bool pureRail = true;
             bool railAndPeds = true;
             for (NBEdge* e : n->getEdges()) {
@@ -581,19 +582,10 @@ NBNodeCont::generateNodeClusters(double maxDist, NodeClusters& into) const {
                               << " clusterNode=" << n->getID() << " edge=" << e->getID() << " length=" << length << " with cluster " << joinNamedToString(c, ' ') << "\n";
                 }
 #endif
-                if (railAndPeds && n->getType() != SumoXMLNodeType::RAIL_CROSSING) {
-                    bool railAndPeds2 = true;
-                    for (NBEdge* e2 : n->getEdges()) {
-                        if ((e2->getPermissions() & ~(SVC_RAIL_CLASSES | SVC_PEDESTRIAN)) != 0) {
-                            railAndPeds2 = false;
-                            break;
-                        }
-                    }
-                    if (railAndPeds2 && s->getType() != SumoXMLNodeType::RAIL_CROSSING) {
-                        // do not join rail/ped nodes unless at a rail crossing
-                        // (neither nodes nor the traffic lights)
-                        continue;
-                    }
+                if (railAndPeds && n->getType() != SumoXMLNodeType::RAIL_CROSSING && s->getType() != SumoXMLNodeType::RAIL_CROSSING) {
+                    // do not join rail/ped nodes unless at a rail crossing
+                    // (neither nodes nor the traffic lights)
+                    continue;
                 }
                 const bool bothCrossing = n->getType() == SumoXMLNodeType::RAIL_CROSSING && s->getType() == SumoXMLNodeType::RAIL_CROSSING;
                 const bool joinPedCrossings = bothCrossing && e->getPermissions() == SVC_PEDESTRIAN;
@@ -1659,16 +1651,16 @@ NBNodeCont::shortestEdge(const NodeSet& cluster, const NodeSet& startNodes, cons
 }
 
 void
-NBNodeCont::joinNodeClusters(NodeClusters clusters,
+NBNodeCont::joinNodeClusters(const NodeClusters& clusters,
                              NBDistrictCont& dc, NBEdgeCont& ec, NBTrafficLightLogicCont& tlc, bool resetConnections) {
-    for (NodeSet cluster : clusters) {
+    for (const NodeSet& cluster : clusters) {
         joinNodeCluster(cluster, dc, ec, tlc, nullptr, resetConnections);
     }
 }
 
 
 void
-NBNodeCont::joinNodeCluster(NodeSet cluster, NBDistrictCont& dc, NBEdgeCont& ec, NBTrafficLightLogicCont& tlc, NBNode* predefined, bool resetConnections) {
+NBNodeCont::joinNodeCluster(const NodeSet& cluster, NBDistrictCont& dc, NBEdgeCont& ec, NBTrafficLightLogicCont& tlc, NBNode* predefined, bool resetConnections) {
     const bool origNames = OptionsCont::getOptions().getBool("output.original-names");
     assert(cluster.size() > 1);
     std::string id = "cluster_";
@@ -1921,7 +1913,7 @@ NBNodeCont::registerJoinedCluster(const NodeSet& cluster) {
 
 
 void
-NBNodeCont::analyzeCluster(NodeSet cluster, std::string& id, Position& pos,
+NBNodeCont::analyzeCluster(const NodeSet& cluster, std::string& id, Position& pos,
                            bool& hasTLS, TrafficLightType& type, SumoXMLNodeType& nodeType) {
     id = createClusterId(cluster, id);
     bool ambiguousType = false;
@@ -2415,18 +2407,18 @@ NBNodeCont::setAsTLControlled(NBNode* node, NBTrafficLightLogicCont& tlc,
 // -----------
 void
 NBNodeCont::computeLanes2Lanes() {
-    for (NodeCont::iterator i = myNodes.begin(); i != myNodes.end(); i++) {
-        (*i).second->computeLanes2Lanes();
-    }
+    computeForAllNodes([](NBNode * node) {
+        node->computeLanes2Lanes();
+    });
 }
 
 
 // computes the "wheel" of incoming and outgoing edges for every node
 void
 NBNodeCont::computeLogics(const NBEdgeCont& ec) {
-    for (NodeCont::iterator i = myNodes.begin(); i != myNodes.end(); i++) {
-        (*i).second->computeLogic(ec);
-    }
+    computeForAllNodes([&ec](NBNode * node) {
+        node->computeLogic(ec);
+    });
 }
 
 
@@ -2479,10 +2471,72 @@ NBNodeCont::getFreeID() {
 
 void
 NBNodeCont::computeNodeShapes(double mismatchThreshold) {
+    computeForAllNodes([mismatchThreshold](NBNode * node) {
+        node->computeNodeShape(mismatchThreshold);
+    });
+}
+
+
+void
+NBNodeCont::computeForAllNodes(const std::function<void(NBNode*)>& func) {
+#ifdef HAVE_FOX
+    if (myThreadPool != nullptr && myThreadPool->size() > 0) {
+        // a node only modifies its own edges (and traffic lights), so it has to wait
+        // for all nodes with smaller id sharing one of them but not for the others
+        std::vector<std::vector<NBNode*> > levels;
+        std::map<const NBEdge*, int> edgeLevel;
+        std::map<const NBTrafficLightDefinition*, int> tlsLevel;
+        for (const auto& item : myNodes) {
+            NBNode* const node = item.second;
+            int level = 0;
+            for (const NBEdge* const e : node->getEdges()) {
+                auto it = edgeLevel.find(e);
+                if (it != edgeLevel.end()) {
+                    level = MAX2(level, it->second + 1);
+                }
+            }
+            for (const NBTrafficLightDefinition* const tl : node->getControllingTLS()) {
+                auto it = tlsLevel.find(tl);
+                if (it != tlsLevel.end()) {
+                    level = MAX2(level, it->second + 1);
+                }
+            }
+            for (const NBEdge* const e : node->getEdges()) {
+                edgeLevel[e] = level;
+            }
+            for (const NBTrafficLightDefinition* const tl : node->getControllingTLS()) {
+                tlsLevel[tl] = level;
+            }
+            if (level == (int)levels.size()) {
+                levels.push_back(std::vector<NBNode*>());
+            }
+            levels[level].push_back(node);
+        }
+        for (const std::vector<NBNode*>& nodes : levels) {
+            const int numTasks = MIN2((int)nodes.size(), 4 * myThreadPool->size());
+            const int chunkSize = ((int)nodes.size() + numTasks - 1) / numTasks;
+            for (int i = 0; i < (int)nodes.size(); i += chunkSize) {
+                myThreadPool->add(new NodeTask(nodes.begin() + i, nodes.begin() + MIN2(i + chunkSize, (int)nodes.size()), func));
+            }
+            myThreadPool->waitAll();
+        }
+        return;
+    }
+#endif
     for (NodeCont::iterator i = myNodes.begin(); i != myNodes.end(); i++) {
-        (*i).second->computeNodeShape(mismatchThreshold);
+        func((*i).second);
+    }
+}
+
+
+#ifdef HAVE_FOX
+void
+NBNodeCont::NodeTask::run(MFXWorkerThread* /* context */) {
+    for (std::vector<NBNode*>::const_iterator i = myFirst; i != myLast; ++i) {
+        myFunc(*i);
     }
 }
+#endif
 
 
 void
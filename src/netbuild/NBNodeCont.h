@@ -28,12 +28,16 @@
 #include <map>
 #include <vector>
 #include <set>
+#include <functional>
 #include <utils/common/NamedRTree.h>
 #include <utils/geom/Position.h>
 #include "NBCont.h"
 #include "NBEdgeCont.h"
 #include "NBNode.h"
 #include <utils/common/UtilExceptions.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#endif
 
 
 // ===========================================================================
@@ -314,6 +318,13 @@ public:
      */
     void computeNodeShapes(double mismatchThreshold = -1);
 
+#ifdef HAVE_FOX
+    /// @brief sets the thread pool for computing node shapes, connections and logics in parallel (nullptr for serial computation)
+    void setThreadPool(MFXWorkerThread::Pool* pool) {
+        myThreadPool = pool;
+    }
+#endif
+
     /** @brief Prints statistics about built nodes
      *
      * Goes through stored nodes, computes the numbers of unregulated, priority and right-before-left
@@ -331,7 +342,7 @@ public:
      * @param[out] hasTLS Whether the new node has a traffic light
      * @param[out] tlType The type of traffic light (if any)
      */
-    void analyzeCluster(NodeSet cluster, std::string& id, Position& pos,
+    void analyzeCluster(const NodeSet& cluster, std::string& id, Position& pos,
                         bool& hasTLS, TrafficLightType& type, SumoXMLNodeType& nodeType);
 
     /// @brief gets all joined clusters (see doc for myClusters2Join)
@@ -399,8 +410,8 @@ private:
                          double maxDist, std::string& reason) const;
 
     /// @brief joins the given node clusters
-    void joinNodeClusters(NodeClusters clusters, NBDistrictCont& dc, NBEdgeCont& ec, NBTrafficLightLogicCont& tlc, bool resetConnections = false);
-    void joinNodeCluster(NodeSet clusters, NBDistrictCont& dc, NBEdgeCont& ec, NBTrafficLightLogicCont& tlc,
+    void joinNodeClusters(const NodeClusters& clusters, NBDistrictCont& dc, NBEdgeCont& ec, NBTrafficLightLogicCont& tlc, bool resetConnections = false);
+    void joinNodeCluster(const NodeSet& clusters, NBDistrictCont& dc, NBEdgeCont& ec, NBTrafficLightLogicCont& tlc,
                          NBNode* predefined = nullptr, bool resetConnections = false);
 
     /// @}
@@ -424,6 +435,37 @@ private:
     /// @brief update pareto frontier with the given node
     void paretoCheck(NBNode* node, NodeSet& frontier, int xSign, int ySign);
 
+    /** @brief applies the function to all nodes
+     *
+     * Without a thread pool the nodes are processed in id order. Otherwise nodes
+     *  sharing an edge or a traffic light keep their relative (id) order while
+     *  all others are processed in parallel, so the result equals the serial one.
+     */
+    void computeForAllNodes(const std::function<void(NBNode*)>& func);
+
+#ifdef HAVE_FOX
+    /**
+     * @class NodeTask
+     * @brief applies a function to a range of independent nodes
+     */
+    class NodeTask : public MFXWorkerThread::Task {
+    public:
+        NodeTask(std::vector<NBNode*>::const_iterator first, std::vector<NBNode*>::const_iterator last, const std::function<void(NBNode*)>& func)
+            : myFirst(first), myLast(last), myFunc(func) {}
+        void run(MFXWorkerThread* context);
+    private:
+        const std::vector<NBNode*>::const_iterator myFirst;
+        const std::vector<NBNode*>::const_iterator myLast;
+        const std::function<void(NBNode*)>& myFunc;
+    private:
+        /// @brief Invalidated assignment operator.
+        NodeTask& operator=(const NodeTask&) = delete;
+    };
+
+    /// @brief the thread pool for the parallel computation stages
+    MFXWorkerThread::Pool* myThreadPool = nullptr;
+#endif
+
     /// @brief Definition of the map of names to nodes
     typedef std::map<std::string, NBNode*> NodeCont;
 
@@ -68,12 +68,22 @@ NBPTLineCont::insert(NBPTLine* ptLine) {
 
 void
 NBPTLineCont::process(NBEdgeCont& ec, NBPTStopCont& sc, bool routeOnly) {
+    std::vector<NBPTLine*> osmLines;
+    for (auto& item : myPTLines) {
+        if (item.second->getWays().size() > 0) {
+            osmLines.push_back(item.second);
+        }
+    }
+    // the routes do not depend on the stops, so they can be computed up front
+    std::vector<std::vector<NBEdge*> > routes;
+    constructRoutes(osmLines, ec, routes);
+    int osmIndex = 0;
     for (auto& item : myPTLines) {
         NBPTLine* line = item.second;
         if (item.second->getWays().size() > 0) {
             // loaded from OSM rather than ptline input. We can use extra
             // information to reconstruct route and stops
-            constructRoute(line, ec);
+            line->setEdges(routes[osmIndex++]);
             if (!routeOnly) {
                 // map stops to ways, using the constructed route for loose stops
                 reviseStops(line, ec, sc);
@@ -296,8 +306,7 @@ NBPTLineCont::findWay(NBPTLine* line, std::shared_ptr<NBPTStop> stop, const NBEd
 }
 
 
-void NBPTLineCont::constructRoute(NBPTLine* pTLine, const NBEdgeCont& cont) {
-    std::vector<NBEdge*> edges;
+void NBPTLineCont::constructRoute(const NBPTLine* pTLine, const NBEdgeCont& cont, std::vector<NBEdge*>& edges) {
 
     NBNode* first = nullptr;
     NBNode* last = nullptr;
@@ -435,10 +444,41 @@ void NBPTLineCont::constructRoute(NBPTLine* pTLine, const NBEdgeCont& cont) {
         currentWayEdges.clear();
         currentWayMinusEdges.clear();
     }
-    pTLine->setEdges(edges);
 }
 
 
+void
+NBPTLineCont::constructRoutes(const std::vector<NBPTLine*>& lines, const NBEdgeCont& cont, std::vector<std::vector<NBEdge*> >& routes) {
+    routes.assign(lines.size(), std::vector<NBEdge*>());
+#ifdef HAVE_FOX
+    if (myThreadPool != nullptr && myThreadPool->size() > 0 && lines.size() > 1) {
+        const int numTasks = MIN2((int)lines.size(), 4 * myThreadPool->size());
+        const int chunkSize = ((int)lines.size() + numTasks - 1) / numTasks;
+        for (int i = 0; i < (int)lines.size(); i += chunkSize) {
+            myThreadPool->add(new RouteTask(lines, i, MIN2(i + chunkSize, (int)lines.size()), cont, routes));
+        }
+        myThreadPool->waitAll();
+    } else {
+#endif
+        for (int i = 0; i < (int)lines.size(); i++) {
+            constructRoute(lines[i], cont, routes[i]);
+        }
+#ifdef HAVE_FOX
+    }
+#endif
+}
+
+
+#ifdef HAVE_FOX
+void
+NBPTLineCont::RouteTask::run(MFXWorkerThread* /* context */) {
+    for (int i = myFirst; i < myLast; i++) {
+        constructRoute(myLines[i], myCont, myRoutes[i]);
+    }
+}
+#endif
+
+
 void
 NBPTLineCont::replaceEdge(const std::string& edgeID, const EdgeVector& replacement) {
     //std::cout << " replaceEdge " << edgeID << " replacement=" << toString(replacement) << "\n";
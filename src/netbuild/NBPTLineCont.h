@@ -57,6 +57,14 @@ public:
     void fixPermissions();
 
     std::set<std::string>& getServedPTStops();
+
+#ifdef HAVE_FOX
+    /// @brief sets the thread pool for constructing the routes of the lines in parallel (nullptr for serial computation)
+    void setThreadPool(MFXWorkerThread::Pool* pool) {
+        myThreadPool = pool;
+    }
+#endif
+
 private:
 
     static const int FWD;
@@ -74,7 +82,16 @@ private:
      * @note: if the edge id is updated, the stop extent is recomputed */
     std::shared_ptr<NBPTStop> findWay(NBPTLine* line, std::shared_ptr<NBPTStop> stop, const NBEdgeCont& ec, NBPTStopCont& sc) const;
 
-    void constructRoute(NBPTLine* myPTLine, const NBEdgeCont& cont);
+    /// @brief computes the route edges of the line from its ways
+    static void constructRoute(const NBPTLine* pTLine, const NBEdgeCont& cont, std::vector<NBEdge*>& edges);
+
+    /** @brief computes the route edges of all given lines
+     *
+     * The route of a line only depends on its ways and the edges, so the
+     *  routes are computed in parallel chunks if a thread pool is set. They
+     *  are not assigned here since NBPTLine::setEdges may modify the edges.
+     */
+    void constructRoutes(const std::vector<NBPTLine*>& lines, const NBEdgeCont& cont, std::vector<std::vector<NBEdge*> >& routes);
 
     std::set<std::string> myServedPTStops;
 
@@ -85,4 +102,29 @@ private:
 
     /// @brief The map of edge ids to lines that use this edge in their route
     std::map<std::string, std::set<NBPTLine*> > myPTLineLookup;
+
+#ifdef HAVE_FOX
+    /**
+     * @class RouteTask
+     * @brief constructs the routes of a range of lines
+     */
+    class RouteTask : public MFXWorkerThread::Task {
+    public:
+        RouteTask(const std::vector<NBPTLine*>& lines, int first, int last, const NBEdgeCont& cont, std::vector<std::vector<NBEdge*> >& routes)
+            : myLines(lines), myFirst(first), myLast(last), myCont(cont), myRoutes(routes) {}
+        void run(MFXWorkerThread* context);
+    private:
+        const std::vector<NBPTLine*>& myLines;
+        const int myFirst;
+        const int myLast;
+        const NBEdgeCont& myCont;
+        std::vector<std::vector<NBEdge*> >& myRoutes;
+    private:
+        /// @brief Invalidated assignment operator.
+        RouteTask& operator=(const RouteTask&) = delete;
+    };
+
+    /// @brief the thread pool for the route construction
+    MFXWorkerThread::Pool* myThreadPool = nullptr;
+#endif
 };
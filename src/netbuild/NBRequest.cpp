@@ -46,8 +46,8 @@
 // ===========================================================================
 // static member variables
 // ===========================================================================
-int NBRequest::myGoodBuilds = 0;
-int NBRequest::myNotBuild = 0;
+std::atomic<int> NBRequest::myGoodBuilds(0);
+std::atomic<int> NBRequest::myNotBuild(0);
 
 
 // ===========================================================================
@@ -422,6 +422,18 @@ NBRequest::computeLogic(const bool checkLaneFoes) {
     myResponse.clear();
     myFoes.clear();
     myHaveVia.clear();
+    // collect all connections once in the order of the response and foe strings
+    myLinks.clear();
+    for (EdgeVector::const_reverse_iterator i = myIncoming.rbegin(); i != myIncoming.rend(); i++) {
+        const std::vector<NBEdge::Connection>& cons = (*i)->getConnections();
+        for (int j = (*i)->getNumLanes(); j-- > 0;) {
+            for (auto k = cons.rbegin(); k != cons.rend(); ++k) {
+                if (k->fromLane == j) {
+                    myLinks.push_back(LinkConnection(*i, &*k, k->toEdge == nullptr ? -1 : getIndex(*i, k->toEdge)));
+                }
+            }
+        }
+    }
     int pos = 0;
     EdgeVector::const_iterator i;
     // normal connections
@@ -436,6 +448,7 @@ NBRequest::computeLogic(const bool checkLaneFoes) {
     for (auto c : crossings) {
         pos = computeCrossingResponse(*c, pos);
     }
+    myLinks.clear();
 }
 
 void
@@ -630,80 +643,74 @@ NBRequest::getResponseString(const NBEdge* const from, const NBEdge::Connection&
         result += mustBrakeForCrossing(myJunction, from, to, **i) ? '1' : '0';
     }
     const NBEdge::Connection& queryCon = from->getConnection(fromLane, to, toLane);
+    const bool ignoreInternalJam = OptionsCont::getOptions().getBool("tls.ignore-internal-junction-jam");
     // normal connections
-    for (EdgeVector::const_reverse_iterator i = myIncoming.rbegin(); i != myIncoming.rend(); i++) {
-        //const std::vector<NBEdge::Connection> &allConnections = (*i)->getConnections();
-        int noLanes = (*i)->getNumLanes();
-        for (int j = noLanes; j-- > 0;) {
-            std::vector<NBEdge::Connection> connected = (*i)->getConnectionsFromLane(j);
-            int size = (int) connected.size();
-            for (int k = size; k-- > 0;) {
-                if (c.mayDefinitelyPass) {
-                    result += '0';
+    for (const LinkConnection& link : myLinks) {
+        const NBEdge* const foeFrom = link.from;
+        const NBEdge::Connection& foe = *link.con;
+        if (c.mayDefinitelyPass) {
+            result += '0';
 #ifdef DEBUG_RESPONSE
-                    if (DEBUGCOND) {
-                        std::cout << " c=" << queryCon.getDescription(from) << " pass\n";
-                    }
+            if (DEBUGCOND) {
+                std::cout << " c=" << queryCon.getDescription(from) << " pass\n";
+            }
 #endif
-                } else if ((*i) == from && fromLane == j) {
-                    // do not prohibit a connection by others from same lane
-                    // except for indirect turns
+        } else if (foeFrom == from && fromLane == foe.fromLane) {
+            // do not prohibit a connection by others from same lane
+            // except for indirect turns
 #ifdef DEBUG_RESPONSE
-                    if (DEBUGCOND) {
-                        std::cout << " c=" << queryCon.getDescription(from) << " prohibitC=" << connected[k].getDescription(*i)
-                                  << " itc=" <<  indirectLeftTurnConflict(from, queryCon, *i, connected[k], false)
-                                  << "\n";
-                    }
+            if (DEBUGCOND) {
+                std::cout << " c=" << queryCon.getDescription(from) << " prohibitC=" << foe.getDescription(foeFrom)
+                          << " itc=" <<  indirectLeftTurnConflict(from, queryCon, foeFrom, foe, false)
+                          << "\n";
+            }
 #endif
-                    if (indirectLeftTurnConflict(from, queryCon, *i, connected[k], false)) {
-                        result += '1';
-                    } else {
-                        result += '0';
-                    }
-                } else {
-                    assert(connected[k].toEdge != 0);
-                    const int idx2 = getIndex(*i, connected[k].toEdge);
-                    assert(k < (int) connected.size());
-                    assert(idx < (int)(myIncoming.size() * myOutgoing.size()));
-                    assert(idx2 < (int)(myIncoming.size() * myOutgoing.size()));
-                    // check whether the connection is prohibited by another one
+            if (indirectLeftTurnConflict(from, queryCon, foeFrom, foe, false)) {
+                result += '1';
+            } else {
+                result += '0';
+            }
+        } else {
+            assert(foe.toEdge != 0);
+            const int idx2 = link.index;
+            assert(idx < (int)(myIncoming.size() * myOutgoing.size()));
+            assert(idx2 < (int)(myIncoming.size() * myOutgoing.size()));
+            // check whether the connection is prohibited by another one
 #ifdef DEBUG_RESPONSE
-                    if (DEBUGCOND) {
-                        std::cout << " c=" << queryCon.getDescription(from) << " prohibitC=" << connected[k].getDescription(*i)
-                                  << " f=" << myForbids[idx2][idx]
-                                  << " clf=" << checkLaneFoes
-                                  << " clfbc=" << checkLaneFoesByClass(queryCon, *i, connected[k])
-                                  << " clfbcoop=" << checkLaneFoesByCooperation(from, queryCon, *i, connected[k])
-                                  << " lc=" << laneConflict(from, to, toLane, *i, connected[k].toEdge, connected[k].toLane)
-                                  << " rtc=" << NBNode::rightTurnConflict(from, to, fromLane, *i, connected[k].toEdge, connected[k].fromLane)
-                                  << " rtc2=" << rightTurnConflict(from, queryCon, *i, connected[k])
-                                  << " mc=" << mergeConflict(from, queryCon, *i, connected[k], false)
-                                  << " oltc=" << oppositeLeftTurnConflict(from, queryCon, *i, connected[k], false)
-                                  << " itc=" <<  indirectLeftTurnConflict(from, queryCon, *i, connected[k], zipper)
-                                  << " bc=" <<  bidiConflict(from, queryCon, *i, connected[k], false)
-                                  << " rorc=" << myJunction->rightOnRedConflict(c.tlLinkIndex, connected[k].tlLinkIndex)
-                                  << " tlscc=" << myJunction->tlsContConflict(from, c, *i, connected[k])
-                                  << "\n";
-                    }
+            if (DEBUGCOND) {
+                std::cout << " c=" << queryCon.getDescription(from) << " prohibitC=" << foe.getDescription(foeFrom)
+                          << " f=" << myForbids[idx2][idx]
+                          << " clf=" << checkLaneFoes
+                          << " clfbc=" << checkLaneFoesByClass(queryCon, foeFrom, foe)
+                          << " clfbcoop=" << checkLaneFoesByCooperation(from, queryCon, foeFrom, foe)
+                          << " lc=" << laneConflict(from, to, toLane, foeFrom, foe.toEdge, foe.toLane)
+                          << " rtc=" << NBNode::rightTurnConflict(from, to, fromLane, foeFrom, foe.toEdge, foe.fromLane)
+                          << " rtc2=" << rightTurnConflict(from, queryCon, foeFrom, foe)
+                          << " mc=" << mergeConflict(from, queryCon, foeFrom, foe, false)
+                          << " oltc=" << oppositeLeftTurnConflict(from, queryCon, foeFrom, foe, false)
+                          << " itc=" <<  indirectLeftTurnConflict(from, queryCon, foeFrom, foe, zipper)
+                          << " bc=" <<  bidiConflict(from, queryCon, foeFrom, foe, false)
+                          << " rorc=" << myJunction->rightOnRedConflict(c.tlLinkIndex, foe.tlLinkIndex)
+                          << " tlscc=" << myJunction->tlsContConflict(from, c, foeFrom, foe)
+                          << "\n";
+            }
 #endif
-                    const bool hasLaneConflict = (!(checkLaneFoes || checkLaneFoesByClass(queryCon, *i, connected[k])
-                                                    || checkLaneFoesByCooperation(from, queryCon, *i, connected[k]))
-                                                  || laneConflict(from, to, toLane, *i, connected[k].toEdge, connected[k].toLane));
-                    if (((myForbids[idx2][idx] || (zipper && myForbids[idx][idx2])) && hasLaneConflict && !bidiConflict(*i, connected[k], from, queryCon, false))
-                            || rightTurnConflict(from, queryCon, *i, connected[k])
-                            || mergeConflict(from, queryCon, *i, connected[k], zipper)
-                            || oppositeLeftTurnConflict(from, queryCon, *i, connected[k], zipper)
-                            || indirectLeftTurnConflict(from, queryCon, *i, connected[k], zipper)
-                            || bidiConflict(from, queryCon, *i, connected[k], false)
-                            || myJunction->rightOnRedConflict(c.tlLinkIndex, connected[k].tlLinkIndex)
-                            || (myJunction->tlsContConflict(from, c, *i, connected[k]) && hasLaneConflict
-                                && !OptionsCont::getOptions().getBool("tls.ignore-internal-junction-jam"))
-                       ) {
-                        result += '1';
-                    } else {
-                        result += '0';
-                    }
-                }
+            const bool hasLaneConflict = (!(checkLaneFoes || checkLaneFoesByClass(queryCon, foeFrom, foe)
+                                            || checkLaneFoesByCooperation(from, queryCon, foeFrom, foe))
+                                          || laneConflict(from, to, toLane, foeFrom, foe.toEdge, foe.toLane));
+            if (((myForbids[idx2][idx] || (zipper && myForbids[idx][idx2])) && hasLaneConflict && !bidiConflict(foeFrom, foe, from, queryCon, false))
+                    || rightTurnConflict(from, queryCon, foeFrom, foe)
+                    || mergeConflict(from, queryCon, foeFrom, foe, zipper)
+                    || oppositeLeftTurnConflict(from, queryCon, foeFrom, foe, zipper)
+                    || indirectLeftTurnConflict(from, queryCon, foeFrom, foe, zipper)
+                    || bidiConflict(from, queryCon, foeFrom, foe, false)
+                    || myJunction->rightOnRedConflict(c.tlLinkIndex, foe.tlLinkIndex)
+                    || (myJunction->tlsContConflict(from, c, foeFrom, foe) && hasLaneConflict
+                        && !ignoreInternalJam)
+               ) {
+                result += '1';
+            } else {
+                result += '0';
             }
         }
     }
@@ -732,28 +739,27 @@ NBRequest::getFoesString(NBEdge* from, NBEdge* to, int fromLane, int toLane, con
         result += foes ? '1' : '0';
     }
     const NBEdge::Connection& queryCon = from->getConnection(fromLane, to, toLane);
+    const int idx = to == nullptr ? -1 : getIndex(from, to);
     // normal connections
-    for (EdgeVector::const_reverse_iterator i = myIncoming.rbegin(); i != myIncoming.rend(); i++) {
-        for (int j = (*i)->getNumLanes() - 1; j >= 0; --j) {
-            const std::vector<NBEdge::Connection>& connected = (*i)->getConnectionsFromLane(j);
-            int size = (int) connected.size();
-            for (int k = size; k-- > 0;) {
-                const bool hasLaneConflict = (!(checkLaneFoes || checkLaneFoesByClass(queryCon, *i, connected[k])
-                                                || checkLaneFoesByCooperation(from, queryCon, *i, connected[k]))
-                                              || laneConflict(from, to, toLane, *i, connected[k].toEdge, connected[k].toLane));
-                if ((foes(from, to, (*i), connected[k].toEdge) && hasLaneConflict)
-                        || rightTurnConflict(from, queryCon, *i, connected[k])
-                        || myJunction->turnFoes(from, to, fromLane, *i, connected[k].toEdge, connected[k].fromLane, lefthand)
-                        || mergeConflict(from, queryCon, *i, connected[k], true)
-                        || oppositeLeftTurnConflict(from, queryCon, *i, connected[k], true)
-                        || indirectLeftTurnConflict(from, queryCon, *i, connected[k], true)
-                        || bidiConflict(from, queryCon, *i, connected[k], true)
-                   ) {
-                    result += '1';
-                } else {
-                    result += '0';
-                }
-            }
+    for (const LinkConnection& link : myLinks) {
+        const NBEdge* const foeFrom = link.from;
+        const NBEdge::Connection& foe = *link.con;
+        // equivalent to foes(from, to, foeFrom, foe.toEdge)
+        const bool edgeFoes = idx >= 0 && link.index >= 0 && (myForbids[idx][link.index] || myForbids[link.index][idx]);
+        const bool hasLaneConflict = (!(checkLaneFoes || checkLaneFoesByClass(queryCon, foeFrom, foe)
+                                        || checkLaneFoesByCooperation(from, queryCon, foeFrom, foe))
+                                      || laneConflict(from, to, toLane, foeFrom, foe.toEdge, foe.toLane));
+        if ((edgeFoes && hasLaneConflict)
+                || rightTurnConflict(from, queryCon, foeFrom, foe)
+                || myJunction->turnFoes(from, to, fromLane, foeFrom, foe.toEdge, foe.fromLane, lefthand)
+                || mergeConflict(from, queryCon, foeFrom, foe, true)
+                || oppositeLeftTurnConflict(from, queryCon, foeFrom, foe, true)
+                || indirectLeftTurnConflict(from, queryCon, foeFrom, foe, true)
+                || bidiConflict(from, queryCon, foeFrom, foe, true)
+           ) {
+            result += '1';
+        } else {
+            result += '0';
         }
     }
     return result;
@@ -1105,7 +1111,7 @@ void
 NBRequest::reportWarnings() {
     // check if any errors occurred on build the link prohibitions
     if (myNotBuild != 0) {
-        WRITE_WARNING(toString(myNotBuild) + " of " + toString(myNotBuild + myGoodBuilds) + " prohibitions were not build.");
+        WRITE_WARNING(toString(myNotBuild.load()) + " of " + toString(myNotBuild + myGoodBuilds) + " prohibitions were not build.");
     }
 }
 
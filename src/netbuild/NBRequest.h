@@ -27,6 +27,7 @@
 #include <vector>
 #include <map>
 #include <bitset>
+#include <atomic>
 #include "NBConnectionDefs.h"
 #include "NBContHelper.h"
 #include <utils/common/UtilExceptions.h>
@@ -277,13 +278,26 @@ private:
     /// @brief the link X link is done-checks
     CombinationsCont  myDone;
 
+    /// @brief a lane-to-lane link with its index in the combination containers
+    struct LinkConnection {
+        LinkConnection(const NBEdge* _from, const NBEdge::Connection* _con, int _index) :
+            from(_from), con(_con), index(_index) {}
+        const NBEdge* from;
+        const NBEdge::Connection* con;
+        int index;
+    };
+
+    /// @brief all lane-to-lane links in the order of the foe and response strings (valid during computeLogic)
+    std::vector<LinkConnection> myLinks;
+
     /// @brief precomputed right-of-way matrices for each lane-to-lane link
     std::vector<std::string> myFoes;
     std::vector<std::string> myResponse;
     std::vector<bool> myHaveVia;
 
 private:
-    static int myGoodBuilds, myNotBuild;
+    /// @brief statistics about the prohibitions (atomic since logics may be computed in parallel)
+    static std::atomic<int> myGoodBuilds, myNotBuild;
 
     /// @brief Invalidated assignment operator
     NBRequest& operator=(const NBRequest& s) = delete;
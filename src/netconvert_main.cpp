@@ -42,6 +42,9 @@
 #include <utils/xml/XMLSubSys.h>
 #include <utils/iodevices/OutputDevice.h>
 #include <utils/geom/GeoConvHelper.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MsgHandlerSynchronized.h>
+#endif
 
 
 // ===========================================================================
@@ -114,6 +117,12 @@ main(int argc, char** argv) {
         if (oc.isDefault("aggregate-warnings")) {
             oc.setDefault("aggregate-warnings", "5");
         }
+#ifdef HAVE_FOX
+        if (oc.getInt("threads") > 1) {
+            // make the output aware of threading
+            MsgHandler::setFactory(&MsgHandlerSynchronized::create);
+        }
+#endif
         MsgHandler::initOutputOptions();
         if (!checkOptions()) {
             throw ProcessError();
@@ -2733,7 +2733,7 @@ GNENet::initJunctionsAndEdges() {
     if (myAttributeCarriers->getEdges().size() == 0) {
         myGrid.add(Boundary(0, 0, 100, 100));
     }
-    // recalculate all lane2lane connections
+    // compute lane geometries and lane2lane connections (skipped when constructing the loaded edges)
     for (const auto& edge : myAttributeCarriers->getEdges()) {
         for (const auto& lane : edge.second->getLanes()) {
             lane->updateGeometry();
@@ -2766,6 +2766,17 @@ GNENet::computeAndUpdate(OptionsCont& neteditOptions, bool volatileOptions) {
             liveExplicitTurnarounds.insert(explicitTurnarounds);
         }
     }
+    // remember the geometry of all elements so that only the changed ones (and their neighbours) need to be rebuilt
+    std::map<const GNEJunction*, ElementGeometry> junctionGeometries;
+    std::map<const GNEEdge*, ElementGeometry> edgeGeometries;
+    if (!volatileOptions) {
+        for (const auto& junction : myAttributeCarriers->getJunctions()) {
+            junctionGeometries[junction.second] = getJunctionGeometry(junction.second);
+        }
+        for (const auto& edge : myAttributeCarriers->getEdges()) {
+            edgeGeometries[edge.second] = getEdgeGeometry(edge.second);
+        }
+    }
     // removes all junctions of grid
     WRITE_GLDEBUG("Removing junctions during recomputing");
     for (const auto& it : myAttributeCarriers->getJunctions()) {
@@ -2782,11 +2793,33 @@ GNENet::computeAndUpdate(OptionsCont& neteditOptions, bool volatileOptions) {
     if (neteditOptions.getBool("numerical-ids") || neteditOptions.isSet("reserved-ids")) {
         myAttributeCarriers->remapJunctionAndEdgeIds();
     }
+    // collect the changed elements, a changed junction invalidates all its edges and vice versa
+    std::set<GNEJunction*> changedJunctions;
+    std::set<GNEEdge*> changedEdges;
+    for (const auto& junction : myAttributeCarriers->getJunctions()) {
+        const auto it = junctionGeometries.find(junction.second);
+        if (volatileOptions || !junction.second->isLogicValid() || it == junctionGeometries.end() || it->second != getJunctionGeometry(junction.second)) {
+            changedJunctions.insert(junction.second);
+            changedEdges.insert(junction.second->getGNEIncomingEdges().begin(), junction.second->getGNEIncomingEdges().end());
+            changedEdges.insert(junction.second->getGNEOutgoingEdges().begin(), junction.second->getGNEOutgoingEdges().end());
+        }
+    }
+    for (const auto& edge : myAttributeCarriers->getEdges()) {
+        const auto it = edgeGeometries.find(edge.second);
+        if (it == edgeGeometries.end() || it->second != getEdgeGeometry(edge.second)) {
+            changedEdges.insert(edge.second);
+            changedJunctions.insert(edge.second->getFromJunction());
+            changedJunctions.insert(edge.second->getToJunction());
+        }
+    }
+    if (!volatileOptions) {
+        WRITE_DEBUG("Recomputing changed " + toString(changedJunctions.size()) + " junctions and " + toString(changedEdges.size()) + " edges");
+    }
     // update rtree if necessary
     if (!neteditOptions.getBool("offset.disable-normalization")) {
-        for (const auto& edge : myAttributeCarriers->getEdges()) {
+        for (GNEEdge* const edge : changedEdges) {
             // refresh edge geometry
-            edge.second->updateGeometry();
+            edge->updateGeometry();
         }
     }
     // Clear current inspected ACs in inspectorFrame if a previous net was loaded
@@ -2839,22 +2872,22 @@ GNENet::computeAndUpdate(OptionsCont& neteditOptions, bool volatileOptions) {
             myGrid.addAdditionalGLObject(edge.second);
         }
         // remake connections
-        for (const auto& connection : myAttributeCarriers->getEdges()) {
-            connection.second->remakeGNEConnections(true);
+        for (GNEEdge* const edge : changedEdges) {
+            edge->remakeGNEConnections(true);
         }
-        // iterate over junctions of net
-        for (const auto& junction : myAttributeCarriers->getJunctions()) {
+        // iterate over changed junctions of net
+        for (GNEJunction* const junction : changedJunctions) {
             // undolist may not yet exist but is also not needed when just marking junctions as valid
-            junction.second->setLogicValid(true, nullptr);
+            junction->setLogicValid(true, nullptr);
             // updated geometry
-            junction.second->updateGeometryAfterNetbuild();
+            junction->updateGeometryAfterNetbuild();
             // rebuild walking areas
-            junction.second->rebuildGNEWalkingAreas();
+            junction->rebuildGNEWalkingAreas();
         }
-        // iterate over all edges of net
-        for (const auto& edge : myAttributeCarriers->getEdges()) {
+        // iterate over changed edges of net
+        for (GNEEdge* const edge : changedEdges) {
             // update geometry
-            edge.second->updateGeometry();
+            edge->updateGeometry();
         }
     }
     // net recomputed, then return false;
@@ -2862,6 +2895,41 @@ GNENet::computeAndUpdate(OptionsCont& neteditOptions, bool volatileOptions) {
 }
 
 
+GNENet::ElementGeometry
+GNENet::getJunctionGeometry(const GNEJunction* junction) {
+    const NBNode* const node = junction->getNBNode();
+    ElementGeometry result;
+    result.first.push_back(PositionVector(node->getPosition(), node->getPosition()));
+    result.first.push_back(node->getShape());
+    for (const NBNode::Crossing* const crossing : node->getCrossings()) {
+        result.first.push_back(crossing->shape);
+        result.second.push_back(crossing->id);
+    }
+    for (const NBNode::WalkingArea& walkingArea : node->getWalkingAreas()) {
+        result.first.push_back(walkingArea.shape);
+        result.second.push_back(walkingArea.id);
+    }
+    return result;
+}
+
+
+GNENet::ElementGeometry
+GNENet::getEdgeGeometry(const GNEEdge* edge) {
+    const NBEdge* const nbe = edge->getNBEdge();
+    ElementGeometry result;
+    result.first.push_back(nbe->getGeometry());
+    for (int i = 0; i < nbe->getNumLanes(); i++) {
+        result.first.push_back(nbe->getLaneShape(i));
+    }
+    for (const NBEdge::Connection& con : nbe->getConnections()) {
+        result.first.push_back(con.shape);
+        result.first.push_back(con.viaShape);
+        result.second.push_back(toString(con.fromLane) + "_" + con.toEdge->getID() + "_" + toString(con.toLane) + "_" + con.tlID + "_" + toString(con.tlLinkIndex));
+    }
+    return result;
+}
+
+
 void
 GNENet::replaceInListAttribute(GNEAttributeCarrier* ac, SumoXMLAttr key, const std::string& which, const std::string& by, GNEUndoList* undoList) {
     assert(ac->getTagProperty().getAttributeProperties(key).isList());
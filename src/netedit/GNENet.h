@@ -329,6 +329,15 @@ public:
     /// @brief recompute the network and update lane geometries
     void computeAndUpdate(OptionsCont& neteditOptions, bool volatileOptions);
 
+    /// @brief the shapes and connection ids of a network element (to detect which elements were changed by recomputing)
+    typedef std::pair<std::vector<PositionVector>, std::vector<std::string> > ElementGeometry;
+
+    /// @brief the geometry of the junction including crossings and walking areas
+    static ElementGeometry getJunctionGeometry(const GNEJunction* junction);
+
+    /// @brief the geometry of the edge including its lanes and connections
+    static ElementGeometry getEdgeGeometry(const GNEEdge* edge);
+
     /**@brief trigger full netbuild computation
      * param[in] window The window to inform about delay
      * param[in] force Whether to force recomputation even if not needed
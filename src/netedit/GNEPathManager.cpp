@@ -18,6 +18,7 @@
 // Manager for paths in netedit (routes, trips, flows...)
 /****************************************************************************/
 
+#include <algorithm>
 #include <netbuild/NBNetBuilder.h>
 #include <netedit/GNENet.h>
 #include <netedit/GNEViewNet.h>
@@ -78,8 +79,10 @@ GNEPathManager::Segment::Segment(GNEPathManager* pathManager, PathElement* eleme
 
 
 GNEPathManager::Segment::~Segment() {
-    // clear segment from LaneSegments
-    myPathManager->clearSegmentFromJunctionAndLaneSegments(this);
+    // clear segment from LaneSegments (unless all segments of the path elements are cleared at once)
+    if (!myPathManager->myClearingSegments) {
+        myPathManager->clearSegmentFromJunctionAndLaneSegments(this);
+    }
     // remove references in previous and next segment
     if (myPreviousSegment) {
         myPreviousSegment->myNextSegment = nullptr;
@@ -245,6 +248,8 @@ GNEPathManager::PathCalculator::updatePathCalculator() {
     myDijkstraRouter = new DijkstraRouter<NBRouterEdge, NBVehicle>(
         myNet->getNetBuilder()->getEdgeCont().getAllRouterEdges(),
         true, &NBRouterEdge::getTravelTimeStatic, nullptr, true);
+    // paths calculated with the previous router may be outdated
+    myPathCache.clear();
     // update flag
     myPathCalculatorUpdated = true;
 }
@@ -270,19 +275,11 @@ GNEPathManager::PathCalculator::calculateDijkstraPath(const SUMOVehicleClass vCl
         solution.push_back(edges.front());
         return solution;
     } else {
-        // declare temporal vehicle
-        NBVehicle tmpVehicle("temporalNBVehicle", vClass);
-        // obtain pointer to GNENet
-        GNENet* net = edges.front()->getNet();
         // iterate over every selected myEdges
         for (int i = 1; i < (int)edges.size(); i++) {
-            // declare a temporal route in which save route between two last myEdges
-            std::vector<const NBRouterEdge*> partialRoute;
-            myDijkstraRouter->compute(edges.at(i - 1)->getNBEdge(), edges.at(i)->getNBEdge(), &tmpVehicle, 10, partialRoute);
-            // save partial route in solution
-            for (const auto& edgeID : partialRoute) {
-                solution.push_back(net->getAttributeCarriers()->retrieveEdge(edgeID->getID()));
-            }
+            // save partial route between two last myEdges in solution
+            const std::vector<GNEEdge*>& partialRoute = calculatePartialPath(vClass, edges.at(i - 1), edges.at(i));
+            solution.insert(solution.end(), partialRoute.begin(), partialRoute.end());
         }
     }
     // filter solution
@@ -494,6 +491,32 @@ GNEPathManager::PathCalculator::isPathCalculatorUpdated() const {
 void
 GNEPathManager::PathCalculator::invalidatePathCalculator() {
     myPathCalculatorUpdated = false;
+    myPathCache.clear();
+}
+
+
+const std::vector<GNEEdge*>&
+GNEPathManager::PathCalculator::calculatePartialPath(const SUMOVehicleClass vClass, GNEEdge* fromEdge, GNEEdge* toEdge) const {
+    // many demand elements share the same from-to edges, so check first if the path was already calculated
+    const std::tuple<SUMOVehicleClass, const GNEEdge*, const GNEEdge*> key(vClass, fromEdge, toEdge);
+    auto it = myPathCache.find(key);
+    if (it == myPathCache.end()) {
+        // declare temporal vehicle
+        NBVehicle tmpVehicle("temporalNBVehicle", vClass);
+        // declare a temporal route in which save route between both edges
+        std::vector<const NBRouterEdge*> partialRoute;
+        myDijkstraRouter->compute(fromEdge->getNBEdge(), toEdge->getNBEdge(), &tmpVehicle, 10, partialRoute);
+        // obtain pointer to GNENet
+        GNENet* net = fromEdge->getNet();
+        // save partial route in cache
+        std::vector<GNEEdge*>& path = myPathCache[key];
+        path.reserve(partialRoute.size());
+        for (const auto& edgeID : partialRoute) {
+            path.push_back(net->getAttributeCarriers()->retrieveEdge(edgeID->getID()));
+        }
+        return path;
+    }
+    return it->second;
 }
 
 
@@ -919,9 +942,30 @@ GNEPathManager::invalidateJunctionPath(const GNEJunction* junction) {
 
 void
 GNEPathManager::clearDemandPaths() {
+    // remove all demand segments from lane and junction segments at once (removing them one by one is quadratic in the number of demand elements)
+    const auto isDemandSegment = [](const Segment * segment) {
+        return segment->getPathElement()->isDemandElement();
+    };
+    for (auto itLane = myLaneSegments.begin(); itLane != myLaneSegments.end();) {
+        itLane->second.erase(std::remove_if(itLane->second.begin(), itLane->second.end(), isDemandSegment), itLane->second.end());
+        if (itLane->second.empty()) {
+            itLane = myLaneSegments.erase(itLane);
+        } else {
+            itLane++;
+        }
+    }
+    for (auto itJunction = myJunctionSegments.begin(); itJunction != myJunctionSegments.end();) {
+        itJunction->second.erase(std::remove_if(itJunction->second.begin(), itJunction->second.end(), isDemandSegment), itJunction->second.end());
+        if (itJunction->second.empty()) {
+            itJunction = myJunctionSegments.erase(itJunction);
+        } else {
+            itJunction++;
+        }
+    }
     // declare iterator
     auto it = myPaths.begin();
-    // iterate over paths
+    // iterate over paths (segments were already removed from lane and junction segments)
+    myClearingSegments = true;
     while (it != myPaths.end()) {
         if (it->first->isDemandElement()) {
             // delete all segments
@@ -934,6 +978,7 @@ GNEPathManager::clearDemandPaths() {
             it++;
         }
     }
+    myClearingSegments = false;
 }
 
 
@@ -20,6 +20,7 @@
 #pragma once
 #include <config.h>
 
+#include <tuple>
 #include <netbuild/NBEdge.h>
 #include <netbuild/NBVehicle.h>
 #include <utils/common/SUMOVehicleClass.h>
@@ -250,6 +251,12 @@ public:
         /// @brief SUMO Abstract myDijkstraRouter
         SUMOAbstractRouter<NBRouterEdge, NBVehicle>* myDijkstraRouter;
 
+        /// @brief cache with the paths between two consecutive edges (cleared if the network changes)
+        mutable std::map<std::tuple<SUMOVehicleClass, const GNEEdge*, const GNEEdge*>, std::vector<GNEEdge*> > myPathCache;
+
+        /// @brief calculate (or get from cache) the Dijkstra path between two edges
+        const std::vector<GNEEdge*>& calculatePartialPath(const SUMOVehicleClass vClass, GNEEdge* fromEdge, GNEEdge* toEdge) const;
+
         /// @brief optimize junction path
         std::vector<GNEEdge*> optimizeJunctionPath(const std::vector<GNEEdge*>& edges) const;
     };
@@ -385,6 +392,9 @@ protected:
     /// @brief map with junction segments
     std::map<const GNEJunction*, std::vector<Segment*> > myJunctionSegments;
 
+    /// @brief flag for skipping the removal of single segments from lane and junction segments (during clearDemandPaths)
+    bool myClearingSegments = false;
+
 private:
     /// @brief mark label segment
     void markLabelSegment(const std::vector<Segment*>& segments) const;
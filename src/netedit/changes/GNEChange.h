@@ -103,14 +103,14 @@ public:
      * single-character text changes into a single block change.
      * The default implementation returns FALSE.
      */
-    bool canMerge() const;
+    virtual bool canMerge() const;
 
     /**
      * @brief Called by the undo system to try and merge the new incoming command
      * with this command; should return TRUE if merging was possible.
      * The default implementation returns FALSE.
      */
-    bool mergeWith(GNEChange* command);
+    virtual bool mergeWith(GNEChange* command);
 
 protected:
     /// @brief FOX need this
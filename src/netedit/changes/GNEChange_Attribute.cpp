@@ -21,6 +21,7 @@
 
 #include <netedit/GNENet.h>
 #include <netedit/GNEUndoList.h>
+#include <set>
 #include <netedit/elements/data/GNEDataSet.h>
 
 #include "GNEChange_Attribute.h"
@@ -42,9 +43,14 @@ GNEChange_Attribute::changeAttribute(GNEAttributeCarrier* AC, SumoXMLAttr key, c
     change->myForceChange = force;
     // check if process change
     if (change->trueChange()) {
-        undoList->begin(AC, TLF("change '%' attribute in % '%' to '%'", toString(key), AC->getTagStr(), AC->getID(), value));
-        undoList->add(change, true);
-        undoList->end();
+        if (undoList->hasCommandGroup()) {
+            // add directly to the current group to allow merging with the previous change
+            undoList->add(change, true);
+        } else {
+            undoList->begin(AC, TLF("change '%' attribute in % '%' to '%'", toString(key), AC->getTagStr(), AC->getID(), value));
+            undoList->add(change, true);
+            undoList->end();
+        }
     } else {
         delete change;
     }
@@ -59,9 +65,14 @@ GNEChange_Attribute::changeAttribute(GNEAttributeCarrier* AC, SumoXMLAttr key, c
     change->myForceChange = force;
     // check if process change
     if (change->trueChange()) {
-        undoList->begin(AC, TLF("change '%' attribute in % '%' to '%'", toString(key), AC->getTagStr(), AC->getID(), value));
-        undoList->add(change, true);
-        undoList->end();
+        if (undoList->hasCommandGroup()) {
+            // add directly to the current group to allow merging with the previous change
+            undoList->add(change, true);
+        } else {
+            undoList->begin(AC, TLF("change '%' attribute in % '%' to '%'", toString(key), AC->getTagStr(), AC->getID(), value));
+            undoList->add(change, true);
+            undoList->end();
+        }
     } else {
         delete change;
     }
@@ -69,14 +80,16 @@ GNEChange_Attribute::changeAttribute(GNEAttributeCarrier* AC, SumoXMLAttr key, c
 
 
 GNEChange_Attribute::~GNEChange_Attribute() {
-    // decrease reference
-    myAC->decRef("GNEChange_Attribute " + toString(myKey));
-    // remove if is unreferenced
-    if (myAC->unreferenced()) {
-        // show extra information for tests
-        WRITE_DEBUG("Deleting unreferenced " + myAC->getTagStr() + " in GNEChange_Attribute");
-        // delete AC
-        delete myAC;
+    for (GNEAttributeCarrier* AC : myACs) {
+        // decrease reference
+        AC->decRef("GNEChange_Attribute " + toString(myKey));
+        // remove if is unreferenced
+        if (AC->unreferenced()) {
+            // show extra information for tests
+            WRITE_DEBUG("Deleting unreferenced " + AC->getTagStr() + " in GNEChange_Attribute");
+            // delete AC
+            delete AC;
+        }
     }
 }
 
@@ -85,33 +98,8 @@ void
 GNEChange_Attribute::undo() {
     // show extra information for tests
     WRITE_DEBUG("Restoring previous attribute"/* + toString(myKey)*/);
-    // set original value
-    myAC->setAttribute(myKey, myOrigValue);
-    // certain attributes needs extra operations
-    if (myKey != GNE_ATTR_SELECTED) {
-        // check if updated attribute requires a update geometry
-        if (myAC->getTagProperty().hasAttribute(myKey) && myAC->getTagProperty().getAttributeProperties(myKey).requireUpdateGeometry()) {
-            myAC->updateGeometry();
-        }
-        // if is a dataelement, update attribute colors
-        if (myAC->getTagProperty().isGenericData()) {
-            myAC->getNet()->getAttributeCarriers()->retrieveDataSet(myAC->getAttribute(GNE_ATTR_DATASET))->updateAttributeColors();
-        } else if (myAC->getTagProperty().getTag() == SUMO_TAG_DATASET) {
-            myAC->getNet()->getAttributeCarriers()->retrieveDataSet(myAC->getAttribute(SUMO_ATTR_ID))->updateAttributeColors();
-        }
-        // check if networkElements, additional or shapes has to be saved (only if key isn't GNE_ATTR_SELECTED)
-        if (myAC->getTagProperty().isNetworkElement()) {
-            myAC->getNet()->getSavingStatus()->requireSaveNetwork();
-        } else if (myAC->getTagProperty().isAdditionalElement()) {
-            myAC->getNet()->getSavingStatus()->requireSaveAdditionals();
-        } else if (myAC->getTagProperty().isDemandElement()) {
-            myAC->getNet()->getSavingStatus()->requireSaveDemandElements();
-        } else if (myAC->getTagProperty().isDataElement()) {
-            myAC->getNet()->getSavingStatus()->requireSaveDataElements();
-        } else if (myAC->getTagProperty().isMeanData()) {
-            myAC->getNet()->getSavingStatus()->requireSaveMeanDatas();
-        }
-    }
+    // set original values
+    setValues(true);
 }
 
 
@@ -119,67 +107,70 @@ void
 GNEChange_Attribute::redo() {
     // show extra information for tests
     WRITE_DEBUG("Setting new attribute"/* + toString(myKey)*/);
-    // set new value
-    myAC->setAttribute(myKey, myNewValue);
-    // certain attributes needs extra operations
-    if (myKey != GNE_ATTR_SELECTED) {
-        // check if updated attribute requires a update geometry
-        if (myAC->getTagProperty().hasAttribute(myKey) && myAC->getTagProperty().getAttributeProperties(myKey).requireUpdateGeometry()) {
-            myAC->updateGeometry();
-        }
-        // if is a dataelement, update attribute colors
-        if (myAC->getTagProperty().isGenericData()) {
-            myAC->getNet()->getAttributeCarriers()->retrieveDataSet(myAC->getAttribute(GNE_ATTR_DATASET))->updateAttributeColors();
-        } else if (myAC->getTagProperty().getTag() == SUMO_TAG_DATASET) {
-            myAC->getNet()->getAttributeCarriers()->retrieveDataSet(myAC->getAttribute(SUMO_ATTR_ID))->updateAttributeColors();
-        }
-        // check if networkElements, additional or shapes has to be saved (only if key isn't GNE_ATTR_SELECTED)
-        if (myAC->getTagProperty().isNetworkElement()) {
-            myAC->getNet()->getSavingStatus()->requireSaveNetwork();
-        } else if (myAC->getTagProperty().isAdditionalElement()) {
-            myAC->getNet()->getSavingStatus()->requireSaveAdditionals();
-        } else if (myAC->getTagProperty().isDemandElement()) {
-            myAC->getNet()->getSavingStatus()->requireSaveDemandElements();
-        } else if (myAC->getTagProperty().isDataElement()) {
-            myAC->getNet()->getSavingStatus()->requireSaveDataElements();
-        } else if (myAC->getTagProperty().isMeanData()) {
-            myAC->getNet()->getSavingStatus()->requireSaveMeanDatas();
-        }
-    }
+    // set new values
+    setValues(false);
 }
 
 
 std::string
 GNEChange_Attribute::undoName() const {
-    return (TL("Undo change ") + myAC->getTagStr() + " attribute");
+    return (TL("Undo change ") + myACs.front()->getTagStr() + " attribute");
 }
 
 
 std::string
 GNEChange_Attribute::redoName() const {
-    return (TL("Redo change ") + myAC->getTagStr() + " attribute");
+    return (TL("Redo change ") + myACs.front()->getTagStr() + " attribute");
+}
+
+
+int
+GNEChange_Attribute::size() const {
+    return (int)myACs.size();
+}
+
+
+bool
+GNEChange_Attribute::canMerge() const {
+    return true;
+}
+
+
+bool
+GNEChange_Attribute::mergeWith(GNEChange* command) {
+    GNEChange_Attribute* change = dynamic_cast<GNEChange_Attribute*>(command);
+    if (change == nullptr || change->myKey != myKey || change->myNewValue != myNewValue ||
+            change->myForceChange != myForceChange || change->getSupermode() != getSupermode() ||
+            change->myACs.size() != 1) {
+        return false;
+    }
+    // take over the attribute carrier (the reference is decreased in our destructor)
+    myACs.push_back(change->myACs.front());
+    myOrigValues.push_back(change->myOrigValues.front());
+    change->myACs.front()->incRef("GNEChange_Attribute " + toString(myKey));
+    return true;
 }
 
 
 GNEChange_Attribute::GNEChange_Attribute(GNEAttributeCarrier* ac, SumoXMLAttr key, const std::string& value) :
     GNEChange(ac->getTagProperty().getSupermode(), true, false),
-    myAC(ac),
+    myACs({ac}),
     myKey(key),
     myForceChange(false),
-    myOrigValue(ac->getAttribute(key)),
+    myOrigValues({ac->getAttribute(key)}),
     myNewValue(value) {
-    myAC->incRef("GNEChange_Attribute " + toString(myKey));
+    ac->incRef("GNEChange_Attribute " + toString(myKey));
 }
 
 
 GNEChange_Attribute::GNEChange_Attribute(GNEAttributeCarrier* ac, SumoXMLAttr key, const std::string& value, const std::string& origValue) :
     GNEChange(ac->getTagProperty().getSupermode(), true, false),
-    myAC(ac),
+    myACs({ac}),
     myKey(key),
     myForceChange(false),
-    myOrigValue(origValue),
+    myOrigValues({origValue}),
     myNewValue(value) {
-    myAC->incRef("GNEChange_Attribute " + toString(myKey));
+    ac->incRef("GNEChange_Attribute " + toString(myKey));
 }
 
 
@@ -189,7 +180,49 @@ GNEChange_Attribute::trueChange() {
     if (myForceChange) {
         return true;
     } else {
-        return (myOrigValue != myNewValue);
+        return (myOrigValues.front() != myNewValue);
+    }
+}
+
+
+void
+GNEChange_Attribute::setValues(const bool undo) {
+    std::set<GNEDataSet*> dataSets;
+    const int numACs = (int)myACs.size();
+    for (int i = 0; i < numACs; i++) {
+        // undo in reverse order
+        const int index = undo ? numACs - 1 - i : i;
+        GNEAttributeCarrier* AC = myACs[index];
+        AC->setAttribute(myKey, undo ? myOrigValues[index] : myNewValue);
+        // certain attributes needs extra operations
+        if (myKey != GNE_ATTR_SELECTED) {
+            // check if updated attribute requires a update geometry
+            if (AC->getTagProperty().hasAttribute(myKey) && AC->getTagProperty().getAttributeProperties(myKey).requireUpdateGeometry()) {
+                AC->updateGeometry();
+            }
+            // if is a dataelement, collect data set for updating attribute colors
+            if (AC->getTagProperty().isGenericData()) {
+                dataSets.insert(AC->getNet()->getAttributeCarriers()->retrieveDataSet(AC->getAttribute(GNE_ATTR_DATASET)));
+            } else if (AC->getTagProperty().getTag() == SUMO_TAG_DATASET) {
+                dataSets.insert(AC->getNet()->getAttributeCarriers()->retrieveDataSet(AC->getAttribute(SUMO_ATTR_ID)));
+            }
+            // check if networkElements, additional or shapes has to be saved (only if key isn't GNE_ATTR_SELECTED)
+            if (AC->getTagProperty().isNetworkElement()) {
+                AC->getNet()->getSavingStatus()->requireSaveNetwork();
+            } else if (AC->getTagProperty().isAdditionalElement()) {
+                AC->getNet()->getSavingStatus()->requireSaveAdditionals();
+            } else if (AC->getTagProperty().isDemandElement()) {
+                AC->getNet()->getSavingStatus()->requireSaveDemandElements();
+            } else if (AC->getTagProperty().isDataElement()) {
+                AC->getNet()->getSavingStatus()->requireSaveDataElements();
+            } else if (AC->getTagProperty().isMeanData()) {
+                AC->getNet()->getSavingStatus()->requireSaveMeanDatas();
+            }
+        }
+    }
+    // update the attribute colors of every affected data set only once
+    for (GNEDataSet* dataSet : dataSets) {
+        dataSet->updateAttributeColors();
     }
 }
 
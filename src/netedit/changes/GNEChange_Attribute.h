@@ -28,6 +28,10 @@
 /**
  * @class GNEChange_Attribute
  * @brief the function-object for an editing operation (abstract base)
+ *
+ * Consecutive changes of the same attribute to the same value inside a change
+ *  group (i.e. bulk edits of a selection) are merged into a single change which
+ *  keeps only one copy of the key and the new value, and applies all of them in one pass.
  */
 class GNEChange_Attribute : public GNEChange {
     FXDECLARE_ABSTRACT(GNEChange_Attribute)
@@ -72,13 +76,22 @@ public:
     /// @brief redo action
     void redo();
 
+    /// @brief return the number of merged attribute changes
+    int size() const;
+
+    /// @brief attribute changes can always be merged
+    bool canMerge() const;
+
+    /// @brief merge the given change if it sets the same attribute to the same value
+    bool mergeWith(GNEChange* command);
+
     /// @}
 
 private:
-    /**@brief the net to which all operations shall be applied
-     * @note we are not responsible for the pointer
+    /**@brief the attribute carriers to which all operations shall be applied
+     * @note we are not responsible for the pointers
      */
-    GNEAttributeCarrier* myAC;
+    std::vector<GNEAttributeCarrier*> myACs;
 
     /// @brief The attribute name (or the original attribute if we're editing a disjoint attribute)
     const SumoXMLAttr myKey;
@@ -86,8 +99,8 @@ private:
     /// @brief flag used to force set attributes
     bool myForceChange;
 
-    /// @brief the original value
-    const std::string myOrigValue;
+    /// @brief the original values (one for every attribute carrier)
+    std::vector<std::string> myOrigValues;
 
     /// @brief the new value
     const std::string myNewValue;
@@ -110,4 +123,7 @@ private:
 
     /// @brief wether original and new value differ
     bool trueChange();
+
+    /// @brief set the given values and update geometries, data set colors and saving status once
+    void setValues(const bool undo);
 };
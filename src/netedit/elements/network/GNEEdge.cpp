@@ -85,9 +85,11 @@ myUpdateGeometry(true) {
         myLanes.push_back(new GNELane(this, i));
         myLanes.back()->incRef("GNEEdge::GNEEdge");
     }
-    // update Lane geometries
-    for (const auto& lane : myLanes) {
-        lane->updateGeometry();
+    // update Lane geometries (loaded edges are updated by the net once all edges exist)
+    if (!loaded) {
+        for (const auto& lane : myLanes) {
+            lane->updateGeometry();
+        }
     }
     // update centering boundary without updating grid
     updateCenteringBoundary(false);
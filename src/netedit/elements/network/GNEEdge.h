@@ -66,7 +66,7 @@ public:
     /**@brief Constructor
      * @param[in] net The net to inform about gui updates
      * @param[in] nbe The represented edge
-     * @param[in] loaded Whether the edge was loaded from a file
+     * @param[in] loaded Whether the edge was loaded from a file (the net computes the lane geometries afterwards)
      */
     GNEEdge(GNENet* net, NBEdge* nbe, bool wasSplit = false, bool loaded = false);
 
@@ -68,12 +68,16 @@ NGNet::getNextFreeID() {
 
 NGNode*
 NGNet::findNode(int xID, int yID) {
-    for (NGNodeList::iterator ni = myNodeList.begin(); ni != myNodeList.end(); ++ni) {
-        if ((*ni)->samePos(xID, yID)) {
-            return *ni;
-        }
-    }
-    return nullptr;
+    const auto it = myGridIndex.find(std::make_pair(xID, yID));
+    return it == myGridIndex.end() ? nullptr : it->second;
+}
+
+
+void
+NGNet::addGridNode(NGNode* node, int xID, int yID) {
+    myNodeList.push_back(node);
+    // keep the first node at each position like a search of myNodeList would
+    myGridIndex.insert(std::make_pair(std::make_pair(xID, yID), node));
 }
 
 std::string
@@ -99,7 +103,7 @@ NGNet::createChequerBoard(int numX, int numY, double spaceX, double spaceY, doub
             NGNode* node = new NGNode(nodeIDStart + toString(iy), ix, iy);
             node->setX(ix * spaceX + xAttachLength);
             node->setY(iy * spaceY + yAttachLength);
-            myNodeList.push_back(node);
+            addGridNode(node, ix, iy);
             // create Links
             if (ix > 0) {
                 connect(findNode(ix - 1, iy), node);
@@ -120,8 +124,8 @@ NGNet::createChequerBoard(int numX, int numY, double spaceX, double spaceY, doub
             bottomNode->setY(0);
             topNode->setFringe();
             bottomNode->setFringe();
-            myNodeList.push_back(topNode);
-            myNodeList.push_back(bottomNode);
+            addGridNode(topNode, ix, numY);
+            addGridNode(bottomNode, ix, numY + 1);
             // create links
             connect(findNode(ix, numY - 1), topNode);
             connect(bottomNode, findNode(ix, 0));
@@ -138,8 +142,8 @@ NGNet::createChequerBoard(int numX, int numY, double spaceX, double spaceY, doub
             rightNode->setY(iy * spaceY + yAttachLength);
             leftNode->setFringe();
             rightNode->setFringe();
-            myNodeList.push_back(leftNode);
-            myNodeList.push_back(rightNode);
+            addGridNode(leftNode, numX, iy);
+            addGridNode(rightNode, numX + 1, iy);
             // create links
             connect(leftNode, findNode(0, iy));
             connect(findNode(numX - 1, iy), rightNode);
@@ -190,7 +194,7 @@ NGNet::createSpiderWeb(int numRadDiv, int numCircles, double spaceRad, bool hasC
             node = new NGNode(nodeID, ir, ic);
             node->setX(radialToX((ic) * spaceRad, (ir - 1) * angle));
             node->setY(radialToY((ic) * spaceRad, (ir - 1) * angle));
-            myNodeList.push_back(node);
+            addGridNode(node, ir, ic);
             // create Links
             if (ir > 1 && ic != attachCircle) {
                 connect(findNode(ir - 1, ic), node);
@@ -208,7 +212,7 @@ NGNet::createSpiderWeb(int numRadDiv, int numCircles, double spaceRad, bool hasC
         node = new NGNode(myAlphaIDs ? "A1" : "1", 0, 0, true);
         node->setX(0);
         node->setY(0);
-        myNodeList.push_back(node);
+        addGridNode(node, 0, 0);
         // links
         for (ir = 1; ir < numRadDiv + 1; ir++) {
             connect(node, findNode(ir, 1));
@@ -22,6 +22,7 @@
 #pragma once
 #include <config.h>
 
+#include <map>
 #include <utils/distribution/Distribution_Parameterized.h>
 #include "NGEdge.h"
 #include "NGNode.h"
@@ -56,7 +57,7 @@ public:
 
     /** @brief Returns the node at the given position
      *
-     * Searches for a node with the given position within myNodeList.
+     * Searches for a grid or spider node with the given position.
      *  Returns the matching node, if one exists, or 0 otherwise.
      *
      * @param[in] xPos The x-position of the searched node
@@ -190,6 +191,9 @@ private:
      */
     void connect(NGNode* node1, NGNode* node2);
 
+    /// @brief adds a node of a grid or spider network which is retrievable by findNode
+    void addGridNode(NGNode* node, int xID, int yID);
+
     /// @brief return a letter code for the given integer index
     std::string alphabeticalCode(int i, int iMax);
 
@@ -212,6 +216,9 @@ private:
     /// @brief The list of links
     NGEdgeList myEdgeList;
 
+    /// @brief The grid and spider nodes by their position ids
+    std::map<std::pair<int, int>, NGNode*> myGridIndex;
+
 private:
     /// @brief Invalidated copy constructor.
     NGNet(const NGNet&);
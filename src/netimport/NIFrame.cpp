@@ -103,7 +103,7 @@ NIFrame::fillOptions(OptionsCont& oc, bool forNetedit) {
 
     oc.doRegister("osm-files", new Option_FileName());
     oc.addSynonyme("osm-files", "osm");
-    oc.addDescription("osm-files", "Input", TL("Read OSM-network from path 'FILE(s)'"));
+    oc.addDescription("osm-files", "Input", TL("Read OSM-network from path 'FILE(s)' (xml or pbf)"));
 
     oc.doRegister("opendrive-files", new Option_FileName());
     oc.addSynonyme("opendrive-files", "opendrive");
@@ -177,6 +177,12 @@ NIFrame::fillOptions(OptionsCont& oc, bool forNetedit) {
     oc.doRegister("osm.skip-duplicates-check", new Option_Bool(false));
     oc.addDescription("osm.skip-duplicates-check", "Formats", TL("Skips the check for duplicate nodes and edges"));
 
+    oc.doRegister("osm.two-pass", new Option_Bool(false));
+    oc.addDescription("osm.two-pass", "Formats", TL("Reads the osm-files twice to keep only the nodes used by ways and relations (reduces memory)"));
+
+    oc.doRegister("osm.import-boundary", new Option_StringVector());
+    oc.addDescription("osm.import-boundary", "Formats", TL("Only imports the ways with at least one node within the geo boundary <minLon,minLat,maxLon,maxLat> (implies osm.two-pass)"));
+
     oc.doRegister("osm.elevation", new Option_Bool(false));
     oc.addDescription("osm.elevation", "Formats", TL("Imports elevation data"));
 
@@ -354,6 +360,8 @@ NIFrame::fillOptions(OptionsCont& oc, bool forNetedit) {
     oc.addDescription("opendrive.ignore-widths", "Formats", TL("Whether lane widths shall be ignored."));
     oc.doRegister("opendrive.curve-resolution", new Option_Float(2.0));
     oc.addDescription("opendrive.curve-resolution", "Formats", TL("The geometry resolution in m when importing curved geometries as line segments."));
+    oc.doRegister("opendrive.curve-tolerance", new Option_Float(0.0));
+    oc.addDescription("opendrive.curve-tolerance", "Formats", TL("The maximum lateral deviation in m from arcs, spirals and cubic polynomials which allows to sample them coarser than curve-resolution (0 disables it)"));
     oc.doRegister("opendrive.advance-stopline", new Option_Float(0.0));
     oc.addDescription("opendrive.advance-stopline", "Formats", TL("Allow stop lines to be built beyond the start of the junction if the geometries allow so"));
     oc.doRegister("opendrive.min-width", new Option_Float(1.8));
@@ -25,6 +25,7 @@
 #include <string>
 #include <cmath>
 #include <iterator>
+#include <thread>
 #include <utils/xml/SUMOSAXHandler.h>
 #include <utils/common/UtilExceptions.h>
 #include <utils/common/StringUtils.h>
@@ -177,6 +178,7 @@ StringBijection<int>::Entry NIImporter_OpenDrive::openDriveAttrs[] = {
 bool NIImporter_OpenDrive::myImportAllTypes;
 bool NIImporter_OpenDrive::myImportWidths;
 double NIImporter_OpenDrive::myMinWidth;
+double NIImporter_OpenDrive::myCurveTolerance;
 bool NIImporter_OpenDrive::myIgnoreMisplacedSignals;
 bool NIImporter_OpenDrive::myImportInternalShapes;
 NIImporter_OpenDrive::OpenDriveController NIImporter_OpenDrive::myDummyController("", "");
@@ -197,6 +199,7 @@ NIImporter_OpenDrive::loadNetwork(const OptionsCont& oc, NBNetBuilder& nb) {
     myImportAllTypes = oc.getBool("opendrive.import-all-lanes");
     myImportWidths = !oc.getBool("opendrive.ignore-widths");
     myMinWidth = oc.getFloat("opendrive.min-width");
+    myCurveTolerance = oc.getFloat("opendrive.curve-tolerance");
     myImportInternalShapes = oc.getBool("opendrive.internal-shapes");
     myIgnoreMisplacedSignals = oc.getBool("opendrive.ignore-misplaced-signals");
     bool customLaneShapes = oc.getBool("opendrive.lane-shapes");
@@ -1495,73 +1498,12 @@ void
 NIImporter_OpenDrive::computeShapes(std::map<std::string, OpenDriveEdge*>& edges) {
     OptionsCont& oc = OptionsCont::getOptions();
     const double res = oc.getFloat("opendrive.curve-resolution");
+    // sampling is independent per edge, the projection has to be done serially
+    computeForAllEdges(edges, [res](OpenDriveEdge & e) {
+        computeGeometry(e, res);
+    });
     for (std::map<std::string, OpenDriveEdge*>::iterator i = edges.begin(); i != edges.end(); ++i) {
         OpenDriveEdge& e = *(*i).second;
-        GeometryType prevType = OPENDRIVE_GT_UNKNOWN;
-        const double lineRes = hasNonLinearElevation(e) ? res : -1;
-        Position last;
-        for (std::vector<OpenDriveGeometry>::iterator j = e.geometries.begin(); j != e.geometries.end(); ++j) {
-            OpenDriveGeometry& g = *j;
-            PositionVector geom;
-            switch (g.type) {
-                case OPENDRIVE_GT_UNKNOWN:
-                    break;
-                case OPENDRIVE_GT_LINE:
-                    geom = geomFromLine(e, g, lineRes);
-                    break;
-                case OPENDRIVE_GT_SPIRAL:
-                    geom = geomFromSpiral(e, g, res);
-                    break;
-                case OPENDRIVE_GT_ARC:
-                    geom = geomFromArc(e, g, res);
-                    break;
-                case OPENDRIVE_GT_POLY3:
-                    geom = geomFromPoly(e, g, res);
-                    break;
-                case OPENDRIVE_GT_PARAMPOLY3:
-                    geom = geomFromParamPoly(e, g, res);
-                    break;
-                default:
-                    break;
-            }
-            if (e.geom.size() > 0 && prevType == OPENDRIVE_GT_LINE) {
-                // remove redundant end point of the previous geometry segment
-                // (the start point of the current segment should have the same value)
-                // this avoids geometry errors due to imprecision
-                if (!e.geom.back().almostSame(geom.front())) {
-                    const int index = (int)(j - e.geometries.begin());
-                    WRITE_WARNINGF(TL("Mismatched geometry for edge '%' between geometry segments % and %."), e.id, index - 1, index);
-                }
-                e.geom.pop_back();
-            }
-            //std::cout << " adding geometry to road=" << e.id << " old=" << e.geom << " new=" << geom << "\n";
-            for (PositionVector::iterator k = geom.begin(); k != geom.end(); ++k) {
-                last = *k;
-                e.geom.push_back_noDoublePos(*k);
-            }
-            prevType = g.type;
-        }
-        if (e.geom.size() == 1 && e.geom.front() != last) {
-            // avoid length-1 geometry due to almostSame check
-            e.geom.push_back(last);
-        }
-#ifdef DEBUG_SHAPE
-        if (DEBUG_COND3(e.id)) {
-            std::cout << " initialGeom=" << e.geom << "\n";
-        }
-#endif
-        if (oc.exists("geometry.min-dist") && !oc.isDefault("geometry.min-dist")) {
-            // simplify geometry for both directions consistently but ensure
-            // that start and end angles are preserved
-            if (e.geom.size() > 4) {
-                e.geom.removeDoublePoints(oc.getFloat("geometry.min-dist"), true, 1, 1, true);
-            }
-        }
-#ifdef DEBUG_SHAPE
-        if (DEBUG_COND3(e.id)) {
-            std::cout << " reducedGeom=" << e.geom << "\n";
-        }
-#endif
         if (!NBNetBuilder::transformCoordinates(e.geom)) {
             WRITE_ERRORF(TL("Unable to project coordinates for edge '%'."), e.id);
         }
@@ -1595,6 +1537,112 @@ NIImporter_OpenDrive::computeShapes(std::map<std::string, OpenDriveEdge*>& edges
 }
 
 
+void
+NIImporter_OpenDrive::computeGeometry(OpenDriveEdge& e, const double res) {
+    const OptionsCont& oc = OptionsCont::getOptions();
+    GeometryType prevType = OPENDRIVE_GT_UNKNOWN;
+    const double lineRes = hasNonLinearElevation(e) ? res : -1;
+    Position last;
+    for (std::vector<OpenDriveGeometry>::iterator j = e.geometries.begin(); j != e.geometries.end(); ++j) {
+        OpenDriveGeometry& g = *j;
+        PositionVector geom;
+        switch (g.type) {
+            case OPENDRIVE_GT_UNKNOWN:
+                break;
+            case OPENDRIVE_GT_LINE:
+                geom = geomFromLine(e, g, lineRes);
+                break;
+            case OPENDRIVE_GT_SPIRAL:
+                geom = geomFromSpiral(e, g, getCurveResolution(res, MAX2(fabs(g.params[0]), fabs(g.params[1]))));
+                break;
+            case OPENDRIVE_GT_ARC:
+                geom = geomFromArc(e, g, getCurveResolution(res, fabs(g.params[0])));
+                break;
+            case OPENDRIVE_GT_POLY3:
+                // the second derivative bounds the curvature
+                geom = geomFromPoly(e, g, getCurveResolution(res, MAX2(fabs(2 * g.params[2]), fabs(2 * g.params[2] + 6 * g.params[3] * g.length))));
+                break;
+            case OPENDRIVE_GT_PARAMPOLY3:
+                geom = geomFromParamPoly(e, g, res);
+                break;
+            default:
+                break;
+        }
+        if (e.geom.size() > 0 && prevType == OPENDRIVE_GT_LINE) {
+            // remove redundant end point of the previous geometry segment
+            // (the start point of the current segment should have the same value)
+            // this avoids geometry errors due to imprecision
+            if (!e.geom.back().almostSame(geom.front())) {
+                const int index = (int)(j - e.geometries.begin());
+                WRITE_WARNINGF(TL("Mismatched geometry for edge '%' between geometry segments % and %."), e.id, index - 1, index);
+            }
+            e.geom.pop_back();
+        }
+        //std::cout << " adding geometry to road=" << e.id << " old=" << e.geom << " new=" << geom << "\n";
+        for (PositionVector::iterator k = geom.begin(); k != geom.end(); ++k) {
+            last = *k;
+            e.geom.push_back_noDoublePos(*k);
+        }
+        prevType = g.type;
+    }
+    if (e.geom.size() == 1 && e.geom.front() != last) {
+        // avoid length-1 geometry due to almostSame check
+        e.geom.push_back(last);
+    }
+#ifdef DEBUG_SHAPE
+    if (DEBUG_COND3(e.id)) {
+        std::cout << " initialGeom=" << e.geom << "\n";
+    }
+#endif
+    if (oc.exists("geometry.min-dist") && !oc.isDefault("geometry.min-dist")) {
+        // simplify geometry for both directions consistently but ensure
+        // that start and end angles are preserved
+        if (e.geom.size() > 4) {
+            e.geom.removeDoublePoints(oc.getFloat("geometry.min-dist"), true, 1, 1, true);
+        }
+    }
+#ifdef DEBUG_SHAPE
+    if (DEBUG_COND3(e.id)) {
+        std::cout << " reducedGeom=" << e.geom << "\n";
+    }
+#endif
+}
+
+
+void
+NIImporter_OpenDrive::computeForAllEdges(std::map<std::string, OpenDriveEdge*>& edges, const std::function<void(OpenDriveEdge&)>& func) {
+    std::vector<OpenDriveEdge*> all;
+    all.reserve(edges.size());
+    for (const auto& item : edges) {
+        all.push_back(item.second);
+    }
+    const int numThreads = MAX2(1, MIN2(OptionsCont::getOptions().getInt("threads"), (int)all.size()));
+    const auto run = [&all, &func, numThreads](const int first) {
+        for (int i = first; i < (int)all.size(); i += numThreads) {
+            func(*all[i]);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < numThreads; i++) {
+        threads.emplace_back(run, i);
+    }
+    run(0);
+    for (std::thread& t : threads) {
+        t.join();
+    }
+}
+
+
+double
+NIImporter_OpenDrive::getCurveResolution(double resolution, double maxCurvature) {
+    if (myCurveTolerance <= 0 || maxCurvature <= 0) {
+        return resolution;
+    }
+    // a chord of length l on a circle with radius r deviates by about l^2 / (8 r) from the arc
+    return MAX2(resolution, sqrt(8 * myCurveTolerance / maxCurvature));
+}
+
+
 std::vector<double>
 NIImporter_OpenDrive::discretizeOffsets(PositionVector& geom, const std::vector<OpenDriveLaneOffset>& offsets, const std::string& id) {
     UNUSED_PARAMETER(id);
@@ -1678,8 +1726,8 @@ NIImporter_OpenDrive::addOffsets(bool left, PositionVector& geom, const std::vec
 
 void
 NIImporter_OpenDrive::revisitLaneSections(const NBTypeCont& tc, std::map<std::string, OpenDriveEdge*>& edges) {
-    for (std::map<std::string, OpenDriveEdge*>::iterator i = edges.begin(); i != edges.end(); ++i) {
-        OpenDriveEdge& e = *(*i).second;
+    // the lane sections of each edge are processed independently
+    computeForAllEdges(edges, [&tc](OpenDriveEdge & e) {
 #ifdef DEBUG_VARIABLE_SPEED
         if (DEBUG_COND(&e)) {
             gDebugFlag1 = true;
@@ -1732,7 +1780,7 @@ NIImporter_OpenDrive::revisitLaneSections(const NBTypeCont& tc, std::map<std::st
 #ifdef DEBUG_VARIABLE_SPEED
         gDebugFlag1 = false;
 #endif
-    }
+    });
 }
 
 
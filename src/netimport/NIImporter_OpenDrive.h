@@ -23,6 +23,7 @@
 #pragma once
 #include <config.h>
 
+#include <functional>
 #include <string>
 #include <map>
 #include <utils/xml/GenericSAXHandler.h>
@@ -695,6 +696,7 @@ private:
     static bool myImportAllTypes;
     static bool myImportWidths;
     static double myMinWidth;
+    static double myCurveTolerance;
     static bool myImportInternalShapes;
     static bool myIgnoreMisplacedSignals;
     static OpenDriveController myDummyController;
@@ -727,12 +729,25 @@ protected:
     static void calcPointOnCurve(double* ad_x, double* ad_y, double ad_centerX, double ad_centerY,
                                  double ad_r, double ad_length);
 
+    /// @brief the sampling distance for a curve with the given maximum curvature (see opendrive.curve-tolerance)
+    static double getCurveResolution(double resolution, double maxCurvature);
+
 
     /** @brief Computes a polygon representation of each edge's geometry
      * @param[in] edges The edges which geometries shall be converted
      */
     static void computeShapes(std::map<std::string, OpenDriveEdge*>& edges);
 
+    /// @brief samples the geometry records of a single edge (does not project the result)
+    static void computeGeometry(OpenDriveEdge& e, const double res);
+
+    /** @brief applies the function to all edges
+     *
+     * The edges are processed in parallel if several threads are configured,
+     *  so the function may only modify the given edge.
+     */
+    static void computeForAllEdges(std::map<std::string, OpenDriveEdge*>& edges, const std::function<void(OpenDriveEdge&)>& func);
+
     static bool hasNonLinearElevation(OpenDriveEdge& e);
 
     /// transform Poly3 into a list of offsets, adding intermediate points to geom if needed
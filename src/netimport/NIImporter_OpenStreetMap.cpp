@@ -38,6 +38,7 @@
 #include <utils/geom/GeomConvHelper.h>
 #include <utils/options/OptionsCont.h>
 #include <utils/xml/SUMOSAXHandler.h>
+#include <utils/xml/OSMPBFInput.h>
 #include <utils/xml/SUMOSAXReader.h>
 #include <utils/xml/SUMOXMLDefinitions.h>
 #include <utils/xml/XMLSubSys.h>
@@ -149,8 +150,55 @@ NIImporter_OpenStreetMap::load(const OptionsCont& oc, NBNetBuilder& nb) {
         myExtraAttributes.clear();
     }
 
+    // osm.pbf files are decoded in parallel
+    OSMPBFInput::setNumThreads(oc.getInt("threads"));
+
+    // collect the node ids used by ways and relations to skip all other nodes
+    const bool twoPass = oc.getBool("osm.two-pass") || oc.isSet("osm.import-boundary");
+    std::vector<long long int> referencedNodes;
+    std::vector<long long int> keptWays;
+    if (twoPass) {
+        ReferencedNodesHandler referencedHandler(referencedNodes);
+        if (oc.isSet("osm.import-boundary")) {
+            const std::vector<std::string> values = oc.getStringVector("osm.import-boundary");
+            std::vector<double> coords;
+            try {
+                for (const std::string& value : values) {
+                    coords.push_back(StringUtils::toDouble(value));
+                }
+            } catch (NumberFormatException&) {
+                coords.clear();
+            }
+            if (coords.size() != 4) {
+                throw ProcessError(TL("Invalid osm.import-boundary: need <minLon,minLat,maxLon,maxLat>"));
+            }
+            referencedHandler.setGeoBoundary(Boundary(coords[0], coords[1], coords[2], coords[3]), &keptWays);
+        }
+        for (const std::string& file : files) {
+            if (!FileHelpers::isReadable(file)) {
+                WRITE_ERRORF(TL("Could not open osm-file '%'."), file);
+                return;
+            }
+            referencedHandler.setFileName(file);
+            const long before = PROGRESS_BEGIN_TIME_MESSAGE("Collecting referenced nodes from osm-file '" + file + "'");
+            if (!XMLSubSys::runParser(referencedHandler, file)) {
+                return;
+            }
+            PROGRESS_TIME_MESSAGE(before);
+        }
+        std::sort(referencedNodes.begin(), referencedNodes.end());
+        referencedNodes.erase(std::unique(referencedNodes.begin(), referencedNodes.end()), referencedNodes.end());
+        referencedNodes.shrink_to_fit();
+        std::sort(keptWays.begin(), keptWays.end());
+        keptWays.erase(std::unique(keptWays.begin(), keptWays.end()), keptWays.end());
+        keptWays.shrink_to_fit();
+    }
+
     // load nodes, first
     NodesHandler nodesHandler(myOSMNodes, myUniqueNodes, oc);
+    if (twoPass) {
+        nodesHandler.setReferencedNodes(&referencedNodes);
+    }
     for (const std::string& file : files) {
         if (!FileHelpers::isReadable(file)) {
             WRITE_ERRORF(TL("Could not open osm-file '%'."), file);
@@ -172,6 +220,9 @@ NIImporter_OpenStreetMap::load(const OptionsCont& oc, NBNetBuilder& nb) {
 
     // load edges, then
     EdgesHandler edgesHandler(myOSMNodes, myEdges, myPlatformShapes);
+    if (oc.isSet("osm.import-boundary")) {
+        edgesHandler.setKeptWays(&keptWays);
+    }
     int idx = 0;
     for (const std::string& file : files) {
         edgesHandler.setFileName(file);
@@ -846,6 +897,16 @@ NIImporter_OpenStreetMap::insertEdge(Edge* e, int index, NBNode* from, NBNode* t
 }
 
 
+void
+NIImporter_OpenStreetMap::ReferencedNodesHandler::myEndElement(int element) {
+    if (element == SUMO_TAG_WAY && myKeptWays != nullptr && myCurrentWayIsInside) {
+        // ways crossing the border are kept completely
+        myToFill.insert(myToFill.end(), myCurrentWayNodes.begin(), myCurrentWayNodes.end());
+        myKeptWays->push_back(myCurrentWay);
+    }
+}
+
+
 // ---------------------------------------------------------------------------
 // definitions of NIImporter_OpenStreetMap::NodesHandler-methods
 // ---------------------------------------------------------------------------
@@ -863,6 +924,58 @@ NIImporter_OpenStreetMap::NodesHandler::NodesHandler(std::map<long long int, NIO
 
 NIImporter_OpenStreetMap::NodesHandler::~NodesHandler() = default;
 
+
+void
+NIImporter_OpenStreetMap::ReferencedNodesHandler::myStartElement(int element, const SUMOSAXAttributes& attrs) {
+    if (myKeptWays != nullptr) {
+        bool ok = true;
+        if (element == SUMO_TAG_NODE) {
+            const long long int id = attrs.get<long long int>(SUMO_ATTR_ID, nullptr, ok);
+            const double lon = attrs.get<double>(SUMO_ATTR_LON, nullptr, ok);
+            const double lat = attrs.get<double>(SUMO_ATTR_LAT, nullptr, ok);
+            if (ok && myGeoBoundary.around(Position(lon, lat))) {
+                myInsideNodes.push_back(id);
+                myInsideNodesSorted = false;
+            }
+        } else if (element == SUMO_TAG_WAY || element == SUMO_TAG_ND || element == SUMO_TAG_MEMBER) {
+            if (!myInsideNodesSorted) {
+                // the nodes precede the ways and relations in every file
+                std::sort(myInsideNodes.begin(), myInsideNodes.end());
+                myInsideNodes.erase(std::unique(myInsideNodes.begin(), myInsideNodes.end()), myInsideNodes.end());
+                myInsideNodesSorted = true;
+            }
+            if (element == SUMO_TAG_WAY) {
+                myCurrentWay = attrs.get<long long int>(SUMO_ATTR_ID, nullptr, ok);
+                myCurrentWayNodes.clear();
+                myCurrentWayIsInside = false;
+            } else if (element == SUMO_TAG_ND) {
+                const long long int ref = attrs.get<long long int>(SUMO_ATTR_REF, nullptr, ok);
+                if (ok) {
+                    myCurrentWayNodes.push_back(ref);
+                    myCurrentWayIsInside |= std::binary_search(myInsideNodes.begin(), myInsideNodes.end(), ref);
+                }
+            } else if (attrs.getOpt<std::string>(SUMO_ATTR_TYPE, nullptr, ok, "") == "node") {
+                // relation members outside the boundary are not needed
+                const long long int ref = attrs.get<long long int>(SUMO_ATTR_REF, nullptr, ok);
+                if (ok && std::binary_search(myInsideNodes.begin(), myInsideNodes.end(), ref)) {
+                    myToFill.push_back(ref);
+                }
+            }
+        }
+        return;
+    }
+    if (element == SUMO_TAG_ND || element == SUMO_TAG_MEMBER) {
+        bool ok = true;
+        if (element == SUMO_TAG_MEMBER && attrs.getOpt<std::string>(SUMO_ATTR_TYPE, nullptr, ok, "") != "node") {
+            return;
+        }
+        const long long int ref = attrs.get<long long int>(SUMO_ATTR_REF, nullptr, ok);
+        if (ok) {
+            myToFill.push_back(ref);
+        }
+    }
+}
+
 void
 NIImporter_OpenStreetMap::NodesHandler::myStartElement(int element, const SUMOSAXAttributes& attrs) {
     ++myHierarchyLevel;
@@ -882,6 +995,9 @@ NIImporter_OpenStreetMap::NodesHandler::myStartElement(int element, const SUMOSA
             // we do not use attrs.get here to save some time on parsing
             const long long int id = StringUtils::toLong(myLastNodeID);
             myCurrentNode = nullptr;
+            if (myReferencedNodes != nullptr && !std::binary_search(myReferencedNodes->begin(), myReferencedNodes->end(), id)) {
+                return;
+            }
             const auto insertionIt = myToFill.lower_bound(id);
             if (insertionIt == myToFill.end() || insertionIt->first != id) {
                 // assume we are loading multiple files, so we won't report duplicate nodes
@@ -1087,7 +1203,8 @@ NIImporter_OpenStreetMap::EdgesHandler::myStartElement(int element, const SUMOSA
         bool ok = true;
         const long long int id = attrs.get<long long int>(SUMO_ATTR_ID, nullptr, ok);
         const std::string& action = attrs.getOpt<std::string>(SUMO_ATTR_ACTION, nullptr, ok);
-        if (action == "delete" || !ok) {
+        if (action == "delete" || !ok
+                || (myKeptWays != nullptr && !std::binary_search(myKeptWays->begin(), myKeptWays->end(), id))) {
             myCurrentEdge = nullptr;
             return;
         }
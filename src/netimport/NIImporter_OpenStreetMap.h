@@ -29,6 +29,7 @@
 #include <utils/xml/SUMOSAXHandler.h>
 #include <utils/common/UtilExceptions.h>
 #include <utils/common/Parameterised.h>
+#include <utils/geom/Boundary.h>
 #include <netbuild/NBPTPlatform.h>
 
 
@@ -388,6 +389,66 @@ protected:
 
     void applyTurnSigns(NBEdge* e, const std::vector<int>& turnSigns);
 
+    /**
+     * @class ReferencedNodesHandler
+     * @brief A class which collects the ids of the nodes used by ways and relations (first pass of osm.two-pass)
+     */
+    class ReferencedNodesHandler : public SUMOSAXHandler {
+    public:
+        /** @brief Constructor
+         * @param[in, out] toFill The node ids container to fill (unsorted, may contain duplicates)
+         */
+        ReferencedNodesHandler(std::vector<long long int>& toFill) :
+            SUMOSAXHandler("osm - file"),
+            myToFill(toFill) {}
+
+        /** @brief restricts the collected references to the ways with at least one node within the boundary
+         * @param[in] geoBoundary The boundary in lon/lat
+         * @param[in, out] keptWays The ids of the ways to import (unsorted)
+         */
+        void setGeoBoundary(const Boundary& geoBoundary, std::vector<long long int>* keptWays) {
+            myGeoBoundary = geoBoundary;
+            myKeptWays = keptWays;
+        }
+
+    protected:
+        /// @brief collects the references of nd and (node) member elements
+        void myStartElement(int element, const SUMOSAXAttributes& attrs) override;
+
+        /// @brief decides whether the finished way is kept (only with a geo boundary)
+        void myEndElement(int element) override;
+
+    private:
+        /// @brief The node ids container to fill
+        std::vector<long long int>& myToFill;
+
+        /// @brief The boundary to import (only valid if myKeptWays is set)
+        Boundary myGeoBoundary;
+
+        /// @brief The ids of the ways to import (nullptr if all are imported)
+        std::vector<long long int>* myKeptWays = nullptr;
+
+        /// @brief The ids of the nodes within the boundary
+        std::vector<long long int> myInsideNodes;
+
+        /// @brief Whether myInsideNodes is sorted
+        bool myInsideNodesSorted = true;
+
+        /// @brief The id and the references of the current way
+        long long int myCurrentWay = 0;
+        std::vector<long long int> myCurrentWayNodes;
+
+        /// @brief Whether the current way has a node within the boundary
+        bool myCurrentWayIsInside = false;
+
+    private:
+        /** @brief invalidated copy constructor */
+        ReferencedNodesHandler(const ReferencedNodesHandler& s);
+
+        /** @brief invalidated assignment operator */
+        ReferencedNodesHandler& operator=(const ReferencedNodesHandler& s);
+    };
+
     /**
      * @class NodesHandler
      * @brief A class which extracts OSM-nodes from a parsed OSM-file
@@ -415,6 +476,11 @@ protected:
             myHierarchyLevel = 0;
         }
 
+        /// @brief only nodes contained in the given sorted ids are kept (nullptr keeps all)
+        void setReferencedNodes(const std::vector<long long int>* referenced) {
+            myReferencedNodes = referenced;
+        }
+
     protected:
         /// @name inherited from GenericSAXHandler
         //@{
@@ -455,6 +521,9 @@ protected:
         /// @brief the set of unique nodes (used for duplicate detection/substitution)
         std::set<NIOSMNode*, CompareNodes>& myUniqueNodes;
 
+        /// @brief the sorted ids of the nodes to keep (nullptr keeps all)
+        const std::vector<long long int>* myReferencedNodes = nullptr;
+
         /// @brief whether elevation data should be imported
         const bool myImportElevation;
 
@@ -492,6 +561,10 @@ protected:
         /// @brief Destructor
         ~EdgesHandler() override;
 
+        /// @brief only ways contained in the given sorted ids are imported (nullptr imports all)
+        void setKeptWays(const std::vector<long long int>* kept) {
+            myKeptWays = kept;
+        }
 
     protected:
         /// @name inherited from GenericSAXHandler
@@ -536,6 +609,9 @@ protected:
         /// @brief The currently built edge
         Edge* myCurrentEdge = nullptr;
 
+        /// @brief The sorted ids of the ways to import (nullptr if all are imported)
+        const std::vector<long long int>* myKeptWays = nullptr;
+
         /// @brief A map of non-numeric speed descriptions to their numeric values
         std::map<std::string, double> mySpeedMap;
 
@@ -211,7 +211,7 @@ NIImporter_VISUM::load() {
             ParserVector::iterator i;
             for (i = mySingleDataParsers.begin(); i != mySingleDataParsers.end(); i++) {
                 std::string dataName = "$" + (*i).name + ":";
-                if (line.substr(0, dataName.length()) == dataName) {
+                if (line.compare(0, dataName.length(), dataName) == 0) {
                     (*i).position = myLineReader.getPosition();
                     (*i).pattern = line.substr(dataName.length());
                     WRITE_MESSAGE("Found: " + dataName + " at line " + toString<int>(myLineReader.getLineNumber()));
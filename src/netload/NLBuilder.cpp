@@ -21,6 +21,7 @@
 /****************************************************************************/
 #include <config.h>
 
+#include <fstream>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -38,6 +39,7 @@
 #include <utils/common/ToString.h>
 #include <utils/vehicle/SUMORouteLoaderControl.h>
 #include <utils/vehicle/SUMORouteLoader.h>
+#include <utils/xml/SUMOSAXCache.h>
 #include <utils/xml/XMLSubSys.h>
 #ifdef HAVE_FOX
 #include <utils/foxtools/MsgHandlerSynchronized.h>
@@ -69,6 +71,13 @@
 #include "NLBuilder.h"
 
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+std::map<std::string, SUMOSAXCache*> NLBuilder::myNetCache;
+int NLBuilder::myEnsembleRun = 0;
+
+
 // ===========================================================================
 // method definitions
 // ===========================================================================
@@ -155,6 +164,7 @@ NLBuilder::build() {
         const SUMOTime stateTime = MSStateHandler::MSStateTimeHandler::getTime(myOptions.getString("load-state"));
         if (myOptions.isDefault("begin")) {
             myOptions.set("begin", time2string(stateTime));
+            MSGlobals::gBegin = stateTime;
             if (TraCIServer::getInstance() != nullptr) {
                 TraCIServer::getInstance()->stateLoaded(stateTime);
             }
@@ -261,6 +271,7 @@ NLBuilder::build() {
                 return false;
             }
         }
+        myNet.getWeightsStorage().compact();
     }
     // load the previous state if wished
     if (myOptions.isSet("load-state")) {
@@ -311,6 +322,7 @@ NLBuilder::init(const bool isLibsumo) {
         }
     }
     XMLSubSys::setValidation(validation, oc.getString("xml-validation.net"), routeValidation);
+    XMLSubSys::setParseThreads(oc.getInt("parse-threads"));
     if (!MSFrame::checkOptions()) {
         throw ProcessError();
     }
@@ -321,6 +333,12 @@ NLBuilder::init(const bool isLibsumo) {
     }
 #endif
     MsgHandler::initOutputOptions();
+    if (myEnsembleRun > 0) {
+        // every run of an ensemble continues with the next seed
+        const int seed = oc.getInt("seed") + myEnsembleRun;
+        oc.resetWritable();
+        oc.set("seed", toString(seed));
+    }
     initRandomness();
     MSFrame::setMSGlobals(oc);
     MSVehicleControl* vc = nullptr;
@@ -368,6 +386,33 @@ NLBuilder::initRandomness() {
 }
 
 
+std::vector<std::vector<std::string> >
+NLBuilder::readBatchScenarios(const std::string& file) {
+    std::ifstream strm(file.c_str());
+    if (!strm.good()) {
+        throw ProcessError(TLF("Could not load batch file '%'.", file));
+    }
+    std::vector<std::vector<std::string> > result;
+    std::string line;
+    while (std::getline(strm, line)) {
+        line = StringUtils::prune(line);
+        if (line != "" && line[0] != '#') {
+            result.push_back(StringTokenizer(line, StringTokenizer::WHITECHARS).getVector());
+        }
+    }
+    return result;
+}
+
+
+void
+NLBuilder::clearNetCache() {
+    for (const auto& item : myNetCache) {
+        delete item.second;
+    }
+    myNetCache.clear();
+}
+
+
 void
 NLBuilder::buildNet() {
     MSEdgeControl* edges = nullptr;
@@ -425,7 +470,29 @@ NLBuilder::load(const std::string& mmlWhat, const bool isNet) {
     std::vector<std::string> files = myOptions.getStringVector(mmlWhat);
     for (std::vector<std::string>::const_iterator fileIt = files.begin(); fileIt != files.end(); ++fileIt) {
         const long before = PROGRESS_BEGIN_TIME_MESSAGE(TLF("Loading % from '%'", mmlWhat, *fileIt));
-        if (!XMLSubSys::runParser(myXMLHandler, *fileIt, isNet)) {
+        if (isNet && (myOptions.isSet("batch") || myOptions.getInt("ensemble") > 1)) {
+            // the network is parsed once and passed to the handler of every scenario
+            auto it = myNetCache.find(*fileIt);
+            if (it == myNetCache.end()) {
+                SUMOSAXCache* cache = new SUMOSAXCache(*fileIt);
+                if (!XMLSubSys::runParser(*cache, *fileIt, isNet)) {
+                    delete cache;
+                    WRITE_MESSAGEF(TL("Loading of % failed."), mmlWhat);
+                    return false;
+                }
+                it = myNetCache.insert(std::make_pair(*fileIt, cache)).first;
+            }
+            MsgHandler::getErrorInstance()->clear();
+            try {
+                it->second->replay(myXMLHandler);
+            } catch (const ProcessError& e) {
+                WRITE_ERROR(e.what());
+            }
+            if (MsgHandler::getErrorInstance()->wasInformed()) {
+                WRITE_MESSAGEF(TL("Loading of % failed."), mmlWhat);
+                return false;
+            }
+        } else if (!XMLSubSys::runParser(myXMLHandler, *fileIt, isNet)) {
             WRITE_MESSAGEF(TL("Loading of % failed."), mmlWhat);
             return false;
         }
@@ -448,8 +515,9 @@ NLBuilder::buildRouteLoaderControl(const OptionsCont& oc) {
             }
         }
         // open files for reading
+        const bool prefetch = oc.getBool("route-prefetch");
         for (std::vector<std::string>::const_iterator fileIt = files.begin(); fileIt != files.end(); ++fileIt) {
-            loaders->add(new SUMORouteLoader(new MSRouteHandler(*fileIt, false)));
+            loaders->add(new SUMORouteLoader(new MSRouteHandler(*fileIt, false), prefetch));
         }
     }
     return loaders;
@@ -42,6 +42,7 @@ class NLDetectorBuilder;
 class NLTriggerBuilder;
 class SUMORouteLoader;
 class SUMORouteLoaderControl;
+class SUMOSAXCache;
 
 
 // ===========================================================================
@@ -98,6 +99,23 @@ public:
     /// @brief initializes all RNGs
     static void initRandomness();
 
+    /** @brief Reads the scenarios of a batch file
+     *
+     * Each non-empty line which does not start with '#' gives the additional options of one scenario.
+     * @param[in] file The batch file
+     * @return The options of each scenario
+     * @exception ProcessError If the file cannot be read
+     */
+    static std::vector<std::vector<std::string> > readBatchScenarios(const std::string& file);
+
+    /// @brief removes the network files kept in memory for batch runs
+    static void clearNetCache();
+
+    /// @brief sets the index of the next ensemble run (which is added to the seed)
+    static void setEnsembleRun(const int run) {
+        myEnsembleRun = run;
+    }
+
     /** @brief Builds the route loader control
      *
      * Goes through the list of route files to open defined in the option
@@ -214,6 +232,12 @@ protected:
     /// @brief The handler used to parse the net
     NLHandler& myXMLHandler;
 
+    /// @brief the parsed network files for batch runs
+    static std::map<std::string, SUMOSAXCache*> myNetCache;
+
+    /// @brief the index of the current ensemble run
+    static int myEnsembleRun;
+
 
 private:
     /// @brief invalidated copy operator
@@ -25,6 +25,9 @@
 #include <algorithm>
 #include <utils/options/OptionsCont.h>
 #include <utils/iodevices/OutputDevice.h>
+#include <utils/iodevices/OutputDevice_String.h>
+#include <utils/iodevices/BinaryFormatter.h>
+#include <utils/threadpool/WorkStealingThreadPool.h>
 #include <utils/geom/GeoConvHelper.h>
 #include <utils/common/ToString.h>
 #include <utils/common/MsgHandler.h>
@@ -48,6 +51,43 @@
 // ===========================================================================
 // method definitions
 // ===========================================================================
+template<class T, class F>
+bool
+NWWriter_SUMO::writeChunked(OutputDevice& into, const std::vector<T>& elements, const int numThreads, F write) {
+    bool hadAny = false;
+    if (numThreads <= 1 || elements.size() < 2) {
+        for (const T& element : elements) {
+            hadAny |= write(into, element);
+        }
+        return hadAny;
+    }
+    WorkStealingThreadPool<int> threadPool(false, std::vector<int>(numThreads));
+    const int numElements = (int)elements.size();
+    const int chunkSize = MAX2(1, numElements / (4 * numThreads));
+    std::vector<std::future<std::pair<bool, std::string> > > chunks;
+    for (int begin = 0; begin < numElements; begin += chunkSize) {
+        const int end = MIN2(begin + chunkSize, numElements);
+        chunks.push_back(threadPool.executeAsync([&elements, &write, begin, end](int) {
+            // all sections are written directly inside the net element
+            OutputDevice_String chunk(1);
+            bool chunkHadAny = false;
+            for (int i = begin; i < end; i++) {
+                chunkHadAny |= write(chunk, elements[i]);
+            }
+            return std::make_pair(chunkHadAny, chunk.getString());
+        }));
+    }
+    for (std::future<std::pair<bool, std::string> >& chunk : chunks) {
+        const std::pair<bool, std::string> result = chunk.get();
+        hadAny |= result.first;
+        if (!result.second.empty()) {
+            into.writePreformattedTag(result.second);
+        }
+    }
+    return hadAny;
+}
+
+
 // ---------------------------------------------------------------------------
 // static methods
 // ---------------------------------------------------------------------------
@@ -113,6 +153,21 @@ NWWriter_SUMO::writeNetwork(const OptionsCont& oc, NBNetBuilder& nb) {
     const NBNodeCont& nc = nb.getNodeCont();
     const NBEdgeCont& ec = nb.getEdgeCont();
     const NBDistrictCont& dc = nb.getDistrictCont();
+    // the large sections are formatted in chunks by several threads (messages are only synchronized with fox)
+    int numThreads = 1;
+#ifdef HAVE_FOX
+    if (!BinaryFormatter::isBinaryFile(oc.getString("output-file"))) {
+        numThreads = oc.getInt("threads");
+    }
+#endif
+    std::vector<const NBNode*> nodes;
+    for (const auto& item : nc) {
+        nodes.push_back(item.second);
+    }
+    std::vector<const NBEdge*> edges;
+    for (const auto& item : ec) {
+        edges.push_back(item.second);
+    }
 
     // write network offsets and projection
     GeoConvHelper::writeLocation(device);
@@ -123,10 +178,9 @@ NWWriter_SUMO::writeNetwork(const OptionsCont& oc, NBNetBuilder& nb) {
 
     // write inner lanes
     if (!oc.getBool("no-internal-links")) {
-        bool hadAny = false;
-        for (std::map<std::string, NBNode*>::const_iterator i = nc.begin(); i != nc.end(); ++i) {
-            hadAny |= writeInternalEdges(device, ec, *(*i).second);
-        }
+        const bool hadAny = writeChunked(device, nodes, numThreads, [&ec](OutputDevice & into, const NBNode * n) {
+            return writeInternalEdges(into, ec, *n);
+        });
         if (hadAny) {
             device.lf();
         }
@@ -134,50 +188,47 @@ NWWriter_SUMO::writeNetwork(const OptionsCont& oc, NBNetBuilder& nb) {
 
     // write edges with lanes and connected edges
     bool noNames = !oc.getBool("output.street-names");
-    for (std::map<std::string, NBEdge*>::const_iterator i = ec.begin(); i != ec.end(); ++i) {
-        writeEdge(device, *(*i).second, noNames);
-    }
+    writeChunked(device, edges, numThreads, [noNames](OutputDevice & into, const NBEdge * e) {
+        writeEdge(into, *e, noNames);
+        return true;
+    });
     device.lf();
 
     // write tls logics
     writeTrafficLights(device, nb.getTLLogicCont());
 
     // write the nodes (junctions)
-    for (std::map<std::string, NBNode*>::const_iterator i = nc.begin(); i != nc.end(); ++i) {
-        writeJunction(device, *(*i).second);
-    }
+    writeChunked(device, nodes, numThreads, [](OutputDevice & into, const NBNode * n) {
+        writeJunction(into, *n);
+        return true;
+    });
     device.lf();
     const bool includeInternal = !oc.getBool("no-internal-links");
     if (includeInternal) {
         // ... internal nodes if not unwanted
-        bool hadAny = false;
-        for (std::map<std::string, NBNode*>::const_iterator i = nc.begin(); i != nc.end(); ++i) {
-            hadAny |= writeInternalNodes(device, *(*i).second);
-        }
+        const bool hadAny = writeChunked(device, nodes, numThreads, [](OutputDevice & into, const NBNode * n) {
+            return writeInternalNodes(into, *n);
+        });
         if (hadAny) {
             device.lf();
         }
     }
 
     // write the successors of lanes
-    int numConnections = 0;
-    for (std::map<std::string, NBEdge*>::const_iterator it_edge = ec.begin(); it_edge != ec.end(); it_edge++) {
-        NBEdge* from = it_edge->second;
-        const std::vector<NBEdge::Connection>& connections = from->getConnections();
-        numConnections += (int)connections.size();
-        for (const NBEdge::Connection& con : connections) {
-            writeConnection(device, *from, con, includeInternal);
+    const bool hadConnections = writeChunked(device, edges, numThreads, [includeInternal](OutputDevice & into, const NBEdge * from) {
+        for (const NBEdge::Connection& con : from->getConnections()) {
+            writeConnection(into, *from, con, includeInternal);
         }
-    }
-    if (numConnections > 0) {
+        return !from->getConnections().empty();
+    });
+    if (hadConnections) {
         device.lf();
     }
     if (includeInternal) {
         // ... internal successors if not unwanted
-        bool hadAny = false;
-        for (std::map<std::string, NBNode*>::const_iterator i = nc.begin(); i != nc.end(); ++i) {
-            hadAny |= writeInternalConnections(device, *(*i).second);
-        }
+        const bool hadAny = writeChunked(device, nodes, numThreads, [](OutputDevice & into, const NBNode * n) {
+            return writeInternalConnections(into, *n);
+        });
         if (hadAny) {
             device.lf();
         }
@@ -118,6 +118,20 @@ private:
      */
     static bool writeInternalEdges(OutputDevice& into, const NBEdgeCont& ec, const NBNode& n);
 
+    /** @brief Writes the given elements in order using the given function
+     *
+     * With more than one thread, chunks of elements are formatted concurrently
+     *  into strings which are then appended in order, so the output does not
+     *  depend on the number of threads.
+     * @param[in] into The device to write into
+     * @param[in] elements The elements to write
+     * @param[in] numThreads The number of threads to use
+     * @param[in] write The function writing a single element, returning whether anything was written
+     * @return Whether any element was written
+     */
+    template<class T, class F>
+    static bool writeChunked(OutputDevice& into, const std::vector<T>& elements, const int numThreads, F write);
+
 
     /// @brief retrieve bidi edge id for internal corresponding to the given connection
     static std::string getInternalBidi(const NBEdge* e, const NBEdge::Connection& k, double& length);
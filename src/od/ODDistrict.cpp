@@ -54,14 +54,14 @@ ODDistrict::addSink(const std::string& id, double weight) {
 
 
 std::string
-ODDistrict::getRandomSource() const {
-    return mySources.get();
+ODDistrict::getRandomSource(SumoRNG* rng) const {
+    return mySources.get(rng);
 }
 
 
 std::string
-ODDistrict::getRandomSink() const {
-    return mySinks.get();
+ODDistrict::getRandomSink(SumoRNG* rng) const {
+    return mySinks.get(rng);
 }
 
 
@@ -89,10 +89,11 @@ public:
      * If the list of this district's sources is empty, an OutOfBoundsException
      *  -exception is thrown.
      *
+     * @param[in] rng The random number generator to use (nullptr for the global one)
      * @return One of this district's sources chosen randomly regarding their weights
      * @exception OutOfBoundsException If this district has no sources
      */
-    std::string getRandomSource() const;
+    std::string getRandomSource(SumoRNG* rng = nullptr) const;
 
 
     /** @brief Returns the id of a sink to use
@@ -100,10 +101,11 @@ public:
      * If the list of this district's sinks is empty, an OutOfBoundsException
      *  -exception is thrown.
      *
+     * @param[in] rng The random number generator to use (nullptr for the global one)
      * @return One of this district's sinks chosen randomly regarding their weights
      * @exception OutOfBoundsException If this district has no sinks
      */
-    std::string getRandomSink() const;
+    std::string getRandomSink(SumoRNG* rng = nullptr) const;
 
 
     /** @brief Returns the number of sinks
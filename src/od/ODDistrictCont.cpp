@@ -45,22 +45,22 @@ ODDistrictCont::~ODDistrictCont() {}
 
 
 std::string
-ODDistrictCont::getRandomSourceFromDistrict(const std::string& name) const {
+ODDistrictCont::getRandomSourceFromDistrict(const std::string& name, SumoRNG* rng) const {
     ODDistrict* district = get(name);
     if (district == nullptr) {
         throw InvalidArgument("There is no district '" + name + "'.");
     }
-    return district->getRandomSource();
+    return district->getRandomSource(rng);
 }
 
 
 std::string
-ODDistrictCont::getRandomSinkFromDistrict(const std::string& name) const {
+ODDistrictCont::getRandomSinkFromDistrict(const std::string& name, SumoRNG* rng) const {
     ODDistrict* district = get(name);
     if (district == nullptr) {
         throw InvalidArgument("There is no district '" + name + "'.");
     }
-    return district->getRandomSink();
+    return district->getRandomSink(rng);
 }
 
 
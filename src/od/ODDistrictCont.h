@@ -55,12 +55,13 @@ public:
      *  if this district does not contain a source.
      *
      * @param[in] name The id of the district to get a random source from
+     * @param[in] rng The random number generator to use (nullptr for the global one)
      * @return The id of a randomly chosen source
      * @exception InvalidArgument If the named district is not known
      * @exception OutOfBoundsException If the named district has no sources
      * @see ODDistrict::getRandomSource
      */
-    std::string getRandomSourceFromDistrict(const std::string& name) const;
+    std::string getRandomSourceFromDistrict(const std::string& name, SumoRNG* rng = nullptr) const;
 
 
     /** @brief Returns the id of a random sink from the named district
@@ -72,12 +73,13 @@ public:
      *  if this district does not contain a sink.
      *
      * @param[in] name The id of the district to get a random sink from
+     * @param[in] rng The random number generator to use (nullptr for the global one)
      * @return The id of a randomly chosen sink
      * @exception InvalidArgument If the named district is not known
      * @exception OutOfBoundsException If the named district has no sinks
      * @see ODDistrict::getRandomSink
      */
-    std::string getRandomSinkFromDistrict(const std::string& name) const;
+    std::string getRandomSinkFromDistrict(const std::string& name, SumoRNG* rng = nullptr) const;
 
     /// @brief load districts from files
     void loadDistricts(std::vector<std::string> files);
@@ -25,7 +25,9 @@
 
 #include <iostream>
 #include <algorithm>
+#include <limits>
 #include <list>
+#include <memory>
 #include <iterator>
 #include <utils/options/OptionsCont.h>
 #include <utils/common/FileHelpers.h>
@@ -33,6 +35,7 @@
 #include <utils/common/MsgHandler.h>
 #include <utils/common/ToString.h>
 #include <utils/common/RandHelper.h>
+#include <utils/threadpool/WorkStealingThreadPool.h>
 #include <utils/common/StringUtils.h>
 #include <utils/common/StringUtils.h>
 #include <utils/common/StringTokenizer.h>
@@ -168,10 +171,11 @@ double
 ODMatrix::computeDeparts(ODCell* cell,
                          int& vehName, std::vector<ODVehicle>& into,
                          const bool uniform, const bool differSourceSink,
-                         const std::string& prefix) {
+                         const std::string& prefix, int& numSameSourceSink,
+                         SumoRNG* rng) {
     int vehicles2insert = (int) cell->vehicleNumber;
     // compute whether the fraction forces an additional vehicle insertion
-    if (RandHelper::rand() < cell->vehicleNumber - (double)vehicles2insert) {
+    if (RandHelper::rand(rng) < cell->vehicleNumber - (double)vehicles2insert) {
         vehicles2insert++;
     }
     if (vehicles2insert == 0) {
@@ -186,15 +190,15 @@ ODMatrix::computeDeparts(ODCell* cell,
         if (uniform) {
             veh.depart = cell->begin + (SUMOTime)(offset + ((double)(cell->end - cell->begin) * (double) i / (double) vehicles2insert));
         } else {
-            veh.depart = (SUMOTime)RandHelper::rand(cell->begin, cell->end);
+            veh.depart = (SUMOTime)RandHelper::rand(cell->begin, cell->end, rng);
         }
         const bool canDiffer = myDistricts.get(cell->origin)->sourceNumber() > 1 || myDistricts.get(cell->destination)->sinkNumber() > 1;
         do {
-            veh.from = myDistricts.getRandomSourceFromDistrict(cell->origin);
-            veh.to = myDistricts.getRandomSinkFromDistrict(cell->destination);
+            veh.from = myDistricts.getRandomSourceFromDistrict(cell->origin, rng);
+            veh.to = myDistricts.getRandomSinkFromDistrict(cell->destination, rng);
         } while (canDiffer && differSourceSink && (veh.to == veh.from));
         if (!canDiffer && differSourceSink && (veh.to == veh.from)) {
-            WRITE_WARNINGF(TL("Cannot find different source and sink edge for origin '%' and destination '%'."), cell->origin, cell->destination);
+            numSameSourceSink++;
         }
         veh.cell = cell;
         into.push_back(veh);
@@ -257,6 +261,15 @@ ODMatrix::write(SUMOTime begin, const SUMOTime end,
     SumoXMLAttr fromAttr = oc.getBool("junctions") ? SUMO_ATTR_FROM_JUNCTION : SUMO_ATTR_FROM;
     SumoXMLAttr toAttr = oc.getBool("junctions") ? SUMO_ATTR_TO_JUNCTION : SUMO_ATTR_TO;
     const std::string vType = oc.isSet("vtype") ? oc.getString("vtype") : "";
+    const int numThreads = oc.exists("threads") ? oc.getInt("threads") : 1;
+    std::unique_ptr<WorkStealingThreadPool<int> > threadPool;
+    int baseSeed = 0;
+    if (numThreads > 1) {
+        // every cell gets its own random number stream (independent from the thread count)
+        threadPool = std::unique_ptr<WorkStealingThreadPool<int> >(new WorkStealingThreadPool<int>(false, std::vector<int>(numThreads)));
+        baseSeed = RandHelper::rand(std::numeric_limits<int>::max());
+    }
+    int cellIndex = 0;
 
     // go through the time steps
     for (SUMOTime t = begin; t < end;) {
@@ -266,23 +279,68 @@ ODMatrix::write(SUMOTime begin, const SUMOTime end,
         }
         // recheck whether a new cell got valid
         bool changed = false;
+        std::vector<ODCell*> newCells;
         while (next != myContainer.end() && (*next)->begin <= t && (*next)->end > t) {
             std::pair<std::string, std::string> odID = std::make_pair((*next)->origin, (*next)->destination);
             // check whether the current cell must be extended by the last fraction
-            if (fractionLeft.find(odID) != fractionLeft.end()) {
-                (*next)->vehicleNumber += fractionLeft[odID];
-                fractionLeft[odID] = 0;
+            auto it = fractionLeft.find(odID);
+            if (it != fractionLeft.end()) {
+                (*next)->vehicleNumber += it->second;
+                it->second = 0;
+            }
+            newCells.push_back(*next);
+            ++next;
+        }
+        // get the new departures (sampled in parallel if wished)
+        std::vector<std::vector<ODVehicle> > cellVehicles(newCells.size());
+        std::vector<double> fractions(newCells.size());
+        std::vector<int> numSameSourceSink(newCells.size(), 0);
+        if (threadPool != nullptr && newCells.size() > 1) {
+            const int chunkSize = MAX2(1, (int)newCells.size() / (4 * numThreads));
+            std::vector<std::future<void> > results;
+            for (int begin = 0; begin < (int)newCells.size(); begin += chunkSize) {
+                const int end = MIN2(begin + chunkSize, (int)newCells.size());
+                results.push_back(threadPool->executeAsync([&, begin, end](int) {
+                    SumoRNG rng("od");
+                    for (int i = begin; i < end; i++) {
+                        RandHelper::initRand(&rng, false, baseSeed + cellIndex + i);
+                        int unusedName = 0;
+                        fractions[i] = computeDeparts(newCells[i], unusedName, cellVehicles[i], uniform, differSourceSink, prefix, numSameSourceSink[i], &rng);
+                    }
+                }));
+            }
+            for (std::future<void>& result : results) {
+                result.get();
             }
-            // get the new departures (into tmp)
-            const int oldSize = (int)vehicles.size();
-            const double fraction = computeDeparts(*next, vehName, vehicles, uniform, differSourceSink, prefix);
-            if (oldSize != (int)vehicles.size()) {
+        } else {
+            for (int i = 0; i < (int)newCells.size(); i++) {
+                SumoRNG* rng = nullptr;
+                SumoRNG cellRNG("od");
+                if (threadPool != nullptr) {
+                    RandHelper::initRand(&cellRNG, false, baseSeed + cellIndex + i);
+                    rng = &cellRNG;
+                }
+                int unusedName = 0;
+                fractions[i] = computeDeparts(newCells[i], unusedName, cellVehicles[i], uniform, differSourceSink, prefix, numSameSourceSink[i], rng);
+            }
+        }
+        cellIndex += (int)newCells.size();
+        // collect the departures in the order of the cells
+        for (int i = 0; i < (int)newCells.size(); i++) {
+            ODCell* const cell = newCells[i];
+            if (numSameSourceSink[i] > 0) {
+                WRITE_WARNINGF(TL("Cannot find different source and sink edge for origin '%' and destination '%'."), cell->origin, cell->destination);
+            }
+            if (!cellVehicles[i].empty()) {
                 changed = true;
             }
-            if (fraction != 0) {
-                fractionLeft[odID] = fraction;
+            for (ODVehicle& veh : cellVehicles[i]) {
+                veh.id = prefix + toString(vehName++);
+                vehicles.push_back(veh);
+            }
+            if (fractions[i] != 0) {
+                fractionLeft[std::make_pair(cell->origin, cell->destination)] = fractions[i];
             }
-            ++next;
         }
         if (changed) {
             sort(vehicles.begin(), vehicles.end(), descending_departure_comperator());
@@ -305,12 +305,15 @@ protected:
      * @param[in] uniform Information whether departure times shallbe uniformly spread or random
      * @param[in] differSourceSink whether source and sink shall be different edges
      * @param[in] prefix A prefix for the vehicle names
+     * @param[out] numSameSourceSink The number of vehicles for which no different source and sink could be found
+     * @param[in] rng The random number generator to use (nullptr for the global one)
      * @return The number of left vehicles to insert
      */
     double computeDeparts(ODCell* cell,
                           int& vehName, std::vector<ODVehicle>& into,
                           const bool uniform, const bool differSourceSink,
-                          const std::string& prefix);
+                          const std::string& prefix, int& numSameSourceSink,
+                          SumoRNG* rng = nullptr);
 
 
     /** @brief Splits the given cell dividing it on the given time line and
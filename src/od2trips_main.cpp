@@ -161,6 +161,9 @@ fillOptions() {
     oc.doRegister("no-step-log", new Option_Bool(false));
     oc.addDescription("no-step-log", "Processing", TL("Disable console output of current time step"));
 
+    oc.doRegister("threads", new Option_Integer(1));
+    oc.addDescription("threads", "Processing", TL("Samples the trips of different od cells using INT threads"));
+
 
     // register defaults options
     oc.doRegister("departlane", new Option_String("free"));
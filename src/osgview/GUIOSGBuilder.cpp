@@ -46,6 +46,9 @@
 
 //#define DEBUG_TESSEL
 
+// the size of the square tiles grouping the static geometry for culling
+#define TILE_SIZE 250.
+
 // ===========================================================================
 // static member variables
 // ===========================================================================
@@ -61,15 +64,19 @@ GUIOSGBuilder::buildOSGScene(osg::Node* const tlg, osg::Node* const tly, osg::No
     osgUtil::Tessellator tesselator;
     osg::Group* root = new osg::Group();
     GUINet* net = static_cast<GUINet*>(MSNet::getInstance());
+    // the static geometry is grouped by tiles, so the culling can skip whole regions
+    std::map<std::pair<int, int>, osg::Group*> tiles;
     // build edges
     for (const MSEdge* e : net->getEdgeControl().getEdges()) {
         if (!e->isInternal()) {
-            buildOSGEdgeGeometry(*e, *root, tesselator);
+            const PositionVector& shape = e->getLanes()[0]->getShape();
+            buildOSGEdgeGeometry(*e, *getTile(tiles, *root, shape.positionAtOffset(shape.length() / 2.)), tesselator);
         }
     }
     // build junctions
     for (int index = 0; index < (int)net->myJunctionWrapper.size(); ++index) {
-        buildOSGJunctionGeometry(*net->myJunctionWrapper[index], *root, tesselator);
+        GUIJunctionWrapper& junction = *net->myJunctionWrapper[index];
+        buildOSGJunctionGeometry(junction, *getTile(tiles, *root, junction.getJunction().getPosition()), tesselator);
     }
     // build traffic lights
     GUISUMOAbstractView::Decal d;
@@ -106,6 +113,19 @@ GUIOSGBuilder::buildOSGScene(osg::Node* const tlg, osg::Node* const tly, osg::No
 }
 
 
+osg::Group*
+GUIOSGBuilder::getTile(std::map<std::pair<int, int>, osg::Group*>& tiles, osg::Group& root, const Position& pos) {
+    const std::pair<int, int> key((int)floor(pos.x() / TILE_SIZE), (int)floor(pos.y() / TILE_SIZE));
+    auto it = tiles.find(key);
+    if (it == tiles.end()) {
+        osg::Group* tile = new osg::Group();
+        root.addChild(tile);
+        it = tiles.insert(std::make_pair(key, tile)).first;
+    }
+    return it->second;
+}
+
+
 void
 GUIOSGBuilder::buildLight(const GUISUMOAbstractView::Decal& d, osg::Group& addTo) {
     // each light must have a unique number
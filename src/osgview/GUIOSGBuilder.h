@@ -82,6 +82,9 @@ private:
 
     static void setShapeState(osg::ref_ptr<osg::ShapeDrawable> shape);
 
+    /// @brief returns the group collecting the static geometry of the tile containing the given position (adding it to root if needed)
+    static osg::Group* getTile(std::map<std::pair<int, int>, osg::Group*>& tiles, osg::Group& root, const Position& pos);
+
     static std::map<std::string, osg::ref_ptr<osg::Node> > myCars;
 };
 
@@ -445,6 +445,36 @@ GUIOSGView::onPaint(FXObject*, FXSelector, void*) {
     }
     myDecalsLockMutex.unlock();
 
+    const SUMOTime now = MSNet::getInstance()->getCurrentTimeStep();
+    // the movables only change with the simulation step or the coloring, repaints with a moved camera can skip them
+    if (now != myLastUpdate || (myGUIDialogViewSettings != 0 && myGUIDialogViewSettings->shown())) {
+        updateMovables();
+    }
+    if (now != myLastUpdate && myTracked != 0) {
+        osg::Vec3d lookFrom, lookAt, up;
+        lookAt[0] = myTracked->getPosition().x();
+        lookAt[1] = myTracked->getPosition().y();
+        lookAt[2] = myTracked->getPosition().z();
+        const double angle = myTracked->getAngle();
+        lookFrom[0] = lookAt[0] + 50. * cos(angle);
+        lookFrom[1] = lookAt[1] + 50. * sin(angle);
+        lookFrom[2] = lookAt[2] + 10.;
+        osg::Matrix m;
+        m.makeLookAt(lookFrom, lookAt, osg::Z_AXIS);
+        myViewer->getCameraManipulator()->setByInverseMatrix(m);
+    }
+
+    if (myAdapter->makeCurrent()) {
+        myViewer->frame();
+        makeNonCurrent();
+    }
+    myLastUpdate = now;
+    return 1;
+}
+
+
+void
+GUIOSGView::updateMovables() {
     // reset active flag
     for (auto& item : myVehicles) {
         item.second.active = false;
@@ -454,6 +484,9 @@ GUIOSGView::onPaint(FXObject*, FXSelector, void*) {
     // build edges
     for (const MSEdge* e : net->getEdgeControl().getEdges()) {
         for (const MSLane* l : e->getLanes()) {
+            if (l->getVehicleNumber() == 0) {
+                continue;
+            }
             const MSLane::VehCont& vehicles = l->getVehiclesSecure();
             for (MSVehicle* msVeh : vehicles) {
                 GUIVehicle* veh = static_cast<GUIVehicle*>(msVeh);
@@ -509,23 +542,7 @@ GUIOSGView::onPaint(FXObject*, FXSelector, void*) {
         }
     }
 
-    const SUMOTime now = MSNet::getInstance()->getCurrentTimeStep();
-    if (now != myLastUpdate || (myGUIDialogViewSettings != 0 && myGUIDialogViewSettings->shown())) {
-        GUINet::getGUIInstance()->updateColor(*myVisualizationSettings);
-    }
-    if (now != myLastUpdate && myTracked != 0) {
-        osg::Vec3d lookFrom, lookAt, up;
-        lookAt[0] = myTracked->getPosition().x();
-        lookAt[1] = myTracked->getPosition().y();
-        lookAt[2] = myTracked->getPosition().z();
-        const double angle = myTracked->getAngle();
-        lookFrom[0] = lookAt[0] + 50. * cos(angle);
-        lookFrom[1] = lookAt[1] + 50. * sin(angle);
-        lookFrom[2] = lookAt[2] + 10.;
-        osg::Matrix m;
-        m.makeLookAt(lookFrom, lookAt, osg::Z_AXIS);
-        myViewer->getCameraManipulator()->setByInverseMatrix(m);
-    }
+    GUINet::getGUIInstance()->updateColor(*myVisualizationSettings);
 
     // reset active flag
     for (auto& item : myPersons) {
@@ -571,13 +588,6 @@ GUIOSGView::onPaint(FXObject*, FXSelector, void*) {
             ++person;
         }
     }
-
-    if (myAdapter->makeCurrent()) {
-        myViewer->frame();
-        makeNonCurrent();
-    }
-    myLastUpdate = now;
-    return 1;
 }
 
 
@@ -266,6 +266,9 @@ private:
     /// @brief inform HUD about the current window size to let it reposition
     void updateHUDPosition(int width, int height);
 
+    /// @brief update the colors and the transforms of the vehicles and persons
+    void updateMovables();
+
     class FXOSGAdapter : public osgViewer::GraphicsWindow {
     public:
         FXOSGAdapter(GUISUMOAbstractView* parent, FXCursor* cursor);
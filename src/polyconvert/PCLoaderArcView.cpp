@@ -95,17 +95,21 @@ PCLoaderArcView::toShape(OGRLineString* geom, const std::string& tid) {
         myWarnMissingProjection = false;
     }
     GeoConvHelper& geoConvHelper = GeoConvHelper::getProcessing();
-    PositionVector shape;
+    PositionVector geo;
 #if GDAL_VERSION_MAJOR < 3
     for (int j = 0; j < geom->getNumPoints(); j++) {
-        Position pos(geom->getX(j), geom->getY(j));
+        geo.push_back(Position(geom->getX(j), geom->getY(j)));
+    }
 #else
     for (const OGRPoint& p : *geom) {
-        Position pos(p.getX(), p.getY());
+        geo.push_back(Position(p.getX(), p.getY()));
+    }
 #endif
-        if (!geoConvHelper.x2cartesian(pos)) {
-            WRITE_ERRORF(TL("Unable to project coordinates for polygon '%'."), tid);
-        }
+    if (!geoConvHelper.x2cartesian(geo)) {
+        WRITE_ERRORF(TL("Unable to project coordinates for polygon '%'."), tid);
+    }
+    PositionVector shape;
+    for (const Position& pos : geo) {
         shape.push_back_noDoublePos(pos);
     }
     return shape;
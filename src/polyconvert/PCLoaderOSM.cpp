@@ -254,14 +254,17 @@ PCLoaderOSM::loadIfSet(OptionsCont& oc, PCPolyContainer& toFill, PCTypeMap& tm)
             WRITE_ERRORF(TL("Polygon '%' has no shape."), toString(e->id));
             continue;
         }
-        // compute shape
-        PositionVector vec;
+        // compute shape (projecting all nodes at once)
+        PositionVector geo;
         for (std::vector<long long int>::iterator j = e->myCurrentNodes.begin(); j != e->myCurrentNodes.end(); ++j) {
             PCOSMNode* n = nodes.find(*j)->second;
-            Position pos(n->lon, n->lat);
-            if (!GeoConvHelper::getProcessing().x2cartesian(pos)) {
-                WRITE_WARNINGF(TL("Unable to project coordinates for polygon '%'."), e->id);
-            }
+            geo.push_back(Position(n->lon, n->lat));
+        }
+        if (!GeoConvHelper::getProcessing().x2cartesian(geo)) {
+            WRITE_WARNINGF(TL("Unable to project coordinates for polygon '%'."), e->id);
+        }
+        PositionVector vec;
+        for (const Position& pos : geo) {
             vec.push_back_noDoublePos(pos);
         }
         const bool ignorePruning = OptionsCont::getOptions().isInStringVector("prune.keep-list", toString(e->id));
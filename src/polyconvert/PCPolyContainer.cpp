@@ -24,6 +24,7 @@
 
 #include <string>
 #include <algorithm>
+#include <future>
 #include <map>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/ToString.h>
@@ -31,9 +32,12 @@
 #include <utils/common/StringUtils.h>
 #include <utils/geom/GeoConvHelper.h>
 #include <utils/shapes/SUMOPolygon.h>
+#include <utils/iodevices/BinaryFormatter.h>
 #include <utils/iodevices/OutputDevice.h>
+#include <utils/iodevices/OutputDevice_String.h>
 #include <utils/xml/SUMOSAXAttributes.h>
 #include <utils/options/OptionsCont.h>
+#include <utils/threadpool/WorkStealingThreadPool.h>
 #include "PCPolyContainer.h"
 
 
@@ -113,8 +117,33 @@ PCPolyContainer::save(const std::string& file, bool useGeo) {
         GeoConvHelper::writeLocation(out);
     }
     // write polygons
-    for (auto i : myPolygons) {
-        i.second->writeXML(out, useGeo);
+    const int numThreads = OptionsCont::getOptions().getInt("threads");
+    if (numThreads > 1 && !useGeo && !BinaryFormatter::isBinaryFile(file) && myPolygons.size() > 1) {
+        // serialize chunks in parallel and write them in order (the geo conversion is not thread safe)
+        std::vector<const SUMOPolygon*> polygons;
+        for (auto i : myPolygons) {
+            polygons.push_back(i.second);
+        }
+        WorkStealingThreadPool<int> threadPool(false, std::vector<int>(numThreads));
+        const int chunkSize = MAX2(1, (int)polygons.size() / (4 * numThreads));
+        std::vector<std::future<std::string> > chunks;
+        for (int begin = 0; begin < (int)polygons.size(); begin += chunkSize) {
+            const int end = MIN2(begin + chunkSize, (int)polygons.size());
+            chunks.push_back(threadPool.executeAsync([&polygons, begin, end](int) {
+                OutputDevice_String chunk(1);
+                for (int i = begin; i < end; i++) {
+                    polygons[i]->writeXML(chunk, false);
+                }
+                return chunk.getString();
+            }));
+        }
+        for (std::future<std::string>& chunk : chunks) {
+            out.writePreformattedTag(chunk.get());
+        }
+    } else {
+        for (auto i : myPolygons) {
+            i.second->writeXML(out, useGeo);
+        }
     }
     // write pois
     const double zOffset = OptionsCont::getOptions().getFloat("poi-layer-offset");
@@ -67,7 +67,8 @@ ROEdge::ROEdge(const std::string& id, RONode* from, RONode* to, int index, const
     myUsingETimeLine(false),
     myCombinedPermissions(0),
     myOtherTazConnector(nullptr),
-    myTimePenalty(0) {
+    myTimePenalty(0),
+    myMinimumLineTravelTime(0) {
     while ((int)myEdges.size() <= index) {
         myEdges.push_back(0);
     }
@@ -211,6 +212,18 @@ ROEdge::getTravelTime(const ROVehicle* const veh, double time) const {
 }
 
 
+double
+ROEdge::getTravelTimeLowerBound(const ROVehicle* const veh) const {
+    const double speed = veh != nullptr ? MIN2(veh->getMaxSpeed(), veh->getType()->speedFactor.getParameter()[0] * mySpeed) : mySpeed;
+    const double freeFlow = myLength / speed + myTimePenalty;
+    if (myUsingTTTimeLine) {
+        // interpolated values lie between two stored values
+        return MIN2(freeFlow, MAX2(getMinimumTravelTime(veh), myMinimumLineTravelTime));
+    }
+    return freeFlow;
+}
+
+
 double
 ROEdge::getNoiseEffort(const ROEdge* const edge, const ROVehicle* const veh, double time) {
     double ret = 0;
@@ -315,9 +328,12 @@ ROEdge::buildTimeLines(const std::string& measure, const bool boundariesOverride
             value = PollutantsInterface::compute(c, PollutantsInterface::ELEC, mySpeed, 0, 0, nullptr) * value; // @todo: give correct slope
         }
         myEfforts.fillGaps(value, boundariesOverride);
+        myEfforts.compact();
     }
     if (myUsingTTTimeLine) {
         myTravelTimes.fillGaps(myLength / mySpeed + myTimePenalty, boundariesOverride);
+        myTravelTimes.compact();
+        myMinimumLineTravelTime = myTravelTimes.getMinimumValue(myLength / mySpeed + myTimePenalty);
     }
 }
 
@@ -400,6 +400,17 @@ public:
     double getTravelTime(const ROVehicle* const veh, double time) const;
 
 
+    /** @brief Returns a lower bound of the travel time for all times
+     *
+     * In contrast to getMinimumTravelTime the loaded travel times are taken
+     *  into account, so routing with time dependent weights may use it for
+     *  precomputing admissible heuristics.
+     * @param[in] veh The vehicle for which the travel time shall be retrieved
+     * @return The smallest travel time getTravelTime may return for the vehicle
+     */
+    double getTravelTimeLowerBound(const ROVehicle* const veh) const;
+
+
     /** @brief Returns the effort for the given edge
      *
      * @param[in] edge The edge for which the effort shall be retrieved
@@ -428,6 +439,10 @@ public:
         return edge->getTravelTime(veh, time) * RandHelper::rand(1., gWeightsRandomFactor);
     }
 
+    static inline double getTravelTimeLowerBoundStatic(const ROEdge* const edge, const ROVehicle* const veh, double /* time */) {
+        return edge->getTravelTimeLowerBound(veh);
+    }
+
     /// @brief Alias for getTravelTimeStatic (there is no routing device to provide aggregated travel times)
     static inline double getTravelTimeAggregated(const ROEdge* const edge, const ROVehicle* const veh, double time) {
         return edge->getTravelTime(veh, time);
@@ -633,6 +648,9 @@ protected:
     /// @brief flat penalty when computing traveltime
     double myTimePenalty;
 
+    /// @brief the smallest value of the travel time line
+    double myMinimumLineTravelTime;
+
     /// @brief cached value of parameters which may restrict access
     std::vector<double> myParamRestrictions;
 
@@ -167,14 +167,24 @@ ROFrame::fillOptions(OptionsCont& oc, const bool isDUA, const bool isMA) {
 
         oc.doRegister("bulk-routing", new Option_Bool(false));
         oc.addDescription("bulk-routing", "Processing", TL("Aggregate routing queries with the same origin"));
+
+        oc.doRegister("bulk-routing.interval", new Option_String("-1", "TIME"));
+        oc.addDescription("bulk-routing.interval", "Processing", TL("Aggregate only routing queries departing in the same interval of the given length (non-positive values aggregate all departures)"));
     }
 
     oc.doRegister("routing-threads", new Option_Integer(0));
     oc.addDescription("routing-threads", "Processing", TL("The number of parallel execution threads used for routing"));
 
+    oc.doRegister("parse-threads", new Option_Integer(0));
+    oc.addDescription("parse-threads", "Processing", TL("Parse large xml inputs (routes, additionals, edge data) in chunks using INT threads"));
+
     if (isDUA || isMA) {
         oc.doRegister("routing-algorithm", new Option_String("dijkstra"));
-        oc.addDescription("routing-algorithm", "Processing", TL("Select among routing algorithms ['dijkstra', 'astar', 'CH', 'CHWrapper']"));
+        if (isDUA) {
+            oc.addDescription("routing-algorithm", "Processing", TL("Select among routing algorithms ['dijkstra', 'astar', 'CH', 'CHWrapper', 'raptor' (intermodal only)]"));
+        } else {
+            oc.addDescription("routing-algorithm", "Processing", TL("Select among routing algorithms ['dijkstra', 'astar', 'CH', 'CHWrapper']"));
+        }
     }
 
     oc.doRegister("restriction-params", new Option_StringVector());
@@ -22,6 +22,7 @@
 #include <config.h>
 
 #include <algorithm>
+#include <tuple>
 #include <utils/router/RouteCostCalculator.h>
 #include <utils/vehicle/SUMOVTypeParameter.h>
 #include <utils/router/SUMOAbstractRouter.h>
@@ -624,27 +625,29 @@ RONet::checkFlows(SUMOTime time, MsgHandler* errorHandler) {
 
 void
 RONet::createBulkRouteRequests(const RORouterProvider& provider, const SUMOTime time, const bool removeLoops) {
-    std::map<const int, std::vector<RORoutable*> > bulkVehs;
+    // one search tree is shared by all queries with the same origin, vehicle class and departure interval
+    typedef std::tuple<int, SUMOVehicleClass, SUMOTime> BulkKey;
+    const SUMOTime interval = string2time(OptionsCont::getOptions().getString("bulk-routing.interval"));
+    std::map<BulkKey, std::vector<RORoutable*> > bulkVehs;
     for (RoutablesMap::const_iterator i = myRoutables.begin(); i != myRoutables.end(); ++i) {
         if (i->first >= time) {
             break;
         }
         for (RORoutable* const routable : i->second) {
             const ROEdge* const depEdge = routable->getDepartEdge();
-            bulkVehs[depEdge->getNumericalID()].push_back(routable);
-            RORoutable* const first = bulkVehs[depEdge->getNumericalID()].front();
+            std::vector<RORoutable*>& group = bulkVehs[std::make_tuple(depEdge->getNumericalID(), routable->getVClass(),
+                                                       interval > 0 ? routable->getDepart() / interval : 0)];
+            group.push_back(routable);
+            RORoutable* const first = group.front();
             if (first->getMaxSpeed() != routable->getMaxSpeed()) {
                 WRITE_WARNINGF(TL("Bulking different maximum speeds ('%' and '%') may lead to suboptimal routes."), first->getID(), routable->getID());
             }
-            if (first->getVClass() != routable->getVClass()) {
-                WRITE_WARNINGF(TL("Bulking different vehicle classes ('%' and '%') may lead to invalid routes."), first->getID(), routable->getID());
-            }
         }
     }
 #ifdef HAVE_FOX
     int workerIndex = 0;
 #endif
-    for (std::map<const int, std::vector<RORoutable*> >::const_iterator i = bulkVehs.begin(); i != bulkVehs.end(); ++i) {
+    for (std::map<BulkKey, std::vector<RORoutable*> >::const_iterator i = bulkVehs.begin(); i != bulkVehs.end(); ++i) {
 #ifdef HAVE_FOX
         if (myThreadPool.size() > 0) {
             bool bulk = true;
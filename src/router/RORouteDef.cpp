@@ -30,6 +30,7 @@
 #include <utils/common/StringUtils.h>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/RandHelper.h>
+#include <utils/common/StdDefs.h>
 #include <utils/iodevices/OutputDevice.h>
 #include <utils/options/OptionsCont.h>
 #include "ROEdge.h"
@@ -43,6 +44,7 @@
 // static members
 // ===========================================================================
 bool RORouteDef::myUsingJTRR(false);
+thread_local RORouteDef::CostCache RORouteDef::myCostCache;
 
 // ===========================================================================
 // method definitions
@@ -131,8 +133,8 @@ RORouteDef::preComputeCurrentRoute(SUMOAbstractRouter<ROEdge, ROVehicle>& router
         }
         return;
     }
-    if ((RouteCostCalculator<RORoute, ROEdge, ROVehicle>::getCalculator().skipRouteCalculation()
-            || OptionsCont::getOptions().getBool("remove-loops"))
+    const RouteCostCalculator<RORoute, ROEdge, ROVehicle>& calc = RouteCostCalculator<RORoute, ROEdge, ROVehicle>::getCalculator();
+    if ((calc.skipRouteCalculation() || oc.getBool("remove-loops") || calc.skipRerouting())
             && (skipTripRouting || myAlternatives[myLastUsed]->isValid(veh, ignoreErrors))) {
         myPrecomputed = myAlternatives[myLastUsed];
     } else {
@@ -314,7 +316,7 @@ RORouteDef::addAlternative(SUMOAbstractRouter<ROEdge, ROVehicle>& router,
             throw ProcessError("Route '" + current->getID() + "' (vehicle '" + veh->getID() + "') is not valid.");
         }
         // recompute the costs for all routes
-        const double newCosts = router.recomputeCosts(alt->getEdgeVector(), veh, begin);
+        const double newCosts = getCosts(router, alt->getEdgeVector(), veh, begin);
         assert(myAlternatives.size() != 0);
         if (myNewRoute) {
             if (alt == current) {
@@ -392,6 +394,29 @@ RORouteDef::addAlternative(SUMOAbstractRouter<ROEdge, ROVehicle>& router,
 }
 
 
+double
+RORouteDef::getCosts(const SUMOAbstractRouter<ROEdge, ROVehicle>& router, const ConstROEdgeVector& edges,
+                     const ROVehicle* const veh, SUMOTime begin) {
+    if (gWeightsRandomFactor > 1) {
+        // randomized weights differ for every call
+        return router.recomputeCosts(edges, veh, begin);
+    }
+    CostCache& cache = myCostCache;
+    if (cache.router != &router || cache.time != begin) {
+        // vehicles are routed by departure, so older entries will not be needed again
+        cache.costs.clear();
+        cache.router = &router;
+        cache.time = begin;
+    }
+    auto key = std::make_pair(veh->getType(), edges);
+    auto it = cache.costs.find(key);
+    if (it == cache.costs.end()) {
+        it = cache.costs.insert(std::make_pair(std::move(key), router.recomputeCosts(edges, veh, begin))).first;
+    }
+    return it->second;
+}
+
+
 const ROEdge*
 RORouteDef::getDestination() const {
     return myAlternatives[0]->getLast();
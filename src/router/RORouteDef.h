@@ -24,6 +24,7 @@
 
 #include <string>
 #include <iostream>
+#include <map>
 #include <utils/common/Named.h>
 #include <utils/router/SUMOAbstractRouter.h>
 #include "RORoute.h"
@@ -36,6 +37,7 @@ class ROEdge;
 class OptionsCont;
 class ROVehicle;
 class OutputDevice;
+class SUMOVTypeParameter;
 
 
 // ===========================================================================
@@ -167,6 +169,24 @@ protected:
 
     static bool myUsingJTRR;
 
+private:
+    /** @brief returns the costs of the route for the given vehicle
+     *
+     * Vehicles of the same type departing at the same time get the same costs
+     *  for the same edges, so the costs are cached for the current departure
+     *  time (per thread, since every routing thread has its own router).
+     */
+    static double getCosts(const SUMOAbstractRouter<ROEdge, ROVehicle>& router, const ConstROEdgeVector& edges,
+                           const ROVehicle* const veh, SUMOTime begin);
+
+    /// @brief the route costs of the current departure time
+    struct CostCache {
+        const SUMOAbstractRouter<ROEdge, ROVehicle>* router = nullptr;
+        SUMOTime time = -1;
+        std::map<std::pair<const SUMOVTypeParameter*, ConstROEdgeVector>, double> costs;
+    };
+    static thread_local CostCache myCostCache;
+
 private:
     /// @brief Invalidated copy constructor
     RORouteDef(const RORouteDef& src) = delete;
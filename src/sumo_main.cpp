@@ -29,6 +29,8 @@
 
 #include <csignal>
 #include <netload/NLBuilder.h>
+#include <microsim/MSFrame.h>
+#include <microsim/output/MSEnsembleStatistics.h>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/SystemFrame.h>
 #include <utils/options/OptionsIO.h>
@@ -92,20 +94,55 @@ main(int argc, char** argv) {
         // initialise subsystems
         XMLSubSys::init();
         OptionsIO::setArgs(argc, argv);
-        // load the net
-        MSNet::SimulationState state = MSNet::SIMSTATE_LOADING;
-        while (state == MSNet::SIMSTATE_LOADING) {
-            net = NLBuilder::init();
-            if (net != nullptr) {
-                state = net->simulate(string2time(oc.getString("begin")), string2time(oc.getString("end")));
-                delete net;
-            } else {
+        // check for a batch of scenarios (each one adds its options to the ones given on the command line)
+        std::vector<std::vector<std::string> > scenarios(1);
+        MSFrame::fillOptions();
+        OptionsIO::getOptions();
+        if (oc.isSet("batch")) {
+            scenarios = NLBuilder::readBatchScenarios(oc.getString("batch"));
+        }
+        // check for an ensemble (each scenario is run several times with different seeds)
+        const int ensembleRuns = MAX2(1, oc.getInt("ensemble"));
+        const std::string ensembleOutput = oc.isSet("ensemble-output") ? oc.getString("ensemble-output") : "";
+        const std::vector<std::string> baseArgs(argv + 1, argv + argc);
+        for (int index = 0; index < (int)scenarios.size() * ensembleRuns; index++) {
+            const std::vector<std::string>& scenario = scenarios[index / ensembleRuns];
+            const int run = index % ensembleRuns;
+            if (run == 0 && scenarios.size() > 1 && ensembleOutput != "") {
+                MSEnsembleStatistics::startScenario(toString(index / ensembleRuns));
+            }
+            std::vector<std::string> args = baseArgs;
+            args.insert(args.end(), scenario.begin(), scenario.end());
+            OptionsIO::setArgs(args);
+            NLBuilder::setEnsembleRun(run);
+            // load the net
+            MSNet::SimulationState state = MSNet::SIMSTATE_LOADING;
+            while (state == MSNet::SIMSTATE_LOADING) {
+                net = NLBuilder::init();
+                if (net != nullptr) {
+                    state = net->simulate(string2time(oc.getString("begin")), string2time(oc.getString("end")));
+                    if (ensembleOutput != "" && state != MSNet::SIMSTATE_LOADING) {
+                        MSEnsembleStatistics::addRun(*net);
+                    }
+                    delete net;
+                    net = nullptr;
+                } else {
+                    break;
+                }
+                // flush warnings and prepare reinit of all outputs
+                MsgHandler::getWarningInstance()->clear();
+                OutputDevice::closeAll();
+                MsgHandler::cleanupOnEnd();
+            }
+            if (net == nullptr && state == MSNet::SIMSTATE_LOADING) {
+                // meta options (help, version) were processed
                 break;
             }
-            // flush warnings and prepare reinit of all outputs
-            MsgHandler::getWarningInstance()->clear();
-            OutputDevice::closeAll();
-            MsgHandler::cleanupOnEnd();
+        }
+        NLBuilder::clearNetCache();
+        if (ensembleOutput != "") {
+            MSEnsembleStatistics::write(ensembleOutput);
+            MSEnsembleStatistics::cleanup();
         }
     } catch (const ProcessError& e) {
         if (std::string(e.what()) != std::string("Process Error") && std::string(e.what()) != std::string("")) {
@@ -38,6 +38,8 @@
 #include <map>
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <thread>
 #include <foreign/tcpip/socket.h>
 #include <foreign/tcpip/storage.h>
 #include <utils/common/SUMOTime.h>
@@ -64,6 +66,7 @@
 #include <libsumo/Subscription.h>
 #include <libsumo/TraCIConstants.h>
 #include "TraCIServer.h"
+#include "TraCITrace.h"
 #include "TraCIServerAPI_InductionLoop.h"
 #include "TraCIServerAPI_Junction.h"
 #include "TraCIServerAPI_Lane.h"
@@ -230,7 +233,10 @@ TraCIServer::getWrapperStorage() {
 
 
 TraCIServer::TraCIServer(const SUMOTime begin, const int port, const int numClients)
-    : myTargetTime(begin), myLastContextSubscription(nullptr) {
+    : myTargetTime(begin), myInterleaveReads(numClients > 1 && OptionsCont::getOptions().getBool("traci-server.interleave-reads")),
+      myTrace(nullptr),
+      myLastContextSubscription(nullptr),
+      myLastSubscription(nullptr) {
 #ifdef DEBUG_MULTI_CLIENTS
     std::cout << "Creating new TraCIServer for " << numClients << " clients on port " << port << "." << std::endl;
 #endif
@@ -316,6 +322,17 @@ TraCIServer::TraCIServer(const SUMOTime begin, const int port, const int numClie
         MsgHandler::getWarningInstance()->inform("Use without option --no-internal-links to avoid unexpected behavior", false);
     }
 
+    const OptionsCont& oc = OptionsCont::getOptions();
+    if (oc.isSet("traci-server.replay")) {
+        myTrace = new TraCITrace(oc.getString("traci-server.replay"), false);
+        WRITE_MESSAGEF(TL("***Replaying TraCI trace '%' ***"), oc.getString("traci-server.replay"));
+        addClient(nullptr, begin);
+        myCurrentSocket = mySockets.begin();
+        return;
+    }
+    if (oc.isSet("traci-server.record")) {
+        myTrace = new TraCITrace(oc.getString("traci-server.record"), true);
+    }
     try {
         WRITE_MESSAGEF(TL("***Starting server on port % ***"), toString(port));
         tcpip::Socket serverSocket(port);
@@ -323,26 +340,7 @@ TraCIServer::TraCIServer(const SUMOTime begin, const int port, const int numClie
             WRITE_MESSAGEF(TL("  waiting for % clients..."), toString(numClients));
         }
         while ((int)mySockets.size() < numClients) {
-            int index = (int)mySockets.size() + libsumo::MAX_ORDER + 1;
-            mySockets[index] = new SocketInfo(serverSocket.accept(true), begin);
-            mySockets[index]->vehicleStateChanges[MSNet::VehicleState::BUILT] = std::vector<std::string>();
-            mySockets[index]->vehicleStateChanges[MSNet::VehicleState::DEPARTED] = std::vector<std::string>();
-            mySockets[index]->vehicleStateChanges[MSNet::VehicleState::STARTING_TELEPORT] = std::vector<std::string>();
-            mySockets[index]->vehicleStateChanges[MSNet::VehicleState::ENDING_TELEPORT] = std::vector<std::string>();
-            mySockets[index]->vehicleStateChanges[MSNet::VehicleState::ARRIVED] = std::vector<std::string>();
-            mySockets[index]->vehicleStateChanges[MSNet::VehicleState::NEWROUTE] = std::vector<std::string>();
-            mySockets[index]->vehicleStateChanges[MSNet::VehicleState::STARTING_PARKING] = std::vector<std::string>();
-            mySockets[index]->vehicleStateChanges[MSNet::VehicleState::MANEUVERING] = std::vector<std::string>();
-            mySockets[index]->vehicleStateChanges[MSNet::VehicleState::ENDING_PARKING] = std::vector<std::string>();
-            mySockets[index]->vehicleStateChanges[MSNet::VehicleState::STARTING_STOP] = std::vector<std::string>();
-            mySockets[index]->vehicleStateChanges[MSNet::VehicleState::ENDING_STOP] = std::vector<std::string>();
-            mySockets[index]->vehicleStateChanges[MSNet::VehicleState::COLLISION] = std::vector<std::string>();
-            mySockets[index]->vehicleStateChanges[MSNet::VehicleState::EMERGENCYSTOP] = std::vector<std::string>();
-
-            mySockets[index]->transportableStateChanges[MSNet::TransportableState::PERSON_DEPARTED] = std::vector<std::string>();
-            mySockets[index]->transportableStateChanges[MSNet::TransportableState::PERSON_ARRIVED] = std::vector<std::string>();
-            mySockets[index]->transportableStateChanges[MSNet::TransportableState::CONTAINER_DEPARTED] = std::vector<std::string>();
-            mySockets[index]->transportableStateChanges[MSNet::TransportableState::CONTAINER_ARRIVED] = std::vector<std::string>();
+            addClient(serverSocket.accept(true), begin);
             if (numClients > 1) {
                 WRITE_MESSAGE(TL("  client connected"));
             }
@@ -363,6 +361,10 @@ TraCIServer::~TraCIServer() {
     for (const auto& socket : mySockets) {
         delete socket.second;
     }
+    if (myTrace != nullptr) {
+        myTrace->report();
+        delete myTrace;
+    }
     // there is no point in calling cleanup() here, it does not free any pointers and will only modify members which get deleted anyway
 }
 
@@ -370,7 +372,7 @@ TraCIServer::~TraCIServer() {
 // ---------- Initialisation and Shutdown
 void
 TraCIServer::openSocket(const std::map<int, CmdExecutor>& execs) {
-    if (myInstance == nullptr && !myDoCloseConnection && (OptionsCont::getOptions().getInt("remote-port") != 0)) {
+    if (myInstance == nullptr && !myDoCloseConnection && (OptionsCont::getOptions().getInt("remote-port") != 0 || OptionsCont::getOptions().isSet("traci-server.replay"))) {
         myInstance = new TraCIServer(string2time(OptionsCont::getOptions().getString("begin")),
                                      OptionsCont::getOptions().getInt("remote-port"),
                                      OptionsCont::getOptions().getInt("num-clients"));
@@ -444,7 +446,7 @@ TraCIServer::checkClientOrdering() {
 //        bool clientUnordered = true;
         while (true) {
             myInputStorage.reset();
-            myCurrentSocket->second->socket->receiveExact(myInputStorage);
+            receive(myCurrentSocket->second, myInputStorage);
             int commandStart, commandLength;
             int commandId = readCommandID(commandStart, commandLength);
 #ifdef DEBUG_MULTI_CLIENTS
@@ -471,7 +473,7 @@ TraCIServer::checkClientOrdering() {
 
                 // Handle initialization command completely
                 dispatchCommand();
-                myCurrentSocket->second->socket->sendExact(myOutputStorage);
+                send(myCurrentSocket->second->socket, myOutputStorage);
                 myOutputStorage.reset();
             } else {
 #ifdef DEBUG_MULTI_CLIENTS
@@ -556,6 +558,86 @@ TraCIServer::nextTargetTime() const {
 }
 
 
+void
+TraCIServer::receiveRequest(const bool afterMove) {
+    SocketInfo* const current = myCurrentSocket->second;
+    if (current->pendingRequest.size() > 0) {
+        myInputStorage.writeStorage(current->pendingRequest);
+        current->pendingRequest.reset();
+        return;
+    }
+    if (myInterleaveReads) {
+        while (!current->socket->has_data()) {
+            if (!serveReadOnlyRequests(afterMove)) {
+                std::this_thread::sleep_for(std::chrono::microseconds(20));
+            }
+        }
+    }
+    receive(current, myInputStorage);
+}
+
+
+bool
+TraCIServer::serveReadOnlyRequests(const bool afterMove) {
+    // the input and output storages are empty while waiting for the next request of the current client
+    const std::map<int, SocketInfo*>::iterator current = myCurrentSocket;
+    bool served = false;
+    for (std::map<int, SocketInfo*>::iterator it = std::next(current); it != mySockets.end(); ++it) {
+        SocketInfo* const info = it->second;
+        if (info->targetTime > myTargetTime || (afterMove && !info->executeMove)
+                || info->pendingRequest.size() > 0 || !info->socket->has_data()) {
+            continue;
+        }
+        receive(info, info->pendingRequest);
+        if (!isReadOnlyRequest(info->pendingRequest)) {
+            // keep it until it is the client's turn
+            continue;
+        }
+        myInputStorage.writeStorage(info->pendingRequest);
+        info->pendingRequest.reset();
+        myCurrentSocket = it;
+        while (myInputStorage.valid_pos()) {
+            dispatchCommand();
+        }
+        send(info->socket, myOutputStorage);
+        myOutputStorage.reset();
+        myInputStorage.reset();
+        myCurrentSocket = current;
+        served = true;
+    }
+    return served;
+}
+
+
+bool
+TraCIServer::isReadOnlyRequest(const tcpip::Storage& request) {
+    tcpip::Storage::StorageType::const_iterator it = request.begin();
+    const tcpip::Storage::StorageType::const_iterator end = request.end();
+    while (it != end) {
+        // every command starts with its length (extended to four bytes if the first one is 0) and its id
+        int length = *it;
+        int offset = 1;
+        if (length == 0) {
+            if (end - it < 6) {
+                return false;
+            }
+            length = (*(it + 1) << 24) | (*(it + 2) << 16) | (*(it + 3) << 8) | *(it + 4);
+            offset = 5;
+        } else if (end - it < 2) {
+            return false;
+        }
+        const int commandId = *(it + offset);
+        const bool isGet = (commandId >= libsumo::CMD_GET_INDUCTIONLOOP_VARIABLE && commandId <= libsumo::CMD_GET_BUSSTOP_VARIABLE)
+                           || (commandId >= libsumo::CMD_GET_PARKINGAREA_VARIABLE && commandId <= libsumo::CMD_GET_OVERHEADWIRE_VARIABLE);
+        if (!isGet || length <= offset || end - it < length) {
+            return false;
+        }
+        it += length;
+    }
+    return true;
+}
+
+
 // send out subscription results to clients which will act in this step (i.e. with client target time <= myTargetTime)
 void
 TraCIServer::sendOutputToAll() const {
@@ -566,7 +648,7 @@ TraCIServer::sendOutputToAll() const {
     while (i != mySockets.end()) {
         if (i->second->targetTime <= MSNet::getInstance()->getCurrentTimeStep()) {
             // this client will become active before the next SUMO step. Provide subscription results.
-            i->second->socket->sendExact(myOutputStorage);
+            send(i->second->socket, myOutputStorage, &mySubscriptionCache);
 #ifdef DEBUG_MULTI_CLIENTS
             std::cout << i->second->socket << "\n";
 #endif
@@ -641,7 +723,7 @@ TraCIServer::processCommands(const SUMOTime step, const bool afterMove) {
                         // have read request completely, send response if adequate
                         if (myOutputStorage.size() > 0) {
                             // send response to previous query
-                            myCurrentSocket->second->socket->sendExact(myOutputStorage);
+                            send(myCurrentSocket->second->socket, myOutputStorage);
                             myOutputStorage.reset();
                         }
 #ifdef DEBUG_MULTI_CLIENTS
@@ -649,11 +731,19 @@ TraCIServer::processCommands(const SUMOTime step, const bool afterMove) {
 #endif
                         // Read next request
                         myInputStorage.reset();
-                        myCurrentSocket->second->socket->receiveExact(myInputStorage);
+                        receiveRequest(afterMove);
                     }
 
                     while (myInputStorage.valid_pos() && !myDoCloseConnection) {
-                        const int cmd = dispatchCommand();
+                        int cmd;
+                        if (isReplaying()) {
+                            const int commandId = TraCITrace::peekCommandID(myInputStorage);
+                            const auto start = std::chrono::steady_clock::now();
+                            cmd = dispatchCommand();
+                            myTrace->addCommandTime(commandId, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+                        } else {
+                            cmd = dispatchCommand();
+                        }
                         if (cmd == libsumo::CMD_SIMSTEP || cmd == libsumo::CMD_LOAD || cmd == libsumo::CMD_EXECUTEMOVE || cmd == libsumo::CMD_CLOSE) {
                             finalCmd = cmd;
                         }
@@ -702,6 +792,7 @@ TraCIServer::processCommands(const SUMOTime step, const bool afterMove) {
 void
 TraCIServer::cleanup() {
     mySubscriptions.clear();
+    myLastSubscription = nullptr;
     myTargetTime = string2time(OptionsCont::getOptions().getString("begin"));
     for (myCurrentSocket = mySockets.begin(); myCurrentSocket != mySockets.end(); ++myCurrentSocket) {
         myCurrentSocket->second->targetTime = myTargetTime;
@@ -732,6 +823,65 @@ TraCIServer::removeCurrentSocket() {
 }
 
 
+void
+TraCIServer::addClient(tcpip::Socket* socket, const SUMOTime begin) {
+    int index = (int)mySockets.size() + libsumo::MAX_ORDER + 1;
+    mySockets[index] = new SocketInfo(socket, begin);
+    mySockets[index]->vehicleStateChanges[MSNet::VehicleState::BUILT] = std::vector<std::string>();
+    mySockets[index]->vehicleStateChanges[MSNet::VehicleState::DEPARTED] = std::vector<std::string>();
+    mySockets[index]->vehicleStateChanges[MSNet::VehicleState::STARTING_TELEPORT] = std::vector<std::string>();
+    mySockets[index]->vehicleStateChanges[MSNet::VehicleState::ENDING_TELEPORT] = std::vector<std::string>();
+    mySockets[index]->vehicleStateChanges[MSNet::VehicleState::ARRIVED] = std::vector<std::string>();
+    mySockets[index]->vehicleStateChanges[MSNet::VehicleState::NEWROUTE] = std::vector<std::string>();
+    mySockets[index]->vehicleStateChanges[MSNet::VehicleState::STARTING_PARKING] = std::vector<std::string>();
+    mySockets[index]->vehicleStateChanges[MSNet::VehicleState::MANEUVERING] = std::vector<std::string>();
+    mySockets[index]->vehicleStateChanges[MSNet::VehicleState::ENDING_PARKING] = std::vector<std::string>();
+    mySockets[index]->vehicleStateChanges[MSNet::VehicleState::STARTING_STOP] = std::vector<std::string>();
+    mySockets[index]->vehicleStateChanges[MSNet::VehicleState::ENDING_STOP] = std::vector<std::string>();
+    mySockets[index]->vehicleStateChanges[MSNet::VehicleState::COLLISION] = std::vector<std::string>();
+    mySockets[index]->vehicleStateChanges[MSNet::VehicleState::EMERGENCYSTOP] = std::vector<std::string>();
+
+    mySockets[index]->transportableStateChanges[MSNet::TransportableState::PERSON_DEPARTED] = std::vector<std::string>();
+    mySockets[index]->transportableStateChanges[MSNet::TransportableState::PERSON_ARRIVED] = std::vector<std::string>();
+    mySockets[index]->transportableStateChanges[MSNet::TransportableState::CONTAINER_DEPARTED] = std::vector<std::string>();
+    mySockets[index]->transportableStateChanges[MSNet::TransportableState::CONTAINER_ARRIVED] = std::vector<std::string>();
+}
+
+
+void
+TraCIServer::receive(SocketInfo* info, tcpip::Storage& request) {
+    if (isReplaying()) {
+        if (!myTrace->read(request)) {
+            throw ProcessError(TL("The TraCI trace ended before the connection was closed."));
+        }
+        return;
+    }
+    info->socket->receiveExact(request);
+    if (myTrace != nullptr) {
+        myTrace->write(request);
+    }
+}
+
+
+void
+TraCIServer::send(tcpip::Socket* socket, const tcpip::Storage& head, const tcpip::Storage* const body) {
+    if (socket == nullptr) {
+        return;
+    }
+    if (body == nullptr) {
+        socket->sendExact(head);
+    } else {
+        socket->sendExact(head, *body);
+    }
+}
+
+
+bool
+TraCIServer::isReplaying() const {
+    return myTrace != nullptr && !myTrace->isRecording();
+}
+
+
 int
 TraCIServer::readCommandID(int& commandStart, int& commandLength) {
     commandStart = myInputStorage.position();
@@ -782,7 +932,7 @@ TraCIServer::dispatchCommand() {
                     writeStatusCmd(libsumo::CMD_LOAD, libsumo::RTYPE_OK, "");
                     // XXX: This only cares for the client that issued the load command.
                     // Multiclient-load functionality is still to be implemented. Refs #3146.
-                    myCurrentSocket->second->socket->sendExact(myOutputStorage);
+                    send(myCurrentSocket->second->socket, myOutputStorage);
                     myCurrentSocket = mySockets.end();
                     myOutputStorage.reset();
                 } catch (libsumo::TraCIException& e) {
@@ -828,7 +978,7 @@ TraCIServer::dispatchCommand() {
             }
             case libsumo::CMD_CLOSE:
                 writeStatusCmd(libsumo::CMD_CLOSE, libsumo::RTYPE_OK, "");
-                myCurrentSocket->second->socket->sendExact(myOutputStorage);
+                send(myCurrentSocket->second->socket, myOutputStorage);
                 myOutputStorage.reset();
                 if (mySockets.size() == 1) {
                     // Last client has closed connection
@@ -856,6 +1006,29 @@ TraCIServer::dispatchCommand() {
                 writeStatusCmd(libsumo::CMD_SETORDER, libsumo::RTYPE_OK, "");
                 break;
             }
+            case libsumo::CMD_SHARED_MEMORY: {
+                const std::string name = myInputStorage.readString();
+                const int capacity = myInputStorage.readInt();
+                tcpip::Socket* const socket = myCurrentSocket->second->socket;
+                if (socket == nullptr) {
+                    // replaying a trace, there is no client to share the memory with
+                    writeStatusCmd(libsumo::CMD_SHARED_MEMORY, libsumo::RTYPE_OK, "");
+                    success = true;
+                    break;
+                }
+                try {
+                    socket->mapSharedMemory(name, capacity, false);
+                } catch (tcpip::SocketException& e) {
+                    return writeErrorStatusCmd(libsumo::CMD_SHARED_MEMORY, e.what(), myOutputStorage);
+                }
+                // the acknowledgement still goes via TCP, everything afterwards (including subscription results) via the ring buffers
+                writeStatusCmd(libsumo::CMD_SHARED_MEMORY, libsumo::RTYPE_OK, "");
+                socket->sendExact(myOutputStorage);
+                myOutputStorage.reset();
+                socket->useSharedMemory();
+                success = true;
+                break;
+            }
             case libsumo::CMD_SUBSCRIBE_BUSSTOP_VARIABLE:
             case libsumo::CMD_SUBSCRIBE_CALIBRATOR_VARIABLE:
             case libsumo::CMD_SUBSCRIBE_CHARGINGSTATION_VARIABLE:
@@ -962,6 +1135,8 @@ TraCIServer::postProcessSimulationStep() {
     std::cout << "   postProcessSimulationStep() at time=" << t << std::endl;
 #endif
     writeStatusCmd(libsumo::CMD_SIMSTEP, libsumo::RTYPE_OK, "");
+    // subscriptions may be removed below
+    myLastSubscription = nullptr;
     int noActive = 0;
     for (std::vector<libsumo::Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end();) {
         const libsumo::Subscription& s = *i;
@@ -988,13 +1163,15 @@ TraCIServer::postProcessSimulationStep() {
 #ifdef DEBUG_SUBSCRIPTIONS
     std::cout << "   Size after writing an int is " << mySubscriptionCache.size() << std::endl;
 #endif
+    libsumo::Helper::useVehicleGrid(true);
+    tcpip::Storage into;
     for (std::vector<libsumo::Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end();) {
-        const libsumo::Subscription& s = *i;
+        libsumo::Subscription& s = *i;
         if (s.beginTime > t) {
             ++i;
             continue;
         }
-        tcpip::Storage into;
+        into.reset();
         std::string errors;
         bool ok = processSingleSubscription(s, into, errors);
 #ifdef DEBUG_SUBSCRIPTIONS
@@ -1008,7 +1185,8 @@ TraCIServer::postProcessSimulationStep() {
             i = mySubscriptions.erase(i);
         }
     }
-    myOutputStorage.writeStorage(mySubscriptionCache);
+    libsumo::Helper::useVehicleGrid(false);
+    // the cache is sent after myOutputStorage by sendOutputToAll without copying it
 #ifdef DEBUG_SUBSCRIPTIONS
     std::cout << "   Size after writing subscriptions is " << mySubscriptionCache.size() << std::endl;
 #endif
@@ -1029,9 +1207,8 @@ TraCIServer::sendSingleSimStepResponse() {
 //    myOutputStorage.writeInt(0);
 //    myCurrentSocket->second->socket->sendExact(myOutputStorage);
 //    myOutputStorage.reset();
-    myOutputStorage.writeStorage(mySubscriptionCache);
     // send results to active client
-    myCurrentSocket->second->socket->sendExact(myOutputStorage);
+    send(myCurrentSocket->second->socket, myOutputStorage, &mySubscriptionCache);
     myOutputStorage.reset();
 }
 
@@ -1080,9 +1257,7 @@ TraCIServer::initialiseSubscription(libsumo::Subscription& s) {
                         int noActive = 1 + (mySubscriptionCache.size() > 0 ? mySubscriptionCache.readInt() : 0);
                         tcpip::Storage tmp;
                         tmp.writeInt(noActive);
-                        while (mySubscriptionCache.valid_pos()) {
-                            tmp.writeByte(mySubscriptionCache.readByte());
-                        }
+                        tmp.writeStorage(mySubscriptionCache);
                         tmp.writeStorage(writeInto);
                         mySubscriptionCache.reset();
                         mySubscriptionCache.writeStorage(tmp);
@@ -1090,6 +1265,11 @@ TraCIServer::initialiseSubscription(libsumo::Subscription& s) {
                 }
                 writeStatusCmd(s.commandId, libsumo::RTYPE_OK, "");
             }
+            if (modifiedSubscription != nullptr) {
+                // the variables may have changed, so everything is sent again in delta mode
+                modifiedSubscription->lastValues.clear();
+            }
+            myLastSubscription = modifiedSubscription;
             if (modifiedSubscription != nullptr && (
                         modifiedSubscription->isVehicleToVehicleContextSubscription()
                         || modifiedSubscription->isVehicleToPersonContextSubscription())) {
@@ -1116,6 +1296,7 @@ TraCIServer::removeSubscription(int commandId, const std::string& id, int domain
     for (j = mySubscriptions.begin(); j != mySubscriptions.end();) {
         if (j->id == id && j->commandId == commandId && j->contextDomain == domain) {
             j = mySubscriptions.erase(j);
+            myLastSubscription = nullptr;
             if (j != mySubscriptions.end() && myLastContextSubscription == &(*j)) {
                 // Remove also reference for filter additions
                 myLastContextSubscription = nullptr;
@@ -1135,7 +1316,7 @@ TraCIServer::removeSubscription(int commandId, const std::string& id, int domain
 
 
 bool
-TraCIServer::processSingleSubscription(const libsumo::Subscription& s, tcpip::Storage& writeInto,
+TraCIServer::processSingleSubscription(libsumo::Subscription& s, tcpip::Storage& writeInto,
                                        std::string& errors) {
     bool ok = true;
     tcpip::Storage outputStorage;
@@ -1152,7 +1333,14 @@ TraCIServer::processSingleSubscription(const libsumo::Subscription& s, tcpip::St
         objIDs.insert(s.id);
     }
     const int numVars = s.contextDomain > 0 && s.variables.size() == 1 && s.variables[0] == libsumo::TRACI_ID_LIST ? 0 : (int)s.variables.size();
+    const bool delta = s.deltaMode && s.contextDomain == 0;
+    if (delta) {
+        s.lastValues.resize(numVars);
+    }
+    int numSent = 0;
     int skipped = 0;
+    // the executor is the same for all objects and variables of the subscription
+    const auto executor = myExecutors.find(getCommandId);
     for (std::set<std::string>::iterator j = objIDs.begin(); j != objIDs.end(); ++j) {
         if (s.contextDomain > 0) {
             //if (centralObject(s, *j)) {
@@ -1163,7 +1351,10 @@ TraCIServer::processSingleSubscription(const libsumo::Subscription& s, tcpip::St
         }
         if (numVars > 0) {
             std::vector<std::shared_ptr<tcpip::Storage> >::const_iterator k = s.parameters.begin();
-            for (std::vector<int>::const_iterator i = s.variables.begin(); i != s.variables.end(); ++i, ++k) {
+            int varIndex = 0;
+            for (std::vector<int>::const_iterator i = s.variables.begin(); i != s.variables.end(); ++i, ++k, ++varIndex) {
+                tcpip::Storage varStorage;
+                tcpip::Storage& varOutput = delta ? varStorage : outputStorage;
                 tcpip::Storage message;
                 message.writeUnsignedByte(*i);
                 message.writeString(*j);
@@ -1172,8 +1363,8 @@ TraCIServer::processSingleSubscription(const libsumo::Subscription& s, tcpip::St
                     message.writeChar(v);
                 }
                 tcpip::Storage tmpOutput;
-                if (myExecutors.find(getCommandId) != myExecutors.end()) {
-                    ok &= myExecutors[getCommandId](*this, message, tmpOutput);
+                if (executor != myExecutors.end()) {
+                    ok &= executor->second(*this, message, tmpOutput);
                 } else {
                     writeStatusCmd(s.commandId, libsumo::RTYPE_NOTIMPLEMENTED, "Unsupported command specified", tmpOutput);
                     ok = false;
@@ -1184,22 +1375,19 @@ TraCIServer::processSingleSubscription(const libsumo::Subscription& s, tcpip::St
                     while (--length > 0) {
                         tmpOutput.readUnsignedByte();
                     }
-                    int lengthLength = 1;
-                    length = tmpOutput.readUnsignedByte();
-                    if (length == 0) {
-                        lengthLength = 5;
-                        length = tmpOutput.readInt();
+                    if (tmpOutput.readUnsignedByte() == 0) {
+                        // extended length
+                        tmpOutput.readInt();
                     }
                     //read responseType
                     tmpOutput.readUnsignedByte();
-                    int variable = tmpOutput.readUnsignedByte();
-                    std::string id = tmpOutput.readString();
-                    outputStorage.writeUnsignedByte(variable);
-                    outputStorage.writeUnsignedByte(libsumo::RTYPE_OK);
-                    length -= (lengthLength + 1 + 4 + (int)id.length());
-                    while (--length > 0) {
-                        outputStorage.writeUnsignedByte(tmpOutput.readUnsignedByte());
-                    }
+                    const int variable = tmpOutput.readUnsignedByte();
+                    // object id
+                    tmpOutput.readString();
+                    varOutput.writeUnsignedByte(variable);
+                    varOutput.writeUnsignedByte(libsumo::RTYPE_OK);
+                    // the value is the remainder of the response
+                    varOutput.writeStorage(tmpOutput);
                 } else {
                     //read length
                     tmpOutput.readUnsignedByte();
@@ -1208,12 +1396,22 @@ TraCIServer::processSingleSubscription(const libsumo::Subscription& s, tcpip::St
                     //read status
                     tmpOutput.readUnsignedByte();
                     std::string msg = tmpOutput.readString();
-                    outputStorage.writeUnsignedByte(*i);
-                    outputStorage.writeUnsignedByte(libsumo::RTYPE_ERR);
-                    outputStorage.writeUnsignedByte(libsumo::TYPE_STRING);
-                    outputStorage.writeString(msg);
+                    varOutput.writeUnsignedByte(*i);
+                    varOutput.writeUnsignedByte(libsumo::RTYPE_ERR);
+                    varOutput.writeUnsignedByte(libsumo::TYPE_STRING);
+                    varOutput.writeString(msg);
                     errors = errors + msg;
                 }
+                if (delta) {
+                    const std::string value(varStorage.begin(), varStorage.end());
+                    if (!ok || value != s.lastValues[varIndex]) {
+                        for (const unsigned char c : value) {
+                            outputStorage.writeUnsignedByte(c);
+                        }
+                        s.lastValues[varIndex] = ok ? value : "";
+                        numSent++;
+                    }
+                }
             }
         }
     }
@@ -1229,7 +1427,7 @@ TraCIServer::processSingleSubscription(const libsumo::Subscription& s, tcpip::St
     if (s.contextDomain > 0) {
         writeInto.writeUnsignedByte(s.contextDomain);
     }
-    writeInto.writeUnsignedByte(numVars);
+    writeInto.writeUnsignedByte(delta ? numSent : numVars);
     if (s.contextDomain > 0) {
         writeInto.writeInt((int)objIDs.size() - skipped);
     }
@@ -1290,6 +1488,17 @@ TraCIServer::addSubscriptionFilter() {
     // Read filter type
     int filterType = myInputStorage.readUnsignedByte();
 
+    if (filterType == libsumo::FILTER_TYPE_DELTA) {
+        if (myLastSubscription == nullptr || myLastSubscription->contextDomain > 0) {
+            writeStatusCmd(libsumo::CMD_ADD_SUBSCRIPTION_FILTER, libsumo::RTYPE_ERR,
+                           "No previous variable subscription exists to switch to delta mode");
+            return false;
+        }
+        myLastSubscription->deltaMode = true;
+        writeStatusCmd(libsumo::CMD_ADD_SUBSCRIPTION_FILTER, libsumo::RTYPE_OK, "");
+        return true;
+    }
+
     if (myLastContextSubscription == nullptr) {
         writeStatusCmd(libsumo::CMD_ADD_SUBSCRIPTION_FILTER, libsumo::RTYPE_ERR,
                        "No previous vehicle context subscription exists to apply filter type " + toHex(filterType, 2));
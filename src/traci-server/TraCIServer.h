@@ -50,6 +50,12 @@
 #include "TraCIServerAPI_Lane.h"
 
 
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class TraCITrace;
+
+
 // ===========================================================================
 // class definitions
 // ===========================================================================
@@ -307,6 +313,8 @@ private:
         std::map<MSNet::VehicleState, std::vector<std::string> > vehicleStateChanges;
         /// @brief container for transportable state changes since last step taken by this client
         std::map<MSNet::TransportableState, std::vector<std::string> > transportableStateChanges;
+        /// @brief a request received ahead of the client's turn which was not read-only
+        tcpip::Storage pendingRequest;
     private:
         SocketInfo(const SocketInfo&);
     };
@@ -343,7 +351,7 @@ private:
     /// @brief get the minimal next target time among all clients
     SUMOTime nextTargetTime() const;
 
-    /// @brief send out subscription results (actually just the content of myOutputStorage) to clients which will act in this step (i.e. with client target time <= myTargetTime)
+    /// @brief send out subscription results (the content of myOutputStorage followed by mySubscriptionCache) to clients which will act in this step (i.e. with client target time <= myTargetTime)
     void sendOutputToAll() const;
 
     /// @brief sends an empty response to a simstep command to the current client. (This applies to a situation where the TraCI step frequency is higher than the SUMO step frequency)
@@ -352,6 +360,37 @@ private:
     /// @brief removes myCurrentSocket from mySockets and returns an iterator pointing to the next member according to the ordering
     std::map<int, SocketInfo*>::iterator removeCurrentSocket();
 
+    /** @brief receives the next request of the current client into myInputStorage
+     *
+     * With interleaved reads the read-only requests of the clients which are
+     *  served later in this step are answered while waiting for the request.
+     * @param[in] afterMove Whether only the clients which did a half step are served
+     */
+    void receiveRequest(const bool afterMove);
+
+    /// @brief answers the available read-only requests of the clients following the current one, returns whether there were any
+    bool serveReadOnlyRequests(const bool afterMove);
+
+    /// @brief whether the request consists of get commands only
+    static bool isReadOnlyRequest(const tcpip::Storage& request);
+
+    /// @brief adds a client with the given socket (nullptr when replaying a trace)
+    void addClient(tcpip::Socket* socket, const SUMOTime begin);
+
+    /** @brief receives the next request of the given client
+     *
+     * When replaying, the request is read from the trace instead.
+     * When recording, the received request is appended to the trace.
+     * @exception ProcessError If the replayed trace has no more requests
+     */
+    void receive(SocketInfo* info, tcpip::Storage& request);
+
+    /// @brief sends the given storages to the client (responses are discarded when replaying a trace)
+    static void send(tcpip::Socket* socket, const tcpip::Storage& head, const tcpip::Storage* const body = nullptr);
+
+    /// @brief whether the requests are read from a trace instead of a client
+    bool isReplaying() const;
+
 
 private:
     /// @brief Singleton instance of the server
@@ -373,6 +412,12 @@ private:
     /// @brief The time step to reach until processing the next commands
     SUMOTime myTargetTime;
 
+    /// @brief Whether read-only requests of later clients are answered while waiting for the current one
+    const bool myInterleaveReads;
+
+    /// @brief The trace the requests are recorded to or replayed from (if any)
+    TraCITrace* myTrace;
+
     /// @brief The storage to read from
     tcpip::Storage myInputStorage;
 
@@ -399,6 +444,9 @@ private:
     /// @brief The last modified context subscription (the one to add a filter to, see @addSubscriptionFilter(), currently only for vehicle to vehicle context)
     libsumo::Subscription* myLastContextSubscription;
 
+    /// @brief The last modified subscription of any kind in the current step (the one to switch to delta mode)
+    libsumo::Subscription* myLastSubscription;
+
     /// @brief Changes in the states of simulated vehicles
     /// @note
     /// Server cache myVehicleStateChanges is used for managing last steps subscription updates
@@ -421,7 +469,7 @@ private:
     bool addObjectVariableSubscription(const int commandId, const bool hasContext);
     void initialiseSubscription(libsumo::Subscription& s);
     void removeSubscription(int commandId, const std::string& identity, int domain);
-    bool processSingleSubscription(const libsumo::Subscription& s, tcpip::Storage& writeInto,
+    bool processSingleSubscription(libsumo::Subscription& s, tcpip::Storage& writeInto,
                                    std::string& errors);
 
 
@@ -0,0 +1,157 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    TraCITrace.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Records the TraCI requests of a client and replays them without a client
+/****************************************************************************/
+#include <config.h>
+
+#include <vector>
+#include <utils/common/MsgHandler.h>
+#include <utils/common/StdDefs.h>
+#include <utils/common/ToString.h>
+#include <utils/common/UtilExceptions.h>
+#include "TraCITrace.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const std::string TraCITrace::MAGIC = "SUMO-traci-trace-1";
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+TraCITrace::TraCITrace(const std::string& file, const bool record) :
+    myAmRecording(record),
+    myAmStarted(false),
+    myLastRecordedTime(0.),
+    myNumRequests(0) {
+    if (myAmRecording) {
+        myOutput.open(file.c_str(), std::ios::binary);
+        if (!myOutput.good()) {
+            throw ProcessError(TLF("Could not open TraCI trace '%' for writing.", file));
+        }
+        myOutput << MAGIC << "\n";
+    } else {
+        myInput.open(file.c_str(), std::ios::binary);
+        std::string magic;
+        if (!myInput.good() || !std::getline(myInput, magic) || magic != MAGIC) {
+            throw ProcessError(TLF("File '%' is no TraCI trace.", file));
+        }
+    }
+}
+
+
+void
+TraCITrace::write(const tcpip::Storage& request) {
+    if (!myAmStarted) {
+        myStart = std::chrono::steady_clock::now();
+        myAmStarted = true;
+    }
+    const double time = getElapsed();
+    const int size = (int)request.size();
+    const std::vector<unsigned char> bytes(request.begin(), request.end());
+    myOutput.write((const char*)&time, sizeof(double));
+    myOutput.write((const char*)&size, sizeof(int));
+    myOutput.write((const char*)bytes.data(), size);
+    myOutput.flush();
+    myNumRequests++;
+}
+
+
+bool
+TraCITrace::read(tcpip::Storage& request) {
+    double time;
+    int size;
+    if (!myInput.read((char*)&time, sizeof(double)) || !myInput.read((char*)&size, sizeof(int)) || size < 0) {
+        return false;
+    }
+    std::vector<unsigned char> bytes(size);
+    if (!myInput.read((char*)bytes.data(), size)) {
+        return false;
+    }
+    if (!myAmStarted) {
+        myStart = std::chrono::steady_clock::now();
+        myAmStarted = true;
+    }
+    request.reset();
+    request.writePacket(bytes);
+    myLastRecordedTime = time;
+    myNumRequests++;
+    return true;
+}
+
+
+void
+TraCITrace::addCommandTime(const int commandId, const double seconds) {
+    myCommandTimes[commandId].add(seconds);
+}
+
+
+void
+TraCITrace::report() const {
+    if (myAmRecording) {
+        WRITE_MESSAGEF(TL("Recorded % TraCI requests."), toString(myNumRequests));
+        return;
+    }
+    double commandTime = 0.;
+    int numCommands = 0;
+    for (const auto& item : myCommandTimes) {
+        commandTime += item.second.getMean() * item.second.size();
+        numCommands += item.second.size();
+    }
+    const double replayTime = getElapsed();
+    WRITE_MESSAGEF(TL("Replayed % TraCI requests with % commands."), toString(myNumRequests), toString(numCommands));
+    WRITE_MESSAGEF(TL(" Recorded duration: %s"), toString(myLastRecordedTime));
+    WRITE_MESSAGEF(TL(" Replay duration: %s (commands: %s, simulation: %s)"), toString(replayTime), toString(commandTime), toString(replayTime - commandTime));
+    WRITE_MESSAGEF(TL(" Client and communication (estimated): %s"), toString(MAX2(0., myLastRecordedTime - replayTime)));
+    WRITE_MESSAGE(TL(" Command times in ms (count, mean, median, q95, max):"));
+    for (const auto& item : myCommandTimes) {
+        const SampleStatistics& s = item.second;
+        WRITE_MESSAGEF("  %: %, %, %, %, %", toHex(item.first, 2), toString(s.size()),
+                       toString(s.getMean() * 1000.), toString(s.getQuantile(0.5) * 1000.),
+                       toString(s.getQuantile(0.95) * 1000.), toString(s.getQuantile(1.) * 1000.));
+    }
+}
+
+
+int
+TraCITrace::peekCommandID(const tcpip::Storage& request) {
+    // every command starts with its length (extended to four bytes if the first one is 0) and its id
+    const tcpip::Storage::StorageType::const_iterator it = request.begin() + request.position();
+    if (it == request.end()) {
+        return -1;
+    }
+    const int offset = *it == 0 ? 5 : 1;
+    if (request.end() - it <= offset) {
+        return -1;
+    }
+    return *(it + offset);
+}
+
+
+double
+TraCITrace::getElapsed() const {
+    if (!myAmStarted) {
+        return 0.;
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - myStart).count();
+}
+
+
+/****************************************************************************/
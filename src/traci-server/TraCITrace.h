@@ -0,0 +1,125 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    TraCITrace.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Records the TraCI requests of a client and replays them without a client
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <string>
+#include <foreign/tcpip/storage.h>
+#include <utils/common/SampleStatistics.h>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class TraCITrace
+ * @brief A file of recorded TraCI requests
+ *
+ * When recording, each request received by the server is appended together
+ *  with the wall clock time since the first request. When replaying, the
+ *  requests are read in the same order instead of being received from a
+ *  socket and the processing time of each command is collected. The report
+ *  compares the recorded session duration with the server time of the replay
+ *  which shows how much of the original run was spent on the client side
+ *  (including the communication).
+ *
+ * File layout (native byte order): the magic line TraCITrace::MAGIC,
+ *  then per request a double (seconds since the first request), an int
+ *  (the number of bytes) and the bytes of the request as given to the
+ *  command dispatcher.
+ */
+class TraCITrace {
+public:
+    /// @brief the first line of the file
+    static const std::string MAGIC;
+
+    /** @brief Constructor
+     * @param[in] file The file to write to or to read from
+     * @param[in] record Whether requests are recorded (else they are replayed)
+     * @exception ProcessError If the file cannot be opened or is no trace
+     */
+    TraCITrace(const std::string& file, const bool record);
+
+    /// @brief Destructor
+    ~TraCITrace() { }
+
+    /// @brief whether requests are recorded
+    bool isRecording() const {
+        return myAmRecording;
+    }
+
+    /// @brief appends the given request
+    void write(const tcpip::Storage& request);
+
+    /** @brief reads the next request
+     * @param[out] request The storage to fill
+     * @return Whether there was another request
+     */
+    bool read(tcpip::Storage& request);
+
+    /** @brief adds the processing time of a replayed command
+     * @param[in] commandId The command id
+     * @param[in] seconds The time the server needed to process the command
+     */
+    void addCommandTime(const int commandId, const double seconds);
+
+    /// @brief writes the processing time statistics of the replay
+    void report() const;
+
+    /// @brief the id of the command at the current read position of the given request
+    static int peekCommandID(const tcpip::Storage& request);
+
+private:
+    /// @brief the seconds since the first request
+    double getElapsed() const;
+
+private:
+    /// @brief whether requests are recorded
+    const bool myAmRecording;
+
+    /// @brief the file to write to
+    std::ofstream myOutput;
+
+    /// @brief the file to read from
+    std::ifstream myInput;
+
+    /// @brief the time of the first request, whether it was seen
+    std::chrono::steady_clock::time_point myStart;
+    bool myAmStarted;
+
+    /// @brief the recorded time of the last replayed request
+    double myLastRecordedTime;
+
+    /// @brief the number of replayed requests
+    int myNumRequests;
+
+    /// @brief the processing times of the replayed commands by command id
+    std::map<int, SampleStatistics> myCommandTimes;
+
+private:
+    /// @brief Invalidated copy constructor.
+    TraCITrace(const TraCITrace&) = delete;
+
+    /// @brief Invalidated assignment operator.
+    TraCITrace& operator=(const TraCITrace&) = delete;
+};
@@ -0,0 +1,128 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    HistogramStatistics.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Streaming histogram with mean and approximate quantiles
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class HistogramStatistics
+ * @brief Counts values in bins of a fixed width
+ *
+ * In contrast to SampleStatistics the values are not kept, so the memory
+ *  only depends on the number of occupied bins and large samples (e.g. one
+ *  value per trip) can be aggregated. Count, mean, minimum and maximum are
+ *  exact, the quantiles interpolate linearly within their bin.
+ */
+class HistogramStatistics {
+public:
+    /** @brief Constructor
+     * @param[in] binWidth The width of the bins (bin i covers [i * binWidth, (i + 1) * binWidth))
+     */
+    HistogramStatistics(const double binWidth) :
+        myBinWidth(binWidth > 0. ? binWidth : 1.), myCount(0), mySum(0.), myMin(0.), myMax(0.) {}
+
+    /// @brief adds a value to the histogram
+    void add(const double value) {
+        myBins[(long long)std::floor(value / myBinWidth)]++;
+        myMin = myCount == 0 ? value : std::min(myMin, value);
+        myMax = myCount == 0 ? value : std::max(myMax, value);
+        mySum += value;
+        myCount++;
+    }
+
+    /// @brief the number of values
+    long long size() const {
+        return myCount;
+    }
+
+    /// @brief the arithmetic mean (0 for an empty histogram)
+    double getMean() const {
+        return myCount == 0 ? 0. : mySum / (double)myCount;
+    }
+
+    /// @brief the smallest value (0 for an empty histogram)
+    double getMin() const {
+        return myMin;
+    }
+
+    /// @brief the largest value (0 for an empty histogram)
+    double getMax() const {
+        return myMax;
+    }
+
+    /// @brief the width of the bins
+    double getBinWidth() const {
+        return myBinWidth;
+    }
+
+    /// @brief the number of values per occupied bin index
+    const std::map<long long, long long>& getBins() const {
+        return myBins;
+    }
+
+    /** @brief the quantile interpolated within the bin containing it
+     * @param[in] p The probability in [0, 1] (0 gives the minimum, 1 the maximum)
+     * @return The quantile (0 for an empty histogram)
+     */
+    double getQuantile(const double p) const {
+        if (myCount == 0 || p <= 0.) {
+            return myMin;
+        }
+        if (p >= 1.) {
+            return myMax;
+        }
+        const double target = p * (double)myCount;
+        double seen = 0.;
+        for (const auto& bin : myBins) {
+            if (seen + (double)bin.second >= target) {
+                const double value = ((double)bin.first + (target - seen) / (double)bin.second) * myBinWidth;
+                return std::max(myMin, std::min(myMax, value));
+            }
+            seen += (double)bin.second;
+        }
+        return myMax;
+    }
+
+private:
+    /// @brief the width of the bins
+    const double myBinWidth;
+
+    /// @brief the number of values per occupied bin
+    std::map<long long, long long> myBins;
+
+    /// @brief the number of values
+    long long myCount;
+
+    /// @brief the sum of the values
+    double mySum;
+
+    /// @brief the smallest value
+    double myMin;
+
+    /// @brief the largest value
+    double myMax;
+};
@@ -0,0 +1,77 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MemoryPool.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Size class based recycling of memory for frequently created objects
+/****************************************************************************/
+#include <config.h>
+
+#include <new>
+#include "MemoryPool.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+MemoryPool::FreeBlock* MemoryPool::myFreeLists[MemoryPool::MAX_SIZE / MemoryPool::GRANULARITY] = {};
+std::mutex MemoryPool::myMutex;
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+void*
+MemoryPool::allocate(const std::size_t size) {
+    if (size == 0 || size > MAX_SIZE) {
+        return ::operator new(size);
+    }
+    const std::size_t sizeClass = (size - 1) / GRANULARITY;
+    std::lock_guard<std::mutex> lock(myMutex);
+    FreeBlock*& freeList = myFreeLists[sizeClass];
+    if (freeList == nullptr) {
+        // carve a new chunk into free blocks (in ascending order of their address)
+        const std::size_t blockSize = (sizeClass + 1) * GRANULARITY;
+        char* const chunk = static_cast<char*>(::operator new(blockSize * OBJECTS_PER_CHUNK));
+        for (std::size_t i = OBJECTS_PER_CHUNK; i > 0; i--) {
+            FreeBlock* const block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * blockSize);
+            block->next = freeList;
+            freeList = block;
+        }
+    }
+    FreeBlock* const result = freeList;
+    freeList = result->next;
+    return result;
+}
+
+
+void
+MemoryPool::deallocate(void* p, const std::size_t size) {
+    if (p == nullptr) {
+        return;
+    }
+    if (size == 0 || size > MAX_SIZE) {
+        ::operator delete(p);
+        return;
+    }
+    FreeBlock* const block = static_cast<FreeBlock*>(p);
+    std::lock_guard<std::mutex> lock(myMutex);
+    FreeBlock*& freeList = myFreeLists[(size - 1) / GRANULARITY];
+    block->next = freeList;
+    freeList = block;
+}
+
+
+/****************************************************************************/
@@ -0,0 +1,78 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MemoryPool.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Size class based recycling of memory for frequently created objects
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MemoryPool
+ * @brief Recycles the memory of short living objects of the same size
+ *
+ * The memory is taken from larger chunks (which keeps objects created one
+ *  after another close to each other) and returned to a free list of its
+ *  size class on deallocation. The chunks are never released, so a
+ *  simulation with a steady number of vehicles reaches a steady memory
+ *  footprint. Classes use it by declaring
+ *  @code
+ *  static void* operator new(std::size_t size) { return MemoryPool::allocate(size); }
+ *  static void operator delete(void* p, std::size_t size) { MemoryPool::deallocate(p, size); }
+ *  @endcode
+ *  Larger sizes are passed through to the global allocator.
+ */
+class MemoryPool {
+public:
+    /// @brief returns memory for an object of the given size
+    static void* allocate(const std::size_t size);
+
+    /// @brief recycles the memory of an object of the given size
+    static void deallocate(void* p, const std::size_t size);
+
+private:
+    /// @brief the granularity of the size classes (and the alignment of the objects)
+    static constexpr std::size_t GRANULARITY = 16;
+
+    /// @brief the largest pooled object size
+    static constexpr std::size_t MAX_SIZE = 4096;
+
+    /// @brief the number of objects per chunk
+    static constexpr std::size_t OBJECTS_PER_CHUNK = 64;
+
+    /// @brief a recycled block (stores the pointer to the next free one)
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    /// @brief the free lists for all size classes
+    static FreeBlock* myFreeLists[MAX_SIZE / GRANULARITY];
+
+    /// @brief the mutex for all free lists (objects may be created in parallel loading)
+    static std::mutex myMutex;
+
+private:
+    /// @brief Invalidated constructor.
+    MemoryPool() = delete;
+};
@@ -152,6 +152,12 @@ MsgHandler::insertLineBreaks(std::string msg, int lineWidth) {
 
 void
 MsgHandler::inform(std::string msg, bool addType) {
+    write(msg, build(msg, addType), addType);
+}
+
+
+void
+MsgHandler::write(const std::string& msg, const std::string& built, bool addType) {
     if (addType && !myInitialMessages.empty() && myInitialMessages.size() < 5) {
         myInitialMessages.push_back(msg);
     }
@@ -160,10 +166,9 @@ MsgHandler::inform(std::string msg, bool addType) {
         myAmProcessingProcess = false;
         MsgHandler::getMessageInstance()->inform("");
     }
-    msg = build(msg, addType);
     // inform all receivers
     for (auto i : myRetrievers) {
-        i->inform(msg);
+        i->inform(built);
     }
     // set the information that something occurred
     myWasInformed = true;
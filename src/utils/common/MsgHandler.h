@@ -208,6 +208,18 @@ protected:
         return myAggregationThreshold >= 0 && myAggregationCount[format]++ >= myAggregationThreshold;
     }
 
+    /// @brief whether messages of the same type are counted (the threshold is only set on initialization)
+    bool isAggregating() const {
+        return myAggregationThreshold >= 0;
+    }
+
+    /** @brief passes an already built message to the retrievers
+     * @param[in] msg The message as given to inform
+     * @param[in] built The message including the prefixes (see build)
+     * @param[in] addType Whether the type prefix was added
+     */
+    void write(const std::string& msg, const std::string& built, bool addType);
+
     void setAggregationThreshold(const int thresh) {
         myAggregationThreshold = thresh;
     }
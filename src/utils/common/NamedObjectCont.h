@@ -25,6 +25,7 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include "StringHashIndex.h"
 
 
 // ===========================================================================
@@ -35,7 +36,7 @@
  * @brief A map of named object pointers
  *
  * An associative storage (map) for objects (pointers to them to be exact),
- *  which do have a name.
+ *  which do have a name. The iteration is ordered by name, lookups use a hash index.
  */
 template<class T>
 class NamedObjectCont {
@@ -46,6 +47,13 @@ public:
     ///@brief Constructor
     NamedObjectCont() {}
 
+    ///@brief Copy constructor (rebuilds the index for the copied map)
+    NamedObjectCont(const NamedObjectCont& other) : myMap(other.myMap) {
+        for (auto it = myMap.begin(); it != myMap.end(); ++it) {
+            myIndex.insert(it);
+        }
+    }
+
     ///@brief Destructor
     virtual ~NamedObjectCont() {
         // iterate over all elements to delete it
@@ -64,12 +72,12 @@ public:
      * @return If the item could be added (no item with the same id was within the container before)
      */
     bool add(const std::string& id, T item) {
-        const auto it = myMap.lower_bound(id);
-        if (it == myMap.end() || it->first != id) {
-            myMap.emplace_hint(it, id, item);
-            return true;
+        typename IDMap::iterator it;
+        if (myIndex.find(id, it)) {
+            return false;
         }
-        return false;
+        myIndex.insert(myMap.emplace(id, item).first);
+        return true;
     }
 
     /** @brief Removes an item
@@ -78,13 +86,14 @@ public:
      * @return If the item could be removed (an item with the id was within the container before)
      */
     bool remove(const std::string& id, const bool del = true) {
-        auto it = myMap.find(id);
-        if (it == myMap.end()) {
+        typename IDMap::iterator it;
+        if (!myIndex.find(id, it)) {
             return false;
         } else {
             if (del) {
                 delete it->second;
             }
+            myIndex.erase(id);
             myMap.erase(it);
             return true;
         }
@@ -98,8 +107,8 @@ public:
      * @return The item stored under the given id, or 0 if no such item exists
      */
     T get(const std::string& id) const {
-        auto it = myMap.find(id);
-        if (it == myMap.end()) {
+        typename IDMap::iterator it;
+        if (!myIndex.find(id, it)) {
             return 0;
         } else {
             return it->second;
@@ -112,6 +121,7 @@ public:
             delete i.second;
         }
         myMap.clear();
+        myIndex.clear();
     }
 
     /// @brief Returns the number of stored items within the container
@@ -130,14 +140,18 @@ public:
 
     /// @brief change ID of a stored object
     bool changeID(const std::string& oldId, const std::string& newId) {
-        auto i = myMap.find(oldId);
-        if (i == myMap.end()) {
+        typename IDMap::iterator i;
+        if (!myIndex.find(oldId, i)) {
             return false;
         } else {
             // save Item, remove it from Map, and insert it again with the new ID
             T item = i->second;
+            myIndex.erase(oldId);
             myMap.erase(i);
-            myMap.insert(std::make_pair(newId, item));
+            const auto inserted = myMap.insert(std::make_pair(newId, item));
+            if (inserted.second) {
+                myIndex.insert(inserted.first);
+            }
             return true;
         }
     }
@@ -156,4 +170,11 @@ public:
 private:
     /// @brief The map from key to object
     IDMap myMap;
+
+    /// @brief The hash index into myMap
+    StringHashIndex<typename IDMap::iterator> myIndex;
+
+private:
+    /// @brief Invalidated assignment operator
+    NamedObjectCont& operator=(const NamedObjectCont& s) = delete;
 };
@@ -0,0 +1,107 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    PerformanceCounters.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Object counts, memory and time spent per subsystem
+/****************************************************************************/
+#include <config.h>
+
+#include <sstream>
+#include "ToString.h"
+#include "PerformanceCounters.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const char* const PerformanceCounters::myNames[NUM_SUBSYSTEMS] = {
+    "routes", "vehicles", "devices", "detectors", "gui", "routing", "insertion", "movement", "laneChange"
+};
+bool PerformanceCounters::myEnabled(false);
+std::atomic<long long> PerformanceCounters::myObjects[NUM_SUBSYSTEMS];
+std::atomic<long long> PerformanceCounters::myBytes[NUM_SUBSYSTEMS];
+std::atomic<long long> PerformanceCounters::myPeakBytes[NUM_SUBSYSTEMS];
+std::atomic<long long> PerformanceCounters::myNanos[NUM_SUBSYSTEMS];
+std::atomic<long long> PerformanceCounters::myCalls[NUM_SUBSYSTEMS];
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+bool
+PerformanceCounters::getValue(const std::string& key, std::string& value) {
+    const std::string::size_type sep = key.find('.');
+    if (sep == std::string::npos) {
+        return false;
+    }
+    const std::string name = key.substr(0, sep);
+    const std::string counter = key.substr(sep + 1);
+    for (int i = 0; i < NUM_SUBSYSTEMS; i++) {
+        if (name == myNames[i]) {
+            if (counter == "objects") {
+                value = toString(myObjects[i].load());
+            } else if (counter == "bytes") {
+                value = toString(myBytes[i].load());
+            } else if (counter == "peakBytes") {
+                value = toString(myPeakBytes[i].load());
+            } else if (counter == "time") {
+                value = toString((double)myNanos[i].load() / 1e6);
+            } else if (counter == "calls") {
+                value = toString(myCalls[i].load());
+            } else {
+                return false;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+
+std::string
+PerformanceCounters::printStatistics() {
+    if (!myEnabled) {
+        return "";
+    }
+    std::ostringstream msg;
+    msg << "Subsystems:\n";
+    for (int i = 0; i < NUM_SUBSYSTEMS; i++) {
+        if (myPeakBytes[i] == 0 && myCalls[i] == 0) {
+            continue;
+        }
+        msg << " " << myNames[i] << ":";
+        if (myPeakBytes[i] > 0) {
+            msg << " objects " << myObjects[i] << ", memory " << (myBytes[i] >> 10) << " kB (peak " << (myPeakBytes[i] >> 10) << " kB)";
+        }
+        if (myCalls[i] > 0) {
+            msg << (myPeakBytes[i] > 0 ? "," : "") << " time " << myNanos[i] / 1000000 << " ms in " << myCalls[i] << " calls";
+        }
+        msg << "\n";
+    }
+    return msg.str();
+}
+
+
+void
+PerformanceCounters::resetTimers() {
+    for (int i = 0; i < NUM_SUBSYSTEMS; i++) {
+        myNanos[i] = 0;
+        myCalls[i] = 0;
+    }
+}
+
+
+/****************************************************************************/
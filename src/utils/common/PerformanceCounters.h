@@ -0,0 +1,151 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    PerformanceCounters.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Object counts, memory and time spent per subsystem
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class PerformanceCounters
+ * @brief Tagged counters for the objects, the memory and the time of the main subsystems
+ *
+ * The counters are only updated when enabled (before loading the network)
+ *  so they cost a single check otherwise. The memory is the size of the
+ *  objects themselves (plus the directly owned containers where noted) and
+ *  not a complete accounting of the heap. All counters are atomic because
+ *  vehicles move and routes are computed in parallel.
+ */
+class PerformanceCounters {
+public:
+    /// @brief the instrumented subsystems
+    enum Subsystem {
+        ROUTES,
+        VEHICLES,
+        DEVICES,
+        DETECTORS,
+        GUI,
+        ROUTING,
+        INSERTION,
+        MOVEMENT,
+        LANE_CHANGE,
+        NUM_SUBSYSTEMS
+    };
+
+    /// @brief measures the time until the end of the scope
+    class Timer {
+    public:
+        Timer(Subsystem subsystem) : mySubsystem(subsystem), myActive(myEnabled) {
+            if (myActive) {
+                myBegin = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~Timer() {
+            if (myActive) {
+                myNanos[mySubsystem] += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - myBegin).count();
+                myCalls[mySubsystem]++;
+            }
+        }
+
+    private:
+        const Subsystem mySubsystem;
+        const bool myActive;
+        std::chrono::steady_clock::time_point myBegin;
+
+        /// @brief Invalidated copy constructor.
+        Timer(const Timer&) = delete;
+
+        /// @brief Invalidated assignment operator.
+        Timer& operator=(const Timer&) = delete;
+    };
+
+    /// @brief enables or disables the counting (must not change while objects are alive)
+    static void setEnabled(bool enabled) {
+        myEnabled = enabled;
+    }
+
+    /// @brief whether the counters are updated
+    static bool isEnabled() {
+        return myEnabled;
+    }
+
+    /// @brief registers the creation of an object of the subsystem with the given size
+    static void added(Subsystem subsystem, long long bytes) {
+        if (myEnabled) {
+            myObjects[subsystem]++;
+            myBytes[subsystem] += bytes;
+            myPeakBytes[subsystem] = std::max(myPeakBytes[subsystem].load(), myBytes[subsystem].load());
+        }
+    }
+
+    /// @brief registers the deletion of an object of the subsystem with the given size
+    static void removed(Subsystem subsystem, long long bytes) {
+        if (myEnabled) {
+            myObjects[subsystem]--;
+            myBytes[subsystem] -= bytes;
+        }
+    }
+
+    /** @brief returns the value of a counter
+     * @param[in] key The subsystem name and the counter ("objects", "bytes", "peakBytes", "time" in ms or "calls") separated by '.'
+     * @param[out] value The current value
+     * @return whether the key is known
+     */
+    static bool getValue(const std::string& key, std::string& value);
+
+    /// @brief returns a report of all subsystems which were used
+    static std::string printStatistics();
+
+    /// @brief resets the time counters
+    static void resetTimers();
+
+private:
+    /// @brief the names of the subsystems
+    static const char* const myNames[NUM_SUBSYSTEMS];
+
+    /// @brief whether counting is enabled
+    static bool myEnabled;
+
+    /// @brief the number of living objects per subsystem
+    static std::atomic<long long> myObjects[NUM_SUBSYSTEMS];
+
+    /// @brief the memory of the living objects per subsystem
+    static std::atomic<long long> myBytes[NUM_SUBSYSTEMS];
+
+    /// @brief the maximum memory per subsystem
+    static std::atomic<long long> myPeakBytes[NUM_SUBSYSTEMS];
+
+    /// @brief the time spent per subsystem in nanoseconds
+    static std::atomic<long long> myNanos[NUM_SUBSYSTEMS];
+
+    /// @brief the number of timed calls per subsystem
+    static std::atomic<long long> myCalls[NUM_SUBSYSTEMS];
+
+private:
+    /// @brief Invalidated constructor.
+    PerformanceCounters() = delete;
+};
@@ -37,6 +37,7 @@
 // static member variables
 // ===========================================================================
 SumoRNG RandHelper::myRandomNumberGenerator("default");
+bool RandHelper::myAliasSampling = false;
 
 #ifdef DEBUG_RANDCALLS
 unsigned long long int myDebugIndex(7);
@@ -67,6 +68,9 @@ RandHelper::insertRandOptions(OptionsCont& oc) {
     oc.doRegister("seed", new Option_Integer(23423));
     oc.addSynonyme("seed", "srand", true);
     oc.addDescription("seed", "Random Number", TL("Initialises the random number generator with the given value"));
+
+    oc.doRegister("alias-sampling", new Option_Bool(false));
+    oc.addDescription("alias-sampling", "Random Number", TL("Draws from route and type distributions in constant time (the drawn values differ from the default sampling)"));
 }
 
 
@@ -87,6 +91,7 @@ void
 RandHelper::initRandGlobal(SumoRNG* which) {
     OptionsCont& oc = OptionsCont::getOptions();
     initRand(which, oc.getBool("random"), oc.getInt("seed"));
+    setAliasSampling(oc.getBool("alias-sampling"));
 }
 
 
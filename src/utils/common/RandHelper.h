@@ -24,6 +24,7 @@
 #include <cassert>
 #include <vector>
 #include <map>
+#include <memory>
 #include <random>
 #include <sstream>
 #include <iostream>
@@ -97,13 +98,123 @@ private:
 };
 
 
-//class SumoRNG : public XoShiRo256PlusPlus {
-class SumoRNG : public std::mt19937 {
+/**
+ * @class SumoRNG
+ * @brief The random number generator used throughout SUMO
+ *
+ * By default this is a Mersenne twister. A counter based generator does not
+ *  keep any state besides its key, the current step and the number of draws in
+ *  this step. Every number is a hash of these three values, so the results do not
+ *  depend on the order in which different generators are used (e.g. by different threads).
+ */
+class SumoRNG {
 public:
-    SumoRNG(const std::string& _id) : id(_id) {}
+    typedef std::mt19937::result_type result_type;
+
+    /// @brief Constructor for a Mersenne twister
+    SumoRNG(const std::string& _id) : id(_id), myEngine(new std::mt19937()) {}
+
+    /// @brief Constructor for a counter based generator with the given key
+    SumoRNG(const std::string& _id, const uint64_t key) : id(_id), myKey(key) {}
+
+    SumoRNG(const SumoRNG& other) :
+        count(other.count), id(other.id),
+        myEngine(other.myEngine == nullptr ? nullptr : new std::mt19937(*other.myEngine)),
+        myKey(other.myKey), myStep(other.myStep), myDraw(other.myDraw) {}
+
+    SumoRNG& operator=(const SumoRNG& other) {
+        if (this != &other) {
+            count = other.count;
+            id = other.id;
+            myEngine.reset(other.myEngine == nullptr ? nullptr : new std::mt19937(*other.myEngine));
+            myKey = other.myKey;
+            myStep = other.myStep;
+            myDraw = other.myDraw;
+        }
+        return *this;
+    }
+
+    inline result_type operator()() {
+        if (myEngine != nullptr) {
+            return (*myEngine)();
+        }
+        // the draws of a step form a splitmix64 sequence whose start depends on key and step
+        return (result_type)(splitmix64(splitmix64(myKey ^ (uint64_t)myStep) + 0x9e3779b97f4a7c15 * myDraw++) >> 32);
+    }
+
+    void seed(const result_type seed) {
+        if (myEngine != nullptr) {
+            myEngine->seed(seed);
+        } else {
+            myKey = seed;
+            myDraw = 0;
+        }
+    }
+
+    void discard(unsigned long long skip) {
+        if (myEngine != nullptr) {
+            myEngine->discard(skip);
+        } else {
+            myDraw += skip;
+        }
+    }
+
+    /// @brief whether this is a counter based generator
+    bool isCounterBased() const {
+        return myEngine == nullptr;
+    }
+
+    /// @brief lets a counter based generator start the draws of the given step (has no effect if the step did not change)
+    inline void setStep(const long long int step) {
+        if (step != myStep) {
+            myStep = step;
+            myDraw = 0;
+        }
+    }
+
+    /// @brief derives the key for a counter based generator from the seed and an object specific value
+    static uint64_t deriveKey(const uint64_t seed, const uint64_t objectID) {
+        return splitmix64(splitmix64(seed) ^ objectID);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const SumoRNG& r) {
+        if (r.myEngine != nullptr) {
+            os << *r.myEngine;
+        } else {
+            os << r.myKey << " " << r.myStep << " " << r.myDraw;
+        }
+        return os;
+    }
+
+    friend std::istream& operator>>(std::istream& is, SumoRNG& r) {
+        if (r.myEngine != nullptr) {
+            is >> *r.myEngine;
+        } else {
+            is >> r.myKey >> r.myStep >> r.myDraw;
+        }
+        return is;
+    }
 
     unsigned long long int count = 0;
     std::string id;
+
+private:
+    static inline uint64_t splitmix64(const uint64_t seed) {
+        uint64_t z = (seed + 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    /// @brief the Mersenne twister (nullptr for counter based generators)
+    std::unique_ptr<std::mt19937> myEngine;
+
+    /// @brief the key of a counter based generator
+    uint64_t myKey = 0;
+
+    /// @brief the step and the number of draws in this step of a counter based generator
+    long long int myStep = 0;
+    unsigned long long int myDraw = 0;
 };
 
 
@@ -126,6 +237,16 @@ public:
     /// @brief Returns a random real number in [0, 1)
     static double rand(SumoRNG* rng = nullptr);
 
+    /// @brief Returns whether RandomDistributor draws from alias tables (instead of scanning the probabilities)
+    static bool useAliasSampling() {
+        return myAliasSampling;
+    }
+
+    /// @brief Sets whether RandomDistributor draws from alias tables (done by initRandGlobal)
+    static void setAliasSampling(const bool value) {
+        myAliasSampling = value;
+    }
+
     /// @brief Returns a random real number in [0, maxV)
     static inline double rand(double maxV, SumoRNG* rng = nullptr) {
         return maxV * rand(rng);
@@ -239,4 +360,7 @@ protected:
     /// @brief the default random number generator to use
     static SumoRNG myRandomNumberGenerator;
 
+    /// @brief whether RandomDistributor uses alias tables
+    static bool myAliasSampling;
+
 };
@@ -0,0 +1,106 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    SampleStatistics.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Mean, variance and quantiles of a sample of values
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class SampleStatistics
+ * @brief Collects values and computes their descriptive statistics
+ *
+ * Mean and variance are updated with every value (Welford's algorithm) so
+ *  they are numerically stable. The values themselves are kept as well since
+ *  the quantiles need all of them, which is fine for the small samples this
+ *  is meant for (e.g. one value per simulation run).
+ */
+class SampleStatistics {
+public:
+    /// @brief Constructor
+    SampleStatistics() : myMean(0.), mySquaredDiffs(0.), myAmSorted(true) {}
+
+    /// @brief adds a value to the sample
+    void add(const double value) {
+        myValues.push_back(value);
+        const double delta = value - myMean;
+        myMean += delta / (double)myValues.size();
+        mySquaredDiffs += delta * (value - myMean);
+        myAmSorted = false;
+    }
+
+    /// @brief the number of values
+    int size() const {
+        return (int)myValues.size();
+    }
+
+    /// @brief the arithmetic mean (0 for an empty sample)
+    double getMean() const {
+        return myMean;
+    }
+
+    /// @brief the (unbiased) sample variance (0 for less than two values)
+    double getVariance() const {
+        return myValues.size() < 2 ? 0. : mySquaredDiffs / (double)(myValues.size() - 1);
+    }
+
+    /// @brief the sample standard deviation
+    double getStdDev() const {
+        return std::sqrt(getVariance());
+    }
+
+    /** @brief the quantile with linear interpolation between the closest ranks
+     * @param[in] p The probability in [0, 1] (0 gives the minimum, 1 the maximum)
+     * @return The quantile (0 for an empty sample)
+     */
+    double getQuantile(const double p) const {
+        if (myValues.empty()) {
+            return 0.;
+        }
+        if (!myAmSorted) {
+            std::sort(myValues.begin(), myValues.end());
+            myAmSorted = true;
+        }
+        const double rank = std::max(0., std::min(1., p)) * (double)(myValues.size() - 1);
+        const int lower = (int)rank;
+        if (lower + 1 >= (int)myValues.size()) {
+            return myValues.back();
+        }
+        return myValues[lower] + (rank - lower) * (myValues[lower + 1] - myValues[lower]);
+    }
+
+private:
+    /// @brief the values (sorted lazily for the quantiles)
+    mutable std::vector<double> myValues;
+
+    /// @brief the running mean
+    double myMean;
+
+    /// @brief the running sum of squared differences from the mean
+    double mySquaredDiffs;
+
+    /// @brief whether myValues is sorted
+    mutable bool myAmSorted;
+};
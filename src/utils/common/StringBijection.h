@@ -23,6 +23,7 @@
 #include <config.h>
 #include <iostream>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <utils/common/UtilExceptions.h>
@@ -93,8 +94,9 @@ public:
 
 
     T get(const std::string& str) const {
-        if (hasString(str)) {
-            return myString2T.find(str)->second;
+        const auto it = myString2T.find(str);
+        if (it != myString2T.end()) {
+            return it->second;
         } else {
             throw InvalidArgument("String '" + str + "' not found.");
         }
@@ -102,8 +104,9 @@ public:
 
 
     const std::string& getString(const T key) const {
-        if (has(key)) {
-            return myT2String.find(key)->second;
+        const auto it = myT2String.find(key);
+        if (it != myT2String.end()) {
+            return it->second;
         } else {
             // cannot use toString(key) because that might create an infinite loop
             throw InvalidArgument("Key not found.");
@@ -153,7 +156,10 @@ public:
 
 
 private:
-    std::map<std::string, T> myString2T;
+    /// @brief the lookup by string (hashed since it is never iterated)
+    std::unordered_map<std::string, T> myString2T;
+
+    /// @brief the lookup by key (ordered since getStrings and getValues depend on it)
     std::map<T, std::string> myT2String;
 
 };
@@ -0,0 +1,154 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    StringHashIndex.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// An open addressing hash index over the entries of a string keyed map
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class StringHashIndex
+ * @brief A flat hash index for fast lookups in a string keyed std::map
+ *
+ * The map keeps the ordered iteration (which output order depends on) while
+ *  lookups by id only need to hash the string and usually compare it once
+ *  instead of doing a string compare on every level of the tree. The index
+ *  stores the map iterators (and the hash values) only, so the keys are not
+ *  duplicated. It uses linear probing and is kept at most half full.
+ *
+ * The map must not be copied or moved without rebuilding the index.
+ */
+template<class ITERATOR>
+class StringHashIndex {
+public:
+    /// @brief Constructor
+    StringHashIndex() : mySize(0) {}
+
+    /// @brief adds the map entry (the key must not be in the index yet)
+    void insert(ITERATOR it) {
+        if (2 * (mySize + 1) > (int)mySlots.size()) {
+            rehash(mySlots.empty() ? 16 : 2 * mySlots.size());
+        }
+        insertSlot(Slot(std::hash<std::string>()(it->first), it));
+        mySize++;
+    }
+
+    /** @brief looks up the given key
+     * @param[in] key The key to search for
+     * @param[out] result The map entry found
+     * @return whether the key was found
+     */
+    bool find(const std::string& key, ITERATOR& result) const {
+        const int index = findSlot(key);
+        if (index < 0) {
+            return false;
+        }
+        result = mySlots[index].it;
+        return true;
+    }
+
+    /// @brief removes the given key from the index (the map entry must still be valid)
+    void erase(const std::string& key) {
+        int i = findSlot(key);
+        if (i < 0) {
+            return;
+        }
+        // backward shift deletion keeps all probe sequences intact
+        const int mask = (int)mySlots.size() - 1;
+        int j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (!mySlots[j].used) {
+                break;
+            }
+            const int home = (int)(mySlots[j].hash & mask);
+            if ((j > i && (home <= i || home > j)) || (j < i && home <= i && home > j)) {
+                mySlots[i] = mySlots[j];
+                i = j;
+            }
+        }
+        mySlots[i].used = false;
+        mySize--;
+    }
+
+    /// @brief removes all entries
+    void clear() {
+        mySlots.clear();
+        mySize = 0;
+    }
+
+    /// @brief the number of entries
+    int size() const {
+        return mySize;
+    }
+
+private:
+    struct Slot {
+        Slot() : hash(0), used(false) {}
+        Slot(std::size_t _hash, ITERATOR _it) : hash(_hash), it(_it), used(true) {}
+        std::size_t hash;
+        ITERATOR it;
+        bool used;
+    };
+
+    int findSlot(const std::string& key) const {
+        if (mySlots.empty()) {
+            return -1;
+        }
+        const std::size_t hash = std::hash<std::string>()(key);
+        const int mask = (int)mySlots.size() - 1;
+        for (int i = (int)(hash & mask); mySlots[i].used; i = (i + 1) & mask) {
+            if (mySlots[i].hash == hash && mySlots[i].it->first == key) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void insertSlot(const Slot& slot) {
+        const int mask = (int)mySlots.size() - 1;
+        int i = (int)(slot.hash & mask);
+        while (mySlots[i].used) {
+            i = (i + 1) & mask;
+        }
+        mySlots[i] = slot;
+    }
+
+    void rehash(const std::size_t numSlots) {
+        std::vector<Slot> old(numSlots);
+        old.swap(mySlots);
+        for (const Slot& slot : old) {
+            if (slot.used) {
+                insertSlot(slot);
+            }
+        }
+    }
+
+    /// @brief the hash table (its size is a power of two)
+    std::vector<Slot> mySlots;
+
+    /// @brief the number of used slots
+    int mySize;
+};
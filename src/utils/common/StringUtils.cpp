@@ -333,6 +333,10 @@ StringUtils::toIntSecure(const std::string& sData, int def) {
 
 long long int
 StringUtils::toLong(const std::string& sData) {
+    long long int simple;
+    if (parseSimpleLong(sData, simple)) {
+        return simple;
+    }
     const char* const data = sData.c_str();
     if (data == 0 || data[0] == 0) {
         throw EmptyData();
@@ -384,6 +388,10 @@ StringUtils::toDouble(const std::string& sData) {
     if (sData.size() == 0) {
         throw EmptyData();
     }
+    double simple;
+    if (parseSimpleDouble(sData, simple)) {
+        return simple;
+    }
     try {
         size_t idx = 0;
         const double result = std::stod(sData, &idx);
@@ -399,6 +407,102 @@ StringUtils::toDouble(const std::string& sData) {
 }
 
 
+bool
+StringUtils::parseSimpleLong(const std::string& sData, long long int& result) {
+    const int length = (int)sData.size();
+    int i = 0;
+    const bool negative = length > 0 && sData[0] == '-';
+    if (length > 0 && (sData[0] == '-' || sData[0] == '+')) {
+        i++;
+    }
+    if (i == length || length - i > 18) {
+        return false;
+    }
+    long long int value = 0;
+    for (; i < length; i++) {
+        const char c = sData[i];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = 10 * value + (c - '0');
+    }
+    result = negative ? -value : value;
+    return true;
+}
+
+
+bool
+StringUtils::parseSimpleDouble(const std::string& sData, double& result) {
+    // exact powers of ten, a product or quotient of an integer below 2^53 and
+    // one of these is correctly rounded and thus identical to the result of strtod
+    static const double powersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const int length = (int)sData.size();
+    int i = 0;
+    const bool negative = length > 0 && sData[0] == '-';
+    if (length > 0 && (sData[0] == '-' || sData[0] == '+')) {
+        i++;
+    }
+    long long int mantissa = 0;
+    int numDigits = 0;
+    int significant = 0;
+    int exponent = 0;
+    bool afterPoint = false;
+    for (; i < length; i++) {
+        const char c = sData[i];
+        if (c >= '0' && c <= '9') {
+            numDigits++;
+            if (mantissa != 0 || c != '0') {
+                if (++significant > 15) {
+                    return false;
+                }
+            }
+            mantissa = 10 * mantissa + (c - '0');
+            if (afterPoint) {
+                exponent--;
+            }
+        } else if (c == '.' && !afterPoint) {
+            afterPoint = true;
+        } else {
+            break;
+        }
+    }
+    if (numDigits == 0) {
+        return false;
+    }
+    if (i < length) {
+        if ((sData[i] != 'e' && sData[i] != 'E') || i + 1 == length) {
+            return false;
+        }
+        i++;
+        const bool negativeExp = sData[i] == '-';
+        if (sData[i] == '-' || sData[i] == '+') {
+            i++;
+        }
+        if (i == length || length - i > 3) {
+            return false;
+        }
+        int exp = 0;
+        for (; i < length; i++) {
+            const char c = sData[i];
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            exp = 10 * exp + (c - '0');
+        }
+        exponent += negativeExp ? -exp : exp;
+    }
+    if (exponent < -22 || exponent > 22) {
+        return false;
+    }
+    const double value = exponent < 0 ? (double)mantissa / powersOfTen[-exponent] : (double)mantissa * powersOfTen[exponent];
+    result = negative ? -value : value;
+    return true;
+}
+
+
 double
 StringUtils::toDoubleSecure(const std::string& sData, const double def) {
     if (sData.length() == 0) {
@@ -434,22 +538,32 @@ StringUtils::transcode(const XMLCh* const data, int length) {
     if (data == 0) {
         throw EmptyData();
     }
-    if (length == 0) {
-        return "";
+    // direct conversion from UTF-16 to UTF-8 (much faster than looking up a xerces transcoder for every value)
+    std::string result;
+    result.reserve(length);
+    for (int i = 0; i < length; i++) {
+        unsigned int c = data[i];
+        if (c < 0x80) {
+            result.push_back((char)c);
+        } else if (c < 0x800) {
+            result.push_back((char)(0xC0 | (c >> 6)));
+            result.push_back((char)(0x80 | (c & 0x3F)));
+        } else if (c < 0xD800 || c >= 0xE000) {
+            result.push_back((char)(0xE0 | (c >> 12)));
+            result.push_back((char)(0x80 | ((c >> 6) & 0x3F)));
+            result.push_back((char)(0x80 | (c & 0x3F)));
+        } else if (c < 0xDC00 && i + 1 < length && data[i + 1] >= 0xDC00 && data[i + 1] < 0xE000) {
+            c = 0x10000 + ((c - 0xD800) << 10) + (data[++i] - 0xDC00);
+            result.push_back((char)(0xF0 | (c >> 18)));
+            result.push_back((char)(0x80 | ((c >> 12) & 0x3F)));
+            result.push_back((char)(0x80 | ((c >> 6) & 0x3F)));
+            result.push_back((char)(0x80 | (c & 0x3F)));
+        } else {
+            // unpaired surrogate
+            return "?";
+        }
     }
-#if _XERCES_VERSION < 30100
-    char* t = XERCES_CPP_NAMESPACE::XMLString::transcode(data);
-    std::string result(t);
-    XERCES_CPP_NAMESPACE::XMLString::release(&t);
     return result;
-#else
-    try {
-        XERCES_CPP_NAMESPACE::TranscodeToStr utf8(data, "UTF-8");
-        return reinterpret_cast<const char*>(utf8.str());
-    } catch (XERCES_CPP_NAMESPACE::TranscodingException&) {
-        return "?";
-    }
-#endif
 }
 
 
@@ -181,6 +181,16 @@ public:
     }
 
 private:
+    /** @brief parses plain decimal integers with at most 18 digits
+     * @return false if the string needs the full conversion (which also does the error handling)
+     */
+    static bool parseSimpleLong(const std::string& sData, long long int& result);
+
+    /** @brief parses plain decimal numbers which can be converted exactly (at most 15 significant digits and small exponents)
+     * @return false if the string needs the full conversion (which also does the error handling)
+     */
+    static bool parseSimpleDouble(const std::string& sData, double& result);
+
     static void _format(const char* format, std::ostringstream& os) {
         os << format;
     }
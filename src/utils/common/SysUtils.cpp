@@ -28,6 +28,7 @@
 
 #ifndef WIN32
 #include <sys/time.h>
+#include <sys/resource.h>
 #include <unistd.h>
 #else
 #define NOMINMAX
@@ -115,4 +116,20 @@ SysUtils::getModifiedTime(const std::string& fname) {
 }
 
 
+long long
+SysUtils::getPeakMemoryUsage() {
+#ifndef WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        return (long long)usage.ru_maxrss;
+#else
+        return (long long)usage.ru_maxrss * 1024;
+#endif
+    }
+#endif
+    return -1;
+}
+
+
 /****************************************************************************/
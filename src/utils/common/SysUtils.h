@@ -49,4 +49,7 @@ public:
 
     /// @brie get modified time
     static long long getModifiedTime(const std::string& fname);
+
+    /// @brief returns the peak resident memory of the process in bytes (or -1 if unknown)
+    static long long getPeakMemoryUsage();
 };
@@ -124,6 +124,18 @@ SystemFrame::addReportOptions(OptionsCont& oc) {
     oc.doRegister("output-prefix", new Option_String());
     oc.addDescription("output-prefix", "Output", TL("Prefix which is applied to all output files. The special string 'TIME' is replaced by the current time."));
 
+    oc.doRegister("output.async", new Option_Bool(false));
+    oc.addDescription("output.async", "Output", TL("Write (and compress) output files in background threads"));
+
+    oc.doRegister("output.compression-threads", new Option_Integer(1));
+    oc.addDescription("output.compression-threads", "Output", TL("Number of threads for compressing an output file (zstd always, gzip together with output.async)"));
+
+    oc.doRegister("output.network.buffer", new Option_Integer(0));
+    oc.addDescription("output.network.buffer", "Output", TL("Send network outputs in background threads queueing at most INT kB (0 sends synchronously)"));
+
+    oc.doRegister("output.network.drop", new Option_Bool(false));
+    oc.addDescription("output.network.drop", "Output", TL("Drop network output which does not fit into the queue instead of waiting for the receiver"));
+
     oc.doRegister("precision", new Option_Integer(2));
     oc.addDescription("precision", "Output", TL("Defines the number of digits after the comma for floating point output"));
 
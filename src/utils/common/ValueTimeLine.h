@@ -24,6 +24,7 @@
 #include <map>
 #include <cassert>
 #include <utility>
+#include <vector>
 #include <utils/common/SUMOTime.h>
 
 
@@ -38,12 +39,17 @@
  * with assigned values. The container is sorted by the first value of the
  * time-range while being filled. Every new inserted time range
  * may overwrite or split one or multiple earlier intervals.
+ *
+ * Once filled, the container may be compacted. If the intervals are of equal
+ * length (as for the usual edgeData weights) the values are then stored in an
+ * array and looked up in constant time. Any later modification converts the
+ * container back to the map representation.
  */
 template<typename T>
 class ValueTimeLine {
 public:
     /// @brief Constructor
-    ValueTimeLine() { }
+    ValueTimeLine() : myHasHead(false), myHeadKey(0.), myDenseBegin(0.), myDenseInterval(0.) { }
 
     /// @brief Destructor
     ~ValueTimeLine() { }
@@ -59,6 +65,7 @@ public:
     void add(double begin, double end, T value) {
         assert(begin >= 0);
         assert(begin < end);
+        expand();
         // inserting strictly before the first or after the last interval (includes empty case)
         if (myValues.upper_bound(begin) == myValues.end() ||
                 myValues.upper_bound(end) == myValues.begin()) {
@@ -91,6 +98,11 @@ public:
      * @return the value for the time
      */
     T getValue(double time) const {
+        if (!myDense.empty()) {
+            const int index = denseIndex(time);
+            assert(index >= 0);
+            return getDenseEntry(index).second;
+        }
         assert(myValues.size() != 0);
         typename TimedValueMap::const_iterator it = myValues.upper_bound(time);
         assert(it != myValues.begin());
@@ -109,6 +121,10 @@ public:
      * @return whether a valid value was set
      */
     bool describesTime(double time) const {
+        if (!myDense.empty()) {
+            const int index = denseIndex(time);
+            return index >= 0 && getDenseEntry(index).first;
+        }
         typename TimedValueMap::const_iterator afterIt = myValues.upper_bound(time);
         if (afterIt == myValues.begin()) {
             return false;
@@ -128,6 +144,13 @@ public:
      * @return the split point
      */
     double getSplitTime(double low, double high) const {
+        if (!myDense.empty()) {
+            const int highIndex = denseIndex(high);
+            if (highIndex >= 0 && denseIndex(low) + 1 == highIndex) {
+                return getDenseKey(highIndex);
+            }
+            return -1;
+        }
         typename TimedValueMap::const_iterator afterLow = myValues.upper_bound(low);
         typename TimedValueMap::const_iterator afterHigh = myValues.upper_bound(high);
         --afterHigh;
@@ -143,6 +166,7 @@ public:
      * @param[in] extendOverBoundaries whether the first/last value should be valid for later / earlier times as well
      */
     void fillGaps(T value, bool extendOverBoundaries = false) {
+        expand();
         for (typename TimedValueMap::iterator it = myValues.begin(); it != myValues.end(); ++it) {
             if (!it->second.first) {
                 it->second.second = value;
@@ -158,6 +182,74 @@ public:
         myValues[-1] = std::make_pair(false, value);
     }
 
+    /** @brief Returns the smallest of the valid values
+     * @param[in] fallback The value to return if there is no valid value
+     * @return The minimum of the values of all described times
+     */
+    T getMinimumValue(T fallback) const {
+        bool found = false;
+        T result = fallback;
+        auto update = [&](const ValidValue & v) {
+            if (v.first && (!found || v.second < result)) {
+                result = v.second;
+                found = true;
+            }
+        };
+        if (myHasHead) {
+            update(myHead);
+        }
+        for (const ValidValue& v : myDense) {
+            update(v);
+        }
+        for (const auto& item : myValues) {
+            update(item.second);
+        }
+        return result;
+    }
+
+    /** @brief Stores the values in an array if the intervals are of equal length
+     *
+     * An entry before the first regular interval (as added by fillGaps) is allowed.
+     * The results of all queries stay the same.
+     * @return whether the array representation is used now
+     */
+    bool compact() {
+        if (!myDense.empty()) {
+            return true;
+        }
+        if (myValues.size() < 4) {
+            return false;
+        }
+        typename TimedValueMap::const_iterator start = myValues.begin();
+        typename TimedValueMap::const_iterator second = std::next(start);
+        if (std::next(second)->first - second->first != second->first - start->first) {
+            // the first entry may precede the regular intervals
+            ++start;
+            ++second;
+        }
+        const double begin = start->first;
+        const double interval = second->first - begin;
+        int i = 0;
+        for (typename TimedValueMap::const_iterator it = start; it != myValues.end(); ++it, ++i) {
+            if (it->first != begin + i * interval) {
+                return false;
+            }
+        }
+        myHasHead = start != myValues.begin();
+        if (myHasHead) {
+            myHeadKey = myValues.begin()->first;
+            myHead = myValues.begin()->second;
+        }
+        myDenseBegin = begin;
+        myDenseInterval = interval;
+        myDense.reserve(myValues.size());
+        for (typename TimedValueMap::const_iterator it = start; it != myValues.end(); ++it) {
+            myDense.push_back(it->second);
+        }
+        TimedValueMap().swap(myValues);
+        return true;
+    }
+
 private:
     /// @brief Value of time line, indicating validity.
     typedef std::pair<bool, T> ValidValue;
@@ -165,7 +257,79 @@ private:
     /// @brief Sorted map from start of intervals to values.
     typedef std::map<double, ValidValue> TimedValueMap;
 
+    /// @brief converts the array representation back to the map
+    void expand() {
+        if (myDense.empty()) {
+            return;
+        }
+        if (myHasHead) {
+            myValues[myHeadKey] = myHead;
+        }
+        for (int i = 0; i < (int)myDense.size(); i++) {
+            myValues[myDenseBegin + i * myDenseInterval] = myDense[i];
+        }
+        std::vector<ValidValue>().swap(myDense);
+        myHasHead = false;
+    }
+
+    /** @brief the index of the entry containing the given time (in the array representation)
+     * @return the index (0 for the head entry if there is one) or -1 if the time is before all entries
+     */
+    int denseIndex(double time) const {
+        const int offset = myHasHead ? 1 : 0;
+        if (time < myDenseBegin) {
+            return myHasHead && time >= myHeadKey ? 0 : -1;
+        }
+        const int n = (int)myDense.size();
+        const double pos = (time - myDenseBegin) / myDenseInterval;
+        int i = pos >= n ? n - 1 : (int)pos;
+        // correct rounding errors of the division
+        while (i > 0 && myDenseBegin + i * myDenseInterval > time) {
+            i--;
+        }
+        while (i + 1 < n && myDenseBegin + (i + 1) * myDenseInterval <= time) {
+            i++;
+        }
+        return i + offset;
+    }
+
+    /// @brief the start time of the entry with the given index (see denseIndex)
+    double getDenseKey(int index) const {
+        if (myHasHead) {
+            if (index == 0) {
+                return myHeadKey;
+            }
+            index--;
+        }
+        return myDenseBegin + index * myDenseInterval;
+    }
+
+    /// @brief the entry with the given index (see denseIndex)
+    const ValidValue& getDenseEntry(int index) const {
+        if (myHasHead) {
+            if (index == 0) {
+                return myHead;
+            }
+            index--;
+        }
+        return myDense[index];
+    }
+
     /// @brief The list of time periods (with values)
     TimedValueMap myValues;
 
+    /// @brief whether the array representation has an entry before the regular intervals
+    bool myHasHead;
+
+    /// @brief the start time and the value of the entry before the regular intervals
+    double myHeadKey;
+    ValidValue myHead;
+
+    /// @brief the start and the length of the regular intervals
+    double myDenseBegin;
+    double myDenseInterval;
+
+    /// @brief the values of the regular intervals (empty if the map representation is used)
+    std::vector<ValidValue> myDense;
+
 };
@@ -22,8 +22,12 @@
 #pragma once
 #include <config.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <limits>
+#include <mutex>
+#include <vector>
 #include <utils/common/RandHelper.h>
 #include <utils/common/UtilExceptions.h>
 
@@ -39,6 +43,11 @@
  *  arbitrary (non-negative) probabilities to its elements. The
  *  random number generator used is specified in RandHelper.
  *
+ * By default a draw scans the probabilities. With alias sampling enabled
+ *  (see RandHelper::useAliasSampling) an alias table is built on the first
+ *  draw after a change, then every draw takes constant time and still
+ *  consumes exactly one random number.
+ *
  * @see RandHelper
  */
 
@@ -48,7 +57,25 @@ public:
     /** @brief Constructor for an empty distribution
      */
     RandomDistributor() :
-        myProb(0) {
+        myProb(0),
+        myAliasDirty(true) {
+    }
+
+    /// @brief Copy constructor (the alias table is rebuilt when needed)
+    RandomDistributor(const RandomDistributor& other) :
+        myProb(other.myProb),
+        myVals(other.myVals),
+        myProbs(other.myProbs),
+        myAliasDirty(true) {
+    }
+
+    /// @brief Assignment operator (the alias table is rebuilt when needed)
+    RandomDistributor& operator=(const RandomDistributor& other) {
+        myProb = other.myProb;
+        myVals = other.myVals;
+        myProbs = other.myProbs;
+        myAliasDirty = true;
+        return *this;
     }
 
     /// @brief Destructor
@@ -66,6 +93,7 @@ public:
      * @return true if a new value was added, false if just the probability of an existing one was updated
      */
     bool add(T val, double prob, bool checkDuplicates = true) {
+        myAliasDirty = true;
         myProb += prob;
         assert(myProb >= 0);
         if (checkDuplicates) {
@@ -92,6 +120,7 @@ public:
     bool remove(T val) {
         for (int i = 0; i < (int)myVals.size(); i++) {
             if (myVals[i] == val) {
+                myAliasDirty = true;
                 myProb -= myProbs[i];
                 myProbs.erase(myProbs.begin() + i);
                 myVals.erase(myVals.begin() + i);
@@ -112,6 +141,15 @@ public:
         if (myProb == 0) {
             throw OutOfBoundsException();
         }
+        if (RandHelper::useAliasSampling()) {
+            if (myAliasDirty.load(std::memory_order_acquire)) {
+                buildAliasTable();
+            }
+            const int n = (int)myVals.size();
+            const double r = RandHelper::rand((double)n, which);
+            const int i = std::min((int)r, n - 1);
+            return r - i < myAliasProbs[i] ? myVals[i] : myVals[myAliases[i]];
+        }
         double prob = RandHelper::rand(myProb, which);
         for (int i = 0; i < (int)myVals.size(); i++) {
             if (prob < myProbs[i]) {
@@ -134,6 +172,7 @@ public:
 
     /// @brief Clears the distribution
     void clear() {
+        myAliasDirty = true;
         myProb = 0;
         myVals.clear();
         myProbs.clear();
@@ -162,6 +201,44 @@ public:
     }
 
 private:
+    /// @brief builds the alias table (Vose's method) if the distribution changed since the last build
+    void buildAliasTable() const {
+        static std::mutex buildMutex;
+        std::lock_guard<std::mutex> lock(buildMutex);
+        if (!myAliasDirty.load(std::memory_order_relaxed)) {
+            return;
+        }
+        const int n = (int)myVals.size();
+        myAliasProbs.assign(n, 1.);
+        myAliases.resize(n);
+        std::vector<double> scaled(n);
+        std::vector<int> small;
+        std::vector<int> large;
+        for (int i = 0; i < n; i++) {
+            myAliases[i] = i;
+            scaled[i] = myProbs[i] * n / myProb;
+            if (scaled[i] < 1.) {
+                small.push_back(i);
+            } else {
+                large.push_back(i);
+            }
+        }
+        while (!small.empty() && !large.empty()) {
+            const int s = small.back();
+            small.pop_back();
+            const int l = large.back();
+            myAliasProbs[s] = scaled[s];
+            myAliases[s] = l;
+            scaled[l] += scaled[s] - 1.;
+            if (scaled[l] < 1.) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+        // the remaining entries are (up to rounding errors) exactly one
+        myAliasDirty.store(false, std::memory_order_release);
+    }
+
     /// @brief the total probability
     double myProb;
     /// @brief the members
@@ -169,4 +246,11 @@ private:
     /// @brief the corresponding probabilities
     std::vector<double> myProbs;
 
+    /// @brief whether the alias table has to be rebuilt before the next draw
+    mutable std::atomic<bool> myAliasDirty;
+    /// @brief the probability of keeping the drawn column for every column
+    mutable std::vector<double> myAliasProbs;
+    /// @brief the member to use instead of the drawn column
+    mutable std::vector<int> myAliases;
+
 };
@@ -10133,4 +10133,33 @@ HelpersHBEFA4::getEuroClass(const SUMOEmissionClass c) const {
 }
 
 
+
+PollutantsInterface::Emissions
+HelpersHBEFA4::computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const EnergyParams* param) const {
+    if (param != nullptr && param->isEngineOff()) {
+        return PollutantsInterface::Emissions();
+    }
+    if (v > ZERO_SPEED_ACCURACY && a < getCoastingDecel(c, v, a, slope, param)) {
+        return PollutantsInterface::Emissions();
+    }
+    const int index = (c & ~PollutantsInterface::HEAVY_BIT) - HBEFA4_BASE;
+    double result[7];
+    for (int e = 0; e < 7; e++) {
+        // same term order as in compute to get identical results
+        const double* f = myFunctionParameter[index][e];
+        result[e] = f[0] + f[1] * v + f[2] * a + f[3] * v * v + f[4] * v * v * v + f[5] * a * v + f[6] * a * v * v;
+    }
+    if (myVolumetricFuel) {
+        const std::string fuel = getFuel(c);
+        if (fuel == "Diesel") {
+            result[PollutantsInterface::FUEL] /= 836.;
+        } else if (fuel == "Gasoline") {
+            result[PollutantsInterface::FUEL] /= 742.;
+        }
+    }
+    return PollutantsInterface::Emissions(result[PollutantsInterface::CO2], result[PollutantsInterface::CO], result[PollutantsInterface::HC],
+                                          result[PollutantsInterface::FUEL], result[PollutantsInterface::NO_X], result[PollutantsInterface::PM_X],
+                                          result[PollutantsInterface::ELEC]);
+}
+
 /****************************************************************************/
@@ -114,6 +114,20 @@ public:
     }
 
 
+    /** @brief Computes the emitted amounts of all pollutants using the given speed and acceleration
+     *
+     * The checks for coasting and the fuel scale are done only once and the
+     *  polynomials of all emission types are evaluated in one loop.
+     *
+     * @param[in] c emission class for the function parameters to use
+     * @param[in] v The vehicle's current velocity
+     * @param[in] a The vehicle's current acceleration
+     * @param[in] slope The road's slope at vehicle's position [deg]
+     * @return The amounts emitted by the given emission class when moving with the given velocity and acceleration [mg/s or ml/s]
+     */
+    PollutantsInterface::Emissions computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const EnergyParams* param) const;
+
+
 private:
     /// @brief The function parameter
     static double myFunctionParameter[833][7][7];
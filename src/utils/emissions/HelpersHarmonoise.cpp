@@ -25,6 +25,7 @@
 #include "HelpersHarmonoise.h"
 #include <limits>
 #include <cmath>
+#include <vector>
 
 
 // ===========================================================================
@@ -102,27 +103,32 @@ HelpersHarmonoise::computeNoise(SUMOEmissionClass c, double v, double a) {
     } else {
         return 0;
     }
-    //
-    double L_low = 0;
-    double L_high = 0;
-    v = v * 3.6;
-    double s = -30.;//
+    // The low (0.8 rolling, 0.2 traction) and the high source (0.2 rolling,
+    // 0.8 traction) are energetically summed over all bands. The weights
+    // add up to one, so the sum equals the sum of both components per band
+    // which saves converting levels back and forth for each band.
+    // The common level offset s = -30 dB and the A-weighting of the bands
+    // are applied to the energies directly.
+    static const double dB2ln = log(10.) / 10.;
+    const double s = -30.;
+    const double vKmh = v * 3.6;
+    const double rollingSpeed = log10(vKmh / 70.);
+    const double tractionSpeed = (vKmh - 70.) / 70.;
+    const double accelFactor = exp(dB2ln * a * ac);
+    static const std::vector<double> bandWeights = []() {
+        std::vector<double> weights;
+        for (const double correction : myAOctaveBandCorrection) {
+            weights.push_back(pow(10., correction / 10.));
+        }
+        return weights;
+    }();
+    double energy = 0;
     for (int i = 0; i < 27; ++i) {
-        double crc_low = alphaR[i] + betaR[i] * log10(v / 70.) + 10.*log10(.8); // + mySurfaceCorrection[i];
-        double ctc_low = alphaT[i] + betaT[i] * ((v - 70.) / 70.) + a * ac + 10.*log10(.2);
-        double Li_low = 10. * log10(pow(10., (crc_low / 10.)) + pow(10., (ctc_low / 10.)));
-        Li_low += s;
-        double crc_high = alphaR[i] + betaR[i] * log10(v / 70.) + 10.*log10(.2); // + mySurfaceCorrection[i];
-        double ctc_high = alphaT[i] + betaT[i] * ((v - 70.) / 70.) + a * ac + 10.*log10(.8);
-        double Li_high = 10. * log10(pow(10., (crc_high / 10.)) + pow(10., (ctc_high / 10.)));
-        Li_high += s;
-        L_low += pow(10., (Li_low + myAOctaveBandCorrection[i]) / 10.);
-        L_high += pow(10., (Li_high + myAOctaveBandCorrection[i]) / 10.);
+        const double rolling = exp(dB2ln * (alphaR[i] + betaR[i] * rollingSpeed));
+        const double traction = exp(dB2ln * (alphaT[i] + betaT[i] * tractionSpeed)) * accelFactor;
+        energy += (rolling + traction) * bandWeights[i];
     }
-    L_low = (10. * log10(L_low));
-    L_high = (10. * log10(L_high));
-    double v1 = (double)(10. * log10(pow(10., L_low / 10.) + pow(10., L_high / 10.)));
-    return v1;
+    return 10. * log10(energy) + s;
 }
 
 
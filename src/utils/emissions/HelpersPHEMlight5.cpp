@@ -187,4 +187,42 @@ HelpersPHEMlight5::compute(const SUMOEmissionClass c, const PollutantsInterface:
 }
 
 
+
+PollutantsInterface::Emissions
+HelpersPHEMlight5::computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const EnergyParams* param) const {
+    if (param != nullptr && param->isEngineOff()) {
+        return PollutantsInterface::Emissions();
+    }
+    const double corrSpeed = MAX2(0.0, v);
+    assert(myCEPs.count(c) == 1);
+    PHEMlightdllV5::CEP* const currCep = myCEPs.find(c)->second;
+    const double corrAcc = getModifiedAccel(c, corrSpeed, a, slope);
+    const bool isBEV = currCep->getFuelType() == PHEMlightdllV5::Constants::strBEV;
+    const bool isHybrid = currCep->getFuelType() == PHEMlightdllV5::Constants::strHybrid;
+    const double power_raw = currCep->CalcPower(corrSpeed, corrAcc, slope, isBEV || isHybrid);
+    const double power = isHybrid ? currCep->CalcWheelPower(corrSpeed, corrAcc, slope) : currCep->CalcEngPower(power_raw);
+
+    if (!isBEV && corrAcc < currCep->GetDecelCoast(corrSpeed, corrAcc, slope) &&
+            corrSpeed > PHEMlightdllV5::Constants::ZERO_SPEED_ACCURACY) {
+        return PollutantsInterface::Emissions();
+    }
+    const std::string& fuelType = currCep->getFuelType();
+    const double fc = getEmission(currCep, "FC", power, corrSpeed);
+    const double co = getEmission(currCep, "CO", power, corrSpeed);
+    const double hc = getEmission(currCep, "HC", power, corrSpeed);
+    double fuel = fc / SECONDS_PER_HOUR * 1000.; // still in mg even if myVolumetricFuel is set!
+    if (myVolumetricFuel && fuelType == PHEMlightdllV5::Constants::strDiesel) { // divide by average diesel density of 836 g/l
+        fuel = fc / 836. / SECONDS_PER_HOUR * 1000.;
+    } else if (myVolumetricFuel && fuelType == PHEMlightdllV5::Constants::strGasoline) { // divide by average gasoline density of 742 g/l
+        fuel = fc / 742. / SECONDS_PER_HOUR * 1000.;
+    } else if (fuelType == PHEMlightdllV5::Constants::strBEV) {
+        fuel = 0.;
+    }
+    const double elec = fuelType == PHEMlightdllV5::Constants::strBEV ? (getEmission(currCep, "FC_el", power, corrSpeed) + currCep->getAuxPower()) / SECONDS_PER_HOUR * 1000. : 0.;
+    return PollutantsInterface::Emissions(currCep->GetCO2Emission(fc, co, hc, &myHelper) / SECONDS_PER_HOUR * 1000.,
+                                          co / SECONDS_PER_HOUR * 1000., hc / SECONDS_PER_HOUR * 1000., fuel,
+                                          getEmission(currCep, "NOx", power, corrSpeed) / SECONDS_PER_HOUR * 1000.,
+                                          getEmission(currCep, "PM", power, corrSpeed) / SECONDS_PER_HOUR * 1000., elec);
+}
+
 /****************************************************************************/
@@ -89,6 +89,28 @@ void PollutantsInterface::Emissions::addScaled(const Emissions& a, const double
     electricity += scale * a.electricity;
 }
 
+
+double PollutantsInterface::Emissions::get(const EmissionType e) const {
+    switch (e) {
+        case PollutantsInterface::CO2:
+            return CO2;
+        case PollutantsInterface::CO:
+            return CO;
+        case PollutantsInterface::HC:
+            return HC;
+        case PollutantsInterface::FUEL:
+            return fuel;
+        case PollutantsInterface::NO_X:
+            return NOx;
+        case PollutantsInterface::PM_X:
+            return PMx;
+        case PollutantsInterface::ELEC:
+            return electricity;
+        default:
+            return 0.;
+    }
+}
+
 // ---------------------------------------------------------------------------
 // PollutantsInterface::Helper - methods
 // ---------------------------------------------------------------------------
@@ -182,6 +204,14 @@ PollutantsInterface::Helper::compute(const SUMOEmissionClass c, const EmissionTy
 }
 
 
+PollutantsInterface::Emissions
+PollutantsInterface::Helper::computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const EnergyParams* param) const {
+    return Emissions(compute(c, CO2, v, a, slope, param), compute(c, CO, v, a, slope, param), compute(c, HC, v, a, slope, param),
+                     compute(c, FUEL, v, a, slope, param), compute(c, NO_X, v, a, slope, param), compute(c, PM_X, v, a, slope, param),
+                     compute(c, ELEC, v, a, slope, param));
+}
+
+
 double
 PollutantsInterface::Helper::getModifiedAccel(const SUMOEmissionClass c, const double v, const double a, const double slope) const {
     UNUSED_PARAMETER(c);
@@ -357,10 +387,7 @@ PollutantsInterface::compute(const SUMOEmissionClass c, const EmissionType e, co
 
 PollutantsInterface::Emissions
 PollutantsInterface::computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const EnergyParams* param) {
-    const Helper* const h = myHelpers[c >> 16];
-    return Emissions(h->compute(c, CO2, v, a, slope, param), h->compute(c, CO, v, a, slope, param), h->compute(c, HC, v, a, slope, param),
-                     h->compute(c, FUEL, v, a, slope, param), h->compute(c, NO_X, v, a, slope, param), h->compute(c, PM_X, v, a, slope, param),
-                     h->compute(c, ELEC, v, a, slope, param));
+    return myHelpers[c >> 16]->computeAll(c, v, a, slope, param);
 }
 
 
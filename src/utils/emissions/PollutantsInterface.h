@@ -77,6 +77,9 @@ public:
          */
         void addScaled(const Emissions& a, const double scale = 1.);
 
+        /// @brief returns the value for the given emission type
+        double get(const EmissionType e) const;
+
         /// @brief emission types
         /// @{
         double CO2;
@@ -189,6 +192,18 @@ public:
          */
         virtual double compute(const SUMOEmissionClass c, const EmissionType e, const double v, const double a, const double slope, const EnergyParams* param) const;
 
+        /** @brief Returns the amount of all emitted pollutants given the vehicle type and state (in mg/s or ml/s for fuel)
+         * The default implementation calls compute for every emission type, models sharing
+         *  intermediate results between the emission types should override it.
+         * @param[in] c The vehicle emission class
+         * @param[in] v The vehicle's current velocity
+         * @param[in] a The vehicle's current acceleration
+         * @param[in] slope The road's slope at vehicle's position [deg]
+         * @param[in] param parameter of the emission model affecting the computation
+         * @return The amounts emitted by the given emission class when moving with the given velocity and acceleration [mg/s or ml/s]
+         */
+        virtual Emissions computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const EnergyParams* param) const;
+
         /** @brief Returns the adapted acceleration value, useful for comparing with external PHEMlight references.
          * Default implementation returns always the input accel.
          * @param[in] c the emission class
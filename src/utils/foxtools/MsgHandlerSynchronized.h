@@ -51,8 +51,10 @@ public:
 
     /// @brief adds a new error to the list
     void inform(std::string msg, bool addType = true) {
+        // prefixes and time stamps are built before blocking the other threads
+        const std::string built = build(msg, addType);
         FXMutexLock locker(myLock);
-        MsgHandler::inform(msg, addType);
+        write(msg, built, addType);
     }
 
     /** @brief Begins a process information
@@ -93,6 +95,9 @@ public:
 
 protected:
     bool aggregationThresholdReached(const std::string& format) {
+        if (!isAggregating()) {
+            return false;
+        }
         FXMutexLock locker(myLock);
         return MsgHandler::aggregationThresholdReached(format);
     }
@@ -357,6 +357,32 @@ GeoConvHelper::cartesian2geo(Position& cartesian) const {
 }
 
 
+void
+GeoConvHelper::cartesian2geo(PositionVector& cartesian) const {
+#if defined(PROJ_API_FILE) && defined(PROJ_VERSION_MAJOR)
+    if (myProjectionMethod != NONE && myProjectionMethod != SIMPLE && cartesian.size() > 1) {
+        const Position offset = getOffsetBase();
+        const int n = (int)cartesian.size();
+        std::vector<double> x(n);
+        std::vector<double> y(n);
+        for (int i = 0; i < n; i++) {
+            x[i] = cartesian[i].x() - offset.x();
+            y[i] = cartesian[i].y() - offset.y();
+        }
+        proj_trans_generic(myProjection, PJ_INV, x.data(), sizeof(double), n, y.data(), sizeof(double), n,
+                           nullptr, 0, 0, nullptr, 0, 0);
+        for (int i = 0; i < n; i++) {
+            cartesian[i].set(proj_todeg(x[i]), proj_todeg(y[i]), cartesian[i].z() - offset.z());
+        }
+        return;
+    }
+#endif
+    for (Position& p : cartesian) {
+        cartesian2geo(p);
+    }
+}
+
+
 bool
 GeoConvHelper::x2cartesian(Position& from, bool includeInBoundary) {
     if (includeInBoundary) {
@@ -448,6 +474,67 @@ GeoConvHelper::x2cartesian(Position& from, bool includeInBoundary) {
 }
 
 
+bool
+GeoConvHelper::x2cartesian(PositionVector& shape, bool includeInBoundary) {
+    if (shape.empty()) {
+        return true;
+    }
+    // the first point initializes the projection
+    bool ok = x2cartesian(shape.front(), includeInBoundary);
+#if defined(PROJ_API_FILE) && defined(PROJ_VERSION_MAJOR)
+    if (myProjection != nullptr && myInverseProjection == nullptr && !myUseInverseProjection) {
+        std::vector<PJ_COORD> coords;
+        std::vector<int> indices;
+        coords.reserve(shape.size() - 1);
+        indices.reserve(shape.size() - 1);
+        for (int i = 1; i < (int)shape.size(); i++) {
+            if (includeInBoundary) {
+                myOrigBoundary.add(shape[i]);
+            }
+            const double x2 = shape[i].x() * myGeoScale;
+            const double y2 = shape[i].y() * myGeoScale;
+            const double x = x2 * myCos - y2 * mySin;
+            const double y = x2 * mySin + y2 * myCos;
+            if (x > 180.1 || x < -180.1) {
+                WRITE_WARNING("Invalid longitude " + toString(x));
+                ok = false;
+            } else if (y > 90.1 || y < -90.1) {
+                WRITE_WARNING("Invalid latitude " + toString(y));
+                ok = false;
+            } else {
+                coords.push_back(proj_coord(proj_torad(x), proj_torad(y), 0, 0));
+                indices.push_back(i);
+            }
+        }
+        proj_trans_array(myProjection, PJ_FWD, coords.size(), coords.data());
+        for (int k = 0; k < (int)indices.size(); k++) {
+            const double x = coords[k].xy.x;
+            const double y = coords[k].xy.y;
+            if (x > std::numeric_limits<double>::max() ||
+                    y > std::numeric_limits<double>::max()) {
+                ok = false;
+                continue;
+            }
+            Position& p = shape[indices[k]];
+            p.set(x, y);
+            p.add(myOffset);
+            if (myFlatten) {
+                p.setz(0);
+            }
+            if (includeInBoundary) {
+                myConvBoundary.add(p);
+            }
+        }
+        return ok;
+    }
+#endif
+    for (int i = 1; i < (int)shape.size(); i++) {
+        ok &= x2cartesian(shape[i], includeInBoundary);
+    }
+    return ok;
+}
+
+
 bool
 GeoConvHelper::x2cartesian_const(Position& from) const {
     double x2 = from.x() * myGeoScale;
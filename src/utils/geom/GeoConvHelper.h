@@ -118,11 +118,22 @@ public:
     /// @brief Converts the given cartesian (shifted) position to its geo (lat/long) representation
     void cartesian2geo(Position& cartesian) const;
 
+    /**@brief Converts all given cartesian (shifted) positions to their geo (lat/long) representation
+     * @note: the geo projection is applied to all positions in one call if possible
+     */
+    void cartesian2geo(PositionVector& cartesian) const;
+
     /**@brief Converts the given coordinate into a cartesian and optionally update myConvBoundary
      * @note: initializes UTM / DHDN projection on first use (select zone)
      */
     bool x2cartesian(Position& from, bool includeInBoundary = true);
 
+    /**@brief Converts all coordinates of the given shape (equivalent to converting them one by one)
+     * @note: the geo projection is applied to the whole shape in one call if possible
+     * @return whether all coordinates could be converted
+     */
+    bool x2cartesian(PositionVector& shape, bool includeInBoundary = true);
+
     /// @brief Converts the given coordinate into a cartesian using the previous initialisation
     bool x2cartesian_const(Position& from) const;
 
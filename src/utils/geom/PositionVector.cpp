@@ -1082,12 +1082,19 @@ PositionVector::removeClosest(const Position& p) {
 std::vector<double>
 PositionVector::intersectsAtLengths2D(const PositionVector& other) const {
     std::vector<double> ret;
-    if (other.size() == 0) {
+    if (other.size() == 0 || size() == 0) {
         return ret;
     }
+    // segments of other which do not touch the bounding box of this cannot intersect
+    // (the margin is far larger than the tolerances used by intersects)
+    Boundary box = getBoxBoundary();
+    box.grow(POSITION_EPS);
     for (const_iterator i = other.begin(); i != other.end() - 1; i++) {
-        std::vector<double> atSegment = intersectsAtLengths2D(*i, *(i + 1));
-        copy(atSegment.begin(), atSegment.end(), back_inserter(ret));
+        if (MAX2((*i).x(), (*(i + 1)).x()) < box.xmin() || MIN2((*i).x(), (*(i + 1)).x()) > box.xmax()
+                || MAX2((*i).y(), (*(i + 1)).y()) < box.ymin() || MIN2((*i).y(), (*(i + 1)).y()) > box.ymax()) {
+            continue;
+        }
+        addIntersectionsAtLengths2D(*i, *(i + 1), ret);
     }
     return ret;
 }
@@ -1099,17 +1106,31 @@ PositionVector::intersectsAtLengths2D(const Position& lp1, const Position& lp2)
     if (size() == 0) {
         return ret;
     }
+    addIntersectionsAtLengths2D(lp1, lp2, ret);
+    return ret;
+}
+
+
+void
+PositionVector::addIntersectionsAtLengths2D(const Position& lp1, const Position& lp2, std::vector<double>& into) const {
+    const double lxmin = MIN2(lp1.x(), lp2.x()) - POSITION_EPS;
+    const double lxmax = MAX2(lp1.x(), lp2.x()) + POSITION_EPS;
+    const double lymin = MIN2(lp1.y(), lp2.y()) - POSITION_EPS;
+    const double lymax = MAX2(lp1.y(), lp2.y()) + POSITION_EPS;
     double pos = 0;
     for (const_iterator i = begin(); i != end() - 1; i++) {
         const Position& p1 = *i;
         const Position& p2 = *(i + 1);
-        double x, y, m;
-        if (intersects(p1, p2, lp1, lp2, 0., &x, &y, &m)) {
-            ret.push_back(Position(x, y).distanceTo2D(p1) + pos);
+        // skip the full test for segments which are clearly apart
+        if (MAX2(p1.x(), p2.x()) >= lxmin && MIN2(p1.x(), p2.x()) <= lxmax
+                && MAX2(p1.y(), p2.y()) >= lymin && MIN2(p1.y(), p2.y()) <= lymax) {
+            double x, y, m;
+            if (intersects(p1, p2, lp1, lp2, 0., &x, &y, &m)) {
+                into.push_back(Position(x, y).distanceTo2D(p1) + pos);
+            }
         }
         pos += p1.distanceTo2D(p2);
     }
-    return ret;
 }
 
 
@@ -448,6 +448,9 @@ public:
     bool isClockwiseOriented(void);
 
 private:
+    /// @brief appends the 2D-lengths of all intersections between this vector and the line (this vector must not be empty)
+    void addIntersectionsAtLengths2D(const Position& lp1, const Position& lp2, std::vector<double>& into) const;
+
     /// @brief return whether the line segments defined by Line p11,p12 and Line p21,p22 intersect
     static bool intersects(const Position& p11, const Position& p12, const Position& p21, const Position& p22, const double withinDist = 0., double* x = 0, double* y = 0, double* mu = 0);
 };
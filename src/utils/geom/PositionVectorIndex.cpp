@@ -0,0 +1,219 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    PositionVectorIndex.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Precomputed lengths and segment bounds for fast queries on a fixed shape
+/****************************************************************************/
+#include <config.h>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <utils/common/StdDefs.h>
+#include "GeomHelper.h"
+#include "PositionVectorIndex.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const int PositionVectorIndex::BLOCK_SIZE = 16;
+
+/// @brief guards building the indices (which happens only once per shape)
+static std::mutex myBuildMutex;
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+PositionVectorIndex::PositionVectorIndex(const PositionVector& shape) :
+    myShape(shape),
+    myAmBuilt(false) {
+}
+
+
+void
+PositionVectorIndex::update() {
+    std::lock_guard<std::mutex> lock(myBuildMutex);
+    myAmBuilt.store(false, std::memory_order_release);
+    std::vector<double>().swap(myLengths);
+    std::vector<double>().swap(myLengths2D);
+    std::vector<Boundary>().swap(myBlocks);
+}
+
+
+void
+PositionVectorIndex::build() const {
+    std::lock_guard<std::mutex> lock(myBuildMutex);
+    if (myAmBuilt.load(std::memory_order_relaxed)) {
+        // another thread was faster
+        return;
+    }
+    const PositionVector& shape = myShape;
+    myLengths.clear();
+    myLengths2D.clear();
+    myBlocks.clear();
+    if (shape.empty()) {
+        myAmBuilt.store(true, std::memory_order_release);
+        return;
+    }
+    myLengths.reserve(shape.size());
+    myLengths2D.reserve(shape.size());
+    // accumulate in the same order as PositionVector does to get identical offsets
+    double len = 0.;
+    double len2D = 0.;
+    myLengths.push_back(len);
+    myLengths2D.push_back(len2D);
+    for (PositionVector::const_iterator i = shape.begin(); i != shape.end() - 1; i++) {
+        len += (*i).distanceTo(*(i + 1));
+        len2D += (*i).distanceTo2D(*(i + 1));
+        myLengths.push_back(len);
+        myLengths2D.push_back(len2D);
+    }
+    const int numSegments = (int)shape.size() - 1;
+    if (numSegments > 2 * BLOCK_SIZE) {
+        for (int start = 0; start < numSegments; start += BLOCK_SIZE) {
+            Boundary b;
+            const int end = MIN2(numSegments, start + BLOCK_SIZE);
+            for (int i = start; i <= end; i++) {
+                b.add(*(shape.begin() + i));
+            }
+            myBlocks.push_back(b);
+        }
+    }
+    myAmBuilt.store(true, std::memory_order_release);
+}
+
+
+int
+PositionVectorIndex::findSegment(const std::vector<double>& lengths, const double pos) {
+    // the segment i ends at lengths[i + 1], the first segment ending beyond pos contains it
+    const std::vector<double>::const_iterator it = std::upper_bound(lengths.begin() + 1, lengths.end(), pos);
+    if (it == lengths.end()) {
+        return -1;
+    }
+    return (int)(it - lengths.begin()) - 1;
+}
+
+
+Position
+PositionVectorIndex::positionAtOffset(double pos, double lateralOffset) const {
+    ensureBuilt();
+    if (myShape.size() < 2) {
+        return myShape.positionAtOffset(pos, lateralOffset);
+    }
+    const int index = findSegment(myLengths, pos);
+    const PositionVector::const_iterator i = myShape.begin() + (index < 0 ? (int)myShape.size() - 2 : index);
+    if (index >= 0) {
+        return PositionVector::positionAtOffset(*i, *(i + 1), pos - myLengths[index], lateralOffset);
+    }
+    if (lateralOffset == 0) {
+        return myShape.back();
+    }
+    return PositionVector::positionAtOffset(*i, *(i + 1), (*i).distanceTo(*(i + 1)), lateralOffset);
+}
+
+
+Position
+PositionVectorIndex::positionAtOffset2D(double pos, double lateralOffset) const {
+    ensureBuilt();
+    if (myShape.size() < 2) {
+        return myShape.positionAtOffset2D(pos, lateralOffset);
+    }
+    const int index = findSegment(myLengths2D, pos);
+    if (index < 0) {
+        return myShape.back();
+    }
+    const PositionVector::const_iterator i = myShape.begin() + index;
+    return PositionVector::positionAtOffset2D(*i, *(i + 1), pos - myLengths2D[index], lateralOffset);
+}
+
+
+double
+PositionVectorIndex::rotationAtOffset(double pos) const {
+    ensureBuilt();
+    if (myShape.size() < 2) {
+        return INVALID_DOUBLE;
+    }
+    if (pos < 0) {
+        pos += myLengths.back();
+    }
+    const int index = findSegment(myLengths, pos);
+    const PositionVector::const_iterator i = myShape.begin() + (index < 0 ? (int)myShape.size() - 2 : index);
+    return (*i).angleTo2D(*(i + 1));
+}
+
+
+double
+PositionVectorIndex::nearest_offset_to_point2D(const Position& p, bool perpendicular) const {
+    ensureBuilt();
+    if (myBlocks.empty()) {
+        return myShape.nearest_offset_to_point2D(p, perpendicular);
+    }
+    // the loop of PositionVector::nearest_offset_to_point2D, skipping the blocks which cannot improve the result
+    const PositionVector::const_iterator begin = myShape.begin();
+    const int numSegments = (int)myShape.size() - 1;
+    double minDist = std::numeric_limits<double>::max();
+    double nearestPos = GeomHelper::INVALID_OFFSET;
+    for (int block = 0; block < (int)myBlocks.size(); block++) {
+        if (minDist < std::numeric_limits<double>::max()) {
+            // the margin covers the rounding of the distances computed below
+            const double lowerBound = MAX2(0., myBlocks[block].distanceTo2D(p) - NUMERICAL_EPS);
+            if (lowerBound * lowerBound > minDist) {
+                continue;
+            }
+        }
+        const int end = MIN2(numSegments, (block + 1) * BLOCK_SIZE);
+        for (int index = block * BLOCK_SIZE; index < end; index++) {
+            const PositionVector::const_iterator i = begin + index;
+            const double pos = GeomHelper::nearest_offset_on_line_to_point2D(*i, *(i + 1), p, perpendicular);
+            const double dist2 = pos == GeomHelper::INVALID_OFFSET ? minDist : p.distanceSquaredTo2D(PositionVector::positionAtOffset2D(*i, *(i + 1), pos));
+            if (dist2 < minDist) {
+                nearestPos = pos + myLengths2D[index];
+                minDist = dist2;
+            }
+            if (perpendicular && index != 0 && pos == GeomHelper::INVALID_OFFSET) {
+                // even if perpendicular is set we still need to check the distance to the inner points
+                const double cornerDist2 = p.distanceSquaredTo2D(*i);
+                if (cornerDist2 < minDist) {
+                    const double pos1 = GeomHelper::nearest_offset_on_line_to_point2D(*(i - 1), *i, p, false);
+                    const double pos2 = GeomHelper::nearest_offset_on_line_to_point2D(*i, *(i + 1), p, false);
+                    if (pos1 == (*(i - 1)).distanceTo2D(*i) && pos2 == 0.) {
+                        nearestPos = myLengths2D[index];
+                        minDist = cornerDist2;
+                    }
+                }
+            }
+        }
+    }
+    return nearestPos;
+}
+
+
+double
+PositionVectorIndex::distance2D(const Position& p, bool perpendicular) const {
+    if (myShape.size() < 2) {
+        return myShape.distance2D(p, perpendicular);
+    }
+    const double nearestOffset = nearest_offset_to_point2D(p, perpendicular);
+    if (nearestOffset == GeomHelper::INVALID_OFFSET) {
+        return GeomHelper::INVALID_OFFSET;
+    }
+    return p.distanceTo2D(positionAtOffset2D(nearestOffset));
+}
+
+
+/****************************************************************************/
@@ -0,0 +1,118 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    PositionVectorIndex.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Precomputed lengths and segment bounds for fast queries on a fixed shape
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <atomic>
+#include <vector>
+#include "Boundary.h"
+#include "PositionVector.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class PositionVectorIndex
+ * @brief Answers offset and distance queries on a shape which does not change anymore
+ *
+ * The cumulative (2D and 3D) lengths of the shape are stored, so that finding
+ *  the segment for an offset is a binary search instead of a linear scan. For
+ *  long shapes the bounding boxes of blocks of consecutive segments are kept as
+ *  well and blocks which are farther away than the best segment found so far are
+ *  skipped. All methods return exactly the same values as the PositionVector
+ *  methods of the same name.
+ *
+ * The index is built on the first query (thread safe), so shapes which are
+ *  never queried (e.g. lanes which are not used by the demand) do not need any
+ *  memory for it.
+ *
+ * The shape is referenced and must not be destroyed while the index is in use.
+ *  If the shape gets modified, update() needs to be called.
+ */
+class PositionVectorIndex {
+public:
+    /// @brief Constructor
+    PositionVectorIndex(const PositionVector& shape);
+
+    /// @brief discards the index after the shape was modified (it is rebuilt on the next query)
+    void update();
+
+    /// @brief whether the index was built already
+    bool isBuilt() const {
+        return myAmBuilt.load(std::memory_order_acquire);
+    }
+
+    /// @brief the indexed shape
+    const PositionVector& getShape() const {
+        return myShape;
+    }
+
+    /// @brief see PositionVector::positionAtOffset
+    Position positionAtOffset(double pos, double lateralOffset = 0) const;
+
+    /// @brief see PositionVector::positionAtOffset2D
+    Position positionAtOffset2D(double pos, double lateralOffset = 0) const;
+
+    /// @brief see PositionVector::rotationAtOffset
+    double rotationAtOffset(double pos) const;
+
+    /// @brief see PositionVector::nearest_offset_to_point2D
+    double nearest_offset_to_point2D(const Position& p, bool perpendicular = true) const;
+
+    /// @brief see PositionVector::distance2D
+    double distance2D(const Position& p, bool perpendicular = false) const;
+
+private:
+    /// @brief builds the index if this did not happen yet
+    inline void ensureBuilt() const {
+        if (!myAmBuilt.load(std::memory_order_acquire)) {
+            build();
+        }
+    }
+
+    /// @brief computes the lengths and the block bounds
+    void build() const;
+
+    /// @brief the index of the segment containing the offset (given the cumulative lengths) or -1 if it is beyond the end
+    static int findSegment(const std::vector<double>& lengths, const double pos);
+
+    /// @brief the indexed shape
+    const PositionVector& myShape;
+
+    /// @brief whether the members below are computed
+    mutable std::atomic<bool> myAmBuilt;
+
+    /// @brief the 3D lengths from the start up to each geometry point
+    mutable std::vector<double> myLengths;
+
+    /// @brief the 2D lengths from the start up to each geometry point
+    mutable std::vector<double> myLengths2D;
+
+    /// @brief the bounding boxes of blocks of BLOCK_SIZE segments (empty for short shapes)
+    mutable std::vector<Boundary> myBlocks;
+
+    /// @brief the number of segments per block
+    static const int BLOCK_SIZE;
+
+private:
+    /// @brief Invalidated assignment operator.
+    PositionVectorIndex& operator=(const PositionVectorIndex&) = delete;
+};
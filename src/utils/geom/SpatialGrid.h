@@ -0,0 +1,180 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    SpatialGrid.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// A uniform grid for neighbor searches among objects which move every step
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <algorithm>
+#include <vector>
+#include <utils/common/StdDefs.h>
+#include "Boundary.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class SpatialGrid
+ * @brief A uniform grid over the bounding boxes of items for fast neighbor searches
+ *
+ * The grid is meant to be rebuilt every simulation step: add all items, call
+ *  build() and run the queries. Building is linear in the number of items (the
+ *  cells are stored contiguously) and the number of cells is limited to a few
+ *  per item, so sparse items spread over a large network do not allocate a
+ *  huge grid. Queries are const and may be run from several threads at once.
+ *  They return item indices in ascending order, so results do not depend on
+ *  memory layout.
+ */
+template<class T>
+class SpatialGrid {
+public:
+    /// @brief Constructor
+    SpatialGrid() : myCellSize(1.), myNumX(0), myNumY(0) {}
+
+    /// @brief removes all items (the allocated memory is kept for the next step)
+    void clear() {
+        myItems.clear();
+        myBounds.reset();
+        myCellStart.clear();
+        myCellItems.clear();
+    }
+
+    /// @brief adds an item with the given bounding box, build() needs to be called before the next query
+    void add(const Boundary& b, const T& item) {
+        myItems.push_back(std::make_pair(b, item));
+        myBounds.add(b);
+    }
+
+    /// @brief the number of items
+    int size() const {
+        return (int)myItems.size();
+    }
+
+    /// @brief the item with the given index
+    const T& getItem(const int index) const {
+        return myItems[index].second;
+    }
+
+    /// @brief the bounding box of the item with the given index
+    const Boundary& getBoundary(const int index) const {
+        return myItems[index].first;
+    }
+
+    /** @brief sorts the items into cells
+     * @param[in] cellSize The preferred cell size, typically the query range
+     */
+    void build(double cellSize) {
+        myCellStart.clear();
+        myCellItems.clear();
+        if (myItems.empty()) {
+            myNumX = myNumY = 0;
+            return;
+        }
+        myCellSize = MAX2(cellSize, POSITION_EPS);
+        const double maxCells = MAX2(16., 4. * (double)myItems.size());
+        while ((myBounds.getWidth() / myCellSize + 1) * (myBounds.getHeight() / myCellSize + 1) > maxCells) {
+            myCellSize *= 2;
+        }
+        myNumX = (int)(myBounds.getWidth() / myCellSize) + 1;
+        myNumY = (int)(myBounds.getHeight() / myCellSize) + 1;
+        // count the items per cell, convert to start indices and fill
+        myCellStart.assign(myNumX * myNumY + 1, 0);
+        int x0, x1, y0, y1;
+        for (const auto& item : myItems) {
+            getCells(item.first, x0, x1, y0, y1);
+            for (int y = y0; y <= y1; y++) {
+                for (int x = x0; x <= x1; x++) {
+                    myCellStart[y * myNumX + x + 1]++;
+                }
+            }
+        }
+        for (int i = 1; i < (int)myCellStart.size(); i++) {
+            myCellStart[i] += myCellStart[i - 1];
+        }
+        myCellItems.resize(myCellStart.back());
+        std::vector<int> fill(myCellStart.begin(), myCellStart.end() - 1);
+        for (int index = 0; index < (int)myItems.size(); index++) {
+            getCells(myItems[index].first, x0, x1, y0, y1);
+            for (int y = y0; y <= y1; y++) {
+                for (int x = x0; x <= x1; x++) {
+                    myCellItems[fill[y * myNumX + x]++] = index;
+                }
+            }
+        }
+    }
+
+    /** @brief collects the indices of all items whose bounding box overlaps the given one
+     * @param[in] b The boundary to search
+     * @param[out] into The sorted indices, the vector is cleared first
+     */
+    void query(const Boundary& b, std::vector<int>& into) const {
+        into.clear();
+        if (myNumX == 0 || b.xmax() < myBounds.xmin() || b.xmin() > myBounds.xmax()
+                || b.ymax() < myBounds.ymin() || b.ymin() > myBounds.ymax()) {
+            return;
+        }
+        int x0, x1, y0, y1;
+        getCells(b, x0, x1, y0, y1);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                const int cell = y * myNumX + x;
+                for (int i = myCellStart[cell]; i < myCellStart[cell + 1]; i++) {
+                    const Boundary& ib = myItems[myCellItems[i]].first;
+                    if (ib.xmin() <= b.xmax() && ib.xmax() >= b.xmin() && ib.ymin() <= b.ymax() && ib.ymax() >= b.ymin()) {
+                        into.push_back(myCellItems[i]);
+                    }
+                }
+            }
+        }
+        // items spanning several cells are found more than once
+        std::sort(into.begin(), into.end());
+        into.erase(std::unique(into.begin(), into.end()), into.end());
+    }
+
+private:
+    /// @brief the range of cells covered by the given boundary (clipped to the grid)
+    void getCells(const Boundary& b, int& x0, int& x1, int& y0, int& y1) const {
+        x0 = clampCell((b.xmin() - myBounds.xmin()) / myCellSize, myNumX);
+        x1 = clampCell((b.xmax() - myBounds.xmin()) / myCellSize, myNumX);
+        y0 = clampCell((b.ymin() - myBounds.ymin()) / myCellSize, myNumY);
+        y1 = clampCell((b.ymax() - myBounds.ymin()) / myCellSize, myNumY);
+    }
+
+    static int clampCell(const double pos, const int num) {
+        return pos <= 0. ? 0 : MIN2((int)pos, num - 1);
+    }
+
+    /// @brief the items with their bounding boxes
+    std::vector<std::pair<Boundary, T> > myItems;
+
+    /// @brief the bounding box of all items
+    Boundary myBounds;
+
+    /// @brief the used cell size
+    double myCellSize;
+
+    /// @brief the number of cells in x and y direction
+    int myNumX, myNumY;
+
+    /// @brief the index of the first item index of each cell in myCellItems (plus the end index)
+    std::vector<int> myCellStart;
+
+    /// @brief the item indices sorted by cell
+    std::vector<int> myCellItems;
+};
@@ -579,6 +579,24 @@ GLHelper::drawTriangleAtEnd(const Position& p1, const Position& p2, double tLeng
 }
 
 
+void
+GLHelper::drawTriangles(const std::vector<double>& vertices, const std::vector<unsigned char>& colors) {
+    if (vertices.empty()) {
+        return;
+    }
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_DOUBLE, 0, vertices.data());
+    glColorPointer(4, GL_UNSIGNED_BYTE, 0, colors.data());
+    glDrawArrays(GL_TRIANGLES, 0, (GLsizei)(vertices.size() / 3));
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+#ifdef CHECK_ELEMENTCOUNTER
+    myVertexCounter += (int)(vertices.size() / 3);
+#endif
+}
+
+
 void
 GLHelper::setColor(const RGBColor& c) {
     glColor4ub(c.red(), c.green(), c.blue(), c.alpha());
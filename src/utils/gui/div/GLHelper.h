@@ -309,6 +309,13 @@ public:
     static void drawTriangleAtEnd(const Position& p1, const Position& p2, double tLength,
                                   double tWidth, const double extraOffset = 0);
 
+    /** @brief Draws the given triangles with a single call (vertex arrays)
+     *
+     * @param[in] vertices The x, y and z coordinates of the corners, three corners per triangle
+     * @param[in] colors The red, green, blue and alpha values for every corner
+     */
+    static void drawTriangles(const std::vector<double>& vertices, const std::vector<unsigned char>& colors);
+
     /// @brief Sets the gl-color to this value
     static void setColor(const RGBColor& c);
 
@@ -25,6 +25,7 @@
 #include <string>
 #include <stack>
 #include <utils/common/MsgHandler.h>
+#include <utils/common/PerformanceCounters.h>
 #include <utils/common/ToString.h>
 #include <utils/geom/GeoConvHelper.h>
 #include <utils/gui/windows/GUISUMOAbstractView.h>
@@ -163,10 +164,12 @@ GUIGlObject::GUIGlObject(GUIGlObjectType type, const std::string& microsimID, FX
     assert(myGLObjectType != GLO_ADDITIONALELEMENT);
     myFullName = createFullName();
     GUIGlObjectStorage::gIDStorage.changeName(this, myFullName);
+    PerformanceCounters::added(PerformanceCounters::GUI, sizeof(GUIGlObject));
 }
 
 
 GUIGlObject::~GUIGlObject() {
+    PerformanceCounters::removed(PerformanceCounters::GUI, sizeof(GUIGlObject));
     // remove all paramWindow related with this object
     for (const auto& paramWindow : myParamWindows) {
         paramWindow->removeObject(this);
@@ -53,6 +53,7 @@ GUIShapeContainer::addPOI(const std::string& id, const std::string& type, const
         if (myAllowReplacement) {
             GUIPointOfInterest* oldP = dynamic_cast<GUIPointOfInterest*>(myPOIs.get(id));
             myVis.removeAdditionalGLObject(oldP);
+            unindexPOI(oldP);
             myPOIs.remove(id);
             myPOIs.add(id, p);
             WRITE_WARNINGF(TL("Replacing POI '%'"), id);
@@ -62,6 +63,7 @@ GUIShapeContainer::addPOI(const std::string& id, const std::string& type, const
         }
     }
     myVis.addAdditionalGLObject(p);
+    indexPOI(p);
     return true;
 }
 
@@ -78,6 +80,7 @@ GUIShapeContainer::addPolygon(const std::string& id, const std::string& type,
         if (myAllowReplacement) {
             GUIPolygon* oldP = dynamic_cast<GUIPolygon*>(myPolygons.get(id));
             myVis.removeAdditionalGLObject(oldP);
+            unindexPolygon(oldP);
             myPolygons.remove(id);
             myPolygons.add(id, p);
             WRITE_WARNINGF(TL("Replacing polygon '%'"), id);
@@ -89,6 +92,7 @@ GUIShapeContainer::addPolygon(const std::string& id, const std::string& type,
     bool state = myInactivePolygonTypes.empty() || (std::find(myInactivePolygonTypes.begin(), myInactivePolygonTypes.end(), type) == myInactivePolygonTypes.end());
     p->activate(state);
     myVis.addAdditionalGLObject(p);
+    indexPolygon(p);
     return true;
 }
 
@@ -149,6 +153,7 @@ GUIShapeContainer::removePOI(const std::string& id) {
         return false;
     }
     myVis.removeAdditionalGLObject(p);
+    unindexPOI(p);
     return myPOIs.remove(id);
 }
 
@@ -159,8 +164,10 @@ GUIShapeContainer::movePOI(const std::string& id, const Position& pos) {
     GUIPointOfInterest* p = dynamic_cast<GUIPointOfInterest*>(myPOIs.get(id));
     if (p != nullptr) {
         myVis.removeAdditionalGLObject(p);
+        unindexPOI(p);
         static_cast<Position*>(p)->set(pos);
         myVis.addAdditionalGLObject(p);
+        indexPOI(p);
     }
 }
 
@@ -171,8 +178,10 @@ GUIShapeContainer::reshapePolygon(const std::string& id, const PositionVector& s
     GUIPolygon* p = dynamic_cast<GUIPolygon*>(myPolygons.get(id));
     if (p != nullptr) {
         myVis.removeAdditionalGLObject(p);
+        unindexPolygon(p);
         p->setShape(shape);
         myVis.addAdditionalGLObject(p);
+        indexPolygon(p);
     }
 }
 
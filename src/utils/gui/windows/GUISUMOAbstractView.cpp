@@ -157,6 +157,7 @@ GUISUMOAbstractView::GUISUMOAbstractView(FXComposite* p, GUIMainWindow& app, GUI
 
 
 GUISUMOAbstractView::~GUISUMOAbstractView() {
+    finishSnapshotWrites();
     gSchemeStorage.setDefault(myVisualizationSettings->name);
     gSchemeStorage.saveViewport(myChanger->getXPos(), myChanger->getYPos(), myChanger->getZPos(), myChanger->getRotation());
     gSchemeStorage.saveDecals(myDecals);
@@ -1374,7 +1375,7 @@ GUISUMOAbstractView::addSnapshot(SUMOTime time, const std::string& file, const i
 
 
 std::string
-GUISUMOAbstractView::makeSnapshot(const std::string& destFile, const int w, const int h) {
+GUISUMOAbstractView::makeSnapshot(const std::string& destFile, const int w, const int h, const bool background) {
     if (w >= 0) {
         resize(w, h);
         repaint();
@@ -1499,6 +1500,17 @@ GUISUMOAbstractView::makeSnapshot(const std::string& destFile, const int w, cons
                 *pb++ = t;
             } while (pa < paa);
         } while (paa < pbb);
+#ifdef HAVE_FFMPEG
+        const bool writeInBackground = background && !useVideo && mySnapshotWriters.size() > 0;
+#else
+        const bool writeInBackground = background && mySnapshotWriters.size() > 0;
+#endif
+        if (writeInBackground) {
+            // the writer frees the buffer
+            myPendingSnapshotWrites.push_back(new SnapshotWriter(destFile, getWidth(), getHeight(), buf));
+            mySnapshotWriters.add(myPendingSnapshotWrites.back());
+            return errorMessage;
+        }
         try {
 #ifdef HAVE_FFMPEG
             if (useVideo) {
@@ -1522,6 +1534,34 @@ GUISUMOAbstractView::makeSnapshot(const std::string& destFile, const int w, cons
 }
 
 
+void
+GUISUMOAbstractView::SnapshotWriter::run(MFXWorkerThread* /* context */) {
+    try {
+        if (!MFXImageHelper::saveImage(myFile, myWidth, myHeight, myBuffer)) {
+            myError = "Could not save '" + myFile + "'.";
+        }
+    } catch (InvalidArgument& e) {
+        myError = "Could not save '" + myFile + "'.\n" + e.what();
+    }
+}
+
+
+void
+GUISUMOAbstractView::finishSnapshotWrites() {
+    if (myPendingSnapshotWrites.empty()) {
+        return;
+    }
+    mySnapshotWriters.waitAll(false);
+    for (SnapshotWriter* const writer : myPendingSnapshotWrites) {
+        if (writer->getError() != "") {
+            WRITE_WARNING(writer->getError());
+        }
+        delete writer;
+    }
+    myPendingSnapshotWrites.clear();
+}
+
+
 void
 GUISUMOAbstractView::saveFrame(const std::string& destFile, FXColor* buf) {
     UNUSED_PARAMETER(destFile);
@@ -1542,12 +1582,20 @@ GUISUMOAbstractView::checkSnapshots() {
     }
     std::vector<std::tuple<std::string, int, int> > files = snapIt->second;
     lock.unlock();
+    // the images of the previous snapshot time were written while the simulation continued
+    finishSnapshotWrites();
+    const OptionsCont& oc = OptionsCont::getOptions();
+    if (mySnapshotWriters.size() == 0 && oc.exists("snapshot-threads")) {
+        for (int i = 0; i < oc.getInt("snapshot-threads"); i++) {
+            new MFXWorkerThread(mySnapshotWriters);
+        }
+    }
     // decouple map access and painting to avoid deadlock
     for (const auto& entry : files) {
 #ifdef DEBUG_SNAPSHOT
         std::cout << "make snapshot time=" << time << " file=" << file << "\n";
 #endif
-        const std::string& error = makeSnapshot(std::get<0>(entry), std::get<1>(entry), std::get<2>(entry));
+        const std::string& error = makeSnapshot(std::get<0>(entry), std::get<1>(entry), std::get<2>(entry), true);
         if (error != "" && error != "video") {
             WRITE_WARNING(error);
         }
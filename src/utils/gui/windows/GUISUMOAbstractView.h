@@ -40,6 +40,7 @@
 #include <utils/geom/Position.h>
 #include <utils/common/RGBColor.h>
 #include <utils/common/SUMOTime.h>
+#include <utils/foxtools/MFXWorkerThread.h>
 #include <utils/gui/globjects/GUIGlObjectTypes.h>
 #include <foreign/rtree/SUMORTree.h>
 
@@ -203,9 +204,13 @@ public:
      * @param[in] destFile The name of the file to write the snapshot into
      * @param[in] w The snapshot image width
      * @param[in] w The snapshot image height
+     * @param[in] background Whether image files may be written by the snapshot writer threads (see finishSnapshotWrites)
      * @return The error message, if an error occurred; "" otherwise
      */
-    std::string makeSnapshot(const std::string& destFile, const int w = -1, const int h = -1);
+    std::string makeSnapshot(const std::string& destFile, const int w = -1, const int h = -1, const bool background = false);
+
+    /// @brief waits for the snapshot images written in the background and reports their errors
+    void finishSnapshotWrites();
 
     /// @brief Adds a frame to a video snapshot which will be initialized if necessary
     virtual void saveFrame(const std::string& destFile, FXColor* buf);
@@ -604,6 +609,42 @@ protected:
     /// @brief the semaphore when waiting for snapshots to finish
     FXCondition mySnapshotCondition;
 
+    /// @brief Encodes and writes a rendered snapshot image in a background thread
+    class SnapshotWriter : public MFXWorkerThread::Task {
+    public:
+        /// @brief Constructor taking ownership of the pixel buffer
+        SnapshotWriter(const std::string& file, const int width, const int height, FXColor* buf) :
+            myFile(file), myWidth(width), myHeight(height), myBuffer(buf) {}
+
+        ~SnapshotWriter() {
+            FXFREE(&myBuffer);
+        }
+
+        void run(MFXWorkerThread* context);
+
+        /// @brief the error message, if writing failed; "" otherwise
+        const std::string& getError() const {
+            return myError;
+        }
+
+    private:
+        const std::string myFile;
+        const int myWidth;
+        const int myHeight;
+        FXColor* myBuffer;
+        std::string myError;
+
+    private:
+        /// @brief Invalidated assignment operator.
+        SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+    };
+
+    /// @brief The threads writing snapshot images (option --snapshot-threads)
+    MFXWorkerThread::Pool mySnapshotWriters;
+
+    /// @brief The snapshot images which are written in the background
+    std::vector<SnapshotWriter*> myPendingSnapshotWrites;
+
     /// @brief poly draw lock
     mutable FXMutex myPolyDrawLock;
 
@@ -64,16 +64,10 @@ NamedColumnsParser::parseLine(const std::string& line) {
 
 std::string
 NamedColumnsParser::get(const std::string& name, bool prune) const {
-    PosMap::const_iterator i = myDefinitionsMap.find(name);
-    if (i == myDefinitionsMap.end()) {
-        if (myAmCaseInsensitive) {
-            i = myDefinitionsMap.find(StringUtils::to_lower_case(name));
-        }
-        if (i == myDefinitionsMap.end()) {
-            throw UnknownElement("Element '" + name + "' is missing");
-        }
+    const int pos = getPosition(name);
+    if (pos < 0) {
+        throw UnknownElement("Element '" + name + "' is missing");
     }
-    int pos = (*i).second;
     if (myLineParser.size() <= pos) {
         throw OutOfBoundsException();
     }
@@ -85,17 +79,26 @@ NamedColumnsParser::get(const std::string& name, bool prune) const {
 
 bool
 NamedColumnsParser::know(const std::string& name) const {
+    const int pos = getPosition(name);
+    return pos >= 0 && myLineParser.size() > pos;
+}
+
+
+int
+NamedColumnsParser::getPosition(const std::string& name) const {
     PosMap::const_iterator i = myDefinitionsMap.find(name);
-    if (i == myDefinitionsMap.end()) {
-        if (myAmCaseInsensitive) {
-            i = myDefinitionsMap.find(StringUtils::to_lower_case(name));
-        }
+    if (i != myDefinitionsMap.end()) {
+        return i->second;
+    }
+    if (!myAmCaseInsensitive) {
+        return -1;
     }
-    if (i == myDefinitionsMap.end()) {
-        return false;
+    i = myLookupCache.find(name);
+    if (i == myLookupCache.end()) {
+        PosMap::const_iterator def = myDefinitionsMap.find(StringUtils::to_lower_case(name));
+        i = myLookupCache.insert(std::make_pair(name, def == myDefinitionsMap.end() ? -1 : def->second)).first;
     }
-    int pos = (*i).second;
-    return myLineParser.size() > pos;
+    return i->second;
 }
 
 
@@ -113,6 +116,7 @@ NamedColumnsParser::reinitMap(std::string s,
         s = StringUtils::to_lower_case(s);
     }
     myDefinitionsMap.clear();
+    myLookupCache.clear();
     int pos = 0;
     StringTokenizer st(s, delim);
     while (st.hasNext()) {
@@ -163,6 +163,14 @@ private:
     void checkPrune(std::string& str, bool prune) const;
 
 
+    /** @brief Returns the position of the named column
+     *
+     * @param[in] name The name of the column
+     * @return The position within the definition or -1 if the column is not known
+     */
+    int getPosition(const std::string& name) const;
+
+
 private:
     /** @brief The map's definition of column item names to their positions within the table */
     typedef std::map<std::string, int> PosMap;
@@ -170,6 +178,9 @@ private:
     /// @brief The map of column item names to their positions within the table
     PosMap myDefinitionsMap;
 
+    /// @brief The positions of the requested column names (avoids case conversion for every value)
+    mutable PosMap myLookupCache;
+
     /// @brief The delimiter to split the column items on
     std::string myLineDelimiter;
 
@@ -0,0 +1,124 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2012-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    BinaryFormatter.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Output formatter for the binary (pre-tokenized) XML format
+/****************************************************************************/
+#include <config.h>
+
+#include <utils/common/MsgHandler.h>
+#include <utils/common/StringUtils.h>
+#include <utils/common/UtilExceptions.h>
+#include "BinaryFormatter.h"
+
+
+// ===========================================================================
+// member method definitions
+// ===========================================================================
+BinaryFormatter::BinaryFormatter() :
+    myDepth(0) {
+}
+
+
+bool
+BinaryFormatter::isBinaryFile(const std::string& filename) {
+    return (StringUtils::endsWith(filename, ".net.bin") || StringUtils::endsWith(filename, ".net.bin.gz")
+            || StringUtils::endsWith(filename, ".sbx") || StringUtils::endsWith(filename, ".sbx.gz"));
+}
+
+
+bool
+BinaryFormatter::writeXMLHeader(std::ostream& into, const std::string& rootElement,
+                                const std::map<SumoXMLAttr, std::string>& attrs, bool /* includeConfig */) {
+    if (myDepth == 0) {
+        into << getMagic();
+        openTag(into, rootElement);
+        for (std::map<SumoXMLAttr, std::string>::const_iterator it = attrs.begin(); it != attrs.end(); ++it) {
+            writeAttrString(into, toString(it->first), it->second);
+        }
+        return true;
+    }
+    return false;
+}
+
+
+void
+BinaryFormatter::openTag(std::ostream& into, const std::string& xmlElement) {
+    into.put(EVENT_OPEN);
+    writeName(into, xmlElement);
+    myDepth++;
+}
+
+
+void
+BinaryFormatter::openTag(std::ostream& into, const SumoXMLTag& xmlElement) {
+    openTag(into, toString(xmlElement));
+}
+
+
+bool
+BinaryFormatter::closeTag(std::ostream& into, const std::string& /* comment */) {
+    if (myDepth > 0) {
+        into.put(EVENT_CLOSE);
+        myDepth--;
+        return true;
+    }
+    return false;
+}
+
+
+void
+BinaryFormatter::writePreformattedTag(std::ostream& /* into */, const std::string& /* val */) {
+    throw ProcessError(TL("Preformatted output is not supported by binary XML files."));
+}
+
+
+void
+BinaryFormatter::writePadding(std::ostream& /* into */, const std::string& /* val */) {
+}
+
+
+void
+BinaryFormatter::writeAttrString(std::ostream& into, const std::string& attr, const std::string& val) {
+    into.put(EVENT_ATTR);
+    writeName(into, attr);
+    writeString(into, val);
+}
+
+
+void
+BinaryFormatter::writeName(std::ostream& into, const std::string& name) {
+    auto it = myNames.find(name);
+    if (it == myNames.end()) {
+        const int index = (int)myNames.size();
+        myNames[name] = index;
+        into.write((const char*)&index, sizeof(int));
+        writeString(into, name);
+    } else {
+        into.write((const char*)&it->second, sizeof(int));
+    }
+}
+
+
+void
+BinaryFormatter::writeString(std::ostream& into, const std::string& val) {
+    const int size = (int)val.size();
+    into.write((const char*)&size, sizeof(int));
+    into.write(val.data(), size);
+}
+
+
+/****************************************************************************/
@@ -0,0 +1,163 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2012-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    BinaryFormatter.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Output formatter for the binary (pre-tokenized) XML format
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <map>
+#include <string>
+#include <vector>
+#include <utils/common/ToString.h>
+#include "OutputFormatter.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class BinaryFormatter
+ * @brief Output formatter for binary XML output
+ *
+ * The format stores the sequence of SAX events, so reading it needs no
+ *  tokenizing, entity handling or validation. Element and attribute names are
+ *  kept in a file global dictionary, each name is written in full only once.
+ *
+ * File layout (native byte order, int = int32):
+ *  - the magic line BinaryFormatter::getMagic() which contains the format version
+ *  - a sequence of events, each starting with one of the EVENT_* bytes
+ *  - EVENT_OPEN and EVENT_ATTR are followed by the int name index; if the index
+ *    equals the current dictionary size, the length-prefixed name follows
+ *    and extends the dictionary
+ *  - EVENT_ATTR has the length-prefixed value string after the name
+ *  - EVENT_CLOSE has no payload
+ */
+class BinaryFormatter : public OutputFormatter {
+public:
+    /// @brief event types
+    static const char EVENT_OPEN = 1;
+    static const char EVENT_ATTR = 2;
+    static const char EVENT_CLOSE = 3;
+
+    /// @brief the first line of the file (including the line feed)
+    static const char* getMagic() {
+        return "SUMO-binary-xml-1\n";
+    }
+
+    /// @brief whether the given file name requests binary output
+    static bool isBinaryFile(const std::string& filename);
+
+    /// @brief Constructor
+    BinaryFormatter();
+
+    /// @brief Destructor
+    virtual ~BinaryFormatter() { }
+
+
+    /** @brief Writes the magic line and opens the root element
+     *
+     * The configuration is not written since there is no comment in the binary format.
+     *
+     * @param[in] into The output stream to use
+     * @param[in] rootElement The root element to use
+     * @param[in] attrs Additional attributes to save within the rootElement
+     */
+    bool writeXMLHeader(std::ostream& into, const std::string& rootElement,
+                        const std::map<SumoXMLAttr, std::string>& attrs,
+                        bool includeConfig = true);
+
+
+    /** @brief Opens an XML tag
+     *
+     * @param[in] into The output stream to use
+     * @param[in] xmlElement Name of element to open
+     */
+    void openTag(std::ostream& into, const std::string& xmlElement);
+
+
+    /** @brief Opens an XML tag
+     *
+     * @param[in] into The output stream to use
+     * @param[in] xmlElement Id of the element to open
+     */
+    void openTag(std::ostream& into, const SumoXMLTag& xmlElement);
+
+
+    /** @brief Closes the most recently opened tag (comments are dropped)
+     *
+     * @param[in] into The output stream to use
+     * @return Whether a further element existed in the stack and could be closed
+     */
+    bool closeTag(std::ostream& into, const std::string& comment = "");
+
+
+    /// @brief preformatted XML cannot be represented, so this throws a ProcessError
+    void writePreformattedTag(std::ostream& into, const std::string& val);
+
+    /// @brief padding is ignored
+    void writePadding(std::ostream& into, const std::string& val);
+
+
+    /** @brief writes an arbitrary attribute
+     *
+     * @param[in] into The output stream to use
+     * @param[in] attr The attribute (name)
+     * @param[in] val The attribute value
+     */
+    template <class T>
+    void writeAttr(std::ostream& into, const std::string& attr, const T& val) {
+        writeAttrString(into, attr, toString(val, into.precision()));
+    }
+
+
+    /** @brief writes a named attribute
+     *
+     * @param[in] into The output stream to use
+     * @param[in] attr The attribute (name)
+     * @param[in] val The attribute value
+     */
+    template <class T>
+    void writeAttr(std::ostream& into, const SumoXMLAttr attr, const T& val) {
+        writeAttrString(into, toString(attr), toString(val, into.precision()));
+    }
+
+    bool wroteHeader() const {
+        return myDepth > 0;
+    }
+
+    int getDepth() const {
+        return myDepth;
+    }
+
+private:
+    /// @brief writes the attribute event with the already formatted value
+    void writeAttrString(std::ostream& into, const std::string& attr, const std::string& val);
+
+    /// @brief writes the dictionary index of the name (and the name itself if it is new)
+    void writeName(std::ostream& into, const std::string& name);
+
+    /// @brief writes a length-prefixed string
+    static void writeString(std::ostream& into, const std::string& val);
+
+private:
+    /// @brief the dictionary of element and attribute names
+    std::map<std::string, int> myNames;
+
+    /// @brief the number of open elements
+    int myDepth;
+};
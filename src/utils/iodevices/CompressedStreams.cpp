@@ -0,0 +1,244 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2004-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    CompressedStreams.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Streams for reading and writing gzip and zstd compressed files
+/****************************************************************************/
+#include <config.h>
+
+#include <cstring>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#include <foreign/zstr/zstr.hpp>
+#endif
+#include <utils/common/StringUtils.h>
+#include <utils/common/UtilExceptions.h>
+#include "CompressedStreams.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+#ifdef HAVE_ZSTD
+/// @brief the size of the uncompressed buffers
+static const size_t ZSTD_BUFFER_SIZE = 1 << 17;
+#endif
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+std::unique_ptr<std::istream>
+CompressedStreams::openInput(const std::string& file) {
+    const std::string localName = StringUtils::transcodeToLocal(file);
+#ifdef HAVE_ZSTD
+    if (isZstdFile(file)) {
+        return std::unique_ptr<std::istream>(new ZstdIFStream(localName));
+    }
+#endif
+#ifdef HAVE_ZLIB
+    return std::unique_ptr<std::istream>(new zstr::ifstream(localName.c_str(), std::fstream::in | std::fstream::binary));
+#else
+    return std::unique_ptr<std::istream>(new std::ifstream(localName.c_str(), std::fstream::in | std::fstream::binary));
+#endif
+}
+
+
+bool
+CompressedStreams::isZstdFile(const std::string& file) {
+    std::ifstream strm(StringUtils::transcodeToLocal(file).c_str(), std::fstream::in | std::fstream::binary);
+    unsigned char magic[4];
+    strm.read((char*)magic, sizeof(magic));
+    return strm.gcount() == (std::streamsize)sizeof(magic) && magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD;
+}
+
+
+bool
+CompressedStreams::hasZstdSuffix(const std::string& file) {
+    return StringUtils::endsWith(file, ".zst");
+}
+
+
+#ifdef HAVE_ZLIB
+void
+CompressedStreams::gzipMember(const std::string& data, std::string& into) {
+    z_stream strm;
+    std::memset(&strm, 0, sizeof(strm));
+    // 16 added to the window bits gives a gzip header and trailer
+    if (deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw IOError(TL("Could not initialize the gzip compression."));
+    }
+    into.resize(deflateBound(&strm, (uLong)data.size()));
+    strm.next_in = (Bytef*)data.data();
+    strm.avail_in = (uInt)data.size();
+    strm.next_out = (Bytef*)&into[0];
+    strm.avail_out = (uInt)into.size();
+    const int ret = deflate(&strm, Z_FINISH);
+    into.resize(strm.total_out);
+    deflateEnd(&strm);
+    if (ret != Z_STREAM_END) {
+        throw IOError(TL("Could not compress the output."));
+    }
+}
+#endif
+
+
+#ifdef HAVE_ZSTD
+// ---------------------------------------------------------------------------
+// ZstdOStreamBuf - methods
+// ---------------------------------------------------------------------------
+ZstdOStreamBuf::ZstdOStreamBuf(std::streambuf* sink, const int numThreads) :
+    mySink(sink),
+    myContext(ZSTD_createCCtx()),
+    myIn(ZSTD_BUFFER_SIZE),
+    myOut(ZSTD_CStreamOutSize()) {
+    if (myContext == nullptr) {
+        throw IOError(TL("Could not initialize the zstd compression."));
+    }
+    if (numThreads > 1) {
+        // fails silently if the library does not support multithreading
+        ZSTD_CCtx_setParameter(myContext, ZSTD_c_nbWorkers, numThreads);
+    }
+    setp(myIn.data(), myIn.data() + myIn.size());
+}
+
+
+ZstdOStreamBuf::~ZstdOStreamBuf() {
+    // errors cannot be reported from the destructor
+    compress(ZSTD_e_end);
+    mySink->pubsync();
+    ZSTD_freeCCtx(myContext);
+}
+
+
+ZstdOStreamBuf::int_type
+ZstdOStreamBuf::overflow(int_type c) {
+    if (!compress(ZSTD_e_continue)) {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+
+int
+ZstdOStreamBuf::sync() {
+    return compress(ZSTD_e_flush) && mySink->pubsync() == 0 ? 0 : -1;
+}
+
+
+bool
+ZstdOStreamBuf::compress(ZSTD_EndDirective mode) {
+    ZSTD_inBuffer in = {pbase(), (size_t)(pptr() - pbase()), 0};
+    bool finished = false;
+    while (!finished) {
+        ZSTD_outBuffer out = {myOut.data(), myOut.size(), 0};
+        const size_t remaining = ZSTD_compressStream2(myContext, &out, &in, mode);
+        if (ZSTD_isError(remaining)) {
+            return false;
+        }
+        if (mySink->sputn(myOut.data(), (std::streamsize)out.pos) != (std::streamsize)out.pos) {
+            return false;
+        }
+        // when continuing it is sufficient to consume the input, otherwise all internal buffers need to be flushed
+        finished = mode == ZSTD_e_continue ? in.pos == in.size : remaining == 0;
+    }
+    setp(myIn.data(), myIn.data() + myIn.size());
+    return true;
+}
+
+
+// ---------------------------------------------------------------------------
+// ZstdIStreamBuf - methods
+// ---------------------------------------------------------------------------
+ZstdIStreamBuf::ZstdIStreamBuf(std::streambuf* source) :
+    mySource(source),
+    myContext(ZSTD_createDCtx()),
+    myIn(ZSTD_DStreamInSize()),
+    myOut(ZSTD_DStreamOutSize()),
+    myInPos(0),
+    myInSize(0) {
+    if (myContext == nullptr) {
+        throw IOError(TL("Could not initialize the zstd decompression."));
+    }
+    setg(myOut.data(), myOut.data(), myOut.data());
+}
+
+
+ZstdIStreamBuf::~ZstdIStreamBuf() {
+    ZSTD_freeDCtx(myContext);
+}
+
+
+ZstdIStreamBuf::int_type
+ZstdIStreamBuf::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+    while (true) {
+        if (myInPos == myInSize) {
+            const std::streamsize read = mySource->sgetn(myIn.data(), (std::streamsize)myIn.size());
+            if (read <= 0) {
+                return traits_type::eof();
+            }
+            myInPos = 0;
+            myInSize = (size_t)read;
+        }
+        ZSTD_inBuffer in = {myIn.data(), myInSize, myInPos};
+        ZSTD_outBuffer out = {myOut.data(), myOut.size(), 0};
+        // consecutive frames are decoded one after the other
+        const size_t ret = ZSTD_decompressStream(myContext, &out, &in);
+        if (ZSTD_isError(ret)) {
+            throw IOError(TLF("Could not decompress the input (%).", std::string(ZSTD_getErrorName(ret))));
+        }
+        myInPos = in.pos;
+        if (out.pos > 0) {
+            setg(myOut.data(), myOut.data(), myOut.data() + out.pos);
+            return traits_type::to_int_type(*gptr());
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// ZstdOFStream - methods
+// ---------------------------------------------------------------------------
+ZstdOFStream::ZstdOFStream(const std::string& file, const int numThreads) :
+    std::ostream(nullptr) {
+    if (myFile.open(file.c_str(), std::ios_base::out | std::ios_base::binary) != nullptr) {
+        myBuffer = std::unique_ptr<ZstdOStreamBuf>(new ZstdOStreamBuf(&myFile, numThreads));
+        rdbuf(myBuffer.get());
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// ZstdIFStream - methods
+// ---------------------------------------------------------------------------
+ZstdIFStream::ZstdIFStream(const std::string& file) :
+    std::istream(nullptr) {
+    if (myFile.open(file.c_str(), std::ios_base::in | std::ios_base::binary) != nullptr) {
+        myBuffer = std::unique_ptr<ZstdIStreamBuf>(new ZstdIStreamBuf(&myFile));
+        rdbuf(myBuffer.get());
+    }
+}
+#endif
+
+
+/****************************************************************************/
@@ -0,0 +1,175 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2004-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    CompressedStreams.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Streams for reading and writing gzip and zstd compressed files
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class CompressedStreams
+ * @brief Static helpers for compressed input and output
+ */
+class CompressedStreams {
+public:
+    /** @brief opens the file for reading, detecting gzip and zstd compression by the file content
+     *
+     * Uncompressed files are read as they are.
+     */
+    static std::unique_ptr<std::istream> openInput(const std::string& file);
+
+    /// @brief checks whether the file starts with a zstd frame
+    static bool isZstdFile(const std::string& file);
+
+    /// @brief checks whether the file name denotes a zstd compressed file
+    static bool hasZstdSuffix(const std::string& file);
+
+#ifdef HAVE_ZLIB
+    /** @brief compresses the data into a single gzip member
+     *
+     * Concatenated members form a valid gzip file, so independent parts of a
+     *  file can be compressed in parallel.
+     */
+    static void gzipMember(const std::string& data, std::string& into);
+#endif
+};
+
+
+#ifdef HAVE_ZSTD
+/**
+ * @class ZstdOStreamBuf
+ * @brief A stream buffer which writes a zstd frame into another stream buffer
+ *
+ * The compression uses the given number of worker threads if the zstd library
+ *  was built with multithreading support (otherwise it is single threaded).
+ */
+class ZstdOStreamBuf : public std::streambuf {
+public:
+    ZstdOStreamBuf(std::streambuf* sink, const int numThreads);
+
+    /// @brief Destructor (ends the frame)
+    ~ZstdOStreamBuf();
+
+protected:
+    int_type overflow(int_type c) override;
+
+    int sync() override;
+
+private:
+    /// @brief compresses the buffered input, returns false on errors
+    bool compress(ZSTD_EndDirective mode);
+
+    /// @brief the buffer to write the compressed data to
+    std::streambuf* const mySink;
+
+    /// @brief the compression context
+    ZSTD_CCtx* const myContext;
+
+    /// @brief the uncompressed and the compressed data
+    std::vector<char> myIn, myOut;
+
+private:
+    /// @brief Invalidated copy constructor.
+    ZstdOStreamBuf(const ZstdOStreamBuf&) = delete;
+
+    /// @brief Invalidated assignment operator.
+    ZstdOStreamBuf& operator=(const ZstdOStreamBuf&) = delete;
+};
+
+
+/**
+ * @class ZstdIStreamBuf
+ * @brief A stream buffer which decompresses (a sequence of) zstd frames from another stream buffer
+ */
+class ZstdIStreamBuf : public std::streambuf {
+public:
+    ZstdIStreamBuf(std::streambuf* source);
+
+    /// @brief Destructor
+    ~ZstdIStreamBuf();
+
+protected:
+    int_type underflow() override;
+
+private:
+    /// @brief the buffer to read the compressed data from
+    std::streambuf* const mySource;
+
+    /// @brief the decompression context
+    ZSTD_DCtx* const myContext;
+
+    /// @brief the compressed and the decompressed data
+    std::vector<char> myIn, myOut;
+
+    /// @brief the part of myIn which was read but not decompressed yet
+    size_t myInPos, myInSize;
+
+private:
+    /// @brief Invalidated copy constructor.
+    ZstdIStreamBuf(const ZstdIStreamBuf&) = delete;
+
+    /// @brief Invalidated assignment operator.
+    ZstdIStreamBuf& operator=(const ZstdIStreamBuf&) = delete;
+};
+
+
+/**
+ * @class ZstdOFStream
+ * @brief An output file stream writing zstd compressed data
+ */
+class ZstdOFStream : public std::ostream {
+public:
+    ZstdOFStream(const std::string& file, const int numThreads);
+
+private:
+    /// @brief the file (needs to be declared before the compressing buffer)
+    std::filebuf myFile;
+
+    /// @brief the compressing buffer
+    std::unique_ptr<ZstdOStreamBuf> myBuffer;
+};
+
+
+/**
+ * @class ZstdIFStream
+ * @brief An input file stream reading zstd compressed data
+ */
+class ZstdIFStream : public std::istream {
+public:
+    ZstdIFStream(const std::string& file);
+
+private:
+    /// @brief the file (needs to be declared before the decompressing buffer)
+    std::filebuf myFile;
+
+    /// @brief the decompressing buffer
+    std::unique_ptr<ZstdIStreamBuf> myBuffer;
+};
+#endif
@@ -36,6 +36,8 @@
 #include "OutputDevice_COUT.h"
 #include "OutputDevice_CERR.h"
 #include "OutputDevice_Network.h"
+#include "BinaryFormatter.h"
+#include "CompressedStreams.h"
 #include "PlainXMLFormatter.h"
 #include <utils/common/StringUtils.h>
 #include <utils/common/UtilExceptions.h>
@@ -79,7 +81,10 @@ OutputDevice::getDevice(const std::string& name, bool usePrefix) {
     } else if (FileHelpers::isSocket(name)) {
         try {
             int port = StringUtils::toInt(name.substr(name.find(":") + 1));
-            dev = new OutputDevice_Network(name.substr(0, name.find(":")), port);
+            const OptionsCont& oc = OptionsCont::getOptions();
+            const int bufferSize = oc.exists("output.network.buffer") ? oc.getInt("output.network.buffer") : 0;
+            const bool drop = oc.exists("output.network.drop") && oc.getBool("output.network.drop");
+            dev = new OutputDevice_Network(name.substr(0, name.find(":")), port, bufferSize * 1024, drop);
         } catch (NumberFormatException&) {
             throw IOError("Given port number '" + name.substr(name.find(":") + 1) + "' is not numeric.");
         } catch (EmptyData&) {
@@ -101,7 +106,10 @@ OutputDevice::getDevice(const std::string& name, bool usePrefix) {
         }
         name2 = StringUtils::substituteEnvironment(name2, &OptionsIO::getLoadTime());
         const int len = (int)name.length();
-        dev = new OutputDevice_File(name2, len > 3 && name.substr(len - 3) == ".gz");
+        const bool compressed = (len > 3 && name.substr(len - 3) == ".gz") || CompressedStreams::hasZstdSuffix(name);
+        const bool async = OptionsCont::getOptions().exists("output.async") && OptionsCont::getOptions().getBool("output.async");
+        const int compressionThreads = OptionsCont::getOptions().exists("output.compression-threads") ? OptionsCont::getOptions().getInt("output.compression-threads") : 1;
+        dev = new OutputDevice_File(name2, compressed, async, compressionThreads);
     }
     dev->setPrecision();
     dev->getOStream() << std::setiosflags(std::ios::fixed);
@@ -202,7 +210,9 @@ OutputDevice::realString(const double v, const int precision) {
 // member method definitions
 // ===========================================================================
 OutputDevice::OutputDevice(const int defaultIndentation, const std::string& filename) :
-    myFilename(filename), myFormatter(new PlainXMLFormatter(defaultIndentation)) {
+    myFilename(filename),
+    myAmBinary(BinaryFormatter::isBinaryFile(filename)),
+    myFormatter(myAmBinary ? static_cast<OutputFormatter*>(new BinaryFormatter()) : new PlainXMLFormatter(defaultIndentation)) {
 }
 
 
@@ -291,11 +301,12 @@ OutputDevice::postWriteHook() {}
 
 void
 OutputDevice::inform(const std::string& msg, const char progress) {
-    if (progress != 0) {
-        getOStream() << msg << progress;
-    } else {
-        getOStream() << msg << '\n';
-    }
+    // a single write, unit buffered streams like std::cerr flush after every insertion
+    std::string line;
+    line.reserve(msg.size() + 1);
+    line += msg;
+    line += progress != 0 ? progress : '\n';
+    getOStream() << line;
     postWriteHook();
 }
 
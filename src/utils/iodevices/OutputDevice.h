@@ -28,6 +28,7 @@
 #include <cassert>
 #include <utils/common/ToString.h>
 #include <utils/xml/SUMOXMLDefinitions.h>
+#include "BinaryFormatter.h"
 #include "PlainXMLFormatter.h"
 
 
@@ -197,6 +198,9 @@ public:
 
     template <typename E>
     bool writeHeader(const SumoXMLTag& rootElement) {
+        if (myAmBinary) {
+            return myFormatter->writeXMLHeader(getOStream(), toString(rootElement), std::map<SumoXMLAttr, std::string>());
+        }
         return static_cast<PlainXMLFormatter*>(myFormatter)->writeHeader(getOStream(), rootElement);
     }
 
@@ -240,7 +244,9 @@ public:
     /** @brief writes a line feed if applicable
      */
     void lf() {
-        getOStream() << "\n";
+        if (!myAmBinary) {
+            getOStream() << "\n";
+        }
     }
 
 
@@ -252,7 +258,11 @@ public:
      */
     template <typename T>
     OutputDevice& writeAttr(const SumoXMLAttr attr, const T& val) {
-        PlainXMLFormatter::writeAttr(getOStream(), attr, val);
+        if (myAmBinary) {
+            static_cast<BinaryFormatter*>(myFormatter)->writeAttr(getOStream(), attr, val);
+        } else {
+            PlainXMLFormatter::writeAttr(getOStream(), attr, val);
+        }
         return *this;
     }
 
@@ -271,7 +281,7 @@ public:
     OutputDevice& writeOptionalAttr(const SumoXMLAttr attr, const T& val, long long int attributeMask) {
         assert((int)attr <= 63);
         if (attributeMask == 0 || useAttribute(attr, attributeMask)) {
-            PlainXMLFormatter::writeAttr(getOStream(), attr, val);
+            writeAttr(attr, val);
         }
         return *this;
     }
@@ -285,7 +295,11 @@ public:
      */
     template <typename T>
     OutputDevice& writeAttr(const std::string& attr, const T& val) {
-        PlainXMLFormatter::writeAttr(getOStream(), attr, val);
+        if (myAmBinary) {
+            static_cast<BinaryFormatter*>(myFormatter)->writeAttr(getOStream(), attr, val);
+        } else {
+            PlainXMLFormatter::writeAttr(getOStream(), attr, val);
+        }
         return *this;
     }
 
@@ -357,6 +371,11 @@ protected:
      */
     virtual void postWriteHook();
 
+    /// @brief the number of currently open elements
+    int getDepth() const {
+        return myFormatter->getDepth();
+    }
+
 
 private:
     /// @brief map from names to output devices
@@ -369,6 +388,9 @@ protected:
     const std::string myFilename;
 
 private:
+    /// @brief whether the binary formatter is used (decided by the file name)
+    const bool myAmBinary;
+
     /// @brief The formatter for XML
     OutputFormatter* const myFormatter;
 
@@ -29,13 +29,15 @@
 #endif
 #include <utils/common/StringUtils.h>
 #include <utils/common/UtilExceptions.h>
+#include "CompressedStreams.h"
 #include "OutputDevice_File.h"
 
 
 // ===========================================================================
 // method definitions
 // ===========================================================================
-OutputDevice_File::OutputDevice_File(const std::string& fullName, const bool compressed)
+OutputDevice_File::OutputDevice_File(const std::string& fullName, const bool compressed, const bool async,
+                                     const int compressionThreads)
     : OutputDevice(0, fullName) {
     if (fullName == "/dev/null") {
         myAmNull = true;
@@ -49,38 +51,171 @@ OutputDevice_File::OutputDevice_File(const std::string& fullName, const bool com
 #endif
     }
     const std::string& localName = StringUtils::transcodeToLocal(fullName);
+#ifdef HAVE_ZSTD
+    if (compressed && CompressedStreams::hasZstdSuffix(fullName)) {
+        myFileStream = new ZstdOFStream(localName, compressionThreads);
+    } else
+#endif
 #ifdef HAVE_ZLIB
-    if (compressed) {
+    if (compressed && async && compressionThreads > 1 && !myAmNull) {
+        // the writer thread compresses
+        myFileStream = new std::ofstream(localName.c_str(), std::ios_base::out | std::ios_base::binary);
+        myGzipThreads = compressionThreads;
+    } else if (compressed) {
         try {
-            myFileStream = new zstr::ofstream(localName.c_str(), std::ios_base::out);
+            myFileStream = new zstr::ofstream(localName.c_str(), std::ios_base::out | std::ios_base::binary);
         } catch (strict_fstream::Exception& e) {
             throw IOError("Could not build output file '" + fullName + "' (" + e.what() + ").");
         } catch (zstr::Exception& e) {
             throw IOError("Could not build output file '" + fullName + "' (" + e.what() + ").");
         }
     } else {
-        myFileStream = new std::ofstream(localName.c_str(), std::ios_base::out);
+        myFileStream = new std::ofstream(localName.c_str(), std::ios_base::out | std::ios_base::binary);
     }
 #else
     UNUSED_PARAMETER(compressed);
-    myFileStream = new std::ofstream(localName.c_str(), std::ios_base::out);
+    UNUSED_PARAMETER(compressionThreads);
+    myFileStream = new std::ofstream(localName.c_str(), std::ios_base::out | std::ios_base::binary);
 #endif
     if (!myFileStream->good()) {
         delete myFileStream;
         throw IOError("Could not build output file '" + fullName + "' (" + std::strerror(errno) + ").");
     }
+    if (async && !myAmNull) {
+        myBuffer = new std::ostringstream();
+        myWriter = std::thread(&OutputDevice_File::writeLoop, this);
+    }
 }
 
 
 OutputDevice_File::~OutputDevice_File() {
+    if (myBuffer != nullptr) {
+        handOff();
+        {
+            std::lock_guard<std::mutex> lock(myLock);
+            myQuit = true;
+        }
+        myCondition.notify_all();
+        myWriter.join();
+        delete myBuffer;
+        if (myGzipThreads > 0 && !myWroteGzipMember) {
+            // an empty file is no valid gzip file
+            writeGzipMembers({""});
+        }
+    }
     delete myFileStream;
 }
 
 
+bool
+OutputDevice_File::ok() {
+    if (myBuffer != nullptr) {
+        std::lock_guard<std::mutex> lock(myLock);
+        if (myWriteFailed) {
+            return false;
+        }
+    }
+    return OutputDevice::ok();
+}
+
+
 std::ostream&
 OutputDevice_File::getOStream() {
+    if (myBuffer != nullptr) {
+        if (myBuffer->tellp() > ASYNC_BUFFER_SIZE) {
+            handOff();
+        }
+        return *myBuffer;
+    }
     return *myFileStream;
 }
 
 
+void
+OutputDevice_File::handOff() {
+    std::string data = myBuffer->str();
+    myBuffer->str("");
+    if (data.empty()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(myLock);
+    // do not let the simulation run away from a slow disk
+    myCondition.wait(lock, [this]() {
+        return (int)myPending.size() < ASYNC_MAX_PENDING;
+    });
+    myPending.push_back(std::move(data));
+    lock.unlock();
+    myCondition.notify_all();
+}
+
+
+void
+OutputDevice_File::writeLoop() {
+    std::vector<std::string> work;
+    while (true) {
+        std::unique_lock<std::mutex> lock(myLock);
+        myCondition.wait(lock, [this]() {
+            return myQuit || !myPending.empty();
+        });
+        if (myPending.empty()) {
+            // myQuit is set and everything is written
+            break;
+        }
+        work.swap(myPending);
+        lock.unlock();
+        myCondition.notify_all();
+        if (myGzipThreads > 0) {
+            writeGzipMembers(work);
+        } else {
+            for (const std::string& data : work) {
+                myFileStream->write(data.data(), data.size());
+            }
+        }
+        work.clear();
+        if (!myFileStream->good()) {
+            std::lock_guard<std::mutex> failLock(myLock);
+            myWriteFailed = true;
+        }
+    }
+}
+
+
+void
+OutputDevice_File::writeGzipMembers(const std::vector<std::string>& work) {
+#ifdef HAVE_ZLIB
+    std::vector<std::string> members(work.size());
+    const int numThreads = MIN2(myGzipThreads, (int)work.size());
+    std::vector<std::thread> threads;
+    bool failed = false;
+    std::mutex failLock;
+    for (int i = 0; i < numThreads; i++) {
+        threads.push_back(std::thread([&, i]() {
+            try {
+                for (int j = i; j < (int)work.size(); j += numThreads) {
+                    CompressedStreams::gzipMember(work[j], members[j]);
+                }
+            } catch (IOError&) {
+                std::lock_guard<std::mutex> lock(failLock);
+                failed = true;
+            }
+        }));
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    if (failed) {
+        myFileStream->setstate(std::ios_base::failbit);
+        return;
+    }
+    // the members are written in file order
+    for (const std::string& member : members) {
+        myFileStream->write(member.data(), member.size());
+    }
+    myWroteGzipMember = true;
+#else
+    UNUSED_PARAMETER(work);
+#endif
+}
+
+
 /****************************************************************************/
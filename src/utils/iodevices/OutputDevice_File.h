@@ -21,7 +21,12 @@
 #pragma once
 #include <config.h>
 
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include "OutputDevice.h"
 
 
@@ -34,15 +39,27 @@
  *
  * Please note that the device gots responsible for the stream and deletes
  *  it (it should not be deleted elsewhere).
+ *
+ * In asynchronous mode all output goes into a memory buffer which is handed
+ *  over to a background thread whenever it exceeds ASYNC_BUFFER_SIZE. The
+ *  thread does the actual writing (and compression).
+ *
+ * Files ending with ".zst" are compressed using zstd (if available), all other
+ *  compressed files use gzip. With multiple compression threads zstd uses its
+ *  own worker threads while gzip output (in asynchronous mode only) compresses
+ *  the pending buffers in parallel as independent gzip members.
  */
 class OutputDevice_File : public OutputDevice {
 public:
     /** @brief Constructor
      * @param[in] fullName The name of the output file to use
-     * @param[in] compressed whether to apply gzip compression
+     * @param[in] compressed whether to apply (gzip or zstd) compression
+     * @param[in] async whether to write (and compress) in a background thread
+     * @param[in] compressionThreads the number of threads to use for compression
      * @exception IOError Should not be thrown by this implementation
      */
-    OutputDevice_File(const std::string& fullName, const bool compressed = false);
+    OutputDevice_File(const std::string& fullName, const bool compressed = false, const bool async = false,
+                      const int compressionThreads = 1);
 
 
     /// @brief Destructor
@@ -55,6 +72,9 @@ public:
         return myAmNull;
     }
 
+    /// @brief returns whether the device is ok (including the background writes)
+    bool ok();
+
 
 protected:
     /// @name Methods that override/implement OutputDevice-methods
@@ -67,6 +87,16 @@ protected:
     /// @}
 
 
+private:
+    /// @brief passes the buffered output to the writer thread
+    void handOff();
+
+    /// @brief the main loop of the writer thread
+    void writeLoop();
+
+    /// @brief compresses the buffers as gzip members using the compression threads and writes them
+    void writeGzipMembers(const std::vector<std::string>& work);
+
 private:
     /// The wrapped ofstream
     std::ostream* myFileStream = nullptr;
@@ -74,4 +104,27 @@ private:
     /// am I redirecting to /dev/null
     bool myAmNull = false;
 
+    /// @brief the buffer size (in bytes) which triggers a hand over to the writer thread
+    static const std::streamoff ASYNC_BUFFER_SIZE = 1 << 20;
+
+    /// @brief the maximum number of buffers waiting for the writer thread
+    static const int ASYNC_MAX_PENDING = 16;
+
+    /// @brief the buffer for asynchronous output (nullptr if writing synchronously)
+    std::ostringstream* myBuffer = nullptr;
+
+    /// @brief the background writer and its synchronisation
+    std::thread myWriter;
+    std::mutex myLock;
+    std::condition_variable myCondition;
+    std::vector<std::string> myPending;
+    bool myQuit = false;
+    bool myWriteFailed = false;
+
+    /// @brief the number of threads compressing gzip members in parallel (0 if the stream does the compression)
+    int myGzipThreads = 0;
+
+    /// @brief whether a gzip member was already written
+    bool myWroteGzipMember = false;
+
 };
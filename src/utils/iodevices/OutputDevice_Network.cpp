@@ -31,6 +31,7 @@
 #include <vector>
 #include "OutputDevice_Network.h"
 #include "foreign/tcpip/socket.h"
+#include "utils/common/MsgHandler.h"
 #include "utils/common/ToString.h"
 
 
@@ -38,7 +39,10 @@
 // method definitions
 // ==========================================================================
 OutputDevice_Network::OutputDevice_Network(const std::string& host,
-        const int port) : OutputDevice(0, host + ":" + toString(port)) {
+        const int port, const int bufferSize, const bool drop) :
+    OutputDevice(0, host + ":" + toString(port)),
+    myBufferSize(bufferSize),
+    myDrop(drop) {
     mySocket = new tcpip::Socket(host, port);
     for (int wait = 1; wait < 10; wait += 1) {
         try {
@@ -51,15 +55,39 @@ OutputDevice_Network::OutputDevice_Network(const std::string& host,
             std::this_thread::sleep_for(std::chrono::seconds(wait));
         }
     }
+    if (myBufferSize > 0) {
+        mySender = std::thread(&OutputDevice_Network::sendLoop, this);
+    }
 }
 
 
 OutputDevice_Network::~OutputDevice_Network() {
+    if (myBufferSize > 0) {
+        handOff(false);
+        {
+            std::lock_guard<std::mutex> lock(myLock);
+            myQuit = true;
+        }
+        myCondition.notify_all();
+        mySender.join();
+    }
     mySocket->close();
     delete mySocket;
 }
 
 
+bool
+OutputDevice_Network::ok() {
+    if (myBufferSize > 0) {
+        std::lock_guard<std::mutex> lock(myLock);
+        if (mySendFailed) {
+            return false;
+        }
+    }
+    return OutputDevice::ok();
+}
+
+
 std::ostream&
 OutputDevice_Network::getOStream() {
     return myMessage;
@@ -68,6 +96,13 @@ OutputDevice_Network::getOStream() {
 
 void
 OutputDevice_Network::postWriteHook() {
+    if (myBufferSize > 0) {
+        // keep the open elements (like a time step) together with their children
+        if (getDepth() <= 1) {
+            handOff(getDepth() == 1);
+        }
+        return;
+    }
     const std::string toSend = myMessage.str();
     myMessage.str("");
     if (toSend.empty() || !mySocket->has_client_connection()) {
@@ -84,4 +119,79 @@ OutputDevice_Network::postWriteHook() {
 }
 
 
+void
+OutputDevice_Network::handOff(const bool mayDrop) {
+    std::string data = myMessage.str();
+    myMessage.str("");
+    if (data.empty()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(myLock);
+    if (mySendFailed) {
+        return;
+    }
+    const bool full = myPendingBytes > 0 && myPendingBytes + (int)data.size() > myBufferSize;
+    if (full && myDrop && mayDrop && myHandedOff) {
+        // the header and the closing root element are never dropped
+        lock.unlock();
+        if (myNumDropped++ == 0) {
+            WRITE_WARNINGF(TL("The receiver of network output '%' is too slow, dropping output."), getFilename());
+        }
+        return;
+    }
+    // backpressure: wait until the sender caught up
+    myCondition.wait(lock, [this, &data]() {
+        return mySendFailed || myPendingBytes == 0 || myPendingBytes + (int)data.size() <= myBufferSize;
+    });
+    myPendingBytes += (int)data.size();
+    myPending.push_back(std::move(data));
+    myHandedOff = true;
+    lock.unlock();
+    myCondition.notify_all();
+}
+
+
+void
+OutputDevice_Network::sendLoop() {
+    std::vector<std::string> work;
+    std::vector<unsigned char> msg;
+    while (true) {
+        std::unique_lock<std::mutex> lock(myLock);
+        myCondition.wait(lock, [this]() {
+            return myQuit || !myPending.empty();
+        });
+        if (myPending.empty()) {
+            // myQuit is set and everything is sent
+            break;
+        }
+        work.swap(myPending);
+        lock.unlock();
+        // send everything which queued up in a single batch
+        msg.clear();
+        for (const std::string& data : work) {
+            msg.insert(msg.end(), data.begin(), data.end());
+        }
+        bool failed = false;
+        if (mySocket->has_client_connection()) {
+            try {
+                mySocket->send(msg);
+            } catch (const tcpip::SocketException&) {
+                mySocket->close();
+                failed = true;
+            }
+        }
+        work.clear();
+        lock.lock();
+        myPendingBytes -= (int)msg.size();
+        if (failed) {
+            mySendFailed = true;
+            myPending.clear();
+            myPendingBytes = 0;
+        }
+        lock.unlock();
+        myCondition.notify_all();
+    }
+}
+
+
 /****************************************************************************/
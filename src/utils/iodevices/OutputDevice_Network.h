@@ -26,9 +26,13 @@
 #include "foreign/tcpip/storage.h"
 #include "OutputDevice.h"
 #include <utils/common/UtilExceptions.h>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 
 // ==========================================================================
@@ -42,6 +46,14 @@
  *  project (shawn.sf.net) located in src/foreign/tcpip/socket.h. It uses
  *  an internal storage for the messages, which is sent via the socket when
  *  "postWriteHook" is called.
+ *
+ * With a positive buffer size the messages are sent by a background thread
+ *  instead, so a slow receiver does not block the simulation. Only complete
+ *  top level elements are handed over and everything which queued up while
+ *  the previous send was running goes out in a single batch. If the queue
+ *  exceeds the buffer size, the simulation either waits for the receiver or
+ *  (when dropping) the element is discarded, so the receiver still gets well
+ *  formed output but with gaps.
  * @see postWriteHook
  */
 class OutputDevice_Network : public OutputDevice {
@@ -50,15 +62,20 @@ public:
      *
      * @param[in] host The host to connect
      * @param[in] port The port to connect
+     * @param[in] bufferSize The maximum number of bytes waiting for the sender thread (0 sends synchronously)
+     * @param[in] drop Whether to discard elements which do not fit into the buffer (instead of waiting)
      * @exception IOError If the connection could not be established
      */
     OutputDevice_Network(const std::string& host,
-                         const int port);
+                         const int port, const int bufferSize = 0, const bool drop = false);
 
 
     /// @brief Destructor
     ~OutputDevice_Network();
 
+    /// @brief returns whether the device is ok (including the background sends)
+    bool ok();
+
 
 protected:
     /// @name Methods that override/implement OutputDevice-methods
@@ -83,6 +100,13 @@ protected:
     virtual void postWriteHook();
     /// @}
 
+private:
+    /// @brief passes the message to the sender thread
+    void handOff(const bool mayDrop);
+
+    /// @brief the main loop of the sender thread
+    void sendLoop();
+
 private:
     /// @brief packet buffer
     std::ostringstream myMessage;
@@ -90,4 +114,25 @@ private:
     /// @brief the socket to transfer the data
     tcpip::Socket* mySocket;
 
+    /// @brief the maximum number of bytes waiting for the sender thread (0 if sending synchronously)
+    const int myBufferSize;
+
+    /// @brief whether to discard elements if the buffer is full
+    const bool myDrop;
+
+    /// @brief whether anything was handed over already (the first message contains the header)
+    bool myHandedOff = false;
+
+    /// @brief the number of discarded elements
+    int myNumDropped = 0;
+
+    /// @brief the background sender and its synchronisation
+    std::thread mySender;
+    std::mutex myLock;
+    std::condition_variable myCondition;
+    std::vector<std::string> myPending;
+    int myPendingBytes = 0;
+    bool myQuit = false;
+    bool mySendFailed = false;
+
 };
@@ -104,4 +104,7 @@ public:
     virtual void writePadding(std::ostream& into, const std::string& val) = 0;
 
     virtual bool wroteHeader() const = 0;
+
+    /// @brief the number of currently open elements
+    virtual int getDepth() const = 0;
 };
@@ -21,6 +21,7 @@
 #pragma once
 #include <config.h>
 
+#include <cstdio>
 #include "OutputFormatter.h"
 
 
@@ -121,7 +122,9 @@ public:
      */
     template <class T>
     static void writeAttr(std::ostream& into, const std::string& attr, const T& val) {
-        into << " " << attr << "=\"" << toString(val, into.precision()) << "\"";
+        into << " " << attr << "=\"";
+        writeValue(into, val);
+        into << "\"";
     }
 
 
@@ -133,14 +136,59 @@ public:
      */
     template <class T>
     static void writeAttr(std::ostream& into, const SumoXMLAttr attr, const T& val) {
-        into << " " << toString(attr) << "=\"" << toString(val, into.precision()) << "\"";
+        into << " " << SUMOXMLDefinitions::Attrs.getString(attr) << "=\"";
+        writeValue(into, val);
+        into << "\"";
     }
 
     bool wroteHeader() const {
         return !myXMLStack.empty();
     }
 
+    int getDepth() const {
+        return (int)myXMLStack.size();
+    }
+
 private:
+    /** @brief writes an attribute value in the format of toString
+     *
+     * The overloads below handle the most frequent value types without
+     *  creating a string stream for each attribute.
+     */
+    template <class T>
+    static void writeValue(std::ostream& into, const T& val) {
+        into << toString(val, into.precision());
+    }
+
+    static void writeValue(std::ostream& into, const std::string& val) {
+        into << val;
+    }
+
+    static void writeValue(std::ostream& into, const int val) {
+        char buffer[16];
+        into.write(buffer, snprintf(buffer, sizeof(buffer), "%d", val));
+    }
+
+    static void writeValue(std::ostream& into, const long long int val) {
+        char buffer[32];
+        into.write(buffer, snprintf(buffer, sizeof(buffer), "%lld", val));
+    }
+
+    static void writeValue(std::ostream& into, const double val) {
+        // printf uses the same conversion as the fixed stream formatting of toString
+        char buffer[64];
+        const int length = snprintf(buffer, sizeof(buffer), "%.*f", (int)into.precision(), val);
+        if (length >= 0 && length < (int)sizeof(buffer)) {
+            into.write(buffer, length);
+        } else {
+            into << toString(val, into.precision());
+        }
+    }
+
+    static void writeValue(std::ostream& into, const float val) {
+        writeValue(into, (double)val);
+    }
+
     /// @brief The stack of begun xml elements
     std::vector<std::string> myXMLStack;
 
@@ -38,9 +38,7 @@
 #include <utils/common/FileHelpers.h>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/StringUtils.h>
-#ifdef HAVE_ZLIB
-#include <foreign/zstr/zstr.hpp>
-#endif
+#include <utils/iodevices/CompressedStreams.h>
 #include <utils/xml/IStreamInputSource.h>
 
 
@@ -153,9 +151,9 @@ OptionsIO::getRoot(const std::string& filename) {
         if (!FileHelpers::isReadable(filename) || FileHelpers::isDirectory(filename)) {
             throw ProcessError(TLF("Could not open '%'.", filename));
         }
-#ifdef HAVE_ZLIB
-        zstr::ifstream istream(StringUtils::transcodeToLocal(filename).c_str(), std::fstream::in | std::fstream::binary);
-        IStreamInputSource inputStream(istream);
+#if defined(HAVE_ZLIB) || defined(HAVE_ZSTD)
+        std::unique_ptr<std::istream> istream = CompressedStreams::openInput(filename);
+        IStreamInputSource inputStream(*istream);
         const bool result = parser.parseFirst(inputStream, token);
 #else
         const bool result = parser.parseFirst(StringUtils::transcodeToLocal(filename).c_str(), token);
@@ -28,9 +28,11 @@
 #ifdef HAVE_FOX
 #include <utils/foxtools/MFXWorkerThread.h>
 #endif
+#include <utils/common/SUMOVehicleClass.h>
 #include <utils/router/ReversedEdge.h>
 
 #define UNREACHABLE (std::numeric_limits<double>::max() / 1000.0)
+#define LANDMARK_BINARY_MAGIC "SUMO-landmarks-binary-1"
 
 //#define ASTAR_DEBUG_LOOKUPTABLE
 //#define ASTAR_DEBUG_LOOKUPTABLE_FROM "disabled"
@@ -127,7 +129,14 @@ public:
         std::vector<const E*> landmarks;
         int numLandMarks = 0;
         bool haveData = false;
-        while (std::getline(strm, line)) {
+        bool haveLine = (bool)std::getline(strm, line);
+        if (haveLine && line == LANDMARK_BINARY_MAGIC) {
+            readBinary(strm, filename, edges, numericID, defaultVehicle, landmarks);
+            numLandMarks = (int)landmarks.size();
+            haveData = true;
+            haveLine = false;
+        }
+        while (haveLine) {
             if (line == "") {
                 break;
             }
@@ -174,6 +183,7 @@ public:
                 }
                 haveData = true;
             }
+            haveLine = (bool)std::getline(strm, line);
         }
         if (myLandmarks.empty()) {
             WRITE_WARNINGF("No landmarks in '%', falling back to standard A*.", filename);
@@ -276,13 +286,14 @@ public:
             }
         }
         if (!outfile.empty()) {
+            const bool binary = StringUtils::endsWith(outfile, ".bin") || StringUtils::endsWith(outfile, ".bin.gz");
             std::ostream* ostrm = nullptr;
 #ifdef HAVE_ZLIB
             if (StringUtils::endsWith(outfile, ".gz")) {
-                ostrm = new zstr::ofstream(outfile.c_str(), std::ios_base::out);
+                ostrm = new zstr::ofstream(outfile.c_str(), std::ios_base::out | std::ios_base::binary);
             } else {
 #endif
-                ostrm = new std::ofstream(outfile.c_str());
+                ostrm = new std::ofstream(outfile.c_str(), binary ? std::ios_base::out | std::ios_base::binary : std::ios_base::out);
 #ifdef HAVE_ZLIB
             }
 #endif
@@ -291,6 +302,11 @@ public:
                 throw ProcessError(TLF("Could not open file '%' for writing.", outfile));
             }
             WRITE_MESSAGEF(TL("Saving new matrix to '%'."), outfile);
+            if (binary) {
+                writeBinary(*ostrm, edges, defaultVehicle);
+                delete ostrm;
+                return;
+            }
             for (int i = 0; i < numLandMarks; ++i) {
                 (*ostrm) << getLandmark(i) << "\n";
             }
@@ -436,6 +452,98 @@ private:
     /// @brief for multi threaded routing
 #endif
 
+    /** @brief computes a checksum over the ids of all non-internal edges
+     *
+     * FNV-1a is used (instead of std::hash) to be independent of the standard library.
+     */
+    unsigned long long getNetworkChecksum(const std::vector<E*>& edges) const {
+        unsigned long long hash = 14695981039346656037ULL;
+        for (int j = myFirstNonInternal; j < (int)edges.size(); ++j) {
+            for (const char c : edges[j]->getID() + " ") {
+                hash = (hash ^ (unsigned char)c) * 1099511628211ULL;
+            }
+        }
+        return hash;
+    }
+
+    /** @brief reads the binary landmark distances (the magic line has already been consumed)
+     *
+     * The layout is: number of landmarks, number of edges, network checksum, vehicle class,
+     *  the landmark ids (length prefixed) and all from and to distances as raw doubles
+     *  (landmark major). The format uses the native byte order and is meant as a cache
+     *  on the machine which wrote it.
+     */
+    template<class STREAM>
+    void readBinary(STREAM& strm, const std::string& filename, const std::vector<E*>& edges,
+                    const std::map<std::string, int>& numericID, const V* defaultVehicle, std::vector<const E*>& landmarks) {
+        int numLandMarks = 0;
+        int numEdges = 0;
+        unsigned long long checksum = 0;
+        long long int vClass = 0;
+        strm.read((char*)&numLandMarks, sizeof(numLandMarks));
+        strm.read((char*)&numEdges, sizeof(numEdges));
+        strm.read((char*)&checksum, sizeof(checksum));
+        strm.read((char*)&vClass, sizeof(vClass));
+        if (!strm.good() || numEdges != (int)numericID.size() || checksum != getNetworkChecksum(edges)) {
+            throw ProcessError(TLF("Binary landmark file '%' does not match the network.", filename));
+        }
+        const SUMOVehicleClass svc = defaultVehicle == nullptr ? SVC_IGNORING : defaultVehicle->getVClass();
+        if (vClass != (long long int)svc) {
+            WRITE_WARNINGF(TL("Binary landmark file '%' was computed for vehicle class '%' instead of '%'."),
+                           filename, getVehicleClassNames((SVCPermissions)vClass), getVehicleClassNames(svc));
+        }
+        for (int i = 0; i < numLandMarks; ++i) {
+            int length = 0;
+            strm.read((char*)&length, sizeof(length));
+            std::string lm(MAX2(0, length), ' ');
+            strm.read(&lm[0], length);
+            const auto& it = numericID.find(lm);
+            if (!strm.good() || it == numericID.end()) {
+                throw ProcessError(TLF("Landmark edge '%' does not exist in the network.", lm));
+            }
+            myLandmarks[lm] = i;
+            landmarks.push_back(edges[it->second + myFirstNonInternal]);
+        }
+        for (std::vector<std::vector<double> >* dists : {
+                    &myFromLandmarkDists, &myToLandmarkDists
+                }) {
+            dists->resize(numLandMarks);
+            for (std::vector<double>& d : *dists) {
+                d.resize(numEdges);
+                strm.read((char*)d.data(), sizeof(double) * numEdges);
+            }
+        }
+        if (!strm.good()) {
+            throw ProcessError(TLF("Binary landmark file '%' is truncated.", filename));
+        }
+    }
+
+    /// @brief writes the landmark distances in the binary format (see readBinary)
+    void writeBinary(std::ostream& strm, const std::vector<E*>& edges, const V* defaultVehicle) const {
+        const int numLandMarks = (int)myLandmarks.size();
+        const int numEdges = (int)edges.size() - myFirstNonInternal;
+        const unsigned long long checksum = getNetworkChecksum(edges);
+        const long long int vClass = (long long int)(defaultVehicle == nullptr ? SVC_IGNORING : defaultVehicle->getVClass());
+        strm << LANDMARK_BINARY_MAGIC << "\n";
+        strm.write((const char*)&numLandMarks, sizeof(numLandMarks));
+        strm.write((const char*)&numEdges, sizeof(numEdges));
+        strm.write((const char*)&checksum, sizeof(checksum));
+        strm.write((const char*)&vClass, sizeof(vClass));
+        for (int i = 0; i < numLandMarks; ++i) {
+            const std::string lm = getLandmark(i);
+            const int length = (int)lm.size();
+            strm.write((const char*)&length, sizeof(length));
+            strm.write(lm.data(), length);
+        }
+        for (const std::vector<std::vector<double> >* dists : {
+                    &myFromLandmarkDists, &myToLandmarkDists
+                }) {
+            for (const std::vector<double>& d : *dists) {
+                strm.write((const char*)d.data(), sizeof(double) * d.size());
+            }
+        }
+    }
+
     std::string getLandmark(int i) const {
         for (std::map<std::string, int>::const_iterator it = myLandmarks.begin(); it != myLandmarks.end(); ++it) {
             if (it->second == i) {
@@ -85,14 +85,18 @@ public:
      * @param[in] validatePermissions Whether a multi-permission hierarchy shall be built
      *            If set to false, the net is pruned in synchronize() and the
      *            hierarchy is tailored to the svc
+     * @param[in] reuseOrder Whether rebuilds for later time slices shall
+     *            contract in the order found by the first build
      */
     CHBuilder(const std::vector<E*>& edges, bool unbuildIsWarning,
               const SUMOVehicleClass svc,
-              bool validatePermissions):
+              bool validatePermissions,
+              const bool reuseOrder = false):
         myEdges(edges),
         myErrorMsgHandler(unbuildIsWarning ? MsgHandler::getWarningInstance() : MsgHandler::getErrorInstance()),
         mySPTree(new SPTree<CHInfo, CHConnection>(4, validatePermissions)),
         mySVC(svc),
+        myReuseOrder(reuseOrder),
         myUpdateCount(0) {
         for (const E* const e : edges) {
             myCHInfos.push_back(CHInfo(e));
@@ -126,6 +130,18 @@ public:
         for (int i = 0; i < numEdges; i++) {
             synchronize(myCHInfos[i], time_seconds, vehicle, effortProvider);
         }
+        if (myReuseOrder && (int)myContractionOrder.size() == numEdges) {
+            // re-customize with the known order: only the shortcuts (and
+            // their witness searches) depend on the new weights
+            for (int contractionRank = 0; contractionRank < numEdges; contractionRank++) {
+                CHInfo* const max = &myCHInfos[myContractionOrder[contractionRank]];
+                max->updateShortcuts(mySPTree);
+                contract(max, contractionRank, result);
+            }
+            reportBuild(result, startMillis);
+            return result;
+        }
+        myContractionOrder.clear();
         // synchronization is finished. now we can compute priorities for the first time
         for (int i = 0; i < numEdges; i++) {
             myCHInfos[i].updatePriority(mySPTree);
@@ -137,32 +153,9 @@ public:
         while (!queue.empty()) {
             while (tryUpdateFront(queue)) {}
             CHInfo* max = queue.front();
-            max->rank = contractionRank;
-#ifdef CHRouter_DEBUG_CONTRACTION
-            std::cout << "contracting '" << max->edge->getID() << "' with prio: " << max->priority << " (rank " << contractionRank << ")\n";
-#endif
-            const E* const edge = max->edge;
-            // add outgoing connections to the forward search
-            const int edgeID = edge->getNumericalID();
-            for (const CHConnection& con : max->followers) {
-                result->forwardUplinks[edgeID].push_back(Connection(con.target->edge->getNumericalID(), con.cost, con.permissions));
-                disconnect(con.target->approaching, max);
-                con.target->updatePriority(0);
-            }
-            // add incoming connections to the backward search
-            for (const CHConnection& con : max->approaching) {
-                result->backwardUplinks[edgeID].push_back(Connection(con.target->edge->getNumericalID(), con.cost, con.permissions));
-                disconnect(con.target->followers, max);
-                con.target->updatePriority(0);
-            }
-            // add shortcuts to the net
-            for (const Shortcut& s : max->shortcuts) {
-                const ConstEdgePair& edgePair = s.edgePair;
-                result->shortcuts[edgePair] = edge;
-                CHInfo* from = getCHInfo(edgePair.first);
-                CHInfo* to = getCHInfo(edgePair.second);
-                from->followers.push_back(CHConnection(to, s.cost, s.permissions, s.underlying));
-                to->approaching.push_back(CHConnection(from, s.cost, s.permissions, s.underlying));
+            contract(max, contractionRank, result);
+            if (myReuseOrder) {
+                myContractionOrder.push_back(max->edge->getNumericalID());
             }
             // if you need to debug the chrouter with MSVC uncomment the following line, hierarchy building will get slower and the hierarchy may change though
             //std::make_heap(queue.begin(), queue.end(), myCmp);
@@ -180,13 +173,7 @@ public:
             */
             contractionRank++;
         }
-        // reporting
-        const long duration = SysUtils::getCurrentMillis() - startMillis;
-        WRITE_MESSAGE("Created " + toString(result->shortcuts.size()) + " shortcuts.");
-        WRITE_MESSAGE("Recomputed priority " + toString(myUpdateCount) + " times.");
-        MsgHandler::getMessageInstance()->endProcessMsg("done (" + toString(duration) + "ms).");
-        PROGRESS_DONE_MESSAGE();
-        myUpdateCount = 0;
+        reportBuild(result, startMillis);
         return result;
     }
 
@@ -418,6 +405,49 @@ private:
     }
 
 
+    /// @brief contract the given edge with the given rank, adding its uplinks and shortcuts
+    void contract(CHInfo* max, const int contractionRank, Hierarchy* result) {
+        max->rank = contractionRank;
+#ifdef CHRouter_DEBUG_CONTRACTION
+        std::cout << "contracting '" << max->edge->getID() << "' with prio: " << max->priority << " (rank " << contractionRank << ")\n";
+#endif
+        const E* const edge = max->edge;
+        // add outgoing connections to the forward search
+        const int edgeID = edge->getNumericalID();
+        for (const CHConnection& con : max->followers) {
+            result->forwardUplinks[edgeID].push_back(Connection(con.target->edge->getNumericalID(), con.cost, con.permissions));
+            disconnect(con.target->approaching, max);
+            con.target->updatePriority(0);
+        }
+        // add incoming connections to the backward search
+        for (const CHConnection& con : max->approaching) {
+            result->backwardUplinks[edgeID].push_back(Connection(con.target->edge->getNumericalID(), con.cost, con.permissions));
+            disconnect(con.target->followers, max);
+            con.target->updatePriority(0);
+        }
+        // add shortcuts to the net
+        for (const Shortcut& s : max->shortcuts) {
+            const ConstEdgePair& edgePair = s.edgePair;
+            result->shortcuts[edgePair] = edge;
+            CHInfo* from = getCHInfo(edgePair.first);
+            CHInfo* to = getCHInfo(edgePair.second);
+            from->followers.push_back(CHConnection(to, s.cost, s.permissions, s.underlying));
+            to->approaching.push_back(CHConnection(from, s.cost, s.permissions, s.underlying));
+        }
+    }
+
+
+    /// @brief write the summary of a finished build
+    void reportBuild(const Hierarchy* result, const long startMillis) {
+        const long duration = SysUtils::getCurrentMillis() - startMillis;
+        WRITE_MESSAGE("Created " + toString(result->shortcuts.size()) + " shortcuts.");
+        WRITE_MESSAGE("Recomputed priority " + toString(myUpdateCount) + " times.");
+        MsgHandler::getMessageInstance()->endProcessMsg("done (" + toString(duration) + "ms).");
+        PROGRESS_DONE_MESSAGE();
+        myUpdateCount = 0;
+    }
+
+
     /// @brief copy connections from the original net (modified destructively during contraction)
     void synchronize(CHInfo& info, double time, const V* const vehicle, const SUMOAbstractRouter<E, V>* effortProvider) {
         // forward and backward connections are used only in forward search,
@@ -511,6 +541,12 @@ private:
     /// @brief the permissions for which the hierarchy was constructed
     const SUMOVehicleClass mySVC;
 
+    /// @brief whether later builds reuse the contraction order of the first one
+    const bool myReuseOrder;
+
+    /// @brief numerical edge ids in the order of their contraction (only filled if myReuseOrder is set)
+    std::vector<int> myContractionOrder;
+
     /// @brief counters for performance logging
     int myUpdateCount;
 
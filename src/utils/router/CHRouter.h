@@ -214,20 +214,23 @@ public:
      * @param[in] validatePermissions Whether a multi-permission hierarchy shall be built
      *            If set to false, the net is pruned in synchronize() and the
      *            hierarchy is tailored to the svc
+     * @param[in] reuseOrder Whether rebuilds for later weight periods shall keep the initial contraction order
      */
     CHRouter(const std::vector<E*>& edges, bool unbuildIsWarning, typename SUMOAbstractRouter<E, V>::Operation operation,
              const SUMOVehicleClass svc,
              SUMOTime weightPeriod,
-             const bool havePermissions, const bool haveRestrictions):
+             const bool havePermissions, const bool haveRestrictions,
+             const bool reuseOrder = false):
         SUMOAbstractRouter<E, V>("CHRouter", unbuildIsWarning, operation, nullptr, havePermissions, haveRestrictions),
         myEdges(edges),
         myForwardSearch(edges, true),
         myBackwardSearch(edges, false),
-        myHierarchyBuilder(new CHBuilder<E, V>(edges, unbuildIsWarning, svc, havePermissions)),
+        myHierarchyBuilder(new CHBuilder<E, V>(edges, unbuildIsWarning, svc, havePermissions, reuseOrder)),
         myHierarchy(nullptr),
         myWeightPeriod(weightPeriod),
         myValidUntil(0),
-        mySVC(svc) {
+        mySVC(svc),
+        myReuseOrder(reuseOrder) {
     }
 
     /** @brief Cloning constructor, should be used only for time independent instances which build a hierarchy only once
@@ -244,7 +247,8 @@ public:
         myHierarchy(hierarchy),
         myWeightPeriod(SUMOTime_MAX),
         myValidUntil(SUMOTime_MAX),
-        mySVC(svc) {
+        mySVC(svc),
+        myReuseOrder(false) {
     }
 
     /// Destructor
@@ -263,7 +267,7 @@ public:
                                       mySVC, myHierarchy, this->myHavePermissions, this->myHaveRestrictions);
         }
         return new CHRouter<E, V>(myEdges, this->myErrorMsgHandler == MsgHandler::getWarningInstance(), this->myOperation,
-                                  mySVC, myWeightPeriod, this->myHavePermissions, this->myHaveRestrictions);
+                                  mySVC, myWeightPeriod, this->myHavePermissions, this->myHaveRestrictions, myReuseOrder);
     }
 
 
@@ -408,4 +412,7 @@ private:
 
     /// @brief the permissions for which the hierarchy was constructed
     const SUMOVehicleClass mySVC;
+
+    /// @brief whether hierarchy rebuilds keep the initial contraction order
+    const bool myReuseOrder;
 };
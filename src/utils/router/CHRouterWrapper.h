@@ -64,14 +64,16 @@ public:
     /** @brief Constructor
      */
     CHRouterWrapper(const std::vector<E*>& edges, const bool ignoreErrors, typename SUMOAbstractRouter<E, V>::Operation operation,
-                    const SUMOTime begin, const SUMOTime end, const SUMOTime weightPeriod, bool havePermissions, const int numThreads) :
+                    const SUMOTime begin, const SUMOTime end, const SUMOTime weightPeriod, bool havePermissions, const int numThreads,
+                    const bool reuseOrder = false) :
         SUMOAbstractRouter<E, V>("CHRouterWrapper", ignoreErrors, operation, nullptr, havePermissions, false),
         myEdges(edges),
         myIgnoreErrors(ignoreErrors),
         myBegin(begin),
         myEnd(end),
         myWeightPeriod(weightPeriod),
-        myMaxNumInstances(numThreads) {
+        myMaxNumInstances(numThreads),
+        myReuseOrder(reuseOrder) {
     }
 
     ~CHRouterWrapper() {
@@ -87,7 +89,7 @@ public:
     }
 
     virtual SUMOAbstractRouter<E, V>* clone() {
-        CHRouterWrapper<E, V>* clone = new CHRouterWrapper<E, V>(myEdges, myIgnoreErrors, this->myOperation, myBegin, myEnd, myWeightPeriod, this->myHavePermissions, myMaxNumInstances);
+        CHRouterWrapper<E, V>* clone = new CHRouterWrapper<E, V>(myEdges, myIgnoreErrors, this->myOperation, myBegin, myEnd, myWeightPeriod, this->myHavePermissions, myMaxNumInstances, myReuseOrder);
         for (const auto& item : myRouters) {
             clone->myRouters[item.first] = static_cast<CHRouterType*>(item.second->clone());
         }
@@ -101,7 +103,7 @@ public:
         if (myRouters.count(svc) == 0) {
             // create new router for the given permissions and maximum speed
             // XXX a new router may also be needed if vehicles differ in speed factor
-            myRouters[svc] = new CHRouterType(myEdges, myIgnoreErrors, this->myOperation, svc.first, myWeightPeriod, false, false);
+            myRouters[svc] = new CHRouterType(myEdges, myIgnoreErrors, this->myOperation, svc.first, myWeightPeriod, false, false, myReuseOrder);
         }
         return myRouters[svc]->compute(from, to, vehicle, msTime, into, silent);
     }
@@ -124,4 +126,5 @@ private:
     const SUMOTime myEnd;
     const SUMOTime myWeightPeriod;
     const int myMaxNumInstances;
+    const bool myReuseOrder;
 };
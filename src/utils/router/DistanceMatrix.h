@@ -0,0 +1,102 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    DistanceMatrix.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Route costs and distances between many origins and destinations
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <thread>
+#include <vector>
+#include <utils/common/StdDefs.h>
+#include "SUMOAbstractRouter.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class DistanceMatrix
+ * @brief Computes the shortest paths from each origin to all destinations
+ *
+ * All queries from one origin share a single search tree (using the bulk mode
+ *  of the router), so the search for the next destination continues where the
+ *  previous one stopped instead of starting over. The origins are distributed
+ *  over several threads, each using its own clone of the router. Every cell
+ *  is computed independently, so the result does not depend on the number of
+ *  threads.
+ */
+template<class E, class V>
+class DistanceMatrix {
+public:
+    /** @brief Computes the route costs and lengths for all pairs
+     * @param[in] router The router to use (its bulk mode is switched off afterwards)
+     * @param[in] origins The origin edges
+     * @param[in] destinations The destination edges
+     * @param[in] vehicle The vehicle to route for (only read)
+     * @param[in] msTime The departure time
+     * @param[in] numThreads The number of threads to use
+     * @param[out] costs The route efforts, the travel times for time based routing (row major, INVALID_DOUBLE if there is no connection)
+     * @param[out] lengths The route lengths (row major, INVALID_DOUBLE if there is no connection)
+     */
+    static void compute(SUMOAbstractRouter<E, V>& router, const std::vector<const E*>& origins, const std::vector<const E*>& destinations,
+                        const V* const vehicle, const SUMOTime msTime, const int numThreads,
+                        std::vector<double>& costs, std::vector<double>& lengths) {
+        costs.assign(origins.size() * destinations.size(), INVALID_DOUBLE);
+        lengths.assign(origins.size() * destinations.size(), INVALID_DOUBLE);
+        const int numWorkers = MAX2(1, MIN2(numThreads, (int)origins.size()));
+        std::vector<SUMOAbstractRouter<E, V>*> routers({&router});
+        for (int i = 1; i < numWorkers; i++) {
+            routers.push_back(router.clone());
+        }
+        std::vector<std::thread> threads;
+        for (int i = 1; i < numWorkers; i++) {
+            threads.emplace_back(&DistanceMatrix::computeRows, routers[i], std::cref(origins), std::cref(destinations),
+                                 vehicle, msTime, i, numWorkers, std::ref(costs), std::ref(lengths));
+        }
+        computeRows(&router, origins, destinations, vehicle, msTime, 0, numWorkers, costs, lengths);
+        for (std::thread& t : threads) {
+            t.join();
+        }
+        for (int i = 1; i < numWorkers; i++) {
+            delete routers[i];
+        }
+    }
+
+private:
+    /// @brief computes every step-th row starting with the given one
+    static void computeRows(SUMOAbstractRouter<E, V>* router, const std::vector<const E*>& origins, const std::vector<const E*>& destinations,
+                            const V* const vehicle, const SUMOTime msTime, const int first, const int step,
+                            std::vector<double>& costs, std::vector<double>& lengths) {
+        std::vector<const E*> edges;
+        for (int o = first; o < (int)origins.size(); o += step) {
+            // the first query builds a new tree, the following ones extend it
+            router->setBulkMode(false);
+            for (int d = 0; d < (int)destinations.size(); d++) {
+                edges.clear();
+                if (router->compute(origins[o], destinations[d], vehicle, msTime, edges, true) && !edges.empty()) {
+                    const int cell = o * (int)destinations.size() + d;
+                    double length = 0.;
+                    costs[cell] = router->recomputeCosts(edges, vehicle, msTime, &length);
+                    lengths[cell] = length;
+                }
+                router->setBulkMode(true);
+            }
+        }
+        router->setBulkMode(false);
+    }
+};
@@ -287,6 +287,11 @@ public:
         return myEdges;
     }
 
+    /// @brief Returns the public transport edges of all lines in stop order
+    const std::map<std::string, std::vector<_PTEdge*> >& getPTLines() const {
+        return myPTLines;
+    }
+
     /// @brief Returns the pair of forward and backward edge
     const EdgePair& getBothDirections(const E* e) const {
         typename std::map<const E*, EdgePair>::const_iterator it = myBidiLookup.find(e);
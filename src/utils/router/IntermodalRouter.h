@@ -37,6 +37,7 @@
 #include "CarEdge.h"
 #include "StopEdge.h"
 #include "PedestrianRouter.h"
+#include "RaptorRouter.h"
 
 //#define IntermodalRouter_DEBUG_ROUTES
 
@@ -60,6 +61,7 @@ private:
     typedef SUMOAbstractRouter<_IntermodalEdge, _IntermodalTrip> _InternalRouter;
     typedef DijkstraRouter<_IntermodalEdge, _IntermodalTrip> _InternalDijkstra;
     typedef AStarRouter<_IntermodalEdge, _IntermodalTrip> _InternalAStar;
+    typedef RaptorRouter<E, L, N, V> _InternalRaptor;
 
 public:
     struct TripItem {
@@ -297,6 +299,9 @@ private:
                     if (myRoutingAlgorithm == "astar") {
                         myInternalRouter = new _InternalAStar(myIntermodalNet->getAllEdges(), true,
                                                               gWeightsRandomFactor > 1 ? &_IntermodalEdge::getTravelTimeStaticRandomized : &_IntermodalEdge::getTravelTimeStatic, nullptr, true);
+                    } else if (myRoutingAlgorithm == "raptor") {
+                        myInternalRouter = new _InternalRaptor(myIntermodalNet,
+                                                               gWeightsRandomFactor > 1 ? &_IntermodalEdge::getTravelTimeStaticRandomized : &_IntermodalEdge::getTravelTimeStatic);
                     } else {
                         myInternalRouter = new _InternalDijkstra(myIntermodalNet->getAllEdges(), true,
                                 gWeightsRandomFactor > 1 ? &_IntermodalEdge::getTravelTimeStaticRandomized : &_IntermodalEdge::getTravelTimeStatic, nullptr, false, nullptr, true);
@@ -24,6 +24,9 @@
 
 #include <vector>
 #include <map>
+#ifdef HAVE_FOX
+#include <utils/foxtools/fxheader.h>
+#endif
 
 
 // ===========================================================================
@@ -47,11 +50,14 @@ public:
         route->setCosts(costs);
     }
 
-    /** @brief calculate the probabilities in the logit model */
+    /** @brief calculate the probabilities in the logit model
+     * @note may be called in parallel for disjoint sets of alternatives
+     */
     void calculateProbabilities(std::vector<R*> alternatives, const V* const veh, const SUMOTime time) {
         const double theta = myTheta >= 0 ? myTheta : getThetaForCLogit(alternatives);
         const double beta = myBeta >= 0 ? myBeta : getBetaForCLogit(alternatives);
         const double t = STEPS2TIME(time);
+        std::vector<double> commonalities;
         if (beta > 0) {
             // calculate commonalities
             for (const R* const pR : alternatives) {
@@ -73,13 +79,26 @@ public:
                     }
                     overlapSum += pow(overlapLength / sqrt(lengthR * lengthS), myGamma);
                 }
-                myCommonalities[pR] = beta * log(overlapSum);
+                commonalities.push_back(beta * log(overlapSum));
             }
         }
-        for (R* const pR : alternatives) {
+        {
+#ifdef HAVE_FOX
+            FXMutexLock locker(myLock);
+#endif
+            for (int i = 0; i < (int)alternatives.size(); i++) {
+                if (beta > 0) {
+                    myCommonalities[alternatives[i]] = commonalities[i];
+                } else {
+                    commonalities.push_back(myCommonalities[alternatives[i]]);
+                }
+            }
+        }
+        for (int i = 0; i < (int)alternatives.size(); i++) {
+            R* const pR = alternatives[i];
             double weightedSum = 0;
-            for (const R* const pS : alternatives) {
-                weightedSum += exp(theta * (pR->getCosts() - pS->getCosts() + myCommonalities[pR] - myCommonalities[pS]));
+            for (int j = 0; j < (int)alternatives.size(); j++) {
+                weightedSum += exp(theta * (pR->getCosts() - alternatives[j]->getCosts() + commonalities[i] - commonalities[j]));
             }
             pR->setProbability(1. / weightedSum);
         }
@@ -138,6 +157,11 @@ private:
     /// @brief The route commonality factors for c-logit
     std::map<const R*, double> myCommonalities;
 
+#ifdef HAVE_FOX
+    /// @brief the mutex for the commonality factors
+    FXMutex myLock;
+#endif
+
 private:
     /** @brief invalidated assignment operator */
     LogitCalculator& operator=(const LogitCalculator& s);
@@ -67,6 +67,13 @@ public:
         if (maxTrainLength > myMaxLength) {
             myMaxLength = maxTrainLength;
             myReplacementEdges = replacementEdges;
+            // memoize where the train may reverse to avoid the checks for each route expansion
+            myReplacementReversals.clear();
+            double seen = myStartLength;
+            for (const E* edge : myReplacementEdges) {
+                seen += edge->getLength();
+                myReplacementReversals.push_back(std::make_pair(seen, edge->isConnectedTo(*edge->getBidiEdge(), SVC_IGNORING)));
+            }
 #ifdef RailEdge_DEBUG_INIT
             std::cout << "    update RailEdge " << getID() << " myMaxLength=" << myMaxLength << " repl=" << toString(myReplacementEdges) << "\n";
 #endif
@@ -182,27 +189,33 @@ public:
         if (myOriginal != nullptr) {
             into.push_back(myOriginal);
         } else {
-            double seen = myStartLength;
-            int nPushed = 0;
-            //std::cout << "insertOriginalEdges e=" << getID() << " length=" << length << " seen=" << seen << " into=" << toString(into) << "\n";
-            if (seen >= length && !myIsVirtual) {
+            if (myStartLength >= length && !myIsVirtual) {
                 return;
             }
-            // we need to find a replacement edge that has a real turn
-            for (const E* edge : myReplacementEdges) {
-                into.push_back(edge);
-                nPushed++;
-                seen += edge->getLength();
-                //std::cout << "insertOriginalEdges e=" << getID() << " length=" << length << " seen=" << seen << " into=" << toString(into) << "\n";
-                if (seen >= length && edge->isConnectedTo(*edge->getBidiEdge(), SVC_IGNORING)) {
-                    break;
-                }
+            const int nPushed = getNumReplacementEdges(length);
+            into.insert(into.end(), myReplacementEdges.begin(), myReplacementEdges.begin() + nPushed);
+            for (int i = nPushed - 1; i >= 0; i--) {
+                into.push_back(myReplacementEdges[i]->getBidiEdge());
             }
-            const int last = (int)into.size() - 1;
-            for (int i = 0; i < nPushed; i++) {
-                into.push_back(into[last - i]->getBidiEdge());
+        }
+    }
+
+    /// @brief the forward edges to use when passing this (turnaround) edge
+    const std::vector<const E*>& getReplacementEdges() const {
+        return myReplacementEdges;
+    }
+
+    /// @brief the number of replacement edges a train of the given length has to pass before it can reverse
+    int getNumReplacementEdges(double length) const {
+        // we need to find a replacement edge that has a real turn
+        int result = 0;
+        for (const auto& reversal : myReplacementReversals) {
+            result++;
+            if (reversal.first >= length && reversal.second) {
+                break;
             }
         }
+        return result;
     }
 
     /** @brief Returns the length of the edge
@@ -272,6 +285,9 @@ private:
     /// @brief actual edges to return when passing this (turnaround) edge - only forward
     std::vector<const E*> myReplacementEdges;
 
+    /// @brief for each replacement edge the distance from the turn start to its end and whether reversal is possible there
+    std::vector<std::pair<double, bool> > myReplacementReversals;
+
     /// @brief maximum train length for passing this (turnaround) edge
     double myMaxLength = std::numeric_limits<double>::max();
     /// @brief length of the edge where this turn starts
@@ -275,14 +275,19 @@ private:
         } else {
             // turnaround edge
             if (edge->isVirtual()) {
-                // add up time for replacement edges
-                std::vector<const E*> repl;
-                edge->insertOriginalEdges(veh->getLength(), repl);
-                assert(repl.size() > 0);
+                // add up time for replacement edges (forward and reversed)
+                const std::vector<const E*>& repl = edge->getReplacementEdges();
+                const int numRepl = edge->getNumReplacementEdges(veh->getLength());
+                assert(numRepl > 0);
                 double seenDist = 0;
                 double result = 0;
-                repl.pop_back(); // last edge must not be used fully
-                for (const E* e : repl) {
+                for (int i = 0; i < numRepl; i++) {
+                    result += (*myStaticOperation)(repl[i], veh, time + result);
+                    seenDist += repl[i]->getLength();
+                }
+                // last edge must not be used fully
+                for (int i = numRepl - 1; i > 0; i--) {
+                    const E* e = repl[i]->getBidiEdge();
                     result += (*myStaticOperation)(e, veh, time + result);
                     seenDist += e->getLength();
                 }
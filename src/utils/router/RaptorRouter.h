@@ -0,0 +1,266 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    RaptorRouter.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Round based earliest arrival routing on the intermodal network
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <algorithm>
+#include <assert.h>
+#include <limits>
+#include <string>
+#include <vector>
+#include <utils/common/MsgHandler.h>
+#include "SUMOAbstractRouter.h"
+#include "IntermodalNetwork.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class RaptorRouter
+ * @brief Computes earliest arrival routes similar to RAPTOR
+ *
+ * Each round consists of a foot path phase and a ride phase. The foot path phase
+ *  is a Dijkstra search over all edges except the public transport edges
+ *  (walking, access, car and taxi edges) starting from the edges improved in
+ *  the previous round. The ride phase scans every public transport line serving
+ *  a stop reached in the foot path phase once along its stop sequence, so the
+ *  ride edges never enter the priority queue. The rounds end when no label
+ *  improves, all searches are pruned by the current arrival time at the
+ *  destination. Since all travel times are FIFO, the result is the same
+ *  earliest arrival as found by the DijkstraRouter and the path consists of
+ *  the same intermodal edges.
+ */
+template<class E, class L, class N, class V>
+class RaptorRouter : public SUMOAbstractRouter<IntermodalEdge<E, L, N, V>, IntermodalTrip<E, N, V> > {
+private:
+    typedef IntermodalEdge<E, L, N, V> _IntermodalEdge;
+    typedef IntermodalTrip<E, N, V> _IntermodalTrip;
+    typedef IntermodalNetwork<E, L, N, V> _Network;
+    typedef PublicTransportEdge<E, L, N, V> _PTEdge;
+    typedef SUMOAbstractRouter<_IntermodalEdge, _IntermodalTrip> _Base;
+    typedef typename _Base::EdgeInfo EdgeInfo;
+    typedef std::pair<double, EdgeInfo*> QueueItem;
+
+    /// @brief orders the queue by effort (and by edge id for equal efforts)
+    struct QueueComparator {
+        bool operator()(const QueueItem& a, const QueueItem& b) const {
+            if (a.first == b.first) {
+                return a.second->edge->getNumericalID() > b.second->edge->getNumericalID();
+            }
+            return a.first > b.first;
+        }
+    };
+
+public:
+    /// @brief Constructor (the network needs to be complete including all schedules)
+    RaptorRouter(_Network* net, typename _Base::Operation operation) :
+        _Base("RaptorRouter", true, operation, nullptr, true, false),
+        myNetwork(net) {
+        for (const _IntermodalEdge* const e : net->getAllEdges()) {
+            this->myEdgeInfos.push_back(EdgeInfo(e));
+        }
+        myIsRide.resize(this->myEdgeInfos.size(), false);
+        myStopLines.resize(this->myEdgeInfos.size());
+        for (const auto& item : net->getPTLines()) {
+            const int lineIndex = (int)myLines.size();
+            myLines.push_back(&item.second);
+            for (int pos = 0; pos < (int)item.second.size(); pos++) {
+                const _PTEdge* const ride = item.second[pos];
+                myIsRide[ride->getNumericalID()] = true;
+                myStopLines[ride->getEntryStop()->getNumericalID()].push_back(std::make_pair(lineIndex, pos));
+            }
+        }
+        myLineStart.resize(myLines.size(), std::numeric_limits<int>::max());
+    }
+
+    /// @brief Destructor
+    virtual ~RaptorRouter() {}
+
+    _Base* clone() {
+        return new RaptorRouter<E, L, N, V>(myNetwork, this->myOperation);
+    }
+
+    /** @brief Builds the route between the given edges using the earliest arrival at the given time */
+    bool compute(const _IntermodalEdge* from, const _IntermodalEdge* to, const _IntermodalTrip* const trip,
+                 SUMOTime msTime, std::vector<const _IntermodalEdge*>& into, bool silent = false) {
+        assert(from != nullptr && to != nullptr);
+        if (this->myEdgeInfos[from->getNumericalID()].prohibited || this->isProhibited(from, trip)) {
+            if (!silent) {
+                this->myErrorMsgHandler->inform("Vehicle '" + Named::getIDSecure(trip) + "' is not allowed on source edge '" + from->getID() + "'.");
+            }
+            return false;
+        }
+        if (this->myEdgeInfos[to->getNumericalID()].prohibited || this->isProhibited(to, trip)) {
+            if (!silent) {
+                this->myErrorMsgHandler->inform("Vehicle '" + Named::getIDSecure(trip) + "' is not allowed on destination edge '" + to->getID() + "'.");
+            }
+            return false;
+        }
+        this->startQuery();
+        // all labels live in myFound (visited marks membership), the frontier is kept in myQueue
+        this->init(from->getNumericalID(), msTime);
+        EdgeInfo* const fromInfo = this->myFrontierList.front();
+        this->myFrontierList.clear();
+        fromInfo->visited = true;
+        this->myFound.push_back(fromInfo);
+        myQueue.clear();
+        myQueue.push_back(std::make_pair(0., fromInfo));
+        const EdgeInfo& toInfo = this->myEdgeInfos[to->getNumericalID()];
+        const SUMOVehicleClass vClass = trip == nullptr ? SVC_IGNORING : trip->getVClass();
+        int numVisited = 0;
+        while (!myQueue.empty()) {
+            // foot paths (and car edges)
+            while (!myQueue.empty()) {
+                std::pop_heap(myQueue.begin(), myQueue.end(), myComparator);
+                const QueueItem item = myQueue.back();
+                myQueue.pop_back();
+                EdgeInfo* const info = item.second;
+                if (item.first > info->effort) {
+                    // outdated entry
+                    continue;
+                }
+                if (info->effort >= toInfo.effort) {
+                    // neither this nor any of the remaining edges can improve the arrival
+                    myQueue.clear();
+                    break;
+                }
+                numVisited++;
+                const _IntermodalEdge* const edge = info->edge;
+                for (const std::pair<int, int>& lineStop : myStopLines[edge->getNumericalID()]) {
+                    if (myLineStart[lineStop.first] == std::numeric_limits<int>::max()) {
+                        myTouchedLines.push_back(lineStop.first);
+                    }
+                    myLineStart[lineStop.first] = MIN2(myLineStart[lineStop.first], lineStop.second);
+                }
+                relaxSuccessors(info, trip, vClass);
+            }
+            // rides
+            std::sort(myTouchedLines.begin(), myTouchedLines.end());
+            for (const int lineIndex : myTouchedLines) {
+                numVisited += scanLine(lineIndex, myLineStart[lineIndex], trip, vClass, toInfo);
+                myLineStart[lineIndex] = std::numeric_limits<int>::max();
+            }
+            myTouchedLines.clear();
+        }
+        this->endQuery(numVisited);
+        if (toInfo.effort < std::numeric_limits<double>::max()) {
+            this->buildPathFrom(&toInfo, into);
+            return true;
+        }
+        if (!silent) {
+            this->myErrorMsgHandler->informf(TL("No connection between edge '%' and edge '%' found."), from->getID(), to->getID());
+        }
+        return false;
+    }
+
+private:
+    /// @brief updates the label if the new effort is smaller
+    inline bool improve(EdgeInfo& info, const EdgeInfo* const prev, const double effort, const double time) {
+        if (effort >= info.effort) {
+            return false;
+        }
+        if (!info.visited) {
+            info.visited = true;
+            this->myFound.push_back(&info);
+        }
+        info.effort = effort;
+        info.leaveTime = time;
+        info.prev = prev;
+        return true;
+    }
+
+    /// @brief relaxes the successors of the given edge (except for rides) and queues the improved ones
+    inline void relaxSuccessors(const EdgeInfo* const info, const _IntermodalTrip* const trip, const SUMOVehicleClass vClass) {
+        const double effortDelta = this->getEffort(info->edge, trip, info->leaveTime);
+        for (const std::pair<const _IntermodalEdge*, const _IntermodalEdge*>& follower : info->edge->getViaSuccessors(vClass)) {
+            if (myIsRide[follower.first->getNumericalID()]) {
+                continue;
+            }
+            EdgeInfo& followerInfo = this->myEdgeInfos[follower.first->getNumericalID()];
+            if (followerInfo.prohibited || this->isProhibited(follower.first, trip)) {
+                continue;
+            }
+            double effort = info->effort + effortDelta;
+            double time = info->leaveTime + effortDelta;
+            double length = 0.;
+            this->updateViaEdgeCost(follower.second, trip, time, effort, length);
+            if (improve(followerInfo, info, effort, time)) {
+                myQueue.push_back(std::make_pair(effort, &followerInfo));
+                std::push_heap(myQueue.begin(), myQueue.end(), myComparator);
+            }
+        }
+    }
+
+    /// @brief scans the line from the given stop index, returns the number of rides evaluated
+    int scanLine(const int lineIndex, const int startPos, const _IntermodalTrip* const trip, const SUMOVehicleClass vClass, const EdgeInfo& toInfo) {
+        const std::vector<_PTEdge*>& line = *myLines[lineIndex];
+        int numRides = 0;
+        for (int pos = startPos; pos < (int)line.size(); pos++) {
+            const _PTEdge* const ride = line[pos];
+            const EdgeInfo& stopInfo = this->myEdgeInfos[ride->getEntryStop()->getNumericalID()];
+            if (stopInfo.effort >= toInfo.effort) {
+                // stop not reached (yet) or too late
+                continue;
+            }
+            EdgeInfo& rideInfo = this->myEdgeInfos[ride->getNumericalID()];
+            if (rideInfo.prohibited || this->isProhibited(ride, trip)) {
+                continue;
+            }
+            const double stopDelta = this->getEffort(stopInfo.edge, trip, stopInfo.leaveTime);
+            if (!improve(rideInfo, &stopInfo, stopInfo.effort + stopDelta, stopInfo.leaveTime + stopDelta)) {
+                continue;
+            }
+            numRides++;
+            // the exit stop is the only successor, improving it allows continuing the ride at the next position
+            relaxSuccessors(&rideInfo, trip, vClass);
+        }
+        return numRides;
+    }
+
+private:
+    /// @brief the network (with the public transport lines)
+    _Network* const myNetwork;
+
+    /// @brief the public transport edges of each line in stop order
+    std::vector<const std::vector<_PTEdge*>*> myLines;
+
+    /// @brief the lines (and the position within the line) departing at a stop edge, indexed by edge id
+    std::vector<std::vector<std::pair<int, int> > > myStopLines;
+
+    /// @brief whether the edge with the given id is a public transport edge
+    std::vector<bool> myIsRide;
+
+    /// @brief the first position to scan for each touched line (max int for untouched lines)
+    std::vector<int> myLineStart;
+
+    /// @brief the lines to scan in the current round
+    std::vector<int> myTouchedLines;
+
+    /// @brief the frontier of the foot path phase
+    std::vector<QueueItem> myQueue;
+
+    /// @brief the comparator for the queue
+    QueueComparator myComparator;
+
+private:
+    /// @brief Invalidated assignment operator
+    RaptorRouter& operator=(const RaptorRouter& s) = delete;
+};
@@ -91,6 +91,10 @@ public:
         return edge->myOriginal->getTravelTime(veh, time);
     }
 
+    static inline double getTravelTimeLowerBoundStatic(const ReversedEdge<E, V>* const edge, const V* const veh, double /* time */) {
+        return edge->myOriginal->getTravelTimeLowerBound(veh);
+    }
+
     const ConstEdgePairVector& getViaSuccessors(SUMOVehicleClass vClass = SVC_IGNORING) const {
         if (vClass == SVC_IGNORING || myOriginal->isTazConnector()) { // || !MSNet::getInstance()->hasPermissions()) {
             return myViaSuccessors;
@@ -65,6 +65,17 @@ public:
         return mySkipNewRoutes;
     }
 
+    /// @brief whether the vehicle reuses its alternatives without searching for a new route (see reroute-probability)
+    bool skipRerouting() const {
+        if (myRerouteProb >= 1) {
+            return false;
+        } else if (myRerouteProb <= 0) {
+            return true;
+        } else {
+            return RandHelper::rand() >= myRerouteProb;
+        }
+    }
+
     bool keepRoute() const {
         if (myKeepRouteProb == 1) {
             return true;
@@ -83,6 +94,7 @@ protected:
         myKeepRoutes = oc.getBool("keep-all-routes");
         mySkipNewRoutes = oc.getBool("skip-new-routes");
         myKeepRouteProb = oc.exists("keep-route-probability") ? oc.getFloat("keep-route-probability") : 0;
+        myRerouteProb = oc.exists("reroute-probability") ? oc.getFloat("reroute-probability") : 1;
     }
 
     /// @brief Destructor
@@ -103,6 +115,9 @@ private:
     /// @brief Information whether the old route shall be kept
     double myKeepRouteProb;
 
+    /// @brief The probability of searching a new route for a vehicle with valid alternatives
+    double myRerouteProb;
+
 };
 
 
@@ -34,6 +34,7 @@
 #include <utils/common/ToString.h>
 #include <utils/common/StdDefs.h>
 #include <utils/common/ParametrisedWrappingCommand.h>
+#include <utils/common/NamedRTree.h>
 #include "PolygonDynamics.h"
 #include "ShapeContainer.h"
 
@@ -44,7 +45,9 @@
 // ===========================================================================
 // method definitions
 // ===========================================================================
-ShapeContainer::ShapeContainer() {}
+ShapeContainer::ShapeContainer() :
+    myPolygonTree(nullptr),
+    myPOITree(nullptr) {}
 
 ShapeContainer::~ShapeContainer() {
     for (auto& p : myPolygonUpdateCommands) {
@@ -56,7 +59,8 @@ ShapeContainer::~ShapeContainer() {
         delete p.second;
     }
     myPolygonDynamics.clear();
-
+    delete myPolygonTree;
+    delete myPOITree;
 }
 
 bool
@@ -155,12 +159,20 @@ ShapeContainer::removePolygon(const std::string& id, bool /* useLock */) {
     std::cout << "ShapeContainer: Removing Polygon '" << id << "'" << std::endl;
 #endif
     removePolygonDynamics(id);
+    SUMOPolygon* p = myPolygons.get(id);
+    if (p != nullptr) {
+        unindexPolygon(p);
+    }
     return myPolygons.remove(id);
 }
 
 
 bool
 ShapeContainer::removePOI(const std::string& id) {
+    PointOfInterest* p = myPOIs.get(id);
+    if (p != nullptr) {
+        unindexPOI(p);
+    }
     return myPOIs.remove(id);
 }
 
@@ -169,7 +181,9 @@ void
 ShapeContainer::movePOI(const std::string& id, const Position& pos) {
     PointOfInterest* p = myPOIs.get(id);
     if (p != nullptr) {
+        unindexPOI(p);
         static_cast<Position*>(p)->set(pos);
+        indexPOI(p);
     }
 }
 
@@ -178,7 +192,9 @@ void
 ShapeContainer::reshapePolygon(const std::string& id, const PositionVector& shape) {
     SUMOPolygon* p = myPolygons.get(id);
     if (p != nullptr) {
+        unindexPolygon(p);
         p->setShape(shape);
+        indexPolygon(p);
     }
 }
 
@@ -189,6 +205,7 @@ ShapeContainer::add(SUMOPolygon* poly, bool /* ignorePruning */) {
         delete poly;
         return false;
     }
+    indexPolygon(poly);
     return true;
 }
 
@@ -199,9 +216,74 @@ ShapeContainer::add(PointOfInterest* poi, bool /* ignorePruning */) {
         delete poi;
         return false;
     }
+    indexPOI(poi);
     return true;
 }
 
+
+NamedRTree*
+ShapeContainer::getPolygonTree() {
+    if (myPolygonTree == nullptr) {
+        myPolygonTree = new NamedRTree();
+        for (const auto& item : myPolygons) {
+            indexPolygon(item.second);
+        }
+    }
+    return myPolygonTree;
+}
+
+
+NamedRTree*
+ShapeContainer::getPOITree() {
+    if (myPOITree == nullptr) {
+        myPOITree = new NamedRTree();
+        for (const auto& item : myPOIs) {
+            indexPOI(item.second);
+        }
+    }
+    return myPOITree;
+}
+
+
+void
+ShapeContainer::indexPolygon(SUMOPolygon* poly) {
+    if (myPolygonTree != nullptr) {
+        const Boundary b = poly->getShape().getBoxBoundary();
+        const float cmin[2] = {(float) b.xmin(), (float) b.ymin()};
+        const float cmax[2] = {(float) b.xmax(), (float) b.ymax()};
+        myPolygonTree->Insert(cmin, cmax, poly);
+    }
+}
+
+
+void
+ShapeContainer::unindexPolygon(SUMOPolygon* poly) {
+    if (myPolygonTree != nullptr) {
+        const Boundary b = poly->getShape().getBoxBoundary();
+        const float cmin[2] = {(float) b.xmin(), (float) b.ymin()};
+        const float cmax[2] = {(float) b.xmax(), (float) b.ymax()};
+        myPolygonTree->Remove(cmin, cmax, poly);
+    }
+}
+
+
+void
+ShapeContainer::indexPOI(PointOfInterest* poi) {
+    if (myPOITree != nullptr) {
+        const float cmin[2] = {(float) poi->x(), (float) poi->y()};
+        myPOITree->Insert(cmin, cmin, poi);
+    }
+}
+
+
+void
+ShapeContainer::unindexPOI(PointOfInterest* poi) {
+    if (myPOITree != nullptr) {
+        const float cmin[2] = {(float) poi->x(), (float) poi->y()};
+        myPOITree->Remove(cmin, cmin, poi);
+    }
+}
+
 void
 ShapeContainer::clearState() {
     for (auto& item : myPolygonUpdateCommands) {
@@ -222,7 +304,10 @@ ShapeContainer::cleanupPolygonDynamics(const std::string& id) {
 
 SUMOTime
 ShapeContainer::polygonDynamicsUpdate(SUMOTime t, PolygonDynamics* pd) {
+    // the tree entry must be removed with the box it was inserted with
+    unindexPolygon(pd->getPolygon());
     SUMOTime next = pd->update(t);
+    indexPolygon(pd->getPolygon());
     if (next == 0) {
         // Dynamics have expired => remove polygon
         myPolygonUpdateCommands[pd->getPolygonID()]->deschedule();
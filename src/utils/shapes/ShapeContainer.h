@@ -33,6 +33,7 @@
 // ===========================================================================
 // class declarations
 // ===========================================================================
+class NamedRTree;
 class PolygonDynamics;
 class SUMOTrafficObject;
 template <class T, class S>
@@ -158,6 +159,16 @@ public:
         return myPOIs;
     }
 
+    /** @brief Returns a spatial index of all polygons (by their bounding boxes)
+     *
+     * The tree is built on first use and kept up to date afterwards when
+     *  polygons are added, removed, reshaped or moved by their dynamics.
+     */
+    NamedRTree* getPolygonTree();
+
+    /// @brief Returns a spatial index of all pois (see getPolygonTree)
+    NamedRTree* getPOITree();
+
     /** @brief Regular update event for updating polygon dynamics
     * @param[in] t  The time at which the update is called
     * @param[in] pd The dynamics to be updated
@@ -200,6 +211,14 @@ protected:
     virtual void clearHighlights(const std::string& objectID, SUMOPolygon* p);
     /// @}
 
+    /// @name Maintenance of the spatial indices (no-ops as long as the trees are not built)
+    /// @{
+    void indexPolygon(SUMOPolygon* poly);
+    void unindexPolygon(SUMOPolygon* poly);
+    void indexPOI(PointOfInterest* poi);
+    void unindexPOI(PointOfInterest* poi);
+    /// @}
+
 protected:
     /// @brief stored Polygons
     Polygons myPolygons;
@@ -224,4 +243,10 @@ private:
     /// @brief Command pointers for scheduled polygon update. Maps PolyID->Command
     std::map<const std::string, ParametrisedWrappingCommand<ShapeContainer, PolygonDynamics*>*> myPolygonUpdateCommands;
 
+    /// @brief spatial index of the polygons (built on demand)
+    NamedRTree* myPolygonTree;
+
+    /// @brief spatial index of the pois (built on demand)
+    NamedRTree* myPOITree;
+
 };
@@ -416,6 +416,7 @@ void
 TraCIAPI::readVariableSubscription(int cmdId, tcpip::Storage& inMsg) {
     const std::string objectID = inMsg.readString();
     const int variableCount = inMsg.readUnsignedByte();
+    myDomains[cmdId]->restoreDeltaResults(objectID);
     readVariables(inMsg, objectID, variableCount, myDomains[cmdId]->getModifiableSubscriptionResults());
 }
 
@@ -3853,6 +3854,15 @@ TraCIAPI::TraCIScopeWrapper::subscribeContext(const std::string& objID, int doma
 }
 
 
+void
+TraCIAPI::TraCIScopeWrapper::subscribeDelta(const std::string& objID, const std::vector<int>& vars, double beginTime, double endTime) {
+    subscribe(objID, vars, beginTime, endTime);
+    myParent.createFilterCommand(libsumo::CMD_ADD_SUBSCRIPTION_FILTER, libsumo::FILTER_TYPE_DELTA);
+    myParent.processSet(libsumo::CMD_ADD_SUBSCRIPTION_FILTER);
+    myDeltaSubscriptions.insert(objID);
+}
+
+
 const libsumo::SubscriptionResults
 TraCIAPI::TraCIScopeWrapper::getAllSubscriptionResults() const {
     return mySubscriptionResults;
@@ -3887,6 +3897,14 @@ TraCIAPI::TraCIScopeWrapper::getContextSubscriptionResults(const std::string& ob
 
 void
 TraCIAPI::TraCIScopeWrapper::clearSubscriptionResults() {
+    // keep the delta values of the objects which were part of the last response
+    myDeltaResults.clear();
+    for (const std::string& objID : myDeltaSubscriptions) {
+        auto it = mySubscriptionResults.find(objID);
+        if (it != mySubscriptionResults.end()) {
+            myDeltaResults[objID] = it->second;
+        }
+    }
     mySubscriptionResults.clear();
     myContextSubscriptionResults.clear();
 }
@@ -3904,4 +3922,13 @@ TraCIAPI::TraCIScopeWrapper::getModifiableContextSubscriptionResults(const std::
 }
 
 
+void
+TraCIAPI::TraCIScopeWrapper::restoreDeltaResults(const std::string& objID) {
+    auto it = myDeltaResults.find(objID);
+    if (it != myDeltaResults.end()) {
+        mySubscriptionResults[objID] = it->second;
+    }
+}
+
+
 /****************************************************************************/
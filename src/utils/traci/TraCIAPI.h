@@ -22,6 +22,7 @@
 #pragma once
 #include <config.h>
 #include <vector>
+#include <set>
 #include <limits>
 #include <string>
 #include <sstream>
@@ -116,6 +117,12 @@ public:
         void subscribe(const std::string& objID, const std::vector<int>& vars, double beginTime, double endTime) const;
         void subscribeContext(const std::string& objID, int domain, double range, const std::vector<int>& vars, double beginTime, double endTime) const;
 
+        /** @brief subscribes to the variables but lets the server only send the values which changed
+         *
+         * The results keep the last received value of every variable, so they look like a full subscription.
+         */
+        void subscribeDelta(const std::string& objID, const std::vector<int>& vars, double beginTime, double endTime);
+
         const libsumo::SubscriptionResults getAllSubscriptionResults() const;
         const libsumo::TraCIResults getSubscriptionResults(const std::string& objID) const;
 
@@ -126,6 +133,7 @@ public:
         void clearSubscriptionResults();
         libsumo::SubscriptionResults& getModifiableSubscriptionResults();
         libsumo::SubscriptionResults& getModifiableContextSubscriptionResults(const std::string& objID);
+        void restoreDeltaResults(const std::string& objID);
 
     protected:
         int getUnsignedByte(int var, const std::string& id, tcpip::Storage* add = 0) const;
@@ -157,6 +165,10 @@ public:
         int myContextSubscribeID;
         libsumo::SubscriptionResults mySubscriptionResults;
         libsumo::ContextSubscriptionResults myContextSubscriptionResults;
+        /// @brief the objects with delta subscriptions
+        std::set<std::string> myDeltaSubscriptions;
+        /// @brief the values of the delta subscriptions received until the last step
+        libsumo::SubscriptionResults myDeltaResults;
 
 
     private:
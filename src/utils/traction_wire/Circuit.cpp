@@ -25,6 +25,7 @@
 /****************************************************************************/
 #include <config.h>
 
+#include <algorithm>
 #include <cfloat>
 #include <cstdlib>
 #include <iostream>
@@ -195,15 +196,24 @@ void Circuit::unlock() {
 }
 
 #ifdef HAVE_EIGEN
-void Circuit::removeColumn(Eigen::MatrixXd& matrix, int colToRemove) {
-    const int numRows = (int)matrix.rows();
-    const int numCols = (int)matrix.cols() - 1;
-
-    if (colToRemove < numCols) {
-        matrix.block(0, colToRemove, numRows, numCols - colToRemove) = matrix.rightCols(numCols - colToRemove);
-    }
-
-    matrix.conservativeResize(numRows, numCols);
+Eigen::VectorXd Circuit::solveLinear(const Eigen::SparseMatrix<double>& matrix, const Eigen::VectorXd& rhs) {
+    const int* outer = matrix.outerIndexPtr();
+    const int* inner = matrix.innerIndexPtr();
+    const int numOuter = (int)matrix.outerSize() + 1;
+    const int numInner = (int)matrix.nonZeros();
+    if ((int)solverPatternOuter.size() != numOuter || (int)solverPatternInner.size() != numInner
+            || !std::equal(outer, outer + numOuter, solverPatternOuter.begin())
+            || !std::equal(inner, inner + numInner, solverPatternInner.begin())) {
+        // the topology of the circuit changed
+        solver.analyzePattern(matrix);
+        solverPatternOuter.assign(outer, outer + numOuter);
+        solverPatternInner.assign(inner, inner + numInner);
+    }
+    solver.factorize(matrix);
+    if (solver.info() == Eigen::Success) {
+        return solver.solve(rhs);
+    }
+    return Eigen::MatrixXd(matrix).colPivHouseholderQr().solve(rhs);
 }
 
 bool Circuit::solveEquationsNRmethod(double* eqn, double* vals, std::vector<int>* removable_ids) {
@@ -211,16 +221,27 @@ bool Circuit::solveEquationsNRmethod(double* eqn, double* vals, std::vector<int>
     int numofcolumn = (int)voltageSources->size() + (int)nodes->size() - 1;
     int numofeqs = numofcolumn - (int)removable_ids->size();
 
-    // map equations into matrix A
-    Eigen::MatrixXd A = Eigen::Map < Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> >(eqn, numofeqs, numofcolumn);
-
-    int id;
     // remove removable columns of matrix A, i.e. remove equations corresponding to nodes with two resistors connected in series
-    // RICE_TODO auto for ?
+    std::vector<int> columns(numofcolumn);
+    for (int i = 0; i < numofcolumn; i++) {
+        columns[i] = i;
+    }
     for (std::vector<int>::reverse_iterator it = removable_ids->rbegin(); it != removable_ids->rend(); ++it) {
-        id = (*it >= 0 ? *it : -(*it));
-        removeColumn(A, id);
+        columns.erase(columns.begin() + (*it >= 0 ? *it : -(*it)));
+    }
+
+    // map equations into the sparse matrix A (most nodes are connected to two neighbors only)
+    std::vector<Eigen::Triplet<double> > triplets;
+    for (int row = 0; row < numofeqs; row++) {
+        for (int col = 0; col < (int)columns.size(); col++) {
+            const double value = eqn[row * numofcolumn + columns[col]];
+            if (value != 0.) {
+                triplets.push_back(Eigen::Triplet<double>(row, col, value));
+            }
+        }
     }
+    Eigen::SparseMatrix<double> A(numofeqs, (int)columns.size());
+    A.setFromTriplets(triplets.begin(), triplets.end());
 
     // detect number of column for each node
     // in other words: detect elements of x to certain node
@@ -257,12 +278,32 @@ bool Circuit::solveEquationsNRmethod(double* eqn, double* vals, std::vector<int>
         WRITE_ERROR(TL("Structural error in reduced circuit matrix."));
     }
 
+    // the Jacobian J differs from A in the entries of the nodes with current sources only,
+    // these are added as explicit zeros to A such that all matrices share the sparsity pattern
+    for (auto& node : *nodes) {
+        if (node->isGround() || node->isRemovable() || node->getNumMatrixRow() == -2) {
+            continue;
+        }
+        for (Element* const element : *node->getElements()) {
+            if (element->getType() == Element::ElementType::CURRENT_SOURCE_traction_wire) {
+                if (element->getPosNode()->getNumMatrixCol() != -1) {
+                    triplets.push_back(Eigen::Triplet<double>(node->getNumMatrixRow(), element->getPosNode()->getNumMatrixCol(), 0.));
+                }
+                if (element->getNegNode()->getNumMatrixCol() != -1) {
+                    triplets.push_back(Eigen::Triplet<double>(node->getNumMatrixRow(), element->getNegNode()->getNumMatrixCol(), 0.));
+                }
+            }
+        }
+    }
+    Eigen::SparseMatrix<double> Jbase(numofeqs, (int)columns.size());
+    Jbase.setFromTriplets(triplets.begin(), triplets.end());
+
     // map 'vals' into vector b and initialize solution x
     Eigen::Map<Eigen::VectorXd> b(vals, numofeqs);
-    Eigen::VectorXd x = A.colPivHouseholderQr().solve(b);
+    Eigen::VectorXd x = solveLinear(Jbase, b);
 
     // initialize Jacobian matrix J and vector dx
-    Eigen::MatrixXd J = A;
+    Eigen::SparseMatrix<double> J = Jbase;
     Eigen::VectorXd dx;
     // initialize progressively increasing maximal number of Newton-Rhapson iterations
     int max_iter_of_NR = 10;
@@ -298,7 +339,7 @@ bool Circuit::solveEquationsNRmethod(double* eqn, double* vals, std::vector<int>
             for (int i = 0; i < numofeqs - (int) voltageSources->size(); i++) {
                 vals[i] = 0;
             }
-            J = A;
+            J = Jbase;
 
             int i = 0;
             for (auto& node : *nodes) {
@@ -335,11 +376,11 @@ bool Circuit::solveEquationsNRmethod(double* eqn, double* vals, std::vector<int>
                                 (*it_element)->setCurrent(-alpha * (*it_element)->getPowerWanted() / diff_voltage);
                                 if (PosNode_NumACol != -1) {
                                     // -1* d_b/d_phiPos = -1* d(-alpha*P/(phiPos-phiNeg) )/d_phiPos = -1* (--alpha*P/(phiPos-phiNeg)^2 )
-                                    J(i, PosNode_NumACol) -= alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
+                                    J.coeffRef(i, PosNode_NumACol) -= alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
                                 }
                                 if (NegNode_NumACol != -1) {
                                     // -1* d_b/d_phiNeg = -1* d(-alpha*P/(phiPos-phiNeg) )/d_phiNeg = -1* (---alpha*P/(phiPos-phiNeg)^2 )
-                                    J(i, NegNode_NumACol) += alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
+                                    J.coeffRef(i, NegNode_NumACol) += alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
                                 }
                             } else {
                                 // the positive current (the element is consuming energy if powerWanted > 0) is flowing to the negative node (sign plus)
@@ -351,11 +392,11 @@ bool Circuit::solveEquationsNRmethod(double* eqn, double* vals, std::vector<int>
                                 WRITE_WARNING(TL("The negative node of current source is not the groud."))
                                 if (PosNode_NumACol != -1) {
                                     // -1* d_b/d_phiPos = -1* d(alpha*P/(phiPos-phiNeg) )/d_phiPos = -1* (-alpha*P/(phiPos-phiNeg)^2 )
-                                    J(i, PosNode_NumACol) += alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
+                                    J.coeffRef(i, PosNode_NumACol) += alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
                                 }
                                 if (NegNode_NumACol != -1) {
                                     // -1* d_b/d_phiNeg = -1* d(alpha*P/(phiPos-phiNeg) )/d_phiNeg = -1* (--alpha*P/(phiPos-phiNeg)^2 )
-                                    J(i, NegNode_NumACol) -= alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
+                                    J.coeffRef(i, NegNode_NumACol) -= alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
                                 }
                             }
                         }
@@ -409,7 +450,7 @@ bool Circuit::solveEquationsNRmethod(double* eqn, double* vals, std::vector<int>
             }
 
             // Newton=Rhapson iteration
-            dx = -J.colPivHouseholderQr().solve(A * x - b);
+            dx = -solveLinear(J, A * x - b);
             x = x + dx;
             ++iterNR;
         }
@@ -84,6 +84,14 @@ private:
     * stable solution. This is then reported as alphaBest.
     */
     double alphaBest;
+
+#ifdef HAVE_EIGEN
+    /// @brief The sparse LU solver, its symbolic factorization is kept as long as the pattern of the matrix does not change
+    Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > solver;
+
+    /// @brief The sparsity pattern (column starts and row indices) the solver has been analyzed for
+    std::vector<int> solverPatternOuter, solverPatternInner;
+#endif
 public:
     /**
      * @brief Flag of alpha scaling parameter
@@ -177,9 +185,11 @@ private:
     bool createEquation(Element* vsource, double* eqn, double& val);
 
     /*
-     *    removes the "colToRemove"-th column from matrix "matrix"
+     *    solves the linear system matrix * x = rhs by the sparse LU decomposition
+     *    reuses the symbolic factorization if the sparsity pattern did not change since the last call
+     *    falls back to the dense QR decomposition if the matrix is singular
      */
-    void removeColumn(Eigen::MatrixXd& matrix, const int colToRemove);
+    Eigen::VectorXd solveLinear(const Eigen::SparseMatrix<double>& matrix, const Eigen::VectorXd& rhs);
 
     /*
      * solves the system of nonlinear equations Ax = B(1/x)
@@ -20,30 +20,138 @@
 /****************************************************************************/
 #include <config.h>
 
+#include <utils/common/UtilExceptions.h>
+#include <utils/xml/SUMOSAXAttributes.h>
+#include <utils/xml/SUMOSAXHandler.h>
 #include <utils/xml/SUMOSAXReader.h>
 #include <utils/xml/XMLSubSys.h>
 #include "SUMORouteHandler.h"
 #include "SUMORouteLoader.h"
 
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const int SUMORouteLoader::CHUNK_SIZE = 256;
+const int SUMORouteLoader::MAX_CHUNKS = 512;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/// @brief records the parsed elements for the prefetching thread
+class SUMORouteLoader::Recorder : public SUMOSAXHandler {
+public:
+    Recorder(const std::string& file) : SUMOSAXHandler(file) {}
+
+    /// @brief the elements recorded since the last hand over
+    std::vector<Element> myElements;
+
+protected:
+    void myStartElement(int element, const SUMOSAXAttributes& attrs) {
+        myElements.push_back(Element({element, std::unique_ptr<SUMOSAXAttributes>(attrs.clone())}));
+    }
+
+    void myEndElement(int element) {
+        myElements.push_back(Element({element, nullptr}));
+    }
+};
+
+
 // ===========================================================================
 // method definitions
 // ===========================================================================
-SUMORouteLoader::SUMORouteLoader(SUMORouteHandler* handler)
-    : myParser(nullptr), myMoreAvailable(true), myHandler(handler) {
-    myParser = XMLSubSys::getSAXReader(*myHandler, false, true);
+SUMORouteLoader::SUMORouteLoader(SUMORouteHandler* handler, const bool prefetch)
+    : myParser(nullptr), myMoreAvailable(true), myHandler(handler), myRecorder(nullptr),
+      myCurrentIndex(0), myStopPrefetching(false) {
+    if (prefetch) {
+        myRecorder = new Recorder(myHandler->getFileName());
+        myParser = XMLSubSys::getSAXReader(*myRecorder, false, true);
+    } else {
+        myParser = XMLSubSys::getSAXReader(*myHandler, false, true);
+    }
     if (!myParser->parseFirst(myHandler->getFileName())) {
         throw ProcessError(TLF("Can not read XML-file '%'.", myHandler->getFileName()));
     }
+    if (prefetch) {
+        myPrefetcher = std::thread(&SUMORouteLoader::prefetchLoop, this);
+    }
 }
 
 
 SUMORouteLoader::~SUMORouteLoader() {
+    if (myPrefetcher.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(myLock);
+            myStopPrefetching = true;
+        }
+        myCondition.notify_all();
+        myPrefetcher.join();
+    }
     delete myParser;
+    delete myRecorder;
     delete myHandler;
 }
 
 
+void
+SUMORouteLoader::prefetchLoop() {
+    bool last = false;
+    while (!last) {
+        Chunk chunk;
+        try {
+            while ((int)myRecorder->myElements.size() < CHUNK_SIZE && !last) {
+                last = !myParser->parseNext();
+            }
+        } catch (const std::exception& e) {
+            chunk.error = e.what();
+            last = true;
+        }
+        chunk.elements.swap(myRecorder->myElements);
+        chunk.last = last;
+        std::unique_lock<std::mutex> lock(myLock);
+        myCondition.wait(lock, [this]() {
+            return myStopPrefetching || (int)myChunks.size() < MAX_CHUNKS;
+        });
+        if (myStopPrefetching) {
+            return;
+        }
+        myChunks.push_back(std::move(chunk));
+        myCondition.notify_all();
+    }
+}
+
+
+bool
+SUMORouteLoader::processNext() {
+    while (myCurrentIndex >= (int)myCurrentChunk.elements.size()) {
+        if (myCurrentChunk.last) {
+            if (!myCurrentChunk.error.empty()) {
+                throw ProcessError(myCurrentChunk.error);
+            }
+            return false;
+        }
+        std::unique_lock<std::mutex> lock(myLock);
+        myCondition.wait(lock, [this]() {
+            return !myChunks.empty();
+        });
+        myCurrentChunk = std::move(myChunks.front());
+        myChunks.pop_front();
+        myCurrentIndex = 0;
+        myCondition.notify_all();
+    }
+    Element& e = myCurrentChunk.elements[myCurrentIndex++];
+    GenericSAXHandler* const handler = myHandler;
+    if (e.attrs != nullptr) {
+        handler->myStartElement(e.element, *e.attrs);
+        e.attrs.reset();
+    } else {
+        handler->myEndElement(e.element);
+    }
+    return true;
+}
+
+
 SUMOTime
 SUMORouteLoader::loadUntil(SUMOTime time) {
     // read only when further data is available, no error occurred
@@ -55,7 +163,7 @@ SUMORouteLoader::loadUntil(SUMOTime time) {
     // read vehicles until specified time or the period to read vehicles
     //  until is reached
     while (myHandler->getLastDepart() <= time) {
-        if (!myParser->parseNext()) {
+        if (!(myRecorder != nullptr ? processNext() : myParser->parseNext())) {
             // no data available anymore
             myMoreAvailable = false;
             return SUMOTime_MAX;
@@ -21,6 +21,13 @@
 #pragma once
 #include <config.h>
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include <utils/common/SUMOTime.h>
 
 
@@ -28,6 +35,7 @@
 // class declarations
 // ===========================================================================
 class SUMORouteHandler;
+class SUMOSAXAttributes;
 class SUMOSAXReader;
 
 
@@ -36,11 +44,20 @@ class SUMOSAXReader;
 // ===========================================================================
 /**
  * @class SUMORouteLoader
+ *
+ * When prefetching, a background thread parses the file ahead and records the
+ *  elements with their attributes. loadUntil then only passes the recorded
+ *  elements to the handler which builds the routes and vehicles (on the calling
+ *  thread, since this touches the global containers). Character data is not
+ *  passed on in this mode.
  */
 class SUMORouteLoader {
 public:
-    /// @brief constructor
-    SUMORouteLoader(SUMORouteHandler* handler);
+    /** @brief constructor
+     * @param[in] handler The handler which builds the loaded objects
+     * @param[in] prefetch Whether to parse the file in a background thread
+     */
+    SUMORouteLoader(SUMORouteHandler* handler, const bool prefetch = false);
 
     /// @brief destructor
     ~SUMORouteLoader();
@@ -55,6 +72,31 @@ public:
     SUMOTime getFirstDepart() const;
 
 private:
+    /// @brief a recorded opening or closing tag
+    struct Element {
+        /// @brief the element id
+        int element;
+        /// @brief the attributes of an opening tag (nullptr for a closing tag)
+        std::unique_ptr<SUMOSAXAttributes> attrs;
+    };
+
+    /// @brief a chunk of recorded elements
+    struct Chunk {
+        std::vector<Element> elements;
+        /// @brief whether this is the last chunk of the file
+        bool last = false;
+        /// @brief the message of an error which ended the parsing
+        std::string error;
+    };
+
+    class Recorder;
+
+    /// @brief the main loop of the prefetching thread
+    void prefetchLoop();
+
+    /// @brief passes the next recorded element to the handler, returns false if the file is finished
+    bool processNext();
+
     /// @brief the used SAXReader
     SUMOSAXReader* myParser;
 
@@ -63,4 +105,35 @@ private:
 
     /// @brief the used Handler
     SUMORouteHandler* myHandler;
+
+    /// @name prefetching
+    /// @{
+    /// @brief the handler recording the elements (nullptr if not prefetching)
+    Recorder* myRecorder;
+
+    /// @brief the chunks parsed but not processed yet
+    std::deque<Chunk> myChunks;
+
+    /// @brief the chunk currently processed and the position therein
+    Chunk myCurrentChunk;
+    int myCurrentIndex;
+
+    std::thread myPrefetcher;
+    std::mutex myLock;
+    std::condition_variable myCondition;
+
+    /// @brief whether the prefetching thread shall stop
+    bool myStopPrefetching;
+
+    /// @brief the number of elements per chunk and the maximum number of chunks parsed ahead
+    static const int CHUNK_SIZE;
+    static const int MAX_CHUNKS;
+    /// @}
+
+private:
+    /// @brief Invalidated copy constructor
+    SUMORouteLoader(const SUMORouteLoader&) = delete;
+
+    /// @brief Invalidated assignment operator
+    SUMORouteLoader& operator=(const SUMORouteLoader&) = delete;
 };
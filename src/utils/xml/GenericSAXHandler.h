@@ -223,6 +223,8 @@ public:
 
     // Reader needs access to myStartElement, myEndElement
     friend class SUMOSAXReader;
+    friend class SUMORouteLoader;
+    friend class SUMOSAXCache;
 
 
 protected:
@@ -0,0 +1,497 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    OSMPBFInput.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Decodes OpenStreetMap protocol buffer files (.osm.pbf) into xml events
+/****************************************************************************/
+#include <config.h>
+
+#include <cstring>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#include <utils/common/MsgHandler.h>
+#include <utils/common/StringUtils.h>
+#include <utils/common/ToString.h>
+#include <utils/common/UtilExceptions.h>
+#include <utils/threadpool/WorkStealingThreadPool.h>
+#include "OSMPBFInput.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+int OSMPBFInput::myNumThreads = 1;
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+bool
+OSMPBFInput::Message::nextField(int& field, int& wireType) {
+    if (atEnd()) {
+        return false;
+    }
+    const unsigned long long int key = varint();
+    field = (int)(key >> 3);
+    wireType = (int)(key & 7);
+    return true;
+}
+
+
+unsigned long long int
+OSMPBFInput::Message::varint() {
+    unsigned long long int result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (myPos >= myEnd) {
+            throw ProcessError(TL("Unexpected end of a protocol buffer message."));
+        }
+        const unsigned char byte = (unsigned char) * myPos++;
+        result |= (unsigned long long int)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return result;
+        }
+    }
+    throw ProcessError(TL("Invalid varint in a protocol buffer message."));
+}
+
+
+void
+OSMPBFInput::Message::packed(const int wireType, std::vector<unsigned long long int>& into) {
+    if (wireType == 2) {
+        Message values = bytes();
+        while (!values.atEnd()) {
+            into.push_back(values.varint());
+        }
+    } else {
+        into.push_back(varint());
+    }
+}
+
+
+OSMPBFInput::Message
+OSMPBFInput::Message::bytes() {
+    const unsigned long long int size = varint();
+    if (size > (unsigned long long int)(myEnd - myPos)) {
+        throw ProcessError(TL("Unexpected end of a protocol buffer message."));
+    }
+    const Message result(myPos, (size_t)size);
+    myPos += size;
+    return result;
+}
+
+
+void
+OSMPBFInput::Message::skip(const int wireType) {
+    switch (wireType) {
+        case 0:
+            varint();
+            break;
+        case 1:
+            myPos += 8;
+            break;
+        case 2:
+            bytes();
+            break;
+        case 5:
+            myPos += 4;
+            break;
+        default:
+            throw ProcessError(TLF("Unsupported wire type % in a protocol buffer message.", toString(wireType)));
+    }
+    if (myPos > myEnd) {
+        throw ProcessError(TL("Unexpected end of a protocol buffer message."));
+    }
+}
+
+
+OSMPBFInput::OSMPBFInput(const std::string& systemID) :
+    myFile(systemID),
+    myStream(StringUtils::transcodeToLocal(systemID).c_str(), std::fstream::in | std::fstream::binary),
+    myEOF(false),
+    myCurrentIndex(0),
+    myRootState(0) {
+    myRootOpen.open = true;
+    myRootOpen.name = "osm";
+    myRootClose.open = false;
+    myRootClose.name = "osm";
+    if (myNumThreads > 1) {
+        myThreadPool = std::unique_ptr<WorkStealingThreadPool<int> >(new WorkStealingThreadPool<int>(false, std::vector<int>(myNumThreads)));
+    }
+}
+
+
+OSMPBFInput::~OSMPBFInput() {
+    for (auto& pending : myPending) {
+        pending.wait();
+    }
+}
+
+
+bool
+OSMPBFInput::isPBFFile(const std::string& systemID) {
+    // the first blob header: its size (4 bytes) followed by the type field "OSMHeader"
+    std::ifstream istream(StringUtils::transcodeToLocal(systemID).c_str(), std::fstream::in | std::fstream::binary);
+    char start[15];
+    istream.read(start, sizeof(start));
+    return istream.gcount() == (std::streamsize)sizeof(start) && start[4] == 0x0a && start[5] == 9 && std::memcmp(start + 6, "OSMHeader", 9) == 0;
+}
+
+
+const OSMPBFInput::Event*
+OSMPBFInput::next() {
+    if (myRootState == 0) {
+        myRootState = 1;
+        return &myRootOpen;
+    }
+    while (myCurrent == nullptr || myCurrentIndex >= myCurrent->size()) {
+        myCurrent = nullptr;
+        myCurrentIndex = 0;
+        if (myThreadPool != nullptr) {
+            fetch();
+            if (myPending.empty()) {
+                break;
+            }
+            myCurrent = myPending.front().get();
+            myPending.pop_front();
+        } else {
+            std::string type;
+            std::string blob;
+            if (!readBlob(type, blob)) {
+                break;
+            }
+            myCurrent = decode(type, blob, myFile);
+        }
+    }
+    if (myCurrent != nullptr) {
+        return &(*myCurrent)[myCurrentIndex++];
+    }
+    if (myRootState == 1) {
+        myRootState = 2;
+        return &myRootClose;
+    }
+    return nullptr;
+}
+
+
+void
+OSMPBFInput::fetch() {
+    // keep all threads busy while the current blob is consumed
+    while (!myEOF && (int)myPending.size() < 2 * myNumThreads) {
+        std::string type;
+        std::string blob;
+        if (!readBlob(type, blob)) {
+            break;
+        }
+        const std::string file = myFile;
+        myPending.push_back(myThreadPool->executeAsync([type, data = std::move(blob), file](int) {
+            return decode(type, data, file);
+        }));
+    }
+}
+
+
+bool
+OSMPBFInput::readBlob(std::string& type, std::string& blob) {
+    if (myEOF) {
+        return false;
+    }
+    unsigned char sizeBytes[4];
+    myStream.read((char*)sizeBytes, 4);
+    if (myStream.gcount() == 0) {
+        myEOF = true;
+        return false;
+    }
+    const unsigned int headerSize = ((unsigned int)sizeBytes[0] << 24) | ((unsigned int)sizeBytes[1] << 16) | ((unsigned int)sizeBytes[2] << 8) | sizeBytes[3];
+    // the specification limits the header to 64 KiB and the blob to 32 MiB
+    if (myStream.gcount() != 4 || headerSize > (1 << 16)) {
+        throw ProcessError(TLF("Broken osm.pbf file '%'.", myFile));
+    }
+    std::string header(headerSize, '\0');
+    myStream.read(&header[0], headerSize);
+    if (myStream.gcount() != (std::streamsize)headerSize) {
+        throw ProcessError(TLF("Broken osm.pbf file '%'.", myFile));
+    }
+    unsigned long long int dataSize = 0;
+    Message m(header.data(), header.size());
+    int field;
+    int wireType;
+    while (m.nextField(field, wireType)) {
+        if (field == 1 && wireType == 2) {
+            type = m.string();
+        } else if (field == 3 && wireType == 0) {
+            dataSize = m.varint();
+        } else {
+            m.skip(wireType);
+        }
+    }
+    if (dataSize > (1 << 25)) {
+        throw ProcessError(TLF("Broken osm.pbf file '%'.", myFile));
+    }
+    blob.resize((size_t)dataSize);
+    myStream.read(&blob[0], (std::streamsize)dataSize);
+    if (myStream.gcount() != (std::streamsize)dataSize) {
+        throw ProcessError(TLF("Broken osm.pbf file '%'.", myFile));
+    }
+    return true;
+}
+
+
+std::shared_ptr<std::vector<OSMPBFInput::Event> >
+OSMPBFInput::decode(const std::string& type, const std::string& blob, const std::string& file) {
+    std::shared_ptr<std::vector<Event> > result = std::make_shared<std::vector<Event> >();
+    std::string data;
+    std::string zlibData;
+    unsigned long long int rawSize = 0;
+    Message m(blob.data(), blob.size());
+    int field;
+    int wireType;
+    while (m.nextField(field, wireType)) {
+        if (field == 1 && wireType == 2) {
+            data = m.string();
+        } else if (field == 2 && wireType == 0) {
+            rawSize = m.varint();
+        } else if (field == 3 && wireType == 2) {
+            zlibData = m.string();
+        } else if (wireType == 2 && field > 3) {
+            throw ProcessError(TLF("Unsupported compression in the osm.pbf file '%'.", file));
+        } else {
+            m.skip(wireType);
+        }
+    }
+    if (!zlibData.empty()) {
+#ifdef HAVE_ZLIB
+        data.resize((size_t)rawSize);
+        uLongf size = (uLongf)rawSize;
+        if (rawSize > (1 << 25) || uncompress((Bytef*)&data[0], &size, (const Bytef*)zlibData.data(), (uLong)zlibData.size()) != Z_OK || size != rawSize) {
+            throw ProcessError(TLF("Could not decompress a blob of the osm.pbf file '%'.", file));
+        }
+#else
+        throw ProcessError(TLF("Reading the compressed osm.pbf file '%' requires zlib support.", file));
+#endif
+    }
+    try {
+        if (type == "OSMHeader") {
+            checkHeader(Message(data.data(), data.size()), file);
+        } else if (type == "OSMData") {
+            decodeBlock(Message(data.data(), data.size()), *result);
+        }
+        // other blob types are to be ignored according to the specification
+    } catch (ProcessError& e) {
+        throw ProcessError(TLF("Broken osm.pbf file '%' (%).", file, e.what()));
+    }
+    return result;
+}
+
+
+void
+OSMPBFInput::checkHeader(Message header, const std::string& file) {
+    int field;
+    int wireType;
+    while (header.nextField(field, wireType)) {
+        if (field == 4 && wireType == 2) {
+            const std::string feature = header.string();
+            if (feature != "OsmSchema-V0.6" && feature != "DenseNodes") {
+                throw ProcessError(TLF("The osm.pbf file '%' requires the unsupported feature '%'.", file, feature));
+            }
+        } else {
+            header.skip(wireType);
+        }
+    }
+}
+
+
+void
+OSMPBFInput::decodeBlock(Message block, std::vector<Event>& into) {
+    std::vector<std::string> strings;
+    std::vector<Message> groups;
+    long long int granularity = 100;
+    long long int latOffset = 0;
+    long long int lonOffset = 0;
+    int field;
+    int wireType;
+    while (block.nextField(field, wireType)) {
+        if (field == 1 && wireType == 2) {
+            Message table = block.bytes();
+            while (table.nextField(field, wireType)) {
+                if (field == 1 && wireType == 2) {
+                    strings.push_back(table.string());
+                } else {
+                    table.skip(wireType);
+                }
+            }
+        } else if (field == 2 && wireType == 2) {
+            // the groups are decoded after the block since the offsets come last
+            groups.push_back(block.bytes());
+        } else if (field == 17 && wireType == 0) {
+            granularity = (long long int)block.varint();
+        } else if (field == 19 && wireType == 0) {
+            latOffset = (long long int)block.varint();
+        } else if (field == 20 && wireType == 0) {
+            lonOffset = (long long int)block.varint();
+        } else {
+            block.skip(wireType);
+        }
+    }
+    const std::string memberTypes[] = {"node", "way", "relation"};
+    std::vector<unsigned long long int> keys;
+    std::vector<unsigned long long int> vals;
+    std::vector<unsigned long long int> ids;
+    std::vector<unsigned long long int> lats;
+    std::vector<unsigned long long int> lons;
+    std::vector<unsigned long long int> roles;
+    std::vector<unsigned long long int> types;
+    for (Message& group : groups) {
+        while (group.nextField(field, wireType)) {
+            if (wireType != 2 || field < 1 || field > 4) {
+                group.skip(wireType);
+                continue;
+            }
+            Message element = group.bytes();
+            const int elementType = field;
+            long long int id = 0;
+            long long int lat = 0;
+            long long int lon = 0;
+            keys.clear();
+            vals.clear();
+            ids.clear();
+            lats.clear();
+            lons.clear();
+            roles.clear();
+            types.clear();
+            while (element.nextField(field, wireType)) {
+                if (field == 1 && elementType == 2) {
+                    element.packed(wireType, ids);
+                } else if (field == 1 && wireType == 0) {
+                    id = elementType == 1 ? element.svarint() : (long long int)element.varint();
+                } else if ((field == 2 || field == 3) && elementType != 2) {
+                    element.packed(wireType, field == 2 ? keys : vals);
+                } else if (field == 8 && elementType == 1 && wireType == 0) {
+                    lat = element.svarint();
+                } else if (field == 9 && elementType == 1 && wireType == 0) {
+                    lon = element.svarint();
+                } else if (field == 8 && elementType == 2) {
+                    element.packed(wireType, lats);
+                } else if (field == 9 && elementType == 2) {
+                    element.packed(wireType, lons);
+                } else if (field == 10 && elementType == 2) {
+                    // the keys and values of all nodes, the nodes are separated by 0
+                    element.packed(wireType, keys);
+                } else if (field == 8 && elementType >= 3) {
+                    // node references of a way or roles of a relation
+                    element.packed(wireType, elementType == 3 ? ids : roles);
+                } else if (field == 9 && elementType == 4) {
+                    element.packed(wireType, ids);
+                } else if (field == 10 && elementType == 4) {
+                    element.packed(wireType, types);
+                } else {
+                    element.skip(wireType);
+                }
+            }
+            if (elementType == 1) {
+                into.push_back({true, "node", {{"id", toString(id)}, {"lat", formatCoordinate(latOffset + granularity * lat)}, {"lon", formatCoordinate(lonOffset + granularity * lon)}}});
+                addTags(strings, keys, vals, into);
+                into.push_back({false, "node", {}});
+            } else if (elementType == 2) {
+                if (lats.size() != ids.size() || lons.size() != ids.size()) {
+                    throw ProcessError(TL("Inconsistent dense nodes."));
+                }
+                size_t kv = 0;
+                for (int i = 0; i < (int)ids.size(); i++) {
+                    id += zigzag(ids[i]);
+                    lat += zigzag(lats[i]);
+                    lon += zigzag(lons[i]);
+                    into.push_back({true, "node", {{"id", toString(id)}, {"lat", formatCoordinate(latOffset + granularity * lat)}, {"lon", formatCoordinate(lonOffset + granularity * lon)}}});
+                    while (kv + 1 < keys.size() && keys[kv] != 0) {
+                        if (keys[kv] >= strings.size() || keys[kv + 1] >= strings.size()) {
+                            throw ProcessError(TL("Invalid string index."));
+                        }
+                        into.push_back({true, "tag", {{"k", strings[(size_t)keys[kv]]}, {"v", strings[(size_t)keys[kv + 1]]}}});
+                        into.push_back({false, "tag", {}});
+                        kv += 2;
+                    }
+                    // skip the separator
+                    kv++;
+                    into.push_back({false, "node", {}});
+                }
+            } else if (elementType == 3) {
+                into.push_back({true, "way", {{"id", toString(id)}}});
+                long long int ref = 0;
+                for (const unsigned long long int delta : ids) {
+                    ref += zigzag(delta);
+                    into.push_back({true, "nd", {{"ref", toString(ref)}}});
+                    into.push_back({false, "nd", {}});
+                }
+                addTags(strings, keys, vals, into);
+                into.push_back({false, "way", {}});
+            } else {
+                if (roles.size() != ids.size() || types.size() != ids.size()) {
+                    throw ProcessError(TL("Inconsistent relation members."));
+                }
+                into.push_back({true, "relation", {{"id", toString(id)}}});
+                long long int ref = 0;
+                for (int i = 0; i < (int)ids.size(); i++) {
+                    ref += zigzag(ids[i]);
+                    if (types[i] > 2 || roles[i] >= strings.size()) {
+                        throw ProcessError(TL("Invalid relation member."));
+                    }
+                    into.push_back({true, "member", {{"type", memberTypes[types[i]]}, {"ref", toString(ref)}, {"role", strings[(size_t)roles[i]]}}});
+                    into.push_back({false, "member", {}});
+                }
+                addTags(strings, keys, vals, into);
+                into.push_back({false, "relation", {}});
+            }
+        }
+    }
+}
+
+
+void
+OSMPBFInput::addTags(const std::vector<std::string>& strings, const std::vector<unsigned long long int>& keys,
+                     const std::vector<unsigned long long int>& vals, std::vector<Event>& into) {
+    if (keys.size() != vals.size()) {
+        throw ProcessError(TL("Inconsistent tags."));
+    }
+    for (int i = 0; i < (int)keys.size(); i++) {
+        if (keys[i] >= strings.size() || vals[i] >= strings.size()) {
+            throw ProcessError(TL("Invalid string index."));
+        }
+        into.push_back({true, "tag", {{"k", strings[(size_t)keys[i]]}, {"v", strings[(size_t)vals[i]]}}});
+        into.push_back({false, "tag", {}});
+    }
+}
+
+
+std::string
+OSMPBFInput::formatCoordinate(const long long int nanoDegrees) {
+    // exact decimal representation, equal to the (at most 9 digit) values of osm xml files
+    const unsigned long long int absolute = nanoDegrees < 0 ? (unsigned long long int)(-nanoDegrees) : (unsigned long long int)nanoDegrees;
+    std::string result = (nanoDegrees < 0 ? "-" : "") + toString(absolute / 1000000000ULL);
+    unsigned long long int fraction = absolute % 1000000000ULL;
+    if (fraction > 0) {
+        int digits = 9;
+        while (fraction % 10 == 0) {
+            fraction /= 10;
+            digits--;
+        }
+        const std::string frac = toString(fraction);
+        result += "." + std::string(digits - frac.size(), '0') + frac;
+    }
+    return result;
+}
+
+
+/****************************************************************************/
@@ -0,0 +1,174 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    OSMPBFInput.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Decodes OpenStreetMap protocol buffer files (.osm.pbf) into xml events
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <deque>
+#include <fstream>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+template<typename CONTEXT> class WorkStealingThreadPool;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class OSMPBFInput
+ * @brief Streams the contents of an .osm.pbf file as the equivalent OSM XML elements
+ *
+ * The file is a sequence of independently compressed blobs. The blobs are
+ *  read sequentially but decompressed and decoded in parallel (see setNumThreads),
+ *  the resulting elements are delivered in file order. Only the data needed
+ *  for importing is generated: the ids, coordinates, tags, node references
+ *  of ways and members of relations (no meta data like versions or users).
+ */
+class OSMPBFInput {
+public:
+    /// @brief an element start (with its attributes) or an element end
+    struct Event {
+        bool open;
+        std::string name;
+        std::map<std::string, std::string> attrs;
+    };
+
+    /// @brief opens the file
+    OSMPBFInput(const std::string& systemID);
+
+    /// @brief Destructor (waits for the pending blobs)
+    ~OSMPBFInput();
+
+    /// @brief returns the next element event or nullptr at the end of the file
+    const Event* next();
+
+    /// @brief checks whether the file starts with an OSM header blob
+    static bool isPBFFile(const std::string& systemID);
+
+    /// @brief sets the number of threads for decoding (1 means decoding in the reading thread)
+    static void setNumThreads(const int numThreads) {
+        myNumThreads = numThreads;
+    }
+
+private:
+    /// @brief minimal protocol buffer decoding of a message
+    class Message {
+    public:
+        Message(const char* data, const size_t size) :
+            myPos(data), myEnd(data + size) {}
+
+        /// @brief reads the next field key, returns false at the end of the message
+        bool nextField(int& field, int& wireType);
+
+        unsigned long long int varint();
+
+        long long int svarint() {
+            return zigzag(varint());
+        }
+
+        /// @brief reads a packed (or a single unpacked) repeated varint field
+        void packed(const int wireType, std::vector<unsigned long long int>& into);
+
+        /// @brief reads a length delimited field
+        Message bytes();
+
+        std::string string() {
+            const Message m = bytes();
+            return std::string(m.myPos, m.myEnd);
+        }
+
+        void skip(const int wireType);
+
+        bool atEnd() const {
+            return myPos >= myEnd;
+        }
+
+    private:
+        const char* myPos;
+        const char* myEnd;
+    };
+
+    /// @brief decodes a signed (zigzag encoded) value
+    static long long int zigzag(const unsigned long long int v) {
+        return (long long int)(v >> 1) ^ -(long long int)(v & 1);
+    }
+
+    /// @brief reads the next blob of the file, returns false at the end of the file
+    bool readBlob(std::string& type, std::string& blob);
+
+    /// @brief fills the queue of decoded blobs
+    void fetch();
+
+    /// @brief decompresses the blob and decodes the contained primitive block
+    static std::shared_ptr<std::vector<Event> > decode(const std::string& type, const std::string& blob, const std::string& file);
+
+    /// @brief checks the required features of the file header
+    static void checkHeader(Message header, const std::string& file);
+
+    /// @brief decodes a primitive block into element events
+    static void decodeBlock(Message block, std::vector<Event>& into);
+
+    /// @brief formats a coordinate given in nano degrees
+    static std::string formatCoordinate(const long long int nanoDegrees);
+
+    /// @brief adds the events for the tags given by the string table indices
+    static void addTags(const std::vector<std::string>& strings, const std::vector<unsigned long long int>& keys,
+                        const std::vector<unsigned long long int>& vals, std::vector<Event>& into);
+
+    /// @brief the file name (for error messages)
+    const std::string myFile;
+
+    /// @brief the file to read from
+    std::ifstream myStream;
+
+    /// @brief whether the end of the file was reached
+    bool myEOF;
+
+    /// @brief the blobs which are decoded (or being decoded) in file order
+    std::deque<std::future<std::shared_ptr<std::vector<Event> > > > myPending;
+
+    /// @brief the events of the current blob and the position within them
+    std::shared_ptr<std::vector<Event> > myCurrent;
+    size_t myCurrentIndex;
+
+    /// @brief the events before and after the blobs
+    Event myRootOpen, myRootClose;
+    int myRootState;
+
+    /// @brief the threads decoding the blobs
+    std::unique_ptr<WorkStealingThreadPool<int> > myThreadPool;
+
+    /// @brief the number of threads used for new inputs
+    static int myNumThreads;
+
+private:
+    /// @brief Invalidated copy constructor.
+    OSMPBFInput(const OSMPBFInput&) = delete;
+
+    /// @brief Invalidated assignment operator.
+    OSMPBFInput& operator=(const OSMPBFInput&) = delete;
+};
@@ -64,7 +64,7 @@ std::string
 SUMOSAXAttributesImpl_Xerces::getString(int id, bool* isPresent) const {
     const XMLCh* const xString = getAttributeValueSecure(id);
     if (xString != nullptr) {
-        return StringUtils::transcode(getAttributeValueSecure(id));
+        return StringUtils::transcode(xString);
     }
     *isPresent = false;
     return "";
@@ -0,0 +1,64 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    SUMOSAXCache.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Keeps the parsed elements of a file in memory for repeated loading
+/****************************************************************************/
+#include <config.h>
+
+#include "SUMOSAXAttributes.h"
+#include "SUMOSAXCache.h"
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+SUMOSAXCache::SUMOSAXCache(const std::string& file) :
+    SUMOSAXHandler(file) {
+}
+
+
+SUMOSAXCache::~SUMOSAXCache() {}
+
+
+void
+SUMOSAXCache::replay(GenericSAXHandler& handler) const {
+    const std::string prevFile = handler.getFileName();
+    handler.setFileName(getFileName());
+    for (const Element& e : myElements) {
+        if (e.attrs != nullptr) {
+            handler.myStartElement(e.element, *e.attrs);
+        } else {
+            handler.myEndElement(e.element);
+        }
+    }
+    handler.setFileName(prevFile);
+}
+
+
+void
+SUMOSAXCache::myStartElement(int element, const SUMOSAXAttributes& attrs) {
+    myElements.push_back(Element({element, std::unique_ptr<SUMOSAXAttributes>(attrs.clone())}));
+}
+
+
+void
+SUMOSAXCache::myEndElement(int element) {
+    myElements.push_back(Element({element, nullptr}));
+}
+
+
+/****************************************************************************/
@@ -0,0 +1,77 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    SUMOSAXCache.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Keeps the parsed elements of a file in memory for repeated loading
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "SUMOSAXHandler.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class SUMOSAXCache
+ * @brief Records all elements and attributes of a file to pass them to other handlers later
+ *
+ * Used when the same file (usually the network) is loaded several times within
+ *  one process, so the XML parsing (and decompression) happens only once.
+ *  Character data is not recorded.
+ */
+class SUMOSAXCache : public SUMOSAXHandler {
+public:
+    /// @brief Constructor
+    SUMOSAXCache(const std::string& file);
+
+    /// @brief Destructor
+    ~SUMOSAXCache();
+
+    /** @brief Passes all recorded elements to the given handler (as if it parsed the file)
+     * @param[in] handler The handler to inform
+     * @exception ProcessError If the handler fails
+     */
+    void replay(GenericSAXHandler& handler) const;
+
+protected:
+    /// @brief records an opening tag
+    void myStartElement(int element, const SUMOSAXAttributes& attrs);
+
+    /// @brief records a closing tag
+    void myEndElement(int element);
+
+private:
+    /// @brief a recorded tag (the attributes are nullptr for closing tags)
+    struct Element {
+        int element;
+        std::unique_ptr<SUMOSAXAttributes> attrs;
+    };
+
+    /// @brief the recorded tags in file order
+    std::vector<Element> myElements;
+
+private:
+    /// @brief Invalidated copy constructor
+    SUMOSAXCache(const SUMOSAXCache& s) = delete;
+
+    /// @brief Invalidated assignment operator
+    SUMOSAXCache& operator=(const SUMOSAXCache& s) = delete;
+};
@@ -0,0 +1,357 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    SUMOSAXChunkReader.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Parses a large xml file in chunks on several threads
+/****************************************************************************/
+#include <config.h>
+
+#include <fstream>
+#include <xercesc/sax/SAXException.hpp>
+#include <xercesc/sax2/Attributes.hpp>
+#include <xercesc/sax/SAXParseException.hpp>
+#include <utils/common/FileHelpers.h>
+#include <utils/common/MsgHandler.h>
+#include <utils/common/StdDefs.h>
+#include <utils/common/StringUtils.h>
+#include <utils/common/ToString.h>
+#include <utils/common/UtilExceptions.h>
+#include "SUMOSAXAttributes.h"
+#include "SUMOSAXAttributesImpl_Cached.h"
+#include "SUMOSAXHandler.h"
+#include "SUMOSAXReader.h"
+#include "SUMOSAXChunkReader.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const int SUMOSAXChunkReader::CHUNK_BYTES = 8 * 1024 * 1024;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/// @brief records the parsed elements and warnings of a chunk
+class SUMOSAXChunkReader::Recorder : public SUMOSAXHandler {
+public:
+    Recorder(const std::string& file) : SUMOSAXHandler(file) {}
+
+    /// @brief records includes, they are parsed by the consuming thread
+    void startElement(const XMLCh* const uri, const XMLCh* const localname, const XMLCh* const qname,
+                      const XERCES_CPP_NAMESPACE::Attributes& attrs) {
+        const std::string name = StringUtils::transcode(qname);
+        if (name == toString(SUMO_TAG_INCLUDE)) {
+            static const std::vector<std::string> attrNames = getIncludeAttrNames();
+            std::map<std::string, std::string> values;
+            for (int i = 0; i < (int)attrs.getLength(); i++) {
+                values[StringUtils::transcode(attrs.getLocalName(i))] = StringUtils::transcode(attrs.getValue(i));
+            }
+            myChunk.elements.push_back(Element({SUMO_TAG_INCLUDE, std::unique_ptr<SUMOSAXAttributes>(new SUMOSAXAttributesImpl_Cached(values, attrNames, name))}));
+        } else {
+            SUMOSAXHandler::startElement(uri, localname, qname, attrs);
+        }
+    }
+
+    /// @brief collects the warning instead of reporting it from the parsing thread
+    void warning(const XERCES_CPP_NAMESPACE::SAXParseException& exception) {
+        myChunk.warnings.push_back(buildErrorMessage(exception));
+    }
+
+    /// @brief the chunk currently recorded
+    Chunk myChunk;
+
+protected:
+    /// @brief the attribute names needed for retrieving the href of an include
+    static std::vector<std::string> getIncludeAttrNames() {
+        std::vector<std::string> result(SUMO_ATTR_HREF + 1);
+        result[SUMO_ATTR_HREF] = toString(SUMO_ATTR_HREF);
+        return result;
+    }
+
+    void myStartElement(int element, const SUMOSAXAttributes& attrs) {
+        myChunk.elements.push_back(Element({element, std::unique_ptr<SUMOSAXAttributes>(attrs.clone())}));
+    }
+
+    void myEndElement(int element) {
+        myChunk.elements.push_back(Element({element, nullptr}));
+    }
+};
+
+
+// ===========================================================================
+// helper
+// ===========================================================================
+/** @brief returns the position after the markup (tag, comment, ...) starting at pos
+ * @return npos if the markup does not end within the content
+ */
+static std::string::size_type
+markupEnd(const std::string& content, const std::string::size_type pos) {
+    if (content.compare(pos, 4, "<!--") == 0) {
+        const std::string::size_type end = content.find("-->", pos + 4);
+        return end == std::string::npos ? end : end + 3;
+    }
+    if (content.compare(pos, 9, "<![CDATA[") == 0) {
+        const std::string::size_type end = content.find("]]>", pos + 9);
+        return end == std::string::npos ? end : end + 3;
+    }
+    if (content.compare(pos, 2, "<?") == 0) {
+        const std::string::size_type end = content.find("?>", pos + 2);
+        return end == std::string::npos ? end : end + 2;
+    }
+    // tags and declarations, the closing bracket may be part of a quoted attribute value
+    std::string::size_type i = pos + 1;
+    while (true) {
+        i = content.find_first_of("\"'>", i);
+        if (i == std::string::npos || content[i] == '>') {
+            return i == std::string::npos ? i : i + 1;
+        }
+        i = content.find(content[i], i + 1);
+        if (i == std::string::npos) {
+            return i;
+        }
+        i++;
+    }
+}
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+SUMOSAXChunkReader::SUMOSAXChunkReader(const std::string& file, const std::string& validationScheme, const int threads) :
+    myFile(file),
+    myValidationScheme(validationScheme),
+    myMaxAhead(2 * MAX2(threads, 1)),
+    myNumJobs(0),
+    myNumChunks(-1),
+    myStop(false),
+    myNextChunk(0),
+    myCurrentIndex(0) {
+    mySplitter = std::thread(&SUMOSAXChunkReader::splitLoop, this);
+    for (int i = 0; i < MAX2(threads, 1); i++) {
+        myParsers.push_back(std::thread(&SUMOSAXChunkReader::parseLoop, this));
+    }
+}
+
+
+SUMOSAXChunkReader::~SUMOSAXChunkReader() {
+    {
+        std::lock_guard<std::mutex> lock(myLock);
+        myStop = true;
+    }
+    myCondition.notify_all();
+    mySplitter.join();
+    for (std::thread& t : myParsers) {
+        t.join();
+    }
+}
+
+
+bool
+SUMOSAXChunkReader::canSplit(const std::string& file) {
+    if (!FileHelpers::isReadable(file) || FileHelpers::isDirectory(file)) {
+        return false;
+    }
+    std::ifstream in(file, std::ios::binary | std::ios::ate);
+    if (!in.good() || (long long)in.tellg() < 4 * (long long)CHUNK_BYTES) {
+        return false;
+    }
+    // only plain xml (no compressed, binary or pbf input)
+    in.seekg(0);
+    std::string start(64, ' ');
+    in.read(&start[0], start.size());
+    std::string::size_type pos = start.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0;
+    pos = start.find_first_not_of(" \t\r\n", pos);
+    return pos != std::string::npos && start[pos] == '<';
+}
+
+
+bool
+SUMOSAXChunkReader::next(int& element, const SUMOSAXAttributes*& attrs) {
+    while (myCurrentIndex >= (int)myCurrent.elements.size()) {
+        if (!myCurrent.error.empty()) {
+            throw ProcessError(myCurrent.error);
+        }
+        std::unique_lock<std::mutex> lock(myLock);
+        myCondition.wait(lock, [this]() {
+            return myResults.count(myNextChunk) > 0 || (myNumChunks >= 0 && myNextChunk >= myNumChunks);
+        });
+        if (myResults.count(myNextChunk) == 0) {
+            if (!mySplitError.empty()) {
+                throw ProcessError(mySplitError);
+            }
+            return false;
+        }
+        myCurrent = std::move(myResults[myNextChunk]);
+        myResults.erase(myNextChunk);
+        myNextChunk++;
+        myCurrentIndex = 0;
+        lock.unlock();
+        myCondition.notify_all();
+        for (const std::string& warning : myCurrent.warnings) {
+            WRITE_WARNING(warning);
+        }
+    }
+    const Element& e = myCurrent.elements[myCurrentIndex++];
+    element = e.element;
+    attrs = e.attrs.get();
+    return true;
+}
+
+
+bool
+SUMOSAXChunkReader::addJob(const std::string& body, const long long offset, const bool last) {
+    std::unique_lock<std::mutex> lock(myLock);
+    myCondition.wait(lock, [this]() {
+        return myStop || myNumJobs - myNextChunk < myMaxAhead;
+    });
+    if (myStop) {
+        return false;
+    }
+    myJobs.push_back(Job({myNumJobs++, offset, myPrologue + body + myEpilogue, last}));
+    lock.unlock();
+    myCondition.notify_all();
+    return true;
+}
+
+
+void
+SUMOSAXChunkReader::splitLoop() {
+    std::string error;
+    try {
+        std::ifstream in(myFile, std::ios::binary);
+        if (!in.good()) {
+            throw ProcessError(TLF("Cannot read file '%'!", myFile));
+        }
+        std::vector<char> block(1 << 22);
+        // the part of the file which was not handed over yet, starting at offset
+        std::string content;
+        long long offset = 0;
+        std::string::size_type pos = 0;
+        int depth = 0;
+        bool eof = false;
+        while (true) {
+            const std::string::size_type start = content.find('<', pos);
+            // markups are evaluated only if they are complete (and long enough to identify comments)
+            const std::string::size_type end = start == std::string::npos || (!eof && content.size() - start < 9) ? std::string::npos : markupEnd(content, start);
+            if (end == std::string::npos) {
+                if (eof) {
+                    throw ProcessError(TLF("Unexpected end of file '%'.", myFile));
+                }
+                pos = start == std::string::npos ? content.size() : start;
+                in.read(block.data(), block.size());
+                content.append(block.data(), (size_t)in.gcount());
+                eof = in.gcount() < (std::streamsize)block.size();
+                continue;
+            }
+            pos = end;
+            const char kind = content[start + 1];
+            if (kind == '?' || kind == '!') {
+                continue;
+            }
+            if (kind == '/') {
+                if (depth == 0) {
+                    throw ProcessError(TLF("Unbalanced closing tag in file '%'.", myFile));
+                }
+                if (--depth == 0) {
+                    addJob(content.substr(0, start), offset, true);
+                    break;
+                }
+                continue;
+            }
+            const bool selfClosing = content[end - 2] == '/';
+            if (depth == 0) {
+                // the root element
+                const std::string::size_type nameEnd = content.find_first_of(" \t\r\n/>", start + 1);
+                myPrologue = content.substr(0, end);
+                if (selfClosing) {
+                    addJob("", offset, true);
+                    break;
+                }
+                myEpilogue = "</" + content.substr(start + 1, nameEnd - start - 1) + ">";
+                content.erase(0, end);
+                offset += end;
+                pos = 0;
+            } else if (depth == 1 && start >= (std::string::size_type)CHUNK_BYTES) {
+                if (!addJob(content.substr(0, start), offset, false)) {
+                    break;
+                }
+                content.erase(0, start);
+                offset += start;
+                pos = end - start;
+            }
+            if (!selfClosing) {
+                depth++;
+            }
+        }
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+    std::lock_guard<std::mutex> lock(myLock);
+    mySplitError = error;
+    myNumChunks = myNumJobs;
+    myCondition.notify_all();
+}
+
+
+void
+SUMOSAXChunkReader::parseLoop() {
+    Recorder recorder(myFile);
+    SUMOSAXReader reader(recorder, myValidationScheme, nullptr);
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(myLock);
+            myCondition.wait(lock, [this]() {
+                return myStop || !myJobs.empty();
+            });
+            if (myStop) {
+                return;
+            }
+            job = std::move(myJobs.front());
+            myJobs.pop_front();
+        }
+        try {
+            reader.parseString(job.content);
+        } catch (const std::exception& e) {
+            recorder.myChunk.error = e.what();
+        } catch (const XERCES_CPP_NAMESPACE::SAXException& e) {
+            recorder.myChunk.error = TLF("SAX error occurred while parsing '%':\n %", myFile, StringUtils::transcode(e.getMessage()));
+        } catch (...) {
+            recorder.myChunk.error = TLF("Unspecified error occurred while parsing '%'", myFile);
+        }
+        Chunk chunk = std::move(recorder.myChunk);
+        recorder.myChunk = Chunk();
+        if (!chunk.error.empty()) {
+            chunk.error += TLF(" (in the part starting at byte %)", job.offset);
+        } else if (!job.last && !chunk.elements.empty()) {
+            // the closing root tag which was added to the chunk
+            chunk.elements.pop_back();
+        }
+        if (job.index > 0 && !chunk.elements.empty()) {
+            // the opening root tag which was added to the chunk
+            chunk.elements.erase(chunk.elements.begin());
+        }
+        {
+            std::lock_guard<std::mutex> lock(myLock);
+            myResults[job.index] = std::move(chunk);
+        }
+        myCondition.notify_all();
+    }
+}
+
+
+/****************************************************************************/
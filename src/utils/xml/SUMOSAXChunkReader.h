@@ -0,0 +1,170 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    SUMOSAXChunkReader.h
+/// @author  agent
+/// @date    2023-10-14
+///
+// Parses a large xml file in chunks on several threads
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class SUMOSAXAttributes;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class SUMOSAXChunkReader
+ * @brief Splits a plain xml file between its top level elements and parses the parts in parallel
+ *
+ * A splitting thread scans the file for the boundaries of the elements below
+ *  the root element (vehicles, trips, edges, intervals, ...) and cuts it into
+ *  chunks of about CHUNK_BYTES. Each chunk gets the prolog and the root element
+ *  of the file, so it is a complete document which is parsed by one of the
+ *  parsing threads into recorded elements with cloned attributes. The
+ *  recorded elements are handed out in file order by next, so the
+ *  handler which builds the objects runs on the calling thread only.
+ *
+ * At most two chunks per thread are kept in memory. Character data is not
+ *  recorded and line numbers in error messages refer to the chunk.
+ */
+class SUMOSAXChunkReader {
+public:
+    /** @brief Constructor, starts the threads
+     * @param[in] file The file to parse
+     * @param[in] validationScheme The validation scheme for the chunks
+     * @param[in] threads The number of parsing threads
+     */
+    SUMOSAXChunkReader(const std::string& file, const std::string& validationScheme, const int threads);
+
+    /// @brief Destructor, stops the threads
+    ~SUMOSAXChunkReader();
+
+    /// @brief whether the file is an uncompressed xml file which is large enough to be split
+    static bool canSplit(const std::string& file);
+
+    /** @brief returns the next recorded element in file order
+     * @param[out] element The id of the element
+     * @param[out] attrs The attributes of an opening tag, nullptr for a closing tag (valid until the next call)
+     * @return false if the file is finished
+     * @exception ProcessError If a chunk could not be split or parsed
+     */
+    bool next(int& element, const SUMOSAXAttributes*& attrs);
+
+    /// @brief the approximate size of a chunk in bytes
+    static const int CHUNK_BYTES;
+
+private:
+    /// @brief a recorded tag (the attributes are nullptr for closing tags)
+    struct Element {
+        int element;
+        std::unique_ptr<SUMOSAXAttributes> attrs;
+    };
+
+    /// @brief the recorded elements of a chunk
+    struct Chunk {
+        std::vector<Element> elements;
+        /// @brief the warnings of the parser
+        std::vector<std::string> warnings;
+        /// @brief the message of an error which ended the parsing of the chunk
+        std::string error;
+    };
+
+    /// @brief a part of the file waiting to be parsed
+    struct Job {
+        int index;
+        long long offset;
+        std::string content;
+        bool last;
+    };
+
+    class Recorder;
+
+    /// @brief the main loop of the splitting thread
+    void splitLoop();
+
+    /// @brief the main loop of a parsing thread
+    void parseLoop();
+
+    /** @brief hands the given part of the file (without prolog) over to the parsing threads
+     * @return false if the threads shall stop
+     */
+    bool addJob(const std::string& body, const long long offset, const bool last);
+
+    /// @brief the parsed file
+    const std::string myFile;
+
+    /// @brief the validation scheme of the chunk parsers
+    const std::string myValidationScheme;
+
+    /// @brief the maximum number of chunks which are split but not consumed
+    const int myMaxAhead;
+
+    /// @brief the file contents up to and including the opening root tag and the closing root tag
+    std::string myPrologue;
+    std::string myEpilogue;
+
+    /// @brief the threads
+    std::thread mySplitter;
+    std::vector<std::thread> myParsers;
+
+    /// @brief the lock for all members below and the condition signalling their changes
+    std::mutex myLock;
+    std::condition_variable myCondition;
+
+    /// @brief the chunks waiting to be parsed
+    std::deque<Job> myJobs;
+
+    /// @brief the parsed chunks by index which were not consumed yet
+    std::map<int, Chunk> myResults;
+
+    /// @brief the number of chunks created so far and the total number (-1 while splitting)
+    int myNumJobs;
+    int myNumChunks;
+
+    /// @brief the error which stopped the splitting
+    std::string mySplitError;
+
+    /// @brief whether the threads shall stop
+    bool myStop;
+
+    /// @brief the index of the next chunk to consume
+    int myNextChunk;
+
+    /// @brief the chunk currently consumed and the position therein
+    Chunk myCurrent;
+    int myCurrentIndex;
+
+private:
+    /// @brief Invalidated copy constructor
+    SUMOSAXChunkReader(const SUMOSAXChunkReader& s) = delete;
+
+    /// @brief Invalidated assignment operator
+    SUMOSAXChunkReader& operator=(const SUMOSAXChunkReader& s) = delete;
+};
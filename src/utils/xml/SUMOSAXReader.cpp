@@ -24,6 +24,8 @@
 #include <string>
 #include <memory>
 #include <iostream>
+#include <fstream>
+#include <cstring>
 #include <xercesc/sax2/XMLReaderFactory.hpp>
 #include <xercesc/framework/LocalFileInputSource.hpp>
 #include <xercesc/framework/MemBufInputSource.hpp>
@@ -32,11 +34,15 @@
 #include <utils/common/MsgHandler.h>
 #include <utils/common/ToString.h>
 #include <utils/common/StringUtils.h>
+#include <utils/iodevices/BinaryFormatter.h>
 #include "GenericSAXHandler.h"
-#ifdef HAVE_ZLIB
-#include <foreign/zstr/zstr.hpp>
-#endif
+#include "SUMOSAXChunkReader.h"
+#include "SUMOSAXHandler.h"
+#include "XMLSubSys.h"
+#include "SUMOSAXAttributesImpl_Cached.h"
+#include <utils/iodevices/CompressedStreams.h>
 #include "IStreamInputSource.h"
+#include "OSMPBFInput.h"
 #include "SUMOSAXReader.h"
 
 using XERCES_CPP_NAMESPACE::SAX2XMLReader;
@@ -112,10 +118,33 @@ SUMOSAXReader::parse(std::string systemID) {
     if (FileHelpers::isDirectory(systemID)) {
         throw IOError(TLF("File '%' is a directory!", systemID));
     }
+    if (isBinaryFile(systemID)) {
+        myBinaryInput = std::unique_ptr<BinaryInput>(new BinaryInput(systemID));
+        while (parseBinaryNext());
+        myBinaryInput.reset();
+        return;
+    }
+    if (OSMPBFInput::isPBFFile(systemID)) {
+        myPBFInput = std::unique_ptr<OSMPBFInput>(new OSMPBFInput(systemID));
+        while (parsePBFNext());
+        myPBFInput.reset();
+        return;
+    }
+    if (useChunkReader(systemID)) {
+        myChunkReader = std::unique_ptr<SUMOSAXChunkReader>(new SUMOSAXChunkReader(systemID, myValidationScheme, XMLSubSys::getParseThreads()));
+        try {
+            while (parseChunkNext());
+        } catch (...) {
+            myChunkReader.reset();
+            throw;
+        }
+        myChunkReader.reset();
+        return;
+    }
     ensureSAXReader();
-#ifdef HAVE_ZLIB
-    zstr::ifstream istream(StringUtils::transcodeToLocal(systemID).c_str(), std::fstream::in | std::fstream::binary);
-    myXMLReader->parse(IStreamInputSource(istream));  // NOSONAR
+#if defined(HAVE_ZLIB) || defined(HAVE_ZSTD)
+    std::unique_ptr<std::istream> istream = CompressedStreams::openInput(systemID);
+    myXMLReader->parse(IStreamInputSource(*istream));  // NOSONAR
 #else
     myXMLReader->parse(StringUtils::transcodeToLocal(systemID).c_str());  // NOSONAR
 #endif
@@ -123,7 +152,7 @@ SUMOSAXReader::parse(std::string systemID) {
 
 
 void
-SUMOSAXReader::parseString(std::string content) {
+SUMOSAXReader::parseString(const std::string& content) {
     ensureSAXReader();
     XERCES_CPP_NAMESPACE::MemBufInputSource memBufIS((const XMLByte*)content.c_str(), content.size(), "registrySettings");
     myXMLReader->parse(memBufIS);  // NOSONAR
@@ -138,10 +167,25 @@ SUMOSAXReader::parseFirst(std::string systemID) {
     if (FileHelpers::isDirectory(systemID)) {
         throw IOError(TLF("File '%' is a directory!", systemID));
     }
+    if (isBinaryFile(systemID)) {
+        myBinaryInput = std::unique_ptr<BinaryInput>(new BinaryInput(systemID));
+        return true;
+    }
+    myBinaryInput.reset();
+    if (OSMPBFInput::isPBFFile(systemID)) {
+        myPBFInput = std::unique_ptr<OSMPBFInput>(new OSMPBFInput(systemID));
+        return true;
+    }
+    myPBFInput.reset();
+    myChunkReader.reset();
+    if (useChunkReader(systemID)) {
+        myChunkReader = std::unique_ptr<SUMOSAXChunkReader>(new SUMOSAXChunkReader(systemID, myValidationScheme, XMLSubSys::getParseThreads()));
+        return true;
+    }
     ensureSAXReader();
     myToken = XERCES_CPP_NAMESPACE::XMLPScanToken();
-#ifdef HAVE_ZLIB
-    myIStream = std::unique_ptr<zstr::ifstream>(new zstr::ifstream(StringUtils::transcodeToLocal(systemID).c_str(), std::fstream::in | std::fstream::binary));
+#if defined(HAVE_ZLIB) || defined(HAVE_ZSTD)
+    myIStream = CompressedStreams::openInput(systemID);
     myInputStream = std::unique_ptr<IStreamInputSource>(new IStreamInputSource(*myIStream));
     return myXMLReader->parseFirst(*myInputStream, myToken);  // NOSONAR
 #else
@@ -152,6 +196,15 @@ SUMOSAXReader::parseFirst(std::string systemID) {
 
 bool
 SUMOSAXReader::parseNext() {
+    if (myBinaryInput != nullptr) {
+        return parseBinaryNext();
+    }
+    if (myPBFInput != nullptr) {
+        return parsePBFNext();
+    }
+    if (myChunkReader != nullptr) {
+        return parseChunkNext();
+    }
     if (myXMLReader == nullptr) {
         throw ProcessError(TL("The XML-parser was not initialized."));
     }
@@ -161,7 +214,7 @@ SUMOSAXReader::parseNext() {
 
 bool
 SUMOSAXReader::parseSection(int element) {
-    if (myXMLReader == nullptr) {
+    if (myXMLReader == nullptr && myBinaryInput == nullptr && myPBFInput == nullptr && myChunkReader == nullptr) {
         throw ProcessError(TL("The XML-parser was not initialized."));
     }
     bool started = false;
@@ -174,7 +227,7 @@ SUMOSAXReader::parseSection(int element) {
     }
     myHandler->setSection(element, started);
     while (!myHandler->sectionFinished()) {
-        if (!myXMLReader->parseNext(myToken)) {
+        if (!parseNext()) {
             return false;
         }
     }
@@ -197,6 +250,192 @@ SUMOSAXReader::ensureSAXReader() {
 }
 
 
+bool
+SUMOSAXReader::isBinaryFile(const std::string& systemID) {
+    const std::string magic = BinaryFormatter::getMagic();
+    std::string start(magic.size(), ' ');
+    std::unique_ptr<std::istream> istream = CompressedStreams::openInput(systemID);
+    istream->read(&start[0], start.size());
+    return istream->gcount() == (std::streamsize)magic.size() && start == magic;
+}
+
+
+SUMOSAXReader::BinaryInput::BinaryInput(const std::string& systemID) :
+    myPos(0),
+    myHavePending(false),
+    myError(TLF("Broken binary XML file '%'.", systemID)) {
+    std::unique_ptr<std::istream> istream = CompressedStreams::openInput(systemID);
+    char buffer[1 << 16];
+    while (istream->read(buffer, sizeof(buffer)) || istream->gcount() > 0) {
+        myContent.append(buffer, (size_t)istream->gcount());
+    }
+    myPos = std::strlen(BinaryFormatter::getMagic());
+}
+
+
+int
+SUMOSAXReader::BinaryInput::readInt() {
+    if (myPos + sizeof(int) > myContent.size()) {
+        throw ProcessError(myError);
+    }
+    int val;
+    memcpy(&val, myContent.data() + myPos, sizeof(int));
+    myPos += sizeof(int);
+    return val;
+}
+
+
+std::string
+SUMOSAXReader::BinaryInput::readString() {
+    const int size = readInt();
+    if (size < 0 || myPos + size > myContent.size()) {
+        throw ProcessError(myError);
+    }
+    const std::string val(myContent.data() + myPos, size);
+    myPos += size;
+    return val;
+}
+
+
+const std::string&
+SUMOSAXReader::BinaryInput::readName() {
+    const int index = readInt();
+    if (index == (int)myNames.size()) {
+        myNames.push_back(readString());
+    } else if (index < 0 || index > (int)myNames.size()) {
+        throw ProcessError(myError);
+    }
+    return myNames[index];
+}
+
+
+bool
+SUMOSAXReader::parseBinaryNext() {
+    BinaryInput& in = *myBinaryInput;
+    while (in.myPos < in.myContent.size()) {
+        const char event = in.myContent[in.myPos];
+        if (in.myHavePending && event != BinaryFormatter::EVENT_ATTR) {
+            // the handler may get changed during parsing (see XMLSubSys::setHandler)
+            in.myHavePending = false;
+            startCachedElement(in.myStack.back().first, in.myStack.back().second, in.myAttrs);
+            in.myAttrs.clear();
+            return true;
+        }
+        in.myPos++;
+        if (event == BinaryFormatter::EVENT_OPEN) {
+            const std::string& name = in.readName();
+            in.myStack.push_back(std::make_pair(myHandler->convertTag(name), name));
+            in.myHavePending = true;
+        } else if (event == BinaryFormatter::EVENT_ATTR && in.myHavePending) {
+            const std::string& name = in.readName();
+            in.myAttrs[name] = in.readString();
+        } else if (event == BinaryFormatter::EVENT_CLOSE && !in.myStack.empty()) {
+            const int element = in.myStack.back().first;
+            in.myStack.pop_back();
+            endCachedElement(element);
+            return true;
+        } else {
+            throw ProcessError(in.myError);
+        }
+    }
+    if (in.myHavePending || !in.myStack.empty()) {
+        throw ProcessError(in.myError);
+    }
+    return false;
+}
+
+
+bool
+SUMOSAXReader::parsePBFNext() {
+    const OSMPBFInput::Event* const event = myPBFInput->next();
+    if (event == nullptr) {
+        return false;
+    }
+    if (event->open) {
+        startCachedElement(myHandler->convertTag(event->name), event->name, event->attrs);
+    } else {
+        endCachedElement(myHandler->convertTag(event->name));
+    }
+    return true;
+}
+
+
+bool
+SUMOSAXReader::useChunkReader(const std::string& systemID) const {
+    return (XMLSubSys::getParseThreads() > 1
+            && dynamic_cast<SUMOSAXHandler*>(myHandler) != nullptr
+            && !myHandler->myCollectCharacterData
+            && SUMOSAXChunkReader::canSplit(systemID));
+}
+
+
+bool
+SUMOSAXReader::parseChunkNext() {
+    int element;
+    const SUMOSAXAttributes* attrs;
+    if (!myChunkReader->next(element, attrs)) {
+        myChunkReader.reset();
+        return false;
+    }
+    if (attrs != nullptr) {
+        startRecordedElement(element, *attrs);
+    } else {
+        endCachedElement(element);
+    }
+    return true;
+}
+
+
+void
+SUMOSAXReader::startCachedElement(const int element, const std::string& name, const std::map<std::string, std::string>& attrs) {
+    SUMOSAXAttributesImpl_Cached na(attrs, myHandler->myPredefinedTagsMML, name);
+    startRecordedElement(element, na);
+}
+
+
+void
+SUMOSAXReader::startRecordedElement(const int element, const SUMOSAXAttributes& attrs) {
+    // same section and include handling as in GenericSAXHandler::startElement
+    if (myHandler->mySectionSeen && !myHandler->mySectionOpen && element != myHandler->mySection) {
+        myHandler->mySectionEnded = true;
+        myHandler->myNextSectionStart.first = element;
+        myHandler->myNextSectionStart.second = attrs.clone();
+        return;
+    }
+    if (element == myHandler->mySection) {
+        myHandler->mySectionSeen = true;
+        myHandler->mySectionOpen = true;
+    }
+    if (element == SUMO_TAG_INCLUDE) {
+        std::string file = attrs.getString(SUMO_ATTR_HREF);
+        if (!FileHelpers::isAbsolute(file)) {
+            file = FileHelpers::getConfigurationRelative(myHandler->getFileName(), file);
+        }
+        XMLSubSys::runParser(*myHandler, file);
+    } else {
+        myHandler->myStartElement(element, attrs);
+    }
+}
+
+
+void
+SUMOSAXReader::endCachedElement(const int element) {
+    // same section and parent handling as in GenericSAXHandler::endElement
+    if (element == myHandler->mySection) {
+        myHandler->mySectionOpen = false;
+    }
+    if (element != SUMO_TAG_INCLUDE) {
+        GenericSAXHandler* const handler = myHandler;
+        handler->myEndElement(element);
+        if (handler->myParentHandler && handler->myParentIndicator == element) {
+            XMLSubSys::setHandler(*handler->myParentHandler);
+            handler->myParentIndicator = SUMO_TAG_NOTHING;
+            handler->myParentHandler = nullptr;
+        }
+    }
+}
+
+
 SUMOSAXReader::LocalSchemaResolver::LocalSchemaResolver(const bool haveFallback, const bool noOp) :
     myHaveFallback(haveFallback),
     myNoOp(noOp) {
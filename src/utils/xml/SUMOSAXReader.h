@@ -23,6 +23,7 @@
 #include <config.h>
 
 #include <string>
+#include <map>
 #include <memory>
 #include <vector>
 #include <xercesc/sax2/SAX2XMLReader.hpp>
@@ -37,7 +38,9 @@
 
 class GenericSAXHandler;
 class IStreamInputSource;
+class OSMPBFInput;
 class SUMOSAXAttributes;
+class SUMOSAXChunkReader;
 
 // ===========================================================================
 // class definitions
@@ -49,6 +52,11 @@ class SUMOSAXAttributes;
  * This class generates on demand either a SAX2XMLReader or parses the SUMO
  * binary xml. The interface is inspired by but not identical to
  * SAX2XMLReader.
+ *
+ * If XMLSubSys::setParseThreads was called with more than one thread, large
+ * plain xml files are parsed by a SUMOSAXChunkReader in parallel and the
+ * recorded elements are passed to the handler in file order (for handlers
+ * which do not need character data).
  */
 class SUMOSAXReader {
 
@@ -93,7 +101,7 @@ public:
      *
      * @param[in] content XML string
      */
-    void parseString(std::string content);
+    void parseString(const std::string& content);
 
     /**
      * @brief Start parsing the given file using parseFirst of myXMLReader
@@ -149,6 +157,70 @@ private:
      */
     void ensureSAXReader();
 
+    /**
+     * @brief Checks whether the file starts with the magic line of the binary xml format
+     *
+     * @param[in] systemID file name
+     */
+    static bool isBinaryFile(const std::string& systemID);
+
+    /// @brief The contents and decoding state of a file in the binary xml format (see BinaryFormatter)
+    class BinaryInput {
+    public:
+        /// @brief reads the whole file into memory
+        BinaryInput(const std::string& systemID);
+
+        int readInt();
+        std::string readString();
+        const std::string& readName();
+
+        /// @brief the file contents and the current read position
+        std::string myContent;
+        size_t myPos;
+
+        /// @brief the element and attribute names seen so far
+        std::vector<std::string> myNames;
+
+        /// @brief the currently open elements (id and name)
+        std::vector<std::pair<int, std::string> > myStack;
+
+        /// @brief the attributes of the element on top of the stack as long as it was not reported
+        std::map<std::string, std::string> myAttrs;
+        bool myHavePending;
+
+        /// @brief the error message for broken input
+        const std::string myError;
+    };
+
+    /**
+     * @brief Decodes the binary input until the next element start or end was reported to the handler
+     *
+     * @return whether an element was reported (false at the end of the file)
+     */
+    bool parseBinaryNext();
+
+    /**
+     * @brief Decodes the osm.pbf input until the next element start or end was reported to the handler
+     *
+     * @return whether an element was reported (false at the end of the file)
+     */
+    bool parsePBFNext();
+
+    /// @brief whether the file shall be parsed by a SUMOSAXChunkReader
+    bool useChunkReader(const std::string& systemID) const;
+
+    /// @brief passes the next element of the chunk reader to the handler
+    bool parseChunkNext();
+
+    /// @brief reports an element start of a non-xml input to the handler (respecting the sections)
+    void startCachedElement(const int element, const std::string& name, const std::map<std::string, std::string>& attrs);
+
+    /// @brief reports an element start of a recorded or non-xml input to the handler (respecting the sections and includes)
+    void startRecordedElement(const int element, const SUMOSAXAttributes& attrs);
+
+    /// @brief reports an element end of a recorded or non-xml input to the handler (respecting the sections and parent handlers)
+    void endCachedElement(const int element);
+
     /// @brief generic SAX Handler
     GenericSAXHandler* myHandler;
 
@@ -170,6 +242,15 @@ private:
     /// @brief input stream
     std::unique_ptr<IStreamInputSource> myInputStream;
 
+    /// @brief the input if a binary file is parsed
+    std::unique_ptr<BinaryInput> myBinaryInput;
+
+    /// @brief the input if an osm.pbf file is parsed
+    std::unique_ptr<OSMPBFInput> myPBFInput;
+
+    /// @brief the input if a large xml file is parsed in chunks
+    std::unique_ptr<SUMOSAXChunkReader> myChunkReader;
+
     /// @brief The stack of begun xml elements
     std::vector<SumoXMLTag> myXMLStack;
 
@@ -46,6 +46,7 @@ std::string XMLSubSys::myValidationScheme = "local";
 std::string XMLSubSys::myNetValidationScheme = "local";
 std::string XMLSubSys::myRouteValidationScheme = "local";
 XERCES_CPP_NAMESPACE::XMLGrammarPool* XMLSubSys::myGrammarPool = nullptr;
+int XMLSubSys::myParseThreads = 0;
 
 
 // ===========================================================================
@@ -156,6 +157,19 @@ XMLSubSys::setHandler(GenericSAXHandler& handler) {
 bool
 XMLSubSys::runParser(GenericSAXHandler& handler, const std::string& file,
                      const bool isNet, const bool isRoute, const bool isExternal, const bool catchExceptions) {
+    return runParser(handler, file, nullptr, isNet, isRoute, isExternal, catchExceptions);
+}
+
+
+bool
+XMLSubSys::runParserString(GenericSAXHandler& handler, const std::string& content, const std::string& name, const bool catchExceptions) {
+    return runParser(handler, name, &content, false, false, false, catchExceptions);
+}
+
+
+bool
+XMLSubSys::runParser(GenericSAXHandler& handler, const std::string& file, const std::string* const content,
+                     const bool isNet, const bool isRoute, const bool isExternal, const bool catchExceptions) {
     MsgHandler::getErrorInstance()->clear();
     std::string errorMsg = "";
     try {
@@ -176,7 +190,11 @@ XMLSubSys::runParser(GenericSAXHandler& handler, const std::string& file,
         myNextFreeReader++;
         std::string prevFile = handler.getFileName();
         handler.setFileName(file);
-        myReaders[myNextFreeReader - 1]->parse(file);
+        if (content != nullptr) {
+            myReaders[myNextFreeReader - 1]->parseString(*content);
+        } else {
+            myReaders[myNextFreeReader - 1]->parse(file);
+        }
         handler.setFileName(prevFile);
         myNextFreeReader--;
     } catch (const ProcessError& e) {
@@ -83,6 +83,25 @@ public:
     static void setValidation(const std::string& validationScheme, const std::string& netValidationScheme, const std::string& routeValidationScheme);
 
 
+    /**
+    * @brief Sets the number of threads for parsing large xml files in chunks
+    *
+    * The setting is used by all parsers which start parsing a file after the call.
+    *
+    * @param[in] threads The number of parsing threads (values below 2 disable the chunked parsing)
+    * @see SUMOSAXChunkReader
+    */
+    static void setParseThreads(const int threads) {
+        myParseThreads = threads;
+    }
+
+
+    /// @brief Returns the number of threads for parsing large xml files in chunks
+    static int getParseThreads() {
+        return myParseThreads;
+    }
+
+
     /**
      * @brief Closes the xml-subsystem
      *
@@ -143,8 +162,25 @@ public:
                           const bool isNet = false, const bool isRoute = false,
                           const bool isExternal = false, const bool catchExceptions = true);
 
+    /**
+     * @brief Runs the given handler on the given XML content; returns if everything's ok
+     *
+     * @param[in] handler The handler to assign to the built reader
+     * @param[in] content The XML content to parse
+     * @param[in] name    The name to use in messages instead of a file name
+     * @param[in] catchExceptions whether exceptions on parsing should be caught or transferred into a ProcessError
+     * @return true if the parsing was done without errors, false otherwise (error was printed)
+     * @see runParser
+     */
+    static bool runParserString(GenericSAXHandler& handler, const std::string& content, const std::string& name,
+                                const bool catchExceptions = true);
+
 
 private:
+    /// @brief parses the file or (if given) the content
+    static bool runParser(GenericSAXHandler& handler, const std::string& file, const std::string* const content,
+                          const bool isNet, const bool isRoute, const bool isExternal, const bool catchExceptions);
+
     /// @brief The XML Readers used for repeated parsing
     static std::vector<SUMOSAXReader*> myReaders;
 
@@ -163,4 +199,7 @@ private:
     /// @brief Schema cache to be used for grammars which are not declared
     static XERCES_CPP_NAMESPACE::XMLGrammarPool* myGrammarPool;
 
+    /// @brief The number of threads for parsing large xml files in chunks
+    static int myParseThreads;
+
 };
@@ -0,0 +1,129 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    CFModelBenchmark.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Benchmarks the car following speed computations
+/****************************************************************************/
+#include <config.h>
+
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <utils/vehicle/SUMOVTypeParameter.h>
+#include <microsim/MSGlobals.h>
+#include <microsim/MSVehicleType.h>
+#include <microsim/cfmodels/MSCFModel_Krauss.h>
+#include <microsim/cfmodels/MSCFModel_IDM.h>
+#include <microsim/cfmodels/MSCFModel_ACC.h>
+
+
+// ===========================================================================
+// helper
+// ===========================================================================
+/// @brief gaps and speeds of a platoon like situation
+struct FollowSituations {
+    FollowSituations(const int n) {
+        for (int i = 0; i < n; i++) {
+            speeds.push_back(5. + (i % 25));
+            gaps.push_back(2. + (i % 97) * 0.5);
+            predSpeeds.push_back(3. + (i % 31));
+        }
+    }
+    std::vector<double> speeds, gaps, predSpeeds;
+};
+
+
+template<class CFModel>
+static CFModel*
+buildModel(const MSVehicleType* type) {
+    return new CFModel(type);
+}
+
+
+template<>
+MSCFModel_IDM*
+buildModel(const MSVehicleType* type) {
+    return new MSCFModel_IDM(type, false);
+}
+
+
+template<class CFModel>
+static void
+BM_MaximumSafeFollowSpeed(benchmark::State& state) {
+    MSGlobals::gSemiImplicitEulerUpdate = state.range(0) == 0;
+    MSVehicleType type(SUMOVTypeParameter("0"));
+    const CFModel model(&type);
+    const FollowSituations sit(1024);
+    for (auto _ : state) {
+        for (int i = 0; i < (int)sit.speeds.size(); i++) {
+            benchmark::DoNotOptimize(model.maximumSafeFollowSpeed(sit.gaps[i], sit.speeds[i], sit.predSpeeds[i], 4.5));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * sit.speeds.size());
+    MSGlobals::gSemiImplicitEulerUpdate = true;
+}
+BENCHMARK_TEMPLATE(BM_MaximumSafeFollowSpeed, MSCFModel_Krauss)->ArgName("ballistic")->Arg(0)->Arg(1);
+
+
+static void
+BM_KraussFreeAndStopSpeed(benchmark::State& state) {
+    MSVehicleType type(SUMOVTypeParameter("0"));
+    const MSCFModel_Krauss model(&type);
+    const FollowSituations sit(1024);
+    for (auto _ : state) {
+        for (int i = 0; i < (int)sit.speeds.size(); i++) {
+            benchmark::DoNotOptimize(model.brakeGap(sit.speeds[i]));
+            benchmark::DoNotOptimize(model.maximumSafeStopSpeed(sit.gaps[i], 4.5, sit.speeds[i], false, TS));
+            benchmark::DoNotOptimize(MSCFModel::freeSpeed(sit.speeds[i], 4.5, sit.gaps[i] * 10, sit.predSpeeds[i], true, TS));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * sit.speeds.size());
+}
+BENCHMARK(BM_KraussFreeAndStopSpeed);
+
+
+/* Compares calls through the MSCFModel interface (as done by MSVehicle) with
+ * calls on the final model type which the compiler can bind statically.*/
+template<class CFModel>
+static void
+BM_SecureGapDispatch(benchmark::State& state) {
+    MSVehicleType type(SUMOVTypeParameter("0"));
+    std::unique_ptr<const CFModel> model(buildModel<CFModel>(&type));
+    const MSCFModel* base = model.get();
+    // hide the dynamic type from the optimizer
+    benchmark::DoNotOptimize(base);
+    const FollowSituations sit(1024);
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            for (int i = 0; i < (int)sit.speeds.size(); i++) {
+                benchmark::DoNotOptimize(base->getSecureGap(nullptr, nullptr, sit.speeds[i], sit.predSpeeds[i], 4.5));
+                benchmark::DoNotOptimize(base->minNextSpeed(sit.speeds[i]));
+            }
+        } else {
+            const CFModel& concrete = static_cast<const CFModel&>(*base);
+            for (int i = 0; i < (int)sit.speeds.size(); i++) {
+                benchmark::DoNotOptimize(concrete.getSecureGap(nullptr, nullptr, sit.speeds[i], sit.predSpeeds[i], 4.5));
+                benchmark::DoNotOptimize(concrete.minNextSpeed(sit.speeds[i]));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * sit.speeds.size());
+}
+BENCHMARK_TEMPLATE(BM_SecureGapDispatch, MSCFModel_IDM)->ArgName("static")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_SecureGapDispatch, MSCFModel_ACC)->ArgName("static")->Arg(0)->Arg(1);
+
+
+/****************************************************************************/
@@ -0,0 +1,147 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    GeomBenchmark.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Benchmarks the PositionVector geometry operations
+/****************************************************************************/
+#include <config.h>
+
+#include <cmath>
+#include <benchmark/benchmark.h>
+#include <utils/geom/Boundary.h>
+#include <utils/geom/PositionVector.h>
+#include <utils/geom/PositionVectorIndex.h>
+
+
+// ===========================================================================
+// helper
+// ===========================================================================
+/// @brief a wiggly line of the given number of points similar to a curved road
+static PositionVector
+buildShape(const int n, const double yOffset = 0.) {
+    PositionVector result;
+    for (int i = 0; i < n; i++) {
+        result.push_back(Position(i * 10., 20. * sin(i * 0.3) + yOffset));
+    }
+    return result;
+}
+
+
+// ===========================================================================
+// benchmarks
+// ===========================================================================
+static void
+BM_PositionVectorLength(benchmark::State& state) {
+    const PositionVector shape = buildShape((int)state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shape.length2D());
+    }
+}
+BENCHMARK(BM_PositionVectorLength)->ArgName("points")->Arg(4)->Arg(64)->Arg(1024);
+
+
+static void
+BM_PositionVectorPositionAtOffset(benchmark::State& state) {
+    const PositionVector shape = buildShape((int)state.range(0));
+    const double length = shape.length2D();
+    for (auto _ : state) {
+        for (int i = 0; i < 100; i++) {
+            benchmark::DoNotOptimize(shape.positionAtOffset2D(length * i / 100.));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 100);
+}
+BENCHMARK(BM_PositionVectorPositionAtOffset)->ArgName("points")->Arg(4)->Arg(64)->Arg(1024);
+
+
+static void
+BM_PositionVectorNearestOffset(benchmark::State& state) {
+    const PositionVector shape = buildShape((int)state.range(0));
+    const int n = (int)state.range(0);
+    for (auto _ : state) {
+        for (int i = 0; i < 100; i++) {
+            benchmark::DoNotOptimize(shape.nearest_offset_to_point2D(Position(n * 0.1 * i, 15.)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 100);
+}
+BENCHMARK(BM_PositionVectorNearestOffset)->ArgName("points")->Arg(4)->Arg(64)->Arg(1024);
+
+
+static void
+BM_PositionVectorIndexNearestOffset(benchmark::State& state) {
+    const PositionVector shape = buildShape((int)state.range(0));
+    const PositionVectorIndex index(shape);
+    const int n = (int)state.range(0);
+    for (auto _ : state) {
+        for (int i = 0; i < 100; i++) {
+            benchmark::DoNotOptimize(index.nearest_offset_to_point2D(Position(n * 0.1 * i, 15.)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 100);
+}
+BENCHMARK(BM_PositionVectorIndexNearestOffset)->ArgName("points")->Arg(4)->Arg(64)->Arg(1024);
+
+
+static void
+BM_PositionVectorIndexPositionAtOffset(benchmark::State& state) {
+    const PositionVector shape = buildShape((int)state.range(0));
+    const PositionVectorIndex index(shape);
+    const double length = shape.length2D();
+    for (auto _ : state) {
+        for (int i = 0; i < 100; i++) {
+            benchmark::DoNotOptimize(index.positionAtOffset2D(length * i / 100.));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 100);
+}
+BENCHMARK(BM_PositionVectorIndexPositionAtOffset)->ArgName("points")->Arg(4)->Arg(64)->Arg(1024);
+
+
+static void
+BM_PositionVectorIntersects(benchmark::State& state) {
+    const PositionVector shape = buildShape((int)state.range(0));
+    const PositionVector other = buildShape((int)state.range(0), 5.).reverse();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shape.intersectsAtLengths2D(other));
+    }
+}
+BENCHMARK(BM_PositionVectorIntersects)->ArgName("points")->Arg(4)->Arg(64)->Arg(256);
+
+
+static void
+BM_PositionVectorMove2Side(benchmark::State& state) {
+    const PositionVector shape = buildShape((int)state.range(0));
+    for (auto _ : state) {
+        PositionVector moved = shape;
+        moved.move2side(3.2);
+        benchmark::DoNotOptimize(moved.size());
+    }
+}
+BENCHMARK(BM_PositionVectorMove2Side)->ArgName("points")->Arg(4)->Arg(64)->Arg(1024);
+
+
+static void
+BM_PositionVectorBoundary(benchmark::State& state) {
+    const PositionVector shape = buildShape((int)state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shape.getBoxBoundary());
+    }
+}
+BENCHMARK(BM_PositionVectorBoundary)->ArgName("points")->Arg(4)->Arg(64)->Arg(1024);
+
+
+/****************************************************************************/
@@ -0,0 +1,119 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MesoBenchmark.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Benchmarks the headway and insertion computations of meso segments
+/****************************************************************************/
+#include <config.h>
+
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <utils/options/OptionsCont.h>
+#include <utils/options/Option.h>
+#include <utils/common/SUMOTime.h>
+#include <utils/common/ToString.h>
+#include <utils/geom/PositionVector.h>
+#include <microsim/MSEdge.h>
+#include <microsim/MSLane.h>
+#include <mesosim/MESegment.h>
+
+
+// ===========================================================================
+// helper
+// ===========================================================================
+/// @brief a three lane edge of two segments with the default meso parameters
+struct MesoEdge {
+    MesoEdge(const bool multiQueue) {
+        OptionsCont& oc = OptionsCont::getOptions();
+        if (!oc.exists("thread-rngs")) {
+            oc.doRegister("thread-rngs", new Option_Integer(64));
+            oc.doRegister("random", new Option_Bool(false));
+            oc.doRegister("seed", new Option_Integer(23423));
+        }
+        MSLane::initRNGs(oc);
+        edge = new MSEdge("e", 0, SumoXMLEdgeFunc::NORMAL, "", "", -1, 0.);
+        std::vector<MSLane*>* const lanes = new std::vector<MSLane*>();
+        for (int i = 0; i < 3; i++) {
+            const PositionVector shape(Position(0., i * 3.2), Position(200., i * 3.2));
+            lanes->push_back(new MSLane("e_" + toString(i), 13.89, 1., 200., edge, i, shape, 3.2, SVCAll, SVCAll, SVCAll, i, false, ""));
+        }
+        edge->initialize(lanes);
+        MESegment::MesoEdgeType type;
+        type.tauff = TIME2STEPS(1.13);
+        type.taufj = TIME2STEPS(1.13);
+        type.taujf = TIME2STEPS(1.73);
+        type.taujj = TIME2STEPS(1.4);
+        type.jamThreshold = -1;
+        type.junctionControl = false;
+        type.tlsPenalty = 0;
+        type.tlsFlowPenalty = 0;
+        type.minorPenalty = 0;
+        type.overtaking = false;
+        last = new MESegment("e:1", *edge, nullptr, 100., 13.89, 1, multiQueue, type);
+        first = new MESegment("e:0", *edge, last, 100., 13.89, 0, multiQueue, type);
+    }
+
+    MSEdge* edge;
+    MESegment* first;
+    MESegment* last;
+};
+
+
+/// @brief the edges are built once and kept for all benchmarks
+static const MesoEdge&
+getMesoEdge(const bool multiQueue) {
+    static const MesoEdge single(false);
+    static const MesoEdge multi(true);
+    return multiQueue ? multi : single;
+}
+
+
+// ===========================================================================
+// benchmarks
+// ===========================================================================
+static void
+BM_MesoTimeHeadway(benchmark::State& state) {
+    const MesoEdge& e = getMesoEdge(state.range(0) != 0);
+    // downstream states from empty to full (in m and number of vehicles)
+    std::vector<std::pair<double, int> > next;
+    for (int i = 0; i <= 128; i++) {
+        next.push_back(std::make_pair(e.last->getLength() * i / 128., i / 4));
+    }
+    for (auto _ : state) {
+        for (const auto& n : next) {
+            benchmark::DoNotOptimize(e.first->getTimeHeadway(false, *e.last, n.first, n.second));
+            benchmark::DoNotOptimize(e.first->getTimeHeadway(true, *e.last, n.first, n.second));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * next.size() * 2);
+}
+BENCHMARK(BM_MesoTimeHeadway)->ArgName("multiQueue")->Arg(0)->Arg(1);
+
+
+static void
+BM_MesoNextInsertionTime(benchmark::State& state) {
+    const MesoEdge& e = getMesoEdge(state.range(0) != 0);
+    SUMOTime t = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(e.first->getNextInsertionTime(t));
+        t += DELTA_T;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MesoNextInsertionTime)->ArgName("multiQueue")->Arg(0)->Arg(1);
+
+
+/****************************************************************************/
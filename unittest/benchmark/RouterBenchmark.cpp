@@ -0,0 +1,244 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    RouterBenchmark.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Benchmarks the shortest path routers on grid networks like netgenerate builds them
+/****************************************************************************/
+#include <config.h>
+
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <utils/common/Named.h>
+#include <utils/common/SUMOVehicleClass.h>
+#include <utils/common/StdDefs.h>
+#include <utils/common/ToString.h>
+#include <utils/geom/Position.h>
+#include <utils/router/DijkstraRouter.h>
+#include <utils/router/AStarRouter.h>
+#include <utils/router/CHRouter.h>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+class GridEdge;
+
+/// @brief a vehicle without restrictions (all routers accept nullptr as well)
+class GridVehicle : public Named {
+public:
+    GridVehicle() : Named("veh") {}
+    SUMOVehicleClass getVClass() const {
+        return SVC_PASSENGER;
+    }
+    double getMaxSpeed() const {
+        return 50.;
+    }
+    double getChosenSpeedFactor() const {
+        return 1.;
+    }
+};
+
+
+/// @brief a grid edge providing everything the routers need
+class GridEdge : public Named {
+public:
+    typedef std::vector<std::pair<const GridEdge*, const GridEdge*> > ConstEdgePairVector;
+
+    GridEdge(const int index, const Position& from, const Position& to, const double speed) :
+        Named(toString(index)), myIndex(index), myFrom(from), myTo(to),
+        myLength(from.distanceTo2D(to)), mySpeed(speed) {}
+
+    int getNumericalID() const {
+        return myIndex;
+    }
+    double getLength() const {
+        return myLength;
+    }
+    double getSpeedLimit() const {
+        return mySpeed;
+    }
+    double getLengthGeometryFactor() const {
+        return 1.;
+    }
+    bool isInternal() const {
+        return false;
+    }
+    SVCPermissions getPermissions() const {
+        return SVCAll;
+    }
+    bool prohibits(const GridVehicle* const /* veh */) const {
+        return false;
+    }
+    bool restricts(const GridVehicle* const /* veh */) const {
+        return false;
+    }
+    double getMinimumTravelTime(const GridVehicle* const /* veh */) const {
+        return myLength / mySpeed;
+    }
+    double getDistanceTo(const GridEdge* other) const {
+        return myTo.distanceTo2D(other->myFrom);
+    }
+    const ConstEdgePairVector& getViaSuccessors(SUMOVehicleClass /* vClass */ = SVC_IGNORING, bool /* ignoreTransientPermissions */ = false) const {
+        return mySuccessors;
+    }
+    void addSuccessor(const GridEdge* edge) {
+        mySuccessors.push_back(std::make_pair(edge, nullptr));
+    }
+    static double getTravelTimeStatic(const GridEdge* const edge, const GridVehicle* const /* veh */, double /* time */) {
+        return edge->myLength / edge->mySpeed;
+    }
+
+private:
+    const int myIndex;
+    const Position myFrom, myTo;
+    const double myLength, mySpeed;
+    ConstEdgePairVector mySuccessors;
+};
+
+
+/// @brief a grid of size x size junctions with bidirectional edges of 100m (every fifth street is faster)
+class Grid {
+public:
+    Grid(const int size) {
+        std::vector<std::vector<std::vector<GridEdge*> > > outgoing(size, std::vector<std::vector<GridEdge*> >(size));
+        std::vector<std::vector<std::vector<GridEdge*> > > incoming(size, std::vector<std::vector<GridEdge*> >(size));
+        for (int x = 0; x < size; x++) {
+            for (int y = 0; y < size; y++) {
+                if (x + 1 < size) {
+                    const double speed = y % 5 == 0 ? 19.44 : 13.89;
+                    addEdge(x, y, x + 1, y, speed, outgoing, incoming);
+                    addEdge(x + 1, y, x, y, speed, outgoing, incoming);
+                }
+                if (y + 1 < size) {
+                    const double speed = x % 5 == 0 ? 19.44 : 13.89;
+                    addEdge(x, y, x, y + 1, speed, outgoing, incoming);
+                    addEdge(x, y + 1, x, y, speed, outgoing, incoming);
+                }
+            }
+        }
+        for (int x = 0; x < size; x++) {
+            for (int y = 0; y < size; y++) {
+                for (GridEdge* const in : incoming[x][y]) {
+                    for (const GridEdge* const out : outgoing[x][y]) {
+                        in->addSuccessor(out);
+                    }
+                }
+            }
+        }
+    }
+
+    ~Grid() {
+        for (GridEdge* const e : myEdges) {
+            delete e;
+        }
+    }
+
+    const std::vector<GridEdge*>& getEdges() const {
+        return myEdges;
+    }
+
+    /// @brief deterministic pseudo random origin destination pairs
+    std::vector<std::pair<const GridEdge*, const GridEdge*> > getQueries(const int n) const {
+        std::vector<std::pair<const GridEdge*, const GridEdge*> > result;
+        unsigned int state = 42;
+        for (int i = 0; i < n; i++) {
+            state = state * 1103515245 + 12345;
+            const GridEdge* const from = myEdges[(state >> 8) % myEdges.size()];
+            state = state * 1103515245 + 12345;
+            const GridEdge* const to = myEdges[(state >> 8) % myEdges.size()];
+            result.push_back(std::make_pair(from, to));
+        }
+        return result;
+    }
+
+private:
+    void addEdge(const int x1, const int y1, const int x2, const int y2, const double speed,
+                 std::vector<std::vector<std::vector<GridEdge*> > >& outgoing,
+                 std::vector<std::vector<std::vector<GridEdge*> > >& incoming) {
+        GridEdge* const e = new GridEdge((int)myEdges.size(), Position(x1 * 100., y1 * 100.), Position(x2 * 100., y2 * 100.), speed);
+        myEdges.push_back(e);
+        outgoing[x1][y1].push_back(e);
+        incoming[x2][y2].push_back(e);
+    }
+
+    std::vector<GridEdge*> myEdges;
+};
+
+
+// ===========================================================================
+// benchmarks
+// ===========================================================================
+static void
+runQueries(benchmark::State& state, const Grid& grid, SUMOAbstractRouter<GridEdge, GridVehicle>& router) {
+    const std::vector<std::pair<const GridEdge*, const GridEdge*> > queries = grid.getQueries(64);
+    const GridVehicle veh;
+    std::vector<const GridEdge*> route;
+    for (auto _ : state) {
+        for (const auto& q : queries) {
+            route.clear();
+            router.compute(q.first, q.second, &veh, 0, route, true);
+            benchmark::DoNotOptimize(route.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+
+static void
+BM_DijkstraRouter(benchmark::State& state) {
+    const Grid grid((int)state.range(0));
+    DijkstraRouter<GridEdge, GridVehicle> router(grid.getEdges(), true, &GridEdge::getTravelTimeStatic, nullptr, true);
+    runQueries(state, grid, router);
+}
+BENCHMARK(BM_DijkstraRouter)->ArgName("gridSize")->Arg(20)->Arg(50)->Arg(100);
+
+
+static void
+BM_AStarRouter(benchmark::State& state) {
+    const Grid grid((int)state.range(0));
+    AStarRouter<GridEdge, GridVehicle> router(grid.getEdges(), true, &GridEdge::getTravelTimeStatic);
+    runQueries(state, grid, router);
+}
+BENCHMARK(BM_AStarRouter)->ArgName("gridSize")->Arg(20)->Arg(50)->Arg(100);
+
+
+static void
+BM_CHRouter(benchmark::State& state) {
+    const Grid grid((int)state.range(0));
+    CHRouter<GridEdge, GridVehicle> router(grid.getEdges(), true, &GridEdge::getTravelTimeStatic, SVC_PASSENGER, SUMOTime_MAX, false, false);
+    // the first query contracts the network
+    std::vector<const GridEdge*> route;
+    router.compute(grid.getEdges().front(), grid.getEdges().back(), nullptr, 0, route, true);
+    runQueries(state, grid, router);
+}
+BENCHMARK(BM_CHRouter)->ArgName("gridSize")->Arg(20)->Arg(50)->Arg(100);
+
+
+static void
+BM_CHContraction(benchmark::State& state) {
+    const Grid grid((int)state.range(0));
+    for (auto _ : state) {
+        CHRouter<GridEdge, GridVehicle> router(grid.getEdges(), true, &GridEdge::getTravelTimeStatic, SVC_PASSENGER, SUMOTime_MAX, false, false);
+        std::vector<const GridEdge*> route;
+        router.compute(grid.getEdges().front(), grid.getEdges().back(), nullptr, 0, route, true);
+        benchmark::DoNotOptimize(route.data());
+    }
+}
+BENCHMARK(BM_CHContraction)->ArgName("gridSize")->Arg(20)->Arg(50)->Unit(benchmark::kMillisecond);
+
+
+/****************************************************************************/
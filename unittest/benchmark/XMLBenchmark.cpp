@@ -0,0 +1,93 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    XMLBenchmark.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Benchmarks parsing route files with the SUMO SAX handlers
+/****************************************************************************/
+#include <config.h>
+
+#include <cstdio>
+#include <fstream>
+#include <benchmark/benchmark.h>
+#include <utils/common/ToString.h>
+#include <utils/xml/SUMOSAXAttributes.h>
+#include <utils/xml/SUMOSAXHandler.h>
+#include <utils/xml/SUMOXMLDefinitions.h>
+#include <utils/xml/XMLSubSys.h>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/// @brief reads the typical vehicle attributes without building anything
+class CountingHandler : public SUMOSAXHandler {
+public:
+    CountingHandler() : myNumVehicles(0), mySpeedSum(0) {}
+
+    int myNumVehicles;
+    double mySpeedSum;
+
+protected:
+    void myStartElement(int element, const SUMOSAXAttributes& attrs) {
+        if (element == SUMO_TAG_VEHICLE) {
+            bool ok = true;
+            attrs.get<std::string>(SUMO_ATTR_ID, nullptr, ok);
+            mySpeedSum += attrs.getOpt<double>(SUMO_ATTR_DEPARTSPEED, nullptr, ok, 0.);
+            myNumVehicles++;
+        } else if (element == SUMO_TAG_ROUTE) {
+            bool ok = true;
+            attrs.get<std::string>(SUMO_ATTR_EDGES, nullptr, ok);
+        }
+    }
+};
+
+
+// ===========================================================================
+// benchmarks
+// ===========================================================================
+static void
+BM_ParseRoutes(benchmark::State& state) {
+    static bool initialized = false;
+    if (!initialized) {
+        XMLSubSys::init();
+        XMLSubSys::setValidation("never", "never", "never");
+        initialized = true;
+    }
+    const std::string file = "benchmark_routes_" + toString(state.range(0)) + ".rou.xml";
+    std::ofstream out(file.c_str());
+    out << "<routes>\n";
+    for (int i = 0; i < state.range(0); i++) {
+        out << "    <vehicle id=\"veh" << i << "\" depart=\"" << i << ".00\" departSpeed=\"" << i % 14 << ".5\">\n";
+        out << "        <route edges=\"";
+        for (int j = 0; j < 20; j++) {
+            out << (j == 0 ? "" : " ") << "e" << (i + j) % 1000;
+        }
+        out << "\"/>\n    </vehicle>\n";
+    }
+    out << "</routes>\n";
+    out.close();
+    for (auto _ : state) {
+        CountingHandler handler;
+        XMLSubSys::runParser(handler, file);
+        benchmark::DoNotOptimize(handler.mySpeedSum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::remove(file.c_str());
+}
+BENCHMARK(BM_ParseRoutes)->ArgName("vehicles")->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+
+/****************************************************************************/
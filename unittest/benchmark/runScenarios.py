@@ -0,0 +1,129 @@
+#!/usr/bin/env python
+# Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+# Copyright (C) 2008-2023 German Aerospace Center (DLR) and others.
+# This program and the accompanying materials are made available under the
+# terms of the Eclipse Public License 2.0 which is available at
+# https://www.eclipse.org/legal/epl-2.0/
+# This Source Code may also be made available under the following Secondary
+# Licenses when the conditions for such availability set forth in the Eclipse
+# Public License 2.0 are satisfied: GNU General Public License, version 2
+# or later which is available at
+# https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+# SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+
+# @file    runScenarios.py
+# @author  agent
+# @date    2023-10-14
+
+"""
+Runs end to end benchmark scenarios and writes the timings as json.
+The grid and spider scenarios are generated with netgenerate, further
+scenarios (e.g. real city networks) can be given as sumo configuration files.
+Every scenario is run --repeat times and the fastest run is reported.
+"""
+from __future__ import print_function
+from __future__ import absolute_import
+import argparse
+import json
+import os
+import platform
+import random
+import subprocess
+import sys
+import time
+import xml.etree.ElementTree as ET
+
+SCENARIOS = {
+    "grid": ["--grid", "--grid.number", "20", "--grid.length", "200", "--default.lanenumber", "2",
+             "--tls.guess"],
+    "spider": ["--spider", "--spider.arm-number", "12", "--spider.circle-number", "10",
+               "--spider.space-radius", "150", "--tls.guess"],
+}
+
+
+def getBinary(binDir, name):
+    binary = os.path.join(binDir, name)
+    if os.name == "nt":
+        binary += ".exe"
+    if not os.path.exists(binary):
+        sys.exit("Could not find '%s'." % binary)
+    return binary
+
+
+def writeTrips(netFile, routeFile, numVehicles, end, seed):
+    edges = [e.get("id") for e in ET.parse(netFile).getroot().iter("edge") if e.get("function") is None]
+    rng = random.Random(seed)
+    with open(routeFile, "w") as routes:
+        routes.write("<routes>\n")
+        for i in range(numVehicles):
+            source, dest = rng.sample(edges, 2)
+            routes.write('    <trip id="%s" depart="%.2f" from="%s" to="%s" departLane="best"/>\n' %
+                         (i, end * i / numVehicles, source, dest))
+        routes.write("</routes>\n")
+
+
+def runScenario(sumo, name, args, options):
+    statsFile = os.path.join(options.work_dir, name + ".stats.xml")
+    best = None
+    for _ in range(options.repeat):
+        start = time.time()
+        subprocess.check_call([sumo, "--no-step-log", "--no-warnings", "--duration-log.disable",
+                               "--statistic-output", statsFile] + args)
+        wallTime = time.time() - start
+        if best is None or wallTime < best["wallTime"]:
+            root = ET.parse(statsFile).getroot()
+            perf = root.find("performance")
+            vehicles = root.find("vehicles")
+            best = {"name": name,
+                    "wallTime": wallTime,
+                    "simulationDuration": float(perf.get("clockDuration")),
+                    "realTimeFactor": float(perf.get("realTimeFactor")),
+                    "vehicleUpdatesPerSecond": float(perf.get("vehicleUpdatesPerSecond")),
+                    "insertedVehicles": int(vehicles.get("inserted")),
+                    }
+    return best
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument("--bin-dir", default=os.path.join(os.path.dirname(__file__), "..", "..", "bin"),
+                    help="directory containing sumo and netgenerate")
+    ap.add_argument("--work-dir", default="benchmark_scenarios", help="directory for the generated files")
+    ap.add_argument("-o", "--output", default="benchmark_scenarios.json", help="json result file")
+    ap.add_argument("-c", "--config", action="append", default=[],
+                    help="additional sumo configuration to time (may be given multiple times)")
+    ap.add_argument("--vehicles", type=int, default=10000, help="number of vehicles in the generated scenarios")
+    ap.add_argument("--end", type=int, default=3600, help="end of the vehicle insertion in the generated scenarios")
+    ap.add_argument("--repeat", type=int, default=3, help="number of runs per scenario")
+    ap.add_argument("--seed", type=int, default=42, help="random seed for the generated trips")
+    ap.add_argument("--threads", type=int, default=1, help="number of simulation threads")
+    options = ap.parse_args()
+
+    sumo = getBinary(options.bin_dir, "sumo")
+    netgenerate = getBinary(options.bin_dir, "netgenerate")
+    if not os.path.exists(options.work_dir):
+        os.makedirs(options.work_dir)
+    results = []
+    for name, netArgs in sorted(SCENARIOS.items()):
+        netFile = os.path.join(options.work_dir, name + ".net.xml")
+        routeFile = os.path.join(options.work_dir, name + ".rou.xml")
+        subprocess.check_call([netgenerate, "--no-warnings", "-o", netFile] + netArgs)
+        writeTrips(netFile, routeFile, options.vehicles, options.end, options.seed)
+        results.append(runScenario(sumo, name, ["-n", netFile, "-r", routeFile, "--ignore-route-errors",
+                                                "--threads", str(options.threads)], options))
+    for config in options.config:
+        name = os.path.basename(config).split(".")[0]
+        results.append(runScenario(sumo, name, ["-c", os.path.abspath(config), "--threads", str(options.threads)],
+                                   options))
+    version = subprocess.check_output([sumo, "--version"], universal_newlines=True).splitlines()[0]
+    with open(options.output, "w") as out:
+        json.dump({"context": {"version": version, "host": platform.node(), "machine": platform.machine(),
+                               "date": time.strftime("%Y-%m-%dT%H:%M:%S"), "threads": options.threads},
+                   "scenarios": results}, out, indent=2)
+    for r in results:
+        print("%-20s %8.2fs wall, %10.0f vehicle updates per second" %
+              (r["name"], r["wallTime"], r["vehicleUpdatesPerSecond"]))
+
+
+if __name__ == "__main__":
+    main()
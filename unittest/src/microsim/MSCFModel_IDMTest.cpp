@@ -115,3 +115,30 @@ TEST_F(MSCFModel_IDMTest, test_method_getSecureGap) {
         }
     }
 }
+
+TEST_F(MSCFModel_IDMTest, test_method_followSpeedBatch) {
+    // the batch evaluation must give the same results as the scalar one
+    MSCFModel& m = type->getCarFollowModel();
+    std::vector<const MSVehicle*> vehs;
+    std::vector<double> speeds;
+    std::vector<double> gaps;
+    std::vector<double> predSpeeds;
+    std::vector<double> predDecels;
+    for (double v = 0; v < 15; v += 1.5) { // follower
+        for (double u = 0; u < 25; u += 2.5) { // leader
+            for (double g = -1; g < 60; g += 7) { // gap
+                vehs.push_back(veh);
+                speeds.push_back(v);
+                gaps.push_back(g);
+                predSpeeds.push_back(u);
+                predDecels.push_back(m.getMaxDecel());
+            }
+        }
+    }
+    const int n = (int)vehs.size();
+    std::vector<double> result(n);
+    m.followSpeedBatch(n, vehs.data(), speeds.data(), gaps.data(), predSpeeds.data(), predDecels.data(), nullptr, result.data());
+    for (int i = 0; i < n; i++) {
+        EXPECT_DOUBLE_EQ(m.followSpeed(veh, speeds[i], gaps[i], predSpeeds[i], predDecels[i], nullptr), result[i]);
+    }
+}
@@ -38,3 +38,61 @@ TEST(MSEventControl, test_method_execute) {
     eventControl.execute(5);
     EXPECT_TRUE(mock->isExecuteCalled());
 }
+
+
+/* A command which records its execution and may repeat itself once. */
+class OrderCommand : public Command {
+public:
+    OrderCommand(std::vector<int>& order, int id, SUMOTime repeat = 0) :
+        myOrder(order), myID(id), myRepeat(repeat) {}
+
+    SUMOTime execute(SUMOTime /*currentTime*/) {
+        myOrder.push_back(myID);
+        const SUMOTime repeat = myRepeat;
+        myRepeat = 0;
+        return repeat;
+    }
+
+private:
+    std::vector<int>& myOrder;
+    const int myID;
+    SUMOTime myRepeat;
+};
+
+
+/* Test that events are executed ordered by time and priority within one step. */
+TEST(MSEventControl, test_order_within_step) {
+    std::vector<int> order;
+    MSEventControl eventControl;
+    OrderCommand* late = new OrderCommand(order, 3);
+    OrderCommand* low = new OrderCommand(order, 2);
+    OrderCommand* high = new OrderCommand(order, 1);
+    high->priority = 1;
+    eventControl.addEvent(late, 500);
+    eventControl.addEvent(low, 0);
+    eventControl.addEvent(high, 0);
+    eventControl.execute(0);
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), order);
+    EXPECT_TRUE(eventControl.isEmpty());
+}
+
+
+/* Test events beyond the horizon of the timing wheel and repeated events. */
+TEST(MSEventControl, test_far_events) {
+    std::vector<int> order;
+    MSEventControl eventControl;
+    const SUMOTime far = (MSEventControl::WHEEL_SIZE + 10) * DELTA_T;
+    eventControl.addEvent(new OrderCommand(order, 2), far);
+    eventControl.addEvent(new OrderCommand(order, 1, far), DELTA_T);
+    eventControl.execute(0);
+    EXPECT_TRUE(order.empty());
+    eventControl.execute(DELTA_T);
+    EXPECT_EQ(std::vector<int>({1}), order);
+    eventControl.execute(far - DELTA_T);
+    EXPECT_EQ(std::vector<int>({1}), order);
+    eventControl.execute(far);
+    EXPECT_EQ(std::vector<int>({1, 2}), order);
+    eventControl.execute(far + DELTA_T);
+    EXPECT_EQ(std::vector<int>({1, 2, 1}), order);
+    EXPECT_TRUE(eventControl.isEmpty());
+}
@@ -0,0 +1,62 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    HistogramStatisticsTest.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Tests the class HistogramStatistics
+/****************************************************************************/
+#include <config.h>
+
+#include <gtest/gtest.h>
+#include <utils/common/HistogramStatistics.h>
+
+
+/* Test the empty histogram and a single value.*/
+TEST(HistogramStatistics, test_small_samples) {
+    HistogramStatistics stats(10.);
+    EXPECT_EQ(0, stats.size());
+    EXPECT_DOUBLE_EQ(0., stats.getMean());
+    EXPECT_DOUBLE_EQ(0., stats.getQuantile(0.5));
+    stats.add(13.);
+    EXPECT_DOUBLE_EQ(13., stats.getMean());
+    EXPECT_DOUBLE_EQ(13., stats.getQuantile(0.));
+    EXPECT_DOUBLE_EQ(13., stats.getQuantile(0.5));
+    EXPECT_DOUBLE_EQ(13., stats.getQuantile(1.));
+    EXPECT_EQ(1, (int)stats.getBins().size());
+    EXPECT_EQ(1, stats.getBins().at(1));
+}
+
+
+/* Test the bins, mean and the interpolated quantiles of uniform values.*/
+TEST(HistogramStatistics, test_uniform_values) {
+    HistogramStatistics stats(10.);
+    for (int i = 0; i < 100; i++) {
+        stats.add(i);
+    }
+    EXPECT_EQ(100, stats.size());
+    EXPECT_EQ(10, (int)stats.getBins().size());
+    EXPECT_DOUBLE_EQ(49.5, stats.getMean());
+    EXPECT_DOUBLE_EQ(0., stats.getMin());
+    EXPECT_DOUBLE_EQ(99., stats.getMax());
+    EXPECT_DOUBLE_EQ(0., stats.getQuantile(0.));
+    EXPECT_DOUBLE_EQ(25., stats.getQuantile(0.25));
+    EXPECT_DOUBLE_EQ(50., stats.getQuantile(0.5));
+    EXPECT_DOUBLE_EQ(95., stats.getQuantile(0.95));
+    EXPECT_DOUBLE_EQ(99., stats.getQuantile(1.));
+    // negative values use bins below zero
+    stats.add(-5.);
+    EXPECT_EQ(1, stats.getBins().at(-1));
+    EXPECT_DOUBLE_EQ(-5., stats.getQuantile(0.));
+}
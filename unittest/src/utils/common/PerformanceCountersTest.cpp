@@ -0,0 +1,66 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    PerformanceCountersTest.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Tests the class PerformanceCounters
+/****************************************************************************/
+#include <config.h>
+
+#include <gtest/gtest.h>
+#include <utils/common/PerformanceCounters.h>
+
+
+/* Test that objects are only counted when enabled and that the values can be queried.*/
+TEST(PerformanceCounters, test_object_counts) {
+    std::string value;
+    PerformanceCounters::added(PerformanceCounters::ROUTES, 100);
+    EXPECT_TRUE(PerformanceCounters::getValue("routes.objects", value));
+    EXPECT_EQ("0", value);
+    PerformanceCounters::setEnabled(true);
+    PerformanceCounters::added(PerformanceCounters::ROUTES, 100);
+    PerformanceCounters::added(PerformanceCounters::ROUTES, 50);
+    PerformanceCounters::removed(PerformanceCounters::ROUTES, 100);
+    EXPECT_TRUE(PerformanceCounters::getValue("routes.objects", value));
+    EXPECT_EQ("1", value);
+    EXPECT_TRUE(PerformanceCounters::getValue("routes.bytes", value));
+    EXPECT_EQ("50", value);
+    EXPECT_TRUE(PerformanceCounters::getValue("routes.peakBytes", value));
+    EXPECT_EQ("150", value);
+    PerformanceCounters::removed(PerformanceCounters::ROUTES, 50);
+    EXPECT_FALSE(PerformanceCounters::getValue("routes", value));
+    EXPECT_FALSE(PerformanceCounters::getValue("routes.unknown", value));
+    EXPECT_FALSE(PerformanceCounters::getValue("unknown.objects", value));
+    PerformanceCounters::setEnabled(false);
+}
+
+
+/* Test the timers.*/
+TEST(PerformanceCounters, test_timers) {
+    std::string value;
+    PerformanceCounters::setEnabled(true);
+    {
+        PerformanceCounters::Timer timer(PerformanceCounters::MOVEMENT);
+    }
+    {
+        PerformanceCounters::Timer timer(PerformanceCounters::MOVEMENT);
+    }
+    EXPECT_TRUE(PerformanceCounters::getValue("movement.calls", value));
+    EXPECT_EQ("2", value);
+    PerformanceCounters::resetTimers();
+    EXPECT_TRUE(PerformanceCounters::getValue("movement.calls", value));
+    EXPECT_EQ("0", value);
+    PerformanceCounters::setEnabled(false);
+}
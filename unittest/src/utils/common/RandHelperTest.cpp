@@ -127,3 +127,40 @@ TEST(RandHelper, test_sequence) {
         EXPECT_EQ(expect[i], RandHelper::rand(100));
     }
 }
+
+/* Test whether the default generator still yields the Mersenne twister sequence.*/
+TEST(RandHelper, test_mt19937_sequence) {
+    SumoRNG rng("test");
+    std::mt19937 reference;
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(reference(), rng());
+    }
+}
+
+/* Test whether counter based generators only depend on key, step and draw index.*/
+TEST(RandHelper, test_counter_based) {
+    SumoRNG a("a", SumoRNG::deriveKey(42, 1));
+    SumoRNG b("b", SumoRNG::deriveKey(42, 1));
+    SumoRNG other("other", SumoRNG::deriveKey(42, 2));
+    EXPECT_TRUE(a.isCounterBased());
+    std::vector<double> drawsA;
+    a.setStep(1000);
+    for (int i = 0; i < 10; i++) {
+        drawsA.push_back(RandHelper::rand(&a));
+    }
+    // drawing from other generators in between does not matter
+    b.setStep(1000);
+    for (int i = 0; i < 10; i++) {
+        RandHelper::rand(&other);
+        EXPECT_EQ(drawsA[i], RandHelper::rand(&b));
+    }
+    EXPECT_NE(drawsA[0], RandHelper::rand(&other));
+    // a new step starts a new sequence, repeating a step repeats it
+    a.setStep(2000);
+    EXPECT_NE(drawsA[0], RandHelper::rand(&a));
+    SumoRNG c("c", SumoRNG::deriveKey(42, 1));
+    c.setStep(1000);
+    EXPECT_EQ(drawsA[0], RandHelper::rand(&c));
+    SumoRNG copy(c);
+    EXPECT_EQ(RandHelper::rand(&c), RandHelper::rand(&copy));
+}
@@ -0,0 +1,87 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    RandomDistributorTest.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Tests the class RandomDistributor
+/****************************************************************************/
+#include <config.h>
+
+#include <gtest/gtest.h>
+#include <utils/common/RandHelper.h>
+#include <utils/distribution/RandomDistributor.h>
+
+
+/* Counts how often the first value is drawn out of the given number of draws.*/
+static int
+countFirst(const RandomDistributor<int>& dist, const int draws) {
+    int result = 0;
+    for (int i = 0; i < draws; i++) {
+        if (dist.get() == 0) {
+            result++;
+        }
+    }
+    return result;
+}
+
+
+/* Test that both sampling modes follow the probabilities.*/
+TEST(RandomDistributor, test_sampling_modes) {
+    RandomDistributor<int> dist;
+    dist.add(0, 1.);
+    dist.add(1, 3.);
+    dist.add(2, 0.);
+    for (const bool alias : std::vector<bool>({false, true})) {
+        RandHelper::setAliasSampling(alias);
+        RandHelper::initRand();
+        EXPECT_EQ(alias, RandHelper::useAliasSampling());
+        const int first = countFirst(dist, 10000);
+        EXPECT_NEAR(2500, first, 200);
+        for (int i = 0; i < 1000; i++) {
+            EXPECT_NE(2, dist.get());
+        }
+    }
+    RandHelper::setAliasSampling(false);
+}
+
+
+/* Test that the alias table follows changes and that draws are reproducible.*/
+TEST(RandomDistributor, test_alias_rebuild) {
+    RandHelper::setAliasSampling(true);
+    RandomDistributor<int> dist;
+    for (int i = 0; i < 100; i++) {
+        dist.add(i, 1.);
+    }
+    EXPECT_NEAR(100, countFirst(dist, 10000), 40);
+    // increasing the weight of the first value invalidates the table
+    dist.add(0, 99.);
+    EXPECT_NEAR(5000, countFirst(dist, 10000), 200);
+    // copies draw the same values with the same seed
+    RandomDistributor<int> copy = dist;
+    std::vector<int> first;
+    RandHelper::initRand();
+    for (int i = 0; i < 100; i++) {
+        first.push_back(dist.get());
+    }
+    RandHelper::initRand();
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(first[i], copy.get());
+    }
+    dist.remove(0);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_NE(0, dist.get());
+    }
+    RandHelper::setAliasSampling(false);
+}
@@ -0,0 +1,60 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    SampleStatisticsTest.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Tests the class SampleStatistics
+/****************************************************************************/
+#include <config.h>
+
+#include <gtest/gtest.h>
+#include <utils/common/SampleStatistics.h>
+
+
+/* Test the empty sample and a single value.*/
+TEST(SampleStatistics, test_small_samples) {
+    SampleStatistics stats;
+    EXPECT_EQ(0, stats.size());
+    EXPECT_DOUBLE_EQ(0., stats.getMean());
+    EXPECT_DOUBLE_EQ(0., stats.getQuantile(0.5));
+    stats.add(3.);
+    EXPECT_DOUBLE_EQ(3., stats.getMean());
+    EXPECT_DOUBLE_EQ(0., stats.getVariance());
+    EXPECT_DOUBLE_EQ(3., stats.getQuantile(0.));
+    EXPECT_DOUBLE_EQ(3., stats.getQuantile(1.));
+}
+
+
+/* Test mean, variance and quantiles against known values.*/
+TEST(SampleStatistics, test_moments_and_quantiles) {
+    SampleStatistics stats;
+    const double values[] = {4., 1., 3., 2., 5.};
+    for (const double v : values) {
+        stats.add(v);
+    }
+    EXPECT_EQ(5, stats.size());
+    EXPECT_DOUBLE_EQ(3., stats.getMean());
+    EXPECT_DOUBLE_EQ(2.5, stats.getVariance());
+    EXPECT_DOUBLE_EQ(1., stats.getQuantile(0.));
+    EXPECT_DOUBLE_EQ(2., stats.getQuantile(0.25));
+    EXPECT_DOUBLE_EQ(3., stats.getQuantile(0.5));
+    EXPECT_DOUBLE_EQ(5., stats.getQuantile(1.));
+    EXPECT_DOUBLE_EQ(4.6, stats.getQuantile(0.9));
+    // adding after querying a quantile keeps the results consistent
+    stats.add(0.);
+    EXPECT_DOUBLE_EQ(2.5, stats.getMean());
+    EXPECT_DOUBLE_EQ(0., stats.getQuantile(0.));
+    EXPECT_DOUBLE_EQ(2.5, stats.getQuantile(0.5));
+}
@@ -0,0 +1,78 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    StringHashIndexTest.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Tests the classes StringHashIndex and NamedObjectCont
+/****************************************************************************/
+#include <config.h>
+
+#include <map>
+#include <gtest/gtest.h>
+#include <utils/common/NamedObjectCont.h>
+#include <utils/common/StringHashIndex.h>
+
+
+/* Test inserting and erasing against the map contents.*/
+TEST(StringHashIndex, test_insert_erase) {
+    typedef std::map<std::string, int> Map;
+    Map map;
+    StringHashIndex<Map::iterator> index;
+    for (int i = 0; i < 1000; i++) {
+        index.insert(map.emplace("e" + std::to_string(i), i).first);
+    }
+    // erase every third entry
+    for (int i = 0; i < 1000; i += 3) {
+        const std::string key = "e" + std::to_string(i);
+        index.erase(key);
+        map.erase(key);
+    }
+    EXPECT_EQ((int)map.size(), index.size());
+    for (int i = 0; i < 1100; i++) {
+        Map::iterator it;
+        const bool found = index.find("e" + std::to_string(i), it);
+        EXPECT_EQ(i < 1000 && i % 3 != 0, found) << "Testing key " << i;
+        if (found) {
+            EXPECT_EQ(i, it->second);
+        }
+    }
+    index.clear();
+    Map::iterator it;
+    EXPECT_FALSE(index.find("e1", it));
+}
+
+
+/* Test the container keeps its ordered iteration.*/
+TEST(NamedObjectCont, test_order_and_lookup) {
+    NamedObjectCont<int*> cont;
+    EXPECT_TRUE(cont.add("b", new int(2)));
+    EXPECT_TRUE(cont.add("a", new int(1)));
+    EXPECT_TRUE(cont.add("c", new int(3)));
+    EXPECT_FALSE(cont.add("a", nullptr));
+    EXPECT_EQ(1, *cont.get("a"));
+    EXPECT_EQ(nullptr, cont.get("d"));
+    EXPECT_TRUE(cont.changeID("a", "d"));
+    EXPECT_EQ(nullptr, cont.get("a"));
+    EXPECT_EQ(1, *cont.get("d"));
+    EXPECT_TRUE(cont.remove("b"));
+    EXPECT_FALSE(cont.remove("b"));
+    std::vector<std::string> ids;
+    cont.insertIDs(ids);
+    EXPECT_EQ(std::vector<std::string>({"c", "d"}), ids);
+    NamedObjectCont<int*> copy(cont);
+    EXPECT_EQ(3, *copy.get("c"));
+    copy.remove("c", false);
+    copy.remove("d", false);
+}
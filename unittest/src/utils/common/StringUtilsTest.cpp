@@ -142,6 +142,25 @@ TEST(StringUtils, test_toDouble) {
     EXPECT_THROW(StringUtils::toDouble(""), EmptyData);
     EXPECT_THROW(StringUtils::toDouble("1e0x"), NumberFormatException);
     EXPECT_THROW(StringUtils::toDouble("1x"), NumberFormatException);
+    EXPECT_THROW(StringUtils::toDouble("."), NumberFormatException);
+    EXPECT_THROW(StringUtils::toDouble("1e"), NumberFormatException);
+    EXPECT_THROW(StringUtils::toDouble("1.2.3"), NumberFormatException);
+    EXPECT_EQ(-0.25, StringUtils::toDouble("-2.5E-1"));
+    EXPECT_EQ(1e30, StringUtils::toDouble("1e30"));
+}
+
+
+/* Tests that the fast conversion gives the same results as strtod */
+TEST(StringUtils, test_toDouble_matches_strtod) {
+    const char* const values[] = {
+        "0.1", "0.3", "-12.345", "123456.789012", "9007199254740993", "0.000001", "1e-22", "1.7976931348623157e308",
+        "3.14159265358979", "3.141592653589793", "2.5e-3", "-0.000", "000123.4500", "42e+2", "1234567890123.45"
+    };
+    for (const char* const value : values) {
+        EXPECT_EQ(strtod(value, nullptr), StringUtils::toDouble(value)) << value;
+    }
+    EXPECT_EQ(123456789012345678, StringUtils::toLong("123456789012345678"));
+    EXPECT_EQ(-1234567890123456789, StringUtils::toLong("-1234567890123456789"));
 }
 
 TEST(StringUtils, test_toBool) {
@@ -164,3 +183,16 @@ TEST(StringUtils, test_toBool) {
     EXPECT_THROW(StringUtils::toBool("Trari"), BoolFormatException);
     EXPECT_THROW(StringUtils::toBool("yessir"), BoolFormatException);
 }
+
+TEST(StringUtils, test_transcode) {
+    const XMLCh ascii[] = { 'c', 'a', 'r', 0 };
+    EXPECT_EQ("car", StringUtils::transcode(ascii));
+    const XMLCh umlaut[] = { 'M', 0xFC, 'n', 0x20AC, 0 };
+    EXPECT_EQ("M\xC3\xBCn\xE2\x82\xAC", StringUtils::transcode(umlaut));
+    const XMLCh surrogates[] = { 0xD83D, 0xDE97, 0 };
+    EXPECT_EQ("\xF0\x9F\x9A\x97", StringUtils::transcode(surrogates));
+    const XMLCh unpaired[] = { 'a', 0xDE97, 0 };
+    EXPECT_EQ("?", StringUtils::transcode(unpaired));
+    EXPECT_EQ("ca", StringUtils::transcode(ascii, 2));
+    EXPECT_THROW(StringUtils::transcode(nullptr), EmptyData);
+}
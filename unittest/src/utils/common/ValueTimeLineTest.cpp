@@ -211,3 +211,61 @@ TEST(ValueTimeLine, test_fill_gaps_nobounds) {
     EXPECT_EQ(4, vtl.getValue(299)) << "The stored number should be returned when asking within the interval.";
     EXPECT_EQ(4, vtl.getValue(250)) << "The stored number should be returned when asking within the interval.";
 }
+
+
+// --------------------------------
+// compaction tests
+// --------------------------------
+
+/* Tests that a compacted time line returns the same values as the original one. */
+TEST(ValueTimeLine, test_compact) {
+    ValueTimeLine<double> vtl;
+    for (int i = 0; i < 10; i++) {
+        vtl.add(i * 0.1, (i + 1) * 0.1, i);
+    }
+    ValueTimeLine<double> extended = vtl;
+    extended.fillGaps(-1., true);
+    ValueTimeLine<double> filled = vtl;
+    filled.fillGaps(-1.);
+    ValueTimeLine<double> compacted = vtl;
+    EXPECT_TRUE(compacted.compact());
+    ValueTimeLine<double> compactedExtended = extended;
+    EXPECT_TRUE(compactedExtended.compact());
+    ValueTimeLine<double> compactedFilled = filled;
+    EXPECT_TRUE(compactedFilled.compact());
+    for (double t = -0.05; t < 1.2; t += 0.01) {
+        EXPECT_EQ(vtl.describesTime(t), compacted.describesTime(t)) << t;
+        EXPECT_EQ(extended.describesTime(t), compactedExtended.describesTime(t)) << t;
+        EXPECT_EQ(extended.getValue(t), compactedExtended.getValue(t)) << t;
+        EXPECT_EQ(filled.getValue(t), compactedFilled.getValue(t)) << t;
+        EXPECT_EQ(filled.getSplitTime(t, t + 0.07), compactedFilled.getSplitTime(t, t + 0.07)) << t;
+        if (t >= 0) {
+            EXPECT_EQ(vtl.getValue(t), compacted.getValue(t)) << t;
+            EXPECT_EQ(vtl.getSplitTime(t, t + 0.07), compacted.getSplitTime(t, t + 0.07)) << t;
+        }
+    }
+    for (int i = 0; i <= 10; i++) {
+        EXPECT_EQ(vtl.getValue(i * 0.1), compacted.getValue(i * 0.1)) << i;
+    }
+    // modifying returns to the map representation
+    compacted.add(0.15, 0.25, 42.);
+    EXPECT_EQ(42., compacted.getValue(0.2));
+    EXPECT_EQ(0., compacted.getValue(0.05));
+    EXPECT_FALSE(compacted.compact());
+}
+
+/* Tests the minimum of the valid values. */
+TEST(ValueTimeLine, test_minimum) {
+    ValueTimeLine<double> vtl;
+    EXPECT_EQ(7., vtl.getMinimumValue(7.));
+    vtl.add(0, 100, 3.);
+    vtl.add(200, 300, 2.);
+    vtl.add(300, 400, 4.);
+    vtl.add(400, 500, 5.);
+    EXPECT_EQ(2., vtl.getMinimumValue(7.));
+    // the filled gaps are not valid
+    vtl.fillGaps(1.);
+    EXPECT_EQ(2., vtl.getMinimumValue(7.));
+    EXPECT_TRUE(vtl.compact());
+    EXPECT_EQ(2., vtl.getMinimumValue(7.));
+}
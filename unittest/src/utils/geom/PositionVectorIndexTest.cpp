@@ -0,0 +1,94 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    PositionVectorIndexTest.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Tests the class PositionVectorIndex
+/****************************************************************************/
+#include <config.h>
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <utils/geom/PositionVectorIndex.h>
+
+
+class PositionVectorIndexTest : public testing::Test {
+protected:
+    static PositionVector buildShape(const int n) {
+        PositionVector result;
+        for (int i = 0; i < n; i++) {
+            result.push_back(Position(i * 7.3, 30. * sin(i * 0.21), i * 0.1));
+        }
+        return result;
+    }
+};
+
+
+/* Test the offset based methods against the PositionVector implementation.*/
+TEST_F(PositionVectorIndexTest, test_method_positionAtOffset) {
+    for (const int n : {1, 2, 5, 200}) {
+        const PositionVector shape = buildShape(n);
+        const PositionVectorIndex index(shape);
+        for (int k = -10; k < 1100; k++) {
+            const double pos = shape.length() * k / 1000.;
+            EXPECT_EQ(shape.positionAtOffset(pos), index.positionAtOffset(pos));
+            EXPECT_EQ(shape.positionAtOffset(pos, 1.5), index.positionAtOffset(pos, 1.5));
+            EXPECT_EQ(shape.positionAtOffset2D(pos, -1.5), index.positionAtOffset2D(pos, -1.5));
+            if (n > 1) {
+                EXPECT_DOUBLE_EQ(shape.rotationAtOffset(pos), index.rotationAtOffset(pos));
+            }
+        }
+    }
+}
+
+
+/* Test the distance based methods against the PositionVector implementation (the long shape uses the block bounds).*/
+TEST_F(PositionVectorIndexTest, test_method_nearest_offset_to_point2D) {
+    for (const int n : {2, 5, 1000}) {
+        const PositionVector shape = buildShape(n);
+        const PositionVectorIndex index(shape);
+        for (int k = -10; k < 1100; k++) {
+            const Position p(n * 7.3 * k / 1000., 40. * cos(k * 0.05));
+            EXPECT_EQ(shape.nearest_offset_to_point2D(p), index.nearest_offset_to_point2D(p));
+            EXPECT_EQ(shape.nearest_offset_to_point2D(p, false), index.nearest_offset_to_point2D(p, false));
+            EXPECT_EQ(shape.distance2D(p), index.distance2D(p));
+            EXPECT_EQ(shape.distance2D(p, true), index.distance2D(p, true));
+        }
+    }
+}
+
+
+/* Test recomputing the index after modifying the shape.*/
+TEST_F(PositionVectorIndexTest, test_method_update) {
+    PositionVector shape = buildShape(3);
+    PositionVectorIndex index(shape);
+    shape.push_back(Position(100., 100.));
+    index.update();
+    EXPECT_EQ(shape.positionAtOffset(shape.length() - 1.), index.positionAtOffset(shape.length() - 1.));
+}
+
+
+/* Test the index is only built when queried and rebuilt after an update.*/
+TEST_F(PositionVectorIndexTest, test_lazy_build) {
+    PositionVector shape = buildShape(100);
+    PositionVectorIndex index(shape);
+    EXPECT_FALSE(index.isBuilt());
+    EXPECT_EQ(shape.positionAtOffset(50.), index.positionAtOffset(50.));
+    EXPECT_TRUE(index.isBuilt());
+    shape.add(Position(10., 10.));
+    index.update();
+    EXPECT_FALSE(index.isBuilt());
+    EXPECT_EQ(shape.positionAtOffset(50.), index.positionAtOffset(50.));
+}
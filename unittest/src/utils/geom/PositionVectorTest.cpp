@@ -292,6 +292,22 @@ TEST_F(PositionVectorTest, test_method_intersectsAtLengths2D) {
     vec2.push_back(Position(0, 0, 0));
     vec2.push_back(Position(3, 1, 0));
     EXPECT_DOUBLE_EQ(0, vec1.intersectsAtLengths2D(vec2)[0]);
+
+    PositionVector zigzag;
+    zigzag.push_back(Position(10, -10));
+    zigzag.push_back(Position(10, 10));
+    zigzag.push_back(Position(20, 10));
+    zigzag.push_back(Position(20, -10));
+    const std::vector<double> lengths = vec1.intersectsAtLengths2D(zigzag);
+    ASSERT_EQ(2, (int)lengths.size());
+    EXPECT_DOUBLE_EQ(10, lengths[0]);
+    EXPECT_DOUBLE_EQ(20, lengths[1]);
+    EXPECT_DOUBLE_EQ(10, zigzag.intersectsAtLengths2D(vec1)[0]);
+
+    PositionVector apart;
+    apart.push_back(Position(0, 5));
+    apart.push_back(Position(100, 5));
+    EXPECT_TRUE(vec1.intersectsAtLengths2D(apart).empty());
 }
 
 
@@ -0,0 +1,59 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.dev/sumo
+// Copyright (C) 2001-2023 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    SpatialGridTest.cpp
+/// @author  agent
+/// @date    2023-10-14
+///
+// Tests the class SpatialGrid
+/****************************************************************************/
+#include <config.h>
+
+#include <gtest/gtest.h>
+#include <utils/geom/SpatialGrid.h>
+
+
+/* Test the query results against a linear scan.*/
+TEST(SpatialGrid, test_method_query) {
+    SpatialGrid<int> grid;
+    std::vector<Boundary> boxes;
+    for (int i = 0; i < 500; i++) {
+        // clustered and far away items
+        const double x = (i % 50) * 13.7 + (i % 7 == 0 ? 20000. : 0.);
+        const double y = (i / 50) * 21.1;
+        boxes.push_back(Boundary(x, y, x + (i % 5) * 3., y + 2.));
+        grid.add(boxes.back(), i * 10);
+    }
+    grid.build(100.);
+    EXPECT_EQ(500, grid.size());
+    std::vector<int> found;
+    for (int q = 0; q < 100; q++) {
+        const Boundary query(q * 7., q * 2., q * 7. + 100., q * 2. + 100.);
+        grid.query(query, found);
+        std::vector<int> expected;
+        for (int i = 0; i < (int)boxes.size(); i++) {
+            if (boxes[i].xmin() <= query.xmax() && boxes[i].xmax() >= query.xmin()
+                    && boxes[i].ymin() <= query.ymax() && boxes[i].ymax() >= query.ymin()) {
+                expected.push_back(i);
+            }
+        }
+        EXPECT_EQ(expected, found);
+    }
+    EXPECT_EQ(70, grid.getItem(7));
+    grid.query(Boundary(-1000., -1000., -900., -900.), found);
+    EXPECT_TRUE(found.empty());
+    grid.clear();
+    grid.build(100.);
+    grid.query(Boundary(0., 0., 100., 100.), found);
+    EXPECT_TRUE(found.empty());
+}